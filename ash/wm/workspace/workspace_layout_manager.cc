@@ -77,11 +77,14 @@ void WorkspaceLayoutManager::OnChildWindowVisibilityChanged(
 void WorkspaceLayoutManager::SetChildBounds(
     aura::Window* child,
     const gfx::Rect& requested_bounds) {
+  const gfx::Rect old_bounds(child->bounds());
   if (GetTrackedByWorkspace(child))
     BaseLayoutManager::SetChildBounds(child, requested_bounds);
   else
     SetChildBoundsDirect(child, requested_bounds);
-  workspace_manager_->UpdateShelfVisibility();
+  // A window that didn't move can't change whether windows overlap the shelf.
+  if (child->bounds() != old_bounds)
+    workspace_manager_->UpdateShelfVisibility();
 }
 
 void WorkspaceLayoutManager::OnWindowPropertyChanged(aura::Window* window,
@@ -53,7 +53,9 @@ WorkspaceManager::WorkspaceManager(aura::Window* contents_view)
       active_workspace_(NULL),
       ignored_window_(NULL),
       grid_size_(0),
-      shelf_(NULL) {
+      shelf_(NULL),
+      shelf_update_deferral_count_(0),
+      shelf_update_pending_(false) {
   DCHECK(contents_view);
 }
 
@@ -80,6 +82,7 @@ bool WorkspaceManager::IsInMaximizedMode() const {
 
 void WorkspaceManager::AddWindow(aura::Window* window) {
   DCHECK(IsManagedWindow(window));
+  ScopedShelfUpdate shelf_update(this);
 
   Workspace* current_workspace = FindBy(window);
   if (current_workspace) {
@@ -129,6 +132,10 @@ void WorkspaceManager::SetActiveWorkspaceByWindow(aura::Window* window) {
 }
 
 void WorkspaceManager::UpdateShelfVisibility() {
+  if (shelf_update_deferral_count_ > 0) {
+    shelf_update_pending_ = true;
+    return;
+  }
   shelf_->UpdateVisibilityState();
 }
 
@@ -169,6 +176,7 @@ void WorkspaceManager::ShowStateChanged(aura::Window* window) {
   if (!IsManagedWindow(window) || !FindBy(window))
     return;
 
+  ScopedShelfUpdate shelf_update(this);
   Workspace::Type old_type = FindBy(window)->type();
   Workspace::Type new_type = Workspace::TypeForWindow(window);
   if (new_type != old_type)
@@ -176,6 +184,24 @@ void WorkspaceManager::ShowStateChanged(aura::Window* window) {
   UpdateShelfVisibility();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// WorkspaceManager::ScopedShelfUpdate:
+
+WorkspaceManager::ScopedShelfUpdate::ScopedShelfUpdate(
+    WorkspaceManager* manager)
+    : manager_(manager) {
+  manager_->shelf_update_deferral_count_++;
+}
+
+WorkspaceManager::ScopedShelfUpdate::~ScopedShelfUpdate() {
+  DCHECK_GT(manager_->shelf_update_deferral_count_, 0);
+  if (--manager_->shelf_update_deferral_count_ == 0 &&
+      manager_->shelf_update_pending_) {
+    manager_->shelf_update_pending_ = false;
+    manager_->UpdateShelfVisibility();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // WorkspaceManager, private:
 
@@ -224,6 +250,11 @@ void WorkspaceManager::SetWindowLayerVisibility(
     bool value) {
   for (size_t i = 0; i < windows.size(); ++i) {
     ui::Layer* layer = windows[i]->layer();
+    // Leave windows that are already in, or heading to, the requested state
+    // alone so that they don't get an animation of their own.
+    if (layer && layer->GetTargetVisibility() == value &&
+        (!value || layer->GetTargetOpacity() == 1.0f))
+      continue;
     // Only show the layer for windows that want to be visible.
     if (layer && (!value || windows[i]->TargetVisibility())) {
       bool animation_disabled =
@@ -267,6 +298,7 @@ void WorkspaceManager::SetActiveWorkspace(Workspace* workspace) {
     return;
   DCHECK(std::find(workspaces_.begin(), workspaces_.end(),
                    workspace) != workspaces_.end());
+  ScopedShelfUpdate shelf_update(this);
   if (active_workspace_)
     SetVisibilityOfWorkspaceWindows(active_workspace_, ANIMATE, false);
   Workspace* last_active = active_workspace_;
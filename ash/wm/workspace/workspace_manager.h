@@ -106,6 +106,20 @@ class ASH_EXPORT WorkspaceManager {
   friend class Workspace;
   friend class WorkspaceManagerTest;
 
+  // Defers UpdateShelfVisibility() until the outermost ScopedShelfUpdate
+  // goes out of scope, so that the shelf state, which looks at every window,
+  // is computed once per change rather than once per step of it.
+  class ScopedShelfUpdate {
+   public:
+    explicit ScopedShelfUpdate(WorkspaceManager* manager);
+    ~ScopedShelfUpdate();
+
+   private:
+    WorkspaceManager* manager_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedShelfUpdate);
+  };
+
   // See description above getter.
   void set_ignored_window(aura::Window* ignored_window) {
     ignored_window_ = ignored_window;
@@ -171,6 +185,11 @@ class ASH_EXPORT WorkspaceManager {
   // Owned by the Shell container window LauncherContainer. May be NULL.
   ShelfLayoutManager* shelf_;
 
+  // Number of live ScopedShelfUpdates, and whether UpdateShelfVisibility()
+  // was called while there were any.
+  int shelf_update_deferral_count_;
+  bool shelf_update_pending_;
+
   DISALLOW_COPY_AND_ASSIGN(WorkspaceManager);
 };
 
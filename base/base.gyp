@@ -149,6 +149,7 @@
         'cpu_unittest.cc',
         'debug/leak_tracker_unittest.cc',
         'debug/stack_trace_unittest.cc',
+        'debug/tagged_heap_profiler_unittest.cc',
         'debug/trace_event_unittest.cc',
         'debug/trace_event_win_unittest.cc',
         'dir_reader_posix_unittest.cc',
@@ -204,6 +205,7 @@
         'metrics/stats_table_unittest.cc',
         'observer_list_unittest.cc',
         'path_service_unittest.cc',
+        'pending_task_unittest.cc',
         'pickle_unittest.cc',
         'platform_file_unittest.cc',
         'pr_time_unittest.cc',
@@ -528,6 +530,23 @@
         }],
       ],
     },
+    {
+      'target_name': 'base_perftests',
+      'type': 'executable',
+      'dependencies': [
+        'base',
+        'test_support_perf',
+        '../testing/gtest.gyp:gtest',
+      ],
+      'sources': [
+        'json/json_reader_perftest.cc',
+        'message_loop_perftest.cc',
+        'pickle_perftest.cc',
+        'sha1_perftest.cc',
+        'threading/sequenced_worker_pool_perftest.cc',
+        'utf_string_conversions_perftest.cc',
+      ],
+    },
   ],
   'conditions': [
     ['OS == "android"', {
@@ -0,0 +1,229 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/tagged_heap_profiler.h"
+
+#include <string.h>
+
+#include "base/atomicops.h"
+#include "base/debug/trace_event.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+// The samples live in a fixed size open addressing table so that recording
+// them never allocates, which would re-enter the allocator hooks. With the
+// default 128KB interval it holds the samples of a 2GB heap.
+const uint32 kTableSize = 1 << 14;
+const uint32 kTableMask = kTableSize - 1;
+
+// Samples are never further than this from their home slot. A sample that
+// can't be placed is dropped.
+const uint32 kMaxProbes = 32;
+
+// Counts the samples whose pointers hash to each bucket, so that frees of
+// unsampled pointers (nearly all of them) can return without the lock.
+const uint32 kFilterSize = 1 << 15;
+const uint32 kFilterMask = kFilterSize - 1;
+
+const char* const kHeapTagNames[] = {
+  "untagged",
+  "net",
+  "history",
+  "v8_bindings",
+  "media",
+  "gpu_client",
+};
+
+COMPILE_ASSERT(arraysize(kHeapTagNames) == HEAP_TAG_COUNT,
+               heap_tag_names_must_match_heap_tags);
+
+struct Sample {
+  const void* ptr;
+  size_t weight;
+  HeapTag tag;
+};
+
+subtle::Atomic32 g_enabled = 0;
+subtle::Atomic32 g_sample_interval = 0;
+subtle::Atomic32 g_bytes_until_sample = 0;
+subtle::Atomic32 g_filter[kFilterSize];
+
+// Holds the current HeapTag of each thread.
+ThreadLocalStorage::StaticSlot g_tag_slot = TLS_INITIALIZER;
+
+LazyInstance<Lock>::Leaky g_lock = LAZY_INSTANCE_INITIALIZER;
+
+// Guarded by |g_lock|.
+Sample g_samples[kTableSize];
+HeapTagStats g_stats[HEAP_TAG_COUNT];
+
+uint32 HashPointer(const void* ptr) {
+  // Heap blocks are at least 8 byte aligned, so the low bits carry nothing.
+  uint64 value = reinterpret_cast<uintptr_t>(ptr) >> 3;
+  uint32 hash = static_cast<uint32>(value ^ (value >> 32)) * 0x9E3779B1U;
+  return hash >> 8;
+}
+
+void AddSample(const void* ptr, size_t weight, HeapTag tag) {
+  uint32 hash = HashPointer(ptr);
+  AutoLock lock(g_lock.Get());
+  HeapTagStats& stats = g_stats[tag];
+  stats.total_bytes += weight;
+  for (uint32 probe = 0; probe < kMaxProbes; ++probe) {
+    Sample& sample = g_samples[(hash + probe) & kTableMask];
+    if (sample.ptr)
+      continue;
+    sample.ptr = ptr;
+    sample.weight = weight;
+    sample.tag = tag;
+    stats.live_bytes += weight;
+    ++stats.live_samples;
+    subtle::NoBarrier_AtomicIncrement(&g_filter[hash & kFilterMask], 1);
+    return;
+  }
+}
+
+// Empties the slot at |index|, moving later samples of the same run back so
+// that lookups can stop at the first empty slot.
+void RemoveSampleAt(uint32 index) {
+  g_lock.Get().AssertAcquired();
+  uint32 empty = index;
+  for (uint32 i = (index + 1) & kTableMask; g_samples[i].ptr;
+       i = (i + 1) & kTableMask) {
+    uint32 home = HashPointer(g_samples[i].ptr) & kTableMask;
+    if (((i - home) & kTableMask) >= ((i - empty) & kTableMask)) {
+      g_samples[empty] = g_samples[i];
+      empty = i;
+    }
+  }
+  g_samples[empty].ptr = NULL;
+}
+
+}  // namespace
+
+void EnableHeapTagging(size_t sample_interval) {
+  DCHECK(!IsHeapTaggingEnabled());
+  DCHECK_GT(sample_interval, 0u);
+  DCHECK_LE(sample_interval, static_cast<size_t>(kint32max));
+  if (!g_tag_slot.initialized())
+    g_tag_slot.Initialize(NULL);
+  g_lock.Get();
+  subtle::NoBarrier_Store(&g_sample_interval, sample_interval);
+  subtle::NoBarrier_Store(&g_bytes_until_sample, sample_interval);
+  subtle::Release_Store(&g_enabled, 1);
+}
+
+bool IsHeapTaggingEnabled() {
+  return subtle::Acquire_Load(&g_enabled) != 0;
+}
+
+void RecordHeapAllocation(const void* ptr, size_t size) {
+  if (!ptr || !subtle::NoBarrier_Load(&g_enabled))
+    return;
+
+  size_t interval = subtle::NoBarrier_Load(&g_sample_interval);
+  size_t weight;
+  if (size >= interval) {
+    // Large allocations are always sampled, and stand for themselves.
+    weight = size;
+  } else {
+    subtle::Atomic32 remaining = subtle::NoBarrier_AtomicIncrement(
+        &g_bytes_until_sample, -static_cast<subtle::Atomic32>(size));
+    if (remaining > 0)
+      return;
+    // Threads racing past zero each take a sample, which only adds a little
+    // noise to the estimate.
+    subtle::NoBarrier_Store(&g_bytes_until_sample, interval);
+    weight = interval;
+  }
+  AddSample(ptr, weight, GetCurrentHeapTag());
+}
+
+void RecordHeapFree(const void* ptr) {
+  if (!ptr || !subtle::NoBarrier_Load(&g_enabled))
+    return;
+
+  uint32 hash = HashPointer(ptr);
+  if (!subtle::NoBarrier_Load(&g_filter[hash & kFilterMask]))
+    return;
+
+  AutoLock lock(g_lock.Get());
+  for (uint32 probe = 0; probe < kMaxProbes; ++probe) {
+    uint32 index = (hash + probe) & kTableMask;
+    const Sample& sample = g_samples[index];
+    if (!sample.ptr)
+      return;
+    if (sample.ptr == ptr) {
+      HeapTagStats& stats = g_stats[sample.tag];
+      stats.live_bytes -= sample.weight;
+      --stats.live_samples;
+      subtle::NoBarrier_AtomicIncrement(&g_filter[hash & kFilterMask], -1);
+      RemoveSampleAt(index);
+      return;
+    }
+  }
+}
+
+HeapTag GetCurrentHeapTag() {
+  if (!g_tag_slot.initialized())
+    return HEAP_TAG_UNTAGGED;
+  return static_cast<HeapTag>(reinterpret_cast<intptr_t>(g_tag_slot.Get()));
+}
+
+void SetCurrentThreadHeapTag(HeapTag tag) {
+  if (g_tag_slot.initialized())
+    g_tag_slot.Set(reinterpret_cast<void*>(static_cast<intptr_t>(tag)));
+}
+
+const char* GetHeapTagName(HeapTag tag) {
+  DCHECK_GE(tag, 0);
+  DCHECK_LT(tag, HEAP_TAG_COUNT);
+  return kHeapTagNames[tag];
+}
+
+void GetHeapTagStats(HeapTagStats stats[HEAP_TAG_COUNT]) {
+  AutoLock lock(g_lock.Get());
+  memcpy(stats, g_stats, sizeof(g_stats));
+}
+
+void TraceHeapTagCounters() {
+  if (!IsHeapTaggingEnabled())
+    return;
+
+  HeapTagStats stats[HEAP_TAG_COUNT];
+  GetHeapTagStats(stats);
+  for (int i = 0; i < HEAP_TAG_COUNT; ++i) {
+    TRACE_COUNTER1("memory", GetHeapTagName(static_cast<HeapTag>(i)),
+                   stats[i].live_bytes / 1024);
+  }
+}
+
+void ResetHeapTaggingForTesting() {
+  subtle::Release_Store(&g_enabled, 0);
+  AutoLock lock(g_lock.Get());
+  memset(g_samples, 0, sizeof(g_samples));
+  memset(g_stats, 0, sizeof(g_stats));
+  memset(g_filter, 0, sizeof(g_filter));
+  if (g_tag_slot.initialized())
+    g_tag_slot.Set(NULL);
+}
+
+ScopedHeapTag::ScopedHeapTag(HeapTag tag)
+    : previous_tag_(GetCurrentHeapTag()) {
+  SetCurrentThreadHeapTag(tag);
+}
+
+ScopedHeapTag::~ScopedHeapTag() {
+  SetCurrentThreadHeapTag(previous_tag_);
+}
+
+}  // namespace debug
+}  // namespace base
@@ -0,0 +1,97 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_DEBUG_TAGGED_HEAP_PROFILER_H_
+#define BASE_DEBUG_TAGGED_HEAP_PROFILER_H_
+#pragma once
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+
+// The tagged heap profiler attributes live heap memory to the subsystem that
+// allocated it. Code that runs on behalf of a subsystem declares a
+// ScopedHeapTag; the allocator hooks installed by the embedder report
+// allocations and frees, and a sample of roughly one allocation per
+// |sample_interval| bytes is remembered along with the tag that was current
+// when it was made. The samples are cheap enough to leave enabled in release
+// builds, and a live size that keeps growing for one tag points at a leak in
+// that subsystem.
+//
+// Nothing is recorded unless EnableHeapTagging() has been called and the
+// allocator reports to RecordHeapAllocation() and RecordHeapFree(). See
+// content_main_runner.cc for the tcmalloc hooks.
+namespace base {
+namespace debug {
+
+enum HeapTag {
+  HEAP_TAG_UNTAGGED,
+  HEAP_TAG_NET,
+  HEAP_TAG_HISTORY,
+  HEAP_TAG_V8_BINDINGS,
+  HEAP_TAG_MEDIA,
+  HEAP_TAG_GPU_CLIENT,
+  HEAP_TAG_COUNT
+};
+
+// The sampled view of the allocations made under one tag. The sizes are
+// estimates: each sample stands for the bytes allocated since the previous
+// one.
+struct HeapTagStats {
+  // Estimated bytes still allocated.
+  int64 live_bytes;
+  // Number of samples still allocated.
+  int64 live_samples;
+  // Estimated bytes allocated since heap tagging was enabled.
+  int64 total_bytes;
+};
+
+// Starts sampling one allocation per |sample_interval| bytes. Must be called
+// before the allocator hooks are installed, and only once per process.
+BASE_EXPORT void EnableHeapTagging(size_t sample_interval);
+
+// Returns true if EnableHeapTagging() has been called.
+BASE_EXPORT bool IsHeapTaggingEnabled();
+
+// Called by the allocator hooks. These never allocate, and only take a lock
+// for sampled allocations and their frees.
+BASE_EXPORT void RecordHeapAllocation(const void* ptr, size_t size);
+BASE_EXPORT void RecordHeapFree(const void* ptr);
+
+// Returns the tag allocations made on the current thread are attributed to.
+BASE_EXPORT HeapTag GetCurrentHeapTag();
+
+// Attributes the allocations made on the current thread outside of any
+// ScopedHeapTag to |tag|. For threads that only do work for one subsystem.
+BASE_EXPORT void SetCurrentThreadHeapTag(HeapTag tag);
+
+// Returns a short name for |tag|, such as "net".
+BASE_EXPORT const char* GetHeapTagName(HeapTag tag);
+
+// Fills |stats| with one entry per tag, indexed by HeapTag.
+BASE_EXPORT void GetHeapTagStats(HeapTagStats stats[HEAP_TAG_COUNT]);
+
+// Adds the live size of every tag to the trace as "memory" counters, so that
+// a trace shows each process's attribution when tracing begins and ends.
+BASE_EXPORT void TraceHeapTagCounters();
+
+// Forgets all samples and disables heap tagging.
+BASE_EXPORT void ResetHeapTaggingForTesting();
+
+// Attributes the allocations made on the current thread during its lifetime
+// to |tag|. Scopes nest; the innermost one wins.
+class BASE_EXPORT ScopedHeapTag {
+ public:
+  explicit ScopedHeapTag(HeapTag tag);
+  ~ScopedHeapTag();
+
+ private:
+  HeapTag previous_tag_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedHeapTag);
+};
+
+}  // namespace debug
+}  // namespace base
+
+#endif  // BASE_DEBUG_TAGGED_HEAP_PROFILER_H_
@@ -0,0 +1,139 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/tagged_heap_profiler.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+const size_t kSampleInterval = 1024;
+
+// The profiler only looks at the pointers it is given, so the tests hand it
+// addresses inside a buffer rather than real allocations.
+char g_fake_heap[64 * 1024];
+
+const void* FakeBlock(size_t offset) {
+  return &g_fake_heap[offset];
+}
+
+class TaggedHeapProfilerTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    ResetHeapTaggingForTesting();
+    EnableHeapTagging(kSampleInterval);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    ResetHeapTaggingForTesting();
+  }
+
+  HeapTagStats GetStats(HeapTag tag) {
+    HeapTagStats stats[HEAP_TAG_COUNT];
+    GetHeapTagStats(stats);
+    return stats[tag];
+  }
+};
+
+}  // namespace
+
+TEST_F(TaggedHeapProfilerTest, ScopedTags) {
+  EXPECT_EQ(HEAP_TAG_UNTAGGED, GetCurrentHeapTag());
+  {
+    ScopedHeapTag net(HEAP_TAG_NET);
+    EXPECT_EQ(HEAP_TAG_NET, GetCurrentHeapTag());
+    {
+      ScopedHeapTag history(HEAP_TAG_HISTORY);
+      EXPECT_EQ(HEAP_TAG_HISTORY, GetCurrentHeapTag());
+    }
+    EXPECT_EQ(HEAP_TAG_NET, GetCurrentHeapTag());
+  }
+  EXPECT_EQ(HEAP_TAG_UNTAGGED, GetCurrentHeapTag());
+}
+
+TEST_F(TaggedHeapProfilerTest, ThreadTag) {
+  SetCurrentThreadHeapTag(HEAP_TAG_MEDIA);
+  {
+    ScopedHeapTag net(HEAP_TAG_NET);
+    EXPECT_EQ(HEAP_TAG_NET, GetCurrentHeapTag());
+  }
+  EXPECT_EQ(HEAP_TAG_MEDIA, GetCurrentHeapTag());
+  SetCurrentThreadHeapTag(HEAP_TAG_UNTAGGED);
+}
+
+TEST_F(TaggedHeapProfilerTest, SamplesSmallAllocations) {
+  ScopedHeapTag tag(HEAP_TAG_MEDIA);
+  // One sample is taken for every kSampleInterval bytes.
+  for (size_t i = 0; i < 64; ++i)
+    RecordHeapAllocation(FakeBlock(i * 64), 64);
+
+  HeapTagStats stats = GetStats(HEAP_TAG_MEDIA);
+  EXPECT_EQ(4, stats.live_samples);
+  EXPECT_EQ(static_cast<int64>(4 * kSampleInterval), stats.live_bytes);
+  EXPECT_EQ(stats.live_bytes, stats.total_bytes);
+  EXPECT_EQ(0, GetStats(HEAP_TAG_UNTAGGED).total_bytes);
+}
+
+TEST_F(TaggedHeapProfilerTest, LargeAllocationsAreAlwaysSampled) {
+  {
+    ScopedHeapTag tag(HEAP_TAG_GPU_CLIENT);
+    RecordHeapAllocation(FakeBlock(0), 4 * kSampleInterval);
+  }
+  RecordHeapAllocation(FakeBlock(8), 2 * kSampleInterval);
+
+  EXPECT_EQ(static_cast<int64>(4 * kSampleInterval),
+            GetStats(HEAP_TAG_GPU_CLIENT).live_bytes);
+  EXPECT_EQ(static_cast<int64>(2 * kSampleInterval),
+            GetStats(HEAP_TAG_UNTAGGED).live_bytes);
+
+  // The free is attributed to the tag of the allocation, not the current one.
+  {
+    ScopedHeapTag tag(HEAP_TAG_NET);
+    RecordHeapFree(FakeBlock(0));
+  }
+  HeapTagStats stats = GetStats(HEAP_TAG_GPU_CLIENT);
+  EXPECT_EQ(0, stats.live_bytes);
+  EXPECT_EQ(0, stats.live_samples);
+  EXPECT_EQ(static_cast<int64>(4 * kSampleInterval), stats.total_bytes);
+  EXPECT_EQ(0, GetStats(HEAP_TAG_NET).total_bytes);
+}
+
+TEST_F(TaggedHeapProfilerTest, FreeOfUnsampledPointer) {
+  RecordHeapAllocation(FakeBlock(0), kSampleInterval);
+  RecordHeapFree(FakeBlock(8));
+  RecordHeapFree(NULL);
+  EXPECT_EQ(1, GetStats(HEAP_TAG_UNTAGGED).live_samples);
+}
+
+// Every sample must stay reachable while others around it are removed.
+TEST_F(TaggedHeapProfilerTest, ManySamples) {
+  ScopedHeapTag tag(HEAP_TAG_HISTORY);
+  const size_t kBlocks = sizeof(g_fake_heap) / 8;
+  for (size_t i = 0; i < kBlocks; ++i)
+    RecordHeapAllocation(FakeBlock(i * 8), kSampleInterval);
+  int64 sampled = GetStats(HEAP_TAG_HISTORY).live_samples;
+  EXPECT_GT(sampled, 0);
+
+  for (size_t i = 0; i < kBlocks; i += 2)
+    RecordHeapFree(FakeBlock(i * 8));
+  for (size_t i = 1; i < kBlocks; i += 2)
+    RecordHeapFree(FakeBlock(i * 8));
+
+  HeapTagStats stats = GetStats(HEAP_TAG_HISTORY);
+  EXPECT_EQ(0, stats.live_samples);
+  EXPECT_EQ(0, stats.live_bytes);
+  EXPECT_EQ(static_cast<int64>(kBlocks * kSampleInterval), stats.total_bytes);
+}
+
+TEST_F(TaggedHeapProfilerTest, DisabledRecordsNothing) {
+  ResetHeapTaggingForTesting();
+  RecordHeapAllocation(FakeBlock(0), 4 * kSampleInterval);
+  EXPECT_EQ(0, GetStats(HEAP_TAG_UNTAGGED).total_bytes);
+}
+
+}  // namespace debug
+}  // namespace base
@@ -323,6 +323,8 @@ TraceLog* TraceLog::GetInstance() {
 
 TraceLog::TraceLog()
     : enabled_(false)
+    , record_mode_(RECORD_UNTIL_FULL)
+    , oldest_event_index_(0)
     , dispatching_to_observer_list_(false) {
   // Trace is enabled or disabled on one thread while other threads are
   // accessing the enabled flag. We don't care whether edge-case events are
@@ -424,6 +426,13 @@ const unsigned char* TraceLog::GetCategoryEnabledInternal(const char* name) {
   }
 }
 
+void TraceLog::SetRecordMode(RecordMode mode) {
+  AutoLock lock(lock_);
+  if (enabled_)
+    return;
+  record_mode_ = mode;
+}
+
 void TraceLog::GetKnownCategories(std::vector<std::string>* categories) {
   AutoLock lock(lock_);
   for (int i = 0; i < g_category_index; i++)
@@ -512,6 +521,7 @@ void TraceLog::SetDisabled() {
     excluded_categories_.clear();
     for (int i = 0; i < g_category_index; i++)
       g_category_enabled[i] = 0;
+    UnwrapEventBuffer();
     AddThreadNameMetadataEvents();
     AddClockSyncMetadataEvents();
   }  // release lock
@@ -553,6 +563,7 @@ void TraceLog::Flush() {
   OutputCallback output_callback_copy;
   {
     AutoLock lock(lock_);
+    UnwrapEventBuffer();
     previous_logged_events.swap(logged_events_);
     output_callback_copy = output_callback_;
   }  // release lock
@@ -592,7 +603,8 @@ int TraceLog::AddTraceEvent(char phase,
     AutoLock lock(lock_);
     if (!*category_enabled)
       return -1;
-    if (logged_events_.size() >= kTraceEventBufferSize)
+    if (logged_events_.size() >= kTraceEventBufferSize &&
+        record_mode_ == RECORD_UNTIL_FULL)
       return -1;
 
     int thread_id = static_cast<int>(PlatformThread::CurrentId());
@@ -645,14 +657,18 @@ int TraceLog::AddTraceEvent(char phase,
     if (flags & TRACE_EVENT_FLAG_MANGLE_ID)
       id ^= process_id_hash_;
 
-    ret_begin_id = static_cast<int>(logged_events_.size());
-    logged_events_.push_back(
+    // Indices of events move as the ring buffer wraps around, so thresholds
+    // are not supported when recording continuously.
+    if (record_mode_ == RECORD_UNTIL_FULL)
+      ret_begin_id = static_cast<int>(logged_events_.size());
+    AddEventToBuffer(
         TraceEvent(thread_id,
                    now, phase, category_enabled, name, id,
                    num_args, arg_names, arg_types, arg_values,
                    flags));
 
-    if (logged_events_.size() == kTraceEventBufferSize) {
+    if (logged_events_.size() == kTraceEventBufferSize &&
+        record_mode_ == RECORD_UNTIL_FULL) {
       buffer_full_callback_copy = buffer_full_callback_;
     }
   }  // release lock
@@ -663,6 +679,27 @@ int TraceLog::AddTraceEvent(char phase,
   return ret_begin_id;
 }
 
+void TraceLog::AddEventToBuffer(const TraceEvent& event) {
+  lock_.AssertAcquired();
+  if (logged_events_.size() < kTraceEventBufferSize) {
+    logged_events_.push_back(event);
+    return;
+  }
+  DCHECK_EQ(RECORD_CONTINUOUSLY, record_mode_);
+  logged_events_[oldest_event_index_] = event;
+  oldest_event_index_ = (oldest_event_index_ + 1) % logged_events_.size();
+}
+
+void TraceLog::UnwrapEventBuffer() {
+  lock_.AssertAcquired();
+  if (!oldest_event_index_)
+    return;
+  std::rotate(logged_events_.begin(),
+              logged_events_.begin() + oldest_event_index_,
+              logged_events_.end());
+  oldest_event_index_ = 0;
+}
+
 void TraceLog::AddTraceEventEtw(char phase,
                                 const char* name,
                                 const void* id,
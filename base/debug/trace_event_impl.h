@@ -155,8 +155,24 @@ class BASE_EXPORT TraceResultBuffer {
 
 class BASE_EXPORT TraceLog {
  public:
+  // How events are recorded once the trace buffer is full.
+  enum RecordMode {
+    // Drop new events (the default). The buffer full callback is run.
+    RECORD_UNTIL_FULL,
+
+    // Overwrite the oldest events, so that the buffer always holds the most
+    // recent ones. Meant to be left enabled to capture what led up to an
+    // event of interest, such as a hang. Begin/end pairs are never dropped
+    // by TRACE_EVENT_IF_LONGER_THAN thresholds in this mode.
+    RECORD_CONTINUOUSLY,
+  };
+
   static TraceLog* GetInstance();
 
+  // Sets how events are recorded once the buffer is full. Has no effect while
+  // tracing is enabled.
+  void SetRecordMode(RecordMode mode);
+
   // Get set of known categories. This can change as new code paths are reached.
   // The known categories are inserted into |categories|.
   void GetKnownCategories(std::vector<std::string>* categories);
@@ -294,6 +310,14 @@ class BASE_EXPORT TraceLog {
   void AddThreadNameMetadataEvents();
   void AddClockSyncMetadataEvents();
 
+  // Adds |event| to |logged_events_|, overwriting the oldest event if the
+  // buffer is full and recording continuously.
+  void AddEventToBuffer(const TraceEvent& event);
+
+  // Reorders a wrapped-around |logged_events_| so that it is in chronological
+  // order again.
+  void UnwrapEventBuffer();
+
   // TODO(nduca): switch to per-thread trace buffers to reduce thread
   // synchronization.
   Lock lock_;
@@ -301,6 +325,10 @@ class BASE_EXPORT TraceLog {
   OutputCallback output_callback_;
   BufferFullCallback buffer_full_callback_;
   std::vector<TraceEvent> logged_events_;
+  RecordMode record_mode_;
+  // When recording continuously and the buffer is full, the index of the
+  // oldest event in |logged_events_|, which is overwritten next.
+  size_t oldest_event_index_;
   std::vector<std::string> included_categories_;
   std::vector<std::string> excluded_categories_;
   bool dispatching_to_observer_list_;
@@ -1370,5 +1370,34 @@ TEST_F(TraceEventTestFixture, TraceResultBuffer) {
   EXPECT_STREQ(json_output_.json_output.c_str(), "[bla1,bla2,bla3,bla4]");
 }
 
+// Test that a full buffer keeps the most recent events when recording
+// continuously.
+TEST_F(TraceEventTestFixture, RecordContinuously) {
+  ManualTestSetUp();
+  TraceLog* trace_log = TraceLog::GetInstance();
+  trace_log->SetRecordMode(TraceLog::RECORD_CONTINUOUSLY);
+  trace_log->SetEnabled(true);
+
+  while (trace_log->GetBufferPercentFull() < 1.0f)
+    TRACE_EVENT_INSTANT0("category", "old event");
+  size_t buffer_size = trace_log->GetEventsSize();
+
+  const size_t kNumNewEvents = 10;
+  for (size_t i = 0; i < kNumNewEvents; ++i)
+    TRACE_EVENT_INSTANT0("category", "new event");
+  EXPECT_EQ(buffer_size, trace_log->GetEventsSize());
+
+  size_t new_events = 0;
+  for (size_t i = 0; i < trace_log->GetEventsSize(); ++i) {
+    if (std::string(trace_log->GetEventAt(i).name()) == "new event")
+      ++new_events;
+  }
+  EXPECT_EQ(kNumNewEvents, new_events);
+
+  // Don't convert the whole buffer to JSON when disabling.
+  trace_log->SetOutputCallback(TraceLog::OutputCallback());
+  trace_log->SetEnabled(false);
+}
+
 }  // namespace debug
 }  // namespace base
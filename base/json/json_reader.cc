@@ -4,6 +4,11 @@
 
 #include "base/json/json_reader.h"
 
+#include <string.h>
+
+#include <vector>
+
+#include "base/compiler_specific.h"
 #include "base/float_util.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
@@ -61,6 +66,95 @@ bool ReadHexDigits(base::JSONReader::Token& token, int digits) {
   return true;
 }
 
+// Builds a Value tree out of the events of JSONReader::JsonToDelegate(). Every
+// list or dictionary is attached to its parent as soon as it begins, so the
+// partial tree is released when parsing fails part way.
+class ValueBuilder : public base::JSONReader::Delegate {
+ public:
+  ValueBuilder() {}
+  virtual ~ValueBuilder() {}
+
+  base::Value* Release() {
+    DCHECK(containers_.empty());
+    return root_.release();
+  }
+
+  // JSONReader::Delegate implementation.
+  virtual bool OnNull() OVERRIDE {
+    Add(base::Value::CreateNullValue());
+    return true;
+  }
+  virtual bool OnBoolean(bool value) OVERRIDE {
+    Add(base::Value::CreateBooleanValue(value));
+    return true;
+  }
+  virtual bool OnInteger(int value) OVERRIDE {
+    Add(base::Value::CreateIntegerValue(value));
+    return true;
+  }
+  virtual bool OnDouble(double value) OVERRIDE {
+    Add(base::Value::CreateDoubleValue(value));
+    return true;
+  }
+  virtual bool OnString(const std::string& value) OVERRIDE {
+    Add(base::Value::CreateStringValue(value));
+    return true;
+  }
+  virtual bool OnListBegin() OVERRIDE {
+    base::ListValue* list = new base::ListValue;
+    Add(list);
+    containers_.push_back(list);
+    return true;
+  }
+  virtual bool OnListEnd() OVERRIDE {
+    containers_.pop_back();
+    return true;
+  }
+  virtual bool OnDictionaryBegin() OVERRIDE {
+    base::DictionaryValue* dictionary = new base::DictionaryValue;
+    Add(dictionary);
+    containers_.push_back(dictionary);
+    return true;
+  }
+  virtual bool OnDictionaryKey(const std::string& key) OVERRIDE {
+    key_.assign(key);
+    return true;
+  }
+  virtual bool OnDictionaryEnd() OVERRIDE {
+    containers_.pop_back();
+    return true;
+  }
+
+ private:
+  // Takes ownership of |value| and attaches it to the innermost open
+  // container, or makes it the root if there is none.
+  void Add(base::Value* value) {
+    if (containers_.empty()) {
+      DCHECK(!root_.get());
+      root_.reset(value);
+      return;
+    }
+    base::Value* parent = containers_.back();
+    if (parent->IsType(base::Value::TYPE_LIST)) {
+      static_cast<base::ListValue*>(parent)->Append(value);
+    } else {
+      static_cast<base::DictionaryValue*>(parent)->SetWithoutPathExpansion(
+          key_, value);
+    }
+  }
+
+  scoped_ptr<base::Value> root_;
+
+  // Lists and dictionaries that are still being parsed, innermost last. They
+  // are owned by |root_|.
+  std::vector<base::Value*> containers_;
+
+  // Key of the dictionary entry whose value is parsed next.
+  std::string key_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueBuilder);
+};
+
 }  // namespace
 
 namespace base {
@@ -122,6 +216,26 @@ Value* JSONReader::ReadAndReturnError(const std::string& json,
   return NULL;
 }
 
+// static
+bool JSONReader::ReadWithDelegate(const std::string& json,
+                                  int options,
+                                  Delegate* delegate,
+                                  int* error_code_out,
+                                  std::string* error_msg_out) {
+  JSONReader reader = JSONReader();
+  if (reader.JsonToDelegate(json, false,
+          (options & JSON_ALLOW_TRAILING_COMMAS) != 0, delegate)) {
+    return true;
+  }
+
+  if (error_code_out)
+    *error_code_out = reader.error_code();
+  if (error_msg_out)
+    *error_msg_out = reader.GetErrorMessage();
+
+  return false;
+}
+
 // static
 std::string JSONReader::ErrorCodeToString(JsonParseError error_code) {
   switch (error_code) {
@@ -156,10 +270,19 @@ std::string JSONReader::GetErrorMessage() const {
 
 Value* JSONReader::JsonToValue(const std::string& json, bool check_root,
                                bool allow_trailing_comma) {
+  ValueBuilder builder;
+  if (!JsonToDelegate(json, check_root, allow_trailing_comma, &builder))
+    return NULL;
+  return builder.Release();
+}
+
+bool JSONReader::JsonToDelegate(const std::string& json, bool check_root,
+                                bool allow_trailing_comma,
+                                Delegate* delegate) {
   // The input must be in UTF-8.
   if (!IsStringUTF8(json.data())) {
     error_code_ = JSON_UNSUPPORTED_ENCODING;
-    return NULL;
+    return false;
   }
 
   start_pos_ = json.data();
@@ -167,7 +290,7 @@ Value* JSONReader::JsonToValue(const std::string& json, bool check_root,
 
   // When the input JSON string starts with a UTF-8 Byte-Order-Mark (U+FEFF)
   // or <0xEF 0xBB 0xBF>, advance the start position to avoid the
-  // JSONReader::BuildValue() function from mis-treating a Unicode BOM as an
+  // JSONReader::ParseValue() function from mis-treating a Unicode BOM as an
   // invalid character and returning NULL.
   if (json.size() >= 3 && static_cast<uint8>(start_pos_[0]) == 0xEF &&
       static_cast<uint8>(start_pos_[1]) == 0xBB &&
@@ -180,10 +303,9 @@ Value* JSONReader::JsonToValue(const std::string& json, bool check_root,
   stack_depth_ = 0;
   error_code_ = JSON_NO_ERROR;
 
-  scoped_ptr<Value> root(BuildValue(check_root));
-  if (root.get()) {
+  if (ParseValue(check_root, delegate)) {
     if (ParseToken().type == Token::END_OF_INPUT) {
-      return root.release();
+      return true;
     } else {
       SetErrorCode(JSON_UNEXPECTED_DATA_AFTER_ROOT, json_pos_);
     }
@@ -193,7 +315,7 @@ Value* JSONReader::JsonToValue(const std::string& json, bool check_root,
   if (error_code_ == 0)
     SetErrorCode(JSON_SYNTAX_ERROR, json_pos_);
 
-  return NULL;
+  return false;
 }
 
 // static
@@ -206,11 +328,11 @@ std::string JSONReader::FormatErrorMessage(int line, int column,
   return description;
 }
 
-Value* JSONReader::BuildValue(bool is_root) {
+bool JSONReader::ParseValue(bool is_root, Delegate* delegate) {
   ++stack_depth_;
   if (stack_depth_ > kStackLimit) {
     SetErrorCode(JSON_TOO_MUCH_NESTING, json_pos_);
-    return NULL;
+    return false;
   }
 
   Token token = ParseToken();
@@ -218,51 +340,52 @@ Value* JSONReader::BuildValue(bool is_root) {
   if (is_root && token.type != Token::OBJECT_BEGIN &&
       token.type != Token::ARRAY_BEGIN) {
     SetErrorCode(JSON_BAD_ROOT_ELEMENT_TYPE, json_pos_);
-    return NULL;
+    return false;
   }
 
-  scoped_ptr<Value> node;
-
   switch (token.type) {
     case Token::END_OF_INPUT:
     case Token::INVALID_TOKEN:
-      return NULL;
+      return false;
 
     case Token::NULL_TOKEN:
-      node.reset(Value::CreateNullValue());
+      if (!delegate->OnNull())
+        return false;
       break;
 
     case Token::BOOL_TRUE:
-      node.reset(Value::CreateBooleanValue(true));
+      if (!delegate->OnBoolean(true))
+        return false;
       break;
 
     case Token::BOOL_FALSE:
-      node.reset(Value::CreateBooleanValue(false));
+      if (!delegate->OnBoolean(false))
+        return false;
       break;
 
     case Token::NUMBER:
-      node.reset(DecodeNumber(token));
-      if (!node.get())
-        return NULL;
+      if (!DecodeNumber(token, delegate))
+        return false;
       break;
 
     case Token::STRING:
-      node.reset(DecodeString(token));
-      if (!node.get())
-        return NULL;
+      if (!DecodeString(token, &decoded_string_) ||
+          !delegate->OnString(decoded_string_)) {
+        return false;
+      }
       break;
 
     case Token::ARRAY_BEGIN:
       {
+        if (!delegate->OnListBegin())
+          return false;
+
         json_pos_ += token.length;
         token = ParseToken();
 
-        node.reset(new ListValue());
         while (token.type != Token::ARRAY_END) {
-          Value* array_node = BuildValue(false);
-          if (!array_node)
-            return NULL;
-          static_cast<ListValue*>(node.get())->Append(array_node);
+          if (!ParseValue(false, delegate))
+            return false;
 
           // After a list value, we expect a comma or the end of the list.
           token = ParseToken();
@@ -274,54 +397,51 @@ Value* JSONReader::BuildValue(bool is_root) {
             if (token.type == Token::ARRAY_END) {
               if (!allow_trailing_comma_) {
                 SetErrorCode(JSON_TRAILING_COMMA, json_pos_);
-                return NULL;
+                return false;
               }
               // Trailing comma OK, stop parsing the Array.
               break;
             }
           } else if (token.type != Token::ARRAY_END) {
             // Unexpected value after list value.  Bail out.
-            return NULL;
+            return false;
           }
         }
-        if (token.type != Token::ARRAY_END) {
-          return NULL;
-        }
+        if (token.type != Token::ARRAY_END)
+          return false;
+
+        if (!delegate->OnListEnd())
+          return false;
         break;
       }
 
     case Token::OBJECT_BEGIN:
       {
+        if (!delegate->OnDictionaryBegin())
+          return false;
+
         json_pos_ += token.length;
         token = ParseToken();
 
-        node.reset(new DictionaryValue);
         while (token.type != Token::OBJECT_END) {
           if (token.type != Token::STRING) {
             SetErrorCode(JSON_UNQUOTED_DICTIONARY_KEY, json_pos_);
-            return NULL;
+            return false;
+          }
+          if (!DecodeString(token, &decoded_string_) ||
+              !delegate->OnDictionaryKey(decoded_string_)) {
+            return false;
           }
-          scoped_ptr<Value> dict_key_value(DecodeString(token));
-          if (!dict_key_value.get())
-            return NULL;
-
-          // Convert the key into a wstring.
-          std::string dict_key;
-          bool success = dict_key_value->GetAsString(&dict_key);
-          DCHECK(success);
 
           json_pos_ += token.length;
           token = ParseToken();
           if (token.type != Token::OBJECT_PAIR_SEPARATOR)
-            return NULL;
+            return false;
 
           json_pos_ += token.length;
           token = ParseToken();
-          Value* dict_value = BuildValue(false);
-          if (!dict_value)
-            return NULL;
-          static_cast<DictionaryValue*>(node.get())->SetWithoutPathExpansion(
-              dict_key, dict_value);
+          if (!ParseValue(false, delegate))
+            return false;
 
           // After a key/value pair, we expect a comma or the end of the
           // object.
@@ -334,30 +454,32 @@ Value* JSONReader::BuildValue(bool is_root) {
             if (token.type == Token::OBJECT_END) {
               if (!allow_trailing_comma_) {
                 SetErrorCode(JSON_TRAILING_COMMA, json_pos_);
-                return NULL;
+                return false;
               }
               // Trailing comma OK, stop parsing the Object.
               break;
             }
           } else if (token.type != Token::OBJECT_END) {
             // Unexpected value after last object value.  Bail out.
-            return NULL;
+            return false;
           }
         }
         if (token.type != Token::OBJECT_END)
-          return NULL;
+          return false;
 
+        if (!delegate->OnDictionaryEnd())
+          return false;
         break;
       }
 
     default:
       // We got a token that's not a value.
-      return NULL;
+      return false;
   }
   json_pos_ += token.length;
 
   --stack_depth_;
-  return node.release();
+  return true;
 }
 
 JSONReader::Token JSONReader::ParseNumberToken() {
@@ -397,18 +519,18 @@ JSONReader::Token JSONReader::ParseNumberToken() {
   return token;
 }
 
-Value* JSONReader::DecodeNumber(const Token& token) {
-  const std::string num_string(token.begin, token.length);
-
+bool JSONReader::DecodeNumber(const Token& token, Delegate* delegate) {
+  // Most numbers are ints, which can be converted without a copy.
   int num_int;
-  if (StringToInt(num_string, &num_int))
-    return Value::CreateIntegerValue(num_int);
+  if (StringToInt(StringPiece(token.begin, token.length), &num_int))
+    return delegate->OnInteger(num_int);
 
+  const std::string num_string(token.begin, token.length);
   double num_double;
   if (StringToDouble(num_string, &num_double) && base::IsFinite(num_double))
-    return Value::CreateDoubleValue(num_double);
+    return delegate->OnDouble(num_double);
 
-  return NULL;
+  return false;
 }
 
 JSONReader::Token JSONReader::ParseStringToken() {
@@ -456,9 +578,18 @@ JSONReader::Token JSONReader::ParseStringToken() {
   return Token::CreateInvalidToken();
 }
 
-Value* JSONReader::DecodeString(const Token& token) {
-  std::string decoded_str;
-  decoded_str.reserve(token.length - 2);
+bool JSONReader::DecodeString(const Token& token, std::string* dest_string) {
+  std::string& decoded_str = *dest_string;
+  decoded_str.clear();
+
+  // Strings without escapes, the common case, are copied as a whole.
+  const char* contents = token.begin + 1;
+  const size_t contents_length = token.length - 2;
+  if (!memchr(contents, '\\', contents_length)) {
+    decoded_str.assign(contents, contents_length);
+    return true;
+  }
+  decoded_str.reserve(contents_length);
 
   for (int i = 1; i < token.length - 1; ++i) {
     char c = *(token.begin + i);
@@ -492,31 +623,31 @@ Value* JSONReader::DecodeString(const Token& token) {
 
         case 'x': {
           if (i + 2 >= token.length)
-            return NULL;
+            return false;
           int hex_digit = 0;
           if (!HexStringToInt(StringPiece(token.begin + i + 1, 2), &hex_digit))
-            return NULL;
+            return false;
           decoded_str.push_back(hex_digit);
           i += 2;
           break;
         }
         case 'u':
           if (!ConvertUTF16Units(token, &i, &decoded_str))
-            return NULL;
+            return false;
           break;
 
         default:
           // We should only have valid strings at this point.  If not,
           // ParseStringToken didn't do its job.
           NOTREACHED();
-          return NULL;
+          return false;
       }
     } else {
       // Not escaped
       decoded_str.push_back(c);
     }
   }
-  return Value::CreateStringValue(decoded_str);
+  return true;
 }
 
 bool JSONReader::ConvertUTF16Units(const Token& token,
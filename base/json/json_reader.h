@@ -3,7 +3,8 @@
 // found in the LICENSE file.
 //
 // A JSON parser.  Converts strings of JSON into a Value object (see
-// base/values.h).
+// base/values.h), or reports their contents to a JSONReader::Delegate as they
+// are parsed.
 // http://www.ietf.org/rfc/rfc4627.txt?number=4627
 //
 // Known limitations/deviations from the RFC:
@@ -114,6 +115,33 @@ class BASE_EXPORT JSONReader {
     JSON_UNQUOTED_DICTIONARY_KEY,
   };
 
+  // Receives the contents of a JSON document in document order while it is
+  // parsed, so that callers which only need part of the data, or want to
+  // build their own structures, don't pay for a Value tree. Every method
+  // returns false to stop parsing.
+  //
+  // Events are delivered as soon as they are parsed, so a delegate can see
+  // part of a document that turns out to be invalid later on.
+  class BASE_EXPORT Delegate {
+   public:
+    virtual bool OnNull() = 0;
+    virtual bool OnBoolean(bool value) = 0;
+    virtual bool OnInteger(int value) = 0;
+    virtual bool OnDouble(double value) = 0;
+    // |value| is only valid for the duration of the call.
+    virtual bool OnString(const std::string& value) = 0;
+    virtual bool OnListBegin() = 0;
+    virtual bool OnListEnd() = 0;
+    virtual bool OnDictionaryBegin() = 0;
+    // Called before the value of each dictionary entry. |key| is only valid
+    // for the duration of the call.
+    virtual bool OnDictionaryKey(const std::string& key) = 0;
+    virtual bool OnDictionaryEnd() = 0;
+
+   protected:
+    virtual ~Delegate() {}
+  };
+
   // String versions of parse error codes.
   static const char* kBadRootElementType;
   static const char* kInvalidEscape;
@@ -144,6 +172,17 @@ class BASE_EXPORT JSONReader {
                                    int* error_code_out,
                                    std::string* error_msg_out);
 
+  // Parses |json| like ReadAndReturnError(), but reports its contents to
+  // |delegate| instead of building a Value. Returns true if the whole input
+  // was a well-formed JSON document and |delegate| never stopped parsing.
+  // |error_code_out| and |error_msg_out| are optional and only populated on
+  // a parse error.
+  static bool ReadWithDelegate(const std::string& json,
+                               int options,  // JSONParserOptions
+                               Delegate* delegate,
+                               int* error_code_out,
+                               std::string* error_msg_out);
+
   // Converts a JSON parse error code into a human readable message.
   // Returns an empty string if error_code is JSON_NO_ERROR.
   static std::string ErrorCodeToString(JsonParseError error_code);
@@ -166,6 +205,11 @@ class BASE_EXPORT JSONReader {
   Value* JsonToValue(const std::string& json, bool check_root,
                      bool allow_trailing_comma);
 
+  // Like JsonToValue(), but reports the parsed contents to |delegate|.
+  // Returns false on a parse error or if |delegate| stopped parsing.
+  bool JsonToDelegate(const std::string& json, bool check_root,
+                      bool allow_trailing_comma, Delegate* delegate);
+
  private:
   FRIEND_TEST_ALL_PREFIXES(JSONReaderTest, Reading);
   FRIEND_TEST_ALL_PREFIXES(JSONReaderTest, ErrorMessages);
@@ -173,10 +217,10 @@ class BASE_EXPORT JSONReader {
   static std::string FormatErrorMessage(int line, int column,
                                         const std::string& description);
 
-  // Recursively build Value.  Returns NULL if we don't have a valid JSON
-  // string.  If |is_root| is true, we verify that the root element is either
-  // an object or an array.
-  Value* BuildValue(bool is_root);
+  // Recursively parses a value, reporting it to |delegate|.  Returns false if
+  // we don't have a valid JSON string.  If |is_root| is true, we verify that
+  // the root element is either an object or an array.
+  bool ParseValue(bool is_root, Delegate* delegate);
 
   // Parses a sequence of characters into a Token::NUMBER. If the sequence of
   // characters is not a valid number, returns a Token::INVALID_TOKEN. Note
@@ -185,8 +229,8 @@ class BASE_EXPORT JSONReader {
   Token ParseNumberToken();
 
   // Try and convert the substring that token holds into an int or a double. If
-  // we can (ie., no overflow), return the value, else return NULL.
-  Value* DecodeNumber(const Token& token);
+  // we can (ie., no overflow), report it to |delegate|, else return false.
+  bool DecodeNumber(const Token& token, Delegate* delegate);
 
   // Parses a sequence of characters into a Token::STRING. If the sequence of
   // characters is not a valid string, returns a Token::INVALID_TOKEN. Note
@@ -194,9 +238,9 @@ class BASE_EXPORT JSONReader {
   // actual wstring.
   Token ParseStringToken();
 
-  // Convert the substring into a value string.  This should always succeed
-  // (otherwise ParseStringToken would have failed).
-  Value* DecodeString(const Token& token);
+  // Convert the substring into |dest_string|, replacing its contents.  This
+  // should always succeed (otherwise ParseStringToken would have failed).
+  bool DecodeString(const Token& token, std::string* dest_string);
 
   // Helper function for DecodeString that consumes UTF16 [0,2] code units and
   // convers them to UTF8 code untis.  |token| is the string token in which the
@@ -242,6 +286,10 @@ class BASE_EXPORT JSONReader {
   // A parser flag that allows trailing commas in objects and arrays.
   bool allow_trailing_comma_;
 
+  // Scratch buffer for decoded strings, reused so that its storage is only
+  // allocated once per document rather than once per string.
+  std::string decoded_string_;
+
   // Contains the error code for the last call to JsonToValue(), if any.
   JsonParseError error_code_;
   int error_line_;
@@ -0,0 +1,108 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/json_reader.h"
+
+#include <string>
+#include <vector>
+
+#include "base/compiler_specific.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/perftimer.h"
+#include "base/stringprintf.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Size of the generated document, roughly that of a large Preferences file.
+const size_t kDocumentSize = 5 * 1024 * 1024;
+
+const int kIterations = 5;
+
+// Returns a document shaped like a Preferences file: a dictionary of
+// per-site dictionaries holding strings, numbers, booleans and lists.
+std::string MakePreferencesLikeDocument() {
+  std::string json = "{\"profile\": {\"name\": \"Person 1\"}, \"sites\": {";
+  for (int i = 0; json.size() < kDocumentSize; i++) {
+    if (i)
+      json += ",";
+    base::StringAppendF(&json,
+        "\"http://www%d.example.com:80\": {"
+        "\"last_visit\": \"1333%07d\", \"visit_count\": %d, "
+        "\"zoom\": %d.25, \"pinned\": %s, \"content_settings\": "
+        "{\"images\": 1, \"popups\": 2, \"plugins\": null}, "
+        "\"paths\": [\"/index.html\", \"/a/b/c?q=\\\"%d\\\"\", \"/\"]}",
+        i, i, i % 1000, i % 4, i % 2 ? "true" : "false", i);
+  }
+  json += "}}";
+  return json;
+}
+
+// Counts the values in a document without building a Value tree.
+class CountingDelegate : public JSONReader::Delegate {
+ public:
+  CountingDelegate() : count_(0) {}
+
+  int count() const { return count_; }
+
+  virtual bool OnNull() OVERRIDE { return Count(); }
+  virtual bool OnBoolean(bool value) OVERRIDE { return Count(); }
+  virtual bool OnInteger(int value) OVERRIDE { return Count(); }
+  virtual bool OnDouble(double value) OVERRIDE { return Count(); }
+  virtual bool OnString(const std::string& value) OVERRIDE { return Count(); }
+  virtual bool OnListBegin() OVERRIDE { return Count(); }
+  virtual bool OnListEnd() OVERRIDE { return true; }
+  virtual bool OnDictionaryBegin() OVERRIDE { return Count(); }
+  virtual bool OnDictionaryKey(const std::string& key) OVERRIDE {
+    return true;
+  }
+  virtual bool OnDictionaryEnd() OVERRIDE { return true; }
+
+ private:
+  bool Count() {
+    count_++;
+    return true;
+  }
+
+  int count_;
+};
+
+}  // namespace
+
+TEST(JSONReaderPerfTest, ReadValue) {
+  const std::string json = MakePreferencesLikeDocument();
+
+  std::vector<double> samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    PerfTimer timer;
+    for (int i = 0; i < kIterations; i++) {
+      scoped_ptr<Value> root(JSONReader::Read(json));
+      ASSERT_TRUE(root.get());
+    }
+    samples.push_back(timer.Elapsed().InMillisecondsF());
+  }
+  LogPerfResultSamples("JSONReader_Read_5MB", samples, "ms");
+}
+
+TEST(JSONReaderPerfTest, ReadWithDelegate) {
+  const std::string json = MakePreferencesLikeDocument();
+
+  std::vector<double> samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    PerfTimer timer;
+    for (int i = 0; i < kIterations; i++) {
+      CountingDelegate delegate;
+      ASSERT_TRUE(JSONReader::ReadWithDelegate(json, JSON_PARSE_RFC,
+                                               &delegate, NULL, NULL));
+      ASSERT_GT(delegate.count(), 0);
+    }
+    samples.push_back(timer.Elapsed().InMillisecondsF());
+  }
+  LogPerfResultSamples("JSONReader_ReadWithDelegate_5MB", samples, "ms");
+}
+
+}  // namespace base
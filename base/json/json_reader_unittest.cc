@@ -5,9 +5,11 @@
 #include "base/json/json_reader.h"
 
 #include "base/base_paths.h"
+#include "base/compiler_specific.h"
 #include "base/file_util.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/path_service.h"
+#include "base/string_number_conversions.h"
 #include "base/string_piece.h"
 #include "base/utf_string_conversions.h"
 #include "base/values.h"
@@ -16,6 +18,65 @@
 
 namespace base {
 
+namespace {
+
+// Records the events it receives as a compact string.
+class RecordingDelegate : public JSONReader::Delegate {
+ public:
+  // Stops parsing at the first string equal to |stop_at| if non-empty.
+  explicit RecordingDelegate(const std::string& stop_at)
+      : stop_at_(stop_at) {}
+
+  const std::string& events() const { return events_; }
+
+  virtual bool OnNull() OVERRIDE {
+    events_ += "null ";
+    return true;
+  }
+  virtual bool OnBoolean(bool value) OVERRIDE {
+    events_ += value ? "true " : "false ";
+    return true;
+  }
+  virtual bool OnInteger(int value) OVERRIDE {
+    events_ += "i" + IntToString(value) + " ";
+    return true;
+  }
+  virtual bool OnDouble(double value) OVERRIDE {
+    events_ += "d" + DoubleToString(value) + " ";
+    return true;
+  }
+  virtual bool OnString(const std::string& value) OVERRIDE {
+    events_ += "'" + value + "' ";
+    return stop_at_.empty() || value != stop_at_;
+  }
+  virtual bool OnListBegin() OVERRIDE {
+    events_ += "[ ";
+    return true;
+  }
+  virtual bool OnListEnd() OVERRIDE {
+    events_ += "] ";
+    return true;
+  }
+  virtual bool OnDictionaryBegin() OVERRIDE {
+    events_ += "{ ";
+    return true;
+  }
+  virtual bool OnDictionaryKey(const std::string& key) OVERRIDE {
+    events_ += key + ": ";
+    return true;
+  }
+  virtual bool OnDictionaryEnd() OVERRIDE {
+    events_ += "} ";
+    return true;
+  }
+
+ private:
+  std::string stop_at_;
+  std::string events_;
+};
+
+}  // namespace
+
 TEST(JSONReaderTest, Reading) {
   // some whitespace checking
   scoped_ptr<Value> root;
@@ -607,4 +668,32 @@ TEST(JSONReaderTest, ErrorMessages) {
   EXPECT_EQ(JSONReader::JSON_INVALID_ESCAPE, error_code);
 }
 
+TEST(JSONReaderTest, Delegate) {
+  RecordingDelegate delegate("");
+  EXPECT_TRUE(JSONReader::ReadWithDelegate(
+      "{\"a\": [1, 2.5, \"x\\ny\"], \"b\": {\"c\": null}, \"d\": true}",
+      JSON_PARSE_RFC, &delegate, NULL, NULL));
+  EXPECT_EQ("{ a: [ i1 d2.5 'x\ny' ] b: { c: null } d: true } ",
+            delegate.events());
+
+  // Errors are reported like ReadAndReturnError() does, after the events
+  // that preceded them.
+  RecordingDelegate bad_delegate("");
+  int error_code = 0;
+  std::string error_message;
+  EXPECT_FALSE(JSONReader::ReadWithDelegate("[false,]", JSON_PARSE_RFC,
+                                            &bad_delegate, &error_code,
+                                            &error_message));
+  EXPECT_EQ("[ false ", bad_delegate.events());
+  EXPECT_EQ(JSONReader::JSON_TRAILING_COMMA, error_code);
+  EXPECT_FALSE(error_message.empty());
+
+  // The delegate can stop parsing early.
+  RecordingDelegate stopping_delegate("stop");
+  EXPECT_FALSE(JSONReader::ReadWithDelegate("[\"go\", \"stop\", \"more\"]",
+                                            JSON_PARSE_RFC,
+                                            &stopping_delegate, NULL, NULL));
+  EXPECT_EQ("[ 'go' 'stop' ", stopping_delegate.events());
+}
+
 }  // namespace base
@@ -0,0 +1,75 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/perftimer.h"
+#include "base/threading/thread.h"
+#include "base/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const int kNumTasks = 1000000;
+
+// The number of tasks posted before the loop gets to run them.
+const int kBatchSize = 100;
+
+void IncrementCounter(int* counter) {
+  ++(*counter);
+}
+
+}  // namespace
+
+// Posts and runs tasks on the current loop, as a thread posting to itself
+// does.
+TEST(MessageLoopPerfTest, PostTaskToSelf) {
+  MessageLoop message_loop;
+  std::vector<double> samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    int counter = 0;
+    Closure task = Bind(&IncrementCounter, &counter);
+
+    PerfTimer timer;
+    for (int i = 0; i < kNumTasks / kBatchSize; ++i) {
+      for (int j = 0; j < kBatchSize; ++j)
+        message_loop.PostTask(FROM_HERE, task);
+      message_loop.RunAllPending();
+    }
+    TimeDelta elapsed = timer.Elapsed();
+    EXPECT_EQ(kNumTasks, counter);
+    samples.push_back(kNumTasks / elapsed.InSecondsF());
+  }
+
+  LogPerfResultSamples("MessageLoop_post_task_to_self", samples, "tasks/s");
+}
+
+// Posts tasks from this thread to another thread's loop.
+TEST(MessageLoopPerfTest, PostTaskToOtherThread) {
+  std::vector<double> samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    Thread thread("PostTaskToOtherThread");
+    ASSERT_TRUE(thread.Start());
+    int counter = 0;
+    Closure task = Bind(&IncrementCounter, &counter);
+
+    PerfTimer timer;
+    for (int i = 0; i < kNumTasks; ++i)
+      thread.message_loop()->PostTask(FROM_HERE, task);
+    thread.Stop();
+    TimeDelta elapsed = timer.Elapsed();
+    EXPECT_EQ(kNumTasks, counter);
+    samples.push_back(kNumTasks / elapsed.InSecondsF());
+  }
+
+  LogPerfResultSamples("MessageLoop_post_task_to_other_thread", samples,
+                       "tasks/s");
+}
+
+}  // namespace base
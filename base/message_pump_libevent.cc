@@ -177,15 +177,27 @@ bool MessagePumpLibevent::WatchFileDescriptor(int fd,
     // Combine old/new event masks.
     event_mask |= old_interest_mask;
 
-    // Must disarm the event before we can reuse it.
-    event_del(evt.get());
-
     // It's illegal to use this function to listen on 2 separate fds with the
     // same |controller|.
     if (EVENT_FD(evt.get()) != fd) {
+      event_del(evt.get());
       NOTREACHED() << "FDs don't match" << EVENT_FD(evt.get()) << "!=" << fd;
       return false;
     }
+
+    // A persistent event that is still registered with this pump for
+    // everything asked for can be kept as is. Disarming and re-adding it
+    // would cost two epoll_ctl() calls for no change.
+    if ((old_interest_mask & EV_PERSIST) && event_mask == old_interest_mask &&
+        controller->pump() == this &&
+        event_pending(evt.get(), EV_READ | EV_WRITE, NULL)) {
+      controller->Init(evt.release(), persistent);
+      controller->set_watcher(delegate);
+      return true;
+    }
+
+    // Must disarm the event before we can reuse it.
+    event_del(evt.get());
   }
 
   // Set current interest mask and message pump for this event.
@@ -373,10 +385,12 @@ void MessagePumpLibevent::OnWakeup(int socket, short flags, void* context) {
               static_cast<base::MessagePumpLibevent*>(context);
   DCHECK(that->wakeup_pipe_out_ == socket);
 
-  // Remove and discard the wakeup byte.
-  char buf;
-  int nread = HANDLE_EINTR(read(socket, &buf, 1));
-  DCHECK_EQ(nread, 1);
+  // Remove and discard the wakeup bytes. Several ScheduleWork() calls may
+  // have landed since the last wakeup; draining them together keeps the pipe
+  // from waking the next event_base_loop() for work that was already done.
+  char buf[64];
+  int nread = HANDLE_EINTR(read(socket, buf, sizeof(buf)));
+  DCHECK_GT(nread, 0);
   that->processed_io_events_ = true;
   // Tell libevent to break out of inner loop.
   event_base_loopbreak(that->event_base_);
@@ -6,6 +6,7 @@
 
 #include <unistd.h>
 
+#include "base/eintr_wrapper.h"
 #include "base/message_loop.h"
 #include "base/threading/thread.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -42,6 +43,10 @@ class MessagePumpLibeventTest : public testing::Test {
     pump->OnLibeventNotification(0, EV_WRITE | EV_READ, controller);
   }
 
+  event* GetEvent(MessagePumpLibevent::FileDescriptorWatcher* controller) {
+    return controller->event_;
+  }
+
   MessageLoop ui_loop_;
   Thread io_thread_;
 };
@@ -140,6 +145,36 @@ TEST_F(MessagePumpLibeventTest, StopWatcher) {
   OnLibeventNotification(pump, &watcher);
 }
 
+TEST_F(MessagePumpLibeventTest, RewatchPersistent) {
+  int pipefds[2];
+  ASSERT_EQ(0, pipe(pipefds));
+  scoped_refptr<MessagePumpLibevent> pump(new MessagePumpLibevent);
+  StupidWatcher delegate;
+  {
+    MessagePumpLibevent::FileDescriptorWatcher watcher;
+    ASSERT_TRUE(pump->WatchFileDescriptor(
+        pipefds[0], true, MessagePumpLibevent::WATCH_READ, &watcher,
+        &delegate));
+    event* e = GetEvent(&watcher);
+
+    // Watching again for the same thing keeps the registration.
+    ASSERT_TRUE(pump->WatchFileDescriptor(
+        pipefds[0], true, MessagePumpLibevent::WATCH_READ, &watcher,
+        &delegate));
+    EXPECT_EQ(e, GetEvent(&watcher));
+    EXPECT_EQ(EV_READ, event_pending(e, EV_READ | EV_WRITE, NULL));
+
+    // Asking for more re-registers with the combined mask.
+    ASSERT_TRUE(pump->WatchFileDescriptor(
+        pipefds[0], true, MessagePumpLibevent::WATCH_WRITE, &watcher,
+        &delegate));
+    EXPECT_EQ(EV_READ | EV_WRITE,
+              event_pending(GetEvent(&watcher), EV_READ | EV_WRITE, NULL));
+  }
+  EXPECT_EQ(0, HANDLE_EINTR(close(pipefds[0])));
+  EXPECT_EQ(0, HANDLE_EINTR(close(pipefds[1])));
+}
+
 }  // namespace
 
 }  // namespace base
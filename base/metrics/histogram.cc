@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <string>
 
+#include "base/atomicops.h"
 #include "base/debug/leak_annotations.h"
 #include "base/logging.h"
 #include "base/pickle.h"
@@ -393,10 +394,10 @@ size_t Histogram::bucket_count() const {
   return bucket_count_;
 }
 
-// Do a safe atomic snapshot of sample data.
-// This implementation assumes we are on a safe single thread.
+// Snapshot the sample data. Samples may be added concurrently, so the copy
+// can be off by the samples being recorded at that moment, but every sample
+// recorded before the call is included.
 void Histogram::SnapshotSample(SampleSet* sample) const {
-  // Note locking not done in this version!!!
   *sample = sample_;
 }
 
@@ -551,9 +552,9 @@ const std::string Histogram::GetAsciiBucketRange(size_t i) const {
   return result;
 }
 
-// Update histogram data with new sample.
+// Update histogram data with new sample. This is lock free, see
+// SampleSet::Accumulate().
 void Histogram::Accumulate(Sample value, Count count, size_t index) {
-  // Note locking not done in this version!!!
   sample_.Accumulate(value, count, index);
 }
 
@@ -721,9 +722,26 @@ void Histogram::SampleSet::CheckSize(const Histogram& histogram) const {
 void Histogram::SampleSet::Accumulate(Sample value,  Count count,
                                       size_t index) {
   DCHECK(count == 1 || count == -1);
-  counts_[index] += count;
+  // Histograms are updated from any thread without a lock, so use atomic
+  // increments to avoid losing samples that are recorded concurrently.
+  COMPILE_ASSERT(sizeof(Count) == sizeof(subtle::Atomic32),
+                 count_must_be_atomic32);
+  subtle::NoBarrier_AtomicIncrement(
+      reinterpret_cast<subtle::Atomic32*>(&counts_[index]), count);
+#if defined(ARCH_CPU_64_BITS)
+  COMPILE_ASSERT(sizeof(int64) == sizeof(subtle::Atomic64),
+                 int64_must_be_atomic64);
+  subtle::NoBarrier_AtomicIncrement(
+      reinterpret_cast<subtle::Atomic64*>(&sum_),
+      static_cast<int64>(count) * value);
+  subtle::NoBarrier_AtomicIncrement(
+      reinterpret_cast<subtle::Atomic64*>(&redundant_count_), count);
+#else
+  // There are no 64 bit atomics here. A lost update only skews the mean, or
+  // shows up as a count mismatch in FindCorruption(), as it always has.
   sum_ += count * value;
   redundant_count_ += count;
+#endif
   DCHECK_GE(counts_[index], 0);
   DCHECK_GE(sum_, 0);
   DCHECK_GE(redundant_count_, 0);
@@ -8,7 +8,9 @@
 #include <vector>
 
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/metrics/histogram.h"
+#include "base/threading/simple_thread.h"
 #include "base/time.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -347,6 +349,45 @@ TEST(HistogramTest, BucketPlacementTest) {
     EXPECT_EQ(i + 1, sample.counts(i));
 }
 
+// Adds |count| samples of |value| to |histogram|.
+class HistogramAdder : public DelegateSimpleThread::Delegate {
+ public:
+  HistogramAdder(Histogram* histogram, int value, int count)
+      : histogram_(histogram), value_(value), count_(count) {}
+
+  virtual void Run() OVERRIDE {
+    for (int i = 0; i < count_; ++i)
+      histogram_->Add(value_);
+  }
+
+ private:
+  Histogram* histogram_;
+  int value_;
+  int count_;
+};
+
+// Samples recorded concurrently from several threads must not be lost.
+TEST(HistogramTest, ConcurrentAddTest) {
+  const int kNumThreads = 4;
+  const int kSamplesPerThread = 100000;
+  Histogram* histogram(Histogram::FactoryGet(
+      "ConcurrentHistogram", 1, 64, 8, Histogram::kNoFlags));
+
+  ScopedVector<HistogramAdder> adders;
+  ScopedVector<DelegateSimpleThread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    adders.push_back(new HistogramAdder(histogram, 20, kSamplesPerThread));
+    threads.push_back(new DelegateSimpleThread(adders[i], "HistogramAdder"));
+    threads[i]->Start();
+  }
+  for (int i = 0; i < kNumThreads; ++i)
+    threads[i]->Join();
+
+  Histogram::SampleSet snapshot;
+  histogram->SnapshotSample(&snapshot);
+  EXPECT_EQ(kNumThreads * kSamplesPerThread, snapshot.TotalCount());
+}
+
 }  // namespace
 
 //------------------------------------------------------------------------------
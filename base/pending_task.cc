@@ -4,6 +4,8 @@
 
 #include "base/pending_task.h"
 
+#include <algorithm>
+
 #include "base/tracked_objects.h"
 
 namespace base {
@@ -47,8 +49,45 @@ bool PendingTask::operator<(const PendingTask& other) const {
   return (sequence_num - other.sequence_num) > 0;
 }
 
+namespace {
+
+// A drained TaskQueue holding room for more than this many tasks gives the
+// memory back rather than keeping it for the next batch.
+const size_t kMaxRetainedCapacity = 256;
+
+}  // namespace
+
+TaskQueue::TaskQueue() : front_(0) {
+}
+
+TaskQueue::~TaskQueue() {
+}
+
+void TaskQueue::pop() {
+  DCHECK(!empty());
+  // Release whatever the task has bound now rather than when its slot is
+  // reused, as popping from a std::queue would.
+  tasks_[front_].task.Reset();
+  ++front_;
+
+  if (front_ == tasks_.size()) {
+    if (tasks_.capacity() > kMaxRetainedCapacity)
+      std::vector<PendingTask>().swap(tasks_);
+    else
+      tasks_.clear();  // Keeps the storage.
+    front_ = 0;
+  } else if (front_ >= kMaxRetainedCapacity && front_ * 2 >= tasks_.size()) {
+    // A queue that is pushed to while it's drained may never empty. Drop the
+    // popped tasks once they are the larger part of the array; this moves no
+    // more tasks than were popped since the last time.
+    tasks_.erase(tasks_.begin(), tasks_.begin() + front_);
+    front_ = 0;
+  }
+}
+
 void TaskQueue::Swap(TaskQueue* queue) {
-  c.swap(queue->c);  // Calls std::deque::swap.
+  tasks_.swap(queue->tasks_);  // Constant time.
+  std::swap(front_, queue->front_);
 }
 
 }  // namespace base
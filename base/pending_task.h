@@ -7,10 +7,13 @@
 #pragma once
 
 #include <queue>
+#include <vector>
 
 #include "base/base_export.h"
+#include "base/basictypes.h"
 #include "base/callback.h"
 #include "base/location.h"
+#include "base/logging.h"
 #include "base/time.h"
 #include "base/tracking_info.h"
 
@@ -43,11 +46,42 @@ struct BASE_EXPORT PendingTask : public TrackingInfo {
   bool nestable;
 };
 
-// Wrapper around std::queue specialized for PendingTask which adds a Swap
-// helper method.
-class BASE_EXPORT TaskQueue : public std::queue<PendingTask> {
+// FIFO queue of PendingTasks with a constant time Swap. The tasks are kept in
+// one array whose storage is reused once the queue has been drained, so a
+// MessageLoop that swaps its incoming and work queues back and forth doesn't
+// allocate for each task posted, as std::queue's deque blocks would.
+class BASE_EXPORT TaskQueue {
  public:
+  TaskQueue();
+  ~TaskQueue();
+
+  bool empty() const { return front_ == tasks_.size(); }
+  size_t size() const { return tasks_.size() - front_; }
+
+  PendingTask& front() {
+    DCHECK(!empty());
+    return tasks_[front_];
+  }
+  const PendingTask& front() const {
+    DCHECK(!empty());
+    return tasks_[front_];
+  }
+
+  void push(const PendingTask& pending_task) {
+    tasks_.push_back(pending_task);
+  }
+  void pop();
+
   void Swap(TaskQueue* queue);
+
+ private:
+  std::vector<PendingTask> tasks_;
+
+  // Index in |tasks_| of the next task to run. The tasks before it have
+  // already been popped.
+  size_t front_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskQueue);
 };
 
 // PendingTasks are sorted by their |delayed_run_time| property.
@@ -0,0 +1,89 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/pending_task.h"
+
+#include "base/bind.h"
+#include "base/memory/ref_counted.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+class RefCountedObject : public RefCounted<RefCountedObject> {
+ private:
+  friend class RefCounted<RefCountedObject>;
+  ~RefCountedObject() {}
+};
+
+void TakeObject(RefCountedObject* object) {}
+
+PendingTask MakeTask(int sequence_num) {
+  PendingTask pending_task(FROM_HERE, Bind(&TakeObject,
+                                           scoped_refptr<RefCountedObject>()));
+  pending_task.sequence_num = sequence_num;
+  return pending_task;
+}
+
+}  // namespace
+
+TEST(TaskQueueTest, FirstInFirstOut) {
+  TaskQueue queue;
+  EXPECT_TRUE(queue.empty());
+
+  // Interleave the pushes and pops so the popped tasks have to be dropped
+  // from the front while the queue is never empty.
+  int next_pushed = 0;
+  int next_popped = 0;
+  for (int round = 0; round < 1000; ++round) {
+    for (int i = 0; i < 3; ++i)
+      queue.push(MakeTask(next_pushed++));
+    for (int i = 0; i < 2; ++i) {
+      ASSERT_FALSE(queue.empty());
+      EXPECT_EQ(next_popped++, queue.front().sequence_num);
+      queue.pop();
+    }
+    EXPECT_EQ(static_cast<size_t>(next_pushed - next_popped), queue.size());
+  }
+
+  while (!queue.empty()) {
+    EXPECT_EQ(next_popped++, queue.front().sequence_num);
+    queue.pop();
+  }
+  EXPECT_EQ(next_pushed, next_popped);
+  EXPECT_EQ(0u, queue.size());
+}
+
+TEST(TaskQueueTest, Swap) {
+  TaskQueue first;
+  TaskQueue second;
+  first.push(MakeTask(1));
+  first.push(MakeTask(2));
+  first.pop();
+  second.push(MakeTask(3));
+  second.push(MakeTask(4));
+  second.push(MakeTask(5));
+
+  first.Swap(&second);
+  ASSERT_EQ(3u, first.size());
+  EXPECT_EQ(3, first.front().sequence_num);
+  ASSERT_EQ(1u, second.size());
+  EXPECT_EQ(2, second.front().sequence_num);
+}
+
+// Popping a task releases what it has bound, even though the storage for it
+// is kept.
+TEST(TaskQueueTest, PopReleasesTask) {
+  scoped_refptr<RefCountedObject> object(new RefCountedObject);
+  TaskQueue queue;
+  queue.push(PendingTask(FROM_HERE, Bind(&TakeObject, object)));
+  queue.push(MakeTask(0));
+  EXPECT_FALSE(object->HasOneRef());
+
+  queue.pop();
+  EXPECT_TRUE(object->HasOneRef());
+}
+
+}  // namespace base
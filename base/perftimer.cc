@@ -4,16 +4,31 @@
 
 #include "base/perftimer.h"
 
+#include <math.h>
 #include <stdio.h>
 #include <string>
 
 #include "base/basictypes.h"
+#include "base/command_line.h"
 #include "base/file_path.h"
 #include "base/file_util.h"
 #include "base/logging.h"
+#include "base/string_number_conversions.h"
 
 static FILE* perf_log_file = NULL;
 
+static const int kDefaultPerfRepetitions = 5;
+
+// Two-sided 95% critical values of Student's t distribution, indexed by
+// degrees of freedom minus one.
+static const double kStudentT95[] = {
+  12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+};
+// The normal approximation used past the end of the table.
+static const double kNormal95 = 1.960;
+
 bool InitPerfLog(const FilePath& log_file) {
   if (perf_log_file) {
     // trying to initialize twice
@@ -43,3 +58,49 @@ void LogPerfResult(const char* test_name, double value, const char* units) {
   fprintf(perf_log_file, "%s\t%g\t%s\n", test_name, value, units);
   printf("%s\t%g\t%s\n", test_name, value, units);
 }
+
+void LogPerfResultSamples(const char* test_name,
+                          const std::vector<double>& samples,
+                          const char* units) {
+  if (!perf_log_file) {
+    NOTREACHED();
+    return;
+  }
+  if (samples.empty()) {
+    NOTREACHED();
+    return;
+  }
+
+  size_t n = samples.size();
+  double sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += samples[i];
+  double mean = sum / n;
+
+  double stddev = 0;
+  double ci95 = 0;
+  if (n > 1) {
+    double squares = 0;
+    for (size_t i = 0; i < n; ++i)
+      squares += (samples[i] - mean) * (samples[i] - mean);
+    stddev = sqrt(squares / (n - 1));
+    double t = n - 1 <= arraysize(kStudentT95) ? kStudentT95[n - 2] :
+                                                 kNormal95;
+    ci95 = t * stddev / sqrt(static_cast<double>(n));
+  }
+
+  const char kFormat[] = "%s\t%g\t%s\tn=%d\tstddev=%g\tci95=%g\n";
+  fprintf(perf_log_file, kFormat, test_name, mean, units,
+          static_cast<int>(n), stddev, ci95);
+  printf(kFormat, test_name, mean, units, static_cast<int>(n), stddev, ci95);
+}
+
+int GetPerfRepetitions() {
+  std::string value = CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+      "perf-repetitions");
+  int repetitions;
+  if (value.empty() || !base::StringToInt(value, &repetitions) ||
+      repetitions < 1)
+    return kDefaultPerfRepetitions;
+  return repetitions;
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/time.h"
@@ -28,6 +29,23 @@ void FinalizePerfLog();
 // ----------------------------------------------------------------------
 void LogPerfResult(const char* test_name, double value, const char* units);
 
+// ----------------------------------------------------------------------
+// LogPerfResultSamples
+//   Like LogPerfResult, but for a result measured once per repetition of
+//   a test. Logs the mean of |samples| followed by tab separated
+//   "n=", "stddev=" and "ci95=" fields, the last being the half width of
+//   the 95% confidence interval of the mean, so that tools comparing runs
+//   can tell a regression from noise.
+// ----------------------------------------------------------------------
+void LogPerfResultSamples(const char* test_name,
+                          const std::vector<double>& samples,
+                          const char* units);
+
+// Returns how many times a test should repeat its measurement to feed
+// LogPerfResultSamples. Defaults to 5 and can be set with the
+// --perf-repetitions switch.
+int GetPerfRepetitions();
+
 // ----------------------------------------------------------------------
 // PerfTimer
 //   A simple wrapper around Now()
@@ -300,6 +300,17 @@ void Pickle::TrimWriteData(int new_length) {
   *cur_length = new_length;
 }
 
+bool Pickle::Reserve(size_t length) {
+  DCHECK_NE(kCapacityReadOnly, capacity_) << "oops: pickle is readonly";
+
+  // Writes start at a uint32-aligned offset, as in BeginWrite.
+  size_t offset = AlignInt(header_->payload_size, sizeof(uint32));
+  size_t needed_size = header_size_ + offset + length;
+  if (needed_size > capacity_ && !Resize(std::max(capacity_ * 2, needed_size)))
+    return false;
+  return true;
+}
+
 char* Pickle::BeginWrite(size_t length) {
   // write at a uint32-aligned offset from the beginning of the header
   size_t offset = AlignInt(header_->payload_size, sizeof(uint32));
@@ -355,3 +366,19 @@ const char* Pickle::FindNext(size_t header_size,
 
   return (payload_end > end) ? NULL : payload_end;
 }
+
+// static
+bool Pickle::PeekNext(size_t header_size,
+                      const char* start,
+                      const char* end,
+                      size_t* pickle_size) {
+  DCHECK_EQ(header_size, AlignInt(header_size, sizeof(uint32)));
+  DCHECK_LE(header_size, static_cast<size_t>(kPayloadUnit));
+
+  if (static_cast<size_t>(end - start) < sizeof(Header))
+    return false;
+
+  const Header* hdr = reinterpret_cast<const Header*>(start);
+  *pickle_size = header_size + hdr->payload_size;
+  return true;
+}
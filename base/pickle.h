@@ -238,6 +238,11 @@ class BASE_EXPORT Pickle {
   // not been changed.
   void TrimWriteData(int length);
 
+  // Makes room for |length| more bytes of data so that a run of small writes
+  // whose total size is known up front needs at most one reallocation.
+  // Returns false if the buffer could not be grown.
+  bool Reserve(size_t length);
+
   // Payload follows after allocation of Header (header size is customizable).
   struct Header {
     uint32 payload_size;  // Specifies the size of the payload.
@@ -311,6 +316,14 @@ class BASE_EXPORT Pickle {
                               const char* range_start,
                               const char* range_end);
 
+  // Like FindNext, but only needs the header to be in the given data range.
+  // Returns true and sets |pickle_size| to the size of the whole Pickle, which
+  // may extend past |range_end|, if the header is there.
+  static bool PeekNext(size_t header_size,
+                       const char* range_start,
+                       const char* range_end,
+                       size_t* pickle_size);
+
   // The allocation granularity of the payload.
   static const int kPayloadUnit;
 
@@ -324,8 +337,10 @@ class BASE_EXPORT Pickle {
   size_t variable_buffer_offset_;  // IF non-zero, then offset to a buffer.
 
   FRIEND_TEST_ALL_PREFIXES(PickleTest, Resize);
+  FRIEND_TEST_ALL_PREFIXES(PickleTest, Reserve);
   FRIEND_TEST_ALL_PREFIXES(PickleTest, FindNext);
   FRIEND_TEST_ALL_PREFIXES(PickleTest, FindNextWithIncompleteHeader);
+  FRIEND_TEST_ALL_PREFIXES(PickleTest, PeekNext);
 };
 
 #endif  // BASE_PICKLE_H__
@@ -0,0 +1,84 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/pickle.h"
+
+#include <string>
+#include <vector>
+
+#include "base/perftimer.h"
+#include "base/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kNumPickles = 200000;
+
+// The fields of a typical small IPC message, such as a resource load update.
+void WriteSmallMessage(Pickle* pickle, const std::string& url) {
+  pickle->WriteInt(1);
+  pickle->WriteInt(42);
+  pickle->WriteInt64(12345678);
+  pickle->WriteBool(true);
+  pickle->WriteString(url);
+  pickle->WriteUInt32(200);
+}
+
+}  // namespace
+
+TEST(PicklePerfTest, WriteSmallMessages) {
+  const std::string url("http://www.example.com/images/logo.png");
+  std::vector<double> samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    PerfTimer timer;
+    for (int i = 0; i < kNumPickles; ++i) {
+      Pickle pickle;
+      WriteSmallMessage(&pickle, url);
+    }
+    samples.push_back(kNumPickles / timer.Elapsed().InSecondsF());
+  }
+  LogPerfResultSamples("Pickle_write_small_messages", samples, "pickles/s");
+}
+
+TEST(PicklePerfTest, ReadSmallMessages) {
+  const std::string url("http://www.example.com/images/logo.png");
+  Pickle pickle;
+  WriteSmallMessage(&pickle, url);
+
+  std::vector<double> samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    PerfTimer timer;
+    for (int i = 0; i < kNumPickles; ++i) {
+      PickleIterator iter(pickle);
+      int a, b;
+      int64 c;
+      bool d;
+      std::string e;
+      uint32 f;
+      ASSERT_TRUE(pickle.ReadInt(&iter, &a) && pickle.ReadInt(&iter, &b) &&
+                  pickle.ReadInt64(&iter, &c) && pickle.ReadBool(&iter, &d) &&
+                  pickle.ReadString(&iter, &e) &&
+                  pickle.ReadUInt32(&iter, &f));
+    }
+    samples.push_back(kNumPickles / timer.Elapsed().InSecondsF());
+  }
+  LogPerfResultSamples("Pickle_read_small_messages", samples, "pickles/s");
+}
+
+// Large payloads, as sent for clipboard data and resource bodies.
+TEST(PicklePerfTest, WriteLargeData) {
+  const std::string data(256 * 1024, 'x');
+  const int kNumLargePickles = 2000;
+  double megabytes = kNumLargePickles * data.size() / (1024.0 * 1024.0);
+  std::vector<double> samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    PerfTimer timer;
+    for (int i = 0; i < kNumLargePickles; ++i) {
+      Pickle pickle;
+      pickle.WriteData(data.data(), static_cast<int>(data.size()));
+    }
+    samples.push_back(megabytes / timer.Elapsed().InSecondsF());
+  }
+  LogPerfResultSamples("Pickle_write_256KB_data", samples, "MB/s");
+}
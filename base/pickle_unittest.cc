@@ -188,6 +188,28 @@ TEST(PickleTest, FindNextWithIncompleteHeader) {
   EXPECT_TRUE(NULL == Pickle::FindNext(header_size, start, end));
 }
 
+TEST(PickleTest, PeekNext) {
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteInt(1));
+  EXPECT_TRUE(pickle.WriteString("Domo"));
+
+  const char* start = reinterpret_cast<const char*>(pickle.data());
+  const char* end = start + pickle.size();
+
+  size_t pickle_size = 0;
+  EXPECT_TRUE(Pickle::PeekNext(pickle.header_size_, start, end, &pickle_size));
+  EXPECT_EQ(pickle.size(), pickle_size);
+
+  // Only the header is needed.
+  pickle_size = 0;
+  EXPECT_TRUE(Pickle::PeekNext(pickle.header_size_, start,
+                               start + sizeof(Pickle::Header), &pickle_size));
+  EXPECT_EQ(pickle.size(), pickle_size);
+  EXPECT_FALSE(Pickle::PeekNext(pickle.header_size_, start,
+                                start + sizeof(Pickle::Header) - 1,
+                                &pickle_size));
+}
+
 TEST(PickleTest, GetReadPointerAndAdvance) {
   Pickle pickle;
 
@@ -239,6 +261,28 @@ TEST(PickleTest, Resize) {
   EXPECT_EQ(cur_payload, pickle.payload_size());
 }
 
+TEST(PickleTest, Reserve) {
+  size_t unit = Pickle::kPayloadUnit;
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteInt(1));
+  size_t payload_size = pickle.payload_size();
+
+  // Reserving room for what already fits leaves the buffer alone.
+  EXPECT_TRUE(pickle.Reserve(sizeof(int)));
+  EXPECT_EQ(unit, pickle.capacity());
+
+  // Reserving more grows it once, and the writes that follow fit.
+  const int kInts = 40;
+  EXPECT_TRUE(pickle.Reserve(kInts * sizeof(int)));
+  size_t capacity = pickle.capacity();
+  EXPECT_LE(sizeof(Pickle::Header) + payload_size + kInts * sizeof(int),
+            capacity);
+  for (int i = 0; i < kInts; ++i)
+    EXPECT_TRUE(pickle.WriteInt(i));
+  EXPECT_EQ(capacity, pickle.capacity());
+  EXPECT_EQ(payload_size + kInts * sizeof(int), pickle.payload_size());
+}
+
 namespace {
 
 struct CustomHeader : Pickle::Header {
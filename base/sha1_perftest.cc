@@ -0,0 +1,54 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/sha1.h"
+
+#include <string>
+#include <vector>
+
+#include "base/perftimer.h"
+#include "base/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// The number of bytes hashed by each test.
+const size_t kTotalBytes = 64 * 1024 * 1024;
+
+// Hashes kTotalBytes as inputs of |input_size| bytes each, and logs the
+// throughput.
+void RunSHA1Test(size_t input_size, const char* name) {
+  std::string input(input_size, 'a');
+  unsigned char hash[kSHA1Length];
+
+  double megabytes = kTotalBytes / (1024.0 * 1024.0);
+  std::vector<double> samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    PerfTimer timer;
+    for (size_t hashed = 0; hashed < kTotalBytes; hashed += input_size) {
+      SHA1HashBytes(reinterpret_cast<const unsigned char*>(input.data()),
+                    input.size(), hash);
+    }
+    TimeDelta elapsed = timer.Elapsed();
+    samples.push_back(megabytes / elapsed.InSecondsF());
+  }
+
+  LogPerfResultSamples(name, samples, "MB/s");
+}
+
+}  // namespace
+
+// Prefixes and keys, as hashed by Safe Browsing and sync.
+TEST(SHA1PerfTest, SmallInputs) {
+  RunSHA1Test(32, "SHA1_32_bytes");
+}
+
+// Disk cache entries and extension files.
+TEST(SHA1PerfTest, LargeInputs) {
+  RunSHA1Test(1024 * 1024, "SHA1_1_MB");
+}
+
+}  // namespace base
@@ -6,6 +6,8 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include "base/basictypes.h"
 
 namespace base {
@@ -60,37 +62,33 @@ class SecureHashAlgorithm {
   };
 
   uint32 cursor;
-  uint32 l;
+  // Message length in bits.
+  uint64 l;
 };
 
-static inline uint32 f(uint32 t, uint32 B, uint32 C, uint32 D) {
-  if (t < 20) {
-    return (B & C) | ((~B) & D);
-  } else if (t < 40) {
-    return B ^ C ^ D;
-  } else if (t < 60) {
-    return (B & C) | (B & D) | (C & D);
-  } else {
-    return B ^ C ^ D;
-  }
-}
-
 static inline uint32 S(uint32 n, uint32 X) {
   return (X << n) | (X >> (32-n));
 }
 
-static inline uint32 K(uint32 t) {
-  if (t < 20) {
-    return 0x5a827999;
-  } else if (t < 40) {
-    return 0x6ed9eba1;
-  } else if (t < 60) {
-    return 0x8f1bbcdc;
-  } else {
-    return 0xca62c1d6;
-  }
+// The round functions and constants, one per group of 20 rounds. Ch and Maj
+// are in the forms that need the fewest operations.
+static inline uint32 Ch(uint32 B, uint32 C, uint32 D) {
+  return D ^ (B & (C ^ D));
 }
 
+static inline uint32 Parity(uint32 B, uint32 C, uint32 D) {
+  return B ^ C ^ D;
+}
+
+static inline uint32 Maj(uint32 B, uint32 C, uint32 D) {
+  return (B & C) | (D & (B | C));
+}
+
+static const uint32 kK0 = 0x5a827999;
+static const uint32 kK1 = 0x6ed9eba1;
+static const uint32 kK2 = 0x8f1bbcdc;
+static const uint32 kK3 = 0xca62c1d6;
+
 static inline void swapends(uint32* t) {
   *t = ((*t & 0xff000000) >> 24) |
        ((*t & 0xff0000) >> 8) |
@@ -125,11 +123,16 @@ void SecureHashAlgorithm::Final() {
 
 void SecureHashAlgorithm::Update(const void* data, size_t nbytes) {
   const uint8* d = reinterpret_cast<const uint8*>(data);
-  while (nbytes--) {
-    M[cursor++] = *d++;
-    if (cursor >= 64)
+  l += static_cast<uint64>(nbytes) * 8;
+  while (nbytes) {
+    // Copy as much of the input as fits in the current block at once.
+    size_t n = std::min(nbytes, static_cast<size_t>(64 - cursor));
+    memcpy(M + cursor, d, n);
+    cursor += n;
+    d += n;
+    nbytes -= n;
+    if (cursor == 64)
       Process();
-    l += 8;
   }
 }
 
@@ -144,13 +147,11 @@ void SecureHashAlgorithm::Pad() {
     Process();
   }
 
-  while (cursor < 64-4)
+  while (cursor < 64-8)
     M[cursor++] = 0;
 
-  M[64-4] = (l & 0xff000000) >> 24;
-  M[64-3] = (l & 0xff0000) >> 16;
-  M[64-2] = (l & 0xff00) >> 8;
-  M[64-1] = (l & 0xff);
+  for (int i = 0; i < 8; ++i)
+    M[64-8+i] = static_cast<uint8>(l >> (56 - 8 * i));
 }
 
 void SecureHashAlgorithm::Process() {
@@ -176,15 +177,26 @@ void SecureHashAlgorithm::Process() {
   D = H[3];
   E = H[4];
 
-  // d.
-  for (t = 0; t < 80; ++t) {
-    uint32 TEMP = S(5, A) + f(t, B, C, D) + E + W[t] + K(t);
-    E = D;
-    D = C;
-    C = S(30, B);
-    B = A;
-    A = TEMP;
+  // d. The 80 rounds are split by the function and constant they use, so
+  // that neither is chosen per round.
+#define SHA1_ROUND(F, K)                                    \
+  {                                                         \
+    uint32 TEMP = S(5, A) + F(B, C, D) + E + W[t] + K;      \
+    E = D;                                                  \
+    D = C;                                                  \
+    C = S(30, B);                                           \
+    B = A;                                                  \
+    A = TEMP;                                               \
   }
+  for (t = 0; t < 20; ++t)
+    SHA1_ROUND(Ch, kK0);
+  for (; t < 40; ++t)
+    SHA1_ROUND(Parity, kK1);
+  for (; t < 60; ++t)
+    SHA1_ROUND(Maj, kK2);
+  for (; t < 80; ++t)
+    SHA1_ROUND(Parity, kK3);
+#undef SHA1_ROUND
 
   // e.
   H[0] += A;
@@ -174,11 +174,11 @@ class StringTokenizerT {
       if (token_end_ == end_)
         return false;
       ++token_end_;
-      if (delims_.find(*token_begin_) == str::npos)
+      if (!IsDelim(*token_begin_))
         break;
       // else skip over delimiter.
     }
-    while (token_end_ != end_ && delims_.find(*token_end_) == str::npos)
+    while (token_end_ != end_ && !IsDelim(*token_end_))
       ++token_end_;
     return true;
   }
@@ -206,6 +206,10 @@ class StringTokenizerT {
   }
 
   bool IsDelim(char_type c) const {
+    // Most tokenizers split on a single character, which is cheaper to compare
+    // against directly than to search for in |delims_|.
+    if (delims_.size() == 1)
+      return c == delims_[0];
     return delims_.find(c) != str::npos;
   }
 
@@ -4,7 +4,7 @@
 
 #include "base/threading/sequenced_worker_pool.h"
 
-#include <list>
+#include <deque>
 #include <map>
 #include <set>
 #include <utility>
@@ -38,16 +38,28 @@ namespace {
 struct SequencedTask {
   SequencedTask()
       : sequence_token_id(0),
+        sequence_task_number(0),
         shutdown_behavior(SequencedWorkerPool::BLOCK_SHUTDOWN) {}
 
   ~SequencedTask() {}
 
   int sequence_token_id;
+  // Order in which the task was posted to the pool. Runnable tasks are run in
+  // this order.
+  int64 sequence_task_number;
   SequencedWorkerPool::WorkerShutdown shutdown_behavior;
   tracked_objects::Location location;
   Closure task;
 };
 
+// Orders tasks by the time they were posted.
+struct SequencedTaskLessThan {
+ public:
+  bool operator()(const SequencedTask& lhs, const SequencedTask& rhs) const {
+    return lhs.sequence_task_number < rhs.sequence_task_number;
+  }
+};
+
 // SequencedWorkerPoolTaskRunner ---------------------------------------------
 // A TaskRunner which posts tasks to a SequencedWorkerPool with a
 // fixed ShutdownBehavior.
@@ -352,9 +364,9 @@ class SequencedWorkerPool::Inner {
   int WillRunWorkerTask(const SequencedTask& task);
   void DidRunWorkerTask(const SequencedTask& task);
 
-  // Returns true if there are no threads currently running the given
-  // sequence token.
-  bool IsSequenceTokenRunnable(int sequence_token_id) const;
+  // Makes the next pending task of |sequence_token_id|, if any, runnable.
+  // Called once the current task of that sequence has run or been dropped.
+  void PromoteNextTaskInSequence(int sequence_token_id);
 
   // Checks if all threads are busy and the addition of one more could run an
   // additional task waiting in the queue. This must be called from within
@@ -432,20 +444,26 @@ class SequencedWorkerPool::Inner {
   // flag set.
   size_t blocking_shutdown_thread_count_;
 
-  // In-order list of all pending tasks. These are tasks waiting for a thread
-  // to run on or that are blocked on a previous task in their sequence.
-  //
-  // We maintain the pending_task_count_ separately for metrics because
-  // list.size() can be linear time.
-  std::list<SequencedTask> pending_tasks_;
+  // Tasks that can run as soon as a thread is available, in posting order.
+  // A sequenced task is only here while no other task of its sequence is
+  // running or runnable, so workers never have to skip over blocked tasks
+  // while holding the lock.
+  typedef std::set<SequencedTask, SequencedTaskLessThan> RunnableTaskSet;
+  RunnableTaskSet runnable_tasks_;
+
+  // For every sequence that has a task running or in |runnable_tasks_|, the
+  // tasks of that sequence posted after it, in order.
+  typedef std::map<int, std::deque<SequencedTask> > BlockedTaskMap;
+  BlockedTaskMap blocked_tasks_;
+
+  // Number of tasks in |runnable_tasks_| and |blocked_tasks_|.
   size_t pending_task_count_;
 
-  // Number of tasks in the pending_tasks_ list that are marked as blocking
-  // shutdown.
+  // Number of pending tasks that are marked as blocking shutdown.
   size_t blocking_shutdown_pending_task_count_;
 
-  // Lists all sequence tokens currently executing.
-  std::set<int> current_sequences_;
+  // Number used to order the next posted task.
+  int64 next_sequence_task_number_;
 
   // Set when Shutdown is called and no further tasks should be
   // allowed, though we may still be running existing tasks.
@@ -502,6 +520,7 @@ SequencedWorkerPool::Inner::Inner(
       blocking_shutdown_thread_count_(0),
       pending_task_count_(0),
       blocking_shutdown_pending_task_count_(0),
+      next_sequence_task_number_(0),
       shutdown_called_(false),
       testing_observer_(observer) {}
 
@@ -554,7 +573,20 @@ bool SequencedWorkerPool::Inner::PostTask(
     if (optional_token_name)
       sequenced.sequence_token_id = LockedGetNamedTokenID(*optional_token_name);
 
-    pending_tasks_.push_back(sequenced);
+    sequenced.sequence_task_number = next_sequence_task_number_++;
+    if (!sequenced.sequence_token_id) {
+      runnable_tasks_.insert(sequenced);
+    } else {
+      BlockedTaskMap::iterator blocked =
+          blocked_tasks_.find(sequenced.sequence_token_id);
+      if (blocked == blocked_tasks_.end()) {
+        // Nothing else in this sequence is pending or running.
+        blocked_tasks_[sequenced.sequence_token_id];
+        runnable_tasks_.insert(sequenced);
+      } else {
+        blocked->second.push_back(sequenced);
+      }
+    }
     pending_task_count_++;
     if (shutdown_behavior == BLOCK_SHUTDOWN)
       blocking_shutdown_pending_task_count_++;
@@ -732,50 +764,26 @@ bool SequencedWorkerPool::Inner::GetWork(
     std::vector<Closure>* delete_these_outside_lock) {
   lock_.AssertAcquired();
 
-  DCHECK_EQ(pending_tasks_.size(), pending_task_count_);
   UMA_HISTOGRAM_COUNTS_100("SequencedWorkerPool.TaskCount",
                            static_cast<int>(pending_task_count_));
 
-  // Find the next task with a sequence token that's not currently in use.
-  // If the token is in use, that means another thread is running something
-  // in that sequence, and we can't run it without going out-of-order.
-  //
-  // This algorithm is simple and fair, but inefficient in some cases. For
-  // example, say somebody schedules 1000 slow tasks with the same sequence
-  // number. We'll have to go through all those tasks each time we feel like
-  // there might be work to schedule. If this proves to be a problem, we
-  // should make this more efficient.
-  //
-  // One possible enhancement would be to keep a map from sequence ID to a
-  // list of pending but currently blocked SequencedTasks for that ID.
-  // When a worker finishes a task of one sequence token, it can pick up the
-  // next one from that token right away.
-  //
-  // This may lead to starvation if there are sufficient numbers of sequences
-  // in use. To alleviate this, we could add an incrementing priority counter
-  // to each SequencedTask. Then maintain a priority_queue of all runnable
-  // tasks, sorted by priority counter. When a sequenced task is completed
-  // we would pop the head element off of that tasks pending list and add it
-  // to the priority queue. Then we would run the first item in the priority
-  // queue.
-  bool found_task = false;
-  int unrunnable_tasks = 0;
-  std::list<SequencedTask>::iterator i = pending_tasks_.begin();
-  while (i != pending_tasks_.end()) {
-    if (!IsSequenceTokenRunnable(i->sequence_token_id)) {
-      unrunnable_tasks++;
-      ++i;
-      continue;
-    }
+  // Take the oldest runnable task. Tasks blocked behind a running task of
+  // their sequence are kept in |blocked_tasks_| and are never looked at here,
+  // so this is constant time no matter how many of them there are.
+  while (!runnable_tasks_.empty()) {
+    RunnableTaskSet::iterator i = runnable_tasks_.begin();
+    SequencedTask next = *i;
+    runnable_tasks_.erase(i);
+    pending_task_count_--;
 
-    if (shutdown_called_ && i->shutdown_behavior != BLOCK_SHUTDOWN) {
+    if (shutdown_called_ && next.shutdown_behavior != BLOCK_SHUTDOWN) {
       // We're shutting down and the task we just found isn't blocking
       // shutdown. Delete it and get more work.
       //
-      // Note that we do not want to delete unrunnable tasks. Deleting a task
-      // can have side effects (like freeing some objects) and deleting a
-      // task that's supposed to run after one that's currently running could
-      // cause an obscure crash.
+      // Note that we do not want to delete blocked tasks before their turn.
+      // Deleting a task can have side effects (like freeing some objects) and
+      // deleting a task that's supposed to run after one that's currently
+      // running could cause an obscure crash.
       //
       // We really want to delete these tasks outside the lock in case the
       // closures are holding refs to objects that want to post work from
@@ -784,38 +792,25 @@ bool SequencedWorkerPool::Inner::GetWork(
       // until the lock is exited. The calling code can just clear() the
       // vector they passed to us once the lock is exited to make this
       // happen.
-      delete_these_outside_lock->push_back(i->task);
-      i = pending_tasks_.erase(i);
-      pending_task_count_--;
-    } else {
-      // Found a runnable task.
-      *task = *i;
-      i = pending_tasks_.erase(i);
-      pending_task_count_--;
-      if (task->shutdown_behavior == BLOCK_SHUTDOWN) {
-        blocking_shutdown_pending_task_count_--;
-      }
-
-      found_task = true;
-      break;
+      delete_these_outside_lock->push_back(next.task);
+      if (next.sequence_token_id)
+        PromoteNextTaskInSequence(next.sequence_token_id);
+      continue;
     }
+
+    // Found a runnable task.
+    *task = next;
+    if (task->shutdown_behavior == BLOCK_SHUTDOWN)
+      blocking_shutdown_pending_task_count_--;
+    return true;
   }
 
-  // Track the number of tasks we had to skip over to see if we should be
-  // making this more efficient. If this number ever becomes large or is
-  // frequently "some", we should consider the optimization above.
-  UMA_HISTOGRAM_COUNTS_100("SequencedWorkerPool.UnrunnableTaskCount",
-                           unrunnable_tasks);
-  return found_task;
+  return false;
 }
 
 int SequencedWorkerPool::Inner::WillRunWorkerTask(const SequencedTask& task) {
   lock_.AssertAcquired();
 
-  // Mark the task's sequence number as in use.
-  if (task.sequence_token_id)
-    current_sequences_.insert(task.sequence_token_id);
-
   if (task.shutdown_behavior == BLOCK_SHUTDOWN)
     blocking_shutdown_thread_count_++;
 
@@ -846,15 +841,20 @@ void SequencedWorkerPool::Inner::DidRunWorkerTask(const SequencedTask& task) {
   }
 
   if (task.sequence_token_id)
-    current_sequences_.erase(task.sequence_token_id);
+    PromoteNextTaskInSequence(task.sequence_token_id);
 }
 
-bool SequencedWorkerPool::Inner::IsSequenceTokenRunnable(
-    int sequence_token_id) const {
+void SequencedWorkerPool::Inner::PromoteNextTaskInSequence(
+    int sequence_token_id) {
   lock_.AssertAcquired();
-  return !sequence_token_id ||
-      current_sequences_.find(sequence_token_id) ==
-          current_sequences_.end();
+  BlockedTaskMap::iterator blocked = blocked_tasks_.find(sequence_token_id);
+  DCHECK(blocked != blocked_tasks_.end());
+  if (blocked->second.empty()) {
+    blocked_tasks_.erase(blocked);
+    return;
+  }
+  runnable_tasks_.insert(blocked->second.front());
+  blocked->second.pop_front();
 }
 
 int SequencedWorkerPool::Inner::PrepareToStartAdditionalThreadIfHelpful() {
@@ -891,16 +891,12 @@ int SequencedWorkerPool::Inner::PrepareToStartAdditionalThreadIfHelpful() {
   if (!shutdown_called_ &&
       !thread_being_created_ &&
       threads_.size() < max_threads_ &&
-      waiting_thread_count_ == 0) {
-    // We could use an additional thread if there's work to be done.
-    for (std::list<SequencedTask>::iterator i = pending_tasks_.begin();
-         i != pending_tasks_.end(); ++i) {
-      if (IsSequenceTokenRunnable(i->sequence_token_id)) {
-        // Found a runnable task, mark the thread as being started.
-        thread_being_created_ = true;
-        return static_cast<int>(threads_.size() + 1);
-      }
-    }
+      waiting_thread_count_ == 0 &&
+      !runnable_tasks_.empty()) {
+    // We could use an additional thread since there's work to be done, mark
+    // the thread as being started.
+    thread_being_created_ = true;
+    return static_cast<int>(threads_.size() + 1);
   }
   return 0;
 }
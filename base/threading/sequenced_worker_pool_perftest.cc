@@ -0,0 +1,84 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/threading/sequenced_worker_pool.h"
+
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/bind.h"
+#include "base/memory/ref_counted.h"
+#include "base/message_loop.h"
+#include "base/perftimer.h"
+#include "base/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+const int kNumTasks = 100000;
+
+// Number of distinct sequences used by the sequenced runs. Kept above the
+// largest thread count so that every worker can find something to do.
+const int kNumSequences = 32;
+
+void IncrementCounter(subtle::Atomic32* counter) {
+  subtle::NoBarrier_AtomicIncrement(counter, 1);
+}
+
+// Posts kNumTasks trivial tasks to a pool of |num_threads| threads and logs
+// how many tasks per second were run. If |sequenced| is true the tasks are
+// spread round-robin over kNumSequences sequence tokens.
+void TimeTasks(size_t num_threads, bool sequenced) {
+  MessageLoop message_loop;
+  scoped_refptr<SequencedWorkerPool> pool(
+      new SequencedWorkerPool(num_threads, "PerfTest"));
+
+  std::vector<SequencedWorkerPool::SequenceToken> tokens;
+  for (int i = 0; i < kNumSequences; i++)
+    tokens.push_back(pool->GetSequenceToken());
+
+  std::vector<double> samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    subtle::Atomic32 counter = 0;
+    PerfTimer timer;
+    for (int i = 0; i < kNumTasks; i++) {
+      Closure task = Bind(&IncrementCounter, &counter);
+      if (sequenced) {
+        pool->PostSequencedWorkerTask(tokens[i % kNumSequences], FROM_HERE,
+                                      task);
+      } else {
+        pool->PostWorkerTask(FROM_HERE, task);
+      }
+    }
+    pool->FlushForTesting();
+    TimeDelta elapsed = timer.Elapsed();
+    EXPECT_EQ(kNumTasks, subtle::NoBarrier_Load(&counter));
+    samples.push_back(kNumTasks / elapsed.InSecondsF());
+  }
+
+  std::string name = StringPrintf("%s_%d_threads",
+                                  sequenced ? "sequenced" : "unsequenced",
+                                  static_cast<int>(num_threads));
+  LogPerfResultSamples(name.c_str(), samples, "tasks/s");
+
+  pool->Shutdown();
+}
+
+}  // namespace
+
+TEST(SequencedWorkerPoolPerfTest, UnsequencedThroughput) {
+  const size_t kThreadCounts[] = { 1, 2, 4, 8, 16 };
+  for (size_t i = 0; i < arraysize(kThreadCounts); i++)
+    TimeTasks(kThreadCounts[i], false);
+}
+
+TEST(SequencedWorkerPoolPerfTest, SequencedThroughput) {
+  const size_t kThreadCounts[] = { 1, 2, 4, 8, 16 };
+  for (size_t i = 0; i < arraysize(kThreadCounts); i++)
+    TimeTasks(kThreadCounts[i], true);
+}
+
+}  // namespace base
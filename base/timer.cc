@@ -4,58 +4,139 @@
 
 #include "base/timer.h"
 
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/message_loop.h"
+#include "base/threading/thread_local.h"
 
 namespace base {
 
-// BaseTimerTaskInternal is a simple delegate for scheduling a callback to
-// Timer in the MessageLoop. It also handles the following edge
-// cases:
-// - deleted by MessageLoop.
-// - abandoned (orphaned) by Timer.
-class BaseTimerTaskInternal {
+namespace {
+
+LazyInstance<ThreadLocalPointer<BaseTimerQueueInternal> > lazy_tls_queue =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// BaseTimerQueueInternal holds the running Timers of one MessageLoop, ordered
+// by their desired_run_time_, and keeps a single delayed task posted for the
+// earliest of them. Stopping or resetting a Timer moves its entry here
+// instead of leaving an orphaned task behind in the MessageLoop's delayed
+// work queue. It deletes itself when the MessageLoop is destroyed, after
+// stopping any Timers still waiting on it.
+class BaseTimerQueueInternal : public MessageLoop::DestructionObserver {
  public:
-  BaseTimerTaskInternal(Timer* timer)
-      : timer_(timer) {
+  // Returns the queue for the current thread's MessageLoop, creating it if
+  // needed.
+  static BaseTimerQueueInternal* GetForCurrentThread() {
+    BaseTimerQueueInternal* queue = lazy_tls_queue.Pointer()->Get();
+    if (!queue)
+      queue = new BaseTimerQueueInternal();
+    return queue;
+  }
+
+  // Adds |timer| to run at its desired_run_time_.
+  void Add(Timer* timer) {
+    timer->sequence_num_ = next_sequence_num_++;
+    timers_[Key(timer)] = timer;
+    if (timers_.begin()->second == timer)
+      ScheduleWakeUp(timer);
+  }
+
+  // Removes |timer|, which must have been added.
+  void Remove(Timer* timer) {
+    size_t removed = timers_.erase(Key(timer));
+    DCHECK_EQ(1u, removed);
+  }
+
+  // MessageLoop::DestructionObserver implementation.
+  virtual void WillDestroyCurrentMessageLoop() OVERRIDE {
+    TimerMap timers;
+    timers.swap(timers_);
+    for (TimerMap::iterator it = timers.begin(); it != timers.end(); ++it) {
+      it->second->queue_ = NULL;
+      it->second->Stop();
+    }
+    delete this;
+  }
+
+ private:
+  typedef std::pair<TimeTicks, int64> TimerKey;
+  typedef std::map<TimerKey, Timer*> TimerMap;
+
+  BaseTimerQueueInternal() : next_sequence_num_(0) {
+    lazy_tls_queue.Pointer()->Set(this);
+    MessageLoop::current()->AddDestructionObserver(this);
+  }
+
+  virtual ~BaseTimerQueueInternal() {
+    DCHECK(timers_.empty());
+    MessageLoop::current()->RemoveDestructionObserver(this);
+    lazy_tls_queue.Pointer()->Set(NULL);
+  }
+
+  static TimerKey Key(const Timer* timer) {
+    return TimerKey(timer->desired_run_time_, timer->sequence_num_);
   }
 
-  ~BaseTimerTaskInternal() {
-    // This task may be getting cleared because the MessageLoop has been
-    // destructed.  If so, don't leave Timer with a dangling pointer
-    // to this.
-    if (timer_)
-      timer_->StopAndAbandon();
+  // Makes sure a wake-up is posted no later than |timer|'s run time. A later
+  // wake-up that is already posted is left alone and ignored when it runs.
+  void ScheduleWakeUp(const Timer* timer) {
+    if (!wake_up_time_.is_null() && wake_up_time_ <= timer->desired_run_time_)
+      return;
+    wake_up_time_ = timer->desired_run_time_;
+    TimeDelta delay = std::max(wake_up_time_ - TimeTicks::Now(), TimeDelta());
+    MessageLoop::current()->PostDelayedTask(
+        timer->posted_from_,
+        base::Bind(&BaseTimerQueueInternal::OnWakeUp, base::Unretained(this),
+                   wake_up_time_),
+        delay);
   }
 
-  void Run() {
-    // timer_ is NULL if we were abandoned.
-    if (!timer_)
+  // Runs the earliest Timer if it is due. Only one Timer runs per task, so
+  // that due Timers interleave with other work as their own tasks used to.
+  void OnWakeUp(TimeTicks wake_up_time) {
+    if (wake_up_time != wake_up_time_)
+      return;  // Superseded by an earlier wake-up.
+    wake_up_time_ = TimeTicks();
+    if (timers_.empty())
       return;
 
-    // *this will be deleted by the MessageLoop, so Timer needs to
-    // forget us:
-    timer_->scheduled_task_ = NULL;
+    TimerMap::iterator first = timers_.begin();
+    Timer* timer = first->second;
+    if (timer->desired_run_time_ > TimeTicks::Now()) {
+      // The Timer this wake-up was for has been stopped or reset since.
+      ScheduleWakeUp(timer);
+      return;
+    }
+    timers_.erase(first);
+    timer->queue_ = NULL;
+    if (!timers_.empty())
+      ScheduleWakeUp(timers_.begin()->second);
 
-    // Although Timer should not call back into *this, let's clear
-    // the timer_ member first to be pedantic.
-    Timer* timer = timer_;
-    timer_ = NULL;
     timer->RunScheduledTask();
   }
 
-  // The task remains in the MessageLoop queue, but nothing will happen when it
-  // runs.
-  void Abandon() {
-    timer_ = NULL;
-  }
+  TimerMap timers_;
 
- private:
-  Timer* timer_;
+  // Hands out the second half of each Timer's key, so that Timers due at the
+  // same time run in the order they were scheduled.
+  int64 next_sequence_num_;
+
+  // The run time of the earliest wake-up posted to the MessageLoop, or null
+  // if the last one has run.
+  TimeTicks wake_up_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(BaseTimerQueueInternal);
 };
 
 Timer::Timer(bool retain_user_task, bool is_repeating)
-    : scheduled_task_(NULL),
+    : queue_(NULL),
+      sequence_num_(0),
       thread_id_(0),
       is_repeating_(is_repeating),
       retain_user_task_(retain_user_task),
@@ -66,7 +147,8 @@ Timer::Timer(const tracked_objects::Location& posted_from,
              TimeDelta delay,
              const base::Closure& user_task,
              bool is_repeating)
-    : scheduled_task_(NULL),
+    : queue_(NULL),
+      sequence_num_(0),
       posted_from_(posted_from),
       delay_(delay),
       user_task_(user_task),
@@ -77,7 +159,7 @@ Timer::Timer(const tracked_objects::Location& posted_from,
 }
 
 Timer::~Timer() {
-  StopAndAbandon();
+  Stop();
 }
 
 void Timer::Start(const tracked_objects::Location& posted_from,
@@ -89,32 +171,15 @@ void Timer::Start(const tracked_objects::Location& posted_from,
 
 void Timer::Stop() {
   is_running_ = false;
+  CancelScheduledTask();
   if (!retain_user_task_)
     user_task_.Reset();
 }
 
 void Timer::Reset() {
   DCHECK(!user_task_.is_null());
-
-  // If there's no pending task, start one up and return.
-  if (!scheduled_task_) {
-    PostNewScheduledTask(delay_);
-    return;
-  }
-
-  // Set the new desired_run_time_.
-  desired_run_time_ = TimeTicks::Now() + delay_;
-
-  // We can use the existing scheduled task if it arrives before the new
-  // desired_run_time_.
-  if (desired_run_time_ > scheduled_run_time_) {
-    is_running_ = true;
-    return;
-  }
-
-  // We can't reuse the scheduled_task_, so abandon it and post a new one.
-  AbandonScheduledTask();
-  PostNewScheduledTask(delay_);
+  CancelScheduledTask();
+  ScheduleTask(delay_);
 }
 
 void Timer::SetTaskInfo(const tracked_objects::Location& posted_from,
@@ -125,54 +190,34 @@ void Timer::SetTaskInfo(const tracked_objects::Location& posted_from,
   user_task_ = user_task;
 }
 
-void Timer::PostNewScheduledTask(TimeDelta delay) {
-  DCHECK(scheduled_task_ == NULL);
+void Timer::ScheduleTask(TimeDelta delay) {
+  DCHECK(queue_ == NULL);
   is_running_ = true;
-  scheduled_task_ = new BaseTimerTaskInternal(this);
-  MessageLoop::current()->PostDelayedTask(posted_from_,
-      base::Bind(&BaseTimerTaskInternal::Run, base::Owned(scheduled_task_)),
-      delay);
-  scheduled_run_time_ = desired_run_time_ = TimeTicks::Now() + delay;
+  desired_run_time_ = TimeTicks::Now() + delay;
+  queue_ = BaseTimerQueueInternal::GetForCurrentThread();
+  queue_->Add(this);
   // Remember the thread ID that posts the first task -- this will be verified
-  // later when the task is abandoned to detect misuse from multiple threads.
+  // later when the task is cancelled to detect misuse from multiple threads.
   if (!thread_id_)
     thread_id_ = static_cast<int>(PlatformThread::CurrentId());
 }
 
-void Timer::AbandonScheduledTask() {
+void Timer::CancelScheduledTask() {
   DCHECK(thread_id_ == 0 ||
          thread_id_ == static_cast<int>(PlatformThread::CurrentId()));
-  if (scheduled_task_) {
-    scheduled_task_->Abandon();
-    scheduled_task_ = NULL;
+  if (queue_) {
+    queue_->Remove(this);
+    queue_ = NULL;
   }
 }
 
 void Timer::RunScheduledTask() {
-  // Task may have been disabled.
-  if (!is_running_)
-    return;
-
-  // First check if we need to delay the task because of a new target time.
-  if (desired_run_time_ > scheduled_run_time_) {
-    // TimeTicks::Now() can be expensive, so only call it if we know the user
-    // has changed the desired_run_time_.
-    TimeTicks now = TimeTicks::Now();
-    // MessageLoop may have called us late anyway, so only post a continuation
-    // task if the desired_run_time_ is in the future.
-    if (desired_run_time_ > now) {
-      // Post a new task to span the remaining time.
-      PostNewScheduledTask(desired_run_time_ - now);
-      return;
-    }
-  }
-
   // Make a local copy of the task to run. The Stop method will reset the
   // user_task_ member if retain_user_task_ is false.
   base::Closure task = user_task_;
 
   if (is_repeating_)
-    PostNewScheduledTask(delay_);
+    ScheduleTask(delay_);
   else
     Stop();
 
@@ -61,12 +61,14 @@ class MessageLoop;
 
 namespace base {
 
-class BaseTimerTaskInternal;
+class BaseTimerQueueInternal;
 
 //-----------------------------------------------------------------------------
-// This class wraps MessageLoop::PostDelayedTask to manage delayed and repeating
-// tasks. It must be destructed on the same thread that starts tasks. There are
-// DCHECKs in place to verify this.
+// This class manages delayed and repeating tasks on the current MessageLoop.
+// The running Timers of a thread share a single delayed task, so stopping or
+// resetting a Timer does not leave an orphaned task in the MessageLoop. It
+// must be destructed on the same thread that starts tasks. There are DCHECKs
+// in place to verify this.
 //
 class BASE_EXPORT Timer {
  public:
@@ -104,43 +106,38 @@ class BASE_EXPORT Timer {
   void Stop();
 
   // Call this method to reset the timer delay. The user_task_ must be set. If
-  // the timer is not running, this will start it by posting a task.
+  // the timer is not running, this will start it.
   void Reset();
 
   const base::Closure& user_task() const { return user_task_; }
   const TimeTicks& desired_run_time() const { return desired_run_time_; }
 
  protected:
-  // Used to initiate a new delayed task.  This has the side-effect of disabling
-  // scheduled_task_ if it is non-null.
+  // Sets the task info used by the next Reset().
   void SetTaskInfo(const tracked_objects::Location& posted_from,
                    TimeDelta delay,
                    const base::Closure& user_task);
 
  private:
-  friend class BaseTimerTaskInternal;
+  friend class BaseTimerQueueInternal;
 
-  // Allocates a new scheduled_task_ and posts it on the current MessageLoop
-  // with the given |delay|. scheduled_task_ must be NULL. scheduled_run_time_
-  // and desired_run_time_ are reset to Now() + delay.
-  void PostNewScheduledTask(TimeDelta delay);
+  // Adds this timer to the current thread's timer queue to run at Now() +
+  // |delay|, which becomes the new desired_run_time_. The timer must not be
+  // scheduled already.
+  void ScheduleTask(TimeDelta delay);
 
-  // Disable scheduled_task_ and abandon it so that it no longer refers back to
-  // this object.
-  void AbandonScheduledTask();
+  // Removes this timer from its queue, if it is scheduled.
+  void CancelScheduledTask();
 
-  // Called by BaseTimerTaskInternal when the MessageLoop runs it.
+  // Called by BaseTimerQueueInternal when desired_run_time_ is reached.
   void RunScheduledTask();
 
-  // Stop running task (if any) and abandon scheduled task (if any).
-  void StopAndAbandon() {
-    Stop();
-    AbandonScheduledTask();
-  }
+  // When non-NULL, this timer is waiting in |queue_| to call
+  // RunScheduledTask() at desired_run_time_.
+  BaseTimerQueueInternal* queue_;
 
-  // When non-NULL, the scheduled_task_ is waiting in the MessageLoop to call
-  // RunScheduledTask() at scheduled_run_time_.
-  BaseTimerTaskInternal* scheduled_task_;
+  // Orders this timer after others already scheduled for the same time.
+  int64 sequence_num_;
 
   // Location in user code.
   tracked_objects::Location posted_from_;
@@ -149,16 +146,9 @@ class BASE_EXPORT Timer {
   // user_task_ is what the user wants to be run at desired_run_time_.
   base::Closure user_task_;
 
-  // The estimated time that the MessageLoop will run the scheduled_task_ that
-  // will call RunScheduledTask().
-  TimeTicks scheduled_run_time_;
-
   // The desired run time of user_task_. The user may update this at any time,
-  // even if their previous request has not run yet. If desired_run_time_ is
-  // greater than scheduled_run_time_, a continuation task will be posted to
-  // wait for the remaining time. This allows us to reuse the pending task so as
-  // not to flood the MessageLoop with orphaned tasks when the user code
-  // excessively Stops and Starts the timer.
+  // even if their previous request has not run yet; the timer's entry in
+  // |queue_| is moved rather than a new task being posted.
   TimeTicks desired_run_time_;
 
   // Thread ID of current MessageLoop for verifying single-threaded usage.
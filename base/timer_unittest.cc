@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/message_loop.h"
 #include "base/timer.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -474,4 +475,41 @@ TEST(TimerTest, ContinuationReset) {
   }
 }
 
+TEST(TimerTest, ResetToEarlierTime) {
+  {
+    ClearAllCallbackHappened();
+    MessageLoop loop(MessageLoop::TYPE_DEFAULT);
+    base::Timer timer(false, false);
+    timer.Start(FROM_HERE, TimeDelta::FromDays(1),
+                base::Bind(&SetCallbackHappened2));
+    timer.Start(FROM_HERE, TimeDelta::FromMilliseconds(10),
+                base::Bind(&SetCallbackHappened1));
+    MessageLoop::current()->Run();
+    EXPECT_TRUE(g_callback_happened1);
+    EXPECT_FALSE(g_callback_happened2);
+    EXPECT_FALSE(timer.IsRunning());
+  }
+}
+
+TEST(TimerTest, ManyStoppedTimers) {
+  ClearAllCallbackHappened();
+  MessageLoop loop(MessageLoop::TYPE_DEFAULT);
+  ScopedVector<base::Timer> timers;
+  for (int i = 0; i < 1000; ++i) {
+    base::Timer* timer = new base::Timer(false, false);
+    timer->Start(FROM_HERE, TimeDelta::FromMilliseconds(i % 10),
+                 base::Bind(&SetCallbackHappened2));
+    timers.push_back(timer);
+  }
+  for (size_t i = 0; i < timers.size(); ++i)
+    timers[i]->Stop();
+
+  base::Timer timer(false, false);
+  timer.Start(FROM_HERE, TimeDelta::FromMilliseconds(20),
+              base::Bind(&SetCallbackHappened1));
+  MessageLoop::current()->Run();
+  EXPECT_TRUE(g_callback_happened1);
+  EXPECT_FALSE(g_callback_happened2);
+}
+
 }  // namespace
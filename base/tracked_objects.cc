@@ -74,10 +74,11 @@ DeathData::DeathData(int count) {
 
 void DeathData::RecordDeath(const int32 queue_duration,
                             const int32 run_duration,
-                            int32 random_number) {
-  ++count_;
-  queue_duration_sum_ += queue_duration;
-  run_duration_sum_ += run_duration;
+                            int32 random_number,
+                            int weight) {
+  count_ += weight;
+  queue_duration_sum_ += queue_duration * weight;
+  run_duration_sum_ += run_duration * weight;
 
   if (queue_duration_max_ < queue_duration)
     queue_duration_max_ = queue_duration;
@@ -85,11 +86,12 @@ void DeathData::RecordDeath(const int32 queue_duration,
     run_duration_max_ = run_duration;
 
   // Take a uniformly distributed sample over all durations ever supplied.
-  // The probability that we (instead) use this new sample is 1/count_.  This
-  // results in a completely uniform selection of the sample.
+  // The probability that we (instead) use this new sample is weight/count_.
+  // This results in a completely uniform selection of the sample.
   // We ignore the fact that we correlated our selection of a sample of run
   // and queue times.
-  if (0 == (random_number % count_)) {
+  if (static_cast<uint32>(random_number) % count_ <
+      static_cast<uint32>(weight)) {
     queue_duration_sample_ = queue_duration;
     run_duration_sample_ = run_duration;
   }
@@ -180,11 +182,11 @@ BirthOnThreadSnapshot::~BirthOnThreadSnapshot() {
 //------------------------------------------------------------------------------
 Births::Births(const Location& location, const ThreadData& current)
     : BirthOnThread(location, current),
-      birth_count_(1) { }
+      birth_count_(0) { }
 
 int Births::birth_count() const { return birth_count_; }
 
-void Births::RecordBirth() { ++birth_count_; }
+void Births::RecordBirth(int weight) { birth_count_ += weight; }
 
 void Births::ForgetBirth() { --birth_count_; }
 
@@ -229,10 +231,14 @@ base::LazyInstance<base::Lock>::Leaky
 // static
 ThreadData::Status ThreadData::status_ = ThreadData::UNINITIALIZED;
 
+// static
+int ThreadData::sampling_interval_ = 1;
+
 ThreadData::ThreadData(const std::string& suggested_name)
     : next_(NULL),
       next_retired_worker_(NULL),
       worker_thread_number_(0),
+      births_until_sample_(0),
       incarnation_count_for_pool_(-1) {
   DCHECK_GE(suggested_name.size(), 0u);
   thread_name_ = suggested_name;
@@ -243,6 +249,7 @@ ThreadData::ThreadData(int thread_number)
     : next_(NULL),
       next_retired_worker_(NULL),
       worker_thread_number_(thread_number),
+      births_until_sample_(0),
       incarnation_count_for_pool_(-1)  {
   CHECK_GT(thread_number, 0);
   base::StringAppendF(&thread_name_, "WorkerThread-%d", thread_number);
@@ -366,14 +373,32 @@ void ThreadData::Snapshot(bool reset_max, ProcessDataSnapshot* process_data) {
   }
 }
 
-Births* ThreadData::TallyABirth(const Location& location) {
+int ThreadData::SampleABirth() {
+  const int interval = sampling_interval_;
+  if (interval <= 1)
+    return 1;
+  if (--births_until_sample_ > 0)
+    return 0;
+
+  // Draw the gap to the next profiled birth uniformly from
+  // [1, 2 * interval - 1]. It averages |interval|, but unlike a fixed stride
+  // it can't lock onto a task that is posted periodically.
+  random_number_ = static_cast<int32>(
+      static_cast<uint32>(random_number_) * 1103515245u + 12345u);
+  births_until_sample_ = 1 + static_cast<int>(
+      (static_cast<uint32>(random_number_) >> 16) % (2 * interval - 1));
+  return interval;
+}
+
+Births* ThreadData::TallyABirth(const Location& location, int weight) {
   BirthMap::iterator it = birth_map_.find(location);
   Births* child;
   if (it != birth_map_.end()) {
     child =  it->second;
-    child->RecordBirth();
+    child->RecordBirth(weight);
   } else {
     child = new Births(location, *this);  // Leak this.
+    child->RecordBirth(weight);
     // Lock since the map may get relocated now, and other threads sometimes
     // snapshot it (but they lock before copying it).
     base::AutoLock lock(map_lock_);
@@ -418,7 +443,8 @@ void ThreadData::TallyADeath(const Births& birth,
     base::AutoLock lock(map_lock_);  // Lock as the map may get relocated now.
     death_data = &death_map_[&birth];
   }  // Release lock ASAP.
-  death_data->RecordDeath(queue_duration, run_duration, random_number_);
+  death_data->RecordDeath(queue_duration, run_duration, random_number_,
+                          sampling_interval_);
 
   if (!kTrackParentChildLinks)
     return;
@@ -438,7 +464,10 @@ Births* ThreadData::TallyABirthIfActive(const Location& location) {
   ThreadData* current_thread_data = Get();
   if (!current_thread_data)
     return NULL;
-  return current_thread_data->TallyABirth(location);
+  int weight = current_thread_data->SampleABirth();
+  if (!weight)
+    return NULL;
+  return current_thread_data->TallyABirth(location, weight);
 }
 
 // static
@@ -716,6 +745,12 @@ bool ThreadData::InitializeAndSetTrackingStatus(Status status) {
   return true;
 }
 
+// static
+void ThreadData::SetSamplingInterval(int interval) {
+  DCHECK_GE(interval, 1);
+  sampling_interval_ = interval;
+}
+
 // static
 ThreadData::Status ThreadData::status() {
   return status_;
@@ -733,7 +768,11 @@ bool ThreadData::TrackingParentChildStatus() {
 
 // static
 TrackedTime ThreadData::NowForStartOfRun(const Births* parent) {
-  if (kTrackParentChildLinks && parent && status_ > PROFILING_ACTIVE) {
+  // A task without a birth (e.g., one that was not sampled) is not tallied,
+  // so don't bother reading the clock for it.
+  if (!parent)
+    return TrackedTime();
+  if (kTrackParentChildLinks && status_ > PROFILING_ACTIVE) {
     ThreadData* current_thread_data = Get();
     if (current_thread_data)
       current_thread_data->parent_stack_.push(parent);
@@ -801,6 +840,7 @@ void ThreadData::ShutdownSingleThreadedCleanup(bool leak) {
   cleanup_count_ = 0;
   tls_index_.Set(NULL);
   status_ = DORMANT_DURING_TESTS;  // Almost UNINITIALIZED.
+  sampling_interval_ = 1;
 
   // To avoid any chance of racing in unit tests, which is the only place we
   // call this function, we may sometimes leak all the data structures we
@@ -235,8 +235,10 @@ class BASE_EXPORT Births: public BirthOnThread {
 
   int birth_count() const;
 
-  // When we have a birth we update the count for this birthplace.
-  void RecordBirth();
+  // When we have a birth we update the count for this birthplace. A sampled
+  // birth has a |weight| of the sampling interval, standing in for the births
+  // that were skipped.
+  void RecordBirth(int weight);
 
   // When a birthplace is changed (updated), we need to decrement the counter
   // for the old instance.
@@ -268,10 +270,12 @@ class BASE_EXPORT DeathData {
   explicit DeathData(int count);
 
   // Update stats for a task destruction (death) that had a Run() time of
-  // |duration|, and has had a queueing delay of |queue_duration|.
+  // |duration|, and has had a queueing delay of |queue_duration|. The death is
+  // counted |weight| times, as for a birth that was sampled.
   void RecordDeath(const int32 queue_duration,
                    const int32 run_duration,
-                   int random_number);
+                   int random_number,
+                   int weight);
 
   // Metrics accessors, used only for serialization and in tests.
   int count() const;
@@ -447,6 +451,14 @@ class BASE_EXPORT ThreadData {
   // PROFILING_CHILDREN_ACTIVE level might not be compiled in).
   static bool InitializeAndSetTrackingStatus(Status status);
 
+  // Profiles only about one in |interval| births on each thread, and counts
+  // each profiled birth and death |interval| times so that counts and sums
+  // remain unbiased estimates. Maxima and samples are taken from the profiled
+  // tasks only. Births and deaths that are skipped cost no map lookups or
+  // timer reads. Changing the interval while tasks are outstanding skews their
+  // Still_Alive counts. The default interval of 1 profiles every birth.
+  static void SetSamplingInterval(int interval);
+
   static Status status();
 
   // Indicate if any sort of profiling is being done (i.e., we are more than
@@ -516,8 +528,12 @@ class BASE_EXPORT ThreadData {
   ThreadData* next() const;
 
 
+  // Decides whether the next birth on this thread is profiled. Returns the
+  // weight to record it with, or 0 if it is to be skipped.
+  int SampleABirth();
+
   // In this thread's data, record a new birth.
-  Births* TallyABirth(const Location& location);
+  Births* TallyABirth(const Location& location, int weight);
 
   // Find a place to record a death on this thread.
   void TallyADeath(const Births& birth, int32 queue_duration, int32 duration);
@@ -616,6 +632,9 @@ class BASE_EXPORT ThreadData {
   // We set status_ to SHUTDOWN when we shut down the tracking service.
   static Status status_;
 
+  // One in about this many births is profiled. See SetSamplingInterval().
+  static int sampling_interval_;
+
   // Link to next instance (null terminated list). Used to globally track all
   // registered instances (corresponds to all registered threads where we keep
   // data).
@@ -677,6 +696,10 @@ class BASE_EXPORT ThreadData {
   // we stir in more and more as we go.
   int32 random_number_;
 
+  // The number of births left on this thread until the next one is profiled,
+  // when sampling_interval_ is above 1.
+  int births_until_sample_;
+
   // Record of what the incarnation_counter_ was when this instance was created.
   // If the incarnation_counter_ has changed, then we avoid pushing into the
   // pool (this is only critical in tests which go through multiple
@@ -242,14 +242,14 @@ TEST_F(TrackedObjectsTest, DeathDataTest) {
   int32 queue_ms = 8;
 
   const int kUnrandomInt = 0;  // Fake random int that ensure we sample data.
-  data->RecordDeath(queue_ms, run_ms, kUnrandomInt);
+  data->RecordDeath(queue_ms, run_ms, kUnrandomInt, 1);
   EXPECT_EQ(data->run_duration_sum(), run_ms);
   EXPECT_EQ(data->run_duration_sample(), run_ms);
   EXPECT_EQ(data->queue_duration_sum(), queue_ms);
   EXPECT_EQ(data->queue_duration_sample(), queue_ms);
   EXPECT_EQ(data->count(), 1);
 
-  data->RecordDeath(queue_ms, run_ms, kUnrandomInt);
+  data->RecordDeath(queue_ms, run_ms, kUnrandomInt, 1);
   EXPECT_EQ(data->run_duration_sum(), run_ms + run_ms);
   EXPECT_EQ(data->run_duration_sample(), run_ms);
   EXPECT_EQ(data->queue_duration_sum(), queue_ms + queue_ms);
@@ -266,6 +266,67 @@ TEST_F(TrackedObjectsTest, DeathDataTest) {
   EXPECT_EQ(queue_ms, snapshot.queue_duration_sample);
 }
 
+TEST_F(TrackedObjectsTest, WeightedDeathDataTest) {
+  if (!ThreadData::InitializeAndSetTrackingStatus(
+          ThreadData::PROFILING_CHILDREN_ACTIVE))
+    return;
+
+  DeathData data;
+  int32 run_ms = 42;
+  int32 queue_ms = 8;
+  const int kWeight = 3;
+
+  data.RecordDeath(queue_ms, run_ms, 0, kWeight);
+  EXPECT_EQ(kWeight, data.count());
+  EXPECT_EQ(kWeight * run_ms, data.run_duration_sum());
+  EXPECT_EQ(run_ms, data.run_duration_max());
+  EXPECT_EQ(run_ms, data.run_duration_sample());
+  EXPECT_EQ(kWeight * queue_ms, data.queue_duration_sum());
+  EXPECT_EQ(queue_ms, data.queue_duration_max());
+  EXPECT_EQ(queue_ms, data.queue_duration_sample());
+
+  // A random number that is not below the weight modulo the count keeps the
+  // earlier sample.
+  data.RecordDeath(2 * queue_ms, 2 * run_ms, kWeight, kWeight);
+  EXPECT_EQ(2 * kWeight, data.count());
+  EXPECT_EQ(3 * kWeight * run_ms, data.run_duration_sum());
+  EXPECT_EQ(2 * run_ms, data.run_duration_max());
+  EXPECT_EQ(run_ms, data.run_duration_sample());
+}
+
+TEST_F(TrackedObjectsTest, SampledBirths) {
+  if (!ThreadData::InitializeAndSetTrackingStatus(
+          ThreadData::PROFILING_CHILDREN_ACTIVE))
+    return;
+
+  const int kInterval = 4;
+  const int kBirths = 1000;
+  ThreadData::SetSamplingInterval(kInterval);
+  ThreadData::InitializeThreadContext(kMainThreadName);
+
+  const char kFunction[] = "SampledBirths";
+  Location location(kFunction, kFile, kLineNumber, NULL);
+  const Births* birth = NULL;
+  int sampled = 0;
+  for (int i = 0; i < kBirths; ++i) {
+    const Births* sampled_birth = ThreadData::TallyABirthIfActive(location);
+    if (!sampled_birth)
+      continue;
+    ++sampled;
+    birth = sampled_birth;
+  }
+
+  // The gaps between sampled births average |kInterval|, so this is far
+  // outside the range a working sampler would miss.
+  EXPECT_GT(sampled, kBirths / kInterval / 2);
+  EXPECT_LT(sampled, kBirths / kInterval * 2);
+  ASSERT_TRUE(birth);
+  EXPECT_EQ(sampled * kInterval, birth->birth_count());
+
+  // A birth that was not sampled doesn't read the clock.
+  EXPECT_TRUE(ThreadData::NowForStartOfRun(NULL).is_null());
+}
+
 TEST_F(TrackedObjectsTest, DeactivatedBirthOnlyToSnapshotWorkerThread) {
   // Start in the deactivated state.
   if (!ThreadData::InitializeAndSetTrackingStatus(ThreadData::DEACTIVATED))
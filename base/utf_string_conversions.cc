@@ -4,6 +4,8 @@
 
 #include "base/utf_string_conversions.h"
 
+#include <string.h>
+
 #include "base/string_piece.h"
 #include "base/string_util.h"
 #include "base/utf_string_conversion_utils.h"
@@ -15,6 +17,55 @@ using base::WriteUnicodeCharacter;
 
 namespace {
 
+// ASCII fast path -------------------------------------------------------------
+
+// Returns the number of ASCII characters at the start of |src|. Once |src| is
+// word aligned a whole machine word of characters is checked at a time, which
+// is what makes mostly-ASCII strings cheap to convert.
+template<typename SRC_CHAR>
+size_t CountLeadingASCII(const SRC_CHAR* src, size_t src_len) {
+  typedef typename ToUnsigned<SRC_CHAR>::Unsigned UnsignedChar;
+  const size_t kCharsPerWord = sizeof(uintptr_t) / sizeof(SRC_CHAR);
+  const size_t kAlignmentMask = sizeof(uintptr_t) - 1;
+
+  // Every bit but the low seven of each character in a word.
+  uintptr_t non_ascii_mask = 0;
+  for (size_t i = 0; i < kCharsPerWord; ++i) {
+    non_ascii_mask |= static_cast<uintptr_t>(static_cast<UnsignedChar>(~0x7F))
+        << (i * 8 * sizeof(SRC_CHAR));
+  }
+
+  size_t i = 0;
+  for (; i < src_len && (reinterpret_cast<uintptr_t>(src + i) & kAlignmentMask);
+       ++i) {
+    if (static_cast<UnsignedChar>(src[i]) >= 0x80)
+      return i;
+  }
+  for (; i + kCharsPerWord <= src_len; i += kCharsPerWord) {
+    uintptr_t word;
+    memcpy(&word, src + i, sizeof(word));
+    if (word & non_ascii_mask)
+      break;
+  }
+  for (; i < src_len; ++i) {
+    if (static_cast<UnsignedChar>(src[i]) >= 0x80)
+      return i;
+  }
+  return i;
+}
+
+// Appends the |src_len| ASCII characters at |src| to |output|. ASCII is the
+// same code unit in UTF-8, UTF-16 and UTF-32, so this only widens or narrows.
+template<typename SRC_CHAR, typename DEST_STRING>
+void AppendASCII(const SRC_CHAR* src, size_t src_len, DEST_STRING* output) {
+  typedef typename DEST_STRING::value_type DestChar;
+  size_t old_len = output->length();
+  output->resize(old_len + src_len);
+  DestChar* dest = &(*output)[old_len];
+  for (size_t i = 0; i < src_len; ++i)
+    dest[i] = static_cast<DestChar>(src[i]);
+}
+
 // Generalized Unicode converter -----------------------------------------------
 
 // Converts the given source Unicode character type to the given destination
@@ -29,6 +80,15 @@ bool ConvertUnicode(const SRC_CHAR* src,
   bool success = true;
   int32 src_len32 = static_cast<int32>(src_len);
   for (int32 i = 0; i < src_len32; i++) {
+    // Runs of ASCII are copied across without decoding them.
+    size_t ascii_len = CountLeadingASCII(src + i, src_len32 - i);
+    if (ascii_len) {
+      AppendASCII(src + i, ascii_len, output);
+      i += static_cast<int32>(ascii_len);
+      if (i == src_len32)
+        break;
+    }
+
     uint32 code_point;
     if (ReadUnicodeCharacter(src, src_len32, &i, &code_point)) {
       WriteUnicodeCharacter(code_point, output);
@@ -0,0 +1,94 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/utf_string_conversions.h"
+
+#include <string>
+#include <vector>
+
+#include "base/perftimer.h"
+#include "base/string16.h"
+#include "base/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// The number of bytes of UTF-8 converted by each test.
+const size_t kCorpusSize = 16 * 1024 * 1024;
+
+// Strings of the kind the browser converts, mostly URLs and markup with some
+// text in other scripts.
+const char* const kSnippets[] = {
+  "http://www.google.com/search?q=chromium&ie=UTF-8&oe=UTF-8",
+  "<div class=\"result\"><a href=\"/url?sa=t&amp;rct=j\">Chromium</a></div>",
+  "Content-Type: text/html; charset=utf-8",
+  // "Café crème brûlée"
+  "Caf\xc3\xa9 cr\xc3\xa8me br\xc3\xbbl\xc3\xa9""e",
+  // "Поиск страниц на русском"
+  "\xd0\x9f\xd0\xbe\xd0\xb8\xd1\x81\xd0\xba \xd1\x81\xd1\x82\xd1\x80\xd0\xb0"
+  "\xd0\xbd\xd0\xb8\xd1\x86 \xd0\xbd\xd0\xb0 \xd1\x80\xd1\x83\xd1\x81\xd1\x81"
+  "\xd0\xba\xd0\xbe\xd0\xbc",
+  // "网页 图片 资讯更多"
+  "\xe7\xbd\x91\xe9\xa1\xb5 \xe5\x9b\xbe\xe7\x89\x87 \xe8\xb5\x84\xe8\xae\xaf"
+  "\xe6\x9b\xb4\xe5\xa4\x9a",
+};
+
+std::string MakeCorpus(const char* const* snippets, size_t snippet_count) {
+  std::string corpus;
+  corpus.reserve(kCorpusSize);
+  for (size_t i = 0; corpus.length() < kCorpusSize; ++i) {
+    corpus.append(snippets[i % snippet_count]);
+    corpus.push_back(' ');
+  }
+  return corpus;
+}
+
+void RunUTF8AndUTF16Test(const std::string& utf8, const char* name) {
+  double megabytes = utf8.length() / (1024.0 * 1024.0);
+  std::vector<double> to_utf16_samples;
+  std::vector<double> to_utf8_samples;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    string16 utf16;
+    PerfTimer to_utf16_timer;
+    ASSERT_TRUE(UTF8ToUTF16(utf8.data(), utf8.length(), &utf16));
+    TimeDelta to_utf16 = to_utf16_timer.Elapsed();
+
+    std::string round_trip;
+    PerfTimer to_utf8_timer;
+    ASSERT_TRUE(UTF16ToUTF8(utf16.data(), utf16.length(), &round_trip));
+    TimeDelta to_utf8 = to_utf8_timer.Elapsed();
+    EXPECT_EQ(utf8, round_trip);
+
+    to_utf16_samples.push_back(megabytes / to_utf16.InSecondsF());
+    to_utf8_samples.push_back(megabytes / to_utf8.InSecondsF());
+  }
+
+  LogPerfResultSamples((std::string(name) + "_utf8_to_utf16").c_str(),
+                       to_utf16_samples, "MB/s");
+  LogPerfResultSamples((std::string(name) + "_utf16_to_utf8").c_str(),
+                       to_utf8_samples, "MB/s");
+}
+
+}  // namespace
+
+// Markup and URLs only.
+TEST(UTFStringConversionsPerfTest, ASCII) {
+  RunUTF8AndUTF16Test(MakeCorpus(kSnippets, 3), "UTF_conversion_ascii");
+}
+
+// ASCII broken up by Latin, Cyrillic and CJK text.
+TEST(UTFStringConversionsPerfTest, Mixed) {
+  RunUTF8AndUTF16Test(MakeCorpus(kSnippets, arraysize(kSnippets)),
+                      "UTF_conversion_mixed");
+}
+
+// CJK text, where every character takes the slow path.
+TEST(UTFStringConversionsPerfTest, CJK) {
+  RunUTF8AndUTF16Test(MakeCorpus(kSnippets + arraysize(kSnippets) - 1, 1),
+                      "UTF_conversion_cjk");
+}
+
+}  // namespace base
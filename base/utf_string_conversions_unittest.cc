@@ -184,6 +184,43 @@ TEST(UTFStringConversionsTest, ConvertUTF32ToUTF8) {
 }
 #endif  // defined(WCHAR_T_IS_UTF32)
 
+// ASCII is converted a word at a time, so put the non-ASCII character at
+// every position relative to the word boundaries, starting from an unaligned
+// offset as well as an aligned one.
+TEST(UTFStringConversionsTest, ConvertASCIIRuns) {
+  const std::string ascii("The quick brown fox jumps over the lazy dog");
+  for (size_t start = 0; start < 8; ++start) {
+    for (size_t pos = start; pos <= ascii.length(); ++pos) {
+      // U+00E9 LATIN SMALL LETTER E WITH ACUTE.
+      std::string utf8 = ascii.substr(start, pos - start) + "\xc3\xa9" +
+                         ascii.substr(pos);
+      string16 utf16 = ASCIIToUTF16(ascii.substr(start, pos - start)) +
+                       static_cast<char16>(0xe9) +
+                       ASCIIToUTF16(ascii.substr(pos));
+
+      string16 converted16;
+      EXPECT_TRUE(UTF8ToUTF16(utf8.data(), utf8.length(), &converted16));
+      EXPECT_EQ(utf16, converted16);
+      std::string converted8;
+      EXPECT_TRUE(UTF16ToUTF8(utf16.data(), utf16.length(), &converted8));
+      EXPECT_EQ(utf8, converted8);
+      EXPECT_EQ(utf8, WideToUTF8(UTF8ToWide(utf8)));
+    }
+  }
+}
+
+// An invalid byte in the middle of a long ASCII run is still replaced.
+TEST(UTFStringConversionsTest, ConvertInvalidInASCIIRun) {
+  std::string utf8(100, 'a');
+  utf8[57] = '\xff';
+  string16 expected(100, 'a');
+  expected[57] = 0xfffd;
+
+  string16 converted;
+  EXPECT_FALSE(UTF8ToUTF16(utf8.data(), utf8.length(), &converted));
+  EXPECT_EQ(expected, converted);
+}
+
 TEST(UTFStringConversionsTest, ConvertMultiString) {
   static wchar_t wmulti[] = {
     L'f', L'o', L'o', L'\0',
@@ -346,7 +346,9 @@ BinaryValue::BinaryValue(char* buffer, size_t size)
 ///////////////////// DictionaryValue ////////////////////
 
 DictionaryValue::DictionaryValue()
-    : Value(TYPE_DICTIONARY) {
+    : Value(TYPE_DICTIONARY),
+      shared_(NULL),
+      frozen_(false) {
 }
 
 DictionaryValue::~DictionaryValue() {
@@ -367,9 +369,9 @@ bool DictionaryValue::GetAsDictionary(const DictionaryValue** out_value) const {
 
 bool DictionaryValue::HasKey(const std::string& key) const {
   DCHECK(IsStringUTF8(key));
-  ValueMap::const_iterator current_entry = dictionary_.find(key);
-  DCHECK((current_entry == dictionary_.end()) || current_entry->second);
-  return current_entry != dictionary_.end();
+  ValueMap::const_iterator current_entry = entries().find(key);
+  DCHECK((current_entry == entries().end()) || current_entry->second);
+  return current_entry != entries().end();
 }
 
 void DictionaryValue::Clear() {
@@ -380,6 +382,8 @@ void DictionaryValue::Clear() {
   }
 
   dictionary_.clear();
+  shared_ = NULL;
+  owner_ = NULL;
 }
 
 void DictionaryValue::Set(const std::string& path, Value* in_value) {
@@ -430,6 +434,7 @@ void DictionaryValue::SetString(const std::string& path,
 
 void DictionaryValue::SetWithoutPathExpansion(const std::string& key,
                                               Value* in_value) {
+  Unshare();
   // If there's an existing value here, we need to delete it, because
   // we own all our children.
   std::pair<ValueMap::iterator, bool> ins_res =
@@ -462,8 +467,8 @@ bool DictionaryValue::Get(const std::string& path, Value** out_value) const {
 
 bool DictionaryValue::GetBoolean(const std::string& path,
                                  bool* bool_value) const {
-  Value* value;
-  if (!Get(path, &value))
+  const Value* value = Peek(path);
+  if (!value)
     return false;
 
   return value->GetAsBoolean(bool_value);
@@ -471,8 +476,8 @@ bool DictionaryValue::GetBoolean(const std::string& path,
 
 bool DictionaryValue::GetInteger(const std::string& path,
                                  int* out_value) const {
-  Value* value;
-  if (!Get(path, &value))
+  const Value* value = Peek(path);
+  if (!value)
     return false;
 
   return value->GetAsInteger(out_value);
@@ -480,8 +485,8 @@ bool DictionaryValue::GetInteger(const std::string& path,
 
 bool DictionaryValue::GetDouble(const std::string& path,
                                 double* out_value) const {
-  Value* value;
-  if (!Get(path, &value))
+  const Value* value = Peek(path);
+  if (!value)
     return false;
 
   return value->GetAsDouble(out_value);
@@ -489,8 +494,8 @@ bool DictionaryValue::GetDouble(const std::string& path,
 
 bool DictionaryValue::GetString(const std::string& path,
                                 std::string* out_value) const {
-  Value* value;
-  if (!Get(path, &value))
+  const Value* value = Peek(path);
+  if (!value)
     return false;
 
   return value->GetAsString(out_value);
@@ -498,8 +503,8 @@ bool DictionaryValue::GetString(const std::string& path,
 
 bool DictionaryValue::GetString(const std::string& path,
                                 string16* out_value) const {
-  Value* value;
-  if (!Get(path, &value))
+  const Value* value = Peek(path);
+  if (!value)
     return false;
 
   return value->GetAsString(out_value);
@@ -562,8 +567,9 @@ bool DictionaryValue::GetList(const std::string& path,
 bool DictionaryValue::GetWithoutPathExpansion(const std::string& key,
                                               Value** out_value) const {
   DCHECK(IsStringUTF8(key));
-  ValueMap::const_iterator entry_iterator = dictionary_.find(key);
-  if (entry_iterator == dictionary_.end())
+  Unshare();
+  ValueMap::const_iterator entry_iterator = entries().find(key);
+  if (entry_iterator == entries().end())
     return false;
 
   Value* entry = entry_iterator->second;
@@ -574,8 +580,8 @@ bool DictionaryValue::GetWithoutPathExpansion(const std::string& key,
 
 bool DictionaryValue::GetIntegerWithoutPathExpansion(const std::string& key,
                                                      int* out_value) const {
-  Value* value;
-  if (!GetWithoutPathExpansion(key, &value))
+  const Value* value = PeekWithoutPathExpansion(key);
+  if (!value)
     return false;
 
   return value->GetAsInteger(out_value);
@@ -583,8 +589,8 @@ bool DictionaryValue::GetIntegerWithoutPathExpansion(const std::string& key,
 
 bool DictionaryValue::GetDoubleWithoutPathExpansion(const std::string& key,
                                                     double* out_value) const {
-  Value* value;
-  if (!GetWithoutPathExpansion(key, &value))
+  const Value* value = PeekWithoutPathExpansion(key);
+  if (!value)
     return false;
 
   return value->GetAsDouble(out_value);
@@ -593,8 +599,8 @@ bool DictionaryValue::GetDoubleWithoutPathExpansion(const std::string& key,
 bool DictionaryValue::GetStringWithoutPathExpansion(
     const std::string& key,
     std::string* out_value) const {
-  Value* value;
-  if (!GetWithoutPathExpansion(key, &value))
+  const Value* value = PeekWithoutPathExpansion(key);
+  if (!value)
     return false;
 
   return value->GetAsString(out_value);
@@ -603,8 +609,8 @@ bool DictionaryValue::GetStringWithoutPathExpansion(
 bool DictionaryValue::GetStringWithoutPathExpansion(
     const std::string& key,
     string16* out_value) const {
-  Value* value;
-  if (!GetWithoutPathExpansion(key, &value))
+  const Value* value = PeekWithoutPathExpansion(key);
+  if (!value)
     return false;
 
   return value->GetAsString(out_value);
@@ -656,6 +662,7 @@ bool DictionaryValue::Remove(const std::string& path, Value** out_value) {
 bool DictionaryValue::RemoveWithoutPathExpansion(const std::string& key,
                                                  Value** out_value) {
   DCHECK(IsStringUTF8(key));
+  Unshare();
   ValueMap::iterator entry_iterator = dictionary_.find(key);
   if (entry_iterator == dictionary_.end())
     return false;
@@ -675,26 +682,37 @@ DictionaryValue* DictionaryValue::DeepCopyWithoutEmptyChildren() {
 }
 
 void DictionaryValue::MergeDictionary(const DictionaryValue* dictionary) {
-  for (DictionaryValue::key_iterator key(dictionary->begin_keys());
-       key != dictionary->end_keys(); ++key) {
-    Value* merge_value;
-    if (dictionary->GetWithoutPathExpansion(*key, &merge_value)) {
-      // Check whether we have to merge dictionaries.
-      if (merge_value->IsType(Value::TYPE_DICTIONARY)) {
-        DictionaryValue* sub_dict;
-        if (GetDictionaryWithoutPathExpansion(*key, &sub_dict)) {
-          sub_dict->MergeDictionary(
-              static_cast<const DictionaryValue*>(merge_value));
-          continue;
-        }
+  // Reads |dictionary| through entries() so that merging from a
+  // copy-on-write copy doesn't make it copy its entries.
+  for (ValueMap::const_iterator it(dictionary->entries().begin());
+       it != dictionary->entries().end(); ++it) {
+    const Value* merge_value = it->second;
+    // Check whether we have to merge dictionaries.
+    if (merge_value->IsType(Value::TYPE_DICTIONARY)) {
+      DictionaryValue* sub_dict;
+      if (GetDictionaryWithoutPathExpansion(it->first, &sub_dict)) {
+        sub_dict->MergeDictionary(
+            static_cast<const DictionaryValue*>(merge_value));
+        continue;
       }
-      // All other cases: Make a copy and hook it up.
-      SetWithoutPathExpansion(*key, merge_value->DeepCopy());
     }
+    // All other cases: Make a copy and hook it up.
+    SetWithoutPathExpansion(it->first, merge_value->DeepCopy());
   }
 }
 
+void DictionaryValue::Swap(DictionaryValue* other) {
+  DCHECK(!frozen_ && !other->frozen_);
+  dictionary_.swap(other->dictionary_);
+  owner_.swap(other->owner_);
+  std::swap(shared_, other->shared_);
+}
+
 DictionaryValue* DictionaryValue::DeepCopy() const {
+  // A copy that hasn't been modified can share the same tree again.
+  if (shared_)
+    return new DictionaryValue(owner_.get(), shared_);
+
   DictionaryValue* result = new DictionaryValue;
 
   for (ValueMap::const_iterator current_entry(dictionary_.begin());
@@ -712,29 +730,79 @@ bool DictionaryValue::Equals(const Value* other) const {
 
   const DictionaryValue* other_dict =
       static_cast<const DictionaryValue*>(other);
-  key_iterator lhs_it(begin_keys());
-  key_iterator rhs_it(other_dict->begin_keys());
-  while (lhs_it != end_keys() && rhs_it != other_dict->end_keys()) {
-    Value* lhs;
-    Value* rhs;
-    if (*lhs_it != *rhs_it ||
-        !GetWithoutPathExpansion(*lhs_it, &lhs) ||
-        !other_dict->GetWithoutPathExpansion(*rhs_it, &rhs) ||
-        !lhs->Equals(rhs)) {
+  if (entries().size() != other_dict->entries().size())
+    return false;
+
+  ValueMap::const_iterator lhs_it(entries().begin());
+  ValueMap::const_iterator rhs_it(other_dict->entries().begin());
+  for (; lhs_it != entries().end(); ++lhs_it, ++rhs_it) {
+    if (lhs_it->first != rhs_it->first ||
+        !lhs_it->second->Equals(rhs_it->second)) {
       return false;
     }
-    ++lhs_it;
-    ++rhs_it;
   }
-  if (lhs_it != end_keys() || rhs_it != other_dict->end_keys())
-    return false;
 
   return true;
 }
 
+DictionaryValue::DictionaryValue(const ImmutableValue* owner,
+                                 const DictionaryValue* shared)
+    : Value(TYPE_DICTIONARY),
+      owner_(owner),
+      shared_(shared),
+      frozen_(false) {
+  DCHECK(owner);
+  DCHECK(!shared->shared_);
+}
+
+const Value* DictionaryValue::Peek(const std::string& path) const {
+  DCHECK(IsStringUTF8(path));
+  std::string current_path(path);
+  const DictionaryValue* current_dictionary = this;
+  for (size_t delimiter_position = current_path.find('.');
+       delimiter_position != std::string::npos;
+       delimiter_position = current_path.find('.')) {
+    const Value* child = current_dictionary->PeekWithoutPathExpansion(
+        current_path.substr(0, delimiter_position));
+    if (!child || !child->IsType(TYPE_DICTIONARY))
+      return NULL;
+
+    current_dictionary = static_cast<const DictionaryValue*>(child);
+    current_path.erase(0, delimiter_position + 1);
+  }
+
+  return current_dictionary->PeekWithoutPathExpansion(current_path);
+}
+
+const Value* DictionaryValue::PeekWithoutPathExpansion(
+    const std::string& key) const {
+  DCHECK(IsStringUTF8(key));
+  ValueMap::const_iterator entry_iterator = entries().find(key);
+  if (entry_iterator == entries().end())
+    return NULL;
+  return entry_iterator->second;
+}
+
+void DictionaryValue::Unshare() const {
+  if (!shared_ || frozen_)
+    return;
+
+  DCHECK(dictionary_.empty());
+  for (ValueMap::const_iterator it(shared_->dictionary_.begin());
+       it != shared_->dictionary_.end(); ++it) {
+    dictionary_.insert(dictionary_.end(),
+                       std::make_pair(it->first, owner_->CopyNode(it->second)));
+  }
+  shared_ = NULL;
+  owner_ = NULL;
+}
+
 ///////////////////// ListValue ////////////////////
 
-ListValue::ListValue() : Value(TYPE_LIST) {
+ListValue::ListValue()
+    : Value(TYPE_LIST),
+      shared_(NULL),
+      frozen_(false) {
 }
 
 ListValue::~ListValue() {
@@ -745,12 +813,15 @@ void ListValue::Clear() {
   for (ValueVector::iterator i(list_.begin()); i != list_.end(); ++i)
     delete *i;
   list_.clear();
+  shared_ = NULL;
+  owner_ = NULL;
 }
 
 bool ListValue::Set(size_t index, Value* in_value) {
   if (!in_value)
     return false;
 
+  Unshare();
   if (index >= list_.size()) {
     // Pad out any intermediate indexes with null settings
     while (index > list_.size())
@@ -765,50 +836,51 @@ bool ListValue::Set(size_t index, Value* in_value) {
 }
 
 bool ListValue::Get(size_t index, Value** out_value) const {
-  if (index >= list_.size())
+  Unshare();
+  if (index >= entries().size())
     return false;
 
   if (out_value)
-    *out_value = list_[index];
+    *out_value = entries()[index];
 
   return true;
 }
 
 bool ListValue::GetBoolean(size_t index, bool* bool_value) const {
-  Value* value;
-  if (!Get(index, &value))
+  const Value* value = Peek(index);
+  if (!value)
     return false;
 
   return value->GetAsBoolean(bool_value);
 }
 
 bool ListValue::GetInteger(size_t index, int* out_value) const {
-  Value* value;
-  if (!Get(index, &value))
+  const Value* value = Peek(index);
+  if (!value)
     return false;
 
   return value->GetAsInteger(out_value);
 }
 
 bool ListValue::GetDouble(size_t index, double* out_value) const {
-  Value* value;
-  if (!Get(index, &value))
+  const Value* value = Peek(index);
+  if (!value)
     return false;
 
   return value->GetAsDouble(out_value);
 }
 
 bool ListValue::GetString(size_t index, std::string* out_value) const {
-  Value* value;
-  if (!Get(index, &value))
+  const Value* value = Peek(index);
+  if (!value)
     return false;
 
   return value->GetAsString(out_value);
 }
 
 bool ListValue::GetString(size_t index, string16* out_value) const {
-  Value* value;
-  if (!Get(index, &value))
+  const Value* value = Peek(index);
+  if (!value)
     return false;
 
   return value->GetAsString(out_value);
@@ -851,6 +923,7 @@ bool ListValue::GetList(size_t index, ListValue** out_value) const {
 }
 
 bool ListValue::Remove(size_t index, Value** out_value) {
+  Unshare();
   if (index >= list_.size())
     return false;
 
@@ -864,6 +937,7 @@ bool ListValue::Remove(size_t index, Value** out_value) {
 }
 
 bool ListValue::Remove(const Value& value, size_t* index) {
+  Unshare();
   for (ValueVector::iterator i(list_.begin()); i != list_.end(); ++i) {
     if ((*i)->Equals(&value)) {
       size_t previous_index = i - list_.begin();
@@ -880,11 +954,13 @@ bool ListValue::Remove(const Value& value, size_t* index) {
 
 void ListValue::Append(Value* in_value) {
   DCHECK(in_value);
+  Unshare();
   list_.push_back(in_value);
 }
 
 bool ListValue::AppendIfNotPresent(Value* in_value) {
   DCHECK(in_value);
+  Unshare();
   for (ValueVector::const_iterator i(list_.begin()); i != list_.end(); ++i) {
     if ((*i)->Equals(in_value)) {
       delete in_value;
@@ -897,6 +973,7 @@ bool ListValue::AppendIfNotPresent(Value* in_value) {
 
 bool ListValue::Insert(size_t index, Value* in_value) {
   DCHECK(in_value);
+  Unshare();
   if (index > list_.size())
     return false;
 
@@ -905,7 +982,15 @@ bool ListValue::Insert(size_t index, Value* in_value) {
 }
 
 ListValue::const_iterator ListValue::Find(const Value& value) const {
-  return std::find_if(list_.begin(), list_.end(), ValueEquals(&value));
+  Unshare();
+  return std::find_if(entries().begin(), entries().end(), ValueEquals(&value));
+}
+
+void ListValue::Swap(ListValue* other) {
+  DCHECK(!frozen_ && !other->frozen_);
+  list_.swap(other->list_);
+  owner_.swap(other->owner_);
+  std::swap(shared_, other->shared_);
 }
 
 bool ListValue::GetAsList(ListValue** out_value) {
@@ -921,6 +1006,10 @@ bool ListValue::GetAsList(const ListValue** out_value) const {
 }
 
 ListValue* ListValue::DeepCopy() const {
+  // A copy that hasn't been modified can share the same tree again.
+  if (shared_)
+    return new ListValue(owner_.get(), shared_);
+
   ListValue* result = new ListValue;
 
   for (ValueVector::const_iterator i(list_.begin()); i != list_.end(); ++i)
@@ -936,18 +1025,118 @@ bool ListValue::Equals(const Value* other) const {
   const ListValue* other_list =
       static_cast<const ListValue*>(other);
   const_iterator lhs_it, rhs_it;
-  for (lhs_it = begin(), rhs_it = other_list->begin();
-       lhs_it != end() && rhs_it != other_list->end();
+  for (lhs_it = entries().begin(), rhs_it = other_list->entries().begin();
+       lhs_it != entries().end() && rhs_it != other_list->entries().end();
        ++lhs_it, ++rhs_it) {
     if (!(*lhs_it)->Equals(*rhs_it))
       return false;
   }
-  if (lhs_it != end() || rhs_it != other_list->end())
+  if (lhs_it != entries().end() || rhs_it != other_list->entries().end())
     return false;
 
   return true;
 }
 
+ListValue::ListValue(const ImmutableValue* owner, const ListValue* shared)
+    : Value(TYPE_LIST),
+      owner_(owner),
+      shared_(shared),
+      frozen_(false) {
+  DCHECK(owner);
+  DCHECK(!shared->shared_);
+}
+
+const Value* ListValue::Peek(size_t index) const {
+  if (index >= entries().size())
+    return NULL;
+  return entries()[index];
+}
+
+void ListValue::Unshare() const {
+  if (!shared_ || frozen_)
+    return;
+
+  DCHECK(list_.empty());
+  list_.reserve(shared_->list_.size());
+  for (ValueVector::const_iterator i(shared_->list_.begin());
+       i != shared_->list_.end(); ++i) {
+    list_.push_back(owner_->CopyNode(*i));
+  }
+  shared_ = NULL;
+  owner_ = NULL;
+}
+
+///////////////////// ImmutableValue ////////////////////
+
+ImmutableValue::ImmutableValue(Value* value) : value_(value) {
+  DCHECK(value);
+  Freeze(value);
+}
+
+ImmutableValue::~ImmutableValue() {
+}
+
+Value* ImmutableValue::CreateCopy() const {
+  return CopyNode(value_.get());
+}
+
+Value* ImmutableValue::CopyNode(const Value* node) const {
+  switch (node->GetType()) {
+    case Value::TYPE_DICTIONARY: {
+      const DictionaryValue* dict = static_cast<const DictionaryValue*>(node);
+      // A copy-on-write copy in this tree reads from another ImmutableValue;
+      // its DeepCopy() shares that one.
+      if (dict->shared_)
+        return dict->DeepCopy();
+      return new DictionaryValue(this, dict);
+    }
+
+    case Value::TYPE_LIST: {
+      const ListValue* list = static_cast<const ListValue*>(node);
+      if (list->shared_)
+        return list->DeepCopy();
+      return new ListValue(this, list);
+    }
+
+    default:
+      return node->DeepCopy();
+  }
+}
+
+// static
+void ImmutableValue::Freeze(Value* node) {
+  switch (node->GetType()) {
+    case Value::TYPE_DICTIONARY: {
+      DictionaryValue* dict = static_cast<DictionaryValue*>(node);
+      if (dict->shared_) {
+        dict->frozen_ = true;
+        return;
+      }
+      for (ValueMap::iterator it(dict->dictionary_.begin());
+           it != dict->dictionary_.end(); ++it) {
+        Freeze(it->second);
+      }
+      return;
+    }
+
+    case Value::TYPE_LIST: {
+      ListValue* list = static_cast<ListValue*>(node);
+      if (list->shared_) {
+        list->frozen_ = true;
+        return;
+      }
+      for (ValueVector::iterator i(list->list_.begin());
+           i != list->list_.end(); ++i) {
+        Freeze(*i);
+      }
+      return;
+    }
+
+    default:
+      return;
+  }
+}
+
 ValueSerializer::~ValueSerializer() {
 }
 
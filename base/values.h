@@ -17,6 +17,11 @@
 // string setting.  If some elements of the path didn't exist yet, the
 // SetString() method would create the missing elements and attach them to root
 // before attaching the homepage value.
+//
+// A tree that many owners read, such as a policy or manifest dictionary, can
+// be handed to an ImmutableValue. Its CreateCopy() returns dictionaries and
+// lists that read from the shared tree and copy only the parts of a path that
+// are touched through a non-const pointer, instead of a full DeepCopy().
 
 #ifndef BASE_VALUES_H_
 #define BASE_VALUES_H_
@@ -30,6 +35,8 @@
 #include "base/base_export.h"
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/string16.h"
 
 // This file declares "using base::Value", etc. at the bottom, so that
@@ -42,6 +49,7 @@ namespace base {
 class BinaryValue;
 class DictionaryValue;
 class FundamentalValue;
+class ImmutableValue;
 class ListValue;
 class StringValue;
 class Value;
@@ -226,10 +234,10 @@ class BASE_EXPORT DictionaryValue : public Value {
   bool HasKey(const std::string& key) const;
 
   // Returns the number of Values in this dictionary.
-  size_t size() const { return dictionary_.size(); }
+  size_t size() const { return entries().size(); }
 
   // Returns whether the dictionary is empty.
-  bool empty() const { return dictionary_.empty(); }
+  bool empty() const { return entries().empty(); }
 
   // Clears any current contents of this dictionary.
   void Clear();
@@ -320,9 +328,7 @@ class BASE_EXPORT DictionaryValue : public Value {
   void MergeDictionary(const DictionaryValue* dictionary);
 
   // Swaps contents with the |other| dictionary.
-  void Swap(DictionaryValue* other) {
-    dictionary_.swap(other->dictionary_);
-  }
+  void Swap(DictionaryValue* other);
 
   // This class provides an iterator for the keys in the dictionary.
   // It can't be used to modify the dictionary.
@@ -346,17 +352,26 @@ class BASE_EXPORT DictionaryValue : public Value {
     ValueMap::const_iterator itr_;
   };
 
-  key_iterator begin_keys() const { return key_iterator(dictionary_.begin()); }
-  key_iterator end_keys() const { return key_iterator(dictionary_.end()); }
+  key_iterator begin_keys() const {
+    Unshare();
+    return key_iterator(entries().begin());
+  }
+  key_iterator end_keys() const {
+    Unshare();
+    return key_iterator(entries().end());
+  }
 
   // This class provides an iterator over both keys and values in the
   // dictionary.  It can't be used to modify the dictionary.
   class Iterator {
    public:
     explicit Iterator(const DictionaryValue& target)
-        : target_(target), it_(target.dictionary_.begin()) {}
+        : target_(target) {
+      target_.Unshare();
+      it_ = target_.entries().begin();
+    }
 
-    bool HasNext() const { return it_ != target_.dictionary_.end(); }
+    bool HasNext() const { return it_ != target_.entries().end(); }
     void Advance() { ++it_; }
 
     const std::string& key() const { return it_->first; }
@@ -372,7 +387,37 @@ class BASE_EXPORT DictionaryValue : public Value {
   virtual bool Equals(const Value* other) const OVERRIDE;
 
  private:
-  ValueMap dictionary_;
+  friend class ImmutableValue;
+
+  // Creates a dictionary that reads from |shared|, which is part of |owner|'s
+  // tree, until it has to hand out a non-const pointer.
+  DictionaryValue(const ImmutableValue* owner, const DictionaryValue* shared);
+
+  // Returns the entries this dictionary reads from.
+  const ValueMap& entries() const {
+    return shared_ ? shared_->entries() : dictionary_;
+  }
+
+  // Looks up a value without copying anything from the shared tree, for
+  // getters that only return a copy of what they find.
+  const Value* Peek(const std::string& path) const;
+  const Value* PeekWithoutPathExpansion(const std::string& key) const;
+
+  // Gives this dictionary its own entries if it still reads from a shared
+  // tree; dictionaries and lists among them keep reading from it. This is
+  // const because the const getters return non-const pointers.
+  void Unshare() const;
+
+  mutable ValueMap dictionary_;
+
+  // The tree this dictionary reads from while it has no entries of its own,
+  // if any.
+  mutable scoped_refptr<const ImmutableValue> owner_;
+  mutable const DictionaryValue* shared_;
+
+  // True if this copy is itself part of an ImmutableValue, so it is never
+  // modified and never has to stop sharing.
+  bool frozen_;
 
   DISALLOW_COPY_AND_ASSIGN(DictionaryValue);
 };
@@ -390,10 +435,10 @@ class BASE_EXPORT ListValue : public Value {
   void Clear();
 
   // Returns the number of Values in this list.
-  size_t GetSize() const { return list_.size(); }
+  size_t GetSize() const { return entries().size(); }
 
   // Returns whether the list is empty.
-  bool empty() const { return list_.empty(); }
+  bool empty() const { return entries().empty(); }
 
   // Sets the list item at the given index to be the Value specified by
   // the value given.  If the index beyond the current end of the list, null
@@ -449,16 +494,26 @@ class BASE_EXPORT ListValue : public Value {
   const_iterator Find(const Value& value) const;
 
   // Swaps contents with the |other| list.
-  void Swap(ListValue* other) {
-    list_.swap(other->list_);
-  }
+  void Swap(ListValue* other);
 
   // Iteration.
-  iterator begin() { return list_.begin(); }
-  iterator end() { return list_.end(); }
+  iterator begin() {
+    Unshare();
+    return list_.begin();
+  }
+  iterator end() {
+    Unshare();
+    return list_.end();
+  }
 
-  const_iterator begin() const { return list_.begin(); }
-  const_iterator end() const { return list_.end(); }
+  const_iterator begin() const {
+    Unshare();
+    return entries().begin();
+  }
+  const_iterator end() const {
+    Unshare();
+    return entries().end();
+  }
 
   // Overridden from Value:
   virtual bool GetAsList(ListValue** out_value) OVERRIDE;
@@ -467,11 +522,70 @@ class BASE_EXPORT ListValue : public Value {
   virtual bool Equals(const Value* other) const OVERRIDE;
 
  private:
-  ValueVector list_;
+  friend class ImmutableValue;
+
+  // Creates a list that reads from |shared|, which is part of |owner|'s
+  // tree, until it has to hand out a non-const pointer.
+  ListValue(const ImmutableValue* owner, const ListValue* shared);
+
+  // Returns the entries this list reads from.
+  const ValueVector& entries() const {
+    return shared_ ? shared_->entries() : list_;
+  }
+
+  // Like the DictionaryValue methods of the same names.
+  const Value* Peek(size_t index) const;
+  void Unshare() const;
+
+  mutable ValueVector list_;
+
+  mutable scoped_refptr<const ImmutableValue> owner_;
+  mutable const ListValue* shared_;
+  bool frozen_;
 
   DISALLOW_COPY_AND_ASSIGN(ListValue);
 };
 
+// ImmutableValue owns a Value tree that is never modified again, so it can be
+// shared between any number of owners and threads. Copies made from it are
+// copy-on-write: a dictionary or list copies its own level from the shared
+// tree the first time it hands out a non-const pointer or an iterator, and
+// its children keep sharing. The getters that return values by copy never
+// copy anything. A copy is a normal Value for its owner, but even its const
+// methods may modify it, so unlike the shared tree it must not be used from
+// several threads at once.
+class BASE_EXPORT ImmutableValue
+    : public RefCountedThreadSafe<ImmutableValue> {
+ public:
+  // Takes ownership of |value|, which must not be modified afterwards. It
+  // may itself contain copies of other ImmutableValues.
+  explicit ImmutableValue(Value* value);
+
+  const Value& value() const { return *value_; }
+
+  // Returns a copy of the tree that shares it until it is modified. The
+  // caller owns the copy.
+  Value* CreateCopy() const;
+
+ private:
+  friend class DictionaryValue;
+  friend class ListValue;
+  friend class RefCountedThreadSafe<ImmutableValue>;
+
+  ~ImmutableValue();
+
+  // Returns a copy of |node|, which is part of this tree: a copy-on-write
+  // copy for a dictionary or list, and a DeepCopy() of anything else.
+  Value* CopyNode(const Value* node) const;
+
+  // Marks the copy-on-write copies inside |node| as frozen.
+  static void Freeze(Value* node);
+
+  scoped_ptr<const Value> value_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImmutableValue);
+};
+
 // This interface is implemented by classes that know how to serialize and
 // deserialize Value objects.
 class BASE_EXPORT ValueSerializer {
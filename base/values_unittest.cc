@@ -755,4 +755,122 @@ TEST(ValuesTest, DictionaryIterator) {
   EXPECT_TRUE(seen2);
 }
 
+TEST(ValuesTest, ImmutableValueCopyOnWrite) {
+  DictionaryValue* original = new DictionaryValue;
+  original->SetString("a.b.string", "original");
+  original->SetInteger("a.c.int", 1);
+  ListValue* list = new ListValue;
+  list->Append(Value::CreateIntegerValue(42));
+  original->Set("list", list);
+  scoped_refptr<ImmutableValue> shared(new ImmutableValue(original));
+
+  scoped_ptr<Value> copy_value(shared->CreateCopy());
+  ASSERT_TRUE(copy_value->IsType(Value::TYPE_DICTIONARY));
+  DictionaryValue* copy = static_cast<DictionaryValue*>(copy_value.get());
+  EXPECT_TRUE(copy->Equals(original));
+
+  // Reading by value doesn't need a copy.
+  std::string string_value;
+  EXPECT_TRUE(copy->GetString("a.b.string", &string_value));
+  EXPECT_EQ("original", string_value);
+  int int_value = 0;
+  EXPECT_TRUE(copy->GetInteger("a.c.int", &int_value));
+  EXPECT_EQ(1, int_value);
+  EXPECT_EQ(2u, copy->size());
+
+  // Modifying the copy copies the path to the change and leaves the shared
+  // tree alone.
+  copy->SetString("a.b.string", "modified");
+  copy->SetInteger("new", 2);
+  EXPECT_TRUE(copy->GetString("a.b.string", &string_value));
+  EXPECT_EQ("modified", string_value);
+  EXPECT_TRUE(copy->GetInteger("a.c.int", &int_value));
+  EXPECT_EQ(1, int_value);
+  EXPECT_TRUE(shared->value().Equals(original));
+  EXPECT_TRUE(original->GetString("a.b.string", &string_value));
+  EXPECT_EQ("original", string_value);
+  EXPECT_FALSE(original->HasKey("new"));
+
+  // Pointers handed out by the const getters belong to the copy.
+  ListValue* copy_list = NULL;
+  ASSERT_TRUE(copy->GetList("list", &copy_list));
+  copy_list->Append(Value::CreateIntegerValue(43));
+  EXPECT_EQ(2u, copy_list->GetSize());
+  EXPECT_EQ(1u, list->GetSize());
+
+  // The shared tree outlives the ImmutableValue while copies read from it.
+  scoped_ptr<Value> second_copy(shared->CreateCopy());
+  shared = NULL;
+  DictionaryValue* second_copy_dict =
+      static_cast<DictionaryValue*>(second_copy.get());
+  EXPECT_TRUE(second_copy_dict->GetString("a.b.string", &string_value));
+  EXPECT_EQ("original", string_value);
+  EXPECT_FALSE(second_copy_dict->Equals(copy));
+}
+
+TEST(ValuesTest, ImmutableValueIteration) {
+  DictionaryValue* original = new DictionaryValue;
+  original->SetInteger("one", 1);
+  original->SetInteger("two", 2);
+  ListValue* list = new ListValue;
+  list->Append(Value::CreateStringValue("element"));
+  original->Set("list", list);
+  scoped_refptr<ImmutableValue> shared(new ImmutableValue(original));
+
+  // Getting values out of the copy while iterating over it is fine, even
+  // though the first Get() makes the copy read from its own entries.
+  scoped_ptr<DictionaryValue> copy(
+      static_cast<DictionaryValue*>(shared->CreateCopy()));
+  int keys = 0;
+  for (DictionaryValue::key_iterator it = copy->begin_keys();
+       it != copy->end_keys(); ++it) {
+    Value* value = NULL;
+    EXPECT_TRUE(copy->GetWithoutPathExpansion(*it, &value));
+    ++keys;
+  }
+  EXPECT_EQ(3, keys);
+
+  ListValue* list_value = NULL;
+  ASSERT_TRUE(copy->GetList("list", &list_value));
+  const ListValue* copy_list = list_value;
+  int elements = 0;
+  for (ListValue::const_iterator it = copy_list->begin();
+       it != copy_list->end(); ++it) {
+    EXPECT_TRUE((*it)->IsType(Value::TYPE_STRING));
+    ++elements;
+  }
+  EXPECT_EQ(1, elements);
+}
+
+TEST(ValuesTest, ImmutableValueOfCopy) {
+  DictionaryValue* original = new DictionaryValue;
+  original->SetString("unchanged.string", "original");
+  original->SetString("changed.string", "original");
+  scoped_refptr<ImmutableValue> first(new ImmutableValue(original));
+
+  // A modified copy can be shared again, and keeps sharing the parts of the
+  // first tree it didn't modify.
+  DictionaryValue* copy = static_cast<DictionaryValue*>(first->CreateCopy());
+  copy->SetString("changed.string", "modified");
+  scoped_refptr<ImmutableValue> second(new ImmutableValue(copy));
+  first = NULL;
+
+  scoped_ptr<DictionaryValue> second_copy(
+      static_cast<DictionaryValue*>(second->CreateCopy()));
+  std::string string_value;
+  EXPECT_TRUE(second_copy->GetString("unchanged.string", &string_value));
+  EXPECT_EQ("original", string_value);
+  EXPECT_TRUE(second_copy->GetString("changed.string", &string_value));
+  EXPECT_EQ("modified", string_value);
+
+  // Reading the frozen tree through its const getters doesn't change it.
+  const DictionaryValue* frozen = NULL;
+  ASSERT_TRUE(second->value().GetAsDictionary(&frozen));
+  DictionaryValue* unchanged = NULL;
+  EXPECT_TRUE(frozen->GetDictionary("unchanged", &unchanged));
+  EXPECT_TRUE(unchanged->GetString("string", &string_value));
+  EXPECT_EQ("original", string_value);
+  EXPECT_TRUE(second_copy->Equals(frozen));
+}
+
 }  // namespace base
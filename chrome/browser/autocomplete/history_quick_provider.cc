@@ -124,7 +124,7 @@ void HistoryQuickProvider::Start(const AutocompleteInput& input,
   // autocomplete behavior here.
   if (GetIndex()) {
     base::TimeTicks start_time = base::TimeTicks::Now();
-    DoAutocomplete();
+    DoAutocomplete(minimal_changes);
     if (input.text().length() < 6) {
       base::TimeTicks end_time = base::TimeTicks::Now();
       std::string name = "HistoryQuickProvider.QueryIndexTime." +
@@ -142,10 +142,16 @@ void HistoryQuickProvider::DeleteMatch(const AutocompleteMatch& match) {}
 
 HistoryQuickProvider::~HistoryQuickProvider() {}
 
-void HistoryQuickProvider::DoAutocomplete() {
-  // Get the matching URLs from the DB.
+void HistoryQuickProvider::DoAutocomplete(bool minimal_changes) {
+  // Get the matching URLs from the DB, unless only something other than the
+  // text (such as whether to inline autocomplete) has changed since the last
+  // query.
   string16 term_string = autocomplete_input_.text();
-  ScoredHistoryMatches matches = GetIndex()->HistoryItemsForTerms(term_string);
+  if (!minimal_changes || term_string != last_term_string_) {
+    last_history_matches_ = GetIndex()->HistoryItemsForTerms(term_string);
+    last_term_string_ = term_string;
+  }
+  const ScoredHistoryMatches& matches = last_history_matches_;
   if (matches.empty())
     return;
 
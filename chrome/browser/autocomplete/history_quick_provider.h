@@ -24,8 +24,9 @@ class HistoryQuickProvider : public HistoryProvider {
  public:
   HistoryQuickProvider(ACProviderListener* listener, Profile* profile);
 
-  // AutocompleteProvider. |minimal_changes| is ignored since there
-  // is no asynch completion performed.
+  // AutocompleteProvider. When |minimal_changes| is true the scored results
+  // of the previous query for the same text are reused instead of querying
+  // the index again.
   virtual void Start(const AutocompleteInput& input,
                      bool minimal_changes) OVERRIDE;
 
@@ -45,8 +46,10 @@ class HistoryQuickProvider : public HistoryProvider {
 
   virtual ~HistoryQuickProvider();
 
-  // Performs the autocomplete matching and scoring.
-  void DoAutocomplete();
+  // Performs the autocomplete matching and scoring. If |minimal_changes| is
+  // true and the text hasn't changed since the last query, the index isn't
+  // queried again.
+  void DoAutocomplete(bool minimal_changes);
 
   // Creates an AutocompleteMatch from |history_match|, assigning it
   // the score |score|.
@@ -72,6 +75,12 @@ class HistoryQuickProvider : public HistoryProvider {
   AutocompleteInput autocomplete_input_;
   std::string languages_;
 
+  // The text of the last index query and the results it returned. Scoring
+  // the index results dominates the time spent per keystroke, and the results
+  // depend only on the text.
+  string16 last_term_string_;
+  history::ScoredHistoryMatches last_history_matches_;
+
   // Only used for testing.
   scoped_ptr<history::InMemoryURLIndex> index_for_testing_;
 
@@ -276,6 +276,26 @@ TEST_F(HistoryQuickProviderTest, SimpleSingleMatch) {
           ASCIIToUTF16("slashdot.org/favorite_page.html"));
 }
 
+TEST_F(HistoryQuickProviderTest, MinimalChanges) {
+  std::vector<std::string> expected_urls;
+  expected_urls.push_back("http://slashdot.org/favorite_page.html");
+  RunTest(ASCIIToUTF16("slashdot"), expected_urls, true,
+          ASCIIToUTF16("slashdot.org/favorite_page.html"));
+  int inline_relevance = ac_matches_[0].relevance;
+
+  // Only preventing inline autocompletion changes; the earlier results are
+  // rescored without inlining.
+  AutocompleteInput input(ASCIIToUTF16("slashdot"), string16(), true, false,
+                          true, AutocompleteInput::ALL_MATCHES);
+  provider_->Start(input, true);
+  ASSERT_EQ(1U, provider_->matches().size());
+  EXPECT_EQ(expected_urls[0],
+            provider_->matches()[0].destination_url.spec());
+  EXPECT_LT(provider_->matches()[0].relevance, inline_relevance);
+  EXPECT_LT(provider_->matches()[0].relevance,
+            AutocompleteResult::kLowestDefaultScore);
+}
+
 TEST_F(HistoryQuickProviderTest, MultiTermTitleMatch) {
   std::vector<std::string> expected_urls;
   expected_urls.push_back(
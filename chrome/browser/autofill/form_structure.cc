@@ -7,7 +7,9 @@
 #include <utility>
 
 #include "base/basictypes.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/memory/mru_cache.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/sha1.h"
 #include "base/string_number_conversions.h"
@@ -53,6 +55,49 @@ const char kXMLElementField[] = "field";
 // The number of fillable fields necessary for a form to be fillable.
 const size_t kRequiredFillableFields = 3;
 
+// The number of forms whose heuristic field types are remembered.
+const size_t kHeuristicsCacheSize = 100;
+
+// Maps the inputs to the field type heuristics for a form to the type they
+// produced for each of its fields, so that a form seen again, in this tab or
+// any other, doesn't go through the regular expressions again.
+class HeuristicsCache
+    : public base::MRUCache<std::string, std::vector<AutofillFieldType> > {
+ public:
+  HeuristicsCache()
+      : base::MRUCache<std::string, std::vector<AutofillFieldType> >(
+            kHeuristicsCacheSize) {}
+};
+
+base::LazyInstance<HeuristicsCache> g_heuristics_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Appends |str| to |key|, prefixed with its length so that the boundaries
+// between strings are unambiguous.
+void AppendToHeuristicsKey(const string16& str, std::string* key) {
+  std::string utf8 = UTF16ToUTF8(str);
+  key->append(base::Uint64ToString(utf8.length()));
+  key->push_back(':');
+  key->append(utf8);
+}
+
+// Returns the key in |g_heuristics_cache| for |fields|. It covers everything
+// the heuristics look at, which is more than the form signature does.
+std::string HeuristicsCacheKey(const std::vector<AutofillField*>& fields) {
+  std::string key;
+  for (std::vector<AutofillField*>::const_iterator iter = fields.begin();
+       iter != fields.end(); ++iter) {
+    const AutofillField* field = *iter;
+    AppendToHeuristicsKey(field->label, &key);
+    AppendToHeuristicsKey(field->name, &key);
+    AppendToHeuristicsKey(field->value, &key);
+    AppendToHeuristicsKey(field->form_control_type, &key);
+    key.append(base::Uint64ToString(field->max_length));
+    key.push_back(';');
+  }
+  return base::SHA1HashString(key);
+}
+
 // Helper for |EncodeUploadRequest()| that creates a bit field corresponding to
 // |available_field_types| and returns the hex representation as a string.
 std::string EncodeFieldTypes(const FieldTypeSet& available_field_types) {
@@ -285,13 +330,27 @@ void FormStructure::DetermineHeuristicTypes() {
                                   &has_author_specified_sections);
 
   if (!has_author_specified_types_) {
-    FieldTypeMap field_type_map;
-    FormField::ParseFormFields(fields_.get(), &field_type_map);
+    HeuristicsCache* cache = g_heuristics_cache.Pointer();
+    std::string key = HeuristicsCacheKey(fields_.get());
+    HeuristicsCache::iterator cached = cache->Get(key);
+    if (cached == cache->end()) {
+      FieldTypeMap field_type_map;
+      FormField::ParseFormFields(fields_.get(), &field_type_map);
+      std::vector<AutofillFieldType> types(field_count(), UNKNOWN_TYPE);
+      for (size_t index = 0; index < field_count(); index++) {
+        FieldTypeMap::iterator iter =
+            field_type_map.find(fields_[index]->unique_name());
+        if (iter != field_type_map.end())
+          types[index] = iter->second;
+      }
+      cached = cache->Put(key, types);
+    }
+
+    const std::vector<AutofillFieldType>& types = cached->second;
+    DCHECK_EQ(field_count(), types.size());
     for (size_t index = 0; index < field_count(); index++) {
-      AutofillField* field = fields_[index];
-      FieldTypeMap::iterator iter = field_type_map.find(field->unique_name());
-      if (iter != field_type_map.end())
-        field->set_heuristic_type(iter->second);
+      if (types[index] != UNKNOWN_TYPE)
+        fields_[index]->set_heuristic_type(types[index]);
     }
   }
 
@@ -334,6 +334,47 @@ TEST(FormStructureTest, HeuristicsContactInfo) {
 }
 
 // Verify that we can correctly process the |autocompletetype| attribute.
+// Forms seen before reuse their heuristic types, but only when everything the
+// heuristics look at is the same, not just the form signature.
+TEST(FormStructureTest, HeuristicsRepeatedForm) {
+  FormData form;
+  form.method = ASCIIToUTF16("post");
+
+  FormField field;
+  field.form_control_type = ASCIIToUTF16("text");
+
+  field.label = ASCIIToUTF16("First Name");
+  field.name = ASCIIToUTF16("field1");
+  form.fields.push_back(field);
+
+  field.label = ASCIIToUTF16("Last Name");
+  field.name = ASCIIToUTF16("field2");
+  form.fields.push_back(field);
+
+  field.label = ASCIIToUTF16("Email");
+  field.name = ASCIIToUTF16("field3");
+  form.fields.push_back(field);
+
+  for (int i = 0; i < 2; ++i) {
+    FormStructure form_structure(form);
+    form_structure.DetermineHeuristicTypes();
+    ASSERT_EQ(3U, form_structure.field_count());
+    EXPECT_EQ(NAME_FIRST, form_structure.field(0)->heuristic_type());
+    EXPECT_EQ(NAME_LAST, form_structure.field(1)->heuristic_type());
+    EXPECT_EQ(EMAIL_ADDRESS, form_structure.field(2)->heuristic_type());
+  }
+
+  // Same names, so the same signature, but a different label.
+  form.fields[2].label = ASCIIToUTF16("Phone");
+  FormStructure form_structure(form);
+  form_structure.DetermineHeuristicTypes();
+  ASSERT_EQ(3U, form_structure.field_count());
+  EXPECT_EQ(NAME_FIRST, form_structure.field(0)->heuristic_type());
+  EXPECT_EQ(NAME_LAST, form_structure.field(1)->heuristic_type());
+  EXPECT_EQ(PHONE_HOME_WHOLE_NUMBER,
+            form_structure.field(2)->heuristic_type());
+}
+
 TEST(FormStructureTest, HeuristicsAutocompletetype) {
   scoped_ptr<FormStructure> form_structure;
   FormData form;
@@ -4,6 +4,8 @@
 
 #include "chrome/browser/automation/url_request_automation_job.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/message_loop.h"
@@ -41,6 +43,11 @@ static const char* const kFilteredHeaderStrings[] = {
   "via"
 };
 
+// Chrome Frame is asked for at least this many bytes per read. Whatever the
+// pending read has no room for is kept in |buffered_data_| and used for the
+// following reads, so a large response needs far fewer IPC round trips.
+static const int kMinRequestReadSize = 256 * 1024;
+
 int URLRequestAutomationJob::instance_count_ = 0;
 bool URLRequestAutomationJob::is_protocol_factory_registered_ = false;
 
@@ -159,11 +166,17 @@ bool URLRequestAutomationJob::ReadRawData(
   // We should not receive a read request for a pending job.
   DCHECK(!is_pending());
 
+  if (!buffered_data_.empty()) {
+    *bytes_read = CopyBufferedData(buf, buf_size);
+    return true;
+  }
+
   pending_buf_ = buf;
   pending_buf_size_ = buf_size;
 
   if (message_filter_) {
-    message_filter_->Send(new AutomationMsg_RequestRead(tab_, id_, buf_size));
+    message_filter_->Send(new AutomationMsg_RequestRead(
+        tab_, id_, std::max(buf_size, kMinRequestReadSize)));
     SetStatus(net::URLRequestStatus(net::URLRequestStatus::IO_PENDING, 0));
   } else {
     MessageLoop::current()->PostTask(
@@ -315,14 +328,16 @@ void URLRequestAutomationJob::OnDataAvailable(
   SetStatus(net::URLRequestStatus());
 
   if (pending_buf_ && pending_buf_->data()) {
-    DCHECK_GE(pending_buf_size_, bytes.size());
-    const int bytes_to_copy = std::min(bytes.size(), pending_buf_size_);
+    DCHECK(buffered_data_.empty());
+    const size_t bytes_to_copy = std::min(bytes.size(), pending_buf_size_);
     memcpy(pending_buf_->data(), &bytes[0], bytes_to_copy);
+    if (bytes_to_copy < bytes.size())
+      buffered_data_.assign(bytes, bytes_to_copy, std::string::npos);
 
     pending_buf_ = NULL;
     pending_buf_size_ = 0;
 
-    NotifyReadComplete(bytes_to_copy);
+    NotifyReadComplete(static_cast<int>(bytes_to_copy));
   } else {
     NOTREACHED() << "Received unexpected data of length:" << bytes.size();
   }
@@ -386,6 +401,16 @@ void URLRequestAutomationJob::Cleanup() {
 
   pending_buf_ = NULL;
   pending_buf_size_ = 0;
+  buffered_data_.clear();
+}
+
+int URLRequestAutomationJob::CopyBufferedData(net::IOBuffer* buf,
+                                              int buf_size) {
+  const size_t bytes_to_copy =
+      std::min(buffered_data_.size(), static_cast<size_t>(buf_size));
+  memcpy(buf->data(), buffered_data_.data(), bytes_to_copy);
+  buffered_data_.erase(0, bytes_to_copy);
+  return static_cast<int>(bytes_to_copy);
 }
 
 void URLRequestAutomationJob::StartAsync() {
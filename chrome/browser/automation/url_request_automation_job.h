@@ -95,12 +95,18 @@ class URLRequestAutomationJob : public net::URLRequestJob {
   // function, which completes the job.
   void NotifyJobCompletionTask();
 
+  // Moves up to |buf_size| bytes of |buffered_data_| into |buf| and returns
+  // the number of bytes moved.
+  int CopyBufferedData(net::IOBuffer* buf, int buf_size);
+
   int id_;
   int tab_;
   scoped_refptr<AutomationResourceMessageFilter> message_filter_;
 
   scoped_refptr<net::IOBuffer> pending_buf_;
   size_t pending_buf_size_;
+  // Data received from Chrome Frame beyond what the last read asked for.
+  std::string buffered_data_;
 
   std::string mime_type_;
   scoped_refptr<net::HttpResponseHeaders> headers_;
@@ -223,10 +223,12 @@ bool BookmarkCodec::DecodeNode(const DictionaryValue& value,
     return false;
   }
 
+  // None of the keys contain a '.', so skip the path expansion done by the
+  // plain getters; this runs for every bookmark on startup.
   std::string id_string;
   int64 id = 0;
   if (ids_valid_) {
-    if (!value.GetString(kIdKey, &id_string) ||
+    if (!value.GetStringWithoutPathExpansion(kIdKey, &id_string) ||
         !base::StringToInt64(id_string, &id) ||
         ids_.count(id) != 0) {
       ids_valid_ = false;
@@ -238,10 +240,10 @@ bool BookmarkCodec::DecodeNode(const DictionaryValue& value,
   maximum_id_ = std::max(maximum_id_, id);
 
   string16 title;
-  value.GetString(kNameKey, &title);
+  value.GetStringWithoutPathExpansion(kNameKey, &title);
 
   std::string date_added_string;
-  if (!value.GetString(kDateAddedKey, &date_added_string))
+  if (!value.GetStringWithoutPathExpansion(kDateAddedKey, &date_added_string))
     date_added_string = base::Int64ToString(Time::Now().ToInternalValue());
   int64 internal_time;
   base::StringToInt64(date_added_string, &internal_time);
@@ -261,7 +263,7 @@ bool BookmarkCodec::DecodeNode(const DictionaryValue& value,
 #endif
 
   std::string type_string;
-  if (!value.GetString(kTypeKey, &type_string))
+  if (!value.GetStringWithoutPathExpansion(kTypeKey, &type_string))
     return false;
 
   if (type_string != kTypeURL && type_string != kTypeFolder)
@@ -269,10 +271,10 @@ bool BookmarkCodec::DecodeNode(const DictionaryValue& value,
 
   if (type_string == kTypeURL) {
     std::string url_string;
-    if (!value.GetString(kURLKey, &url_string))
+    if (!value.GetStringWithoutPathExpansion(kURLKey, &url_string))
       return false;
 
-    GURL url = GURL(url_string);
+    GURL url(url_string);
     if (!node && url.is_valid())
       node = new BookmarkNode(id, url);
     else
@@ -284,11 +286,12 @@ bool BookmarkCodec::DecodeNode(const DictionaryValue& value,
     UpdateChecksumWithUrlNode(id_string, title, url_string);
   } else {
     std::string last_modified_date;
-    if (!value.GetString(kDateModifiedKey, &last_modified_date))
+    if (!value.GetStringWithoutPathExpansion(kDateModifiedKey,
+                                             &last_modified_date))
       last_modified_date = base::Int64ToString(Time::Now().ToInternalValue());
 
     Value* child_values;
-    if (!value.Get(kChildrenKey, &child_values))
+    if (!value.GetWithoutPathExpansion(kChildrenKey, &child_values))
       return false;
 
     if (child_values->GetType() != Value::TYPE_LIST)
@@ -251,11 +251,8 @@ std::vector<string16> BookmarkIndex::ExtractQueryWords(const string16& query) {
 
 void BookmarkIndex::RegisterNode(const string16& term,
                                  const BookmarkNode* node) {
-  if (std::find(index_[term].begin(), index_[term].end(), node) !=
-      index_[term].end()) {
-    // We've already added node for term.
-    return;
-  }
+  // This is a no-op if we've already added node for term, as happens for a
+  // title containing the same term more than once.
   index_[term].insert(node);
 }
 
@@ -14,6 +14,7 @@
 #include "base/debug/trace_event.h"
 #include "base/file_path.h"
 #include "base/file_util.h"
+#include "base/message_loop.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/path_service.h"
@@ -255,6 +256,16 @@ void InitializeNetworkOptions(const CommandLine& parsed_command_line) {
   if (parsed_command_line.HasSwitch(switches::kEnableHttpPipelining))
     net::HttpStreamFactory::set_http_pipelining_enabled(true);
 
+  if (parsed_command_line.HasSwitch(switches::kEnableSocketWarmPool))
+    net::internal::ClientSocketPoolBaseHelper::set_warm_pool_enabled(true);
+
+  if (parsed_command_line.HasSwitch(
+          switches::kDrainConnectionsOnNetworkChange)) {
+    net::internal::ClientSocketPoolBaseHelper::
+        set_drain_on_ip_address_change(true);
+    net::SpdySessionPool::set_drain_sessions_on_ip_address_change(true);
+  }
+
   if (parsed_command_line.HasSwitch(switches::kTestingFixedHttpPort)) {
     int value;
     base::StringToInt(
@@ -360,6 +371,7 @@ PrefService* InitializeLocalState(const CommandLine& parsed_command_line,
 Profile* CreateProfile(const content::MainFunctionParams& parameters,
                        const FilePath& user_data_dir,
                        const CommandLine& parsed_command_line) {
+  TRACE_EVENT0("startup", "CreateProfile");
   Profile* profile;
   if (ProfileManager::IsMultipleProfilesEnabled() &&
       parsed_command_line.HasSwitch(switches::kProfileDirectory)) {
@@ -434,11 +446,8 @@ void InitializeGpuDataManager(const CommandLine& parsed_command_line) {
   const base::StringPiece gpu_blacklist_json(
       ResourceBundle::GetSharedInstance().GetRawDataResource(
           IDR_GPU_BLACKLIST));
-  GpuBlacklist* gpu_blacklist = GpuBlacklist::GetInstance();
-  bool succeed = gpu_blacklist->LoadGpuBlacklist(
-      gpu_blacklist_json.as_string(), GpuBlacklist::kCurrentOsOnly);
-  DCHECK(succeed);
-  gpu_blacklist->UpdateGpuDataManager();
+  GpuBlacklist::GetInstance()->LoadGpuBlacklistForStartup(
+      gpu_blacklist_json.as_string(), g_browser_process->local_state());
 }
 
 #if defined(OS_MACOSX)
@@ -509,6 +518,21 @@ bool HasImportSwitch(const CommandLine& command_line) {
           command_line.HasSwitch(switches::kImportFromFile));
 }
 
+// Records the startup metrics that nothing on the way to the first browser
+// window depends on. Posted to run once the main message loop starts.
+void RecordDeferredStartupMetrics(MetricsService* metrics_service,
+                                  PrefService* local_state,
+                                  const std::string& accept_languages,
+                                  const std::string& application_locale) {
+  TRACE_EVENT0("startup", "RecordDeferredStartupMetrics");
+  RecordBreakpadStatusUMA(metrics_service);
+#if !defined(OS_ANDROID)
+  about_flags::RecordUMAStatistics(local_state);
+#endif
+  LanguageUsageMetrics::RecordAcceptLanguages(accept_languages);
+  LanguageUsageMetrics::RecordApplicationLanguage(application_locale);
+}
+
 }  // namespace
 
 namespace chrome_browser {
@@ -1233,6 +1257,15 @@ int ChromeBrowserMainParts::PreCreateThreadsImpl() {
     tracked_objects::ThreadData::InitializeAndSetTrackingStatus(status);
   }
 
+  if (parsed_command_line().HasSwitch(switches::kProfilingSamplingInterval)) {
+    int interval = 0;
+    if (base::StringToInt(parsed_command_line().GetSwitchValueASCII(
+            switches::kProfilingSamplingInterval), &interval) &&
+        interval >= 1) {
+      tracked_objects::ThreadData::SetSamplingInterval(interval);
+    }
+  }
+
   if (parsed_command_line().HasSwitch(switches::kProfilingOutputFile)) {
     tracking_objects_.set_output_file_path(
         parsed_command_line().GetSwitchValuePath(
@@ -1437,6 +1470,8 @@ void ChromeBrowserMainParts::PostBrowserStart() {
 }
 
 int ChromeBrowserMainParts::PreMainMessageLoopRunImpl() {
+  TRACE_EVENT0("startup", "ChromeBrowserMainParts::PreMainMessageLoopRunImpl");
+
   // Now that the file thread has been started, start recording.
   StartMetricsRecording();
 
@@ -1549,7 +1584,9 @@ int ChromeBrowserMainParts::PreMainMessageLoopRunImpl() {
 
   // Autoload any profiles which are running background apps.
   // TODO(rlp): Do this on a separate thread. See http://crbug.com/99075.
+  TRACE_EVENT_BEGIN0("startup", "ProfileManager::AutoloadProfiles");
   browser_process_->profile_manager()->AutoloadProfiles();
+  TRACE_EVENT_END0("startup", "ProfileManager::AutoloadProfiles");
 
   // Post-profile init ---------------------------------------------------------
 
@@ -1731,14 +1768,13 @@ int ChromeBrowserMainParts::PreMainMessageLoopRunImpl() {
 #endif
 
   HandleTestParameters(parsed_command_line());
-  RecordBreakpadStatusUMA(browser_process_->metrics_service());
-#if !defined(OS_ANDROID)
-  about_flags::RecordUMAStatistics(local_state_);
-#endif
-  LanguageUsageMetrics::RecordAcceptLanguages(
-      profile_->GetPrefs()->GetString(prefs::kAcceptLanguages));
-  LanguageUsageMetrics::RecordApplicationLanguage(
-      browser_process_->GetApplicationLocale());
+  MessageLoop::current()->PostTask(
+      FROM_HERE,
+      base::Bind(&RecordDeferredStartupMetrics,
+                 browser_process_->metrics_service(),
+                 local_state_,
+                 profile_->GetPrefs()->GetString(prefs::kAcceptLanguages),
+                 browser_process_->GetApplicationLocale()));
 
   // The extension service may be available at this point. If the command line
   // specifies --uninstall-extension, attempt the uninstall extension startup
@@ -1774,7 +1810,9 @@ int ChromeBrowserMainParts::PreMainMessageLoopRunImpl() {
 #endif
 
   // Load GPU Blacklist.
+  TRACE_EVENT_BEGIN0("startup", "InitializeGpuDataManager");
   InitializeGpuDataManager(parsed_command_line());
+  TRACE_EVENT_END0("startup", "InitializeGpuDataManager");
 
   // Start watching all browser threads for responsiveness.
   ThreadWatcherList::StartWatchingAll(parsed_command_line());
@@ -1807,8 +1845,12 @@ int ChromeBrowserMainParts::PreMainMessageLoopRunImpl() {
     std::vector<Profile*> last_opened_profiles =
         g_browser_process->profile_manager()->GetLastOpenedProfiles();
 #endif
-    if (browser_init_->Start(parsed_command_line(), FilePath(),
-                             profile_, last_opened_profiles, &result_code)) {
+    TRACE_EVENT_BEGIN0("startup", "BrowserInit::Start");
+    bool started = browser_init_->Start(parsed_command_line(), FilePath(),
+                                        profile_, last_opened_profiles,
+                                        &result_code);
+    TRACE_EVENT_END0("startup", "BrowserInit::Start");
+    if (started) {
 #if defined(OS_WIN) || (defined(OS_LINUX) && !defined(OS_CHROMEOS))
       // Initialize autoupdate timer. Timer callback costs basically nothing
       // when browser is not in persistent mode, so it's OK to let it ride on
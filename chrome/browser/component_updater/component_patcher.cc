@@ -0,0 +1,156 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/component_updater/component_patcher.h"
+
+#include <string>
+
+#include "base/file_path.h"
+#include "base/file_util.h"
+#include "base/json/json_file_value_serializer.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/string_util.h"
+#include "base/values.h"
+#include "chrome/browser/component_updater/component_updater_service.h"
+#include "courgette/courgette.h"
+#include "courgette/streams.h"
+#include "courgette/third_party/bsdiff.h"
+
+namespace {
+
+const FilePath::CharType kCommandsFileName[] =
+    FILE_PATH_LITERAL("commands.json");
+const FilePath::CharType kManifestFileName[] =
+    FILE_PATH_LITERAL("manifest.json");
+
+// Reads the relative path in |key| of |command|. Paths that could escape the
+// directory they are relative to are rejected.
+bool GetRelativePath(const base::DictionaryValue* command,
+                     const char* key,
+                     std::string* relative) {
+  if (!command->GetStringASCII(key, relative) || relative->empty())
+    return false;
+  FilePath relative_path = FilePath().AppendASCII(*relative);
+  return !relative_path.IsAbsolute() && !relative_path.ReferencesParent();
+}
+
+// Like GetRelativePath(), but returns the path appended to |base|.
+bool GetCommandPath(const base::DictionaryValue* command,
+                    const char* key,
+                    const FilePath& base,
+                    FilePath* path) {
+  std::string relative;
+  if (!GetRelativePath(command, key, &relative))
+    return false;
+  *path = base.AppendASCII(relative);
+  return true;
+}
+
+bool ApplyBsdiffPatch(const FilePath& input_file,
+                      const FilePath& patch_file,
+                      const FilePath& output_file) {
+  std::string input;
+  std::string patch;
+  if (!file_util::ReadFileToString(input_file, &input) ||
+      !file_util::ReadFileToString(patch_file, &patch))
+    return false;
+
+  courgette::SourceStream input_stream;
+  courgette::SourceStream patch_stream;
+  courgette::SinkStream output_stream;
+  input_stream.Init(input);
+  patch_stream.Init(patch);
+  if (courgette::ApplyBinaryPatch(&input_stream, &patch_stream,
+                                  &output_stream) != courgette::OK)
+    return false;
+
+  int size = static_cast<int>(output_stream.Length());
+  return file_util::WriteFile(
+      output_file, reinterpret_cast<const char*>(output_stream.Buffer()),
+      size) == size;
+}
+
+// Carries out one entry of commands.json.
+ComponentUnpacker::Error ApplyCommand(const base::DictionaryValue* command,
+                                      const FilePath& unpack_path,
+                                      const FilePath& output_path,
+                                      ComponentInstaller* installer) {
+  std::string op;
+  FilePath output_file;
+  if (!command->GetStringASCII("op", &op) ||
+      !GetCommandPath(command, "output", output_path, &output_file))
+    return ComponentUnpacker::kDeltaBadCommands;
+
+  FilePath input_file;
+  if (op != "create") {
+    std::string input;
+    if (!GetRelativePath(command, "input", &input))
+      return ComponentUnpacker::kDeltaBadCommands;
+    if (!installer->GetInstalledFile(input, &input_file) ||
+        !file_util::PathExists(input_file))
+      return ComponentUnpacker::kDeltaMissingExistingFile;
+  }
+
+  FilePath patch_file;
+  if (op != "copy" &&
+      !GetCommandPath(command, "patch", unpack_path, &patch_file))
+    return ComponentUnpacker::kDeltaBadCommands;
+
+  if (!file_util::CreateDirectory(output_file.DirName()))
+    return ComponentUnpacker::kDeltaOperationFailure;
+
+  bool success = false;
+  if (op == "copy") {
+    success = file_util::CopyFile(input_file, output_file);
+  } else if (op == "create") {
+    success = file_util::Move(patch_file, output_file);
+  } else if (op == "courgette") {
+    success = courgette::ApplyEnsemblePatch(input_file.value().c_str(),
+                                            patch_file.value().c_str(),
+                                            output_file.value().c_str()) ==
+        courgette::C_OK;
+  } else if (op == "bsdiff") {
+    success = ApplyBsdiffPatch(input_file, patch_file, output_file);
+  } else {
+    return ComponentUnpacker::kDeltaBadCommands;
+  }
+  return success ? ComponentUnpacker::kNone :
+                   ComponentUnpacker::kDeltaOperationFailure;
+}
+
+}  // namespace
+
+bool IsDifferentialUpdate(const FilePath& unpack_path) {
+  return file_util::PathExists(unpack_path.Append(kCommandsFileName));
+}
+
+ComponentUnpacker::Error ApplyDifferentialUpdate(
+    const FilePath& unpack_path,
+    const FilePath& output_path,
+    ComponentInstaller* installer) {
+  JSONFileValueSerializer serializer(unpack_path.Append(kCommandsFileName));
+  std::string error;
+  scoped_ptr<base::Value> root(serializer.Deserialize(NULL, &error));
+  if (!root.get() || !root->IsType(base::Value::TYPE_LIST))
+    return ComponentUnpacker::kDeltaBadCommands;
+  const base::ListValue* commands = static_cast<base::ListValue*>(root.get());
+
+  if (!file_util::CreateDirectory(output_path))
+    return ComponentUnpacker::kDeltaOperationFailure;
+
+  for (size_t i = 0; i < commands->GetSize(); ++i) {
+    base::DictionaryValue* command = NULL;
+    if (!commands->GetDictionary(i, &command))
+      return ComponentUnpacker::kDeltaBadCommands;
+    ComponentUnpacker::Error result =
+        ApplyCommand(command, unpack_path, output_path, installer);
+    if (result != ComponentUnpacker::kNone)
+      return result;
+  }
+
+  if (!file_util::CopyFile(unpack_path.Append(kManifestFileName),
+                           output_path.Append(kManifestFileName)))
+    return ComponentUnpacker::kDeltaOperationFailure;
+  return ComponentUnpacker::kNone;
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_COMPONENT_UPDATER_COMPONENT_PATCHER_H_
+#define CHROME_BROWSER_COMPONENT_UPDATER_COMPONENT_PATCHER_H_
+#pragma once
+
+#include "chrome/browser/component_updater/component_unpacker.h"
+
+class ComponentInstaller;
+class FilePath;
+
+// A differential update is a CRX that, besides the manifest.json of the new
+// version, contains a commands.json which says how to build each file of the
+// new version from the currently installed version:
+//
+//   [{"op": "copy", "output": "a.dll", "input": "a.dll"},
+//    {"op": "create", "output": "b.dll", "patch": "b.dll"},
+//    {"op": "courgette", "output": "c.dll", "input": "c.dll",
+//     "patch": "c.dll.courgette"},
+//    {"op": "bsdiff", "output": "d.pak", "input": "d.pak",
+//     "patch": "d.pak.bsdiff"}]
+//
+// "input" names a file of the installed component, as resolved by
+// ComponentInstaller::GetInstalledFile(), and "patch" names a file in the
+// unpacked update. "output" is the file to create in the new version.
+
+// Returns true if the CRX unpacked in |unpack_path| is a differential update.
+bool IsDifferentialUpdate(const FilePath& unpack_path);
+
+// Builds the full new version of the component in |output_path| from the
+// differential update unpacked in |unpack_path| and the files |installer|
+// has installed. Does file IO and patching, so it must not be called on a
+// browser thread that can't block.
+ComponentUnpacker::Error ApplyDifferentialUpdate(
+    const FilePath& unpack_path,
+    const FilePath& output_path,
+    ComponentInstaller* installer);
+
+#endif  // CHROME_BROWSER_COMPONENT_UPDATER_COMPONENT_PATCHER_H_
@@ -12,8 +12,9 @@
 #include "base/memory/scoped_handle.h"
 #include "base/string_number_conversions.h"
 #include "base/stringprintf.h"
-#include "chrome/browser/extensions/sandboxed_extension_unpacker.h"
+#include "chrome/browser/component_updater/component_patcher.h"
 #include "chrome/browser/component_updater/component_updater_service.h"
+#include "chrome/browser/extensions/sandboxed_extension_unpacker.h"
 #include "chrome/common/extensions/extension_constants.h"
 #include "chrome/common/zip.h"
 #include "crypto/secure_hash.h"
@@ -139,7 +140,8 @@ base::DictionaryValue* ReadManifest(const FilePath& unpack_path) {
 ComponentUnpacker::ComponentUnpacker(const std::vector<uint8>& pk_hash,
                                      const FilePath& path,
                                      ComponentInstaller* installer)
-  : error_(kNone) {
+  : installer_(installer),
+    error_(kNone) {
   if (pk_hash.empty() || path.empty()) {
     error_ = kInvalidParams;
     return;
@@ -190,12 +192,31 @@ ComponentUnpacker::ComponentUnpacker(const std::vector<uint8>& pk_hash,
     error_ = kUnzipFailed;
     return;
   }
-  scoped_ptr<base::DictionaryValue> manifest(ReadManifest(unpack_path_));
-  if (!manifest.get()) {
+  if (IsDifferentialUpdate(unpack_path_)) {
+    // Build the full new version next to the unpacked delta, then carry on
+    // as if the full version had been downloaded.
+    FilePath patched_path =
+        unpack_path_.InsertBeforeExtensionASCII("_patched");
+    if (file_util::DirectoryExists(patched_path))
+      file_util::Delete(patched_path, true);
+    error_ = ApplyDifferentialUpdate(unpack_path_, patched_path, installer);
+    file_util::Delete(unpack_path_, true);
+    unpack_path_ = patched_path;
+    if (error_ != kNone)
+      return;
+  }
+  manifest_.reset(ReadManifest(unpack_path_));
+  if (!manifest_.get()) {
     error_ = kBadManifest;
     return;
   }
-  if (!installer->Install(manifest.release(), unpack_path_)) {
+}
+
+void ComponentUnpacker::Install() {
+  if (error_ != kNone)
+    return;
+  DCHECK(manifest_.get());
+  if (!installer_->Install(manifest_.release(), unpack_path_)) {
     error_ = kInstallerError;
     return;
   }
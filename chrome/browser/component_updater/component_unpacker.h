@@ -9,13 +9,24 @@
 #include <vector>
 
 #include "base/file_path.h"
+#include "base/memory/scoped_ptr.h"
 
 class ComponentInstaller;
 
+namespace base {
+class DictionaryValue;
+}
+
 // In charge of unpacking the component CRX package and verifying that it is
-// well formed and the cryptographic signature is correct. If there is no
-// error the component specific installer will be invoked to proceed with
-// the component installation or update.
+// well formed and the cryptographic signature is correct. If the CRX is a
+// differential update the full new version is then built from it and the
+// installed version, see component_patcher.h. If there is no error, Install()
+// invokes the component specific installer to proceed with the component
+// installation or update.
+//
+// Unpacking and patching are expensive, so the constructor is meant to run
+// on a worker pool thread. Install() must run on the thread the installers
+// expect, which is the file thread.
 //
 // This class should be used only by the component updater. It is inspired
 // and overlaps with code in the extension's SandboxedExtensionUnpacker.
@@ -38,9 +49,13 @@ class ComponentUnpacker {
     kBadExtension,
     kInvalidId,
     kInstallerError,
+    kDeltaBadCommands,
+    kDeltaMissingExistingFile,
+    kDeltaOperationFailure,
   };
-  // Unpacks, verifies and calls the installer. |pk_hash| is the expected
-  // public key SHA256 hash. |path| is the current location of the CRX.
+  // Unpacks, verifies and, for differential updates, patches. |pk_hash| is
+  // the expected public key SHA256 hash. |path| is the current location of
+  // the CRX.
   ComponentUnpacker(const std::vector<uint8>& pk_hash,
                     const FilePath& path,
                     ComponentInstaller* installer);
@@ -49,11 +64,19 @@ class ComponentUnpacker {
   // destructor will delete the unpacked CRX files.
   ~ComponentUnpacker();
 
+  // Calls the installer with the unpacked component. Does nothing if
+  // unpacking failed.
+  void Install();
+
   Error error() const { return error_; }
 
  private:
   FilePath unpack_path_;
+  ComponentInstaller* installer_;
+  scoped_ptr<base::DictionaryValue> manifest_;
   Error error_;
+
+  DISALLOW_COPY_AND_ASSIGN(ComponentUnpacker);
 };
 
 #endif  // CHROME_BROWSER_COMPONENT_UPDATER_COMPONENT_UNPACKER_H_
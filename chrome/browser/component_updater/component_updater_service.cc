@@ -18,6 +18,7 @@
 #include "base/string_piece.h"
 #include "base/string_util.h"
 #include "base/stringprintf.h"
+#include "base/threading/sequenced_worker_pool.h"
 #include "base/timer.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/component_updater/component_unpacker.h"
@@ -188,12 +189,16 @@ struct CrxUpdateItem {
 
   Status status;
   GURL crx_url;
+  // Differential update for the installed version, if the server has one.
+  GURL diff_crx_url;
+  // Set when applying |diff_crx_url| failed, so the full |crx_url| is used.
+  bool diff_update_failed;
   std::string id;
   base::Time last_check;
   CrxComponent component;
   Version next_version;
 
-  CrxUpdateItem() : status(kNew) {}
+  CrxUpdateItem() : status(kNew), diff_update_failed(false) {}
 
   // Function object used to find a specific component.
   class FindById {
@@ -225,9 +230,9 @@ CrxComponent::~CrxComponent() {}
 // the tasks. Also when we do network requests there is only one |url_fetcher_|
 // in flight at at a time.
 // There are no locks in this code, the main structure |work_items_| is mutated
-// only from the UI thread. The unpack and installation is done in the file
-// thread and the network requests are done in the IO thread and in the file
-// thread.
+// only from the UI thread. The unpack and patching is done in the blocking
+// pool, the installation is done in the file thread and the network requests
+// are done in the IO thread and in the file thread.
 class CrxUpdateService : public ComponentUpdateService {
  public:
   explicit CrxUpdateService(ComponentUpdateService::Configurator* config);
@@ -286,7 +291,8 @@ class CrxUpdateService : public ComponentUpdateService {
     ComponentInstaller* installer;
     std::vector<uint8> pk_hash;
     std::string id;
-    CRXContext() : installer(NULL) {}
+    bool is_differential;
+    CRXContext() : installer(NULL), is_differential(false) {}
   };
 
   void OnURLFetchComplete(const content::URLFetcher* source,
@@ -312,9 +318,14 @@ class CrxUpdateService : public ComponentUpdateService {
 
   void ParseManifest(const std::string& xml);
 
-  void Install(const CRXContext* context, const FilePath& crx_path);
+  void Unpack(const CRXContext* context, const FilePath& crx_path);
+
+  void Install(const CRXContext* context,
+               const FilePath& crx_path,
+               ComponentUnpacker* unpacker);
 
   void DoneInstalling(const std::string& component_id,
+                      bool is_differential,
                       ComponentUnpacker::Error error);
 
   size_t ChangeItemStatus(CrxUpdateItem::Status from,
@@ -499,14 +510,18 @@ void CrxUpdateService::ProcessPendingItems() {
     CrxUpdateItem* item = *it;
     if (item->status != CrxUpdateItem::kCanUpdate)
       continue;
-    // Found component to update, start the process.
+    // Found component to update, start the process. Prefer the smaller
+    // differential update unless it already failed to apply.
     item->status = CrxUpdateItem::kDownloading;
     CRXContext* context = new CRXContext;
     context->pk_hash = item->component.pk_hash;
     context->id = item->id;
     context->installer = item->component.installer;
+    context->is_differential =
+        item->diff_crx_url.is_valid() && !item->diff_update_failed;
     url_fetcher_.reset(content::URLFetcher::Create(
-        0, item->crx_url, content::URLFetcher::GET,
+        0, context->is_differential ? item->diff_crx_url : item->crx_url,
+        content::URLFetcher::GET,
         MakeContextDelegate(this, context)));
     StartFetch(url_fetcher_.get(), config_->RequestContext(), true);
     return;
@@ -648,6 +663,8 @@ void CrxUpdateService::OnParseUpdateManifestSucceeded(
     // All test passed. Queue an upgrade for this component and fire the
     // notifications.
     crx->crx_url = it->crx_url;
+    crx->diff_crx_url = it->diff_crx_url;
+    crx->diff_update_failed = false;
     crx->status = CrxUpdateItem::kCanUpdate;
     crx->next_version = Version(it->version);
     ++update_pending;
@@ -677,8 +694,8 @@ void CrxUpdateService::OnParseUpdateManifestFailed(
 }
 
 // Called when the CRX package has been downloaded to a temporary location.
-// Here we fire the notifications and schedule the component-specific installer
-// to be called in the file thread.
+// Here we fire the notifications and schedule the unpacking in the blocking
+// pool.
 void CrxUpdateService::OnURLFetchComplete(const content::URLFetcher* source,
                                           CRXContext* context) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
@@ -705,10 +722,9 @@ void CrxUpdateService::OnURLFetchComplete(const content::URLFetcher* source,
         content::NotificationService::NoDetails());
 
     // Why unretained? See comment at top of file.
-    BrowserThread::PostDelayedTask(
-        BrowserThread::FILE,
+    BrowserThread::GetBlockingPool()->PostDelayedTask(
         FROM_HERE,
-        base::Bind(&CrxUpdateService::Install,
+        base::Bind(&CrxUpdateService::Unpack,
                    base::Unretained(this),
                    context,
                    temp_crx_path),
@@ -716,16 +732,30 @@ void CrxUpdateService::OnURLFetchComplete(const content::URLFetcher* source,
   }
 }
 
-// Install consists of digital signature verification, unpacking and then
-// calling the component specific installer. All that is handled by the
-// |unpacker|. If there is an error this function is in charge of deleting
+// Unpacking consists of digital signature verification, unzipping and, for
+// differential updates, applying the patches. It does not touch the installed
+// component so it runs in the blocking pool, away from the file thread.
+void CrxUpdateService::Unpack(const CRXContext* context,
+                              const FilePath& crx_path) {
+  ComponentUnpacker* unpacker =
+      new ComponentUnpacker(context->pk_hash, crx_path, context->installer);
+  // Why unretained? See comment at top of file.
+  BrowserThread::PostTask(
+      BrowserThread::FILE,
+      FROM_HERE,
+      base::Bind(&CrxUpdateService::Install, base::Unretained(this),
+                 context, crx_path, base::Owned(unpacker)));
+}
+
+// Install calls the component specific installer with what |unpacker|
+// produced. If there is an error the |unpacker| is in charge of deleting
 // the files created.
 void CrxUpdateService::Install(const CRXContext* context,
-                               const FilePath& crx_path) {
+                               const FilePath& crx_path,
+                               ComponentUnpacker* unpacker) {
   // This function owns the |crx_path| and the |context| object.
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
-  ComponentUnpacker
-      unpacker(context->pk_hash, crx_path, context->installer);
+  unpacker->Install();
   if (!file_util::Delete(crx_path, false)) {
     NOTREACHED() << crx_path.value();
   }
@@ -734,18 +764,26 @@ void CrxUpdateService::Install(const CRXContext* context,
       BrowserThread::UI,
       FROM_HERE,
       base::Bind(&CrxUpdateService::DoneInstalling, base::Unretained(this),
-                 context->id, unpacker.error()),
+                 context->id, context->is_differential, unpacker->error()),
       base::TimeDelta::FromMilliseconds(config_->StepDelay()));
   delete context;
 }
 
 // Installation has been completed. Adjust the component status and
-// schedule the next check.
+// schedule the next check. A differential update that failed is retried
+// right away with the full CRX.
 void CrxUpdateService::DoneInstalling(const std::string& component_id,
+                                      bool is_differential,
                                       ComponentUnpacker::Error error) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
 
   CrxUpdateItem* item = FindUpdateItemById(component_id);
+  if (is_differential && error != ComponentUnpacker::kNone) {
+    item->diff_update_failed = true;
+    item->status = CrxUpdateItem::kCanUpdate;
+    ScheduleNextRun(true);
+    return;
+  }
   item->status = (error == ComponentUnpacker::kNone) ? CrxUpdateItem::kUpdated :
                                                        CrxUpdateItem::kNoUpdate;
   if (item->status == CrxUpdateItem::kUpdated)
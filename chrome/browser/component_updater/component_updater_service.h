@@ -23,7 +23,7 @@ class DictionaryValue;
 }
 
 // Component specific installers must derive from this class and implement
-// OnUpdateError() and Install(). A valid instance of this class must be
+// OnUpdateError(), Install() and GetInstalledFile(). A valid instance of this class must be
 // given to ComponentUpdateService::RegisterComponent().
 class ComponentInstaller {
  public :
@@ -40,6 +40,13 @@ class ComponentInstaller {
   // with all the unpacked CRX files.
   virtual bool Install(base::DictionaryValue* manifest,
                        const FilePath& unpack_path) = 0;
+
+  // Called by the component updater to apply a differential update. Sets
+  // |installed_file| to the location of |file|, a path relative to the
+  // component root, in the currently installed version of the component.
+  // Returns false if the component is not installed or has no such file.
+  virtual bool GetInstalledFile(const std::string& file,
+                                FilePath* installed_file) = 0;
 };
 
 // Describes a particular component that can be installed or updated. This
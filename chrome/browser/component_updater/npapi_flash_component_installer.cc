@@ -76,6 +76,9 @@ class NPAPIFlashComponentInstaller : public ComponentInstaller {
   virtual bool Install(base::DictionaryValue* manifest,
                        const FilePath& unpack_path) OVERRIDE;
 
+  virtual bool GetInstalledFile(const std::string& file,
+                                FilePath* installed_file) OVERRIDE;
+
  private:
   Version current_version_;
 };
@@ -113,6 +116,13 @@ bool NPAPIFlashComponentInstaller::Install(base::DictionaryValue* manifest,
   return true;
 }
 
+bool NPAPIFlashComponentInstaller::GetInstalledFile(
+    const std::string& file, FilePath* installed_file) {
+  // The registered version can belong to a flash that was not installed by
+  // the component updater, so differential updates are not supported.
+  return false;
+}
+
 void FinishFlashUpdateRegistration(ComponentUpdateService* cus,
                                    const webkit::WebPluginInfo& info) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
@@ -228,6 +228,9 @@ class PepperFlashComponentInstaller : public ComponentInstaller {
   virtual bool Install(base::DictionaryValue* manifest,
                        const FilePath& unpack_path) OVERRIDE;
 
+  virtual bool GetInstalledFile(const std::string& file,
+                                FilePath* installed_file) OVERRIDE;
+
  private:
   Version current_version_;
 };
@@ -269,6 +272,15 @@ bool PepperFlashComponentInstaller::Install(base::DictionaryValue* manifest,
   return true;
 }
 
+bool PepperFlashComponentInstaller::GetInstalledFile(
+    const std::string& file, FilePath* installed_file) {
+  if (current_version_.Equals(Version(kNullVersion)))
+    return false;  // No flash installed yet.
+  *installed_file = GetPepperFlashBaseDirectory().AppendASCII(
+      current_version_.GetString()).AppendASCII(file);
+  return true;
+}
+
 bool CheckPepperFlashManifest(base::DictionaryValue* manifest,
                               Version* version_out) {
   std::string name;
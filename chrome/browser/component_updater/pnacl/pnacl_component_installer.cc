@@ -141,6 +141,9 @@ class PnaclComponentInstaller : public ComponentInstaller {
   virtual bool Install(base::DictionaryValue* manifest,
                        const FilePath& unpack_path) OVERRIDE;
 
+  virtual bool GetInstalledFile(const std::string& file,
+                                FilePath* installed_file) OVERRIDE;
+
  private:
   Version current_version_;
 };
@@ -185,6 +188,15 @@ bool PnaclComponentInstaller::Install(base::DictionaryValue* manifest,
   return true;
 }
 
+bool PnaclComponentInstaller::GetInstalledFile(
+    const std::string& file, FilePath* installed_file) {
+  if (current_version_.Equals(Version(kNullVersion)))
+    return false;  // No pnacl installed yet.
+  *installed_file = GetPnaclBaseDirectory().AppendASCII(
+      current_version_.GetString()).AppendASCII(file);
+  return true;
+}
+
 namespace {
 
 // Finally, do the registration with the right version number.
@@ -4,6 +4,8 @@
 
 #include "chrome/browser/content_settings/content_settings_origin_identifier_value_map.h"
 
+#include <algorithm>
+
 #include "base/compiler_specific.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
@@ -53,6 +55,61 @@ class RuleIteratorImpl : public RuleIterator {
   scoped_ptr<base::AutoLock> auto_lock_;
 };
 
+// Like |RuleIteratorImpl|, but iterates a list of rules picked from a |Rules|
+// map.
+class RuleListIterator : public RuleIterator {
+ public:
+  // |RuleListIterator| takes the contents of |rules| and the ownership of
+  // |auto_lock|.
+  RuleListIterator(
+      std::vector<OriginIdentifierValueMap::Rules::const_iterator>* rules,
+      base::AutoLock* auto_lock)
+      : current_rule_(0),
+        auto_lock_(auto_lock) {
+    rules_.swap(*rules);
+  }
+  virtual ~RuleListIterator() {}
+
+  virtual bool HasNext() const OVERRIDE {
+    return current_rule_ < rules_.size();
+  }
+
+  virtual Rule Next() OVERRIDE {
+    DCHECK(HasNext());
+    OriginIdentifierValueMap::Rules::const_iterator rule =
+        rules_[current_rule_++];
+    DCHECK(rule->second.get());
+    return Rule(rule->first.primary_pattern,
+                rule->first.secondary_pattern,
+                rule->second.get()->DeepCopy());
+  }
+
+ private:
+  std::vector<OriginIdentifierValueMap::Rules::const_iterator> rules_;
+  size_t current_rule_;
+  scoped_ptr<base::AutoLock> auto_lock_;
+};
+
+// Orders rules the same way as |OriginIdentifierValueMap::Rules|.
+bool RulePrecedes(const OriginIdentifierValueMap::Rules::const_iterator& a,
+                  const OriginIdentifierValueMap::Rules::const_iterator& b) {
+  return a->first < b->first;
+}
+
+void AppendRulesForHost(
+    const std::multimap<std::string,
+                        OriginIdentifierValueMap::Rules::const_iterator>& index,
+    const std::string& host,
+    std::vector<OriginIdentifierValueMap::Rules::const_iterator>* rules) {
+  typedef std::multimap<std::string,
+                        OriginIdentifierValueMap::Rules::const_iterator>
+      HostIndex;
+  std::pair<HostIndex::const_iterator, HostIndex::const_iterator> range =
+      index.equal_range(host);
+  for (HostIndex::const_iterator it = range.first; it != range.second; ++it)
+    rules->push_back(it->second);
+}
+
 }  // namespace
 
 OriginIdentifierValueMap::EntryMapKey::EntryMapKey(
@@ -108,6 +165,24 @@ RuleIterator* OriginIdentifierValueMap::GetRuleIterator(
                               auto_lock.release());
 }
 
+RuleIterator* OriginIdentifierValueMap::GetRuleIteratorForURL(
+    const GURL& primary_url,
+    ContentSettingsType content_type,
+    const ResourceIdentifier& resource_identifier,
+    base::Lock* lock) const {
+  // As in |GetRuleIterator|, the lock is held from the lookup until the
+  // iterator is destroyed.
+  scoped_ptr<base::AutoLock> auto_lock;
+  if (lock)
+    auto_lock.reset(new base::AutoLock(*lock));
+  std::vector<Rules::const_iterator> rules;
+  GetRulesForURL(EntryMapKey(content_type, resource_identifier), primary_url,
+                 &rules);
+  if (rules.empty())
+    return new EmptyRuleIterator();
+  return new RuleListIterator(&rules, auto_lock.release());
+}
+
 size_t OriginIdentifierValueMap::size() const {
   size_t size = 0;
   EntryMap::const_iterator it;
@@ -125,16 +200,15 @@ Value* OriginIdentifierValueMap::GetValue(
     const GURL& secondary_url,
     ContentSettingsType content_type,
     const ResourceIdentifier& resource_identifier) const {
-  EntryMapKey key(content_type, resource_identifier);
-  EntryMap::const_iterator it = entries_.find(key);
-  if (it == entries_.end())
-      return NULL;
+  std::vector<Rules::const_iterator> rules;
+  GetRulesForURL(EntryMapKey(content_type, resource_identifier), primary_url,
+                 &rules);
 
   // Iterate the entries in until a match is found. Since the rules are stored
   // in the order of decreasing precedence, the most specific match is found
   // first.
-  Rules::const_iterator entry;
-  for (entry = it->second.begin(); entry != it->second.end(); ++entry) {
+  for (size_t i = 0; i < rules.size(); ++i) {
+    Rules::const_iterator entry = rules[i];
     if (entry->first.primary_pattern.Matches(primary_url) &&
         entry->first.secondary_pattern.Matches(secondary_url)) {
       return entry->second.get();
@@ -154,8 +228,14 @@ void OriginIdentifierValueMap::SetValue(
   DCHECK(value);
   EntryMapKey key(content_type, resource_identifier);
   PatternPair patterns(primary_pattern, secondary_pattern);
-  // This will create the entry and the linked_ptr if needed.
-  entries_[key][patterns].reset(value);
+  Rules& rules = entries_[key];
+  Rules::iterator rule = rules.find(patterns);
+  if (rule == rules.end()) {
+    rule = rules.insert(std::make_pair(patterns, linked_ptr<Value>())).first;
+    host_indexes_[key].insert(
+        std::make_pair(primary_pattern.GetHost(), Rules::const_iterator(rule)));
+  }
+  rule->second.reset(value);
 }
 
 void OriginIdentifierValueMap::DeleteValue(
@@ -164,10 +244,29 @@ void OriginIdentifierValueMap::DeleteValue(
       ContentSettingsType content_type,
       const ResourceIdentifier& resource_identifier) {
   EntryMapKey key(content_type, resource_identifier);
-  PatternPair patterns(primary_pattern, secondary_pattern);
-  entries_[key].erase(patterns);
-  if (entries_[key].empty()) {
-    entries_.erase(key);
+  EntryMap::iterator entry = entries_.find(key);
+  if (entry == entries_.end())
+    return;
+  Rules& rules = entry->second;
+  Rules::iterator rule = rules.find(PatternPair(primary_pattern,
+                                                secondary_pattern));
+  if (rule == rules.end())
+    return;
+
+  HostIndex& index = host_indexes_[key];
+  std::pair<HostIndex::iterator, HostIndex::iterator> range =
+      index.equal_range(rule->first.primary_pattern.GetHost());
+  for (HostIndex::iterator it = range.first; it != range.second; ++it) {
+    if (it->second == rule) {
+      index.erase(it);
+      break;
+    }
+  }
+  rules.erase(rule);
+
+  if (rules.empty()) {
+    entries_.erase(entry);
+    host_indexes_.erase(key);
   }
 }
 
@@ -176,11 +275,36 @@ void OriginIdentifierValueMap::DeleteValues(
       const ResourceIdentifier& resource_identifier) {
   EntryMapKey key(content_type, resource_identifier);
   entries_.erase(key);
+  host_indexes_.erase(key);
 }
 
 void OriginIdentifierValueMap::clear() {
   // Delete all owned value objects.
   entries_.clear();
+  host_indexes_.clear();
+}
+
+void OriginIdentifierValueMap::GetRulesForURL(
+    const EntryMapKey& key,
+    const GURL& primary_url,
+    std::vector<Rules::const_iterator>* rules) const {
+  HostIndexMap::const_iterator index = host_indexes_.find(key);
+  if (index == host_indexes_.end())
+    return;
+
+  // A pattern can only match |primary_url| if its host is the host of the URL
+  // or one of the domains above it, or if it matches any host.
+  const std::string host = ContentSettingsPattern::GetURLHost(primary_url);
+  size_t label = host.empty() ? std::string::npos : 0;
+  while (label != std::string::npos) {
+    AppendRulesForHost(index->second, host.substr(label), rules);
+    label = host.find('.', label);
+    if (label != std::string::npos)
+      ++label;
+  }
+  AppendRulesForHost(index->second, std::string(), rules);
+
+  std::sort(rules->begin(), rules->end(), RulePrecedes);
 }
 
 }  // namespace content_settings
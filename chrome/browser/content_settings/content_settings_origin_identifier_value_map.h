@@ -7,6 +7,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/memory/linked_ptr.h"
 #include "chrome/common/content_settings_pattern.h"
@@ -77,6 +78,16 @@ class OriginIdentifierValueMap {
                                 const ResourceIdentifier& resource_identifier,
                                 base::Lock* lock) const;
 
+  // Like |GetRuleIterator|, but the iterator skips the rules whose primary
+  // pattern cannot match |primary_url|. Only the rules filed under the domains
+  // of |primary_url| are visited, so the cost doesn't grow with the number of
+  // rules for other hosts.
+  RuleIterator* GetRuleIteratorForURL(
+      const GURL& primary_url,
+      ContentSettingsType content_type,
+      const ResourceIdentifier& resource_identifier,
+      base::Lock* lock) const;
+
   OriginIdentifierValueMap();
   ~OriginIdentifierValueMap();
 
@@ -117,8 +128,23 @@ class OriginIdentifierValueMap {
   void clear();
 
  private:
+  // The rules of one |EntryMap| entry, keyed by the host of their primary
+  // pattern. Rules whose primary pattern matches any host are filed under the
+  // empty string.
+  typedef std::multimap<std::string, Rules::const_iterator> HostIndex;
+  typedef std::map<EntryMapKey, HostIndex> HostIndexMap;
+
+  // Sets |rules| to the rules for |key| whose primary pattern may match
+  // |primary_url|, in the precedence order of |Rules|.
+  void GetRulesForURL(const EntryMapKey& key,
+                      const GURL& primary_url,
+                      std::vector<Rules::const_iterator>* rules) const;
+
   EntryMap entries_;
 
+  // Indexes |entries_| by host.
+  HostIndexMap host_indexes_;
+
   DISALLOW_COPY_AND_ASSIGN(OriginIdentifierValueMap);
 };
 
@@ -212,3 +212,76 @@ TEST(OriginIdentifierValueMapTest, IterateNonempty) {
   EXPECT_EQ(pattern, rule.primary_pattern);
   EXPECT_EQ(1, content_settings::ValueToContentSetting(rule.value.get()));
 }
+
+TEST(OriginIdentifierValueMapTest, IterateForURL) {
+  content_settings::OriginIdentifierValueMap map;
+  ContentSettingsPattern pattern =
+      ContentSettingsPattern::FromString("[*.]google.com");
+  ContentSettingsPattern sub_pattern =
+      ContentSettingsPattern::FromString("sub.google.com");
+  map.SetValue(
+      pattern,
+      ContentSettingsPattern::Wildcard(),
+      CONTENT_SETTINGS_TYPE_COOKIES,
+      "",
+      Value::CreateIntegerValue(1));
+  map.SetValue(
+      sub_pattern,
+      ContentSettingsPattern::Wildcard(),
+      CONTENT_SETTINGS_TYPE_COOKIES,
+      "",
+      Value::CreateIntegerValue(2));
+  map.SetValue(
+      ContentSettingsPattern::FromString("[*.]youtube.com"),
+      ContentSettingsPattern::Wildcard(),
+      CONTENT_SETTINGS_TYPE_COOKIES,
+      "",
+      Value::CreateIntegerValue(2));
+  map.SetValue(
+      ContentSettingsPattern::Wildcard(),
+      ContentSettingsPattern::Wildcard(),
+      CONTENT_SETTINGS_TYPE_COOKIES,
+      "",
+      Value::CreateIntegerValue(3));
+
+  // Only the rules for the domains of the URL and the wildcard rule are
+  // returned, in precedence order.
+  scoped_ptr<content_settings::RuleIterator> rule_iterator(
+      map.GetRuleIteratorForURL(GURL("http://sub.google.com"),
+                                CONTENT_SETTINGS_TYPE_COOKIES, "", NULL));
+  ASSERT_TRUE(rule_iterator->HasNext());
+  EXPECT_EQ(sub_pattern, rule_iterator->Next().primary_pattern);
+  ASSERT_TRUE(rule_iterator->HasNext());
+  EXPECT_EQ(pattern, rule_iterator->Next().primary_pattern);
+  ASSERT_TRUE(rule_iterator->HasNext());
+  EXPECT_EQ(ContentSettingsPattern::Wildcard(),
+            rule_iterator->Next().primary_pattern);
+  EXPECT_FALSE(rule_iterator->HasNext());
+
+  // Deleted rules are no longer returned.
+  map.DeleteValue(sub_pattern,
+                  ContentSettingsPattern::Wildcard(),
+                  CONTENT_SETTINGS_TYPE_COOKIES,
+                  "");
+  rule_iterator.reset(
+      map.GetRuleIteratorForURL(GURL("http://sub.google.com"),
+                                CONTENT_SETTINGS_TYPE_COOKIES, "", NULL));
+  ASSERT_TRUE(rule_iterator->HasNext());
+  EXPECT_EQ(pattern, rule_iterator->Next().primary_pattern);
+  ASSERT_TRUE(rule_iterator->HasNext());
+  EXPECT_EQ(ContentSettingsPattern::Wildcard(),
+            rule_iterator->Next().primary_pattern);
+  EXPECT_FALSE(rule_iterator->HasNext());
+
+  int actual_value;
+  EXPECT_TRUE(map.GetValue(GURL("http://www.google.com"),
+                           GURL("http://www.example.com"),
+                           CONTENT_SETTINGS_TYPE_COOKIES,
+                           "")->GetAsInteger(&actual_value));
+  EXPECT_EQ(1, actual_value);
+  EXPECT_TRUE(map.GetValue(GURL("http://www.example.com"),
+                           GURL("http://www.example.com"),
+                           CONTENT_SETTINGS_TYPE_COOKIES,
+                           "")->GetAsInteger(&actual_value));
+  EXPECT_EQ(3, actual_value);
+}
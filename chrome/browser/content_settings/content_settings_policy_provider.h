@@ -35,6 +35,12 @@ class PolicyProvider : public ObservableProvider,
       const ResourceIdentifier& resource_identifier,
       bool incognito) const OVERRIDE;
 
+  virtual RuleIterator* GetRuleIteratorForURL(
+      const GURL& primary_url,
+      ContentSettingsType content_type,
+      const ResourceIdentifier& resource_identifier,
+      bool incognito) const OVERRIDE;
+
   virtual bool SetWebsiteSetting(
       const ContentSettingsPattern& primary_pattern,
       const ContentSettingsPattern& secondary_pattern,
@@ -17,6 +17,7 @@
 #include "chrome/common/content_settings_types.h"
 
 class ContentSettingsPattern;
+class GURL;
 
 namespace content_settings {
 
@@ -42,6 +43,17 @@ class ProviderInterface {
       const ResourceIdentifier& resource_identifier,
       bool incognito) const = 0;
 
+  // Like |GetRuleIterator|, but the iterator may skip rules whose primary
+  // pattern cannot match |primary_url|. Providers holding many rules override
+  // this so that looking up the setting for a URL doesn't visit all of them.
+  virtual RuleIterator* GetRuleIteratorForURL(
+      const GURL& primary_url,
+      ContentSettingsType content_type,
+      const ResourceIdentifier& resource_identifier,
+      bool incognito) const {
+    return GetRuleIterator(content_type, resource_identifier, incognito);
+  }
+
   // Asks the provider to set the website setting for a particular
   // |primary_pattern|, |secondary_pattern|, |content_type| tuple. If the
   // provider accepts the setting it returns true and takes the ownership of the
@@ -121,7 +121,8 @@ base::Value* GetContentSettingValueAndPatterns(
     // |RuleIterator| gets out of scope before we get a rule iterator for the
     // normal mode.
     scoped_ptr<RuleIterator> incognito_rule_iterator(
-        provider->GetRuleIterator(content_type, resource_identifier, true));
+        provider->GetRuleIteratorForURL(primary_url, content_type,
+                                        resource_identifier, true));
     base::Value* value = GetContentSettingValueAndPatterns(
         incognito_rule_iterator.get(), primary_url, secondary_url,
         primary_pattern, secondary_pattern);
@@ -130,7 +131,8 @@ base::Value* GetContentSettingValueAndPatterns(
   }
   // No settings from the incognito; use the normal mode.
   scoped_ptr<RuleIterator> rule_iterator(
-      provider->GetRuleIterator(content_type, resource_identifier, false));
+      provider->GetRuleIteratorForURL(primary_url, content_type,
+                                      resource_identifier, false));
   return GetContentSettingValueAndPatterns(
       rule_iterator.get(), primary_url, secondary_url,
       primary_pattern, secondary_pattern);
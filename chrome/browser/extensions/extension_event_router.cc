@@ -316,7 +316,7 @@ void ExtensionEventRouter::DispatchEventToListener(
       listener_profile->GetExtensionService()->process_map();
   // If the event is privileged, only send to extension processes. Otherwise,
   // it's OK to send to normal renderers (e.g., for content scripts).
-  if (ExtensionAPI::GetSharedInstance()->IsPrivileged(event->event_name) &&
+  if (IsEventPrivileged(event->event_name) &&
       !process_map->Contains(extension->id(), listener.process->GetID())) {
     return;
   }
@@ -404,6 +404,18 @@ void ExtensionEventRouter::MaybeLoadLazyBackgroundPage(
   }
 }
 
+bool ExtensionEventRouter::IsEventPrivileged(const std::string& event_name) {
+  std::map<std::string, bool>::iterator it =
+      privileged_events_.find(event_name);
+  if (it != privileged_events_.end())
+    return it->second;
+
+  bool privileged =
+      ExtensionAPI::GetSharedInstance()->IsPrivileged(event_name);
+  privileged_events_[event_name] = privileged;
+  return privileged;
+}
+
 void ExtensionEventRouter::IncrementInFlightEvents(
     Profile* profile, const Extension* extension) {
   // Only increment in-flight events if the lazy background page is active,
@@ -182,6 +182,11 @@ class ExtensionEventRouter : public content::NotificationObserver {
       const Extension* extension,
       const linked_ptr<ExtensionEvent>& event);
 
+  // Returns true if |event_name| may only be dispatched to extension
+  // processes. The answer is cached, since it is needed for every listener
+  // of every event and looking it up resolves the API's dependencies.
+  bool IsEventPrivileged(const std::string& event_name);
+
   // Track of the number of dispatched events that have not yet sent an
   // ACK from the renderer.
   void IncrementInFlightEvents(Profile* profile, const Extension* extension);
@@ -203,6 +208,9 @@ class ExtensionEventRouter : public content::NotificationObserver {
   // stored on disk in the extension prefs.
   ListenerMap lazy_listeners_;
 
+  // Caches IsEventPrivileged(), keyed by event name.
+  std::map<std::string, bool> privileged_events_;
+
   DISALLOW_COPY_AND_ASSIGN(ExtensionEventRouter);
 };
 
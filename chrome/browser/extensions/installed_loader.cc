@@ -115,7 +115,9 @@ void InstalledLoader::LoadAllExtensions() {
       extension_prefs_->GetInstalledExtensionsInfo());
 
   std::vector<int> reload_reason_counts(NUM_MANIFEST_RELOAD_REASONS, 0);
-  bool should_write_prefs = false;
+  // Only the manifests that were reloaded from disk can differ from the copy
+  // in prefs, so only those need to be compared and written back.
+  std::vector<bool> manifest_reloaded(extensions_info->size(), false);
 
   for (size_t i = 0; i < extensions_info->size(); ++i) {
     ExtensionInfo* info = extensions_info->at(i).get();
@@ -151,12 +153,12 @@ void InstalledLoader::LoadAllExtensions() {
       extensions_info->at(i)->extension_manifest.reset(
           static_cast<DictionaryValue*>(
               extension->manifest()->value()->DeepCopy()));
-      should_write_prefs = true;
+      manifest_reloaded[i] = true;
     }
   }
 
   for (size_t i = 0; i < extensions_info->size(); ++i) {
-    Load(*extensions_info->at(i), should_write_prefs);
+    Load(*extensions_info->at(i), manifest_reloaded[i]);
   }
 
   extension_service_->OnLoadedInstalledExtensions();
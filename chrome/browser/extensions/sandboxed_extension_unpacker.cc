@@ -160,6 +160,14 @@ bool FindWritableTempLocation(FilePath* temp_dir) {
   return false;
 }
 
+// The crx is read in chunks of this size while its signature is checked.
+const size_t kReadBufferSize = 64 * 1024;
+
+// Writes |size| bytes from |data| to |file|. Returns false on error.
+bool WriteToFile(FILE* file, const void* data, size_t size) {
+  return fwrite(data, 1, size, file) == size;
+}
+
 }  // namespace
 
 SandboxedExtensionUnpacker::SandboxedExtensionUnpacker(
@@ -220,24 +228,14 @@ void SandboxedExtensionUnpacker::Start() {
   PATH_LENGTH_HISTOGRAM("Extensions.SandboxUnpackUnpackedCrxPathLength",
                         extension_root_);
 
-  // Extract the public key and validate the package.
-  if (!ValidateSignature())
-    return;  // ValidateSignature() already reported the error.
-
-  // Copy the crx file into our working directory.
   FilePath temp_crx_path = temp_dir_.path().Append(crx_path_.BaseName());
   PATH_LENGTH_HISTOGRAM("Extensions.SandboxUnpackTempCrxPathLength",
                         temp_crx_path);
 
-  if (!file_util::CopyFile(crx_path_, temp_crx_path)) {
-    // Failed to copy extension file to temporary directory.
-    ReportFailure(
-        FAILED_TO_COPY_EXTENSION_FILE_TO_TEMP_DIRECTORY,
-        l10n_util::GetStringFUTF16(
-            IDS_EXTENSION_PACKAGE_INSTALL_ERROR,
-            ASCIIToUTF16("FAILED_TO_COPY_EXTENSION_FILE_TO_TEMP_DIRECTORY")));
-    return;
-  }
+  // Extract the public key and validate the package, copying it into our
+  // working directory as it is read.
+  if (!ValidateSignature(temp_crx_path))
+    return;  // ValidateSignature() already reported the error.
 
   // If we are supposed to use a subprocess, kick off the subprocess.
   //
@@ -393,7 +391,8 @@ void SandboxedExtensionUnpacker::OnUnpackExtensionFailed(
            error));
 }
 
-bool SandboxedExtensionUnpacker::ValidateSignature() {
+bool SandboxedExtensionUnpacker::ValidateSignature(
+    const FilePath& copy_path) {
   ScopedStdioHandle file(file_util::OpenFile(crx_path_, "rb"));
 
   if (!file.get()) {
@@ -533,9 +532,20 @@ bool SandboxedExtensionUnpacker::ValidateSignature() {
     return false;
   }
 
-  unsigned char buf[1 << 12];
-  while ((len = fread(buf, 1, sizeof(buf), file.get())) > 0)
-    verifier.VerifyUpdate(buf, len);
+  // The copy gets exactly the bytes that were verified, and the crx is only
+  // read once.
+  ScopedStdioHandle copy(file_util::OpenFile(copy_path, "wb"));
+  bool copied = copy.get() &&
+      WriteToFile(copy.get(), &header, sizeof(header)) &&
+      WriteToFile(copy.get(), &key.front(), key.size()) &&
+      WriteToFile(copy.get(), &signature.front(), signature.size());
+
+  std::vector<uint8> buf(kReadBufferSize);
+  while ((len = fread(&buf.front(), 1, buf.size(), file.get())) > 0) {
+    verifier.VerifyUpdate(&buf.front(), len);
+    copied = copied && WriteToFile(copy.get(), &buf.front(), len);
+  }
+  copied = copied && fflush(copy.get()) == 0;
 
   if (!verifier.VerifyFinal()) {
     // Signature verification failed
@@ -547,6 +557,16 @@ bool SandboxedExtensionUnpacker::ValidateSignature() {
     return false;
   }
 
+  if (!copied) {
+    // Failed to copy extension file to temporary directory.
+    ReportFailure(
+        FAILED_TO_COPY_EXTENSION_FILE_TO_TEMP_DIRECTORY,
+        l10n_util::GetStringFUTF16(
+            IDS_EXTENSION_PACKAGE_INSTALL_ERROR,
+            ASCIIToUTF16("FAILED_TO_COPY_EXTENSION_FILE_TO_TEMP_DIRECTORY")));
+    return false;
+  }
+
   std::string public_key =
       std::string(reinterpret_cast<char*>(&key.front()), key.size());
   base::Base64Encode(public_key, &public_key_);
@@ -180,7 +180,8 @@ class SandboxedExtensionUnpacker : public content::UtilityProcessHostClient {
   virtual bool CreateTempDirectory();
 
   // Validates the signature of the extension and extract the key to
-  // |public_key_|. Returns true if the signature validates, false otherwise.
+  // |public_key_|, copying the crx to |copy_path| as it is read. Returns true
+  // if the signature validates and the copy was written, false otherwise.
   //
   // NOTE: Having this method here is a bit ugly. This code should really live
   // in ExtensionUnpacker as it is not specific to sandboxed unpacking. It was
@@ -188,7 +189,7 @@ class SandboxedExtensionUnpacker : public content::UtilityProcessHostClient {
   // could still have this method statically on ExtensionUnpacker so that code
   // just for unpacking is there and code just for sandboxing of unpacking is
   // here.
-  bool ValidateSignature();
+  bool ValidateSignature(const FilePath& copy_path);
 
   // Starts the utility process that unpacks our extension.
   void StartProcessOnIOThread(const FilePath& temp_crx_path);
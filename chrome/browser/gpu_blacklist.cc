@@ -4,16 +4,21 @@
 
 #include "chrome/browser/gpu_blacklist.h"
 
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/string_number_conversions.h"
 #include "base/string_split.h"
 #include "base/string_util.h"
+#include "base/stringprintf.h"
 #include "base/sys_info.h"
 #include "base/version.h"
 #include "chrome/browser/gpu_util.h"
+#include "chrome/browser/prefs/pref_service.h"
 #include "chrome/common/chrome_version_info.h"
+#include "chrome/common/pref_names.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/gpu_data_manager.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/common/gpu_info.h"
@@ -744,7 +749,9 @@ GpuBlacklist* GpuBlacklist::GetInstance() {
 
 GpuBlacklist::GpuBlacklist()
     : max_entry_id_(0),
-      contains_unknown_fields_(false) {
+      contains_unknown_fields_(false),
+      load_pending_(false),
+      cache_local_state_(NULL) {
   GpuDataManager::GetInstance()->AddObserver(this);
 }
 
@@ -753,6 +760,12 @@ GpuBlacklist::~GpuBlacklist() {
   GpuDataManager::GetInstance()->RemoveObserver(this);
 }
 
+// static
+void GpuBlacklist::RegisterPrefs(PrefService* local_state) {
+  local_state->RegisterStringPref(prefs::kGpuBlacklistCacheKey, std::string());
+  local_state->RegisterIntegerPref(prefs::kGpuBlacklistCachedFeatureType, 0);
+}
+
 bool GpuBlacklist::LoadGpuBlacklist(
     const std::string& json_context, GpuBlacklist::OsFilter os_filter) {
   chrome::VersionInfo chrome_version_info;
@@ -838,6 +851,33 @@ bool GpuBlacklist::LoadGpuBlacklist(
   return true;
 }
 
+void GpuBlacklist::LoadGpuBlacklistForStartup(const std::string& json_context,
+                                              PrefService* local_state) {
+  DCHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::UI));
+  cache_local_state_ = local_state;
+  std::string cache_key =
+      GetFeatureTypeCacheKey(GpuDataManager::GetInstance()->GetGPUInfo());
+  if (local_state &&
+      local_state->GetString(prefs::kGpuBlacklistCacheKey) == cache_key) {
+    GpuDataManager::GetInstance()->SetGpuFeatureType(
+        static_cast<GpuFeatureType>(
+            local_state->GetInteger(prefs::kGpuBlacklistCachedFeatureType)));
+    load_pending_ = true;
+    scoped_ptr<Value>* parsed_json = new scoped_ptr<Value>();
+    content::BrowserThread::PostBlockingPoolTaskAndReply(
+        FROM_HERE,
+        base::Bind(&GpuBlacklist::ParseGpuBlacklistJson,
+                   json_context, parsed_json),
+        base::Bind(&GpuBlacklist::OnGpuBlacklistParsed,
+                   base::Unretained(this), base::Owned(parsed_json)));
+    return;
+  }
+
+  bool succeed = LoadGpuBlacklist(json_context, kCurrentOsOnly);
+  DCHECK(succeed);
+  UpdateGpuDataManagerAndCache();
+}
+
 GpuFeatureType GpuBlacklist::DetermineGpuFeatureType(
     GpuBlacklist::OsType os,
     Version* os_version,
@@ -875,6 +915,21 @@ void GpuBlacklist::UpdateGpuDataManager() {
   gpu_util::UpdateStats();
 }
 
+void GpuBlacklist::UpdateGpuDataManagerAndCache() {
+  content::GPUInfo gpu_info = GpuDataManager::GetInstance()->GetGPUInfo();
+  content::GpuFeatureType feature_type =
+      DetermineGpuFeatureType(GpuBlacklist::kOsAny, NULL, gpu_info);
+  GpuDataManager::GetInstance()->SetGpuFeatureType(feature_type);
+  gpu_util::UpdateStats();
+
+  if (cache_local_state_) {
+    cache_local_state_->SetString(prefs::kGpuBlacklistCacheKey,
+                                  GetFeatureTypeCacheKey(gpu_info));
+    cache_local_state_->SetInteger(prefs::kGpuBlacklistCachedFeatureType,
+                                   feature_type);
+  }
+}
+
 void GpuBlacklist::GetGpuFeatureTypeEntries(
     content::GpuFeatureType feature,
     std::vector<uint32>& entry_ids,
@@ -980,7 +1035,55 @@ GpuBlacklist::IsEntrySupportedByCurrentBrowserVersion(
   return kSupported;
 }
 
+// static
+std::string GpuBlacklist::GetFeatureTypeCacheKey(
+    const content::GPUInfo& gpu_info) {
+  chrome::VersionInfo chrome_version_info;
+  return base::StringPrintf(
+      "%s|%s|%04x|%04x|%s|%s|%s|%s|%s|%.1f|%.1f|%.1f",
+      chrome_version_info.is_valid() ?
+          chrome_version_info.Version().c_str() : "0",
+      base::SysInfo::OperatingSystemVersion().c_str(),
+      gpu_info.vendor_id,
+      gpu_info.device_id,
+      gpu_info.driver_vendor.c_str(),
+      gpu_info.driver_version.c_str(),
+      gpu_info.driver_date.c_str(),
+      gpu_info.gl_vendor.c_str(),
+      gpu_info.gl_renderer.c_str(),
+      gpu_info.performance_stats.graphics,
+      gpu_info.performance_stats.gaming,
+      gpu_info.performance_stats.overall);
+}
+
+// static
+void GpuBlacklist::ParseGpuBlacklistJson(const std::string& json_context,
+                                         scoped_ptr<Value>* parsed_json) {
+  parsed_json->reset(base::JSONReader::Read(json_context));
+}
+
+void GpuBlacklist::OnGpuBlacklistParsed(scoped_ptr<Value>* parsed_json) {
+  DCHECK(load_pending_);
+  load_pending_ = false;
+
+  chrome::VersionInfo chrome_version_info;
+  browser_version_.reset(Version::GetVersionFromString(
+      chrome_version_info.is_valid() ? chrome_version_info.Version() : "0"));
+  DCHECK(browser_version_.get() != NULL);
+
+  bool succeed = parsed_json->get() != NULL &&
+      (*parsed_json)->IsType(Value::TYPE_DICTIONARY) &&
+      LoadGpuBlacklist(*static_cast<DictionaryValue*>(parsed_json->get()),
+                       kCurrentOsOnly);
+  DCHECK(succeed);
+  UpdateGpuDataManagerAndCache();
+}
+
 void GpuBlacklist::OnGpuInfoUpdate() {
+  // The cached flags stay in effect until the blacklist is loaded, which
+  // evaluates the latest gpu info anyway.
+  if (load_pending_)
+    return;
   UpdateGpuDataManager();
 }
 
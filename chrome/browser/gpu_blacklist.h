@@ -18,6 +18,7 @@
 #include "content/public/browser/gpu_data_manager_observer.h"
 #include "content/public/common/gpu_feature_type.h"
 
+class PrefService;
 class Version;
 
 namespace content {
@@ -47,11 +48,23 @@ class GpuBlacklist : public content::GpuDataManagerObserver {
 
   virtual ~GpuBlacklist();
 
+  // Registers the local state prefs that cache the preliminary gpu feature
+  // flags across runs.
+  static void RegisterPrefs(PrefService* local_state);
+
   // Loads blacklist information from a json file.
   // If failed, the current GpuBlacklist is un-touched.
   bool LoadGpuBlacklist(const std::string& json_context,
                         OsFilter os_filter);
 
+  // Sets the preliminary gpu feature flags on GpuDataManager during startup.
+  // If |local_state| holds the flags computed by an earlier run with the same
+  // browser version, OS version and gpu info, they are used right away and
+  // |json_context| is parsed on the blocking pool and evaluated once that is
+  // done. Otherwise the blacklist is loaded and evaluated synchronously.
+  void LoadGpuBlacklistForStartup(const std::string& json_context,
+                                  PrefService* local_state);
+
   // Collects system information and combines them with gpu_info and blacklist
   // information to determine gpu feature flags.
   // If os is kOsAny, use the current OS; if os_version is null, use the
@@ -99,6 +112,7 @@ class GpuBlacklist : public content::GpuDataManagerObserver {
   friend struct DefaultSingletonTraits<GpuBlacklist>;
   FRIEND_TEST_ALL_PREFIXES(GpuBlacklistTest, ChromeVersionEntry);
   FRIEND_TEST_ALL_PREFIXES(GpuBlacklistTest, CurrentBlacklistValidation);
+  FRIEND_TEST_ALL_PREFIXES(GpuBlacklistTest, FeatureTypeCacheKey);
   FRIEND_TEST_ALL_PREFIXES(GpuBlacklistTest, UnknownField);
   FRIEND_TEST_ALL_PREFIXES(GpuBlacklistTest, UnknownExceptionField);
   FRIEND_TEST_ALL_PREFIXES(GpuBlacklistTest, UnknownFeature);
@@ -339,6 +353,22 @@ class GpuBlacklist : public content::GpuDataManagerObserver {
 
   void Clear();
 
+  // Returns the key under which the feature flags computed for |gpu_info| are
+  // cached. The blacklist ships with the browser, so the flags are the same
+  // for the same key.
+  static std::string GetFeatureTypeCacheKey(const content::GPUInfo& gpu_info);
+
+  // Parses |json_context| into |parsed_json| on the blocking pool.
+  static void ParseGpuBlacklistJson(const std::string& json_context,
+                                    scoped_ptr<base::Value>* parsed_json);
+
+  // Loads the blacklist parsed by ParseGpuBlacklistJson() and re-evaluates it.
+  void OnGpuBlacklistParsed(scoped_ptr<base::Value>* parsed_json);
+
+  // Like UpdateGpuDataManager(), but also caches the flags in
+  // |cache_local_state_|.
+  void UpdateGpuDataManagerAndCache();
+
   // Check if the entry is supported by the current version of browser.
   // By default, if there is no browser version information in the entry,
   // return kSupported;
@@ -370,6 +400,14 @@ class GpuBlacklist : public content::GpuDataManagerObserver {
 
   bool contains_unknown_fields_;
 
+  // Set while the blacklist is being parsed off the UI thread, with the cached
+  // flags in effect. Gpu info updates are not evaluated against the still
+  // empty blacklist meanwhile.
+  bool load_pending_;
+
+  // Where to cache the flags once the blacklist is evaluated. Not owned.
+  PrefService* cache_local_state_;
+
   DISALLOW_COPY_AND_ASSIGN(GpuBlacklist);
 };
 
@@ -755,3 +755,17 @@ TEST_F(GpuBlacklistTest, DisabledEntry) {
       content::GPU_FEATURE_TYPE_ALL, flag_entries, disabled);
   EXPECT_EQ(flag_entries.size(), 1u);
 }
+
+TEST_F(GpuBlacklistTest, FeatureTypeCacheKey) {
+  content::GPUInfo gpu_info_copy = gpu_info();
+  std::string key = GpuBlacklist::GetFeatureTypeCacheKey(gpu_info());
+  EXPECT_EQ(key, GpuBlacklist::GetFeatureTypeCacheKey(gpu_info_copy));
+
+  // A driver update invalidates the cached flags.
+  gpu_info_copy.driver_version = "1.6.19";
+  EXPECT_NE(key, GpuBlacklist::GetFeatureTypeCacheKey(gpu_info_copy));
+
+  gpu_info_copy = gpu_info();
+  gpu_info_copy.device_id = 0x0641;
+  EXPECT_NE(key, GpuBlacklist::GetFeatureTypeCacheKey(gpu_info_copy));
+}
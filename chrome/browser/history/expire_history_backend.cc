@@ -469,7 +469,8 @@ void ExpireHistoryBackend::ExpireURLsForVisits(
   std::map<URLID, ChangedURL> changed_urls;
   for (size_t i = 0; i < visits.size(); i++) {
     ChangedURL& cur = changed_urls[visits[i].url_id];
-    // NOTE: This code must stay in sync with HistoryBackend::AddPageVisit().
+    // NOTE: This code must stay in sync with
+    // HistoryBackend::UpdateURLRowForVisit().
     // TODO(pkasting): http://b/1148304 We shouldn't be marking so many URLs as
     // typed, which would help eliminate the need for this code (we still would
     // need to handle RELOAD transitions specially, though).
@@ -26,6 +26,7 @@
 
 #include "base/callback.h"
 #include "base/command_line.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/memory/ref_counted.h"
 #include "base/message_loop.h"
 #include "base/path_service.h"
@@ -721,6 +722,8 @@ bool HistoryService::Init(const FilePath& history_dir,
     Cleanup();
     return false;
   }
+  ScheduleTask(PRIORITY_UI, base::Bind(&base::debug::SetCurrentThreadHeapTag,
+                                       base::debug::HEAP_TAG_HISTORY));
 
   history_dir_ = history_dir;
   bookmark_service_ = bookmark_service;
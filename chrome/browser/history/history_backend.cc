@@ -712,6 +712,41 @@ std::pair<URLID, VisitID> HistoryBackend::AddPageVisit(
     VisitID referring_visit,
     content::PageTransition transition,
     VisitSource visit_source) {
+  // See if this URL is already in the DB.
+  URLRow url_info(url);
+  URLID url_id = db_->GetRowForURL(url, &url_info);
+  UpdateURLRowForVisit(time, transition, !url_id, &url_info);
+  if (url_id) {
+    // Update of an existing row.
+    db_->UpdateURLRow(url_id, url_info);
+  } else {
+    // Addition of a new row.
+    url_id = db_->AddURL(url_info);
+    if (!url_id) {
+      NOTREACHED() << "Adding URL failed.";
+      return std::make_pair(0, 0);
+    }
+    url_info.id_ = url_id;
+
+    // We don't actually add the URL to the full text index at this point. It
+    // might be nice to do this so that even if we get no title or body, the
+    // user can search for URL components and get the page.
+    //
+    // However, in most cases, we'll get at least a title and usually contents,
+    // and this add will be redundant, slowing everything down. As a result,
+    // we ignore this edge case.
+  }
+
+  VisitID visit_id = AddVisitForURLRow(url_info, time, referring_visit,
+                                       transition, visit_source);
+  return std::make_pair(url_id, visit_id);
+}
+
+// static
+void HistoryBackend::UpdateURLRowForVisit(Time time,
+                                          content::PageTransition transition,
+                                          bool is_new_url,
+                                          URLRow* url_info) {
   // Top-level frame navigations are visible, everything else is hidden
   bool new_hidden = !content::PageTransitionIsMainFrame(transition);
 
@@ -727,45 +762,33 @@ std::pair<URLID, VisitID> HistoryBackend::AddPageVisit(
       transition_type == content::PAGE_TRANSITION_KEYWORD_GENERATED)
     typed_increment = 1;
 
-  // See if this URL is already in the DB.
-  URLRow url_info(url);
-  URLID url_id = db_->GetRowForURL(url, &url_info);
-  if (url_id) {
+  if (!is_new_url) {
     // Update of an existing row.
     if (content::PageTransitionStripQualifier(transition) !=
         content::PAGE_TRANSITION_RELOAD)
-      url_info.set_visit_count(url_info.visit_count() + 1);
+      url_info->set_visit_count(url_info->visit_count() + 1);
     if (typed_increment)
-      url_info.set_typed_count(url_info.typed_count() + typed_increment);
-    url_info.set_last_visit(time);
+      url_info->set_typed_count(url_info->typed_count() + typed_increment);
+    url_info->set_last_visit(time);
 
     // Only allow un-hiding of pages, never hiding.
     if (!new_hidden)
-      url_info.set_hidden(false);
-
-    db_->UpdateURLRow(url_id, url_info);
+      url_info->set_hidden(false);
   } else {
     // Addition of a new row.
-    url_info.set_visit_count(1);
-    url_info.set_typed_count(typed_increment);
-    url_info.set_last_visit(time);
-    url_info.set_hidden(new_hidden);
-
-    url_id = db_->AddURL(url_info);
-    if (!url_id) {
-      NOTREACHED() << "Adding URL failed.";
-      return std::make_pair(0, 0);
-    }
-    url_info.id_ = url_id;
-
-    // We don't actually add the URL to the full text index at this point. It
-    // might be nice to do this so that even if we get no title or body, the
-    // user can search for URL components and get the page.
-    //
-    // However, in most cases, we'll get at least a title and usually contents,
-    // and this add will be redundant, slowing everything down. As a result,
-    // we ignore this edge case.
+    url_info->set_visit_count(1);
+    url_info->set_typed_count(typed_increment);
+    url_info->set_last_visit(time);
+    url_info->set_hidden(new_hidden);
   }
+}
+
+VisitID HistoryBackend::AddVisitForURLRow(const URLRow& url_info,
+                                          Time time,
+                                          VisitID referring_visit,
+                                          content::PageTransition transition,
+                                          VisitSource visit_source) {
+  const URLID url_id = url_info.id();
 
   // Add the visit with the time to the database.
   VisitRow visit_info(url_id, time, referring_visit, transition, 0);
@@ -789,7 +812,7 @@ std::pair<URLID, VisitID> HistoryBackend::AddPageVisit(
             << "url_id = " << url_id;
   }
 
-  return std::make_pair(url_id, visit_id);
+  return visit_id;
 }
 
 void HistoryBackend::AddPagesWithDetails(const URLRows& urls,
@@ -995,18 +1018,39 @@ bool HistoryBackend::UpdateURL(URLID id, const history::URLRow& url) {
 bool HistoryBackend::AddVisits(const GURL& url,
                                const std::vector<VisitInfo>& visits,
                                VisitSource visit_source) {
-  if (db_.get()) {
-    for (std::vector<VisitInfo>::const_iterator visit = visits.begin();
-         visit != visits.end(); ++visit) {
-      if (!AddPageVisit(
-              url, visit->first, 0, visit->second, visit_source).first) {
+  if (!db_.get())
+    return false;
+
+  // Sync can hand over dozens of visits per URL. Look the URL row up once
+  // and keep its counts up to date in memory, rather than reading and
+  // rewriting it for every visit as AddPageVisit() would.
+  URLRow url_info(url);
+  URLID url_id = db_->GetRowForURL(url, &url_info);
+  bool row_changed = false;
+  for (std::vector<VisitInfo>::const_iterator visit = visits.begin();
+       visit != visits.end(); ++visit) {
+    UpdateURLRowForVisit(visit->first, visit->second, !url_id, &url_info);
+    if (url_id) {
+      row_changed = true;
+    } else {
+      url_id = db_->AddURL(url_info);
+      if (!url_id) {
+        NOTREACHED() << "Adding URL failed.";
         return false;
       }
+      url_info.id_ = url_id;
     }
-    ScheduleCommit();
-    return true;
+
+    // The visit notifications carry |url_info| as of each visit, as if the
+    // row had been written each time.
+    AddVisitForURLRow(url_info, visit->first, 0, visit->second, visit_source);
   }
-  return false;
+
+  if (row_changed && !db_->UpdateURLRow(url_id, url_info))
+    return false;
+
+  ScheduleCommit();
+  return true;
 }
 
 bool HistoryBackend::RemoveVisits(const VisitVector& visits) {
@@ -441,6 +441,23 @@ class HistoryBackend : public base::RefCountedThreadSafe<HistoryBackend>,
                                          content::PageTransition transition,
                                          VisitSource visit_source);
 
+  // Applies a visit at |time| with |transition| to the visit and typed counts,
+  // last visit time and hidden state of |url_info|. |is_new_url| is true if
+  // |url_info| is not in the database yet.
+  static void UpdateURLRowForVisit(base::Time time,
+                                   content::PageTransition transition,
+                                   bool is_new_url,
+                                   URLRow* url_info);
+
+  // Adds a visit to |url_info|, which must already be in the database, and
+  // sends out the notifications for it. Returns the ID of the new visit, or 0
+  // on failure. Like AddPageVisit(), this does not schedule a commit.
+  VisitID AddVisitForURLRow(const URLRow& url_info,
+                            base::Time time,
+                            VisitID referring_visit,
+                            content::PageTransition transition,
+                            VisitSource visit_source);
+
   // Returns a redirect chain in |redirects| for the VisitID
   // |cur_visit|. |cur_visit| is assumed to be valid. Assumes that
   // this HistoryBackend object has been Init()ed successfully.
@@ -879,6 +879,46 @@ TEST_F(HistoryBackendTest, AddVisitsSource) {
     EXPECT_EQ(history::SOURCE_SYNCED, visit_sources[visits[i].visit_id]);
 }
 
+// AddVisits() counts the visits into the URL row just as adding them one at a
+// time would.
+TEST_F(HistoryBackendTest, AddVisitsUpdatesURLRow) {
+  ASSERT_TRUE(backend_.get());
+
+  GURL url("http://www.google.com/");
+  Time last_visit = Time::Now();
+  std::vector<VisitInfo> visits;
+  visits.push_back(VisitInfo(last_visit - base::TimeDelta::FromDays(3),
+                             content::PAGE_TRANSITION_AUTO_SUBFRAME));
+  visits.push_back(VisitInfo(last_visit - base::TimeDelta::FromDays(2),
+                             content::PAGE_TRANSITION_TYPED));
+  visits.push_back(VisitInfo(last_visit - base::TimeDelta::FromDays(1),
+                             content::PAGE_TRANSITION_RELOAD));
+
+  backend_->DeleteAllHistory();
+  ASSERT_TRUE(backend_->AddVisits(url, visits, history::SOURCE_SYNCED));
+
+  URLRow row;
+  URLID id = backend_->db()->GetRowForURL(url, &row);
+  ASSERT_TRUE(id);
+  EXPECT_EQ(2, row.visit_count());
+  EXPECT_EQ(1, row.typed_count());
+  EXPECT_FALSE(row.hidden());
+  EXPECT_EQ(last_visit - base::TimeDelta::FromDays(1), row.last_visit());
+
+  // Visits to a URL already in the database add to its counts.
+  visits.clear();
+  visits.push_back(VisitInfo(last_visit, content::PAGE_TRANSITION_LINK));
+  ASSERT_TRUE(backend_->AddVisits(url, visits, history::SOURCE_SYNCED));
+  ASSERT_EQ(id, backend_->db()->GetRowForURL(url, &row));
+  EXPECT_EQ(3, row.visit_count());
+  EXPECT_EQ(1, row.typed_count());
+  EXPECT_EQ(last_visit, row.last_visit());
+
+  VisitVector url_visits;
+  ASSERT_TRUE(backend_->db()->GetVisitsForURL(id, &url_visits));
+  EXPECT_EQ(4U, url_visits.size());
+}
+
 TEST_F(HistoryBackendTest, GetMostRecentVisits) {
   ASSERT_TRUE(backend_.get());
 
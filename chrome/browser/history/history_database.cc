@@ -72,6 +72,7 @@ sql::InitStatus HistoryDatabase::Init(const FilePath& history_name,
                                       const FilePath& bookmarks_path) {
   // Set the exceptional sqlite error handler.
   db_.set_error_delegate(GetErrorHandlerForHistoryDb());
+  db_.set_histogram_tag("History");
 
   // Set the database page size to something a little larger to give us
   // better performance (we're typically seek rather than bandwidth limited).
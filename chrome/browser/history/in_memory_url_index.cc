@@ -58,18 +58,25 @@ InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask::
     RebuildPrivateDataFromHistoryDBTask(
         InMemoryURLIndex* index,
         const std::string& languages,
-        const std::set<std::string>& scheme_whitelist)
+        const std::set<std::string>& scheme_whitelist,
+        bool typed_only)
     : index_(index),
       languages_(languages),
       scheme_whitelist_(scheme_whitelist),
+      typed_only_(typed_only),
       succeeded_(false) {
 }
 
 bool InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask::RunOnDBThread(
     HistoryBackend* backend,
     HistoryDatabase* db) {
-  data_ = URLIndexPrivateData::RebuildFromHistory(db, languages_,
-                                                  scheme_whitelist_);
+  if (typed_only_) {
+    data_ = URLIndexPrivateData::RebuildFromTypedURLs(db, languages_,
+                                                      scheme_whitelist_);
+  } else {
+    data_ = URLIndexPrivateData::RebuildFromHistory(db, languages_,
+                                                    scheme_whitelist_);
+  }
   succeeded_ = data_.get() && !data_->Empty();
   if (!succeeded_ && data_.get())
     data_->Clear();
@@ -78,7 +85,10 @@ bool InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask::RunOnDBThread(
 
 void InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask::
     DoneRunOnMainThread() {
-  index_->DoneRebuidingPrivateDataFromHistoryDB(succeeded_, data_);
+  if (typed_only_)
+    index_->DoneRebuildingTypedPrivateData(succeeded_, data_);
+  else
+    index_->DoneRebuidingPrivateDataFromHistoryDB(succeeded_, data_);
 }
 
 InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask::
@@ -254,12 +264,28 @@ void InMemoryURLIndex::OnCacheLoadDone(
 void InMemoryURLIndex::ScheduleRebuildFromHistory() {
   HistoryService* service =
       profile_->GetHistoryService(Profile::EXPLICIT_ACCESS);
+  // History DB tasks run in order, so the typed URLs are always handed over
+  // before the full index.
+  service->ScheduleDBTask(
+      new InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask(
+          this, languages_, scheme_whitelist_, true),
+      &cache_reader_consumer_);
   service->ScheduleDBTask(
       new InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask(
-          this, languages_, scheme_whitelist_),
+          this, languages_, scheme_whitelist_, false),
       &cache_reader_consumer_);
 }
 
+void InMemoryURLIndex::DoneRebuildingTypedPrivateData(
+    bool succeeded,
+    scoped_refptr<URLIndexPrivateData> private_data) {
+  DCHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::UI));
+  // The partial index is neither cached nor reported to the observer; the
+  // full rebuild that follows replaces it and does both.
+  if (succeeded)
+    private_data_ = private_data;
+}
+
 void InMemoryURLIndex::DoneRebuidingPrivateDataFromHistoryDB(
     bool succeeded,
     scoped_refptr<URLIndexPrivateData> private_data) {
@@ -158,12 +158,15 @@ class InMemoryURLIndex : public content::NotificationObserver,
   InMemoryURLIndex();
 
   // HistoryDBTask used to rebuild our private data from the history database.
+  // If |typed_only| is true only the typed URLs are indexed, giving a partial
+  // index to serve queries until the full rebuild completes.
   class RebuildPrivateDataFromHistoryDBTask : public HistoryDBTask {
    public:
-    explicit RebuildPrivateDataFromHistoryDBTask(
+    RebuildPrivateDataFromHistoryDBTask(
         InMemoryURLIndex* index,
         const std::string& languages,
-        const std::set<std::string>& scheme_whitelist);
+        const std::set<std::string>& scheme_whitelist,
+        bool typed_only);
 
     virtual bool RunOnDBThread(HistoryBackend* backend,
                                history::HistoryDatabase* db) OVERRIDE;
@@ -175,6 +178,7 @@ class InMemoryURLIndex : public content::NotificationObserver,
     InMemoryURLIndex* index_;  // Call back to this index at completion.
     std::string languages_;  // Languages for word-breaking.
     std::set<std::string> scheme_whitelist_;  // Schemes to be indexed.
+    bool typed_only_;  // Indicates if only typed URLs are to be indexed.
     bool succeeded_;  // Indicates if the rebuild was successful.
     scoped_refptr<URLIndexPrivateData> data_;  // The rebuilt private data.
 
@@ -195,10 +199,18 @@ class InMemoryURLIndex : public content::NotificationObserver,
   // profile directory.
   void PostRestoreFromCacheFileTask();
 
-  // Schedules a history task to rebuild our private data from the history
-  // database.
+  // Schedules history tasks to rebuild our private data from the history
+  // database. A quick pass over the typed URLs is scheduled ahead of the full
+  // rebuild, so that the most likely matches are available within moments of
+  // startup instead of only once every URL has been indexed.
   void ScheduleRebuildFromHistory();
 
+  // Callback used by RebuildPrivateDataFromHistoryDBTask to hand over the
+  // index of typed URLs, which is used until the full rebuild completes.
+  void DoneRebuildingTypedPrivateData(
+      bool succeeded,
+      scoped_refptr<URLIndexPrivateData> private_data);
+
   // Callback used by RebuildPrivateDataFromHistoryDBTask to signal completion
   // or rebuilding our private data from the history database. |succeeded|
   // will be true if the rebuild was successful. |data| will point to a new
@@ -130,6 +130,34 @@ Char16Set Char16SetFromString16(const string16& uni_word);
 // Determine if |prefix| is any of the standard 'ftp' or 'http[s]' prefixes.
 bool IsInlineablePrefix(const string16& prefix);
 
+// Removes from |result| every element that is not also in |other|. When
+// |other| is the smaller set only its elements are looked up in |result|, so
+// narrowing a large candidate set by a small one, or the reverse, costs about
+// as much as walking the small one.
+template <typename T>
+void IntersectSetInPlace(std::set<T>* result, const std::set<T>& other) {
+  if (other.size() < result->size()) {
+    std::set<T> intersection;
+    for (typename std::set<T>::const_iterator iter = other.begin();
+         iter != other.end(); ++iter) {
+      if (result->count(*iter))
+        intersection.insert(intersection.end(), *iter);
+    }
+    result->swap(intersection);
+    return;
+  }
+  typename std::set<T>::const_iterator other_iter = other.begin();
+  for (typename std::set<T>::iterator iter = result->begin();
+       iter != result->end(); ) {
+    while (other_iter != other.end() && *other_iter < *iter)
+      ++other_iter;
+    if (other_iter == other.end() || *iter < *other_iter)
+      result->erase(iter++);
+    else
+      ++iter;
+  }
+}
+
 // Support for InMemoryURLIndex Private Data -----------------------------------
 
 // An index into a list of all of the words we have indexed.
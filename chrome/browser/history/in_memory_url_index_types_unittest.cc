@@ -144,4 +144,31 @@ TEST_F(InMemoryURLIndexTypesTest, OffsetsAndTermMatches) {
     EXPECT_EQ(expected_offsets_b[i], matches_b[i].offset);
 }
 
+TEST_F(InMemoryURLIndexTypesTest, IntersectSetInPlace) {
+  const size_t small_ids[] = {2, 5, 9, 40};
+  const size_t large_ids[] = {1, 2, 3, 5, 8, 13, 21, 34, 40, 55};
+  std::set<size_t> small_set(small_ids, small_ids + arraysize(small_ids));
+  std::set<size_t> large_set(large_ids, large_ids + arraysize(large_ids));
+  const size_t expected_ids[] = {2, 5, 40};
+  std::vector<size_t> expected(expected_ids,
+                               expected_ids + arraysize(expected_ids));
+
+  // Narrowing a large set by a small one.
+  std::set<size_t> result(large_set);
+  IntersectSetInPlace(&result, small_set);
+  EXPECT_EQ(expected, std::vector<size_t>(result.begin(), result.end()));
+
+  // Narrowing a small set by a large one.
+  result = small_set;
+  IntersectSetInPlace(&result, large_set);
+  EXPECT_EQ(expected, std::vector<size_t>(result.begin(), result.end()));
+
+  // Disjoint and empty sets.
+  result = small_set;
+  IntersectSetInPlace(&result, std::set<size_t>());
+  EXPECT_TRUE(result.empty());
+  IntersectSetInPlace(&result, large_set);
+  EXPECT_TRUE(result.empty());
+}
+
 }  // namespace history
@@ -469,6 +469,28 @@ TEST_F(LimitedInMemoryURLIndexTest, Initialization) {
   EXPECT_EQ(17U, private_data.word_map_.size());
 }
 
+TEST_F(InMemoryURLIndexTest, RebuildFromTypedURLs) {
+  URLID typed_id = history_database_->AddURL(
+      MakeURLRow("http://typed.example.com/", "Typed", 3, 0, 2));
+  URLID untyped_id = history_database_->AddURL(
+      MakeURLRow("http://untyped.example.com/", "Untyped", 3, 0, 0));
+  ASSERT_TRUE(typed_id);
+  ASSERT_TRUE(untyped_id);
+
+  scoped_refptr<URLIndexPrivateData> typed_data(
+      URLIndexPrivateData::RebuildFromTypedURLs(
+          history_database_, "en", url_index_->scheme_whitelist()));
+  ASSERT_TRUE(typed_data.get());
+
+  // Only the typed URLs are indexed.
+  const HistoryInfoMap& typed_map(typed_data->history_info_map_);
+  EXPECT_EQ(1U, typed_map.count(typed_id));
+  EXPECT_EQ(0U, typed_map.count(untyped_id));
+  for (HistoryInfoMap::const_iterator iter = typed_map.begin();
+       iter != typed_map.end(); ++iter)
+    EXPECT_GT(iter->second.typed_count(), 0);
+}
+
 TEST_F(InMemoryURLIndexTest, Retrieval) {
   // See if a very specific term gives a single result.
   ScoredHistoryMatches matches =
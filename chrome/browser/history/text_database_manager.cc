@@ -86,6 +86,8 @@ TextDatabaseManager::TextDatabaseManager(const FilePath& dir,
       transaction_nesting_(0),
       db_cache_(DBCache::NO_AUTO_EVICT),
       present_databases_loaded_(false),
+      last_written_db_(0),
+      db_to_optimize_(0),
       ALLOW_THIS_IN_INITIALIZER_LIST(weak_factory_(this)),
       history_publisher_(NULL) {
 }
@@ -276,6 +278,15 @@ bool TextDatabaseManager::AddPageData(const GURL& url,
   if (!db)
     return false;
 
+  TextDatabase::DBIdent db_ident = TimeToID(visit_time);
+  if (db_ident > last_written_db_) {
+    // A new month has started, so the previous month's database will hardly
+    // be written to again.
+    if (last_written_db_)
+      db_to_optimize_ = last_written_db_;
+    last_written_db_ = db_ident;
+  }
+
   TimeTicks beginning_time = TimeTicks::Now();
 
   // First delete any recently-indexed data for this page. This will delete
@@ -379,6 +390,8 @@ void TextDatabaseManager::DeleteAll() {
 
   // Delete uncommitted entries.
   recent_changes_.Clear();
+  last_written_db_ = 0;
+  db_to_optimize_ = 0;
 
   // Close all open databases.
   db_cache_.Clear();
@@ -395,19 +408,8 @@ void TextDatabaseManager::OptimizeChangedDatabases(
     const ChangeSet& change_set) {
   for (ChangeSet::DBSet::const_iterator i =
            change_set.changed_databases_.begin();
-       i != change_set.changed_databases_.end(); ++i) {
-    // We want to open the database for writing, but only if it exists. To
-    // achieve this, we check whether it exists by saying we're not going to
-    // write to it (avoiding the autocreation code normally called when writing)
-    // and then access it for writing only if it succeeds.
-    TextDatabase* db = GetDB(*i, false);
-    if (!db)
-      continue;
-    db = GetDB(*i, true);
-    if (!db)
-      continue;  // The file may have changed or something.
-    db->Optimize();
-  }
+       i != change_set.changed_databases_.end(); ++i)
+    OptimizeDB(*i);
 }
 
 void TextDatabaseManager::GetTextMatches(
@@ -532,6 +534,20 @@ TextDatabase* TextDatabaseManager::GetDBForTime(Time time,
   return GetDB(TimeToID(time), create_if_necessary);
 }
 
+void TextDatabaseManager::OptimizeDB(TextDatabase::DBIdent id) {
+  // We want to open the database for writing, but only if it exists. To
+  // achieve this, we check whether it exists by saying we're not going to
+  // write to it (avoiding the autocreation code normally called when writing)
+  // and then access it for writing only if it succeeds.
+  TextDatabase* db = GetDB(id, false);
+  if (!db)
+    return;
+  db = GetDB(id, true);
+  if (!db)
+    return;  // The file may have changed or something.
+  db->Optimize();
+}
+
 void TextDatabaseManager::ScheduleFlushOldChanges() {
   weak_factory_.InvalidateWeakPtrs();
   MessageLoop::current()->PostDelayedTask(
@@ -555,6 +571,11 @@ void TextDatabaseManager::FlushOldChangesForTime(TimeTicks now) {
     i = recent_changes_.Erase(i);
   }
 
+  if (db_to_optimize_) {
+    OptimizeDB(db_to_optimize_);
+    db_to_optimize_ = 0;
+  }
+
   ScheduleFlushOldChanges();
 }
 
@@ -162,6 +162,7 @@ class TextDatabaseManager {
   // These tests call ExpireRecentChangesForTime to force expiration.
   FRIEND_TEST_ALL_PREFIXES(TextDatabaseManagerTest, InsertPartial);
   FRIEND_TEST_ALL_PREFIXES(TextDatabaseManagerTest, PartialComplete);
+  FRIEND_TEST_ALL_PREFIXES(TextDatabaseManagerTest, OptimizeFinishedMonth);
   FRIEND_TEST_ALL_PREFIXES(ExpireHistoryTest, DeleteURLAndFavicon);
   FRIEND_TEST_ALL_PREFIXES(ExpireHistoryTest, FlushRecentURLsUnstarred);
   FRIEND_TEST_ALL_PREFIXES(ExpireHistoryTest,
@@ -235,11 +236,14 @@ class TextDatabaseManager {
   // call it whenever you want to ensure the present_databases_ set is filled.
   void InitDBList();
 
+  // Optimizes the database with the given identifier if it exists.
+  void OptimizeDB(TextDatabase::DBIdent id);
+
   // Schedules a call to ExpireRecentChanges in the future.
   void ScheduleFlushOldChanges();
 
   // Checks the recent_changes_ list and commits partial data that has been
-  // around too long.
+  // around too long, then optimizes db_to_optimize_ if there is one.
   void FlushOldChanges();
 
   // Given "now," this will expire old things from the recent_changes_ list.
@@ -293,6 +297,15 @@ class TextDatabaseManager {
   // when the transaction is committed.
   DBIdentSet open_transactions_;
 
+  // The most recent database AddPageData has written to, or 0 if none.
+  TextDatabase::DBIdent last_written_db_;
+
+  // A database that stopped getting new pages when a later month started, or
+  // 0 if none. Its index segments are merged once by the next FlushOldChanges
+  // rather than while the page that started the new month is being indexed,
+  // so queries against it don't have to look through every segment.
+  TextDatabase::DBIdent db_to_optimize_;
+
   QueryParser query_parser_;
 
   // Generates tasks for our periodic checking of expired "recent changes".
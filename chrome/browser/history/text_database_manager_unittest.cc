@@ -199,6 +199,30 @@ TEST_F(TextDatabaseManagerTest, InsertQuery) {
   EXPECT_TRUE(first_time_searched <= times[0]);
 }
 
+// Tests that a month's database is optimized by the next flush once pages start
+// going into the next month's.
+TEST_F(TextDatabaseManagerTest, OptimizeFinishedMonth) {
+  ASSERT_TRUE(Init());
+  InMemDB visit_db;
+  TextDatabaseManager manager(dir_, &visit_db, &visit_db);
+  ASSERT_TRUE(manager.Init(NULL));
+
+  std::vector<Time> times;
+  AddAllPages(manager, &visit_db, &times);
+  EXPECT_EQ(TextDatabaseManager::TimeToID(times[0]), manager.db_to_optimize_);
+
+  manager.FlushOldChangesForTime(TimeTicks::Now());
+  EXPECT_EQ(0, manager.db_to_optimize_);
+
+  // Everything is still there.
+  QueryOptions options;
+  std::vector<TextDatabase::Match> results;
+  Time first_time_searched;
+  manager.GetTextMatches(UTF8ToUTF16("FOO"), options,
+                         &results, &first_time_searched);
+  EXPECT_EQ(6U, results.size());
+}
+
 // Tests that adding page components piecemeal will get them added properly.
 // This does not supply a visit to update, this mode is used only by the unit
 // tests right now, but we test it anyway.
@@ -203,6 +203,12 @@ bool TopSites::SetPageThumbnail(const GURL& url,
   if (!HistoryService::CanAddURL(url))
     return false;  // It's not a real webpage.
 
+  // Encoding is the expensive part, so don't bother when the thumbnail we
+  // have is better. This is the common case, as thumbnails are captured
+  // every time the user leaves a page.
+  if (!add_temp_thumbnail && !ShouldReplaceThumbnailForURL(url, score))
+    return false;
+
   scoped_refptr<base::RefCountedBytes> thumbnail_data;
   if (!EncodeBitmap(thumbnail, &thumbnail_data))
     return false;
@@ -508,27 +514,40 @@ bool TopSites::SetPageThumbnailNoDB(const GURL& url,
   // This should only be invoked when we know about the url.
   DCHECK(cache_->IsKnownURL(url));
 
-  const MostVisitedURL& most_visited =
-      cache_->top_sites()[cache_->GetURLIndex(url)];
+  if (!ShouldReplaceThumbnailForURL(url, score))
+    return false;  // The one we already have is better.
+
   Images* image = cache_->GetImage(url);
+  image->thumbnail = const_cast<base::RefCountedBytes*>(thumbnail_data);
+  image->thumbnail_score = GetScoreWithRedirects(url, score);
+
+  ResetThreadSafeImageCache();
+  return true;
+}
 
+ThumbnailScore TopSites::GetScoreWithRedirects(const GURL& url,
+                                               const ThumbnailScore& score) {
   // When comparing the thumbnail scores, we need to take into account the
   // redirect hops, which are not generated when the thumbnail is because the
   // redirects weren't known. We fill that in here since we know the redirects.
-  ThumbnailScore new_score_with_redirects(score);
-  new_score_with_redirects.redirect_hops_from_dest =
+  const MostVisitedURL& most_visited =
+      cache_->top_sites()[cache_->GetURLIndex(url)];
+  ThumbnailScore score_with_redirects(score);
+  score_with_redirects.redirect_hops_from_dest =
       GetRedirectDistanceForURL(most_visited, url);
+  return score_with_redirects;
+}
 
-  if (!ShouldReplaceThumbnailWith(image->thumbnail_score,
-                                  new_score_with_redirects) &&
-      image->thumbnail.get())
-    return false;  // The one we already have is better.
-
-  image->thumbnail = const_cast<base::RefCountedBytes*>(thumbnail_data);
-  image->thumbnail_score = new_score_with_redirects;
-
-  ResetThreadSafeImageCache();
-  return true;
+bool TopSites::ShouldReplaceThumbnailForURL(const GURL& url,
+                                            const ThumbnailScore& score) {
+  scoped_refptr<base::RefCountedMemory> current_thumbnail;
+  ThumbnailScore current_score;
+  if (!cache_->GetPageThumbnail(url, &current_thumbnail) ||
+      !cache_->GetPageThumbnailScore(url, &current_score)) {
+    return true;
+  }
+  return ShouldReplaceThumbnailWith(current_score,
+                                    GetScoreWithRedirects(url, score));
 }
 
 bool TopSites::SetPageThumbnailEncoded(const GURL& url,
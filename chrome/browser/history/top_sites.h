@@ -219,6 +219,16 @@ class TopSites
                             const base::RefCountedBytes* thumbnail_data,
                             const ThumbnailScore& score);
 
+  // Returns |score| with the redirect hops from the page |url| redirects to
+  // filled in. |url| must be known.
+  ThumbnailScore GetScoreWithRedirects(const GURL& url,
+                                       const ThumbnailScore& score);
+
+  // Returns true if a thumbnail for |url| with |score| would replace the one
+  // we have. |url| must be known.
+  bool ShouldReplaceThumbnailForURL(const GURL& url,
+                                    const ThumbnailScore& score);
+
   // A version of SetPageThumbnail that takes RefCountedBytes as
   // returned by HistoryService.
   bool SetPageThumbnailEncoded(const GURL& url,
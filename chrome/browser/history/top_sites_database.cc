@@ -375,6 +375,7 @@ sql::Connection* TopSitesDatabase::CreateDB(const FilePath& db_name) {
   scoped_ptr<sql::Connection> db(new sql::Connection());
   // Settings copied from ThumbnailDatabase.
   db->set_error_delegate(GetErrorHandlerForThumbnailDb());
+  db->set_histogram_tag("TopSites");
   db->set_page_size(4096);
   db->set_cache_size(32);
 
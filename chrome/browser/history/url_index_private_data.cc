@@ -81,6 +81,11 @@ bool LengthGreater(const string16& string_a, const string16& string_b) {
   return string_a.length() > string_b.length();
 }
 
+// Comparison function for sorting word ID sets by ascending size.
+bool WordIDSetSizeLess(const WordIDSet* set_a, const WordIDSet* set_b) {
+  return set_a->size() < set_b->size();
+}
+
 // std::accumulate helper function to add up TermMatches' lengths.
 int AccumulateMatchLength(int total, const TermMatch& match) {
   return total + match.length;
@@ -326,7 +331,8 @@ void URLIndexPrivateData::AddToHistoryIDWordMap(HistoryID history_id,
   HistoryIDWordMap::iterator iter = history_id_word_map_.find(history_id);
   if (iter != history_id_word_map_.end()) {
     WordIDSet& word_id_set(iter->second);
-    word_id_set.insert(word_id);
+    // Word IDs are usually added in increasing order, so hint at the end.
+    word_id_set.insert(word_id_set.end(), word_id);
   } else {
     WordIDSet word_id_set;
     word_id_set.insert(word_id);
@@ -770,16 +776,10 @@ HistoryIDSet URLIndexPrivateData::HistoryIDSetFromWords(
       history_id_set.clear();
       break;
     }
-    if (iter == words.begin()) {
+    if (iter == words.begin())
       history_id_set.swap(term_history_set);
-    } else {
-      HistoryIDSet new_history_id_set;
-      std::set_intersection(history_id_set.begin(), history_id_set.end(),
-                            term_history_set.begin(), term_history_set.end(),
-                            std::inserter(new_history_id_set,
-                                          new_history_id_set.begin()));
-      history_id_set.swap(new_history_id_set);
-    }
+    else
+      IntersectSetInPlace(&history_id_set, term_history_set);
   }
   return history_id_set;
 }
@@ -847,16 +847,10 @@ HistoryIDSet URLIndexPrivateData::HistoryIDsForTerm(
         return HistoryIDSet();
       }
       // Or there may not have been a prefix from which to start.
-      if (prefix_chars.empty()) {
+      if (prefix_chars.empty())
         word_id_set.swap(leftover_set);
-      } else {
-        WordIDSet new_word_id_set;
-        std::set_intersection(word_id_set.begin(), word_id_set.end(),
-                              leftover_set.begin(), leftover_set.end(),
-                              std::inserter(new_word_id_set,
-                                            new_word_id_set.begin()));
-        word_id_set.swap(new_word_id_set);
-      }
+      else
+        IntersectSetInPlace(&word_id_set, leftover_set);
     }
 
     // We must filter the word list because the resulting word set surely
@@ -898,36 +892,29 @@ HistoryIDSet URLIndexPrivateData::HistoryIDsForTerm(
 
 WordIDSet URLIndexPrivateData::WordIDSetForTermChars(
     const Char16Set& term_chars) {
-  WordIDSet word_id_set;
+  std::vector<const WordIDSet*> char_word_id_sets;
   for (Char16Set::const_iterator c_iter = term_chars.begin();
        c_iter != term_chars.end(); ++c_iter) {
     CharWordIDMap::iterator char_iter = char_word_map_.find(*c_iter);
-    if (char_iter == char_word_map_.end()) {
-      // A character was not found so there are no matching results: bail.
-      word_id_set.clear();
-      break;
-    }
-    WordIDSet& char_word_id_set(char_iter->second);
+    // A character was not found so there are no matching results: bail.
+    if (char_iter == char_word_map_.end())
+      return WordIDSet();
     // It is possible for there to no longer be any words associated with
     // a particular character. Give up in that case.
-    if (char_word_id_set.empty()) {
-      word_id_set.clear();
-      break;
-    }
-
-    if (c_iter == term_chars.begin()) {
-      // First character results becomes base set of results.
-      word_id_set = char_word_id_set;
-    } else {
-      // Subsequent character results get intersected in.
-      WordIDSet new_word_id_set;
-      std::set_intersection(word_id_set.begin(), word_id_set.end(),
-                            char_word_id_set.begin(), char_word_id_set.end(),
-                            std::inserter(new_word_id_set,
-                                          new_word_id_set.begin()));
-      word_id_set.swap(new_word_id_set);
-    }
+    if (char_iter->second.empty())
+      return WordIDSet();
+    char_word_id_sets.push_back(&char_iter->second);
   }
+  if (char_word_id_sets.empty())
+    return WordIDSet();
+
+  // Start from the rarest character, so that only the smallest set is copied
+  // and every intersection after it is bounded by its size.
+  std::sort(char_word_id_sets.begin(), char_word_id_sets.end(),
+            WordIDSetSizeLess);
+  WordIDSet word_id_set(*char_word_id_sets[0]);
+  for (size_t i = 1; i < char_word_id_sets.size() && !word_id_set.empty(); ++i)
+    IntersectSetInPlace(&word_id_set, *char_word_id_sets[i]);
   return word_id_set;
 }
 
@@ -1164,6 +1151,29 @@ scoped_refptr<URLIndexPrivateData> URLIndexPrivateData::RebuildFromHistory(
   return rebuilt_data;
 }
 
+// static
+scoped_refptr<URLIndexPrivateData> URLIndexPrivateData::RebuildFromTypedURLs(
+    HistoryDatabase* history_db,
+    const std::string& languages,
+    const std::set<std::string>& scheme_whitelist) {
+  if (!history_db)
+    return NULL;
+
+  base::TimeTicks beginning_time = base::TimeTicks::Now();
+
+  URLRows typed_rows;
+  if (!history_db->GetAllTypedUrls(&typed_rows))
+    return NULL;
+  scoped_refptr<URLIndexPrivateData> rebuilt_data(new URLIndexPrivateData);
+  for (URLRows::const_iterator row = typed_rows.begin();
+       row != typed_rows.end(); ++row)
+    rebuilt_data->IndexRow(*row, languages, scheme_whitelist);
+
+  UMA_HISTOGRAM_TIMES("History.InMemoryURLTypedIndexingTime",
+                      base::TimeTicks::Now() - beginning_time);
+  return rebuilt_data;
+}
+
 bool URLIndexPrivateData::RestorePrivateData(
     const InMemoryURLIndexCacheItem& cache,
     const std::string& languages) {
@@ -1201,8 +1211,11 @@ bool URLIndexPrivateData::RestoreWordMap(
     return false;
   const RepeatedPtrField<WordMapEntry>& entries(list_item.word_map_entry());
   for (RepeatedPtrField<WordMapEntry>::const_iterator iter = entries.begin();
-       iter != entries.end(); ++iter)
-    word_map_[UTF8ToUTF16(iter->word())] = iter->word_id();
+       iter != entries.end(); ++iter) {
+    word_map_.insert(word_map_.end(),
+                     std::make_pair(UTF8ToUTF16(iter->word()),
+                                    iter->word_id()));
+  }
   return true;
 }
 
@@ -1224,12 +1237,13 @@ bool URLIndexPrivateData::RestoreCharWordMap(
     if (actual_item_count == 0 || actual_item_count != expected_item_count)
       return false;
     char16 uni_char = static_cast<char16>(iter->char_16());
-    WordIDSet word_id_set;
+    // The cache was written from sorted containers, so fill them in place
+    // with end() hints, which makes each insertion constant time.
+    WordIDSet& word_id_set(char_word_map_[uni_char]);
     const RepeatedField<int32>& word_ids(iter->word_id());
     for (RepeatedField<int32>::const_iterator jiter = word_ids.begin();
          jiter != word_ids.end(); ++jiter)
-      word_id_set.insert(*jiter);
-    char_word_map_[uni_char] = word_id_set;
+      word_id_set.insert(word_id_set.end(), *jiter);
   }
   return true;
 }
@@ -1252,14 +1266,13 @@ bool URLIndexPrivateData::RestoreWordIDHistoryMap(
     if (actual_item_count == 0 || actual_item_count != expected_item_count)
       return false;
     WordID word_id = iter->word_id();
-    HistoryIDSet history_id_set;
+    HistoryIDSet& history_id_set(word_id_history_map_[word_id]);
     const RepeatedField<int64>& history_ids(iter->history_id());
     for (RepeatedField<int64>::const_iterator jiter = history_ids.begin();
          jiter != history_ids.end(); ++jiter) {
-      history_id_set.insert(*jiter);
+      history_id_set.insert(history_id_set.end(), *jiter);
       AddToHistoryIDWordMap(*jiter, word_id);
     }
-    word_id_history_map_[word_id] = history_id_set;
   }
   return true;
 }
@@ -1287,7 +1300,8 @@ bool URLIndexPrivateData::RestoreHistoryInfoMap(
       string16 title(UTF8ToUTF16(iter->title()));
       url_row.set_title(title);
     }
-    history_info_map_[history_id] = url_row;
+    history_info_map_.insert(history_info_map_.end(),
+                             std::make_pair(history_id, url_row));
   }
   return true;
 }
@@ -1309,18 +1323,15 @@ bool URLIndexPrivateData::RestoreWordStartsMap(
     for (RepeatedPtrField<WordStartsMapEntry>::const_iterator iter =
          entries.begin(); iter != entries.end(); ++iter) {
       HistoryID history_id = iter->history_id();
-      RowWordStarts word_starts;
+      RowWordStarts& word_starts(word_starts_map_[history_id]);
       // Restore the URL word starts.
       const RepeatedField<int32>& url_starts(iter->url_word_starts());
-      for (RepeatedField<int32>::const_iterator jiter = url_starts.begin();
-           jiter != url_starts.end(); ++jiter)
-        word_starts.url_word_starts_.push_back(*jiter);
+      word_starts.url_word_starts_.assign(url_starts.begin(),
+                                          url_starts.end());
       // Restore the page title word starts.
       const RepeatedField<int32>& title_starts(iter->title_word_starts());
-      for (RepeatedField<int32>::const_iterator jiter = title_starts.begin();
-           jiter != title_starts.end(); ++jiter)
-        word_starts.title_word_starts_.push_back(*jiter);
-      word_starts_map_[history_id] = word_starts;
+      word_starts.title_word_starts_.assign(title_starts.begin(),
+                                            title_starts.end());
     }
   } else {
     // Since the cache did not contain any word starts we must rebuild then from
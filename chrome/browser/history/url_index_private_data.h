@@ -166,6 +166,14 @@ class URLIndexPrivateData
       const std::string& languages,
       const std::set<std::string>& scheme_whitelist);
 
+  // Like RebuildFromHistory(), but indexes only the typed URLs. These are few
+  // and the most likely to be matched, so the result can serve queries while
+  // the full index is still being rebuilt.
+  static scoped_refptr<URLIndexPrivateData> RebuildFromTypedURLs(
+      HistoryDatabase* history_db,
+      const std::string& languages,
+      const std::set<std::string>& scheme_whitelist);
+
   // Writes |private_data| as a cache file to |file_path| and returns success
   // via |succeeded|.
   static void WritePrivateDataToCacheFileTask(
@@ -1,10 +1,15 @@
-// Copyright (c) 2011 The Chromium Authors. All rights reserved.
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
 #include "chrome/browser/image_decoder.h"
 
+#include <deque>
+
 #include "base/bind.h"
+#include "base/lazy_instance.h"
+#include "base/memory/weak_ptr.h"
+#include "base/timer.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/common/chrome_utility_messages.h"
 #include "content/public/browser/browser_thread.h"
@@ -12,6 +17,157 @@
 
 using content::BrowserThread;
 using content::UtilityProcessHost;
+using content::UtilityProcessHostClient;
+
+namespace {
+
+// Number of utility processes kept for decoding images.
+const size_t kMaxDecoderProcesses = 2;
+
+// How long a decoder process stays up without work.
+const int kDecoderProcessIdleTimeoutSeconds = 10;
+
+void DeliverMessage(scoped_refptr<UtilityProcessHostClient> client,
+                    const IPC::Message& message) {
+  client->OnMessageReceived(message);
+}
+
+// A utility process in batch mode that decodes the images sent to it one at a
+// time, in order, so that its replies go to the pending clients first in,
+// first out. Lives on the IO thread.
+class DecoderProcess : public UtilityProcessHostClient {
+ public:
+  DecoderProcess() {}
+
+  bool Start() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    host_ = UtilityProcessHost::Create(this, BrowserThread::IO)->AsWeakPtr();
+    host_->EnableZygote();
+    return host_->StartBatchMode();
+  }
+
+  // Decodes |image_data| and sends the reply to |client| on |client_thread_id|.
+  void Decode(UtilityProcessHostClient* client,
+              BrowserThread::ID client_thread_id,
+              const std::vector<unsigned char>& image_data) {
+    DCHECK(IsAlive());
+    idle_timer_.Stop();
+    pending_.push_back(PendingDecode(client, client_thread_id));
+    host_->Send(new ChromeUtilityMsg_DecodeImage(image_data));
+  }
+
+  bool IsAlive() const { return host_.get() != NULL; }
+  size_t num_pending() const { return pending_.size(); }
+
+  // UtilityProcessHostClient implementation.
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    if (message.type() != ChromeUtilityHostMsg_DecodeImage_Succeeded::ID &&
+        message.type() != ChromeUtilityHostMsg_DecodeImage_Failed::ID) {
+      return false;
+    }
+    if (pending_.empty()) {
+      NOTREACHED();
+      return true;
+    }
+    Reply(message);
+    if (pending_.empty()) {
+      idle_timer_.Start(
+          FROM_HERE,
+          base::TimeDelta::FromSeconds(kDecoderProcessIdleTimeoutSeconds),
+          this, &DecoderProcess::OnIdleTimeout);
+    }
+    return true;
+  }
+
+  virtual void OnProcessCrashed(int exit_code) OVERRIDE {
+    while (!pending_.empty())
+      Reply(ChromeUtilityHostMsg_DecodeImage_Failed());
+  }
+
+ private:
+  typedef std::pair<scoped_refptr<UtilityProcessHostClient>,
+                    BrowserThread::ID> PendingDecode;
+
+  virtual ~DecoderProcess() {}
+
+  // Sends |message| to the oldest pending client.
+  void Reply(const IPC::Message& message) {
+    PendingDecode pending = pending_.front();
+    pending_.pop_front();
+    BrowserThread::PostTask(
+        pending.second, FROM_HERE,
+        base::Bind(&DeliverMessage, pending.first, message));
+  }
+
+  void OnIdleTimeout() {
+    DCHECK(pending_.empty());
+    if (host_.get()) {
+      host_->EndBatchMode();
+      host_.reset();
+    }
+  }
+
+  base::WeakPtr<UtilityProcessHost> host_;
+  std::deque<PendingDecode> pending_;
+  base::OneShotTimer<DecoderProcess> idle_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(DecoderProcess);
+};
+
+// Spreads the decodes over up to kMaxDecoderProcesses processes, so that
+// decoding many images doesn't start a process for each of them. Lives on
+// the IO thread.
+class DecoderProcessPool {
+ public:
+  DecoderProcessPool() {}
+
+  void Decode(UtilityProcessHostClient* client,
+              BrowserThread::ID client_thread_id,
+              const std::vector<unsigned char>& image_data) {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+    DecoderProcess* process = NULL;
+    for (Processes::iterator it = processes_.begin();
+         it != processes_.end();) {
+      if (!(*it)->IsAlive()) {
+        it = processes_.erase(it);
+        continue;
+      }
+      if (!process || (*it)->num_pending() < process->num_pending())
+        process = *it;
+      ++it;
+    }
+
+    if (!process || (process->num_pending() > 0 &&
+                     processes_.size() < kMaxDecoderProcesses)) {
+      scoped_refptr<DecoderProcess> new_process(new DecoderProcess());
+      if (new_process->Start()) {
+        processes_.push_back(new_process);
+        process = new_process;
+      }
+    }
+
+    if (!process) {
+      BrowserThread::PostTask(
+          client_thread_id, FROM_HERE,
+          base::Bind(&DeliverMessage, make_scoped_refptr(client),
+                     ChromeUtilityHostMsg_DecodeImage_Failed()));
+      return;
+    }
+    process->Decode(client, client_thread_id, image_data);
+  }
+
+ private:
+  typedef std::vector<scoped_refptr<DecoderProcess> > Processes;
+
+  Processes processes_;
+
+  DISALLOW_COPY_AND_ASSIGN(DecoderProcessPool);
+};
+
+base::LazyInstance<DecoderProcessPool>::Leaky g_decoder_process_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
 
 ImageDecoder::ImageDecoder(Delegate* delegate,
                            const std::string& image_data)
@@ -59,8 +215,5 @@ void ImageDecoder::OnDecodeImageFailed() {
 void ImageDecoder::DecodeImageInSandbox(
     const std::vector<unsigned char>& image_data) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
-  UtilityProcessHost* utility_process_host = UtilityProcessHost::Create(
-      this, target_thread_id_);
-  utility_process_host->EnableZygote();
-  utility_process_host->Send(new ChromeUtilityMsg_DecodeImage(image_data));
+  g_decoder_process_pool.Get().Decode(this, target_thread_id_, image_data);
 }
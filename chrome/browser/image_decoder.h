@@ -1,4 +1,4 @@
-// Copyright (c) 2011 The Chromium Authors. All rights reserved.
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
@@ -51,7 +51,9 @@ class ImageDecoder : public content::UtilityProcessHostClient {
   void OnDecodeImageSucceeded(const SkBitmap& decoded_image);
   void OnDecodeImageFailed();
 
-  // Launches sandboxed process that will decode the image.
+  // Sends the image to one of the sandboxed processes shared by all
+  // ImageDecoders. They stay up for a while after their last image, so that
+  // decoding several images doesn't start a process for each.
   void DecodeImageInSandbox(const std::vector<unsigned char>& image_data);
 
   Delegate* delegate_;
@@ -19,6 +19,7 @@
 #include "content/public/browser/browser_thread_delegate.h"
 #include "net/base/network_change_notifier.h"
 
+class CertVerifierCachePersister;
 class ChromeNetLog;
 class ExtensionEventRouterForwarder;
 class PrefProxyConfigTrackerImpl;
@@ -75,6 +76,8 @@ class IOThread : public content::BrowserThreadDelegate {
     scoped_ptr<net::NetworkDelegate> system_network_delegate;
     scoped_ptr<net::HostResolver> host_resolver;
     scoped_ptr<net::CertVerifier> cert_verifier;
+    // Saves the results of |cert_verifier| across restarts, if enabled.
+    scoped_ptr<CertVerifierCachePersister> cert_verifier_cache_persister;
     // This TransportSecurityState doesn't load or save any state. It's only
     // used to enforce pinning for system requests and will only use built-in
     // pins.
@@ -9,6 +9,7 @@
 #include "base/basictypes.h"
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/debug/trace_event.h"
 #include "base/memory/ref_counted.h"
 #include "base/message_loop.h"
 #include "base/metrics/histogram.h"
@@ -73,6 +74,10 @@ class JankWatchdog : public base::Watchdog {
     // Put break point here if you want to stop threads and look at what caused
     // the jankiness.
     alarm_count_++;
+    // Mark the hang in the trace, which can be left recording continuously to
+    // capture what led up to it.
+    TRACE_EVENT_INSTANT1("browser", "JankWatchdog::Alarm",
+                         "thread", thread_name_watched_);
     Watchdog::Alarm();
   }
 
@@ -4,6 +4,8 @@
 
 #include "chrome/browser/metrics/metrics_log_serializer.h"
 
+#include <algorithm>
+
 #include "base/base64.h"
 #include "base/md5.h"
 #include "base/metrics/histogram.h"
@@ -30,6 +32,13 @@ const size_t kMaxInitialLogsPersisted = 20;
 // ongoing_log_ at startup).
 const size_t kMaxOngoingLogsPersisted = 8;
 
+// The most compressed log data, XML and protobuf together, we're willing to
+// save for each type of log.  Logs are base64 encoded into Local State, which
+// is rewritten in full on every change, so a few huge ongoing logs from heavy
+// histogram users would otherwise bloat it and slow down all of its writes.
+// The newest logs are kept first.
+const size_t kMaxLogBytesPersisted = 1024 * 1024;
+
 // We append (2) more elements to persisted lists: the size of the list and a
 // checksum of the elements.
 const size_t kChecksumEntryCount = 2;
@@ -92,13 +101,37 @@ void MetricsLogSerializer::SerializeLogs(
       return;
   };
 
+  size_t store_count =
+      CountLogsToPersist(logs, max_store_count, kMaxLogBytesPersisted);
+  UMA_HISTOGRAM_COUNTS_100("PrefService.PersistentLogsDroppedForSize",
+                           std::min(logs.size(), max_store_count) -
+                               store_count);
+
   // Write the XML version.
   ListPrefUpdate update_xml(local_state, pref_xml);
-  WriteLogsToPrefList(logs, true, max_store_count, update_xml.Get());
+  WriteLogsToPrefList(logs, true, store_count, update_xml.Get());
 
   // Write the protobuf version.
   ListPrefUpdate update_proto(local_state, pref_proto);
-  WriteLogsToPrefList(logs, false, max_store_count, update_proto.Get());
+  WriteLogsToPrefList(logs, false, store_count, update_proto.Get());
+}
+
+// static
+size_t MetricsLogSerializer::CountLogsToPersist(
+    const std::vector<MetricsLogManager::SerializedLog>& local_list,
+    size_t max_list_size,
+    size_t max_bytes) {
+  size_t count = 0;
+  size_t bytes = 0;
+  for (std::vector<MetricsLogManager::SerializedLog>::const_reverse_iterator
+           it = local_list.rbegin();
+       it != local_list.rend() && count < max_list_size; ++it) {
+    bytes += it->xml.size() + it->proto.size();
+    if (bytes > max_bytes)
+      break;
+    ++count;
+  }
+  return count;
 }
 
 void MetricsLogSerializer::DeserializeLogs(
@@ -55,6 +55,14 @@ class MetricsLogSerializer : public MetricsLogManager::LogSerializer {
       size_t max_list_size,
       base::ListValue* list);
 
+  // Returns how many of the newest logs in |local_list| to persist: at most
+  // |max_list_size| of them, holding at most |max_bytes| of XML and protobuf
+  // data together.
+  static size_t CountLogsToPersist(
+      const std::vector<MetricsLogManager::SerializedLog>& local_list,
+      size_t max_list_size,
+      size_t max_bytes);
+
   // Decodes and verifies the textual log data from |list|, populating
   // |local_list| and returning a status code.  If |is_xml| is true, populates
   // the XML data in |local_list|; otherwise populates the protobuf data.
@@ -66,6 +74,7 @@ class MetricsLogSerializer : public MetricsLogManager::LogSerializer {
   FRIEND_TEST_ALL_PREFIXES(MetricsLogSerializerTest, EmptyLogList);
   FRIEND_TEST_ALL_PREFIXES(MetricsLogSerializerTest, SingleElementLogList);
   FRIEND_TEST_ALL_PREFIXES(MetricsLogSerializerTest, OverLimitLogList);
+  FRIEND_TEST_ALL_PREFIXES(MetricsLogSerializerTest, OverByteLimitLogList);
   FRIEND_TEST_ALL_PREFIXES(MetricsLogSerializerTest, SmallRecoveredListSize);
   FRIEND_TEST_ALL_PREFIXES(MetricsLogSerializerTest, RemoveSizeFromLogList);
   FRIEND_TEST_ALL_PREFIXES(MetricsLogSerializerTest, CorruptSizeOfLogList);
@@ -112,6 +112,25 @@ TEST(MetricsLogSerializerTest, OverLimitLogList) {
   EXPECT_EQ(kMaxLocalListSize, local_list.size());
 }
 
+// Only the newest logs that fit within the byte limit are persisted.
+TEST(MetricsLogSerializerTest, OverByteLimitLogList) {
+  std::vector<SerializedLog> local_list(4);
+  local_list[0].xml = "one";
+  local_list[0].proto = "one";
+  local_list[1].xml = "two";
+  local_list[1].proto = "two";
+  local_list[2].xml = "three";
+  local_list[2].proto = "three";
+  local_list[3].xml = "four";
+  local_list[3].proto = "four";
+
+  EXPECT_EQ(4U, MetricsLogSerializer::CountLogsToPersist(local_list, 4, 100));
+  EXPECT_EQ(3U, MetricsLogSerializer::CountLogsToPersist(local_list, 3, 100));
+  // "four" and "three" use 18 bytes; adding "two" would use 24.
+  EXPECT_EQ(2U, MetricsLogSerializer::CountLogsToPersist(local_list, 4, 23));
+  EXPECT_EQ(0U, MetricsLogSerializer::CountLogsToPersist(local_list, 4, 7));
+}
+
 // Induce LIST_SIZE_TOO_SMALL corruption
 TEST(MetricsLogSerializerTest, SmallRecoveredListSize) {
   ListValue list;
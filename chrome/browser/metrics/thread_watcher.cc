@@ -381,6 +381,15 @@ void ThreadWatcher::GotNoResponse() {
       crashed_once = true;
       CrashBecauseThreadWasUnresponsive(thread_id_);
     }
+  } else if (ThreadWatcherList::dump_on_hang()) {
+    // Capture what the hung thread is doing without crashing the browser. The
+    // dump suspends the whole process while it is written, so only the first
+    // hang of the session is dumped.
+    static bool dumped_once = false;
+    if (!dumped_once) {
+      dumped_once = true;
+      logging::DumpWithoutCrashing();
+    }
   }
 
   hung_processing_complete_ = true;
@@ -396,6 +405,8 @@ bool ThreadWatcher::IsVeryUnresponsive() {
 // static
 ThreadWatcherList* ThreadWatcherList::g_thread_watcher_list_ = NULL;
 // static
+bool ThreadWatcherList::g_dump_on_hang_ = false;
+// static
 const int ThreadWatcherList::kSleepSeconds = 1;
 // static
 const int ThreadWatcherList::kUnresponsiveSeconds = 2;
@@ -413,6 +424,7 @@ void ThreadWatcherList::StartWatchingAll(const CommandLine& command_line) {
                    &unresponsive_threshold,
                    &crash_on_hang_thread_names,
                    &live_threads_threshold);
+  g_dump_on_hang_ = command_line.HasSwitch(switches::kDumpOnHang);
 
   ThreadWatcherObserver::SetupNotifications(
       base::TimeDelta::FromSeconds(kSleepSeconds * unresponsive_threshold));
@@ -335,6 +335,10 @@ class ThreadWatcherList {
   // all thread watchers that are registered.
   static void WakeUpAll();
 
+  // Returns true if a hang that doesn't crash the browser should produce a
+  // crash dump (switches::kDumpOnHang).
+  static bool dump_on_hang() { return g_dump_on_hang_; }
+
  private:
   // Allow tests to access our innards for testing purposes.
   friend class CustomThreadWatcher;
@@ -389,6 +393,9 @@ class ThreadWatcherList {
   // threads that are being watched.
   static ThreadWatcherList* g_thread_watcher_list_;
 
+  // Whether switches::kDumpOnHang was passed. Set before watching starts.
+  static bool g_dump_on_hang_;
+
   // This is the wait time between ping messages.
   static const int kSleepSeconds;
 
@@ -9,11 +9,13 @@
 
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/file_util.h"
 #include "base/memory/mru_cache.h"
 #include "base/memory/singleton.h"
 #include "base/message_loop.h"
 #include "base/metrics/histogram.h"
 #include "base/path_service.h"
+#include "base/pickle.h"
 #include "base/string_number_conversions.h"
 #include "base/string_split.h"
 #include "base/string_util.h"
@@ -103,6 +105,43 @@ void SetCloseOnExec(nacl::Handle fd) {
 #endif
 }
 
+// The validation cache is kept in this file in the user data directory, so
+// that code validated in one session doesn't need validating in the next.
+const FilePath::CharType kValidationCacheFileName[] =
+    FILE_PATH_LITERAL("NaCl Validation Cache");
+
+// Bumped when the layout of the validation cache file changes.
+const int kValidationCacheFileVersion = 1;
+
+// The number of validation signatures kept. Each signature covers one chunk
+// of code, so a large module needs many of them.
+const size_t kValidationCacheSize = 500;
+
+// How long to wait after the validation cache changes before writing it,
+// so that the signatures added while a module loads are written together.
+const int kValidationCacheWriteDelaySeconds = 10;
+
+FilePath GetValidationCacheFilePath() {
+  FilePath user_data_dir;
+  if (!PathService::Get(chrome::DIR_USER_DATA, &user_data_dir))
+    return FilePath();
+  return user_data_dir.Append(kValidationCacheFileName);
+}
+
+// Runs on the FILE thread.
+void ReadValidationCacheFile(const FilePath& path, std::string* contents) {
+  if (!path.empty())
+    file_util::ReadFileToString(path, contents);
+}
+
+// Runs on the FILE thread.
+void WriteValidationCacheFile(const FilePath& path,
+                              const std::string& contents) {
+  int size = static_cast<int>(contents.size());
+  if (file_util::WriteFile(path, contents.data(), size) != size)
+    LOG(ERROR) << "Failed to write NaCl validation cache";
+}
+
 bool ShareHandleToSelLdr(
     base::ProcessHandle processh,
     nacl::Handle sourceh,
@@ -163,11 +202,21 @@ class NaClBrowser {
   const FilePath& GetIrtFilePath();
 
   // Get the key used for HMACing validation signatures.  This should be a
-  // string of cryptographically secure random bytes.
-  const std::string& GetValidatorCacheKey() const {
+  // string of cryptographically secure random bytes.  Once the key has been
+  // handed out, a validation cache read from disk afterwards is ignored.
+  const std::string& GetValidatorCacheKey() {
+    validator_cache_key_used_ = true;
     return validator_cache_key_;
   }
 
+  // Asynchronously read the validation cache saved by the previous session,
+  // so that it is usually in place by the time the NaCl process starts.
+  void EnsureValidationCacheAvailable();
+
+  static void DoEnsureValidationCacheAvailable() {
+    GetInstance()->EnsureValidationCacheAvailable();
+  }
+
   // Is the validation signature in the database?
   bool QueryKnownToValidate(const std::string& signature);
 
@@ -180,11 +229,13 @@ class NaClBrowser {
   NaClBrowser()
       : irt_platform_file_(base::kInvalidPlatformFileValue),
         irt_filepath_(),
-        // For the moment, choose an arbitrary cache size.
-        validation_cache_(200),
-        // TODO(ncbray) persist this key along with the cache.
+        validation_cache_(kValidationCacheSize),
+        // The key is replaced by the one saved along with the cache, if any.
         // Key size is equal to the block size (not the digest size) of SHA256.
-        validator_cache_key_(base::RandBytesAsString(64)) {
+        validator_cache_key_(base::RandBytesAsString(64)),
+        validator_cache_key_used_(false),
+        validation_cache_load_requested_(false),
+        validation_cache_write_pending_(false) {
     InitIrtFilePath();
   }
 
@@ -201,6 +252,17 @@ class NaClBrowser {
     GetInstance()->OpenIrtLibraryFile();
   }
 
+  // Replaces the validation cache and its key with the ones serialized in
+  // |contents|, unless the current key is already in use.
+  void OnValidationCacheRead(const std::string* contents);
+
+  // Serializes the validation cache and writes it on the FILE thread.
+  void WriteValidationCache();
+
+  static void DoWriteValidationCache() {
+    GetInstance()->WriteValidationCache();
+  }
+
   base::PlatformFile irt_platform_file_;
 
   FilePath irt_filepath_;
@@ -209,6 +271,10 @@ class NaClBrowser {
   ValidationCacheType validation_cache_;
 
   std::string validator_cache_key_;
+  bool validator_cache_key_used_;
+
+  bool validation_cache_load_requested_;
+  bool validation_cache_write_pending_;
 
   DISALLOW_COPY_AND_ASSIGN(NaClBrowser);
 };
@@ -252,6 +318,90 @@ void NaClBrowser::SetKnownToValidate(const std::string& signature) {
   // validation failures and successful validations where stubout occurs.
   // Bucket zero is reserved for future use.
   UMA_HISTOGRAM_ENUMERATION("NaCl.ValidationCache.Set", 1, 2);
+
+  if (!validation_cache_write_pending_) {
+    validation_cache_write_pending_ = true;
+    BrowserThread::PostDelayedTask(
+        BrowserThread::IO, FROM_HERE,
+        base::Bind(&NaClBrowser::DoWriteValidationCache),
+        base::TimeDelta::FromSeconds(kValidationCacheWriteDelaySeconds));
+  }
+}
+
+void NaClBrowser::EnsureValidationCacheAvailable() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  if (validation_cache_load_requested_)
+    return;
+  validation_cache_load_requested_ = true;
+
+  // The singleton is only destroyed at exit, after the IO thread has stopped.
+  std::string* contents = new std::string;
+  BrowserThread::PostTaskAndReply(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&ReadValidationCacheFile, GetValidationCacheFilePath(),
+                 contents),
+      base::Bind(&NaClBrowser::OnValidationCacheRead, base::Unretained(this),
+                 base::Owned(contents)));
+}
+
+void NaClBrowser::OnValidationCacheRead(const std::string* contents) {
+  if (contents->empty() || validator_cache_key_used_)
+    return;
+
+  Pickle pickle(contents->data(), static_cast<int>(contents->size()));
+  PickleIterator iter(pickle);
+  int version;
+  std::string key;
+  int count;
+  if (!pickle.ReadInt(&iter, &version) ||
+      version != kValidationCacheFileVersion ||
+      !pickle.ReadString(&iter, &key) ||
+      !pickle.ReadInt(&iter, &count) ||
+      count < 0) {
+    LOG(WARNING) << "Ignoring malformed NaCl validation cache";
+    return;
+  }
+
+  // Entries are stored least recently used first, so putting them back in
+  // order restores the MRU order.
+  ValidationCacheType validation_cache(kValidationCacheSize);
+  for (int i = 0; i < count; ++i) {
+    std::string signature;
+    if (!pickle.ReadString(&iter, &signature)) {
+      LOG(WARNING) << "Ignoring malformed NaCl validation cache";
+      return;
+    }
+    validation_cache.Put(signature, true);
+  }
+
+  validator_cache_key_ = key;
+  validation_cache_.Clear();
+  for (ValidationCacheType::reverse_iterator it = validation_cache.rbegin();
+       it != validation_cache.rend(); ++it) {
+    validation_cache_.Put(it->first, it->second);
+  }
+}
+
+void NaClBrowser::WriteValidationCache() {
+  validation_cache_write_pending_ = false;
+  FilePath path = GetValidationCacheFilePath();
+  if (path.empty())
+    return;
+
+  Pickle pickle;
+  pickle.WriteInt(kValidationCacheFileVersion);
+  pickle.WriteString(validator_cache_key_);
+  pickle.WriteInt(static_cast<int>(validation_cache_.size()));
+  for (ValidationCacheType::reverse_iterator it = validation_cache_.rbegin();
+       it != validation_cache_.rend(); ++it) {
+    pickle.WriteString(it->first);
+  }
+
+  BrowserThread::PostTask(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&WriteValidationCacheFile, path,
+                 std::string(static_cast<const char*>(pickle.data()),
+                             pickle.size())));
 }
 
 void NaClBrowser::InitIrtFilePath() {
@@ -381,6 +531,10 @@ void NaClProcessHost::EarlyStartup() {
   // under us by autoupdate.
   NaClBrowser::GetInstance()->EnsureIrtAvailable();
 #endif
+  // The validation cache is only touched on the IO thread.
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::Bind(&NaClBrowser::DoEnsureValidationCacheAvailable));
 }
 
 void NaClProcessHost::Launch(
@@ -407,6 +561,8 @@ void NaClProcessHost::Launch(
     delete this;
     return;
   }
+  // Likewise read the validation cache while the process starts up.
+  NaClBrowser::GetInstance()->EnsureValidationCacheAvailable();
 
   // Rather than creating a socket pair in the renderer, and passing
   // one side through the browser to sel_ldr, socket pairs are created
@@ -0,0 +1,118 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/cert_verifier_cache_persister.h"
+
+#include "base/bind.h"
+#include "base/file_path.h"
+#include "base/file_util.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::BrowserThread;
+
+namespace {
+
+const FilePath::CharType kCertVerifierCacheFilename[] =
+    FILE_PATH_LITERAL("Certificate Verification Cache");
+
+}  // namespace
+
+class CertVerifierCachePersister::Loader {
+ public:
+  Loader(const base::WeakPtr<CertVerifierCachePersister>& persister,
+         const FilePath& path)
+      : persister_(persister),
+        path_(path),
+        state_valid_(false) {
+  }
+
+  void Load() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
+    state_valid_ = file_util::ReadFileToString(path_, &state_);
+  }
+
+  void CompleteLoad() {
+    DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+    // Make sure we're deleted.
+    scoped_ptr<Loader> deleter(this);
+
+    if (!persister_)
+      return;
+    persister_->CompleteLoad(state_valid_ ? &state_ : NULL);
+  }
+
+ private:
+  base::WeakPtr<CertVerifierCachePersister> persister_;
+
+  FilePath path_;
+
+  std::string state_;
+  bool state_valid_;
+
+  DISALLOW_COPY_AND_ASSIGN(Loader);
+};
+
+CertVerifierCachePersister::CertVerifierCachePersister(
+    net::MultiThreadedCertVerifier* verifier,
+    const FilePath& user_data_dir)
+    : verifier_(verifier),
+      writer_(user_data_dir.Append(kCertVerifierCacheFilename),
+              BrowserThread::GetMessageLoopProxyForThread(BrowserThread::FILE)),
+      loaded_(false),
+      dirty_(false),
+      weak_ptr_factory_(ALLOW_THIS_IN_INITIALIZER_LIST(this)) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  verifier_->SetDelegate(this);
+
+  Loader* loader = new Loader(weak_ptr_factory_.GetWeakPtr(), writer_.path());
+  BrowserThread::PostTaskAndReply(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&Loader::Load, base::Unretained(loader)),
+      base::Bind(&Loader::CompleteLoad, base::Unretained(loader)));
+}
+
+CertVerifierCachePersister::~CertVerifierCachePersister() {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+
+  verifier_->SetDelegate(NULL);
+}
+
+void CertVerifierCachePersister::CacheIsDirty(
+    net::MultiThreadedCertVerifier* verifier) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  DCHECK_EQ(verifier_, verifier);
+
+  if (!loaded_) {
+    dirty_ = true;
+    return;
+  }
+  writer_.ScheduleWrite(this);
+}
+
+bool CertVerifierCachePersister::SerializeData(std::string* output) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  verifier_->SerializeCache(output);
+  return true;
+}
+
+void CertVerifierCachePersister::CompleteLoad(const std::string* serialized) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+
+  loaded_ = true;
+  if (serialized && !verifier_->LoadCache(*serialized)) {
+    // Replace the unreadable file with the results we have.
+    LOG(WARNING) << "Failed to load the certificate verification cache";
+    dirty_ = true;
+  }
+  if (dirty_)
+    writer_.ScheduleWrite(this);
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// CertVerifierCachePersister keeps the certificate verification results of a
+// MultiThreadedCertVerifier on disk, so that the first connections after a
+// restart don't have to verify the same certificate chains again.
+//
+// The results are loaded on the file thread at startup and added to the
+// verifier's cache when they arrive; until then, the verifier works as if
+// nothing was saved. When the verifier reports that its cache changed, a
+// write is scheduled with ImportantFileWriter, which batches the changes.
+
+#ifndef CHROME_BROWSER_NET_CERT_VERIFIER_CACHE_PERSISTER_H_
+#define CHROME_BROWSER_NET_CERT_VERIFIER_CACHE_PERSISTER_H_
+#pragma once
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "base/memory/weak_ptr.h"
+#include "chrome/common/important_file_writer.h"
+#include "net/base/multi_threaded_cert_verifier.h"
+
+class FilePath;
+
+// Reads and updates the on-disk cache of a MultiThreadedCertVerifier.
+// Must be created, used and destroyed only on the IO thread, before the
+// verifier is destroyed.
+class CertVerifierCachePersister
+    : public net::MultiThreadedCertVerifier::Delegate,
+      public ImportantFileWriter::DataSerializer {
+ public:
+  CertVerifierCachePersister(net::MultiThreadedCertVerifier* verifier,
+                             const FilePath& user_data_dir);
+  virtual ~CertVerifierCachePersister();
+
+  // net::MultiThreadedCertVerifier::Delegate:
+  virtual void CacheIsDirty(net::MultiThreadedCertVerifier* verifier) OVERRIDE;
+
+  // ImportantFileWriter::DataSerializer:
+  virtual bool SerializeData(std::string* data) OVERRIDE;
+
+ private:
+  class Loader;
+
+  // Called with the contents of the file, or NULL if it couldn't be read.
+  void CompleteLoad(const std::string* serialized);
+
+  net::MultiThreadedCertVerifier* verifier_;
+
+  // Helper for safely writing the data.
+  ImportantFileWriter writer_;
+
+  // Writes are held back until the saved results have been loaded, so that
+  // they aren't overwritten.
+  bool loaded_;
+  bool dirty_;
+
+  base::WeakPtrFactory<CertVerifierCachePersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(CertVerifierCachePersister);
+};
+
+#endif  // CHROME_BROWSER_NET_CERT_VERIFIER_CACHE_PERSISTER_H_
@@ -204,4 +204,10 @@ bool CRLSetFetcher::Install(base::DictionaryValue* manifest,
   return true;
 }
 
+bool CRLSetFetcher::GetInstalledFile(
+    const std::string& file, FilePath* installed_file) {
+  // CRL sets carry their own delta format inside the full CRX.
+  return false;
+}
+
 CRLSetFetcher::~CRLSetFetcher() {}
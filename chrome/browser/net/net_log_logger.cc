@@ -6,10 +6,11 @@
 
 #include <stdio.h>
 
+#include "base/bind.h"
 #include "base/file_util.h"
 #include "base/json/json_writer.h"
 #include "base/logging.h"
-#include "base/memory/scoped_ptr.h"
+#include "base/threading/thread.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/values.h"
 #include "chrome/browser/ui/webui/net_internals/net_internals_ui.h"
@@ -27,10 +28,20 @@ NetLogLogger::NetLogLogger(const FilePath &log_path) {
     base::JSONWriter::Write(value.get(), &json);
     fprintf(file_.get(), "{\"constants\": %s,\n", json.c_str());
     fprintf(file_.get(), "\"events\": [\n");
+
+    write_thread_.reset(new base::Thread("NetLogLogger"));
+    if (!write_thread_->Start())
+      write_thread_.reset();
   }
 }
 
 NetLogLogger::~NetLogLogger() {
+  if (write_thread_.get()) {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    // Runs any pending write before returning.
+    write_thread_->Stop();
+  }
+  WritePendingEntries();
 }
 
 void NetLogLogger::StartObserving(net::NetLog* net_log) {
@@ -42,18 +53,51 @@ void NetLogLogger::OnAddEntry(net::NetLog::EventType type,
                               const net::NetLog::Source& source,
                               net::NetLog::EventPhase phase,
                               net::NetLog::EventParameters* params) {
+  if (!file_.get() && !VLOG_IS_ON(1))
+    return;
+
   scoped_ptr<Value> value(
       net::NetLog::EntryToDictionaryValue(
           type, time, source, phase, params, false));
-  // Don't pretty print, so each JSON value occupies a single line, with no
-  // breaks (Line breaks in any text field will be escaped).  Using strings
-  // instead of integer identifiers allows logs from older versions to be
-  // loaded, though a little extra parsing has to be done when loading a log.
-  std::string json;
-  base::JSONWriter::Write(value.get(), &json);
   if (!file_.get()) {
+    std::string json;
+    base::JSONWriter::Write(value.get(), &json);
     VLOG(1) << json;
+    return;
+  }
+
+  {
+    base::AutoLock lock(lock_);
+    bool write_scheduled = !pending_entries_.empty();
+    pending_entries_.push_back(value.release());
+    if (write_scheduled)
+      return;
+  }
+
+  if (write_thread_.get()) {
+    write_thread_->message_loop()->PostTask(
+        FROM_HERE,
+        base::Bind(&NetLogLogger::WritePendingEntries,
+                   base::Unretained(this)));
   } else {
+    WritePendingEntries();
+  }
+}
+
+void NetLogLogger::WritePendingEntries() {
+  ScopedVector<Value> entries;
+  {
+    base::AutoLock lock(lock_);
+    entries.swap(pending_entries_);
+  }
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    // Don't pretty print, so each JSON value occupies a single line, with no
+    // breaks (Line breaks in any text field will be escaped).  Using strings
+    // instead of integer identifiers allows logs from older versions to be
+    // loaded, though a little extra parsing has to be done when loading a log.
+    std::string json;
+    base::JSONWriter::Write(entries[i], &json);
     fprintf(file_.get(), "%s,\n", json.c_str());
   }
 }
@@ -7,10 +7,18 @@
 #pragma once
 
 #include "base/memory/scoped_handle.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/synchronization/lock.h"
 #include "net/base/net_log.h"
 
 class FilePath;
 
+namespace base {
+class Thread;
+class Value;
+}
+
 // NetLogLogger watches the NetLog event stream, and sends all entries to
 // VLOG(1) or a path specified on creation.  This is to debug errors that
 // prevent getting to the about:net-internals page.
@@ -19,6 +27,11 @@ class FilePath;
 // contain a single JSON object, with an extra comma on the end and missing
 // a terminal "]}".
 //
+// Entries written to a file are serialized and written in batches on a
+// thread owned by the logger, so that logging doesn't slow down the threads
+// that add the entries, typically the IO thread.  Entries still pending when
+// the logger is destroyed are written out before the destructor returns.
+//
 // Relies on ChromeNetLog only calling an Observer once at a time for
 // thread-safety.
 class NetLogLogger : public net::NetLog::ThreadSafeObserver {
@@ -41,8 +54,20 @@ class NetLogLogger : public net::NetLog::ThreadSafeObserver {
                           net::NetLog::EventParameters* params) OVERRIDE;
 
  private:
+  // Writes out all of |pending_entries_|.  Called on |write_thread_|, if
+  // there is one, and on destruction once the thread has been stopped.
+  void WritePendingEntries();
+
   ScopedStdioHandle file_;
 
+  // Only created when writing to |file_|.
+  scoped_ptr<base::Thread> write_thread_;
+
+  // Entries that have yet to be written to |file_|.  A task to write them is
+  // posted when the first one is added.  Protected by |lock_|.
+  ScopedVector<base::Value> pending_entries_;
+  base::Lock lock_;
+
   DISALLOW_COPY_AND_ASSIGN(NetLogLogger);
 };
 
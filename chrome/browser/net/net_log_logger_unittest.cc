@@ -0,0 +1,57 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/net_log_logger.h"
+
+#include <string>
+
+#include "base/file_path.h"
+#include "base/file_util.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/scoped_temp_dir.h"
+#include "base/string_util.h"
+#include "base/time.h"
+#include "net/base/net_log.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kEvents = 1000;
+
+// Makes sure that entries queued for the write thread are all in the file by
+// the time the logger is destroyed, in the order they were added.
+TEST(NetLogLoggerTest, WritesPendingEntriesOnDestruction) {
+  ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  FilePath log_path = temp_dir.path().AppendASCII("net_log.json");
+
+  scoped_ptr<NetLogLogger> logger(new NetLogLogger(log_path));
+  for (int i = 0; i < kEvents; ++i) {
+    net::NetLog::Source source(net::NetLog::SOURCE_NONE, i);
+    logger->OnAddEntry(net::NetLog::TYPE_CANCELLED, base::TimeTicks::Now(),
+                       source, net::NetLog::PHASE_NONE, NULL);
+  }
+  logger.reset();
+
+  std::string log;
+  ASSERT_TRUE(file_util::ReadFileToString(log_path, &log));
+  size_t events_start = log.find("\"events\": [\n");
+  ASSERT_NE(std::string::npos, events_start);
+
+  // One line per entry.
+  std::string events = log.substr(events_start);
+  size_t lines = 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+    if (events[i] == '\n')
+      ++lines;
+  }
+  EXPECT_EQ(static_cast<size_t>(kEvents + 1), lines);
+  EXPECT_TRUE(EndsWith(log, "},\n", true));
+
+  // The last entry added is the last one written.
+  std::string last_line = events.substr(events.rfind('\n', events.size() - 2));
+  EXPECT_NE(std::string::npos, last_line.find("\"id\":999"));
+}
+
+}  // namespace
@@ -99,8 +99,10 @@ class Predictor::LookupRequest {
 
     // Make a note that this is a speculative resolve request. This allows us
     // to separate it from real navigations in the observer's callback, and
-    // lets the HostResolver know it can de-prioritize it.
+    // lets the HostResolver know it can de-prioritize it. At IDLE priority
+    // it can't take the jobs the HostResolver reserves for real requests.
     resolve_info.set_is_speculative(true);
+    resolve_info.set_priority(net::IDLE);
     return resolver_.Resolve(
         resolve_info, &addresses_,
         base::Bind(&LookupRequest::OnLookupFinished, base::Unretained(this)),
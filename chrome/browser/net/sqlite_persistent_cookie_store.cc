@@ -40,10 +40,10 @@ using content::BrowserThread;
 // SQLitePersistentCookieStore::Load is called to load all cookies.  It
 // delegates to Backend::Load, which posts a Backend::LoadAndNotifyOnDBThread
 // task to the DB thread.  This task calls Backend::ChainLoadCookies(), which
-// repeatedly posts itself to the DB thread to load each eTLD+1's cookies in
-// separate tasks.  When this is complete, Backend::CompleteLoadOnIOThread is
-// posted to the IO thread, which notifies the caller of
-// SQLitePersistentCookieStore::Load that the load is complete.
+// repeatedly posts itself to the DB thread to load a few eTLD+1s' cookies per
+// task, so that priority loads can run in between.  When this is complete,
+// Backend::CompleteLoadOnIOThread is posted to the IO thread, which notifies
+// the caller of SQLitePersistentCookieStore::Load that the load is complete.
 //
 // If a priority load request is invoked via SQLitePersistentCookieStore::
 // LoadCookiesForKey, it is delegated to Backend::LoadCookiesForKey, which posts
@@ -250,6 +250,11 @@ class SQLitePersistentCookieStore::Backend
 static const int kCurrentVersionNumber = 5;
 static const int kCompatibleVersionNumber = 5;
 
+// Number of domain keys (eTLD+1) whose cookies each background chain-load task
+// reads. Loading several keys per task saves a DB thread round trip per key,
+// while keeping a priority load queued behind it from waiting too long.
+static const size_t kDomainKeysPerChainLoad = 10;
+
 namespace {
 
 // Increments a specified TimeDelta by the duration between this object's
@@ -352,7 +357,11 @@ void SQLitePersistentCookieStore::Backend::LoadAndNotifyOnDBThread(
       base::Bind(&SQLitePersistentCookieStore::Backend::CompleteLoadOnIOThread,
                  this, loaded_callback, false));
   } else {
-    ChainLoadCookies(loaded_callback);
+    // Start the chain-load in a task of its own so that priority loads posted
+    // while the database was being initialized are served first.
+    BrowserThread::PostTask(
+      BrowserThread::DB, FROM_HERE,
+      base::Bind(&Backend::ChainLoadCookies, this, loaded_callback));
   }
 }
 
@@ -479,6 +488,7 @@ bool SQLitePersistentCookieStore::Backend::InitializeDatabase() {
   }
 
   db_.reset(new sql::Connection);
+  db_->set_histogram_tag("Cookie");
   if (!db_->Open(path_)) {
     NOTREACHED() << "Unable to open cookie DB.";
     db_.reset();
@@ -544,12 +554,15 @@ void SQLitePersistentCookieStore::Backend::ChainLoadCookies(
   if (!db_.get()) {
     // Close() has been called on this store.
     load_success = false;
-  } else if (keys_to_load_.size() > 0) {
-    // Load cookies for the first domain key.
-    std::map<std::string, std::set<std::string> >::iterator
-      it = keys_to_load_.begin();
-    load_success = LoadCookiesForDomains(it->second);
-    keys_to_load_.erase(it);
+  } else {
+    // Load cookies for the next few domain keys.
+    for (size_t i = 0; load_success && i < kDomainKeysPerChainLoad &&
+         keys_to_load_.size() > 0; ++i) {
+      std::map<std::string, std::set<std::string> >::iterator
+        it = keys_to_load_.begin();
+      load_success = LoadCookiesForDomains(it->second);
+      keys_to_load_.erase(it);
+    }
   }
 
   // If load is successful and there are more domain keys to be loaded,
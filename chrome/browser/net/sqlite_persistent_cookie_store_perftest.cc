@@ -114,3 +114,18 @@ TEST_F(SQLitePersistentCookieStorePerfTest, TestLoadPerformance) {
 
   ASSERT_EQ(15000U, cookies_.size());
 }
+
+// Test the performance of a priority load for a specific domain key issued
+// while the background load of all cookies is still in progress.
+TEST_F(SQLitePersistentCookieStorePerfTest, TestLoadForKeyWhileLoading) {
+  store_->Load(base::Bind(&SQLitePersistentCookieStorePerfTest::OnLoaded,
+                          base::Unretained(this)));
+  PerfTimeLogger timer("Load cookies for an eTLD+1 during the full load");
+  store_->LoadCookiesForKey("domain_299.com",
+    base::Bind(&SQLitePersistentCookieStorePerfTest::OnKeyLoaded,
+               base::Unretained(this)));
+  key_loaded_event_.Wait();
+  timer.Done();
+
+  loaded_event_.Wait();
+}
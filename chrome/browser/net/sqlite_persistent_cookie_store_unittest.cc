@@ -244,7 +244,7 @@ TEST_F(SQLitePersistentCookieStoreTest, TestLoadCookiesForKey) {
   // (active:)
   // 1. Wait (on db_event)
   // (pending:)
-  // 2. "Init And Chain-Load First Domain"
+  // 2. "Init", which posts the chain-load behind the tasks below
   // 3. Priority Load (aaa.com)
   // 4. Wait (on db_event)
   db_thread_event_.Signal();
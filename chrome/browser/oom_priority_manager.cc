@@ -135,6 +135,7 @@ void OomMemoryDetails::OnDetailsAvailable() {
 OomPriorityManager::TabStats::TabStats()
   : is_pinned(false),
     is_selected(false),
+    is_discarded(false),
     renderer_handle(0),
     sudden_termination_allowed(false),
     tab_contents_id(0) {
@@ -208,10 +209,13 @@ bool OomPriorityManager::DiscardTab() {
   TabStatsList stats = GetTabStatsOnUIThread();
   if (stats.empty())
     return false;
-  // Loop until we find a non-discarded tab to kill.
+  // Loop until we find a non-discarded tab to kill. Skip the discarded ones
+  // here, as DiscardTabById walks every tab looking for the one to discard.
   for (TabStatsList::const_reverse_iterator stats_rit = stats.rbegin();
        stats_rit != stats.rend();
        ++stats_rit) {
+    if (stats_rit->is_discarded)
+      continue;
     int64 least_important_tab_id = stats_rit->tab_contents_id;
     if (DiscardTabById(least_important_tab_id))
       return true;
@@ -301,8 +305,8 @@ int OomPriorityManager::GetTabCount() const {
 
 // Returns true if |first| is considered less desirable to be killed
 // than |second|.
-bool OomPriorityManager::CompareTabStats(TabStats first,
-                                         TabStats second) {
+bool OomPriorityManager::CompareTabStats(const TabStats& first,
+                                         const TabStats& second) {
   // Being currently selected is most important.
   if (first.is_selected != second.is_selected)
     return first.is_selected == true;
@@ -436,6 +440,7 @@ OomPriorityManager::TabStatsList OomPriorityManager::GetTabStatsOnUIThread() {
         TabStats stats;
         stats.is_pinned = model->IsTabPinned(i);
         stats.is_selected = model->IsTabSelected(i);
+        stats.is_discarded = model->IsTabDiscarded(i);
         stats.last_selected = contents->GetLastSelectedTime();
         stats.renderer_handle = contents->GetRenderProcessHost()->GetHandle();
         stats.sudden_termination_allowed =
@@ -63,6 +63,7 @@ class OomPriorityManager : public content::NotificationObserver {
     ~TabStats();
     bool is_pinned;
     bool is_selected;
+    bool is_discarded;
     base::TimeTicks last_selected;
     base::ProcessHandle renderer_handle;
     bool sudden_termination_allowed;
@@ -96,7 +97,7 @@ class OomPriorityManager : public content::NotificationObserver {
   // Sets the score of the focused tab to the least value.
   void AdjustFocusedTabScoreOnFileThread();
 
-  static bool CompareTabStats(TabStats first, TabStats second);
+  static bool CompareTabStats(const TabStats& first, const TabStats& second);
 
   virtual void Observe(int type,
                        const content::NotificationSource& source,
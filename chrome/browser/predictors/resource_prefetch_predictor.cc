@@ -0,0 +1,392 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/predictors/resource_prefetch_predictor.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/metrics/histogram.h"
+#include "base/stl_util.h"
+#include "chrome/browser/history/history_notifications.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/common/chrome_notification_types.h"
+#include "chrome/common/chrome_switches.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/navigation_entry.h"
+#include "content/public/browser/notification_details.h"
+#include "content/public/browser/notification_service.h"
+#include "content/public/browser/notification_source.h"
+#include "content/public/browser/notification_types.h"
+#include "content/public/browser/resource_request_info.h"
+#include "content/public/common/url_constants.h"
+#include "content/public/common/url_fetcher.h"
+#include "net/base/load_flags.h"
+#include "net/http/http_response_headers.h"
+#include "net/url_request/url_request.h"
+
+using content::BrowserThread;
+
+namespace {
+
+// A subresource is prefetched if the page loaded it on at least this fraction
+// of its visits...
+const double kMinConfidenceToPrefetch = 0.7;
+// ...and forgotten once the page loads it on fewer than this fraction.
+const double kMinConfidenceToKeep = 0.2;
+
+const size_t kMaxResourcesPerPage = 100;
+const size_t kMaxPrefetchesPerNavigation = 25;
+const size_t kMaxUrlsToTrack = 500;
+const size_t kMaxHostsToTrack = 200;
+
+// A navigation whose load hasn't stopped after this long is dropped without
+// learning from it.
+const int kMaxNavigationLifetimeSeconds = 60;
+
+bool IsHandledScheme(const GURL& url) {
+  return url.SchemeIs(chrome::kHttpScheme) || url.SchemeIs(chrome::kHttpsScheme);
+}
+
+bool IsHandledSubresourceType(ResourceType::Type resource_type) {
+  switch (resource_type) {
+    case ResourceType::STYLESHEET:
+    case ResourceType::SCRIPT:
+    case ResourceType::IMAGE:
+    case ResourceType::FONT_RESOURCE:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+bool IsCacheable(net::URLRequest* response) {
+  const net::HttpResponseHeaders* headers = response->response_headers();
+  return !headers ||
+      (!headers->HasHeaderValue("cache-control", "no-store") &&
+       !headers->HasHeaderValue("cache-control", "no-cache"));
+}
+
+bool ConfidenceGreater(const ResourcePrefetchPredictorTables::Row& lhs,
+                       const ResourcePrefetchPredictorTables::Row& rhs) {
+  return lhs.GetConfidence() > rhs.GetConfidence();
+}
+
+}  // namespace
+
+ResourcePrefetchPredictor::Navigation::Navigation() {
+}
+
+ResourcePrefetchPredictor::Navigation::~Navigation() {
+}
+
+ResourcePrefetchPredictor::ResourcePrefetchPredictor(Profile* profile)
+    : profile_(profile),
+      tables_(new ResourcePrefetchPredictorTables(profile)),
+      initialized_(false) {
+  BrowserThread::PostTask(BrowserThread::DB, FROM_HERE,
+      base::Bind(&ResourcePrefetchPredictorTables::Initialize, tables_));
+
+  Rows* rows = new Rows();
+  BrowserThread::PostTaskAndReply(
+      BrowserThread::DB, FROM_HERE,
+      base::Bind(&ResourcePrefetchPredictorTables::GetAllRows, tables_, rows),
+      base::Bind(&ResourcePrefetchPredictor::CreateCaches, AsWeakPtr(),
+                 base::Owned(rows)));
+}
+
+ResourcePrefetchPredictor::~ResourcePrefetchPredictor() {
+  STLDeleteValues(&inflight_prefetches_);
+}
+
+// static
+bool ResourcePrefetchPredictor::IsEnabled() {
+  return CommandLine::ForCurrentProcess()->HasSwitch(
+      switches::kEnableSpeculativeResourcePrefetching);
+}
+
+// static
+bool ResourcePrefetchPredictor::ShouldRecordRequest(
+    net::URLRequest* request,
+    ResourceType::Type resource_type) {
+  return resource_type == ResourceType::MAIN_FRAME &&
+      request->method() == "GET" && IsHandledScheme(request->url());
+}
+
+// static
+bool ResourcePrefetchPredictor::ShouldRecordResponse(
+    net::URLRequest* response) {
+  const content::ResourceRequestInfo* info =
+      content::ResourceRequestInfo::ForRequest(response);
+  if (!info || response->method() != "GET" ||
+      !IsHandledScheme(response->url())) {
+    return false;
+  }
+
+  if (info->GetResourceType() == ResourceType::MAIN_FRAME)
+    return true;
+  return IsHandledSubresourceType(info->GetResourceType()) &&
+      IsCacheable(response);
+}
+
+void ResourcePrefetchPredictor::OnMainFrameRequest(const GURL& main_frame_url) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (!initialized_)
+    return;
+
+  StartPrefetching(main_frame_url);
+}
+
+void ResourcePrefetchPredictor::OnMainFrameResponse(
+    const GURL& main_frame_url) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  if (!initialized_)
+    return;
+
+  RemoveAbandonedNavigations();
+
+  Navigation& navigation = inflight_navigations_[main_frame_url];
+  navigation.start_time = base::TimeTicks::Now();
+  navigation.resources.clear();
+}
+
+void ResourcePrefetchPredictor::OnSubresourceResponse(
+    const GURL& main_frame_url,
+    const GURL& resource_url,
+    ResourceType::Type resource_type) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+
+  NavigationMap::iterator it = inflight_navigations_.find(main_frame_url);
+  if (it == inflight_navigations_.end() ||
+      it->second.resources.size() >= kMaxResourcesPerPage) {
+    return;
+  }
+  it->second.resources.insert(std::make_pair(resource_url, resource_type));
+}
+
+void ResourcePrefetchPredictor::Shutdown() {
+  tables_->OnPredictorDestroyed();
+  STLDeleteValues(&inflight_prefetches_);
+}
+
+void ResourcePrefetchPredictor::Observe(
+    int type,
+    const content::NotificationSource& source,
+    const content::NotificationDetails& details) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+
+  switch (type) {
+    case content::NOTIFICATION_LOAD_STOP: {
+      const content::NavigationController* controller =
+          content::Source<content::NavigationController>(source).ptr();
+      if (controller->GetBrowserContext() != profile_)
+        break;
+      const content::NavigationEntry* entry =
+          controller->GetLastCommittedEntry();
+      if (entry)
+        OnNavigationComplete(entry->GetURL());
+      break;
+    }
+
+    case chrome::NOTIFICATION_HISTORY_URLS_DELETED: {
+      const content::Details<const history::URLsDeletedDetails>
+          urls_deleted_details =
+              content::Details<const history::URLsDeletedDetails>(details);
+      if (urls_deleted_details->all_history)
+        DeleteAllRows();
+      else
+        DeleteRowsWithURLs(urls_deleted_details->rows);
+      break;
+    }
+
+    default:
+      NOTREACHED() << "Unexpected notification observed.";
+      break;
+  }
+}
+
+void ResourcePrefetchPredictor::OnURLFetchComplete(
+    const content::URLFetcher* source) {
+  // The response is now in the HTTP cache; the body itself isn't needed.
+  for (std::map<GURL, content::URLFetcher*>::iterator it =
+           inflight_prefetches_.begin();
+       it != inflight_prefetches_.end(); ++it) {
+    if (it->second == source) {
+      delete it->second;
+      inflight_prefetches_.erase(it);
+      return;
+    }
+  }
+  NOTREACHED();
+}
+
+void ResourcePrefetchPredictor::CreateCaches(Rows* rows) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  DCHECK(!initialized_);
+
+  for (Rows::const_iterator it = rows->begin(); it != rows->end(); ++it) {
+    PageCacheMap* cache =
+        it->key_type == ResourcePrefetchPredictorTables::KEY_TYPE_HOST ?
+            &host_cache_ : &url_cache_;
+    (*cache)[it->main_page_key].push_back(*it);
+  }
+
+  UMA_HISTOGRAM_COUNTS("ResourcePrefetchPredictor.UrlTableMainFrameUrlCount",
+                       url_cache_.size());
+  UMA_HISTOGRAM_COUNTS("ResourcePrefetchPredictor.HostTableHostCount",
+                       host_cache_.size());
+
+  notification_registrar_.Add(this, content::NOTIFICATION_LOAD_STOP,
+                              content::NotificationService::AllSources());
+  notification_registrar_.Add(this, chrome::NOTIFICATION_HISTORY_URLS_DELETED,
+                              content::Source<Profile>(profile_));
+  initialized_ = true;
+}
+
+void ResourcePrefetchPredictor::OnNavigationComplete(
+    const GURL& main_frame_url) {
+  NavigationMap::iterator it = inflight_navigations_.find(main_frame_url);
+  if (it == inflight_navigations_.end())
+    return;
+
+  LearnNavigation(main_frame_url.spec(),
+                  ResourcePrefetchPredictorTables::KEY_TYPE_URL,
+                  it->second.resources, kMaxUrlsToTrack, &url_cache_);
+  LearnNavigation(main_frame_url.host(),
+                  ResourcePrefetchPredictorTables::KEY_TYPE_HOST,
+                  it->second.resources, kMaxHostsToTrack, &host_cache_);
+  inflight_navigations_.erase(it);
+}
+
+void ResourcePrefetchPredictor::RemoveAbandonedNavigations() {
+  const base::TimeTicks cutoff = base::TimeTicks::Now() -
+      base::TimeDelta::FromSeconds(kMaxNavigationLifetimeSeconds);
+  for (NavigationMap::iterator it = inflight_navigations_.begin();
+       it != inflight_navigations_.end();) {
+    if (it->second.start_time < cutoff)
+      inflight_navigations_.erase(it++);
+    else
+      ++it;
+  }
+}
+
+void ResourcePrefetchPredictor::LearnNavigation(
+    const std::string& main_page_key,
+    ResourcePrefetchPredictorTables::KeyType key_type,
+    const ResourceMap& resources,
+    size_t max_pages,
+    PageCacheMap* cache) {
+  PageCacheMap::iterator cache_it = cache->find(main_page_key);
+  if (cache_it == cache->end() && cache->size() >= max_pages) {
+    // Make room by forgetting the page that was visited the longest ago.
+    PageCacheMap::iterator oldest = cache->begin();
+    for (PageCacheMap::iterator it = cache->begin(); it != cache->end(); ++it) {
+      if (it->second.front().last_visit < oldest->second.front().last_visit)
+        oldest = it;
+    }
+    BrowserThread::PostTask(BrowserThread::DB, FROM_HERE,
+        base::Bind(&ResourcePrefetchPredictorTables::DeleteRowsForKeys,
+                   tables_, std::vector<std::string>(1, oldest->first),
+                   key_type));
+    cache->erase(oldest);
+  }
+
+  const base::Time now = base::Time::Now();
+  ResourceMap new_resources(resources);
+  Rows rows;
+  if (cache_it != cache->end()) {
+    for (Rows::const_iterator it = cache_it->second.begin();
+         it != cache_it->second.end(); ++it) {
+      Row row(*it);
+      if (new_resources.erase(row.resource_url))
+        ++row.number_of_hits;
+      else
+        ++row.number_of_misses;
+      row.last_visit = now;
+      if (row.GetConfidence() >= kMinConfidenceToKeep)
+        rows.push_back(row);
+    }
+  }
+  for (ResourceMap::const_iterator it = new_resources.begin();
+       it != new_resources.end() && rows.size() < kMaxResourcesPerPage; ++it) {
+    rows.push_back(Row(main_page_key, key_type, it->first, it->second, 1, 0,
+                       now));
+  }
+
+  if (rows.empty()) {
+    if (cache_it != cache->end())
+      cache->erase(cache_it);
+  } else {
+    (*cache)[main_page_key] = rows;
+  }
+  BrowserThread::PostTask(BrowserThread::DB, FROM_HERE,
+      base::Bind(&ResourcePrefetchPredictorTables::UpdateRowsForKey, tables_,
+                 main_page_key, key_type, rows));
+}
+
+void ResourcePrefetchPredictor::StartPrefetching(const GURL& main_frame_url) {
+  // Prefer what was learned for this exact page, and fall back to what other
+  // pages on the same host load.
+  PageCacheMap::const_iterator cache_it = url_cache_.find(main_frame_url.spec());
+  if (cache_it == url_cache_.end()) {
+    cache_it = host_cache_.find(main_frame_url.host());
+    if (cache_it == host_cache_.end())
+      return;
+  }
+
+  Rows rows(cache_it->second);
+  std::stable_sort(rows.begin(), rows.end(), ConfidenceGreater);
+
+  size_t num_prefetches = 0;
+  for (Rows::const_iterator it = rows.begin();
+       it != rows.end() && num_prefetches < kMaxPrefetchesPerNavigation &&
+       it->GetConfidence() >= kMinConfidenceToPrefetch; ++it) {
+    if (inflight_prefetches_.count(it->resource_url))
+      continue;
+
+    content::URLFetcher* fetcher = content::URLFetcher::Create(
+        it->resource_url, content::URLFetcher::GET, this);
+    fetcher->SetRequestContext(profile_->GetRequestContext());
+    fetcher->SetLoadFlags(net::LOAD_PREFETCH);
+    inflight_prefetches_[it->resource_url] = fetcher;
+    fetcher->Start();
+    ++num_prefetches;
+  }
+  UMA_HISTOGRAM_COUNTS_100("ResourcePrefetchPredictor.PrefetchesStarted",
+                           static_cast<int>(num_prefetches));
+}
+
+void ResourcePrefetchPredictor::DeleteRowsWithURLs(
+    const history::URLRows& rows) {
+  std::vector<std::string> urls;
+  std::vector<std::string> hosts;
+  for (history::URLRows::const_iterator it = rows.begin(); it != rows.end();
+       ++it) {
+    const GURL& url = it->url();
+    if (url_cache_.erase(url.spec()))
+      urls.push_back(url.spec());
+    if (host_cache_.erase(url.host()))
+      hosts.push_back(url.host());
+  }
+
+  BrowserThread::PostTask(BrowserThread::DB, FROM_HERE,
+      base::Bind(&ResourcePrefetchPredictorTables::DeleteRowsForKeys, tables_,
+                 urls, ResourcePrefetchPredictorTables::KEY_TYPE_URL));
+  BrowserThread::PostTask(BrowserThread::DB, FROM_HERE,
+      base::Bind(&ResourcePrefetchPredictorTables::DeleteRowsForKeys, tables_,
+                 hosts, ResourcePrefetchPredictorTables::KEY_TYPE_HOST));
+}
+
+void ResourcePrefetchPredictor::DeleteAllRows() {
+  url_cache_.clear();
+  host_cache_.clear();
+  inflight_navigations_.clear();
+
+  BrowserThread::PostTask(BrowserThread::DB, FROM_HERE,
+      base::Bind(&ResourcePrefetchPredictorTables::DeleteAllRows, tables_));
+}
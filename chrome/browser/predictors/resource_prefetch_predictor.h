@@ -0,0 +1,144 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_PREDICTORS_RESOURCE_PREFETCH_PREDICTOR_H_
+#define CHROME_BROWSER_PREDICTORS_RESOURCE_PREFETCH_PREDICTOR_H_
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "base/memory/weak_ptr.h"
+#include "base/time.h"
+#include "chrome/browser/history/history_types.h"
+#include "chrome/browser/predictors/resource_prefetch_predictor_tables.h"
+#include "chrome/browser/profiles/profile_keyed_service.h"
+#include "content/public/browser/notification_observer.h"
+#include "content/public/browser/notification_registrar.h"
+#include "content/public/common/url_fetcher_delegate.h"
+#include "googleurl/src/gurl.h"
+#include "webkit/glue/resource_type.h"
+
+class Profile;
+
+namespace content {
+class URLFetcher;
+}
+
+namespace net {
+class URLRequest;
+}
+
+// Learns, for each top-level page URL and host, which subresources the page
+// loads, and warms the HTTP cache with the ones it loaded on most earlier
+// visits as soon as a new navigation to the page starts. The observations come
+// from ChromeResourceDispatcherHostDelegate on the IO thread; the predictor
+// itself lives on the UI thread and keeps an in-memory copy of its
+// ResourcePrefetchPredictorTables, which it updates asynchronously on the DB
+// thread. It can be accessed as a weak pointer so that it can safely use
+// PostTaskAndReply during initialization.
+class ResourcePrefetchPredictor
+    : public ProfileKeyedService,
+      public content::NotificationObserver,
+      public content::URLFetcherDelegate,
+      public base::SupportsWeakPtr<ResourcePrefetchPredictor> {
+ public:
+  explicit ResourcePrefetchPredictor(Profile* profile);
+  virtual ~ResourcePrefetchPredictor();
+
+  // Whether the predictor was enabled on the command line.
+  static bool IsEnabled();
+
+  // Called on the IO thread to decide whether the start of |request| or the
+  // response to |response| should be reported to the predictor.
+  static bool ShouldRecordRequest(net::URLRequest* request,
+                                  ResourceType::Type resource_type);
+  static bool ShouldRecordResponse(net::URLRequest* response);
+
+  // A navigation to |main_frame_url| is starting; prefetches the subresources
+  // that it is likely to load.
+  void OnMainFrameRequest(const GURL& main_frame_url);
+
+  // The response for the main frame |main_frame_url| started; subresources
+  // reported for it from now on are recorded until the load stops.
+  void OnMainFrameResponse(const GURL& main_frame_url);
+
+  // The page |main_frame_url| received the response for one of its
+  // subresources.
+  void OnSubresourceResponse(const GURL& main_frame_url,
+                             const GURL& resource_url,
+                             ResourceType::Type resource_type);
+
+ private:
+  typedef ResourcePrefetchPredictorTables::Row Row;
+  typedef ResourcePrefetchPredictorTables::Rows Rows;
+  typedef std::map<std::string, Rows> PageCacheMap;
+  typedef std::map<GURL, ResourceType::Type> ResourceMap;
+
+  // The subresources seen so far for a page that is loading.
+  struct Navigation {
+    Navigation();
+    ~Navigation();
+
+    base::TimeTicks start_time;
+    ResourceMap resources;
+  };
+  typedef std::map<GURL, Navigation> NavigationMap;
+
+  // ProfileKeyedService
+  virtual void Shutdown() OVERRIDE;
+
+  // NotificationObserver
+  virtual void Observe(int type,
+                       const content::NotificationSource& source,
+                       const content::NotificationDetails& details) OVERRIDE;
+
+  // URLFetcherDelegate
+  virtual void OnURLFetchComplete(const content::URLFetcher* source) OVERRIDE;
+
+  // Called to populate the local caches from the rows loaded from the
+  // database.
+  void CreateCaches(Rows* rows);
+
+  // Called when the load of |main_frame_url| stops; learns from the
+  // subresources it loaded.
+  void OnNavigationComplete(const GURL& main_frame_url);
+
+  // Drops navigations whose load never reported stopping.
+  void RemoveAbandonedNavigations();
+
+  // Updates the entry for |main_page_key| in |cache| and the database with the
+  // subresources a visit to the page loaded. Evicts the least recently visited
+  // page if a new page would grow |cache| beyond |max_pages|.
+  void LearnNavigation(const std::string& main_page_key,
+                       ResourcePrefetchPredictorTables::KeyType key_type,
+                       const ResourceMap& resources,
+                       size_t max_pages,
+                       PageCacheMap* cache);
+
+  // Starts prefetches for the subresources of |main_frame_url| that are likely
+  // to be needed.
+  void StartPrefetching(const GURL& main_frame_url);
+
+  // Removes the rows of every page whose URL or host is in |rows|.
+  void DeleteRowsWithURLs(const history::URLRows& rows);
+  void DeleteAllRows();
+
+  Profile* profile_;
+  scoped_refptr<ResourcePrefetchPredictorTables> tables_;
+  content::NotificationRegistrar notification_registrar_;
+
+  PageCacheMap url_cache_;
+  PageCacheMap host_cache_;
+  NavigationMap inflight_navigations_;
+
+  // Owned; keyed by the subresource being prefetched.
+  std::map<GURL, content::URLFetcher*> inflight_prefetches_;
+
+  bool initialized_;
+
+  DISALLOW_COPY_AND_ASSIGN(ResourcePrefetchPredictor);
+};
+
+#endif  // CHROME_BROWSER_PREDICTORS_RESOURCE_PREFETCH_PREDICTOR_H_
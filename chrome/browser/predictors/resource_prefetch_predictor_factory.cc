@@ -0,0 +1,37 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/predictors/resource_prefetch_predictor_factory.h"
+
+#include "chrome/browser/predictors/resource_prefetch_predictor.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/browser/profiles/profile_dependency_manager.h"
+
+// static
+ResourcePrefetchPredictor* ResourcePrefetchPredictorFactory::GetForProfile(
+    Profile* profile) {
+  if (!ResourcePrefetchPredictor::IsEnabled())
+    return NULL;
+  return static_cast<ResourcePrefetchPredictor*>(
+      GetInstance()->GetServiceForProfile(profile, true));
+}
+
+// static
+ResourcePrefetchPredictorFactory*
+    ResourcePrefetchPredictorFactory::GetInstance() {
+  return Singleton<ResourcePrefetchPredictorFactory>::get();
+}
+
+ResourcePrefetchPredictorFactory::ResourcePrefetchPredictorFactory()
+    : ProfileKeyedServiceFactory("ResourcePrefetchPredictor",
+                                 ProfileDependencyManager::GetInstance()) {
+}
+
+ResourcePrefetchPredictorFactory::~ResourcePrefetchPredictorFactory() {}
+
+ProfileKeyedService*
+    ResourcePrefetchPredictorFactory::BuildServiceInstanceFor(
+        Profile* profile) const {
+  return new ResourcePrefetchPredictor(profile);
+}
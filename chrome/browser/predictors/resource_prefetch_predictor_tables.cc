@@ -0,0 +1,234 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/predictors/resource_prefetch_predictor_tables.h"
+
+#include "base/file_util.h"
+#include "base/logging.h"
+#include "base/metrics/histogram.h"
+#include "base/stringprintf.h"
+#include "chrome/browser/profiles/profile.h"
+#include "content/public/browser/browser_thread.h"
+#include "sql/statement.h"
+
+namespace {
+
+const char kResourcePrefetchPredictorTableName[] =
+    "resource_prefetch_predictor";
+const FilePath::CharType kResourcePrefetchPredictorDatabaseName[] =
+    FILE_PATH_LITERAL("Resource Prefetch Predictor");
+
+// The maximum length allowed for strings in the database.
+const size_t kMaxDataLength = 2048;
+
+void BindRowToStatement(const ResourcePrefetchPredictorTables::Row& row,
+                        sql::Statement* statement) {
+  statement->BindString(0, row.main_page_key.substr(0, kMaxDataLength));
+  statement->BindInt(1, row.key_type);
+  statement->BindString(2, row.resource_url.spec().substr(0, kMaxDataLength));
+  statement->BindInt(3, row.resource_type);
+  statement->BindInt(4, row.number_of_hits);
+  statement->BindInt(5, row.number_of_misses);
+  statement->BindInt64(6, row.last_visit.ToInternalValue());
+}
+
+bool StepAndInitializeRow(sql::Statement* statement,
+                          ResourcePrefetchPredictorTables::Row* row) {
+  if (!statement->Step())
+    return false;
+
+  row->main_page_key = statement->ColumnString(0);
+  row->key_type = static_cast<ResourcePrefetchPredictorTables::KeyType>(
+      statement->ColumnInt(1));
+  row->resource_url = GURL(statement->ColumnString(2));
+  row->resource_type = ResourceType::FromInt(statement->ColumnInt(3));
+  row->number_of_hits = statement->ColumnInt(4);
+  row->number_of_misses = statement->ColumnInt(5);
+  row->last_visit = base::Time::FromInternalValue(statement->ColumnInt64(6));
+  return true;
+}
+
+void LogDatabaseStats(const FilePath& db_path, sql::Connection* db) {
+  int64 db_size;
+  bool success = file_util::GetFileSize(db_path, &db_size);
+  DCHECK(success) << "Failed to get file size for " << db_path.value();
+  UMA_HISTOGRAM_MEMORY_KB("ResourcePrefetchPredictor.DatabaseSizeKB",
+                          static_cast<int>(db_size / 1024));
+
+  sql::Statement count_statement(db->GetUniqueStatement(
+      base::StringPrintf("SELECT count(*) FROM %s",
+                         kResourcePrefetchPredictorTableName).c_str()));
+  if (!count_statement.Step())
+    return;
+  UMA_HISTOGRAM_COUNTS("ResourcePrefetchPredictor.DatabaseRowCount",
+                       count_statement.ColumnInt(0));
+}
+
+}  // namespace
+
+ResourcePrefetchPredictorTables::Row::Row()
+    : key_type(KEY_TYPE_URL),
+      resource_type(ResourceType::LAST_TYPE),
+      number_of_hits(0),
+      number_of_misses(0) {
+}
+
+ResourcePrefetchPredictorTables::Row::Row(const std::string& main_page_key,
+                                          KeyType key_type,
+                                          const GURL& resource_url,
+                                          ResourceType::Type resource_type,
+                                          int number_of_hits,
+                                          int number_of_misses,
+                                          base::Time last_visit)
+    : main_page_key(main_page_key),
+      key_type(key_type),
+      resource_url(resource_url),
+      resource_type(resource_type),
+      number_of_hits(number_of_hits),
+      number_of_misses(number_of_misses),
+      last_visit(last_visit) {
+}
+
+double ResourcePrefetchPredictorTables::Row::GetConfidence() const {
+  int visits = number_of_hits + number_of_misses;
+  return visits ? static_cast<double>(number_of_hits) / visits : 0.0;
+}
+
+ResourcePrefetchPredictorTables::ResourcePrefetchPredictorTables(
+    Profile* profile)
+    : db_path_(profile->GetPath().Append(
+        kResourcePrefetchPredictorDatabaseName)) {
+}
+
+ResourcePrefetchPredictorTables::~ResourcePrefetchPredictorTables() {
+}
+
+void ResourcePrefetchPredictorTables::Initialize() {
+  CHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::DB));
+
+  if (canceled_.IsSet())
+    return;
+
+  db_.set_exclusive_locking();
+  if (!db_.Open(db_path_)) {
+    canceled_.Set();
+    return;
+  }
+
+  if (!db_.DoesTableExist(kResourcePrefetchPredictorTableName))
+    CreateTable();
+
+  LogDatabaseStats(db_path_, &db_);
+}
+
+void ResourcePrefetchPredictorTables::GetAllRows(Rows* row_buffer) {
+  CHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::DB));
+  CHECK(row_buffer);
+  row_buffer->clear();
+
+  if (canceled_.IsSet())
+    return;
+
+  sql::Statement statement(db_.GetCachedStatement(SQL_FROM_HERE,
+      base::StringPrintf(
+          "SELECT * FROM %s", kResourcePrefetchPredictorTableName).c_str()));
+
+  Row row;
+  while (StepAndInitializeRow(&statement, &row))
+    row_buffer->push_back(row);
+}
+
+void ResourcePrefetchPredictorTables::UpdateRowsForKey(
+    const std::string& main_page_key,
+    KeyType key_type,
+    const Rows& rows) {
+  CHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::DB));
+
+  if (canceled_.IsSet())
+    return;
+
+  sql::Statement delete_statement(db_.GetCachedStatement(SQL_FROM_HERE,
+      base::StringPrintf(
+          "DELETE FROM %s WHERE main_page_key=? AND key_type=?",
+          kResourcePrefetchPredictorTableName).c_str()));
+  sql::Statement insert_statement(db_.GetCachedStatement(SQL_FROM_HERE,
+      base::StringPrintf(
+          "INSERT INTO %s "
+          "(main_page_key, key_type, resource_url, resource_type, "
+          "number_of_hits, number_of_misses, last_visit) "
+          "VALUES (?,?,?,?,?,?,?)",
+          kResourcePrefetchPredictorTableName).c_str()));
+
+  db_.BeginTransaction();
+  delete_statement.BindString(0, main_page_key.substr(0, kMaxDataLength));
+  delete_statement.BindInt(1, key_type);
+  delete_statement.Run();
+
+  for (Rows::const_iterator it = rows.begin(); it != rows.end(); ++it) {
+    DCHECK_EQ(main_page_key, it->main_page_key);
+    DCHECK_EQ(key_type, it->key_type);
+    BindRowToStatement(*it, &insert_statement);
+    bool success = insert_statement.Run();
+    DCHECK(success) << "Failed to insert a row for " << main_page_key
+                    << " into " << kResourcePrefetchPredictorTableName;
+    insert_statement.Reset(true);
+  }
+  db_.CommitTransaction();
+}
+
+void ResourcePrefetchPredictorTables::DeleteRowsForKeys(
+    const std::vector<std::string>& main_page_keys,
+    KeyType key_type) {
+  CHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::DB));
+
+  if (canceled_.IsSet())
+    return;
+
+  sql::Statement statement(db_.GetUniqueStatement(base::StringPrintf(
+          "DELETE FROM %s WHERE main_page_key=? AND key_type=?",
+          kResourcePrefetchPredictorTableName).c_str()));
+
+  db_.BeginTransaction();
+  for (std::vector<std::string>::const_iterator it = main_page_keys.begin();
+       it != main_page_keys.end(); ++it) {
+    statement.BindString(0, it->substr(0, kMaxDataLength));
+    statement.BindInt(1, key_type);
+    statement.Run();
+    statement.Reset(true);
+  }
+  db_.CommitTransaction();
+}
+
+void ResourcePrefetchPredictorTables::DeleteAllRows() {
+  CHECK(content::BrowserThread::CurrentlyOn(content::BrowserThread::DB));
+
+  if (canceled_.IsSet())
+    return;
+
+  sql::Statement statement(db_.GetCachedStatement(SQL_FROM_HERE,
+      base::StringPrintf("DELETE FROM %s",
+                         kResourcePrefetchPredictorTableName).c_str()));
+
+  statement.Run();
+}
+
+void ResourcePrefetchPredictorTables::OnPredictorDestroyed() {
+  canceled_.Set();
+}
+
+void ResourcePrefetchPredictorTables::CreateTable() {
+  bool success = db_.Execute(base::StringPrintf(
+      "CREATE TABLE %s ( "
+      "main_page_key TEXT, "
+      "key_type INTEGER, "
+      "resource_url TEXT, "
+      "resource_type INTEGER, "
+      "number_of_hits INTEGER, "
+      "number_of_misses INTEGER, "
+      "last_visit INTEGER, "
+      "PRIMARY KEY(main_page_key, key_type, resource_url))",
+      kResourcePrefetchPredictorTableName).c_str());
+  DCHECK(success) << "Failed to create "
+                  << kResourcePrefetchPredictorTableName << " table.";
+}
@@ -0,0 +1,106 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_PREDICTORS_RESOURCE_PREFETCH_PREDICTOR_TABLES_H_
+#define CHROME_BROWSER_PREDICTORS_RESOURCE_PREFETCH_PREDICTOR_TABLES_H_
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "base/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/cancellation_flag.h"
+#include "base/time.h"
+#include "googleurl/src/gurl.h"
+#include "sql/connection.h"
+#include "webkit/glue/resource_type.h"
+
+class Profile;
+
+// This manages the resource prefetch predictor table within the SQLite
+// database it opens in the profile directory. It expects the following scheme:
+//
+// resource_prefetch_predictor
+//   main_page_key      The URL or the host of the top-level page.
+//   key_type           Whether |main_page_key| is a URL or a host.
+//   resource_url       The URL of a subresource loaded by the page.
+//   resource_type      The ResourceType::Type of the subresource.
+//   number_of_hits     Number of visits to the page that loaded the resource.
+//   number_of_misses   Number of visits to the page that did not load it.
+//   last_visit         Internal value of the time of the last visit to the
+//                      page.
+//
+// Ref-counted as it is created and destroyed on a different thread to the DB
+// thread that is required for all methods performing database access.
+class ResourcePrefetchPredictorTables
+    : public base::RefCountedThreadSafe<ResourcePrefetchPredictorTables> {
+ public:
+  enum KeyType {
+    KEY_TYPE_URL = 0,
+    KEY_TYPE_HOST = 1
+  };
+
+  struct Row {
+    Row();
+    Row(const std::string& main_page_key,
+        KeyType key_type,
+        const GURL& resource_url,
+        ResourceType::Type resource_type,
+        int number_of_hits,
+        int number_of_misses,
+        base::Time last_visit);
+
+    // Fraction of the visits to the page that loaded this resource.
+    double GetConfidence() const;
+
+    std::string main_page_key;
+    KeyType key_type;
+    GURL resource_url;
+    ResourceType::Type resource_type;
+    int number_of_hits;
+    int number_of_misses;
+    base::Time last_visit;
+  };
+  typedef std::vector<Row> Rows;
+
+  explicit ResourcePrefetchPredictorTables(Profile* profile);
+
+  // Opens the database file from the profile path. Separated from the
+  // constructor to ease construction/destruction of this object on one thread
+  // but database access on the DB thread.
+  void Initialize();
+
+  void GetAllRows(Rows* row_buffer);
+
+  // Replaces all the rows for |main_page_key| with |rows|, in one
+  // transaction. An empty |rows| deletes the page.
+  void UpdateRowsForKey(const std::string& main_page_key,
+                        KeyType key_type,
+                        const Rows& rows);
+
+  void DeleteRowsForKeys(const std::vector<std::string>& main_page_keys,
+                         KeyType key_type);
+  void DeleteAllRows();
+
+  void OnPredictorDestroyed();
+
+ private:
+  friend class ResourcePrefetchPredictorTablesTest;
+  friend class base::RefCountedThreadSafe<ResourcePrefetchPredictorTables>;
+  virtual ~ResourcePrefetchPredictorTables();
+
+  void CreateTable();
+
+  FilePath db_path_;
+  sql::Connection db_;
+
+  // Set when the ResourcePrefetchPredictor is destroyed so we can cancel any
+  // posted database requests.
+  base::CancellationFlag canceled_;
+
+  DISALLOW_COPY_AND_ASSIGN(ResourcePrefetchPredictorTables);
+};
+
+#endif  // CHROME_BROWSER_PREDICTORS_RESOURCE_PREFETCH_PREDICTOR_TABLES_H_
@@ -0,0 +1,205 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "base/message_loop.h"
+#include "base/time.h"
+#include "chrome/browser/predictors/resource_prefetch_predictor_tables.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/test/test_browser_thread.h"
+#include "sql/statement.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+using base::Time;
+using content::BrowserThread;
+
+namespace {
+
+typedef ResourcePrefetchPredictorTables::Row Row;
+typedef ResourcePrefetchPredictorTables::Rows Rows;
+
+}  // end namespace
+
+class ResourcePrefetchPredictorTablesTest : public testing::Test {
+ public:
+  ResourcePrefetchPredictorTablesTest();
+  virtual ~ResourcePrefetchPredictorTablesTest();
+
+  virtual void SetUp();
+  virtual void TearDown();
+
+  size_t CountRecords() const;
+
+  void AddAll();
+
+  bool RowsAreEqual(const Row& lhs, const Row& rhs) const;
+
+ protected:
+  Rows google_rows_;
+  Rows google_host_rows_;
+  Rows reddit_rows_;
+
+  scoped_refptr<ResourcePrefetchPredictorTables> tables_;
+
+ private:
+  TestingProfile profile_;
+  MessageLoop loop_;
+  content::TestBrowserThread db_thread_;
+};
+
+ResourcePrefetchPredictorTablesTest::ResourcePrefetchPredictorTablesTest()
+    : loop_(MessageLoop::TYPE_DEFAULT),
+      db_thread_(BrowserThread::DB, &loop_) {
+}
+
+ResourcePrefetchPredictorTablesTest::~ResourcePrefetchPredictorTablesTest() {
+}
+
+void ResourcePrefetchPredictorTablesTest::SetUp() {
+  tables_ = new ResourcePrefetchPredictorTables(&profile_);
+  tables_->Initialize();
+
+  const Time now = Time::Now();
+  google_rows_.push_back(Row(
+      "http://www.google.com/", ResourcePrefetchPredictorTables::KEY_TYPE_URL,
+      GURL("http://www.google.com/style.css"), ResourceType::STYLESHEET,
+      4, 1, now));
+  google_rows_.push_back(Row(
+      "http://www.google.com/", ResourcePrefetchPredictorTables::KEY_TYPE_URL,
+      GURL("http://www.google.com/logo.png"), ResourceType::IMAGE,
+      5, 0, now));
+  google_host_rows_.push_back(Row(
+      "www.google.com", ResourcePrefetchPredictorTables::KEY_TYPE_HOST,
+      GURL("http://www.google.com/script.js"), ResourceType::SCRIPT,
+      9, 3, now));
+  reddit_rows_.push_back(Row(
+      "http://www.reddit.com/", ResourcePrefetchPredictorTables::KEY_TYPE_URL,
+      GURL("http://www.reddit.com/font.ttf"), ResourceType::FONT_RESOURCE,
+      1, 2, now));
+}
+
+void ResourcePrefetchPredictorTablesTest::TearDown() {
+  tables_ = NULL;
+}
+
+size_t ResourcePrefetchPredictorTablesTest::CountRecords() const {
+  sql::Statement s(tables_->db_.GetUniqueStatement(
+      "SELECT count(*) FROM resource_prefetch_predictor"));
+  EXPECT_TRUE(s.Step());
+  return static_cast<size_t>(s.ColumnInt(0));
+}
+
+void ResourcePrefetchPredictorTablesTest::AddAll() {
+  tables_->UpdateRowsForKey("http://www.google.com/",
+                            ResourcePrefetchPredictorTables::KEY_TYPE_URL,
+                            google_rows_);
+  tables_->UpdateRowsForKey("www.google.com",
+                            ResourcePrefetchPredictorTables::KEY_TYPE_HOST,
+                            google_host_rows_);
+  tables_->UpdateRowsForKey("http://www.reddit.com/",
+                            ResourcePrefetchPredictorTables::KEY_TYPE_URL,
+                            reddit_rows_);
+  EXPECT_EQ(4U, CountRecords());
+}
+
+bool ResourcePrefetchPredictorTablesTest::RowsAreEqual(const Row& lhs,
+                                                       const Row& rhs) const {
+  return (lhs.main_page_key == rhs.main_page_key &&
+          lhs.key_type == rhs.key_type &&
+          lhs.resource_url == rhs.resource_url &&
+          lhs.resource_type == rhs.resource_type &&
+          lhs.number_of_hits == rhs.number_of_hits &&
+          lhs.number_of_misses == rhs.number_of_misses &&
+          lhs.last_visit == rhs.last_visit);
+}
+
+TEST_F(ResourcePrefetchPredictorTablesTest, GetAllRows) {
+  AddAll();
+
+  Rows rows;
+  tables_->GetAllRows(&rows);
+  ASSERT_EQ(4U, rows.size());
+
+  Rows expected(google_rows_);
+  expected.insert(expected.end(), google_host_rows_.begin(),
+                  google_host_rows_.end());
+  expected.insert(expected.end(), reddit_rows_.begin(), reddit_rows_.end());
+  for (Rows::const_iterator it = expected.begin(); it != expected.end();
+       ++it) {
+    bool found = false;
+    for (size_t i = 0; i < rows.size() && !found; ++i)
+      found = RowsAreEqual(*it, rows[i]);
+    EXPECT_TRUE(found) << "Missing " << it->resource_url.spec() << " for "
+                       << it->main_page_key;
+  }
+}
+
+TEST_F(ResourcePrefetchPredictorTablesTest, UpdateRowsForKey) {
+  AddAll();
+
+  // Replacing the rows of a page leaves the other pages alone.
+  Rows rows(1, google_rows_[1]);
+  ++rows[0].number_of_hits;
+  tables_->UpdateRowsForKey("http://www.google.com/",
+                            ResourcePrefetchPredictorTables::KEY_TYPE_URL,
+                            rows);
+  EXPECT_EQ(3U, CountRecords());
+
+  Rows all_rows;
+  tables_->GetAllRows(&all_rows);
+  bool found = false;
+  for (size_t i = 0; i < all_rows.size() && !found; ++i)
+    found = RowsAreEqual(rows[0], all_rows[i]);
+  EXPECT_TRUE(found);
+
+  // An empty update deletes the page.
+  tables_->UpdateRowsForKey("http://www.google.com/",
+                            ResourcePrefetchPredictorTables::KEY_TYPE_URL,
+                            Rows());
+  EXPECT_EQ(2U, CountRecords());
+}
+
+TEST_F(ResourcePrefetchPredictorTablesTest, DeleteRowsForKeys) {
+  AddAll();
+
+  // The key type must match as well as the key.
+  std::vector<std::string> keys;
+  keys.push_back("http://www.google.com/");
+  keys.push_back("www.google.com");
+  tables_->DeleteRowsForKeys(keys,
+                             ResourcePrefetchPredictorTables::KEY_TYPE_URL);
+  EXPECT_EQ(2U, CountRecords());
+
+  tables_->DeleteRowsForKeys(keys,
+                             ResourcePrefetchPredictorTables::KEY_TYPE_HOST);
+  EXPECT_EQ(1U, CountRecords());
+
+  Rows rows;
+  tables_->GetAllRows(&rows);
+  ASSERT_EQ(1U, rows.size());
+  EXPECT_TRUE(RowsAreEqual(reddit_rows_[0], rows[0]));
+}
+
+TEST_F(ResourcePrefetchPredictorTablesTest, DeleteAllRows) {
+  AddAll();
+  tables_->DeleteAllRows();
+  EXPECT_EQ(0U, CountRecords());
+}
+
+TEST_F(ResourcePrefetchPredictorTablesTest, Reopen) {
+  AddAll();
+
+  // The rows survive closing and reopening the database.
+  tables_ = NULL;
+  SetUp();
+  EXPECT_EQ(4U, CountRecords());
+}
+
+TEST_F(ResourcePrefetchPredictorTablesTest, GetConfidence) {
+  EXPECT_DOUBLE_EQ(0.8, google_rows_[0].GetConfidence());
+  EXPECT_DOUBLE_EQ(1.0, google_rows_[1].GetConfidence());
+  EXPECT_DOUBLE_EQ(0.0, Row().GetConfidence());
+}
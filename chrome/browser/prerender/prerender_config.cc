@@ -8,6 +8,9 @@ namespace prerender {
 
 Config::Config() : max_bytes(100 * 1024 * 1024),
                    max_elements(1),
+                   max_total_memory_percent(10),
+                   min_physical_memory_mb(1024),
+                   min_processors(2),
                    rate_limit_enabled(true),
                    max_age(base::TimeDelta::FromSeconds(30)),
                    https_allowed(true),
@@ -20,6 +20,16 @@ struct Config {
   // Number of simultaneous prendered pages allowed.
   unsigned int max_elements;
 
+  // Maximum memory use of all prerendered pages together, as a percentage of
+  // the physical memory of the machine. A new prerender is only started if
+  // the pages it would join leave room for |max_bytes| more.
+  int max_total_memory_percent;
+
+  // Prerendering only happens on machines with at least this much physical
+  // memory and this many processors, so that it can't starve the visible tabs.
+  int min_physical_memory_mb;
+  int min_processors;
+
   // Is rate limiting enabled?
   bool rate_limit_enabled;
 
@@ -652,17 +652,22 @@ base::ProcessMetrics* PrerenderContents::MaybeGetProcessMetrics() {
 }
 
 void PrerenderContents::DestroyWhenUsingTooManyResources() {
-  base::ProcessMetrics* metrics = MaybeGetProcessMetrics();
-  if (metrics == NULL)
-    return;
-
-  size_t private_bytes, shared_bytes;
-  if (metrics->GetMemoryBytes(&private_bytes, &shared_bytes) &&
+  size_t private_bytes;
+  if (GetPrivateBytes(&private_bytes) &&
       private_bytes > prerender_manager_->config().max_bytes) {
       Destroy(FINAL_STATUS_MEMORY_LIMIT_EXCEEDED);
   }
 }
 
+bool PrerenderContents::GetPrivateBytes(size_t* private_bytes) {
+  base::ProcessMetrics* metrics = MaybeGetProcessMetrics();
+  if (metrics == NULL)
+    return false;
+
+  size_t shared_bytes;
+  return metrics->GetMemoryBytes(private_bytes, &shared_bytes);
+}
+
 TabContentsWrapper* PrerenderContents::ReleasePrerenderContents() {
   prerender_contents_->web_contents()->SetDelegate(NULL);
   render_view_host_observer_.reset();
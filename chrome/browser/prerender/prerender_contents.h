@@ -110,6 +110,10 @@ class PrerenderContents : public content::NotificationObserver,
   // it if not.
   void DestroyWhenUsingTooManyResources();
 
+  // Gets the private memory used by the prerendering render process. Returns
+  // false if the process hasn't started yet.
+  bool GetPrivateBytes(size_t* private_bytes);
+
   content::RenderViewHost* GetRenderViewHostMutable();
   const content::RenderViewHost* GetRenderViewHost() const;
 
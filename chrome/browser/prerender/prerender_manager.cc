@@ -12,6 +12,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/metrics/histogram.h"
 #include "base/stl_util.h"
+#include "base/sys_info.h"
 #include "base/time.h"
 #include "base/utf_string_conversions.h"
 #include "base/values.h"
@@ -892,6 +893,12 @@ bool PrerenderManager::AddPrerender(
     return false;
   }
 
+  if (!DoesResourceBudgetAllowPrerender()) {
+    RecordFinalStatus(origin, experiment,
+                      FINAL_STATUS_RESOURCE_BUDGET_EXCEEDED);
+    return false;
+  }
+
   RenderViewHost* source_render_view_host = NULL;
   if (child_route_id_pair.first != -1) {
     source_render_view_host =
@@ -1123,6 +1130,32 @@ bool PrerenderManager::DoesRateLimitAllowPrerender() const {
       base::TimeDelta::FromMilliseconds(kMinTimeBetweenPrerendersMs);
 }
 
+bool PrerenderManager::DoesResourceBudgetAllowPrerender() const {
+  DCHECK(CalledOnValidThread());
+  if (base::SysInfo::NumberOfProcessors() < config_.min_processors ||
+      base::SysInfo::AmountOfPhysicalMemoryMB() <
+          config_.min_physical_memory_mb) {
+    return false;
+  }
+
+  // Only the newest max_elements - 1 prerenders survive adding another one;
+  // the rest are evicted. Assume the new one will grow up to |max_bytes|.
+  uint64 used_bytes = config_.max_bytes;
+  size_t survivors = config_.max_elements > 0 ? config_.max_elements - 1 : 0;
+  for (PrerenderContentsDataList::const_reverse_iterator it =
+           prerender_list_.rbegin();
+       it != prerender_list_.rend() && survivors > 0; ++it, --survivors) {
+    size_t private_bytes;
+    if (it->contents_->GetPrivateBytes(&private_bytes))
+      used_bytes += private_bytes;
+  }
+
+  uint64 budget_bytes = static_cast<uint64>(
+      base::SysInfo::AmountOfPhysicalMemory()) *
+      config_.max_total_memory_percent / 100;
+  return used_bytes <= budget_bytes;
+}
+
 void PrerenderManager::DeleteOldTabContents() {
   while (!old_tab_contents_list_.empty()) {
     TabContentsWrapper* tab_contents = old_tab_contents_list_.front();
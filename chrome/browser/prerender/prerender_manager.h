@@ -354,6 +354,11 @@ class PrerenderManager : public base::SupportsWeakPtr<PrerenderManager>,
 
   bool DoesRateLimitAllowPrerender() const;
 
+  // Returns whether the machine is capable enough for prerendering, and the
+  // prerenders that would be kept alongside a new one leave it enough room in
+  // the memory budget.
+  bool DoesResourceBudgetAllowPrerender() const;
+
   // Deletes old WebContents that have been replaced by prerendered ones.  This
   // is needed because they're replaced in a callback from the old WebContents,
   // so cannot immediately be deleted.
@@ -75,6 +75,11 @@ class TestPrerenderManager : public PrerenderManager {
         next_prerender_contents_(NULL),
         prerender_tracker_(prerender_tracker) {
     set_rate_limit_enabled(false);
+    // Don't let the test machine's memory and processors decide whether to
+    // prerender.
+    mutable_config().min_physical_memory_mb = 0;
+    mutable_config().min_processors = 0;
+    mutable_config().max_total_memory_percent = 100;
   }
 
   virtual ~TestPrerenderManager() {
@@ -412,6 +417,26 @@ TEST_F(PrerenderManagerTest, RateLimitInWindowTest) {
   prerender_manager()->set_rate_limit_enabled(false);
 }
 
+// Ensure that we ignore prerender requests on machines that are too weak, or
+// when the prerenders would exceed the memory budget.
+TEST_F(PrerenderManagerTest, ResourceBudgetTest) {
+  GURL url("http://www.google.com/");
+  prerender_manager()->CreateNextPrerenderContents(
+      url,
+      FINAL_STATUS_MANAGER_SHUTDOWN);
+  prerender_manager()->mutable_config().min_processors = kint32max;
+  EXPECT_FALSE(prerender_manager()->AddSimplePrerender(url));
+  prerender_manager()->mutable_config().min_processors = 0;
+
+  prerender_manager()->mutable_config().max_total_memory_percent = 0;
+  EXPECT_FALSE(prerender_manager()->AddSimplePrerender(url));
+  prerender_manager()->mutable_config().max_total_memory_percent = 100;
+
+  DummyPrerenderContents* null = NULL;
+  EXPECT_TRUE(prerender_manager()->AddSimplePrerender(url));
+  EXPECT_EQ(null, prerender_manager()->next_prerender_contents());
+}
+
 // Ensure that we don't ignore prerender requests outside the rate limit.
 TEST_F(PrerenderManagerTest, RateLimitOutsideWindowTest) {
   GURL url("http://www.google.com/");
@@ -65,6 +65,10 @@ class PrintJob : public PrintJobWorkerOwner,
   // spool as soon as data is available.
   void StartPrinting();
 
+  // Signals the worker that a page was added to the document, so that it is
+  // spooled as soon as the pages before it have been.
+  void OnPageAvailable();
+
   // Waits for the worker thread to finish its queued tasks and disconnects the
   // delegate object. The PrintJobManager will remove it reference. This may
   // have the side-effect of destroying the object if the caller doesn't have a
@@ -47,8 +47,7 @@ void NotificationCallback(PrintJobWorkerOwner* print_job,
 
 PrintJobWorker::PrintJobWorker(PrintJobWorkerOwner* owner)
     : Thread("Printing_Worker"),
-      owner_(owner),
-      ALLOW_THIS_IN_INITIALIZER_LIST(weak_factory_(this)) {
+      owner_(owner) {
   // The object is created in the IO thread.
   DCHECK_EQ(owner_->message_loop(), MessageLoop::current());
 
@@ -248,11 +247,8 @@ void PrintJobWorker::OnNewPage() {
     // Is the page available?
     scoped_refptr<PrintedPage> page;
     if (!document_->GetPage(page_number_.ToInt(), &page)) {
-      // We need to wait for the page to be available.
-      MessageLoop::current()->PostDelayedTask(
-          FROM_HERE,
-          base::Bind(&PrintJobWorker::OnNewPage, weak_factory_.GetWeakPtr()),
-          base::TimeDelta::FromMilliseconds(500));
+      // We need to wait for the page to be available. PrintJob calls us again
+      // as soon as it arrives.
       break;
     }
     // The page is there, print it.
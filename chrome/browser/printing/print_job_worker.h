@@ -8,7 +8,6 @@
 
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
-#include "base/memory/weak_ptr.h"
 #include "base/threading/thread.h"
 #include "printing/page_number.h"
 #include "printing/printing_context.h"
@@ -58,9 +57,9 @@ class PrintJobWorker : public base::Thread {
   // Updates the printed document.
   void OnDocumentChanged(PrintedDocument* new_document);
 
-  // Dequeues waiting pages. Called when PrintJob receives a
-  // NOTIFY_PRINTED_DOCUMENT_UPDATED notification. It's time to look again if
-  // the next page can be printed.
+  // Dequeues waiting pages. Called by PrintJob::OnPageAvailable() whenever a
+  // page is added to the document. It's time to look again if the next page
+  // can be printed.
   void OnNewPage();
 
   // This is the only function that can be called in a thread.
@@ -125,9 +124,6 @@ class PrintJobWorker : public base::Thread {
   // Current page number to print.
   PageNumber page_number_;
 
-  // Used to generate a WeakPtr for callbacks.
-  base::WeakPtrFactory<PrintJobWorker> weak_factory_;
-
   DISALLOW_COPY_AND_ASSIGN(PrintJobWorker);
 };
 
@@ -246,6 +246,7 @@ void PrintViewManager::OnDidPrintPage(
                     params.actual_shrink,
                     params.page_size,
                     params.content_area);
+  print_job_->OnPageAvailable();
 
   ShouldQuitFromInnerMessageLoop();
 }
@@ -376,6 +376,9 @@ void ProfileImplIOData::LazyInitializeInternal(
         profile_params->clear_local_state_on_exit);
     server_bound_cert_service = new net::ServerBoundCertService(
         new net::DefaultServerBoundCertStore(server_bound_cert_db.get()));
+    // Load the certs and pregenerate keys before the first handshake needs
+    // them.
+    server_bound_cert_service->Prefetch();
   }
 
   set_server_bound_cert_service(server_bound_cert_service);
@@ -17,14 +17,18 @@
 #include "chrome/browser/google/google_util.h"
 #include "chrome/browser/instant/instant_loader.h"
 #include "chrome/browser/net/load_timing_observer.h"
+#include "chrome/browser/predictors/resource_prefetch_predictor.h"
+#include "chrome/browser/predictors/resource_prefetch_predictor_factory.h"
 #include "chrome/browser/prerender/prerender_manager.h"
 #include "chrome/browser/prerender/prerender_manager_factory.h"
 #include "chrome/browser/prerender/prerender_tracker.h"
+#include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/profiles/profile_io_data.h"
 #include "chrome/browser/renderer_host/chrome_url_request_user_data.h"
 #include "chrome/browser/renderer_host/safe_browsing_resource_throttle.h"
 #include "chrome/browser/renderer_host/transfer_navigation_resource_throttle.h"
 #include "chrome/browser/safe_browsing/safe_browsing_service.h"
+#include "chrome/browser/tab_contents/tab_util.h"
 #include "chrome/browser/ui/auto_login_prompter.h"
 #include "chrome/browser/ui/login/login_prompt.h"
 #include "chrome/browser/ui/sync/one_click_signin_helper.h"
@@ -37,6 +41,7 @@
 #include "content/public/browser/resource_context.h"
 #include "content/public/browser/resource_dispatcher_host.h"
 #include "content/public/browser/resource_request_info.h"
+#include "content/public/browser/web_contents.h"
 #include "net/base/load_flags.h"
 #include "net/base/ssl_config_service.h"
 #include "net/url_request/url_request.h"
@@ -80,6 +85,46 @@ void NotifyDownloadInitiatedOnUI(int render_process_id, int render_view_id) {
       content::NotificationService::NoDetails());
 }
 
+ResourcePrefetchPredictor* GetResourcePrefetchPredictorOnUI(
+    int render_process_id, int render_view_id) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
+  content::WebContents* web_contents =
+      tab_util::GetWebContentsByID(render_process_id, render_view_id);
+  if (!web_contents)
+    return NULL;
+
+  return ResourcePrefetchPredictorFactory::GetForProfile(
+      Profile::FromBrowserContext(web_contents->GetBrowserContext()));
+}
+
+void OnMainFrameRequestOnUI(int render_process_id, int render_view_id,
+                            const GURL& main_frame_url) {
+  ResourcePrefetchPredictor* predictor =
+      GetResourcePrefetchPredictorOnUI(render_process_id, render_view_id);
+  if (predictor)
+    predictor->OnMainFrameRequest(main_frame_url);
+}
+
+void OnMainFrameResponseOnUI(int render_process_id, int render_view_id,
+                             const GURL& main_frame_url) {
+  ResourcePrefetchPredictor* predictor =
+      GetResourcePrefetchPredictorOnUI(render_process_id, render_view_id);
+  if (predictor)
+    predictor->OnMainFrameResponse(main_frame_url);
+}
+
+void OnSubresourceResponseOnUI(int render_process_id, int render_view_id,
+                               const GURL& main_frame_url,
+                               const GURL& resource_url,
+                               ResourceType::Type resource_type) {
+  ResourcePrefetchPredictor* predictor =
+      GetResourcePrefetchPredictorOnUI(render_process_id, render_view_id);
+  if (predictor) {
+    predictor->OnSubresourceResponse(main_frame_url, resource_url,
+                                     resource_type);
+  }
+}
+
 }  // end namespace
 
 ChromeResourceDispatcherHostDelegate::ChromeResourceDispatcherHostDelegate(
@@ -166,6 +211,13 @@ void ChromeResourceDispatcherHostDelegate::RequestBeginning(
 #endif
   }
 
+  if (ResourcePrefetchPredictor::IsEnabled() &&
+      ResourcePrefetchPredictor::ShouldRecordRequest(request, resource_type)) {
+    BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+        base::Bind(&OnMainFrameRequestOnUI, child_id, route_id,
+                   request->url()));
+  }
+
   AppendChromeMetricsHeaders(request, resource_context, resource_type);
 
   AppendStandardResourceThrottles(request,
@@ -354,6 +406,20 @@ void ChromeResourceDispatcherHostDelegate::OnResponseStarted(
   // suggest auto-login, if available.
   AutoLoginPrompter::ShowInfoBarIfPossible(request, info->GetChildID(),
                                            info->GetRouteID());
+
+  if (ResourcePrefetchPredictor::IsEnabled() &&
+      ResourcePrefetchPredictor::ShouldRecordResponse(request)) {
+    if (info->GetResourceType() == ResourceType::MAIN_FRAME) {
+      BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+          base::Bind(&OnMainFrameResponseOnUI, info->GetChildID(),
+                     info->GetRouteID(), request->url()));
+    } else {
+      BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+          base::Bind(&OnSubresourceResponseOnUI, info->GetChildID(),
+                     info->GetRouteID(), request->first_party_for_cookies(),
+                     request->url(), info->GetResourceType()));
+    }
+  }
 }
 
 void ChromeResourceDispatcherHostDelegate::OnRequestRedirected(
@@ -19,8 +19,9 @@ namespace {
 // md5 -qs chrome/browser/safe_browsing/prefix_set.cc | colrm 9
 static uint32 kMagic = 0x864088dd;
 
-// Current version the code writes out.
-static uint32 kVersion = 0x1;
+// Current version the code writes out.  Version 1 stored the index as
+// platform-sized pairs, and is no longer read.
+static uint32 kVersion = 0x2;
 
 typedef struct {
   uint32 magic;
@@ -29,12 +30,6 @@ typedef struct {
   uint32 deltas_size;
 } FileHeader;
 
-// For |std::upper_bound()| to find a prefix w/in a vector of pairs.
-bool PrefixLess(const std::pair<SBPrefix,size_t>& a,
-                const std::pair<SBPrefix,size_t>& b) {
-  return a.first < b.first;
-}
-
 }  // namespace
 
 namespace safe_browsing {
@@ -43,16 +38,18 @@ PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes)
     : checksum_(0) {
   if (sorted_prefixes.size()) {
     // Estimate the resulting vector sizes.  There will be strictly
-    // more than |min_runs| entries in |index_|, but there generally
-    // aren't many forced breaks.
+    // more than |min_runs| index entries, but there generally aren't
+    // many forced breaks.
     const size_t min_runs = sorted_prefixes.size() / kMaxRun;
-    index_.reserve(min_runs);
+    index_prefixes_.reserve(min_runs);
+    index_offsets_.reserve(min_runs);
     deltas_.reserve(sorted_prefixes.size() - min_runs);
 
     // Lead with the first prefix.
     SBPrefix prev_prefix = sorted_prefixes[0];
     size_t run_length = 0;
-    index_.push_back(std::make_pair(prev_prefix, deltas_.size()));
+    index_prefixes_.push_back(prev_prefix);
+    index_offsets_.push_back(static_cast<uint32>(deltas_.size()));
 
     // Used to build a checksum from the data used to construct the
     // structures.  Since the data is a bunch of uniform hashes, it
@@ -77,7 +74,8 @@ PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes)
       if (delta != static_cast<unsigned>(delta16) || run_length >= kMaxRun) {
         checksum ^= static_cast<uint32>(sorted_prefixes[i]);
         checksum ^= static_cast<uint32>(deltas_.size());
-        index_.push_back(std::make_pair(sorted_prefixes[i], deltas_.size()));
+        index_prefixes_.push_back(sorted_prefixes[i]);
+        index_offsets_.push_back(static_cast<uint32>(deltas_.size()));
         run_length = 0;
       } else {
         checksum ^= static_cast<uint32>(delta16);
@@ -94,9 +92,10 @@ PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes)
 
     // Send up some memory-usage stats.  Bits because fractional bytes
     // are weird.
-    const size_t bits_used = index_.size() * sizeof(index_[0]) * CHAR_BIT +
+    const size_t bits_used = index_prefixes_.size() *
+        (sizeof(index_prefixes_[0]) + sizeof(index_offsets_[0])) * CHAR_BIT +
         deltas_.size() * sizeof(deltas_[0]) * CHAR_BIT;
-    const size_t unique_prefixes = index_.size() + deltas_.size();
+    const size_t unique_prefixes = index_prefixes_.size() + deltas_.size();
     static const size_t kMaxBitsPerPrefix = sizeof(SBPrefix) * CHAR_BIT;
     UMA_HISTOGRAM_ENUMERATION("SB2.PrefixSetBitsPerPrefix",
                               bits_used / unique_prefixes,
@@ -104,43 +103,48 @@ PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes)
   }
 }
 
-PrefixSet::PrefixSet(std::vector<std::pair<SBPrefix,size_t> > *index,
-                     std::vector<uint16> *deltas)
+PrefixSet::PrefixSet(std::vector<SBPrefix>* index_prefixes,
+                     std::vector<uint32>* index_offsets,
+                     std::vector<uint16>* deltas)
     : checksum_(0) {
-  DCHECK(index && deltas);
-  index_.swap(*index);
+  DCHECK(index_prefixes && index_offsets && deltas);
+  DCHECK_EQ(index_prefixes->size(), index_offsets->size());
+  index_prefixes_.swap(*index_prefixes);
+  index_offsets_.swap(*index_offsets);
   deltas_.swap(*deltas);
 }
 
 PrefixSet::~PrefixSet() {}
 
 bool PrefixSet::Exists(SBPrefix prefix) const {
-  if (index_.empty())
+  if (index_prefixes_.empty())
     return false;
 
-  // Find the first position after |prefix| in |index_|.
-  std::vector<std::pair<SBPrefix,size_t> >::const_iterator
-      iter = std::upper_bound(index_.begin(), index_.end(),
-                              std::pair<SBPrefix,size_t>(prefix, 0),
-                              PrefixLess);
+  // Find the first position after |prefix| in the index.  Only the
+  // prefixes are searched, so each cache line fetched holds sixteen
+  // candidates.
+  const size_t next = std::upper_bound(index_prefixes_.begin(),
+                                       index_prefixes_.end(),
+                                       prefix) - index_prefixes_.begin();
 
   // |prefix| comes before anything that's in the set.
-  if (iter == index_.begin())
+  if (next == 0)
     return false;
 
   // Capture the upper bound of our target entry's deltas.
-  const size_t bound = (iter == index_.end() ? deltas_.size() : iter->second);
+  const size_t bound = (next == index_prefixes_.size() ?
+                        deltas_.size() : index_offsets_[next]);
 
   // Back up to the entry our target is in.
-  --iter;
+  const size_t ii = next - 1;
 
-  // All prefixes in |index_| are in the set.
-  SBPrefix current = iter->first;
+  // All prefixes in the index are in the set.
+  SBPrefix current = index_prefixes_[ii];
   if (current == prefix)
     return true;
 
   // Scan forward accumulating deltas while a match is possible.
-  for (size_t di = iter->second; di < bound && current < prefix; ++di) {
+  for (size_t di = index_offsets_[ii]; di < bound && current < prefix; ++di) {
     current += deltas_[di];
   }
 
@@ -148,17 +152,17 @@ bool PrefixSet::Exists(SBPrefix prefix) const {
 }
 
 void PrefixSet::GetPrefixes(std::vector<SBPrefix>* prefixes) const {
-  prefixes->reserve(index_.size() + deltas_.size());
+  prefixes->reserve(index_prefixes_.size() + deltas_.size());
 
-  for (size_t ii = 0; ii < index_.size(); ++ii) {
-    // The deltas for this |index_| entry run to the next index entry,
-    // or the end of the deltas.
-    const size_t deltas_end =
-        (ii + 1 < index_.size()) ? index_[ii + 1].second : deltas_.size();
+  for (size_t ii = 0; ii < index_prefixes_.size(); ++ii) {
+    // The deltas for this index entry run to the next index entry, or
+    // the end of the deltas.
+    const size_t deltas_end = (ii + 1 < index_offsets_.size()) ?
+        index_offsets_[ii + 1] : deltas_.size();
 
-    SBPrefix current = index_[ii].first;
+    SBPrefix current = index_prefixes_[ii];
     prefixes->push_back(current);
-    for (size_t di = index_[ii].second; di < deltas_end; ++di) {
+    for (size_t di = index_offsets_[ii]; di < deltas_end; ++di) {
       current += deltas_[di];
       prefixes->push_back(current);
     }
@@ -186,15 +190,20 @@ PrefixSet* PrefixSet::LoadFile(const FilePath& filter_name) {
   if (header.magic != kMagic || header.version != kVersion)
     return NULL;
 
-  std::vector<std::pair<SBPrefix,size_t> > index;
-  const size_t index_bytes = sizeof(index[0]) * header.index_size;
+  std::vector<SBPrefix> index_prefixes;
+  const size_t index_prefixes_bytes =
+      sizeof(index_prefixes[0]) * header.index_size;
+
+  std::vector<uint32> index_offsets;
+  const size_t index_offsets_bytes =
+      sizeof(index_offsets[0]) * header.index_size;
 
   std::vector<uint16> deltas;
   const size_t deltas_bytes = sizeof(deltas[0]) * header.deltas_size;
 
   // Check for bogus sizes before allocating any space.
-  const size_t expected_bytes =
-      sizeof(header) + index_bytes + deltas_bytes + sizeof(MD5Digest);
+  const size_t expected_bytes = sizeof(header) + index_prefixes_bytes +
+      index_offsets_bytes + deltas_bytes + sizeof(MD5Digest);
   if (static_cast<int64>(expected_bytes) != size_64)
     return NULL;
 
@@ -204,16 +213,28 @@ PrefixSet* PrefixSet::LoadFile(const FilePath& filter_name) {
   base::MD5Update(&context, base::StringPiece(reinterpret_cast<char*>(&header),
                                               sizeof(header)));
 
-  // Read the index vector.  Herb Sutter indicates that vectors are
+  // Read the index vectors.  Herb Sutter indicates that vectors are
   // guaranteed to be contiuguous, so reading to where element 0 lives
   // is valid.
-  index.resize(header.index_size);
-  read = fread(&(index[0]), sizeof(index[0]), index.size(), file.get());
-  if (read != index.size())
+  index_prefixes.resize(header.index_size);
+  read = fread(&(index_prefixes[0]), sizeof(index_prefixes[0]),
+               index_prefixes.size(), file.get());
+  if (read != index_prefixes.size())
+    return NULL;
+  base::MD5Update(&context,
+                  base::StringPiece(
+                      reinterpret_cast<char*>(&(index_prefixes[0])),
+                      index_prefixes_bytes));
+
+  index_offsets.resize(header.index_size);
+  read = fread(&(index_offsets[0]), sizeof(index_offsets[0]),
+               index_offsets.size(), file.get());
+  if (read != index_offsets.size())
     return NULL;
   base::MD5Update(&context,
-                  base::StringPiece(reinterpret_cast<char*>(&(index[0])),
-                                    index_bytes));
+                  base::StringPiece(
+                      reinterpret_cast<char*>(&(index_offsets[0])),
+                      index_offsets_bytes));
 
   // Read vector of deltas.
   deltas.resize(header.deltas_size);
@@ -235,19 +256,28 @@ PrefixSet* PrefixSet::LoadFile(const FilePath& filter_name) {
   if (0 != memcmp(&file_digest, &calculated_digest, sizeof(file_digest)))
     return NULL;
 
-  // Steals contents of |index| and |deltas| via swap().
-  return new PrefixSet(&index, &deltas);
+  // Every run of deltas must lie within |deltas|, in order, or
+  // |Exists()| could read past the end.
+  for (size_t ii = 0; ii < index_offsets.size(); ++ii) {
+    if (index_offsets[ii] > deltas.size() ||
+        (ii > 0 && index_offsets[ii] < index_offsets[ii - 1])) {
+      return NULL;
+    }
+  }
+
+  // Steals contents of the vectors via swap().
+  return new PrefixSet(&index_prefixes, &index_offsets, &deltas);
 }
 
 bool PrefixSet::WriteFile(const FilePath& filter_name) const {
   FileHeader header;
   header.magic = kMagic;
   header.version = kVersion;
-  header.index_size = static_cast<uint32>(index_.size());
+  header.index_size = static_cast<uint32>(index_prefixes_.size());
   header.deltas_size = static_cast<uint32>(deltas_.size());
 
   // Sanity check that the 32-bit values never mess things up.
-  if (static_cast<size_t>(header.index_size) != index_.size() ||
+  if (static_cast<size_t>(header.index_size) != index_prefixes_.size() ||
       static_cast<size_t>(header.deltas_size) != deltas_.size()) {
     NOTREACHED();
     return false;
@@ -270,13 +300,27 @@ bool PrefixSet::WriteFile(const FilePath& filter_name) const {
 
   // As for reads, the standard guarantees the ability to access the
   // contents of the vector by a pointer to an element.
-  const size_t index_bytes = sizeof(index_[0]) * index_.size();
-  written = fwrite(&(index_[0]), sizeof(index_[0]), index_.size(), file.get());
-  if (written != index_.size())
+  const size_t index_prefixes_bytes =
+      sizeof(index_prefixes_[0]) * index_prefixes_.size();
+  written = fwrite(&(index_prefixes_[0]), sizeof(index_prefixes_[0]),
+                   index_prefixes_.size(), file.get());
+  if (written != index_prefixes_.size())
     return false;
   base::MD5Update(&context,
-                  base::StringPiece(reinterpret_cast<const char*>(&(index_[0])),
-                                    index_bytes));
+                  base::StringPiece(
+                      reinterpret_cast<const char*>(&(index_prefixes_[0])),
+                      index_prefixes_bytes));
+
+  const size_t index_offsets_bytes =
+      sizeof(index_offsets_[0]) * index_offsets_.size();
+  written = fwrite(&(index_offsets_[0]), sizeof(index_offsets_[0]),
+                   index_offsets_.size(), file.get());
+  if (written != index_offsets_.size())
+    return false;
+  base::MD5Update(&context,
+                  base::StringPiece(
+                      reinterpret_cast<const char*>(&(index_offsets_[0])),
+                      index_offsets_bytes));
 
   const size_t deltas_bytes = sizeof(deltas_[0]) * deltas_.size();
   written = fwrite(&(deltas_[0]), sizeof(deltas_[0]), deltas_.size(),
@@ -301,12 +345,12 @@ bool PrefixSet::WriteFile(const FilePath& filter_name) const {
 }
 
 size_t PrefixSet::IndexBinFor(size_t target_index) const {
-  // The items in |index_| have the logical index of each previous
-  // item in |index_| plus the count of deltas between the items.
+  // The index entries have the logical index of each previous index
+  // entry plus the count of deltas between the entries.
   // Since the indices into |deltas_| are absolute, the logical index
   // is then the sum of the two indices.
   size_t lo = 0;
-  size_t hi = index_.size();
+  size_t hi = index_offsets_.size();
 
   // Binary search because linear search was too slow (really, the
   // unit test sucked).  Inline because the elements can't be compared
@@ -314,7 +358,7 @@ size_t PrefixSet::IndexBinFor(size_t target_index) const {
   while (hi - lo > 1) {
     const size_t i = (lo + hi) / 2;
 
-    if (target_index < i + index_[i].second) {
+    if (target_index < i + index_offsets_[i]) {
       DCHECK_LT(i, hi);  // Always making progress.
       hi = i;
     } else {
@@ -326,26 +370,26 @@ size_t PrefixSet::IndexBinFor(size_t target_index) const {
 }
 
 size_t PrefixSet::GetSize() const {
-  return index_.size() + deltas_.size();
+  return index_prefixes_.size() + deltas_.size();
 }
 
 bool PrefixSet::IsDeltaAt(size_t target_index) const {
   CHECK_LT(target_index, GetSize());
 
   const size_t i = IndexBinFor(target_index);
-  return target_index > i + index_[i].second;
+  return target_index > i + index_offsets_[i];
 }
 
 uint16 PrefixSet::DeltaAt(size_t target_index) const {
   CHECK_LT(target_index, GetSize());
 
-  // Find the |index_| entry which contains |target_index|.
+  // Find the index entry which contains |target_index|.
   const size_t i = IndexBinFor(target_index);
 
-  // Exactly on the |index_| entry means no delta.
-  CHECK_GT(target_index, i + index_[i].second);
+  // Exactly on the index entry means no delta.
+  CHECK_GT(target_index, i + index_offsets_[i]);
 
-  // -i backs out the |index_| entries, -1 gets the delta that lead to
+  // -i backs out the index entries, -1 gets the delta that lead to
   // the value at |target_index|.
   CHECK_LT(target_index - i - 1, deltas_.size());
   return deltas_[target_index - i - 1];
@@ -354,9 +398,9 @@ uint16 PrefixSet::DeltaAt(size_t target_index) const {
 bool PrefixSet::CheckChecksum() const {
   uint32 checksum = 0;
 
-  for (size_t ii = 0; ii < index_.size(); ++ii) {
-    checksum ^= static_cast<uint32>(index_[ii].first);
-    checksum ^= static_cast<uint32>(index_[ii].second);
+  for (size_t ii = 0; ii < index_prefixes_.size(); ++ii) {
+    checksum ^= static_cast<uint32>(index_prefixes_[ii]);
+    checksum ^= index_offsets_[ii];
   }
 
   for (size_t di = 0; di < deltas_.size(); ++di) {
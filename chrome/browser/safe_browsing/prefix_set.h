@@ -9,11 +9,15 @@
 //
 // For example, the sequence {20, 25, 41, 65432, 150000, 160000} would
 // be stored as:
-//  A pair {20, 0} in |index_|.
+//  20 in |index_prefixes_|, 0 in |index_offsets_|.
 //  5, 16, 65391 in |deltas_|.
-//  A pair {150000, 3} in |index_|.
+//  150000 in |index_prefixes_|, 3 in |index_offsets_|.
 //  10000 in |deltas_|.
-// |index_.size()| will be 2, |deltas_.size()| will be 4.
+// |index_prefixes_.size()| will be 2, |deltas_.size()| will be 4.
+//
+// The index is kept as two parallel arrays rather than an array of
+// pairs, so that the binary search in |Exists()| only touches the
+// densely-packed prefixes.
 //
 // This structure is intended for storage of sparse uniform sets of
 // prefixes of a certain size.  As of this writing, my safe-browsing
@@ -40,11 +44,14 @@
 // The on-disk format looks like:
 //         4 byte magic number
 //         4 byte version number
-//         4 byte |index_.size()|
+//         4 byte |index_prefixes_.size()|
 //         4 byte |deltas_.size()|
-//     n * 8 byte |&index_[0]..&index_[n]|
+//     n * 4 byte |&index_prefixes_[0]..&index_prefixes_[n]|
+//     n * 4 byte |&index_offsets_[0]..&index_offsets_[n]|
 //     m * 2 byte |&deltas_[0]..&deltas_[m]|
 //        16 byte digest
+// All fields are fixed-size, so the arrays are read straight into
+// place without any per-item parsing.
 
 #ifndef CHROME_BROWSER_SAFE_BROWSING_PREFIX_SET_H_
 #define CHROME_BROWSER_SAFE_BROWSING_PREFIX_SET_H_
@@ -83,14 +90,14 @@ class PrefixSet {
   size_t GetSize() const;
 
   // Returns |true| if the element at |target_index| is between items in the
-  // |index_| array.
+  // index.
   bool IsDeltaAt(size_t target_index) const;
 
   // Returns the delta used to calculate the element at
   // |target_index|.  Only call if |IsDeltaAt()| returned |true|.
   uint16 DeltaAt(size_t target_index) const;
 
-  // Check whether |index_| and |deltas_| still match the CRC
+  // Check whether the index and |deltas_| still match the CRC
   // generated during construction.
   bool CheckChecksum() const;
 
@@ -100,23 +107,26 @@ class PrefixSet {
   // for |Exists()| under control.
   static const size_t kMaxRun = 100;
 
-  // Helper for |LoadFile()|.  Steals the contents of |index| and
-  // |deltas| using |swap()|.
-  PrefixSet(std::vector<std::pair<SBPrefix,size_t> > *index,
-            std::vector<uint16> *deltas);
-
-  // Top-level index of prefix to offset in |deltas_|.  Each pair
-  // indicates a base prefix and where the deltas from that prefix
-  // begin in |deltas_|.  The deltas for a pair end at the next pair's
-  // index into |deltas_|.
-  std::vector<std::pair<SBPrefix,size_t> > index_;
-
-  // Deltas which are added to the prefix in |index_| to generate
-  // prefixes.  Deltas are only valid between consecutive items from
-  // |index_|, or the end of |deltas_| for the last |index_| pair.
+  // Helper for |LoadFile()|.  Steals the contents of |index_prefixes|,
+  // |index_offsets| and |deltas| using |swap()|.
+  PrefixSet(std::vector<SBPrefix>* index_prefixes,
+            std::vector<uint32>* index_offsets,
+            std::vector<uint16>* deltas);
+
+  // Top-level index of prefix to offset in |deltas_|.  Each entry of
+  // |index_prefixes_| is a base prefix, and the matching entry of
+  // |index_offsets_| is where the deltas from that prefix begin in
+  // |deltas_|.  The deltas for an entry end at the next entry's offset
+  // into |deltas_|.
+  std::vector<SBPrefix> index_prefixes_;
+  std::vector<uint32> index_offsets_;
+
+  // Deltas which are added to the prefix in |index_prefixes_| to
+  // generate prefixes.  Deltas are only valid between consecutive
+  // index entries, or the end of |deltas_| for the last entry.
   std::vector<uint16> deltas_;
 
-  // For debugging, used to verify that |index_| and |deltas| were not
+  // For debugging, used to verify that the index and |deltas| were not
   // changed after generation during construction.  |checksum_| is
   // calculated from the data used to construct those vectors.
   uint32 checksum_;
@@ -20,7 +20,7 @@ namespace {
 
 class PrefixSetTest : public PlatformTest {
  protected:
-  // Constants for the v1 format.
+  // Constants for the v2 format.
   static const size_t kMagicOffset = 0 * sizeof(uint32);
   static const size_t kVersionOffset = 1 * sizeof(uint32);
   static const size_t kIndexSizeOffset = 2 * sizeof(uint32);
@@ -324,7 +324,8 @@ TEST_F(PrefixSetTest, CorruptionHelpers) {
   FilePath filename;
   ASSERT_TRUE(GetPrefixSetFile(&filename));
 
-  // This will modify data in |index_|, which will fail the digest check.
+  // This will modify data in |index_prefixes_|, which will fail the
+  // digest check.
   file_util::ScopedFILE file(file_util::OpenFile(filename, "r+b"));
   IncrementIntAt(file.get(), kPayloadOffset, 1);
   file.reset();
@@ -389,6 +390,29 @@ TEST_F(PrefixSetTest, CorruptionDeltasSize) {
   ASSERT_FALSE(prefix_set.get());
 }
 
+// An index offset past the end of the deltas is caught by the sanity
+// check, even with a valid digest.
+TEST_F(PrefixSetTest, CorruptionIndexOffset) {
+  FilePath filename;
+  ASSERT_TRUE(GetPrefixSetFile(&filename));
+
+  uint32 index_size = 0;
+  file_util::ScopedFILE file(file_util::OpenFile(filename, "rb"));
+  ASSERT_NE(-1, fseek(file.get(), kIndexSizeOffset, SEEK_SET));
+  ASSERT_EQ(1U, fread(&index_size, sizeof(index_size), 1, file.get()));
+  file.reset();
+
+  // The offsets follow the index prefixes.  Push the last one out of
+  // range.
+  const long last_offset = static_cast<long>(
+      kPayloadOffset + (2 * index_size - 1) * sizeof(uint32));
+  ASSERT_NO_FATAL_FAILURE(
+      ModifyAndCleanChecksum(filename, last_offset, 0x100000));
+  scoped_ptr<safe_browsing::PrefixSet>
+      prefix_set(safe_browsing::PrefixSet::LoadFile(filename));
+  ASSERT_FALSE(prefix_set.get());
+}
+
 // Test that the digest catches corruption in the middle of the file
 // (in the payload between the header and the digest).
 TEST_F(PrefixSetTest, CorruptionPayload) {
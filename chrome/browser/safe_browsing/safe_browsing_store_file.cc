@@ -102,6 +102,32 @@ bool ReadToContainer(CT* values, size_t count, FILE* fp,
   return true;
 }
 
+// Vectors are contiguous, so the items can be read in a single block
+// rather than one by one.  Items are appended to |values|; callers
+// reading many blocks should |reserve()| the total up front so that
+// the vector is not reallocated (and briefly held twice) as it grows.
+template <typename T>
+bool ReadToContainer(std::vector<T>* values, size_t count, FILE* fp,
+                     base::MD5Context* context) {
+  if (!count)
+    return true;
+
+  const size_t original_size = values->size();
+  values->resize(original_size + count);
+  T* items = &(*values)[original_size];
+  if (fread(items, sizeof(T), count, fp) != count) {
+    values->resize(original_size);
+    return false;
+  }
+
+  if (context) {
+    base::MD5Update(context,
+                    base::StringPiece(reinterpret_cast<char*>(items),
+                                      sizeof(T) * count));
+  }
+  return true;
+}
+
 // Write all of |values| to |fp|, and fold the data into the checksum
 // in |context|, if non-NULL.  Returns true on succsess.
 template <typename CT>
@@ -514,18 +540,19 @@ bool SafeBrowsingStoreFile::DoUpdate(
   std::vector<SBAddFullHash> add_full_hashes;
   std::vector<SBSubFullHash> sub_full_hashes;
 
-  // Read original data into the vectors.
+  // Read the original header, so that the final sizes of the vectors
+  // can be known before any data is read.
+  base::MD5Context context;
+  base::MD5Init(&context);
+  FileHeader header;
+  memset(&header, 0, sizeof(header));
   if (!empty_) {
     DCHECK(file_.get());
 
     if (!FileRewind(file_.get()))
       return OnCorruptDatabase();
 
-    base::MD5Context context;
-    base::MD5Init(&context);
-
     // Read the file header and make sure it looks right.
-    FileHeader header;
     if (!ReadAndVerifyHeader(filename_, file_.get(), &header, &context))
       return OnCorruptDatabase();
 
@@ -537,6 +564,67 @@ bool SafeBrowsingStoreFile::DoUpdate(
         !ReadToContainer(&sub_chunks_cache_, header.sub_chunk_count,
                          file_.get(), &context))
       return OnCorruptDatabase();
+  }
+
+  // Rewind the temporary storage.
+  if (!FileRewind(new_file_.get()))
+    return false;
+
+  // Get chunk file's size for validating counts.
+  int64 size = 0;
+  if (!file_util::GetFileSize(TemporaryFileForFilename(filename_), &size))
+    return OnCorruptDatabase();
+
+  // Track update size to answer questions at http://crbug.com/72216 .
+  // Log small updates as 1k so that the 0 (underflow) bucket can be
+  // used for "empty" in SafeBrowsingDatabase.
+  UMA_HISTOGRAM_COUNTS("SB2.DatabaseUpdateKilobytes",
+                       std::max(static_cast<int>(size / 1024), 1));
+
+  // Walk the chunk headers in the temporary storage to total up the
+  // incoming items.
+  size_t sub_prefix_count = header.sub_prefix_count;
+  size_t add_hash_count = header.add_hash_count + pending_adds.size();
+  size_t sub_hash_count = header.sub_hash_count;
+  for (int i = 0; i < chunks_written_; ++i) {
+    ChunkHeader chunk_header;
+
+    int64 ofs = ftell(new_file_.get());
+    if (ofs == -1)
+      return false;
+
+    if (!ReadItem(&chunk_header, new_file_.get(), NULL))
+      return false;
+
+    // As a safety measure, make sure that the header describes a sane
+    // chunk, given the remaining file size.
+    size_t chunk_bytes = 0;
+    chunk_bytes += chunk_header.add_prefix_count * sizeof(SBAddPrefix);
+    chunk_bytes += chunk_header.sub_prefix_count * sizeof(SBSubPrefix);
+    chunk_bytes += chunk_header.add_hash_count * sizeof(SBAddFullHash);
+    chunk_bytes += chunk_header.sub_hash_count * sizeof(SBSubFullHash);
+    if (ofs + static_cast<int64>(sizeof(ChunkHeader) + chunk_bytes) > size)
+      return false;
+
+    if (!FileSkip(chunk_bytes, new_file_.get()))
+      return false;
+
+    sub_prefix_count += chunk_header.sub_prefix_count;
+    add_hash_count += chunk_header.add_hash_count;
+    sub_hash_count += chunk_header.sub_hash_count;
+  }
+
+  // Size the vectors once, rather than letting them double as data is
+  // appended.  Peak memory during an update is dominated by these, and
+  // growing a vector needs its old and new storage at the same time.
+  // |add_prefixes| is a deque, which grows in fixed-size blocks.
+  sub_prefixes.reserve(sub_prefix_count);
+  add_full_hashes.reserve(add_hash_count);
+  sub_full_hashes.reserve(sub_hash_count);
+
+  // Read original data into the vectors.
+  if (!empty_) {
+    DCHECK(file_.get());
 
     if (!ReadToContainer(&add_prefixes, header.add_prefix_count,
                          file_.get(), &context) ||
@@ -567,40 +655,13 @@ bool SafeBrowsingStoreFile::DoUpdate(
   }
   DCHECK(!file_.get());
 
-  // Rewind the temporary storage.
+  // Append the accumulated chunks onto the vectors read from |file_|.
+  // The chunk headers were sanity-checked above.
   if (!FileRewind(new_file_.get()))
     return false;
-
-  // Get chunk file's size for validating counts.
-  int64 size = 0;
-  if (!file_util::GetFileSize(TemporaryFileForFilename(filename_), &size))
-    return OnCorruptDatabase();
-
-  // Track update size to answer questions at http://crbug.com/72216 .
-  // Log small updates as 1k so that the 0 (underflow) bucket can be
-  // used for "empty" in SafeBrowsingDatabase.
-  UMA_HISTOGRAM_COUNTS("SB2.DatabaseUpdateKilobytes",
-                       std::max(static_cast<int>(size / 1024), 1));
-
-  // Append the accumulated chunks onto the vectors read from |file_|.
   for (int i = 0; i < chunks_written_; ++i) {
-    ChunkHeader header;
-
-    int64 ofs = ftell(new_file_.get());
-    if (ofs == -1)
-      return false;
-
-    if (!ReadItem(&header, new_file_.get(), NULL))
-      return false;
-
-    // As a safety measure, make sure that the header describes a sane
-    // chunk, given the remaining file size.
-    int64 expected_size = ofs + sizeof(ChunkHeader);
-    expected_size += header.add_prefix_count * sizeof(SBAddPrefix);
-    expected_size += header.sub_prefix_count * sizeof(SBSubPrefix);
-    expected_size += header.add_hash_count * sizeof(SBAddFullHash);
-    expected_size += header.sub_hash_count * sizeof(SBSubFullHash);
-    if (expected_size > size)
+    ChunkHeader chunk_header;
+    if (!ReadItem(&chunk_header, new_file_.get(), NULL))
       return false;
 
     // TODO(shess): If the vectors were kept sorted, then this code
@@ -610,13 +671,13 @@ bool SafeBrowsingStoreFile::DoUpdate(
     // some sort of recursive binary merge might be in order (merge
     // chunks pairwise, merge those chunks pairwise, and so on, then
     // merge the result with the main list).
-    if (!ReadToContainer(&add_prefixes, header.add_prefix_count,
+    if (!ReadToContainer(&add_prefixes, chunk_header.add_prefix_count,
                          new_file_.get(), NULL) ||
-        !ReadToContainer(&sub_prefixes, header.sub_prefix_count,
+        !ReadToContainer(&sub_prefixes, chunk_header.sub_prefix_count,
                          new_file_.get(), NULL) ||
-        !ReadToContainer(&add_full_hashes, header.add_hash_count,
+        !ReadToContainer(&add_full_hashes, chunk_header.add_hash_count,
                          new_file_.get(), NULL) ||
-        !ReadToContainer(&sub_full_hashes, header.sub_hash_count,
+        !ReadToContainer(&sub_full_hashes, chunk_header.sub_hash_count,
                          new_file_.get(), NULL))
       return false;
   }
@@ -642,11 +703,9 @@ bool SafeBrowsingStoreFile::DoUpdate(
   if (!FileRewind(new_file_.get()))
     return false;
 
-  base::MD5Context context;
   base::MD5Init(&context);
 
   // Write a file header.
-  FileHeader header;
   header.magic = kFileMagic;
   header.version = kFileVersion;
   header.add_chunk_count = add_chunks_cache_.size();
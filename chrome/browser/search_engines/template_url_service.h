@@ -361,10 +361,6 @@ class TemplateURLService : public WebDataServiceConsumer,
   typedef std::map<std::string, TemplateURL*> GUIDToTemplateMap;
   typedef std::list<std::string> PendingExtensionIDs;
 
-  // Helper functor for FindMatchingKeywords(), for finding the range of
-  // keywords which begin with a prefix.
-  class LessWithPrefix;
-
   void Init(const Initializer* initializers, int num_initializers);
 
   void RemoveFromMaps(TemplateURL* template_url);
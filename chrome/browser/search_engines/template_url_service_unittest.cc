@@ -462,6 +462,38 @@ TEST_F(TemplateURLServiceTest, GenerateSearchURLUsingTermsData) {
   EXPECT_TRUE(test_generate_search_url->passed());
 }
 
+TEST_F(TemplateURLServiceTest, FindMatchingKeywords) {
+  AddKeywordWithDate("name1", "foo", false, "http://foo1/{searchTerms}",
+                     std::string(), std::string(), true, std::string(),
+                     Time(), Time());
+  AddKeywordWithDate("name2", "foobar", false, "http://foo2", std::string(),
+                     std::string(), true, std::string(), Time(), Time());
+  AddKeywordWithDate("name3", "fop", false, "http://foo3/{searchTerms}",
+                     std::string(), std::string(), true, std::string(),
+                     Time(), Time());
+  AddKeywordWithDate("name4", "bar", false, "http://foo4/{searchTerms}",
+                     std::string(), std::string(), true, std::string(),
+                     Time(), Time());
+
+  std::vector<string16> matches;
+  model()->FindMatchingKeywords(ASCIIToUTF16("foo"), false, &matches);
+  ASSERT_EQ(2U, matches.size());
+  EXPECT_EQ(ASCIIToUTF16("foo"), matches[0]);
+  EXPECT_EQ(ASCIIToUTF16("foobar"), matches[1]);
+
+  matches.clear();
+  model()->FindMatchingKeywords(ASCIIToUTF16("fo"), true, &matches);
+  ASSERT_EQ(2U, matches.size());
+  EXPECT_EQ(ASCIIToUTF16("foo"), matches[0]);
+  EXPECT_EQ(ASCIIToUTF16("fop"), matches[1]);
+
+  matches.clear();
+  model()->FindMatchingKeywords(ASCIIToUTF16("fooz"), false, &matches);
+  EXPECT_TRUE(matches.empty());
+  model()->FindMatchingKeywords(ASCIIToUTF16("c"), false, &matches);
+  EXPECT_TRUE(matches.empty());
+}
+
 TEST_F(TemplateURLServiceTest, ClearBrowsingData_Keywords) {
   Time now = Time::Now();
   TimeDelta one_day = TimeDelta::FromDays(1);
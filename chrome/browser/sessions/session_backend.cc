@@ -196,7 +196,12 @@ static const char* kCurrentSessionFileName = "Current Session";
 static const char* kLastSessionFileName = "Last Session";
 
 // static
-const int SessionBackend::kFileReadBufferSize = 1024;
+const int SessionBackend::kFileReadBufferSize = 32 * 1024;
+
+// Commands are serialized into a buffer which is written out once it holds
+// this many bytes, so that resetting a large session takes a handful of writes
+// rather than three per command.
+static const size_t kFileWriteBufferSize = 64 * 1024;
 
 SessionBackend::SessionBackend(BaseSessionService::SessionType type,
                                const FilePath& path_to_dir)
@@ -309,41 +314,49 @@ bool SessionBackend::ReadCurrentSessionCommandsImpl(
 
 bool SessionBackend::AppendCommandsToFile(net::FileStream* file,
     const std::vector<SessionCommand*>& commands) {
+  std::string buffer;
+  buffer.reserve(kFileWriteBufferSize);
   for (std::vector<SessionCommand*>::const_iterator i = commands.begin();
        i != commands.end(); ++i) {
-    int wrote;
     const size_type content_size = static_cast<size_type>((*i)->size());
     const size_type total_size =  content_size + sizeof(id_type);
     if (type_ == BaseSessionService::TAB_RESTORE)
       UMA_HISTOGRAM_COUNTS("TabRestore.command_size", total_size);
     else
       UMA_HISTOGRAM_COUNTS("SessionRestore.command_size", total_size);
-    wrote = file->WriteSync(reinterpret_cast<const char*>(&total_size),
-                            sizeof(total_size));
-    if (wrote != sizeof(total_size)) {
-      NOTREACHED() << "error writing";
-      return false;
-    }
-    id_type command_id = (*i)->id();
-    wrote = file->WriteSync(reinterpret_cast<char*>(&command_id),
-                            sizeof(command_id));
-    if (wrote != sizeof(command_id)) {
-      NOTREACHED() << "error writing";
-      return false;
-    }
+    const id_type command_id = (*i)->id();
+    buffer.append(reinterpret_cast<const char*>(&total_size),
+                  sizeof(total_size));
+    buffer.append(reinterpret_cast<const char*>(&command_id),
+                  sizeof(command_id));
     if (content_size > 0) {
-      wrote = file->WriteSync(reinterpret_cast<char*>((*i)->contents()),
-                              content_size);
-      if (wrote != content_size) {
-        NOTREACHED() << "error writing";
+      buffer.append(reinterpret_cast<const char*>((*i)->contents()),
+                    content_size);
+    }
+    if (buffer.size() >= kFileWriteBufferSize) {
+      if (!WriteBufferToFile(file, &buffer))
         return false;
-      }
     }
   }
+  if (!WriteBufferToFile(file, &buffer))
+    return false;
   file->Flush();
   return true;
 }
 
+bool SessionBackend::WriteBufferToFile(net::FileStream* file,
+                                       std::string* buffer) {
+  if (buffer->empty())
+    return true;
+  const int size = static_cast<int>(buffer->size());
+  if (file->WriteSync(buffer->data(), size) != size) {
+    NOTREACHED() << "error writing";
+    return false;
+  }
+  buffer->clear();
+  return true;
+}
+
 SessionBackend::~SessionBackend() {
   if (current_session_file_.get()) {
     // Close() performs file IO. crbug.com/112512.
@@ -6,6 +6,7 @@
 #define CHROME_BROWSER_SESSIONS_SESSION_BACKEND_H_
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "base/memory/ref_counted.h"
@@ -114,6 +115,9 @@ class SessionBackend : public base::RefCountedThreadSafe<SessionBackend> {
   bool AppendCommandsToFile(net::FileStream* file,
                             const std::vector<SessionCommand*>& commands);
 
+  // Writes out and clears the serialized commands in |buffer|.
+  bool WriteBufferToFile(net::FileStream* file, std::string* buffer);
+
   const BaseSessionService::SessionType type_;
 
   // Returns the path to the last file.
@@ -155,6 +155,33 @@ TEST_F(SessionBackendTest, BigData) {
   STLDeleteElements(&commands);
 }
 
+// Writes enough commands that they are written out in several chunks and
+// read back in several buffer fills.
+TEST_F(SessionBackendTest, ManyCommands) {
+  scoped_refptr<SessionBackend> backend(
+      new SessionBackend(BaseSessionService::SESSION_RESTORE, path_));
+  const size_t kCommandCount = 2000;
+  std::vector<SessionCommand*> commands;
+  for (size_t i = 0; i < kCommandCount; ++i) {
+    TestData data = { static_cast<SessionCommand::id_type>(i % 200),
+                      std::string(100 + i % 7, 'a' + i % 26) };
+    commands.push_back(CreateCommandFromData(data));
+  }
+  backend->AppendCommands(new SessionCommands(commands), true);
+  commands.clear();
+
+  backend = NULL;
+  backend = new SessionBackend(BaseSessionService::SESSION_RESTORE, path_);
+  backend->ReadLastSessionCommandsImpl(&commands);
+  ASSERT_EQ(kCommandCount, commands.size());
+  for (size_t i = 0; i < kCommandCount; ++i) {
+    TestData data = { static_cast<SessionCommand::id_type>(i % 200),
+                      std::string(100 + i % 7, 'a' + i % 26) };
+    AssertCommandEqualsData(data, commands[i]);
+  }
+  STLDeleteElements(&commands);
+}
+
 TEST_F(SessionBackendTest, EmptyCommand) {
   TestData empty_command;
   empty_command.command_id = 1;
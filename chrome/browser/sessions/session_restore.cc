@@ -5,6 +5,7 @@
 #include "chrome/browser/sessions/session_restore.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <list>
 #include <set>
 #include <string>
@@ -66,11 +67,22 @@ std::set<SessionRestoreImpl*>* active_session_restorers = NULL;
 // Initial delay (see class decription for details).
 static const int kInitialDelayTimerMS = 100;
 
+// Maximum number of tabs loading at once (see class description for details).
+static const size_t kMaxConcurrentTabLoads = 3;
+
 // TabLoader is responsible for loading tabs after session restore creates
 // tabs. New tabs are loaded after the current tab finishes loading, or a delay
 // is reached (initially kInitialDelayTimerMS). If the delay is reached before
 // a tab finishes loading a new tab is loaded and the time of the delay
-// doubled.
+// doubled. No new tab is started while kMaxConcurrentTabLoads tabs, including
+// the selected tab of each window, are loading, so that background tabs don't
+// compete with the visible ones for the network and CPU.
+//
+// Tabs are loaded in order of their load priority, lowest first. Session
+// restore gives tabs next to the selected tab of their window the lowest
+// values, as those are the ones the user is likely to switch to first. A tab
+// the user selects before its turn loads right away and is dropped from the
+// queue.
 //
 // TabLoader keeps a reference to itself when it's loading. When it has finished
 // loading, it drops the reference. If another profile is restored while the
@@ -88,8 +100,9 @@ class TabLoader : public content::NotificationObserver,
   // starting timestamp is set to |restore_started|.
   static TabLoader* GetTabLoader(base::TimeTicks restore_started);
 
-  // Schedules a tab for loading.
-  void ScheduleLoad(NavigationController* controller);
+  // Schedules a tab for loading. Tabs with a lower |priority| are loaded
+  // first; tabs of equal priority load in the order they were scheduled.
+  void ScheduleLoad(NavigationController* controller, int priority);
 
   // Notifies the loader that a tab has been scheduled for loading through
   // some other mechanism.
@@ -104,7 +117,8 @@ class TabLoader : public content::NotificationObserver,
   friend class base::RefCounted<TabLoader>;
 
   typedef std::set<NavigationController*> TabsLoading;
-  typedef std::list<NavigationController*> TabsToLoad;
+  // Tabs waiting to load, and their priorities, ordered by priority.
+  typedef std::list<std::pair<int, NavigationController*> > TabsToLoad;
   typedef std::set<RenderWidgetHost*> RenderWidgetHostSet;
 
   explicit TabLoader(base::TimeTicks restore_started);
@@ -128,6 +142,10 @@ class TabLoader : public content::NotificationObserver,
   // from.
   void RemoveTab(NavigationController* tab);
 
+  // Returns the position of |tab| in |tabs_to_load_|, or the end of
+  // |tabs_to_load_| if it is not waiting to load.
+  TabsToLoad::iterator FindTabToLoad(NavigationController* tab);
+
   // Invoked from |force_load_timer_|. Doubles |force_load_delay_| and invokes
   // |LoadNextTab| to load the next tab
   void ForceLoadTimerFired();
@@ -192,11 +210,14 @@ TabLoader* TabLoader::GetTabLoader(base::TimeTicks restore_started) {
   return shared_tab_loader;
 }
 
-void TabLoader::ScheduleLoad(NavigationController* controller) {
+void TabLoader::ScheduleLoad(NavigationController* controller,
+                             int priority) {
   DCHECK(controller);
-  DCHECK(find(tabs_to_load_.begin(), tabs_to_load_.end(), controller) ==
-         tabs_to_load_.end());
-  tabs_to_load_.push_back(controller);
+  DCHECK(FindTabToLoad(controller) == tabs_to_load_.end());
+  TabsToLoad::iterator i = tabs_to_load_.begin();
+  while (i != tabs_to_load_.end() && i->first <= priority)
+    ++i;
+  tabs_to_load_.insert(i, std::make_pair(priority, controller));
   RegisterForNotifications(controller);
 }
 
@@ -251,8 +272,9 @@ TabLoader::~TabLoader() {
 }
 
 void TabLoader::LoadNextTab() {
-  if (!tabs_to_load_.empty()) {
-    NavigationController* tab = tabs_to_load_.front();
+  if (!tabs_to_load_.empty() &&
+      tabs_loading_.size() < kMaxConcurrentTabLoads) {
+    NavigationController* tab = tabs_to_load_.front().second;
     DCHECK(tab);
     tabs_loading_.insert(tab);
     if (tabs_loading_.size() > max_parallel_tab_loads_)
@@ -298,6 +320,14 @@ void TabLoader::Observe(int type,
       RenderWidgetHost* render_widget_host = GetRenderWidgetHost(tab);
       DCHECK(render_widget_host);
       render_widget_hosts_loading_.insert(render_widget_host);
+
+      // A tab still waiting its turn has been selected by the user, and
+      // started loading by itself.
+      TabsToLoad::iterator i = FindTabToLoad(tab);
+      if (i != tabs_to_load_.end()) {
+        tabs_to_load_.erase(i);
+        tabs_loading_.insert(tab);
+      }
       break;
     }
     case content::NOTIFICATION_WEB_CONTENTS_DESTROYED: {
@@ -392,12 +422,19 @@ void TabLoader::RemoveTab(NavigationController* tab) {
   if (i != tabs_loading_.end())
     tabs_loading_.erase(i);
 
-  TabsToLoad::iterator j =
-      find(tabs_to_load_.begin(), tabs_to_load_.end(), tab);
+  TabsToLoad::iterator j = FindTabToLoad(tab);
   if (j != tabs_to_load_.end())
     tabs_to_load_.erase(j);
 }
 
+TabLoader::TabsToLoad::iterator TabLoader::FindTabToLoad(
+    NavigationController* tab) {
+  TabsToLoad::iterator i = tabs_to_load_.begin();
+  while (i != tabs_to_load_.end() && i->second != tab)
+    ++i;
+  return i;
+}
+
 void TabLoader::ForceLoadTimerFired() {
   force_load_delay_ *= 2;
   LoadNextTab();
@@ -838,16 +875,19 @@ class SessionRestoreImpl : public content::NotificationObserver {
       const int tab_index = static_cast<int>(i - window.tabs.begin()) +
           initial_tab_count;
       // Don't schedule a load for the selected tab, as ShowBrowser() will
-      // already have done that.
-      RestoreTab(tab, tab_index, browser,
-                 tab_index != (selected_tab_index + initial_tab_count));
+      // already have done that. The others load outwards from it.
+      const int distance_from_selected =
+          std::abs(tab_index - (selected_tab_index + initial_tab_count));
+      RestoreTab(tab, tab_index, browser, distance_from_selected != 0,
+                 distance_from_selected);
     }
   }
 
   void RestoreTab(const SessionTab& tab,
                   const int tab_index,
                   Browser* browser,
-                  bool schedule_load) {
+                  bool schedule_load,
+                  int load_priority) {
     DCHECK(!tab.navigations.empty());
     int selected_index = tab.current_navigation_index;
     selected_index = std::max(
@@ -888,7 +928,8 @@ class SessionRestoreImpl : public content::NotificationObserver {
     }
 
     if (schedule_load)
-      tab_loader_->ScheduleLoad(&web_contents->GetController());
+      tab_loader_->ScheduleLoad(&web_contents->GetController(),
+                                load_priority);
   }
 
   Browser* CreateRestoredBrowser(Browser::Type type,
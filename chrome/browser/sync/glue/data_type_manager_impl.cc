@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <set>
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
@@ -312,21 +313,42 @@ void DataTypeManagerImpl::DownloadReady(
   }
 
   state_ = CONFIGURING;
-  StartNextType();
+  StartTypes();
 }
 
-void DataTypeManagerImpl::StartNextType() {
-  // If there are any data types left to start, start the one at the
-  // front of the list.
-  if (!needs_start_.empty()) {
-    DVLOG(1) << "Starting " << needs_start_[0]->name();
-    TRACE_EVENT_BEGIN1("sync", "ModelAssociation",
-                       "DataType", ModelTypeToString(needs_start_[0]->type()));
-    needs_start_[0]->Start(base::Bind(&DataTypeManagerImpl::TypeStartCallback,
-                                      weak_ptr_factory_.GetWeakPtr()));
-    return;
+void DataTypeManagerImpl::StartTypes() {
+  // Data types of the same model safe group still start one at a time, in
+  // kStartOrder, since they share a model thread.  Controllers may call back
+  // synchronously from Start(), which re-enters this method, so look for the
+  // next type to start afresh each time.
+  while (true) {
+    std::set<ModelSafeGroup> busy_groups;
+    for (size_t i = 0; i < starting_.size(); ++i)
+      busy_groups.insert(starting_[i]->model_safe_group());
+
+    std::vector<DataTypeController*>::iterator it = needs_start_.begin();
+    while (it != needs_start_.end() &&
+           busy_groups.count((*it)->model_safe_group())) {
+      ++it;
+    }
+    if (it == needs_start_.end())
+      break;
+
+    DataTypeController* dtc = *it;
+    needs_start_.erase(it);
+    starting_.push_back(dtc);
+    DVLOG(1) << "Starting " << dtc->name();
+    TRACE_EVENT_ASYNC_BEGIN1("sync", "ModelAssociation", dtc,
+                             "DataType", ModelTypeToString(dtc->type()));
+    dtc->Start(base::Bind(&DataTypeManagerImpl::TypeStartCallback,
+                          weak_ptr_factory_.GetWeakPtr(), dtc));
+    if (state_ != CONFIGURING)
+      return;
   }
 
+  if (!starting_.empty())
+    return;
+
   DCHECK_EQ(state_, CONFIGURING);
   if (ProcessReconfigure()) {
     return;
@@ -355,34 +377,23 @@ void DataTypeManagerImpl::StartNextType() {
 }
 
 void DataTypeManagerImpl::TypeStartCallback(
+    DataTypeController* started_dtc,
     DataTypeController::StartResult result,
     const SyncError& error) {
   // When the data type controller invokes this callback, it must be
   // on the UI thread.
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI));
 
-  TRACE_EVENT_END0("sync", "ModelAssociation");
+  TRACE_EVENT_ASYNC_END0("sync", "ModelAssociation", started_dtc);
 
-  if (state_ == STOPPING) {
-    // If we reach this callback while stopping, this means that
-    // DataTypeManager::Stop() was called while the current data type
-    // was starting.  Now that it has finished starting, we can finish
-    // stopping the DataTypeManager.  This is considered an ABORT.
-    Abort(ABORTED, SyncError());
-    return;
-  }
-
-  if (state_ == STOPPED) {
-    // We shouldn't be getting called back if we got stopped.
-    NOTREACHED();
-    return;
-  }
+  // Callbacks are dropped once we stop, so we must still be configuring.
+  DCHECK_EQ(CONFIGURING, state_);
 
-  // We're done with the data type at the head of the list -- remove it.
-  DataTypeController* started_dtc = needs_start_[0];
-  DCHECK(needs_start_.size());
-  DCHECK_EQ(needs_start_[0], started_dtc);
-  needs_start_.erase(needs_start_.begin());
+  // We're done with this data type -- remove it.
+  std::vector<DataTypeController*>::iterator it =
+      std::find(starting_.begin(), starting_.end(), started_dtc);
+  DCHECK(it != starting_.end());
+  starting_.erase(it);
 
   if (result == DataTypeController::ASSOCIATION_FAILED) {
     failed_datatypes_info_.push_back(error);
@@ -401,7 +412,7 @@ void DataTypeManagerImpl::TypeStartCallback(
       result == DataTypeController::OK ||
       result == DataTypeController::OK_FIRST_RUN ||
       result == DataTypeController::ASSOCIATION_FAILED) {
-    StartNextType();
+    StartTypes();
     return;
   }
 
@@ -422,6 +433,10 @@ void DataTypeManagerImpl::TypeStartCallback(
       break;
   }
 
+  // Drop the start callbacks of the other types still starting, since
+  // Abort() stops them.
+  weak_ptr_factory_.InvalidateWeakPtrs();
+  starting_.clear();
   Abort(configure_status, error);
 }
 
@@ -430,20 +445,14 @@ void DataTypeManagerImpl::Stop() {
   if (state_ == STOPPED)
     return;
 
-  // If we are currently configuring, then the current type is in a
-  // partially started state.  Abort the startup of the current type,
-  // which will synchronously invoke the start callback.
+  // If we are currently configuring, then the types being started are in a
+  // partially started state.  Drop their start callbacks and abort; stopping
+  // them in FinishStop() cancels their startup.
   if (state_ == CONFIGURING) {
     state_ = STOPPING;
-
-    DCHECK_LT(0U, needs_start_.size());
-    needs_start_[0]->Stop();
-
-    // By this point, the datatype should have invoked the start callback,
-    // triggering FinishStop to be called, and the state to reach STOPPED. If we
-    // aren't STOPPED, it means that a datatype controller didn't call the start
-    // callback appropriately.
-    DCHECK_EQ(STOPPED, state_);
+    weak_ptr_factory_.InvalidateWeakPtrs();
+    starting_.clear();
+    Abort(ABORTED, SyncError());
     return;
   }
 
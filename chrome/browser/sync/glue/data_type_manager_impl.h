@@ -41,13 +41,15 @@ class DataTypeManagerImpl : public DataTypeManager {
   virtual State state() const OVERRIDE;
 
  private:
-  // Starts the next data type in the kStartOrder list, indicated by
-  // the current_type_ member.  If there are no more data types to
-  // start, the stashed start_callback_ is invoked.
-  void StartNextType();
+  // Starts the first data type in |needs_start_| of every model safe group
+  // that has no data type starting, so that types on different model threads
+  // associate concurrently.  If there are no more data types to start,
+  // finishes configuring.
+  void StartTypes();
 
   // Callback passed to each data type controller on startup.
-  void TypeStartCallback(DataTypeController::StartResult result,
+  void TypeStartCallback(DataTypeController* started_dtc,
+                         DataTypeController::StartResult result,
                          const SyncError& error);
 
   // Stops all data types.
@@ -94,6 +96,10 @@ class DataTypeManagerImpl : public DataTypeManager {
   std::vector<DataTypeController*> needs_start_;
   std::vector<DataTypeController*> needs_stop_;
 
+  // Data types that have been started but haven't called back yet, at most
+  // one per model safe group.
+  std::vector<DataTypeController*> starting_;
+
   // Whether an attempt to reconfigure was made while we were busy configuring.
   // The |last_requested_types_| will reflect the newest set of requested types.
   bool needs_reconfigure_;
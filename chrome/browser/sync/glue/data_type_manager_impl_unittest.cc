@@ -74,7 +74,11 @@ class FakeBackendDataTypeConfigurer : public BackendDataTypeConfigurer {
 class FakeDataTypeController : public DataTypeController {
  public:
   explicit FakeDataTypeController(ModelType type)
-      : state_(NOT_RUNNING), type_(type) {}
+      : state_(NOT_RUNNING), type_(type), model_safe_group_(GROUP_PASSIVE) {}
+
+  void set_model_safe_group(ModelSafeGroup group) {
+    model_safe_group_ = group;
+  }
 
   // NOT_RUNNING -> MODEL_STARTING
   virtual void Start(const StartCallback& start_callback) {
@@ -145,10 +149,8 @@ class FakeDataTypeController : public DataTypeController {
     return ModelTypeToString(type_);
   }
 
-  // This isn't called by the DTM.
   virtual browser_sync::ModelSafeGroup model_safe_group() const {
-    ADD_FAILURE();
-    return browser_sync::GROUP_PASSIVE;
+    return model_safe_group_;
   }
 
   virtual State state() const {
@@ -178,6 +180,7 @@ class FakeDataTypeController : public DataTypeController {
 
   State state_;
   ModelType type_;
+  ModelSafeGroup model_safe_group_;
   StartCallback last_start_callback_;
 };
 
@@ -690,6 +693,65 @@ TEST_P(SyncDataTypeManagerImplTest, OneControllerFailsAssociation) {
   EXPECT_EQ(DataTypeManager::STOPPED, dtm.state());
 }
 
+// Set up a DTM with two controllers on different model threads,
+// configure it and finish downloading.  Both controllers should start
+// right away, and the DTM should be configured once both have finished,
+// in whichever order.
+TEST_P(SyncDataTypeManagerImplTest, ConfigureConcurrentlyAcrossGroups) {
+  AddController(BOOKMARKS);
+  AddController(PASSWORDS);
+  GetController(BOOKMARKS)->set_model_safe_group(GROUP_UI);
+  GetController(PASSWORDS)->set_model_safe_group(GROUP_PASSWORD);
+
+  DataTypeManagerImpl dtm(&configurer_, &controllers_);
+  SetConfigureStartExpectation();
+  SetConfigureDoneExpectation(DataTypeManager::OK);
+
+  Configure(&dtm, ModelTypeSet(BOOKMARKS, PASSWORDS));
+  FinishDownload(dtm, ModelTypeSet());
+  EXPECT_EQ(DataTypeManager::CONFIGURING, dtm.state());
+  EXPECT_EQ(DataTypeController::MODEL_STARTING,
+            GetController(BOOKMARKS)->state());
+  EXPECT_EQ(DataTypeController::MODEL_STARTING,
+            GetController(PASSWORDS)->state());
+
+  GetController(PASSWORDS)->FinishStart(DataTypeController::OK);
+  EXPECT_EQ(DataTypeManager::CONFIGURING, dtm.state());
+
+  GetController(BOOKMARKS)->FinishStart(DataTypeController::OK);
+  EXPECT_EQ(DataTypeManager::CONFIGURED, dtm.state());
+
+  dtm.Stop();
+  EXPECT_EQ(DataTypeManager::STOPPED, dtm.state());
+}
+
+// Set up a DTM with two controllers on different model threads,
+// configure it, finish downloading, and stop the DTM while both
+// controllers are starting.  The DTM should be aborted once, and both
+// controllers stopped.
+TEST_P(SyncDataTypeManagerImplTest, StopWhileStartingAcrossGroups) {
+  AddController(BOOKMARKS);
+  AddController(PASSWORDS);
+  GetController(BOOKMARKS)->set_model_safe_group(GROUP_UI);
+  GetController(PASSWORDS)->set_model_safe_group(GROUP_PASSWORD);
+
+  DataTypeManagerImpl dtm(&configurer_, &controllers_);
+  SetConfigureStartExpectation();
+  SetConfigureDoneExpectation(DataTypeManager::ABORTED);
+
+  Configure(&dtm, ModelTypeSet(BOOKMARKS, PASSWORDS));
+  FinishDownload(dtm, ModelTypeSet());
+  GetController(PASSWORDS)->StartModel();
+  EXPECT_EQ(DataTypeManager::CONFIGURING, dtm.state());
+
+  dtm.Stop();
+  EXPECT_EQ(DataTypeManager::STOPPED, dtm.state());
+  EXPECT_EQ(DataTypeController::NOT_RUNNING,
+            GetController(BOOKMARKS)->state());
+  EXPECT_EQ(DataTypeController::NOT_RUNNING,
+            GetController(PASSWORDS)->state());
+}
+
 // Set up a DTM with two controllers.  Then:
 //
 //   1) Configure with first controller.
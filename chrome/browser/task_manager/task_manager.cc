@@ -534,6 +534,14 @@ bool TaskManagerModel::GetSharedMemory(int index, size_t* result) const {
 
 bool TaskManagerModel::GetPhysicalMemory(int index, size_t* result) const {
   *result = 0;
+  base::ProcessHandle handle = resources_[index]->GetProcess();
+  PhysicalMemoryUsageMap::const_iterator iter =
+      physical_memory_usage_map_.find(handle);
+  if (iter != physical_memory_usage_map_.end()) {
+    *result = iter->second;
+    return true;
+  }
+
   base::ProcessMetrics* process_metrics;
   if (!GetProcessMetricsForRow(index, &process_metrics))
     return false;
@@ -545,6 +553,7 @@ bool TaskManagerModel::GetPhysicalMemory(int index, size_t* result) const {
   // We exclude the shared memory.
   size_t total_bytes = process_metrics->GetWorkingSetSize();
   total_bytes -= ws_usage.shared * 1024;
+  physical_memory_usage_map_[handle] = total_bytes;
   *result = total_bytes;
   return true;
 }
@@ -878,6 +887,7 @@ void TaskManagerModel::Refresh() {
 
   // Clear the memory values so they can be querried lazily.
   memory_usage_map_.clear();
+  physical_memory_usage_map_.clear();
 
   // Compute the new network usage values.
   displayed_network_usage_map_.clear();
@@ -462,6 +462,7 @@ class TaskManagerModel : public base::RefCountedThreadSafe<TaskManagerModel> {
   // Private memory in bytes, shared memory in bytes.
   typedef std::pair<size_t, size_t> MemoryUsageEntry;
   typedef std::map<base::ProcessHandle, MemoryUsageEntry> MemoryUsageMap;
+  typedef std::map<base::ProcessHandle, size_t> PhysicalMemoryUsageMap;
 
   // Updates the values for all rows.
   void Refresh();
@@ -536,6 +537,11 @@ class TaskManagerModel : public base::RefCountedThreadSafe<TaskManagerModel> {
   // every Refresh().
   mutable MemoryUsageMap memory_usage_map_;
 
+  // A map that contains the physical memory usage of the process. Like
+  // |memory_usage_map_|, it is filled lazily and cleared on every Refresh(),
+  // so that sorting by this column doesn't query each process O(log n) times.
+  mutable PhysicalMemoryUsageMap physical_memory_usage_map_;
+
   ObserverList<TaskManagerModelObserver> observer_list_;
 
   // How many calls to StartUpdating have been made without matching calls to
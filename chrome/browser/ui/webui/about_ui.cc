@@ -12,6 +12,7 @@
 #include "base/bind_helpers.h"
 #include "base/callback.h"
 #include "base/command_line.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/file_util.h"
 #include "base/i18n/number_formatting.h"
 #include "base/json/json_writer.h"
@@ -54,6 +55,7 @@
 #include "content/public/browser/web_contents.h"
 #include "content/public/browser/web_ui.h"
 #include "content/public/common/content_client.h"
+#include "content/public/common/content_switches.h"
 #include "content/public/common/process_type.h"
 #include "crypto/nss_util.h"
 #include "googleurl/src/gurl.h"
@@ -816,6 +818,50 @@ std::string AboutHistograms(const std::string& query) {
   return data;
 }
 
+// Handler for the "about:memory-internals" page, which shows the browser
+// process's live heap broken down by the subsystem that allocated it. |query|
+// is the number of seconds between refreshes, if any. The child processes
+// report the same numbers as "memory" counters in about:tracing.
+std::string AboutMemoryInternals(const std::string& query) {
+  int refresh = 0;
+  base::StringToInt(query, &refresh);
+
+  std::string data;
+  AppendHeader(&data, refresh, "About Memory Internals");
+  AppendBody(&data);
+  data.append("<h2>Browser process heap by subsystem</h2>\n");
+  if (!base::debug::IsHeapTaggingEnabled()) {
+    data.append("<p>Heap tagging is disabled. Start the browser with --");
+    data.append(switches::kEnableHeapTagging);
+    data.append(" to enable it.</p>\n");
+    AppendFooter(&data);
+    return data;
+  }
+
+  base::debug::HeapTagStats stats[base::debug::HEAP_TAG_COUNT];
+  base::debug::GetHeapTagStats(stats);
+  data.append("<table border=1>\n<tr><th>Subsystem</th><th>Live KB</th>"
+              "<th>Live samples</th><th>Allocated KB</th></tr>\n");
+  for (int i = 0; i < base::debug::HEAP_TAG_COUNT; ++i) {
+    base::debug::HeapTag tag = static_cast<base::debug::HeapTag>(i);
+    data.append("<tr><td>");
+    data.append(base::debug::GetHeapTagName(tag));
+    data.append("</td><td>");
+    data.append(base::Int64ToString(stats[i].live_bytes / 1024));
+    data.append("</td><td>");
+    data.append(base::Int64ToString(stats[i].live_samples));
+    data.append("</td><td>");
+    data.append(base::Int64ToString(stats[i].total_bytes / 1024));
+    data.append("</td></tr>\n");
+  }
+  data.append("</table>\n<p>Sizes are estimated from sampled allocations. "
+              "A live size that keeps growing points at a leak. To refresh "
+              "this page automatically, load about:memory-internals/&lt;secs"
+              "&gt;.</p>\n");
+  AppendFooter(&data);
+  return data;
+}
+
 void FinishMemoryDataRequest(const std::string& path,
                              AboutUIHTMLSource* source,
                              int request_id) {
@@ -1401,6 +1447,8 @@ void AboutUIHTMLSource::StartDataRequest(const std::string& path,
 #endif
   } else if (host == chrome::kChromeUIMemoryHost) {
     response = GetAboutMemoryRedirectResponse(profile());
+  } else if (host == chrome::kChromeUIMemoryInternalsHost) {
+    response = AboutMemoryInternals(path);
   } else if (host == chrome::kChromeUIMemoryRedirectHost) {
     FinishMemoryDataRequest(path, this, request_id);
     return;
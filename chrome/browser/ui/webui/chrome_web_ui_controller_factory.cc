@@ -316,6 +316,7 @@ WebUIFactoryFunction GetWebUIFactoryFunction(WebUI* web_ui,
       url.host() == chrome::kChromeUIDNSHost ||
       url.host() == chrome::kChromeUIHistogramsHost ||
       url.host() == chrome::kChromeUIMemoryHost ||
+      url.host() == chrome::kChromeUIMemoryInternalsHost ||
       url.host() == chrome::kChromeUIMemoryRedirectHost ||
       url.host() == chrome::kChromeUIStatsHost ||
       url.host() == chrome::kChromeUITermsHost ||
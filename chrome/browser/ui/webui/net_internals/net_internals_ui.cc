@@ -26,6 +26,7 @@
 #include "base/string_piece.h"
 #include "base/string_split.h"
 #include "base/string_util.h"
+#include "base/synchronization/lock.h"
 #include "base/utf_string_conversions.h"
 #include "base/values.h"
 #include "chrome/browser/browser_process.h"
@@ -444,11 +445,6 @@ class NetInternalsMessageHandler::IOThreadImpl
 
   ~IOThreadImpl();
 
-  // Adds |entry| to the queue of pending log entries to be sent to the page via
-  // Javascript.  Must be called on the IO Thread.  Also creates a delayed task
-  // that will call PostPendingEntries, if there isn't one already.
-  void AddEntryToQueue(Value* entry);
-
   // Sends all pending entries to the page via Javascript, and clears the list
   // of pending entries.  Sending multiple entries at once results in a
   // significant reduction of CPU usage when a lot of events are happening.
@@ -477,8 +473,11 @@ class NetInternalsMessageHandler::IOThreadImpl
 
   // Log entries that have yet to be passed along to Javascript page.  Non-NULL
   // when and only when there is a pending delayed task to call
-  // PostPendingEntries.  Read and written to exclusively on the IO Thread.
+  // PostPendingEntries.  Entries are added by OnAddEntry, on whichever thread
+  // logged them, so that only one task is posted to the IO thread per batch
+  // rather than one per entry.  Protected by |pending_entries_lock_|.
   scoped_ptr<ListValue> pending_entries_;
+  base::Lock pending_entries_lock_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1444,28 +1443,32 @@ void NetInternalsMessageHandler::IOThreadImpl::OnAddEntry(
     const net::NetLog::Source& source,
     net::NetLog::EventPhase phase,
     net::NetLog::EventParameters* params) {
-  BrowserThread::PostTask(
-      BrowserThread::IO, FROM_HERE,
-      base::Bind(&IOThreadImpl::AddEntryToQueue, this,
-          net::NetLog::EntryToDictionaryValue(type, time, source, phase,
-                                              params, false)));
-}
-
-void NetInternalsMessageHandler::IOThreadImpl::AddEntryToQueue(Value* entry) {
-  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
+  Value* entry = net::NetLog::EntryToDictionaryValue(type, time, source, phase,
+                                                     params, false);
+  base::AutoLock lock(pending_entries_lock_);
   if (!pending_entries_.get()) {
+    // The IO thread is gone during shutdown, when there's no page to send the
+    // entries to anyway.
+    if (!BrowserThread::PostDelayedTask(
+            BrowserThread::IO, FROM_HERE,
+            base::Bind(&IOThreadImpl::PostPendingEntries, this),
+            base::TimeDelta::FromMilliseconds(kNetLogEventDelayMilliseconds))) {
+      delete entry;
+      return;
+    }
     pending_entries_.reset(new ListValue());
-    BrowserThread::PostDelayedTask(
-        BrowserThread::IO, FROM_HERE,
-        base::Bind(&IOThreadImpl::PostPendingEntries, this),
-        base::TimeDelta::FromMilliseconds(kNetLogEventDelayMilliseconds));
   }
   pending_entries_->Append(entry);
 }
 
 void NetInternalsMessageHandler::IOThreadImpl::PostPendingEntries() {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::IO));
-  SendJavascriptCommand("receivedLogEntries", pending_entries_.release());
+  ListValue* entries;
+  {
+    base::AutoLock lock(pending_entries_lock_);
+    entries = pending_entries_.release();
+  }
+  SendJavascriptCommand("receivedLogEntries", entries);
 }
 
 void NetInternalsMessageHandler::IOThreadImpl::OnStartConnectionTestSuite() {
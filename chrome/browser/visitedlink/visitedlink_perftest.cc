@@ -12,6 +12,7 @@
 #include "base/shared_memory.h"
 #include "base/stringprintf.h"
 #include "base/test/test_file_util.h"
+#include "base/time.h"
 #include "chrome/browser/visitedlink/visitedlink_master.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -44,6 +45,20 @@ class DummyVisitedLinkEventListener : public VisitedLinkMaster::Listener {
   }
 };
 
+// Counts the tables the master hands out, which it does once per resize.
+class TableCountingListener : public VisitedLinkMaster::Listener {
+ public:
+  TableCountingListener() : new_table_count_(0) {}
+  virtual void NewTable(base::SharedMemory* table) { new_table_count_++; }
+  virtual void Add(VisitedLinkCommon::Fingerprint) {}
+  virtual void Reset() {}
+
+  int new_table_count() const { return new_table_count_; }
+
+ private:
+  int new_table_count_;
+};
+
 
 // this checks IsVisited for the URLs starting with the given prefix and
 // within the given range
@@ -70,6 +85,50 @@ class VisitedLink : public testing::Test {
   virtual void TearDown() {
     file_util::Delete(db_path_, false);
   }
+
+  // Adds |count| URLs one at a time to a fresh table, and logs how long an add
+  // takes on average, and how long the adds that resized the table took.
+  void MeasureAddAndResize(int count) {
+    FilePath db_path;
+    ASSERT_TRUE(file_util::CreateTemporaryFile(&db_path));
+    TableCountingListener listener;
+    VisitedLinkMaster master(&listener, NULL, true, db_path, 0);
+    ASSERT_TRUE(master.Init());
+
+    TimeDelta add_time;
+    TimeDelta resize_time;
+    TimeDelta max_resize_time;
+    int resize_count = 0;
+    for (int i = 0; i < count; i++) {
+      GURL url = TestURL(added_prefix, i);
+      int new_table_count = listener.new_table_count();
+      base::TimeTicks start = base::TimeTicks::HighResNow();
+      master.AddURL(url);
+      TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+      if (listener.new_table_count() == new_table_count) {
+        add_time += elapsed;
+      } else {
+        resize_time += elapsed;
+        max_resize_time = std::max(max_resize_time, elapsed);
+        resize_count++;
+      }
+    }
+
+    std::string suffix = base::StringPrintf("_%dM", count / 1000000);
+    LogPerfResult(("Visited_link_add_time" + suffix).c_str(),
+                  add_time.InMicroseconds() /
+                      static_cast<double>(count - resize_count),
+                  "us");
+    LogPerfResult(("Visited_link_resize_count" + suffix).c_str(),
+                  resize_count, "resizes");
+    if (resize_count > 0) {
+      LogPerfResult(("Visited_link_resize_time" + suffix).c_str(),
+                    resize_time.InMillisecondsF() / resize_count, "ms");
+      LogPerfResult(("Visited_link_max_resize_time" + suffix).c_str(),
+                    max_resize_time.InMillisecondsF(), "ms");
+    }
+    file_util::Delete(db_path, false);
+  }
 };
 
 } // namespace
@@ -106,6 +165,13 @@ TEST_F(VisitedLink, TestAddAndQuery) {
   CheckVisited(master, unadded_prefix, 0, add_count);
 }
 
+// Measures the cost of adds and of the resizes they trigger as the table grows
+// to profile-sized numbers of entries.
+TEST_F(VisitedLink, TestAddAndResize) {
+  MeasureAddAndResize(1000000);
+  MeasureAddAndResize(10000000);
+}
+
 // Tests how long it takes to write and read a large database to and from disk.
 TEST_F(VisitedLink, TestLoad) {
   // create a big DB
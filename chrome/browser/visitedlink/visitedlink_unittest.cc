@@ -50,9 +50,11 @@ class TrackingVisitedLinkEventListener : public VisitedLinkMaster::Listener {
  public:
   TrackingVisitedLinkEventListener()
       : reset_count_(0),
-        add_count_(0) {}
+        add_count_(0),
+        new_table_count_(0) {}
 
   virtual void NewTable(base::SharedMemory* table) {
+    new_table_count_++;
     if (table) {
       for (std::vector<VisitedLinkSlave>::size_type i = 0;
            i < g_slaves.size(); i++) {
@@ -68,14 +70,17 @@ class TrackingVisitedLinkEventListener : public VisitedLinkMaster::Listener {
   void SetUp() {
     reset_count_ = 0;
     add_count_ = 0;
+    new_table_count_ = 0;
   }
 
   int reset_count() const { return reset_count_; }
   int add_count() const { return add_count_; }
+  int new_table_count() const { return new_table_count_; }
 
  private:
   int reset_count_;
   int add_count_;
+  int new_table_count_;
 };
 
 class VisitedLinkTest : public testing::Test {
@@ -437,6 +442,27 @@ TEST_F(VisitedLinkTest, BigImport) {
   ASSERT_EQ(used_count, total_count);
 }
 
+// Adding a batch of URLs should grow the table straight to a size that holds
+// all of them, rather than through every size in between.
+TEST_F(VisitedLinkTest, AddURLsResizesOnce) {
+  ASSERT_TRUE(InitHistory());
+  ASSERT_TRUE(InitVisited(0, true));
+
+  // Enough to outgrow the default table size twice over if added one by one.
+  const int kURLCount = 20000;
+  std::vector<GURL> urls;
+  for (int i = 0; i < kURLCount; i++)
+    urls.push_back(TestURL(i));
+
+  int new_table_count = listener_.new_table_count();
+  master_->AddURLs(urls);
+  EXPECT_EQ(new_table_count + 1, listener_.new_table_count());
+  EXPECT_EQ(kURLCount, master_->GetUsedCount());
+
+  for (int i = 0; i < kURLCount; i++)
+    EXPECT_TRUE(master_->IsVisited(TestURL(i)));
+}
+
 TEST_F(VisitedLinkTest, Listener) {
   ASSERT_TRUE(InitHistory());
   ASSERT_TRUE(InitVisited(0, true));
@@ -441,11 +441,22 @@ const char kDnsPrefetchDisable[]            = "dns-prefetch-disable";
 // Replaces the download shelf with a new experimental UI.
 const char kDownloadsNewUI[]                = "downloads-new-ui";
 
+// Lets requests and SPDY streams already in progress finish when the IP
+// address changes, instead of aborting them. Only new requests use the new
+// network.
+const char kDrainConnectionsOnNetworkChange[] =
+    "drain-connections-on-network-change";
+
 // Dump any accumualted histograms to the log when browser terminates (requires
 // logging to be enabled to really do anything). Used by developers and test
 // scripts.
 const char kDumpHistogramsOnExit[]          = "dump-histograms-on-exit";
 
+// Uploads a crash dump, without crashing, the first time a watched browser
+// thread hangs and the browser isn't crashed for it. The dump has the stack of
+// the hung thread.
+const char kDumpOnHang[]                    = "dump-on-hang";
+
 // Enables the Action Box toolbar UI.
 const char kEnableActionBox[]               = "enable-action-box";
 
@@ -480,6 +491,10 @@ const char kEnableBrowserActionsForAll[]    = "enable-browser-actions-for-all";
 // Enables the bundled PPAPI version of Flash.
 const char kEnableBundledPpapiFlash[]       = "enable-bundled-ppapi-flash";
 
+// Saves the results of certificate verifications in the user data dir, so
+// that they can be reused after a restart while they are fresh.
+const char kEnableCertVerifierDiskCache[]   = "enable-cert-verifier-disk-cache";
+
 // Enables the new ClientOAuth signin flow for connecting a profile a Google
 // account.  When disabled, Chrome will use the ClientLogin flow instead.
 const char kEnableClientOAuthSignin[]       = "enable-client-oauth-signin";
@@ -595,9 +610,18 @@ const char kEnableProfiling[]               = "enable-profiling";
 // supported server-side for searches on google.com.
 const char kEnableSdch[]                    = "enable-sdch";
 
+// Keeps a spare connected socket for hosts that are requested often, so that
+// their next request doesn't wait for a new connection.
+const char kEnableSocketWarmPool[]          = "enable-socket-warm-pool";
+
 // Enable SPDY/3. This is a temporary testing flag.
 const char kEnableSpdy3[]                   = "enable-spdy3";
 
+// Enables learning which subresources each page loads and prefetching the
+// likely ones into the HTTP cache when a navigation to the page starts.
+const char kEnableSpeculativeResourcePrefetching[] =
+    "enable-speculative-resource-prefetching";
+
 // Enables the stacked tabstrip.
 const char kEnableStackedTabStrip[]         = "enable-stacked-tab-strip";
 
@@ -1039,6 +1063,11 @@ const char kProfilingOutputFile[]           = "profiling-output-file";
 // specified.
 const char kProfilingFlush[]                = "profiling-flush";
 
+// Profiles only about one in this many tasks in the browser process, scaling
+// up the counts and times of the profiled ones in about:profiler. Takes an
+// integer interval; 1 profiles every task.
+const char kProfilingSamplingInterval[]     = "profiling-sampling-interval";
+
 // Specifies a custom URL for fetching NTP promo data.
 const char kPromoServerURL[]                = "promo-server-url";
 
@@ -130,7 +130,9 @@ extern const char kDiskCacheSize[];
 extern const char kDnsLogDetails[];
 extern const char kDnsPrefetchDisable[];
 extern const char kDownloadsNewUI[];
+extern const char kDrainConnectionsOnNetworkChange[];
 extern const char kDumpHistogramsOnExit[];
+extern const char kDumpOnHang[];
 extern const char kEnableActionBox[];
 extern const char kEnableAeroPeekTabs[];
 extern const char kEnableAsyncDns[];
@@ -140,6 +142,7 @@ extern const char kEnableAutologin[];
 extern const char kEnableBenchmarking[];
 extern const char kEnableBrowserActionsForAll[];
 extern const char kEnableBundledPpapiFlash[];
+extern const char kEnableCertVerifierDiskCache[];
 extern const char kEnableClientOAuthSignin[];
 extern const char kEnableChromeToMobile[];
 extern const char kEnableCloudPrintProxy[];
@@ -169,8 +172,10 @@ extern const char kEnablePnacl[];
 extern const char kEnableProfiling[];
 extern const char kEnableResourceContentSettings[];
 extern const char kEnableSdch[];
+extern const char kEnableSocketWarmPool[];
 extern const char kEnableSpdy3[];
 extern const char kEnableSpdyFlowControl[];
+extern const char kEnableSpeculativeResourcePrefetching[];
 extern const char kEnableStackedTabStrip[];
 extern const char kEnableSuggestionsTabPage[];
 extern const char kEnableSyncSignin[];
@@ -283,6 +288,7 @@ extern const char kProfilingAtStart[];
 extern const char kProfilingFile[];
 extern const char kProfilingFlush[];
 extern const char kProfilingOutputFile[];
+extern const char kProfilingSamplingInterval[];
 extern const char kPromoServerURL[];
 extern const char kProtector[];
 extern const char kProxyAutoDetect[];
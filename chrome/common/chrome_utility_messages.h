@@ -42,6 +42,7 @@ IPC_STRUCT_TRAITS_BEGIN(UpdateManifest::Result)
   IPC_STRUCT_TRAITS_MEMBER(browser_min_version)
   IPC_STRUCT_TRAITS_MEMBER(package_hash)
   IPC_STRUCT_TRAITS_MEMBER(crx_url)
+  IPC_STRUCT_TRAITS_MEMBER(diff_crx_url)
 IPC_STRUCT_TRAITS_END()
 
 IPC_STRUCT_TRAITS_BEGIN(UpdateManifest::Results)
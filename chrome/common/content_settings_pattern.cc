@@ -447,7 +447,7 @@ bool ContentSettingsPattern::Matches(
         parts_.path == std::string(local_url->path());
 
   // Match the host part.
-  const std::string host(net::TrimEndingDot(local_url->host()));
+  const std::string host(GetURLHost(url));
   if (!parts_.has_domain_wildcard) {
     if (parts_.host != host)
       return false;
@@ -478,6 +478,23 @@ bool ContentSettingsPattern::Matches(
   return true;
 }
 
+// static
+std::string ContentSettingsPattern::GetURLHost(const GURL& url) {
+  const GURL* local_url = &url;
+  if (url.SchemeIsFileSystem() && url.inner_url())
+    local_url = url.inner_url();
+  return net::TrimEndingDot(local_url->host());
+}
+
+std::string ContentSettingsPattern::GetHost() const {
+  // File patterns match by path, so their host says nothing.
+  if (!is_valid_ ||
+      (!parts_.is_scheme_wildcard && parts_.scheme == chrome::kFileScheme)) {
+    return std::string();
+  }
+  return parts_.host;
+}
+
 const std::string ContentSettingsPattern::ToString() const {
   if (IsValid())
     return content_settings::PatternParser::ToString(parts_);
@@ -177,6 +177,15 @@ class ContentSettingsPattern {
   // True if |url| matches this pattern.
   bool Matches(const GURL& url) const;
 
+  // Returns the host of |url| that Matches() compares with the host of a
+  // pattern.
+  static std::string GetURLHost(const GURL& url);
+
+  // Returns the host that the host of every URL matched by this pattern is
+  // equal to or, if the pattern has a domain wildcard, a subdomain of. Returns
+  // an empty string if the pattern matches URLs regardless of their host.
+  std::string GetHost() const;
+
   // Returns a std::string representation of this pattern.
   const std::string ToString() const;
 
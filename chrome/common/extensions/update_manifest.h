@@ -33,6 +33,8 @@ class UpdateManifest {
   // extension. The "codebase" attribute of the <updatecheck> tag is the url to
   // fetch the updated crx file, and the "prodversionmin" attribute refers to
   // the minimum version of the chrome browser that the update applies to.
+  // The optional "codebasediff" attribute is the url to fetch a differential
+  // update against the version reported in the update check.
 
   // The result of parsing one <app> tag in an xml update check manifest.
   struct Result {
@@ -44,6 +46,7 @@ class UpdateManifest {
     std::string browser_min_version;
     std::string package_hash;
     GURL crx_url;
+    GURL diff_crx_url;
   };
 
   static const int kNoDaystart = -1;
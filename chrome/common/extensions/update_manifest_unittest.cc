@@ -104,6 +104,17 @@ static const char* kNoUpdate =
 " </app>"
 "</gupdate>";
 
+// Includes a differential update.
+static const char* kWithDiffCodebase =
+"<?xml version='1.0' encoding='UTF-8'?>"
+"<gupdate xmlns='http://www.google.com/update2/response' protocol='2.0'>"
+" <app appid='12345'>"
+"  <updatecheck codebase='http://example.com/extension_1.2.3.4.crx'"
+"               codebasediff='http://example.com/extension_1.2.3.4_diff.crx'"
+"               version='1.2.3.4'/>"
+" </app>"
+"</gupdate>";
+
 // Includes two <app> tags, one with an error.
 static const char* kTwoAppsOneError =
 "<?xml version='1.0' encoding='UTF-8'?>"
@@ -163,6 +174,17 @@ TEST(ExtensionUpdateManifestTest, TestUpdateManifest) {
   EXPECT_FALSE(parser.results().list.empty());
   firstResult = &parser.results().list.at(0);
   EXPECT_EQ("1234", firstResult->package_hash);
+  EXPECT_FALSE(firstResult->diff_crx_url.is_valid());
+
+  // Parse xml with a differential update.
+  EXPECT_TRUE(parser.Parse(kWithDiffCodebase));
+  EXPECT_TRUE(parser.errors().empty());
+  EXPECT_FALSE(parser.results().list.empty());
+  firstResult = &parser.results().list.at(0);
+  EXPECT_EQ(GURL("http://example.com/extension_1.2.3.4.crx"),
+            firstResult->crx_url);
+  EXPECT_EQ(GURL("http://example.com/extension_1.2.3.4_diff.crx"),
+            firstResult->diff_crx_url);
 
   // Parse xml with a <daystart> element.
   EXPECT_TRUE(parser.Parse(kWithDaystart));
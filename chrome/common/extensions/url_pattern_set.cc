@@ -8,6 +8,7 @@
 #include <iterator>
 
 #include "chrome/common/extensions/url_pattern.h"
+#include "chrome/common/url_constants.h"
 #include "googleurl/src/gurl.h"
 
 
@@ -20,6 +21,7 @@ void URLPatternSet::CreateDifference(const URLPatternSet& set1,
                       set2.patterns_.begin(), set2.patterns_.end(),
                       std::inserter<std::set<URLPattern> >(
                           out->patterns_, out->patterns_.begin()));
+  out->RebuildHostIndex();
 }
 
 // static
@@ -31,6 +33,7 @@ void URLPatternSet::CreateIntersection(const URLPatternSet& set1,
                         set2.patterns_.begin(), set2.patterns_.end(),
                         std::inserter<std::set<URLPattern> >(
                             out->patterns_, out->patterns_.begin()));
+  out->RebuildHostIndex();
 }
 
 // static
@@ -42,20 +45,26 @@ void URLPatternSet::CreateUnion(const URLPatternSet& set1,
                  set2.patterns_.begin(), set2.patterns_.end(),
                  std::inserter<std::set<URLPattern> >(
                      out->patterns_, out->patterns_.begin()));
+  out->RebuildHostIndex();
 }
 
 URLPatternSet::URLPatternSet() {}
 
 URLPatternSet::URLPatternSet(const URLPatternSet& rhs)
-    : patterns_(rhs.patterns_) {}
+    : patterns_(rhs.patterns_) {
+  RebuildHostIndex();
+}
 
 URLPatternSet::URLPatternSet(const std::set<URLPattern>& patterns)
-    : patterns_(patterns) {}
+    : patterns_(patterns) {
+  RebuildHostIndex();
+}
 
 URLPatternSet::~URLPatternSet() {}
 
 URLPatternSet& URLPatternSet::operator=(const URLPatternSet& rhs) {
   patterns_ = rhs.patterns_;
+  RebuildHostIndex();
   return *this;
 }
 
@@ -68,11 +77,15 @@ bool URLPatternSet::is_empty() const {
 }
 
 void URLPatternSet::AddPattern(const URLPattern& pattern) {
-  patterns_.insert(pattern);
+  std::pair<std::set<URLPattern>::iterator, bool> result =
+      patterns_.insert(pattern);
+  if (result.second)
+    AddToHostIndex(&*result.first);
 }
 
 void URLPatternSet::ClearPatterns() {
   patterns_.clear();
+  host_index_.clear();
 }
 
 bool URLPatternSet::Contains(const URLPatternSet& set) const {
@@ -81,23 +94,11 @@ bool URLPatternSet::Contains(const URLPatternSet& set) const {
 }
 
 bool URLPatternSet::MatchesURL(const GURL& url) const {
-  for (URLPatternSet::const_iterator pattern = patterns_.begin();
-       pattern != patterns_.end(); ++pattern) {
-    if (pattern->MatchesURL(url))
-      return true;
-  }
-
-  return false;
+  return MatchesIndexedPattern(url, &URLPattern::MatchesURL);
 }
 
 bool URLPatternSet::MatchesSecurityOrigin(const GURL& origin) const {
-  for (URLPatternSet::const_iterator pattern = patterns_.begin();
-       pattern != patterns_.end(); ++pattern) {
-    if (pattern->MatchesSecurityOrigin(origin))
-      return true;
-  }
-
-  return false;
+  return MatchesIndexedPattern(origin, &URLPattern::MatchesSecurityOrigin);
 }
 
 bool URLPatternSet::OverlapsWith(const URLPatternSet& other) const {
@@ -114,3 +115,51 @@ bool URLPatternSet::OverlapsWith(const URLPatternSet& other) const {
 
   return false;
 }
+
+void URLPatternSet::RebuildHostIndex() {
+  host_index_.clear();
+  for (URLPatternSet::const_iterator pattern = patterns_.begin();
+       pattern != patterns_.end(); ++pattern) {
+    AddToHostIndex(&*pattern);
+  }
+}
+
+void URLPatternSet::AddToHostIndex(const URLPattern* pattern) {
+  // File patterns ignore the host, and a pattern matching subdomains without
+  // a host matches every host.
+  std::string host = pattern->host();
+  if (pattern->match_all_urls() ||
+      pattern->scheme() == chrome::kFileScheme ||
+      (pattern->match_subdomains() && host.empty())) {
+    host.clear();
+  }
+  host_index_.insert(std::make_pair(host, pattern));
+}
+
+bool URLPatternSet::MatchesIndexedPattern(
+    const GURL& url,
+    bool (URLPattern::*matches)(const GURL&) const) const {
+  // Patterns compare the host of the inner URL of filesystem URLs.
+  const GURL* host_url = url.inner_url() ? url.inner_url() : &url;
+  const std::string& host = host_url->host();
+
+  // A pattern can only match |url| if it is filed under the host of the URL,
+  // one of the domains above it, or the empty string.
+  size_t label = host.empty() ? std::string::npos : 0;
+  while (true) {
+    std::string key =
+        label == std::string::npos ? std::string() : host.substr(label);
+    std::pair<HostIndex::const_iterator, HostIndex::const_iterator> range =
+        host_index_.equal_range(key);
+    for (HostIndex::const_iterator it = range.first; it != range.second;
+         ++it) {
+      if ((it->second->*matches)(url))
+        return true;
+    }
+    if (label == std::string::npos)
+      return false;
+    label = host.find('.', label);
+    if (label != std::string::npos)
+      ++label;
+  }
+}
@@ -6,7 +6,9 @@
 #define CHROME_COMMON_EXTENSIONS_URL_PATTERN_SET_H_
 #pragma once
 
+#include <map>
 #include <set>
+#include <string>
 
 #include "chrome/common/extensions/url_pattern.h"
 
@@ -62,8 +64,27 @@ class URLPatternSet {
   bool OverlapsWith(const URLPatternSet& other) const;
 
  private:
+  // Patterns keyed by the host a URL must have, or be a subdomain of, to
+  // match them. Patterns that match URLs regardless of their host are filed
+  // under the empty string.
+  typedef std::multimap<std::string, const URLPattern*> HostIndex;
+
+  // Rebuilds |host_index_| from |patterns_|.
+  void RebuildHostIndex();
+  void AddToHostIndex(const URLPattern* pattern);
+
+  // Returns true if |matches| returns true for any of the patterns that may
+  // match |url|, looked up in |host_index_| with one lookup per label of the
+  // host of |url|.
+  bool MatchesIndexedPattern(
+      const GURL& url,
+      bool (URLPattern::*matches)(const GURL&) const) const;
+
   // The list of URL patterns that comprise the extent.
   std::set<URLPattern> patterns_;
+
+  // Indexes |patterns_| by host.
+  HostIndex host_index_;
 };
 
 #endif  // CHROME_COMMON_EXTENSIONS_URL_PATTERN_SET_H_
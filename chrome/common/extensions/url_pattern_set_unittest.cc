@@ -199,3 +199,39 @@ TEST(URLPatternSetTest, Duplicates) {
   // The sets should still be equal after adding a duplicate.
   EXPECT_EQ(set2, set1);
 }
+
+TEST(URLPatternSetTest, MatchesAcrossHosts) {
+  URLPatternSet set;
+  AddPattern(&set, "http://*.google.com/*");
+  AddPattern(&set, "http://www.yahoo.com/foo*");
+  AddPattern(&set, "https://*/secure/*");
+  AddPattern(&set, "file:///tmp/*");
+
+  EXPECT_TRUE(set.MatchesURL(GURL("http://google.com/")));
+  EXPECT_TRUE(set.MatchesURL(GURL("http://mail.google.com/")));
+  EXPECT_TRUE(set.MatchesURL(GURL("http://a.b.google.com/")));
+  EXPECT_FALSE(set.MatchesURL(GURL("http://notgoogle.com/")));
+  EXPECT_TRUE(set.MatchesURL(GURL("http://www.yahoo.com/foobar")));
+  EXPECT_FALSE(set.MatchesURL(GURL("http://www.yahoo.com/bar")));
+  EXPECT_FALSE(set.MatchesURL(GURL("http://mail.yahoo.com/foo")));
+  EXPECT_TRUE(set.MatchesURL(GURL("https://www.example.com/secure/")));
+  EXPECT_FALSE(set.MatchesURL(GURL("https://www.example.com/")));
+  EXPECT_TRUE(set.MatchesURL(GURL("file:///tmp/foo")));
+  EXPECT_FALSE(set.MatchesURL(GURL("file:///etc/foo")));
+
+  // Copies and results of set operations match the same URLs.
+  URLPatternSet copy(set);
+  EXPECT_TRUE(copy.MatchesURL(GURL("http://mail.google.com/")));
+  URLPatternSet empty;
+  URLPatternSet difference;
+  URLPatternSet::CreateDifference(set, empty, &difference);
+  EXPECT_TRUE(difference.MatchesURL(GURL("http://www.yahoo.com/foobar")));
+  EXPECT_TRUE(difference.MatchesURL(GURL("file:///tmp/foo")));
+
+  set.ClearPatterns();
+  EXPECT_FALSE(set.MatchesURL(GURL("http://mail.google.com/")));
+
+  AddPattern(&set, "<all_urls>");
+  EXPECT_TRUE(set.MatchesURL(GURL("http://www.example.com/")));
+  EXPECT_TRUE(set.MatchesSecurityOrigin(GURL("https://www.example.com/")));
+}
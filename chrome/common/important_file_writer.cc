@@ -86,8 +86,29 @@ void WriteToDiskTask(const FilePath& path, const std::string& data) {
   }
 }
 
+void SerializeAndWriteToDiskTask(
+    const FilePath& path,
+    const base::Callback<bool(std::string*)>& serializer) {
+  std::string data;
+  if (!serializer.Run(&data)) {
+    DLOG(WARNING) << "failed to serialize data to be saved in "
+                  << path.value();
+    return;
+  }
+  if (data.length() > static_cast<size_t>(kint32max)) {
+    NOTREACHED();
+    return;
+  }
+  WriteToDiskTask(path, data);
+}
+
 }  // namespace
 
+base::Callback<bool(std::string*)>
+ImportantFileWriter::DataSerializer::GetSnapshotSerializer() {
+  return base::Callback<bool(std::string*)>();
+}
+
 ImportantFileWriter::ImportantFileWriter(
     const FilePath& path,
     base::SequencedTaskRunner* blocking_task_runner)
@@ -147,6 +168,20 @@ void ImportantFileWriter::ScheduleWrite(DataSerializer* serializer) {
 
 void ImportantFileWriter::DoScheduledWrite() {
   DCHECK(serializer_);
+  base::Callback<bool(std::string*)> snapshot_serializer =
+      serializer_->GetSnapshotSerializer();
+  if (!snapshot_serializer.is_null()) {
+    timer_.Stop();
+    serializer_ = NULL;
+    if (!blocking_task_runner_->PostTask(
+        FROM_HERE, base::Bind(&SerializeAndWriteToDiskTask, path_,
+                              snapshot_serializer))) {
+      NOTREACHED();
+      SerializeAndWriteToDiskTask(path_, snapshot_serializer);
+    }
+    return;
+  }
+
   std::string data;
   if (serializer_->SerializeData(&data)) {
     WriteNow(data);
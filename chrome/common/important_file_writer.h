@@ -9,6 +9,7 @@
 #include <string>
 
 #include "base/basictypes.h"
+#include "base/callback.h"
 #include "base/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/threading/non_thread_safe.h"
@@ -48,6 +49,12 @@ class ImportantFileWriter : public base::NonThreadSafe {
     // serialization. Will be called on the same thread on which
     // ImportantFileWriter has been created.
     virtual bool SerializeData(std::string* data) = 0;
+
+    // Returns a callback that serializes a snapshot of the data taken now, or
+    // a null callback to use SerializeData() instead. The callback is run on
+    // the blocking task runner, so it must only use state it owns. Useful when
+    // taking the snapshot is much cheaper than serializing it.
+    virtual base::Callback<bool(std::string*)> GetSnapshotSerializer();
   };
 
   // Initialize the writer.
@@ -4,6 +4,7 @@
 
 #include "chrome/common/important_file_writer.h"
 
+#include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/file_path.h"
 #include "base/file_util.h"
@@ -38,6 +39,33 @@ class DataSerializer : public ImportantFileWriter::DataSerializer {
   const std::string data_;
 };
 
+bool CopyString(const std::string& data, std::string* output) {
+  output->assign(data);
+  return true;
+}
+
+// Hands out a copy of its current data to be serialized on the blocking task
+// runner.
+class SnapshotDataSerializer : public ImportantFileWriter::DataSerializer {
+ public:
+  explicit SnapshotDataSerializer(const std::string& data) : data_(data) {
+  }
+
+  void set_data(const std::string& data) { data_ = data; }
+
+  virtual bool SerializeData(std::string* output) {
+    ADD_FAILURE() << "snapshot serializer not used";
+    return false;
+  }
+
+  virtual base::Callback<bool(std::string*)> GetSnapshotSerializer() {
+    return base::Bind(&CopyString, data_);
+  }
+
+ private:
+  std::string data_;
+};
+
 }  // namespace
 
 class ImportantFileWriterTest : public testing::Test {
@@ -120,3 +148,18 @@ TEST_F(ImportantFileWriterTest, DISABLED_BatchingWrites) {
   ASSERT_TRUE(file_util::PathExists(writer.path()));
   EXPECT_EQ("baz", GetFileContent(writer.path()));
 }
+
+TEST_F(ImportantFileWriterTest, SnapshotSerializer) {
+  ImportantFileWriter writer(file_,
+                             base::MessageLoopProxy::current());
+  SnapshotDataSerializer serializer("foo");
+  writer.ScheduleWrite(&serializer);
+  writer.DoScheduledWrite();
+  EXPECT_FALSE(writer.HasPendingWrite());
+
+  // Changes after the snapshot was taken are not written.
+  serializer.set_data("bar");
+  loop_.RunAllPending();
+  ASSERT_TRUE(file_util::PathExists(writer.path()));
+  EXPECT_EQ("foo", GetFileContent(writer.path()));
+}
@@ -134,6 +134,13 @@ void FileThreadDeserializer::HandleErrors(
   }
 }
 
+// Writes |snapshot| out as JSON. Runs on the file thread for scheduled writes.
+bool SerializeSnapshot(const DictionaryValue* snapshot, std::string* output) {
+  JSONStringValueSerializer serializer(output);
+  serializer.set_pretty_print(true);
+  return serializer.Serialize(*snapshot);
+}
+
 }  // namespace
 
 JsonPrefStore::JsonPrefStore(const FilePath& filename,
@@ -309,11 +316,20 @@ JsonPrefStore::~JsonPrefStore() {
 }
 
 bool JsonPrefStore::SerializeData(std::string* output) {
+  scoped_ptr<DictionaryValue> snapshot(CreateSnapshot());
+  return SerializeSnapshot(snapshot.get(), output);
+}
+
+base::Callback<bool(std::string*)> JsonPrefStore::GetSnapshotSerializer() {
+  // Copying the prefs is cheap next to writing them out as JSON, which is
+  // left to the file thread.
+  return base::Bind(&SerializeSnapshot, base::Owned(CreateSnapshot()));
+}
+
+DictionaryValue* JsonPrefStore::CreateSnapshot() const {
   // TODO(tc): Do we want to prune webkit preferences that match the default
   // value?
-  JSONStringValueSerializer serializer(output);
-  serializer.set_pretty_print(true);
-  scoped_ptr<DictionaryValue> copy(prefs_->DeepCopyWithoutEmptyChildren());
+  DictionaryValue* copy = prefs_->DeepCopyWithoutEmptyChildren();
 
   // Iterates |keys_need_empty_value_| and if the key exists in |prefs_|,
   // ensure its empty ListValue or DictonaryValue is preserved.
@@ -338,5 +354,5 @@ bool JsonPrefStore::SerializeData(std::string* output) {
     }
   }
 
-  return serializer.Serialize(*(copy.get()));
+  return copy;
 }
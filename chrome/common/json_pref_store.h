@@ -68,6 +68,10 @@ class JsonPrefStore : public PersistentPrefStore,
 
   // ImportantFileWriter::DataSerializer overrides:
   virtual bool SerializeData(std::string* output) OVERRIDE;
+  virtual base::Callback<bool(std::string*)> GetSnapshotSerializer() OVERRIDE;
+
+  // Returns a copy of |prefs_| as it should be written to disk.
+  base::DictionaryValue* CreateSnapshot() const;
 
   FilePath path_;
   scoped_refptr<base::SequencedTaskRunner> blocking_task_runner_;
@@ -1258,6 +1258,13 @@ const char kLastPromptedGoogleURL[] = "browser.last_prompted_google_url";
 // intranet_redirect_detector.h for more information.
 const char kLastKnownIntranetRedirectOrigin[] = "browser.last_redirect_origin";
 
+// The gpu feature flags computed from the GPU blacklist on the last run, and
+// the browser version, OS version and gpu info they were computed for. See
+// GpuBlacklist::LoadGpuBlacklistForStartup().
+const char kGpuBlacklistCacheKey[] = "gpu.blacklist_cache.key";
+const char kGpuBlacklistCachedFeatureType[] =
+    "gpu.blacklist_cache.feature_type";
+
 // Integer containing the system Country ID the first time we checked the
 // template URL prepopulate data.  This is used to avoid adding a whole bunch of
 // new search engine choices if prepopulation runs when the user's Country ID
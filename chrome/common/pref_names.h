@@ -448,6 +448,9 @@ extern const char kLastKnownGoogleURL[];
 extern const char kLastPromptedGoogleURL[];
 extern const char kLastKnownIntranetRedirectOrigin[];
 
+extern const char kGpuBlacklistCacheKey[];
+extern const char kGpuBlacklistCachedFeatureType[];
+
 extern const char kCountryIDAtInstall[];
 extern const char kGeoIDAtInstall[];  // OBSOLETE
 
@@ -131,8 +131,34 @@ void UserScriptSlave::GetActiveExtensions(
   }
 }
 
+const std::vector<WebScriptSource>& UserScriptSlave::GetJsSources(size_t i) {
+  std::vector<WebScriptSource>& sources = js_sources_[i];
+  UserScript* script = scripts_[i];
+  if (!sources.empty() || script->js_scripts().empty())
+    return sources;
+
+  sources.reserve(script->js_scripts().size());
+  for (size_t j = 0; j < script->js_scripts().size(); ++j) {
+    UserScript::File &file = script->js_scripts()[j];
+    std::string content = file.GetContent().as_string();
+
+    // We add this dumb function wrapper for standalone user script to
+    // emulate what Greasemonkey does.
+    // TODO(aa): I think that maybe "is_standalone" scripts don't exist
+    // anymore. Investigate.
+    if (script->is_standalone() || script->emulate_greasemonkey()) {
+      content.insert(0, kUserScriptHead);
+      content += kUserScriptTail;
+    }
+    sources.push_back(
+        WebScriptSource(WebString::fromUTF8(content), file.url()));
+  }
+  return sources;
+}
+
 bool UserScriptSlave::UpdateScripts(base::SharedMemoryHandle shared_memory) {
   scripts_.clear();
+  js_sources_.clear();
 
   bool only_inject_incognito =
       ChromeRenderProcessObserver::is_incognito_process();
@@ -192,6 +218,8 @@ bool UserScriptSlave::UpdateScripts(base::SharedMemoryHandle shared_memory) {
     }
   }
 
+  js_sources_.resize(scripts_.size());
+
   // Push user styles down into WebCore
   RenderThread::Get()->EnsureWebKitInitialized();
   WebView::removeAllUserContent();
@@ -283,21 +311,8 @@ void UserScriptSlave::InjectScripts(WebFrame* frame,
 
     if (script->run_location() == location) {
       num_scripts += script->js_scripts().size();
-      for (size_t j = 0; j < script->js_scripts().size(); ++j) {
-        UserScript::File &file = script->js_scripts()[j];
-        std::string content = file.GetContent().as_string();
-
-        // We add this dumb function wrapper for standalone user script to
-        // emulate what Greasemonkey does.
-        // TODO(aa): I think that maybe "is_standalone" scripts don't exist
-        // anymore. Investigate.
-        if (script->is_standalone() || script->emulate_greasemonkey()) {
-          content.insert(0, kUserScriptHead);
-          content += kUserScriptTail;
-        }
-        sources.push_back(
-            WebScriptSource(WebString::fromUTF8(content), file.url()));
-      }
+      const std::vector<WebScriptSource>& js_sources = GetJsSources(i);
+      sources.insert(sources.end(), js_sources.begin(), js_sources.end());
     }
 
     if (!sources.empty()) {
@@ -306,8 +321,11 @@ void UserScriptSlave::InjectScripts(WebFrame* frame,
       // Emulate Greasemonkey API for scripts that were converted to extensions
       // and "standalone" user scripts.
       if (script->is_standalone() || script->emulate_greasemonkey()) {
-        sources.insert(sources.begin(),
-            WebScriptSource(WebString::fromUTF8(api_js_.as_string())));
+        if (!api_js_source_.get()) {
+          api_js_source_.reset(new WebScriptSource(
+              WebString::fromUTF8(api_js_.data(), api_js_.length())));
+        }
+        sources.insert(sources.begin(), *api_js_source_);
       }
 
       // TODO(aa): Can extension_id() ever be empty anymore?
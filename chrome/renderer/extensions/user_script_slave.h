@@ -66,6 +66,11 @@ class UserScriptSlave {
   static void InitializeIsolatedWorld(int isolated_world_id,
                                       const Extension* extension);
 
+  // Returns the sources to execute for the JavaScript files of |scripts_[i]|,
+  // converting them on first use and caching them until the scripts are
+  // updated.
+  const std::vector<WebScriptSource>& GetJsSources(size_t i);
+
   // Shared memory containing raw script data.
   scoped_ptr<base::SharedMemory> shared_memory_;
 
@@ -73,9 +78,18 @@ class UserScriptSlave {
   std::vector<UserScript*> scripts_;
   STLElementDeleter<std::vector<UserScript*> > script_deleter_;
 
+  // The sources built by GetJsSources(), indexed like |scripts_|. Empty until
+  // the script is first injected. Converting the scripts once, rather than for
+  // every frame, matters on pages with many frames; reusing the same source
+  // strings also lets V8 find its compiled code in its compilation cache.
+  std::vector<std::vector<WebScriptSource> > js_sources_;
+
   // Greasemonkey API source that is injected with the scripts.
   base::StringPiece api_js_;
 
+  // |api_js_| as a script source, built when first needed.
+  scoped_ptr<WebScriptSource> api_js_source_;
+
   // Extension metadata.
   const ExtensionSet* extensions_;
 
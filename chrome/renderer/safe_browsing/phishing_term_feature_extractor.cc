@@ -5,7 +5,6 @@
 #include "chrome/renderer/safe_browsing/phishing_term_feature_extractor.h"
 
 #include <list>
-#include <map>
 
 #include "base/bind.h"
 #include "base/compiler_specific.h"
@@ -13,6 +12,7 @@
 #include "base/logging.h"
 #include "base/message_loop.h"
 #include "base/metrics/histogram.h"
+#include "base/string_piece.h"
 #include "base/time.h"
 #include "base/utf_string_conversions.h"
 #include "crypto/sha2.h"
@@ -234,31 +234,24 @@ void PhishingTermFeatureExtractor::HandleWord(
     return;
   }
 
-  // Find all of the n-grams that we need to check and compute their SHA-256
-  // hashes.
-  std::map<std::string /* hash */, std::string /* plaintext */>
-      hashes_to_check;
-  hashes_to_check[crypto::SHA256HashString(word_lower)] = word_lower;
-
-  // Combine the new word with the previous words to find additional n-grams.
-  // Note that we don't yet add the new word length to previous_word_sizes,
-  // since we don't want to compute the hash for the word by itself again.
-  //
+  // Check the word by itself and every n-gram that ends with it against
+  // page_term_hashes_.  The n-grams are the suffixes of previous_words once
+  // the new word is appended, so they are hashed in place rather than copied
+  // out one by one.  Note that we don't yet add the new word length to
+  // previous_word_sizes, since the word by itself is checked last below.
   state_->previous_words.append(word_lower);
-  std::string current_term = state_->previous_words;
-  for (std::list<size_t>::iterator it = state_->previous_word_sizes.begin();
-       it != state_->previous_word_sizes.end(); ++it) {
-    hashes_to_check[crypto::SHA256HashString(current_term)] = current_term;
-    current_term.erase(0, *it);
-  }
-
-  // Add features for any hashes that match page_term_hashes_.
-  for (std::map<std::string, std::string>::iterator it =
-           hashes_to_check.begin();
-       it != hashes_to_check.end(); ++it) {
-    if (page_term_hashes_->find(it->first) != page_term_hashes_->end()) {
-      features_->AddBooleanFeature(features::kPageTerm + it->second);
+  const base::StringPiece previous_words(state_->previous_words);
+  std::list<size_t>::const_iterator it = state_->previous_word_sizes.begin();
+  size_t term_start = 0;
+  while (true) {
+    base::StringPiece term = previous_words.substr(term_start);
+    if (page_term_hashes_->find(crypto::SHA256HashString(term)) !=
+        page_term_hashes_->end()) {
+      features_->AddBooleanFeature(features::kPageTerm + term.as_string());
     }
+    if (it == state_->previous_word_sizes.end())
+      break;
+    term_start += *it++;
   }
 
   // Now that we have handled the current word, we have to add a space at the
@@ -25,6 +25,13 @@ using WebKit::WebVector;
 using WebKit::WebTextCheckingResult;
 using WebKit::WebTextCheckingType;
 
+namespace {
+
+// The number of words whose spelling is remembered.
+const size_t kWordCacheSize = 4096;
+
+}  // namespace
+
 namespace spellcheck {
 void ToWebResultList(
     int offset,
@@ -89,7 +96,8 @@ class SpellCheck::SpellCheckRequestParam
 };
 
 SpellCheck::SpellCheck()
-    : file_(base::kInvalidPlatformFileValue),
+    : word_cache_(kWordCacheSize),
+      file_(base::kInvalidPlatformFileValue),
       auto_spell_correct_turned_on_(false),
       is_using_platform_spelling_engine_(false),
       initialized_(false),
@@ -133,6 +141,8 @@ void SpellCheck::OnWordAdded(const std::string& word) {
     custom_words_.push_back(word);
   } else {
     AddWordToHunspell(word);
+    // Cached misspellings of |word| are now wrong.
+    word_cache_.Clear();
   }
 }
 
@@ -146,6 +156,7 @@ void SpellCheck::Init(base::PlatformFile file,
   initialized_ = true;
   hunspell_.reset();
   bdict_file_.reset();
+  word_cache_.Clear();
   file_ = file;
   is_using_platform_spelling_engine_ =
       file == base::kInvalidPlatformFileValue && !language.empty();
@@ -409,9 +420,13 @@ bool SpellCheck::CheckSpelling(const string16& word_to_check, int tag) {
     // Hunspell shouldn't let us exceed its max, but check just in case
     if (word_to_check_utf8.length() < MAXWORDUTF8LEN) {
       if (hunspell_.get()) {
+        WordCache::iterator cached = word_cache_.Get(word_to_check);
+        if (cached != word_cache_.end())
+          return cached->second;
         // |hunspell_->spell| returns 0 if the word is spelled correctly and
         // non-zero otherwsie.
         word_correct = (hunspell_->spell(word_to_check_utf8.c_str()) != 0);
+        word_cache_.Put(word_to_check, word_correct);
       } else {
         // If |hunspell_| is NULL here, an error has occurred, but it's better
         // to check rather than crash.
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/gtest_prod_util.h"
+#include "base/memory/mru_cache.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -161,6 +162,11 @@ class SpellCheck : public content::RenderProcessObserver,
   // The hunspell dictionary in use.
   scoped_ptr<Hunspell> hunspell_;
 
+  // Recent results of |hunspell_|, keyed by word. Pages repeat most of their
+  // words, and looking a word up in Hunspell is much slower than in here.
+  typedef base::HashingMRUCache<string16, bool> WordCache;
+  WordCache word_cache_;
+
   base::PlatformFile file_;
   std::vector<std::string> custom_words_;
 
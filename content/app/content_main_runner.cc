@@ -8,6 +8,7 @@
 #include "base/at_exit.h"
 #include "base/command_line.h"
 #include "base/debug/debugger.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/debug/trace_event.h"
 #include "base/file_path.h"
 #include "base/i18n/icu_util.h"
@@ -40,6 +41,7 @@
 
 #if defined(USE_TCMALLOC)
 #include "third_party/tcmalloc/chromium/src/gperftools/malloc_extension.h"
+#include "third_party/tcmalloc/chromium/src/gperftools/malloc_hook.h"
 #endif
 
 #if defined(OS_WIN)
@@ -72,6 +74,12 @@ int tc_set_new_mode(int mode);
 }
 #endif
 
+#if defined(USE_TCMALLOC)
+// One allocation is sampled for every this many bytes allocated when
+// --enable-heap-tagging is passed.
+const size_t kHeapTaggingSampleInterval = 128 * 1024;
+#endif
+
 extern int GpuMain(const content::MainFunctionParams&);
 extern int PluginMain(const content::MainFunctionParams&);
 extern int PpapiPluginMain(const content::MainFunctionParams&);
@@ -421,6 +429,16 @@ static void ReleaseFreeMemoryThunk() {
           command_line.GetSwitchValueASCII(switches::kTraceStartup));
     }
 
+#if defined(USE_TCMALLOC)
+    // Install the heap tagging hooks before any threads are started so that
+    // no sampled allocation misses its free.
+    if (command_line.HasSwitch(switches::kEnableHeapTagging)) {
+      base::debug::EnableHeapTagging(kHeapTaggingSampleInterval);
+      MallocHook::AddNewHook(&base::debug::RecordHeapAllocation);
+      MallocHook::AddDeleteHook(&base::debug::RecordHeapFree);
+    }
+#endif
+
 #if defined(OS_MACOSX)
     // We need to allocate the IO Ports before the Sandbox is initialized or
     // the first instance of SystemMonitor is created.
@@ -35,6 +35,11 @@ using ::testing::StrEq;
 
 namespace {
 
+// Matches a data pointer whose first |length| bytes are |expected|.
+MATCHER_P2(DataEq, expected, length, "") {
+  return std::string(arg, length) == expected;
+}
+
 class MockDownloadFileFactory :
     public DownloadFileManager::DownloadFileFactory {
 
@@ -506,6 +511,34 @@ TEST_F(DownloadFileManagerTest, DownloadWithError) {
                  net::ERR_FILE_NO_SPACE);
 }
 
+TEST_F(DownloadFileManagerTest, CoalescePendingBuffers) {
+  // Same as StartDownload, at first.
+  DownloadCreateInfo* info = new DownloadCreateInfo;
+  DownloadId dummy_id(download_manager_.get(), kDummyDownloadId);
+
+  StartDownload(info, dummy_id);
+
+  // Buffers that arrive before the FILE thread gets to them are written to
+  // the file in a single call.
+  EXPECT_TRUE(UpdateBuffer(kTestData1, strlen(kTestData1)));
+  EXPECT_TRUE(UpdateBuffer(kTestData2, strlen(kTestData2)));
+  EXPECT_TRUE(UpdateBuffer(kTestData3, strlen(kTestData3)));
+  std::string expected_data =
+      std::string(kTestData1) + kTestData2 + kTestData3;
+
+  MockDownloadFile* file = download_file_factory_->GetExistingFile(dummy_id);
+  ASSERT_TRUE(file != NULL);
+  EXPECT_CALL(*file, AppendDataToFile(
+      DataEq(expected_data, expected_data.size()), expected_data.size()))
+      .Times(1)
+      .WillOnce(Return(net::OK));
+
+  download_file_manager_->UpdateDownload(dummy_id, download_buffer_.get());
+  ClearExpectations(dummy_id);
+
+  CleanUp(dummy_id);
+}
+
 TEST_F(DownloadFileManagerTest, CompleteDownload) {
   // Same as StartDownload, at first.
   DownloadCreateInfo* info = new DownloadCreateInfo;
@@ -173,7 +173,11 @@ bool AsyncResourceHandler::OnWillRead(int request_id, net::IOBuffer** buf,
                                       int* buf_size, int min_size) {
   DCHECK_EQ(-1, min_size);
 
-  if (g_spare_read_buffer) {
+  // Only reuse the spare buffer if it is at least as large as the buffer this
+  // request has grown to, so that a large response isn't throttled back to a
+  // small read by a buffer left behind by some other request.
+  if (g_spare_read_buffer &&
+      g_spare_read_buffer->buffer_size() >= next_buffer_size_) {
     DCHECK(!read_buffer_);
     read_buffer_.swap(&g_spare_read_buffer);
     DCHECK(read_buffer_->data());
@@ -16,3 +16,11 @@ BackingStore::~BackingStore() {
 size_t BackingStore::MemorySize() {
   return size_.GetArea() * 4;
 }
+
+bool BackingStore::CanRestoreFromBitmap() {
+  return false;
+}
+
+bool BackingStore::RestoreFromBitmap(const SkBitmap& bitmap) {
+  return false;
+}
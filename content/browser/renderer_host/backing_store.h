@@ -15,6 +15,7 @@
 #include "ui/surface/transport_dib.h"
 
 class RenderProcessHost;
+class SkBitmap;
 
 namespace gfx {
 class Rect;
@@ -72,6 +73,18 @@ class CONTENT_EXPORT BackingStore {
   virtual void ScrollBackingStore(int dx, int dy,
                                   const gfx::Rect& clip_rect,
                                   const gfx::Size& view_size) = 0;
+
+  // Whether RestoreFromBitmap() is implemented. The BackingStoreManager only
+  // keeps a compressed snapshot of an evicted backing store when it can later
+  // be restored.
+  virtual bool CanRestoreFromBitmap();
+
+  // Replaces the entire contents of the backing store with |bitmap|, which
+  // must be a 32bpp bitmap of the same size as the backing store, such as one
+  // produced by CopyFromBackingStore(). Returns false on failure, including
+  // when the implementation doesn't support restoring.
+  virtual bool RestoreFromBitmap(const SkBitmap& bitmap);
+
  protected:
   // Can only be constructed via subclasses.
   BackingStore(content::RenderWidgetHost* widget, const gfx::Size& size);
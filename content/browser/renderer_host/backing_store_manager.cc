@@ -4,13 +4,24 @@
 
 #include "content/browser/renderer_host/backing_store_manager.h"
 
+#if defined(USE_SYSTEM_ZLIB)
+#include <zlib.h>
+#else
+#include "third_party/zlib/zlib.h"
+#endif
+
+#include <string>
+
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/memory/mru_cache.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/sys_info.h"
 #include "content/browser/renderer_host/backing_store.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
 #include "content/public/common/content_switches.h"
+#include "skia/ext/platform_canvas.h"
+#include "third_party/skia/include/core/SkBitmap.h"
 
 using content::RenderWidgetHost;
 
@@ -26,6 +37,21 @@ typedef base::OwningMRUCache<RenderWidgetHost*, BackingStore*>
 static BackingStoreCache* large_cache = NULL;
 static BackingStoreCache* small_cache = NULL;
 
+// Backing stores evicted from the caches above are not dropped outright when
+// the platform can restore them; instead a zlib-compressed snapshot of their
+// pixels is kept in |compressed_cache|, bounded by its own memory budget. When
+// the host asks for its backing store again (typically on tab activation) the
+// snapshot is inflated into a fresh backing store, which saves a full repaint
+// round trip to the renderer.
+struct CompressedBackingStore {
+  gfx::Size size;
+  size_t row_bytes;
+  std::string data;
+};
+typedef base::OwningMRUCache<RenderWidgetHost*, CompressedBackingStore*>
+    CompressedBackingStoreCache;
+static CompressedBackingStoreCache* compressed_cache = NULL;
+
 // Threshold is based on a single large-monitor-width toolstrip.
 // (32bpp, 32 pixels high, 1920 pixels wide)
 // TODO(aa): The extension system no longer supports toolstrips, but we think
@@ -72,9 +98,69 @@ static size_t MaxBackingStoreMemory() {
   return MaxNumberOfBackingStores() * kMemoryMultiplier;
 }
 
+// The maximum amount of memory to use for compressed snapshots. Page content
+// typically deflates by an order of magnitude, so this holds many more tabs
+// than the raw caches do.
+static size_t MaxCompressedBackingStoreMemory() {
+  return MaxBackingStoreMemory() / 2;
+}
+
+size_t CompressedMemorySize() {
+  size_t mem = 0;
+  CompressedBackingStoreCache::iterator it;
+  for (it = compressed_cache->begin(); it != compressed_cache->end(); ++it)
+    mem += it->second->data.size();
+  return mem;
+}
+
+// Snapshots |backing_store| into |compressed_cache|, evicting the least
+// recently used snapshots to stay within the budget. Does nothing if the
+// backing store can't be snapshotted or restored.
+void CompressBackingStore(RenderWidgetHost* host, BackingStore* backing_store) {
+  if (!backing_store->CanRestoreFromBitmap())
+    return;
+
+  const gfx::Size& size = backing_store->size();
+  skia::PlatformCanvas canvas;
+  if (!backing_store->CopyFromBackingStore(gfx::Rect(size), &canvas))
+    return;
+  const SkBitmap& bitmap = skia::GetTopDevice(canvas)->accessBitmap(false);
+  if (bitmap.width() != size.width() || bitmap.height() != size.height())
+    return;
+
+  SkAutoLockPixels bitmap_lock(bitmap);
+  uLong source_size = static_cast<uLong>(bitmap.getSize());
+  uLongf compressed_size = compressBound(source_size);
+  scoped_ptr<CompressedBackingStore> compressed(new CompressedBackingStore);
+  compressed->data.resize(compressed_size);
+  if (compress2(reinterpret_cast<Bytef*>(&compressed->data[0]),
+                &compressed_size,
+                static_cast<const Bytef*>(bitmap.getPixels()),
+                source_size,
+                Z_BEST_SPEED) != Z_OK) {
+    return;
+  }
+  compressed->data.resize(compressed_size);
+  compressed->size = size;
+  compressed->row_bytes = bitmap.rowBytes();
+
+  const size_t max_mem = MaxCompressedBackingStoreMemory();
+  if (compressed->data.size() > max_mem)
+    return;
+  size_t current_mem = CompressedMemorySize();
+  while (current_mem + compressed->data.size() > max_mem) {
+    CompressedBackingStoreCache::iterator entry =
+        --compressed_cache->rbegin().base();
+    current_mem -= entry->second->data.size();
+    compressed_cache->Erase(entry);
+  }
+  compressed_cache->Put(host, compressed.release());
+}
+
 // Expires the given |backing_store| from |cache|.
 void ExpireBackingStoreAt(BackingStoreCache* cache,
                           BackingStoreCache::iterator backing_store) {
+  CompressBackingStore(backing_store->first, backing_store->second);
   cache->Erase(backing_store);
 }
 
@@ -118,6 +204,8 @@ BackingStore* CreateBackingStore(RenderWidgetHost* host,
   if (!large_cache) {
     large_cache = new BackingStoreCache(BackingStoreCache::NO_AUTO_EVICT);
     small_cache = new BackingStoreCache(BackingStoreCache::NO_AUTO_EVICT);
+    compressed_cache = new CompressedBackingStoreCache(
+        CompressedBackingStoreCache::NO_AUTO_EVICT);
   }
 
   // TODO(erikkay) 32bpp is not always accurate
@@ -154,6 +242,42 @@ BackingStore* CreateBackingStore(RenderWidgetHost* host,
   return backing_store;
 }
 
+// Rebuilds the backing store for |host| from its compressed snapshot, if it
+// has one. The snapshot is consumed either way.
+BackingStore* RestoreCompressedBackingStore(RenderWidgetHost* host) {
+  CompressedBackingStoreCache::iterator it = compressed_cache->Peek(host);
+  if (it == compressed_cache->end())
+    return NULL;
+  CompressedBackingStore compressed;
+  compressed.size = it->second->size;
+  compressed.row_bytes = it->second->row_bytes;
+  compressed.data.swap(it->second->data);
+  compressed_cache->Erase(it);
+
+  SkBitmap bitmap;
+  bitmap.setConfig(SkBitmap::kARGB_8888_Config, compressed.size.width(),
+                   compressed.size.height(), compressed.row_bytes);
+  if (!bitmap.allocPixels())
+    return NULL;
+  SkAutoLockPixels bitmap_lock(bitmap);
+  uLongf uncompressed_size = static_cast<uLongf>(bitmap.getSize());
+  if (uncompress(static_cast<Bytef*>(bitmap.getPixels()), &uncompressed_size,
+                 reinterpret_cast<const Bytef*>(compressed.data.data()),
+                 static_cast<uLong>(compressed.data.size())) != Z_OK ||
+      uncompressed_size != bitmap.getSize()) {
+    return NULL;
+  }
+
+  BackingStore* backing_store = CreateBackingStore(host, compressed.size);
+  if (!backing_store)
+    return NULL;
+  if (!backing_store->RestoreFromBitmap(bitmap)) {
+    BackingStoreManager::RemoveBackingStore(host);
+    return NULL;
+  }
+  return backing_store;
+}
+
 int ComputeTotalArea(const std::vector<gfx::Rect>& rects) {
   // We assume that the given rects are non-overlapping, which is a property of
   // the paint rects generated by the PaintAggregator.
@@ -235,6 +359,8 @@ BackingStore* BackingStoreManager::Lookup(RenderWidgetHost* host) {
     it = small_cache->Get(host);
     if (it != small_cache->end())
       return it->second;
+
+    return RestoreCompressedBackingStore(host);
   }
   return NULL;
 }
@@ -244,6 +370,11 @@ void BackingStoreManager::RemoveBackingStore(RenderWidgetHost* host) {
   if (!large_cache)
     return;
 
+  CompressedBackingStoreCache::iterator compressed =
+      compressed_cache->Peek(host);
+  if (compressed != compressed_cache->end())
+    compressed_cache->Erase(compressed);
+
   BackingStoreCache* cache = large_cache;
   BackingStoreCache::iterator it = cache->Peek(host);
   if (it == cache->end()) {
@@ -260,6 +391,7 @@ void BackingStoreManager::RemoveAllBackingStores() {
   if (large_cache) {
     large_cache->Clear();
     small_cache->Clear();
+    compressed_cache->Clear();
   }
 }
 
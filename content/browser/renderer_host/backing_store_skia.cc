@@ -108,3 +108,17 @@ bool BackingStoreSkia::CopyFromBackingStore(const gfx::Rect& rect,
   output->writePixels(b, rect.x(), rect.y());
   return true;
 }
+
+bool BackingStoreSkia::CanRestoreFromBitmap() {
+  return true;
+}
+
+bool BackingStoreSkia::RestoreFromBitmap(const SkBitmap& bitmap) {
+  if (bitmap.width() != size().width() || bitmap.height() != size().height())
+    return false;
+
+  SkPaint copy_paint;
+  copy_paint.setXfermodeMode(SkXfermode::kSrc_Mode);
+  canvas_->drawBitmap(bitmap, 0, 0, &copy_paint);
+  return true;
+}
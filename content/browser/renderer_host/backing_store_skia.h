@@ -50,6 +50,8 @@ class BackingStoreSkia : public BackingStore {
   virtual void ScrollBackingStore(int dx, int dy,
                                   const gfx::Rect& clip_rect,
                                   const gfx::Size& view_size) OVERRIDE;
+  virtual bool CanRestoreFromBitmap() OVERRIDE;
+  virtual bool RestoreFromBitmap(const SkBitmap& bitmap) OVERRIDE;
 
  private:
   SkBitmap bitmap_;
@@ -189,7 +189,10 @@ void ClipboardMessageFilter::OnReadImage(
     ui::Clipboard::Buffer buffer, IPC::Message* reply_msg) {
   SkBitmap bitmap = GetClipboard()->ReadImage(buffer);
 
-#if defined(USE_X11)
+  // Encoding a large image to PNG is slow, so outside Windows, where the read
+  // itself is already serviced on the FILE thread, do it off the UI thread.
+  // The bitmap owns a copy of its pixels, so it can be handed across threads.
+#if !defined(OS_WIN)
   BrowserThread::PostTask(
       BrowserThread::FILE, FROM_HERE,
       base::Bind(
@@ -203,7 +206,6 @@ void ClipboardMessageFilter::OnReadImageReply(
     const SkBitmap& bitmap, IPC::Message* reply_msg) {
   base::SharedMemoryHandle image_handle = base::SharedMemory::NULLHandle();
   uint32 image_size = 0;
-  std::string reply_data;
   if (!bitmap.isNull()) {
     std::vector<unsigned char> png_data;
     SkAutoLockPixels lock(bitmap);
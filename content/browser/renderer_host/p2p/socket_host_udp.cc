@@ -70,7 +70,9 @@ bool P2PSocketHostUdp::Init(const net::IPEndPoint& local_address,
 
   message_sender_->Send(new P2PMsg_OnSocketCreated(routing_id_, id_, address));
 
-  recv_buffer_ = new net::IOBuffer(kReadBufferSize);
+  // Only the pages the packets are read into are ever touched, so the
+  // unused part of each slot doesn't take up memory.
+  recv_buffer_ = new net::IOBuffer(kReadBufferSize * kReadBatchSize);
   DoRead();
 
   return true;
@@ -89,9 +91,10 @@ void P2PSocketHostUdp::OnError() {
 void P2PSocketHostUdp::DoRead() {
   int result;
   do {
-    result = socket_->RecvFrom(recv_buffer_, kReadBufferSize, &recv_address_,
-                               base::Bind(&P2PSocketHostUdp::OnRecv,
-                                          base::Unretained(this)));
+    result = socket_->RecvMultipleFrom(
+        recv_buffer_, kReadBufferSize, kReadBatchSize, recv_sizes_,
+        recv_addresses_,
+        base::Bind(&P2PSocketHostUdp::OnRecv, base::Unretained(this)));
     DidCompleteRead(result);
   } while (result > 0);
 }
@@ -107,29 +110,41 @@ void P2PSocketHostUdp::DidCompleteRead(int result) {
   DCHECK_EQ(state_, STATE_OPEN);
 
   if (result > 0) {
-    std::vector<char> data(recv_buffer_->data(), recv_buffer_->data() + result);
-
-    if (connected_peers_.find(recv_address_) == connected_peers_.end()) {
-      P2PSocketHost::StunMessageType type;
-      bool stun = GetStunPacketType(&*data.begin(), data.size(), &type);
-      if (stun && IsRequestOrResponse(type)) {
-        connected_peers_.insert(recv_address_);
-      } else if (!stun || type == STUN_DATA_INDICATION) {
-        LOG(ERROR) << "Received unexpected data packet from "
-                   << recv_address_.ToString()
-                   << " before STUN binding is finished.";
-        return;
-      }
+    for (int i = 0; i < result; ++i) {
+      HandleReadPacket(recv_buffer_->data() + i * kReadBufferSize,
+                       recv_sizes_[i], recv_addresses_[i]);
     }
-
-    message_sender_->Send(new P2PMsg_OnDataReceived(routing_id_, id_,
-                                                    recv_address_, data));
   } else if (result < 0 && result != net::ERR_IO_PENDING) {
     LOG(ERROR) << "Error when reading from UDP socket: " << result;
     OnError();
   }
 }
 
+void P2PSocketHostUdp::HandleReadPacket(const char* packet, int size,
+                                        const net::IPEndPoint& from) {
+  // There is nothing to pass on for empty packets.
+  if (size <= 0)
+    return;
+
+  std::vector<char> data(packet, packet + size);
+
+  if (connected_peers_.find(from) == connected_peers_.end()) {
+    P2PSocketHost::StunMessageType type;
+    bool stun = GetStunPacketType(&*data.begin(), data.size(), &type);
+    if (stun && IsRequestOrResponse(type)) {
+      connected_peers_.insert(from);
+    } else if (!stun || type == STUN_DATA_INDICATION) {
+      LOG(ERROR) << "Received unexpected data packet from "
+                 << from.ToString()
+                 << " before STUN binding is finished.";
+      return;
+    }
+  }
+
+  message_sender_->Send(new P2PMsg_OnDataReceived(routing_id_, id_,
+                                                  from, data));
+}
+
 void P2PSocketHostUdp::Send(const net::IPEndPoint& to,
                             const std::vector<char>& data) {
   if (!socket_.get()) {
@@ -48,18 +48,26 @@ class CONTENT_EXPORT P2PSocketHostUdp : public P2PSocketHost {
     int size;
   };
 
+  // The most packets read from the socket at once.
+  static const int kReadBatchSize = 8;
+
   void OnError();
   void DoRead();
   void DoSend(const PendingPacket& packet);
   void DidCompleteRead(int result);
+  void HandleReadPacket(const char* packet, int size,
+                        const net::IPEndPoint& from);
 
-  // Callbacks for RecvFrom() and SendTo().
+  // Callbacks for RecvMultipleFrom() and SendTo().
   void OnRecv(int result);
   void OnSend(int result);
 
   scoped_ptr<net::DatagramServerSocket> socket_;
+
+  // Holds |kReadBatchSize| packets, each in a slot of kReadBufferSize bytes.
   scoped_refptr<net::IOBuffer> recv_buffer_;
-  net::IPEndPoint recv_address_;
+  int recv_sizes_[kReadBatchSize];
+  net::IPEndPoint recv_addresses_[kReadBatchSize];
 
   std::deque<PendingPacket> send_queue_;
   int send_queue_bytes_;
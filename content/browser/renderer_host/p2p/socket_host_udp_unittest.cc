@@ -68,6 +68,32 @@ class FakeDatagramServerSocket : public net::DatagramServerSocket {
       recv_buffer_ = buf;
       recv_size_ = buf_len;
       recv_address_ = address;
+      recv_sizes_ = NULL;
+      return net::ERR_IO_PENDING;
+    }
+  }
+
+  virtual int RecvMultipleFrom(net::IOBuffer* buf, int buf_len, int count,
+                               int* sizes, net::IPEndPoint* addresses,
+                               const net::CompletionCallback& callback) OVERRIDE {
+    CHECK(recv_callback_.is_null());
+    if (incoming_packets_.size() > 0) {
+      int read = 0;
+      for (; read < count && incoming_packets_.size() > 0; ++read) {
+        sizes[read] = std::min(
+            static_cast<int>(incoming_packets_.front().second.size()), buf_len);
+        memcpy(buf->data() + read * buf_len,
+               &*incoming_packets_.front().second.begin(), sizes[read]);
+        addresses[read] = incoming_packets_.front().first;
+        incoming_packets_.pop_front();
+      }
+      return read;
+    } else {
+      recv_callback_ = callback;
+      recv_buffer_ = buf;
+      recv_size_ = buf_len;
+      recv_address_ = addresses;
+      recv_sizes_ = sizes;
       return net::ERR_IO_PENDING;
     }
   }
@@ -97,12 +123,24 @@ class FakeDatagramServerSocket : public net::DatagramServerSocket {
       net::CompletionCallback cb = recv_callback_;
       recv_callback_.Reset();
       recv_buffer_ = NULL;
-      cb.Run(size);
+      if (recv_sizes_) {
+        // Pending RecvMultipleFrom().
+        recv_sizes_[0] = size;
+        cb.Run(1);
+      } else {
+        cb.Run(size);
+      }
     } else {
       incoming_packets_.push_back(UDPPacket(address, data));
     }
   }
 
+  // Queues a packet to be returned by the next read, without completing a
+  // pending one.
+  void QueuePacket(const net::IPEndPoint& address, std::vector<char> data) {
+    incoming_packets_.push_back(UDPPacket(address, data));
+  }
+
   virtual const net::BoundNetLog& NetLog() const {
     return net_log_;
   }
@@ -116,6 +154,7 @@ class FakeDatagramServerSocket : public net::DatagramServerSocket {
   scoped_refptr<net::IOBuffer> recv_buffer_;
   net::IPEndPoint* recv_address_;
   int recv_size_;
+  int* recv_sizes_;
   net::CompletionCallback recv_callback_;
 };
 
@@ -207,6 +246,34 @@ TEST_F(P2PSocketHostUdpTest, SendAfterStunRequest) {
   ASSERT_EQ(dest1_, sent_packets_[0].first);
 }
 
+// Verify that packets queued on the socket are all read once it becomes
+// readable.
+TEST_F(P2PSocketHostUdpTest, ReceiveMultiplePackets) {
+  std::vector<char> packet1;
+  CreateStunRequest(&packet1);
+  std::vector<char> packet2;
+  CreateStunResponse(&packet2);
+  std::vector<char> packet3;
+  CreateStunRequest(&packet3);
+
+  EXPECT_CALL(sender_, Send(MatchPacketMessage(packet1)))
+      .WillOnce(DoAll(DeleteArg<0>(), Return(true)));
+  EXPECT_CALL(sender_, Send(MatchPacketMessage(packet2)))
+      .WillOnce(DoAll(DeleteArg<0>(), Return(true)));
+  EXPECT_CALL(sender_, Send(MatchPacketMessage(packet3)))
+      .WillOnce(DoAll(DeleteArg<0>(), Return(true)));
+  socket_->ReceivePacket(dest1_, packet1);
+  socket_->QueuePacket(dest2_, packet2);
+  socket_->QueuePacket(dest1_, packet3);
+
+  // The next packet makes the host read the queued ones too.
+  std::vector<char> packet4;
+  CreateStunRequest(&packet4);
+  EXPECT_CALL(sender_, Send(MatchPacketMessage(packet4)))
+      .WillOnce(DoAll(DeleteArg<0>(), Return(true)));
+  socket_->ReceivePacket(dest2_, packet4);
+}
+
 // Verify that we can send data after we've received STUN response
 // from the other side.
 TEST_F(P2PSocketHostUdpTest, SendAfterStunResponse) {
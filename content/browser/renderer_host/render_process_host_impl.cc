@@ -688,6 +688,7 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     switches::kEnableGamepad,
     switches::kEnableGPUServiceLogging,
     switches::kEnableGPUClientLogging,
+    switches::kEnableHeapTagging,
     switches::kEnableLogging,
     switches::kEnableMediaSource,
     switches::kEnableMediaStream,
@@ -1403,9 +1403,29 @@ void ResourceDispatcherHostImpl::RemovePendingRequest(
   transferred_navigations_.erase(
       GlobalRequestID(info->GetChildID(), info->GetRequestID()));
 
+  // Let the scheduler start the requests this one was holding back. They are
+  // looked up again by ID in case starting one of them finishes another.
+  std::vector<net::URLRequest*> requests_to_start;
+  scheduler_.RemoveRequest(iter->second, &requests_to_start);
+  std::vector<GlobalRequestID> ids_to_start;
+  for (std::vector<net::URLRequest*>::const_iterator i =
+           requests_to_start.begin(); i != requests_to_start.end(); ++i) {
+    ResourceRequestInfoImpl* start_info =
+        ResourceRequestInfoImpl::ForRequest(*i);
+    ids_to_start.push_back(GlobalRequestID(start_info->GetChildID(),
+                                           start_info->GetRequestID()));
+  }
+
   delete iter->second;
   pending_requests_.erase(iter);
 
+  for (std::vector<GlobalRequestID>::const_iterator i = ids_to_start.begin();
+       i != ids_to_start.end(); ++i) {
+    PendingRequestList::iterator to_start = pending_requests_.find(*i);
+    if (to_start != pending_requests_.end())
+      StartScheduledRequest(to_start->second);
+  }
+
   // If we have no more pending requests, then stop the load state monitor
   if (pending_requests_.empty() && update_load_states_timer_.get())
     update_load_states_timer_->Stop();
@@ -1767,6 +1787,17 @@ void ResourceDispatcherHostImpl::BeginRequestInternal(
 }
 
 void ResourceDispatcherHostImpl::StartRequest(net::URLRequest* request) {
+  ResourceRequestInfoImpl* info = ResourceRequestInfoImpl::ForRequest(request);
+  // Otherwise RemovePendingRequest() starts it once the requests that held it
+  // back are done.
+  if (scheduler_.ScheduleRequest(info->GetChildID(), info->GetRouteID(),
+                                 request)) {
+    StartScheduledRequest(request);
+  }
+}
+
+void ResourceDispatcherHostImpl::StartScheduledRequest(
+    net::URLRequest* request) {
   request->Start();
 
   // Make sure we have the load state monitor running
@@ -25,6 +25,7 @@
 #include "base/time.h"
 #include "base/timer.h"
 #include "content/browser/download/download_resource_handler.h"
+#include "content/browser/renderer_host/resource_scheduler.h"
 #include "content/browser/ssl/ssl_error_handler.h"
 #include "content/common/content_export.h"
 #include "content/public/browser/child_process_data.h"
@@ -286,8 +287,12 @@ class CONTENT_EXPORT ResourceDispatcherHostImpl
   // this method with the proper value for the timed_out parameter.
   void HandleSwapOutACK(const ViewMsg_SwapOut_Params& params, bool timed_out);
 
+  // Starts |request| once the scheduler lets it.
   void StartRequest(net::URLRequest* request);
 
+  // Starts |request| now.
+  void StartScheduledRequest(net::URLRequest* request);
+
   // Returns true if the request is paused.
   bool PauseRequestIfNeeded(ResourceRequestInfoImpl* info);
 
@@ -449,6 +454,9 @@ class CONTENT_EXPORT ResourceDispatcherHostImpl
       RegisteredTempFiles;  // key is child process id
   RegisteredTempFiles registered_temp_files_;
 
+  // Decides when the requests of each tab start.
+  ResourceScheduler scheduler_;
+
   // A timer that periodically calls UpdateLoadStates while pending_requests_
   // is not empty.
   scoped_ptr<base::RepeatingTimer<ResourceDispatcherHostImpl> >
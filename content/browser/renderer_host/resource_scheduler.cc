@@ -0,0 +1,128 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/resource_scheduler.h"
+
+#include "base/logging.h"
+#include "net/base/request_priority.h"
+#include "net/url_request/url_request.h"
+
+namespace content {
+
+namespace {
+
+bool IsDelayable(const net::URLRequest* request) {
+  return request->priority() < net::LOW;
+}
+
+bool IsRenderBlocking(const net::URLRequest* request) {
+  return request->priority() == net::MEDIUM;
+}
+
+}  // namespace
+
+// static
+const size_t ResourceScheduler::kMaxDelayableRequestsPerClient;
+// static
+const size_t ResourceScheduler::kMaxDelayableRequestsWhileBlocked;
+
+ResourceScheduler::Client::Client()
+    : in_flight(0),
+      in_flight_blocking(0),
+      in_flight_delayable(0) {
+}
+
+ResourceScheduler::Client::~Client() {
+}
+
+ResourceScheduler::ResourceScheduler() : next_sequence_number_(0) {
+}
+
+ResourceScheduler::~ResourceScheduler() {
+}
+
+bool ResourceScheduler::ScheduleRequest(int child_id,
+                                        int route_id,
+                                        net::URLRequest* request) {
+  DCHECK(requests_.find(request) == requests_.end());
+
+  ClientId client_id(child_id, route_id);
+  Client& client = clients_[client_id];
+  RequestState& state = requests_[request];
+  state.client_id = client_id;
+
+  // Requests already in the queue go first.
+  if (CanStartRequest(client, request) &&
+      (!IsDelayable(request) || client.queue.empty())) {
+    state.in_flight = true;
+    MarkInFlight(&client, request);
+    return true;
+  }
+
+  state.in_flight = false;
+  state.queue_key = QueueKey(-request->priority(), next_sequence_number_++);
+  client.queue[state.queue_key] = request;
+  return false;
+}
+
+void ResourceScheduler::RemoveRequest(
+    net::URLRequest* request,
+    std::vector<net::URLRequest*>* requests_to_start) {
+  RequestMap::iterator it = requests_.find(request);
+  if (it == requests_.end())
+    return;
+
+  ClientMap::iterator client_it = clients_.find(it->second.client_id);
+  DCHECK(client_it != clients_.end());
+  Client& client = client_it->second;
+  if (!it->second.in_flight) {
+    client.queue.erase(it->second.queue_key);
+  } else {
+    DCHECK_GT(client.in_flight, 0u);
+    --client.in_flight;
+    if (IsRenderBlocking(request)) {
+      DCHECK_GT(client.in_flight_blocking, 0u);
+      --client.in_flight_blocking;
+    } else if (IsDelayable(request)) {
+      DCHECK_GT(client.in_flight_delayable, 0u);
+      --client.in_flight_delayable;
+    }
+  }
+  requests_.erase(it);
+
+  while (!client.queue.empty()) {
+    net::URLRequest* next = client.queue.begin()->second;
+    if (!CanStartRequest(client, next))
+      break;
+    client.queue.erase(client.queue.begin());
+    requests_[next].in_flight = true;
+    MarkInFlight(&client, next);
+    requests_to_start->push_back(next);
+  }
+
+  if (client.queue.empty() && client.in_flight == 0)
+    clients_.erase(client_it);
+}
+
+// static
+bool ResourceScheduler::CanStartRequest(const Client& client,
+                                        const net::URLRequest* request) {
+  if (!IsDelayable(request))
+    return true;
+  size_t limit = client.in_flight_blocking > 0 ?
+      kMaxDelayableRequestsWhileBlocked : kMaxDelayableRequestsPerClient;
+  return client.in_flight_delayable < limit;
+}
+
+// static
+void ResourceScheduler::MarkInFlight(Client* client,
+                                     const net::URLRequest* request) {
+  ++client->in_flight;
+  if (IsRenderBlocking(request))
+    ++client->in_flight_blocking;
+  else if (IsDelayable(request))
+    ++client->in_flight_delayable;
+}
+
+}  // namespace content
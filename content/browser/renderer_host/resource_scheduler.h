@@ -0,0 +1,103 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_RENDERER_HOST_RESOURCE_SCHEDULER_H_
+#define CONTENT_BROWSER_RENDERER_HOST_RESOURCE_SCHEDULER_H_
+#pragma once
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "content/common/content_export.h"
+
+namespace net {
+class URLRequest;
+}
+
+namespace content {
+
+// Decides when the URLRequests of each tab start, so that images and
+// prefetches don't compete for the network with the stylesheets, scripts and
+// fonts that block the page from rendering.
+//
+// Requests below net::LOW priority are delayable. A tab has at most
+// |kMaxDelayableRequestsPerClient| of them in flight, and only one while any
+// of its render-blocking (net::MEDIUM) requests are in flight. Everything else
+// starts right away. Queued requests start in priority order, then in the
+// order they were scheduled.
+//
+// A client is identified by a child process ID and a route ID, so each tab of
+// a renderer is scheduled on its own. Lives on the IO thread.
+class CONTENT_EXPORT ResourceScheduler {
+ public:
+  // The most delayable requests a client has in flight at once.
+  static const size_t kMaxDelayableRequestsPerClient = 10;
+
+  // The most delayable requests a client has in flight while at least one of
+  // its render-blocking requests is in flight.
+  static const size_t kMaxDelayableRequestsWhileBlocked = 1;
+
+  ResourceScheduler();
+  ~ResourceScheduler();
+
+  // Called when |request| of the client |child_id|, |route_id| is ready to
+  // start. Returns true if it should start now; otherwise it's queued and
+  // will be returned by a later call to RemoveRequest().
+  bool ScheduleRequest(int child_id, int route_id, net::URLRequest* request);
+
+  // Called when |request| is finished or cancelled, whether it was started or
+  // not. Requests that were never scheduled are ignored. Appends the queued
+  // requests that can start now to |requests_to_start|; the caller is
+  // expected to start them.
+  void RemoveRequest(net::URLRequest* request,
+                     std::vector<net::URLRequest*>* requests_to_start);
+
+ private:
+  typedef std::pair<int, int> ClientId;
+
+  // Queued requests, in the order to start them: highest priority first, then
+  // by sequence number.
+  typedef std::pair<int, int64> QueueKey;
+  typedef std::map<QueueKey, net::URLRequest*> RequestQueue;
+
+  struct Client {
+    Client();
+    ~Client();
+
+    size_t in_flight;
+    size_t in_flight_blocking;
+    size_t in_flight_delayable;
+    RequestQueue queue;
+  };
+  typedef std::map<ClientId, Client> ClientMap;
+
+  // Where a scheduled request is.
+  struct RequestState {
+    ClientId client_id;
+    bool in_flight;
+    QueueKey queue_key;  // Only meaningful while queued.
+  };
+  typedef std::map<net::URLRequest*, RequestState> RequestMap;
+
+  // Returns true if |request| can start now for |client|.
+  static bool CanStartRequest(const Client& client,
+                              const net::URLRequest* request);
+
+  // Counts |request| as in flight for |client|.
+  static void MarkInFlight(Client* client, const net::URLRequest* request);
+
+  ClientMap clients_;
+  RequestMap requests_;
+
+  // Orders queued requests of the same priority.
+  int64 next_sequence_number_;
+
+  DISALLOW_COPY_AND_ASSIGN(ResourceScheduler);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_RENDERER_HOST_RESOURCE_SCHEDULER_H_
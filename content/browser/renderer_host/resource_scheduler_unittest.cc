@@ -0,0 +1,154 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/renderer_host/resource_scheduler.h"
+
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop.h"
+#include "googleurl/src/gurl.h"
+#include "net/base/request_priority.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+namespace {
+
+const int kChildId = 1;
+const int kRouteId = 2;
+
+class ResourceSchedulerTest : public testing::Test {
+ protected:
+  ResourceSchedulerTest()
+      : message_loop_(MessageLoop::TYPE_IO),
+        last_request_(NULL) {
+  }
+
+  net::URLRequest* NewRequest(net::RequestPriority priority) {
+    net::URLRequest* request =
+        new net::URLRequest(GURL("http://host/"), &delegate_);
+    request->set_priority(priority);
+    requests_.push_back(request);
+    last_request_ = request;
+    return request;
+  }
+
+  // Schedules a new request for |route_id| and returns it once it may start,
+  // or NULL if it was queued.
+  net::URLRequest* ScheduleRequest(int route_id,
+                                   net::RequestPriority priority) {
+    net::URLRequest* request = NewRequest(priority);
+    return scheduler_.ScheduleRequest(kChildId, route_id, request) ?
+        request : NULL;
+  }
+
+  // Removes |request| and returns the requests that can start because of it.
+  std::vector<net::URLRequest*> RemoveRequest(net::URLRequest* request) {
+    std::vector<net::URLRequest*> requests_to_start;
+    scheduler_.RemoveRequest(request, &requests_to_start);
+    return requests_to_start;
+  }
+
+  MessageLoop message_loop_;
+  TestDelegate delegate_;
+  ScopedVector<net::URLRequest> requests_;
+  net::URLRequest* last_request_;  // The most recent of |requests_|.
+  ResourceScheduler scheduler_;
+};
+
+TEST_F(ResourceSchedulerTest, NonDelayableRequestsStartRightAway) {
+  for (size_t i = 0; i < 2 * ResourceScheduler::kMaxDelayableRequestsPerClient;
+       ++i) {
+    EXPECT_TRUE(ScheduleRequest(kRouteId, net::HIGHEST));
+    EXPECT_TRUE(ScheduleRequest(kRouteId, net::MEDIUM));
+    EXPECT_TRUE(ScheduleRequest(kRouteId, net::LOW));
+  }
+}
+
+TEST_F(ResourceSchedulerTest, DelayableRequestsAreLimited) {
+  std::vector<net::URLRequest*> started;
+  for (size_t i = 0; i < ResourceScheduler::kMaxDelayableRequestsPerClient;
+       ++i) {
+    net::URLRequest* request = ScheduleRequest(kRouteId, net::LOWEST);
+    ASSERT_TRUE(request);
+    started.push_back(request);
+  }
+  EXPECT_FALSE(ScheduleRequest(kRouteId, net::LOWEST));
+  net::URLRequest* queued = last_request_;
+
+  // Other tabs have their own limit.
+  EXPECT_TRUE(ScheduleRequest(kRouteId + 1, net::LOWEST));
+
+  std::vector<net::URLRequest*> to_start = RemoveRequest(started[0]);
+  ASSERT_EQ(1u, to_start.size());
+  EXPECT_EQ(queued, to_start[0]);
+}
+
+TEST_F(ResourceSchedulerTest, RenderBlockingRequestsHoldBackDelayable) {
+  net::URLRequest* script = ScheduleRequest(kRouteId, net::MEDIUM);
+  ASSERT_TRUE(script);
+  for (size_t i = 0; i < ResourceScheduler::kMaxDelayableRequestsWhileBlocked;
+       ++i) {
+    EXPECT_TRUE(ScheduleRequest(kRouteId, net::LOWEST));
+  }
+  EXPECT_FALSE(ScheduleRequest(kRouteId, net::LOWEST));
+  EXPECT_FALSE(ScheduleRequest(kRouteId, net::IDLE));
+
+  EXPECT_EQ(2u, RemoveRequest(script).size());
+}
+
+TEST_F(ResourceSchedulerTest, QueuedRequestsStartInPriorityOrder) {
+  ASSERT_TRUE(ScheduleRequest(kRouteId, net::MEDIUM));
+  net::URLRequest* image = ScheduleRequest(kRouteId, net::LOWEST);
+  ASSERT_TRUE(image);
+  EXPECT_FALSE(ScheduleRequest(kRouteId, net::IDLE));
+  net::URLRequest* idle = last_request_;
+  EXPECT_FALSE(ScheduleRequest(kRouteId, net::LOWEST));
+  net::URLRequest* lowest = last_request_;
+
+  std::vector<net::URLRequest*> to_start = RemoveRequest(image);
+  ASSERT_EQ(1u, to_start.size());
+  EXPECT_EQ(lowest, to_start[0]);
+
+  to_start = RemoveRequest(lowest);
+  ASSERT_EQ(1u, to_start.size());
+  EXPECT_EQ(idle, to_start[0]);
+}
+
+TEST_F(ResourceSchedulerTest, OnlyDelayableRequestsFreeUpRoom) {
+  net::URLRequest* script = ScheduleRequest(kRouteId, net::MEDIUM);
+  ASSERT_TRUE(script);
+  net::URLRequest* image = ScheduleRequest(kRouteId, net::LOWEST);
+  ASSERT_TRUE(image);
+  EXPECT_FALSE(ScheduleRequest(kRouteId, net::LOWEST));
+  net::URLRequest* queued = last_request_;
+
+  net::URLRequest* frame = ScheduleRequest(kRouteId, net::HIGHEST);
+  ASSERT_TRUE(frame);
+  EXPECT_TRUE(RemoveRequest(frame).empty());
+
+  std::vector<net::URLRequest*> to_start = RemoveRequest(script);
+  ASSERT_EQ(1u, to_start.size());
+  EXPECT_EQ(queued, to_start[0]);
+}
+
+TEST_F(ResourceSchedulerTest, CancelledQueuedRequestIsNotStarted) {
+  net::URLRequest* script = ScheduleRequest(kRouteId, net::MEDIUM);
+  ASSERT_TRUE(script);
+  EXPECT_TRUE(ScheduleRequest(kRouteId, net::LOWEST));
+  EXPECT_FALSE(ScheduleRequest(kRouteId, net::LOWEST));
+  net::URLRequest* queued = last_request_;
+
+  EXPECT_TRUE(RemoveRequest(queued).empty());
+  EXPECT_TRUE(RemoveRequest(script).empty());
+}
+
+TEST_F(ResourceSchedulerTest, UnscheduledRequestIsIgnored) {
+  EXPECT_TRUE(RemoveRequest(NewRequest(net::LOWEST)).empty());
+}
+
+}  // namespace
+
+}  // namespace content
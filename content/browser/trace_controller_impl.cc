@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/debug/trace_event.h"
 #include "base/string_number_conversions.h"
 #include "content/browser/trace_message_filter.h"
@@ -253,6 +254,7 @@ void TraceControllerImpl::OnTracingBegan(TraceSubscriber* subscriber) {
 
   TraceLog::GetInstance()->GetEnabledTraceCategories(&included_categories_,
                                                      &excluded_categories_);
+  base::debug::TraceHeapTagCounters();
   // Notify all child processes.
   for (FilterMap::iterator it = filters_.begin(); it != filters_.end(); ++it) {
     it->get()->SendBeginTracing(included_categories_, excluded_categories_);
@@ -282,6 +284,7 @@ void TraceControllerImpl::OnEndTracingAck(
     // called with the last of the local trace data. Since we are on the UI
     // thread, the call to OnTraceDataCollected will be synchronous, so we can
     // immediately call OnEndTracingComplete below.
+    base::debug::TraceHeapTagCounters();
     TraceLog::GetInstance()->SetEnabled(false);
 
     // Trigger callback if one is set.
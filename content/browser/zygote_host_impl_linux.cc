@@ -119,6 +119,7 @@ void ZygoteHostImpl::Init(const std::string& sandbox_cmd) {
     switches::kV,
     switches::kVModule,
     switches::kRegisterPepperPlugins,
+    switches::kRendererPoolSize,
     switches::kDisableSeccompSandbox,
     switches::kEnableSeccompSandbox,
   };
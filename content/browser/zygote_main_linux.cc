@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/sysinfo.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -28,6 +29,7 @@
 #include "base/process_util.h"
 #include "base/rand_util.h"
 #include "base/rand_util_c.h"
+#include "base/string_number_conversions.h"
 #include "base/sys_info.h"
 #include "build/build_config.h"
 #include "crypto/nss_util.h"
@@ -69,6 +71,14 @@ static bool g_suid_sandbox_active = false;
 
 static const char kUrandomDevPath[] = "/dev/urandom";
 
+// The number of renderers kept in the pool when --renderer-pool-size isn't
+// given.
+static const int kDefaultRendererPoolSize = 1;
+
+// The pool isn't refilled, and the renderers in it are let go, while less
+// than this percentage of physical memory is free.
+static const int kRendererPoolMinFreeMemoryPercent = 5;
+
 #if defined(SECCOMP_SANDBOX)
 static int g_proc_fd = -1;
 #endif
@@ -102,11 +112,24 @@ class Zygote {
       : sandbox_flags_(sandbox_flags),
         helper_(helper),
         initial_uma_sample_(0),
-        initial_uma_boundary_value_(0) {
+        initial_uma_boundary_value_(0),
+        renderer_pool_size_(kDefaultRendererPoolSize) {
     if (helper_)
       helper_->InitialUMA(&initial_uma_name_,
                           &initial_uma_sample_,
                           &initial_uma_boundary_value_);
+
+    const CommandLine& command_line = *CommandLine::ForCurrentProcess();
+    if (command_line.HasSwitch(switches::kRendererPoolSize)) {
+      std::string pool_size =
+          command_line.GetSwitchValueASCII(switches::kRendererPoolSize);
+      if (!base::StringToInt(pool_size, &renderer_pool_size_) ||
+          renderer_pool_size_ < 0) {
+        LOG(WARNING) << "Invalid --" << switches::kRendererPoolSize << ": "
+                     << pool_size;
+        renderer_pool_size_ = kDefaultRendererPoolSize;
+      }
+    }
   }
 
   bool ProcessRequests() {
@@ -140,6 +163,10 @@ class Zygote {
 #endif
     }
 
+    // This function call can return multiple times, once per fork().
+    if (FillRendererPool())
+      return true;
+
     for (;;) {
       // This function call can return multiple times, once per fork().
       if (HandleRequestFromBrowser(kBrowserDescriptor))
@@ -400,98 +427,286 @@ class Zygote {
     return -1;
   }
 
-  // Unpacks process type and arguments from |pickle| and forks a new process.
-  // Returns -1 on error, otherwise returns twice, returning 0 to the child
-  // process and the child process ID to the parent process, like fork().
-  base::ProcessId ReadArgsAndFork(const Pickle& pickle,
-                                  PickleIterator iter,
-                                  std::vector<int>& fds,
-                                  std::string* uma_name,
-                                  int* uma_sample,
-                                  int* uma_boundary_value) {
-    std::vector<std::string> args;
+  // Unpacks process type and arguments from |pickle|, and returns false if
+  // they don't parse. |fds| are the descriptors that came with |pickle|.
+  bool ReadArgs(const Pickle& pickle,
+                PickleIterator iter,
+                const std::vector<int>& fds,
+                std::string* process_type,
+                std::vector<std::string>* args,
+                std::string* channel_id,
+                base::GlobalDescriptors::Mapping* mapping) {
     int argc = 0;
     int numfds = 0;
-    base::GlobalDescriptors::Mapping mapping;
-    std::string process_type;
-    std::string channel_id;
     const std::string channel_id_prefix = std::string("--")
         + switches::kProcessChannelID + std::string("=");
 
-    if (!pickle.ReadString(&iter, &process_type))
-      return -1;
+    if (!pickle.ReadString(&iter, process_type))
+      return false;
     if (!pickle.ReadInt(&iter, &argc))
-      return -1;
+      return false;
 
     for (int i = 0; i < argc; ++i) {
       std::string arg;
       if (!pickle.ReadString(&iter, &arg))
-        return -1;
-      args.push_back(arg);
+        return false;
+      args->push_back(arg);
       if (arg.compare(0, channel_id_prefix.length(), channel_id_prefix) == 0)
-        channel_id = arg;
+        *channel_id = arg;
     }
 
     if (!pickle.ReadInt(&iter, &numfds))
-      return -1;
+      return false;
     if (numfds != static_cast<int>(fds.size()))
-      return -1;
+      return false;
 
     for (int i = 0; i < numfds; ++i) {
       base::GlobalDescriptors::Key key;
       if (!pickle.ReadUInt32(&iter, &key))
-        return -1;
-      mapping.push_back(std::make_pair(key, fds[i]));
+        return false;
+      mapping->push_back(std::make_pair(key, fds[i]));
     }
 
-    mapping.push_back(std::make_pair(
+    mapping->push_back(std::make_pair(
         static_cast<uint32_t>(kSandboxIPCChannel), kMagicSandboxIPCDescriptor));
+    return true;
+  }
 
-    // Returns twice, once per process.
-    base::ProcessId child_pid = ForkWithRealPid(process_type, fds, channel_id,
-                                                uma_name, uma_sample,
-                                                uma_boundary_value);
-    if (!child_pid) {
-      // This is the child process.
+  // Sets up a newly forked child to run with |args| and the descriptors in
+  // |mapping|, once it no longer needs anything from the zygote.
+  void SetUpChild(const std::vector<std::string>& args,
+                  const base::GlobalDescriptors::Mapping& mapping) {
 #if defined(SECCOMP_SANDBOX)
-      if (SeccompSandboxEnabled() && g_proc_fd >= 0) {
-        // Try to open /proc/self/maps as the seccomp sandbox needs access to it
-        int proc_self_maps = openat(g_proc_fd, "self/maps", O_RDONLY);
-        if (proc_self_maps >= 0) {
-          SeccompSandboxSetProcSelfMaps(proc_self_maps);
-        } else {
-          PLOG(ERROR) << "openat(/proc/self/maps)";
-        }
-        close(g_proc_fd);
-        g_proc_fd = -1;
+    if (SeccompSandboxEnabled() && g_proc_fd >= 0) {
+      // Try to open /proc/self/maps as the seccomp sandbox needs access to it
+      int proc_self_maps = openat(g_proc_fd, "self/maps", O_RDONLY);
+      if (proc_self_maps >= 0) {
+        SeccompSandboxSetProcSelfMaps(proc_self_maps);
+      } else {
+        PLOG(ERROR) << "openat(/proc/self/maps)";
       }
+      close(g_proc_fd);
+      g_proc_fd = -1;
+    }
 #endif
 
-      close(kBrowserDescriptor);  // our socket from the browser
-      if (g_suid_sandbox_active)
-        close(kZygoteIdDescriptor);  // another socket from the browser
-      base::GlobalDescriptors::GetInstance()->Reset(mapping);
+    close(kBrowserDescriptor);  // our socket from the browser
+    if (g_suid_sandbox_active)
+      close(kZygoteIdDescriptor);  // another socket from the browser
+    base::GlobalDescriptors::GetInstance()->Reset(mapping);
 
 #if defined(CHROMIUM_SELINUX)
-      SELinuxTransitionToTypeOrDie("chromium_renderer_t");
+    SELinuxTransitionToTypeOrDie("chromium_renderer_t");
 #endif
 
-      // Reset the process-wide command line to our new command line.
-      CommandLine::Reset();
-      CommandLine::Init(0, NULL);
-      CommandLine::ForCurrentProcess()->InitFromArgv(args);
+    // Reset the process-wide command line to our new command line.
+    CommandLine::Reset();
+    CommandLine::Init(0, NULL);
+    CommandLine::ForCurrentProcess()->InitFromArgv(args);
 
-      // Update the process title. The argv was already cached by the call to
-      // SetProcessTitleFromCommandLine in ChromeMain, so we can pass NULL here
-      // (we don't have the original argv at this point).
-      SetProcessTitleFromCommandLine(NULL);
+    // Update the process title. The argv was already cached by the call to
+    // SetProcessTitleFromCommandLine in ChromeMain, so we can pass NULL here
+    // (we don't have the original argv at this point).
+    SetProcessTitleFromCommandLine(NULL);
+  }
+
+  // Unpacks process type and arguments from |pickle| and forks a new process.
+  // Returns -1 on error, otherwise returns twice, returning 0 to the child
+  // process and the child process ID to the parent process, like fork().
+  base::ProcessId ReadArgsAndFork(const Pickle& pickle,
+                                  PickleIterator iter,
+                                  std::vector<int>& fds,
+                                  std::string* uma_name,
+                                  int* uma_sample,
+                                  int* uma_boundary_value) {
+    std::vector<std::string> args;
+    base::GlobalDescriptors::Mapping mapping;
+    std::string process_type;
+    std::string channel_id;
+    if (!ReadArgs(pickle, iter, fds, &process_type, &args, &channel_id,
+                  &mapping)) {
+      return -1;
+    }
+
+    // Returns twice, once per process.
+    base::ProcessId child_pid = ForkWithRealPid(process_type, fds, channel_id,
+                                                uma_name, uma_sample,
+                                                uma_boundary_value);
+    if (!child_pid) {
+      // This is the child process.
+      CloseRendererPool();
+      SetUpChild(args, mapping);
     } else if (child_pid < 0) {
       LOG(ERROR) << "Zygote could not fork: process_type " << process_type
-          << " numfds " << numfds << " child_pid " << child_pid;
+          << " numfds " << fds.size() << " child_pid " << child_pid;
     }
     return child_pid;
   }
 
+  // ---------------------------------------------------------------------------
+  // The renderer pool...
+  //
+  // Renderers forked ahead of time wait in the pool for the browser to ask
+  // for one, so that a new tab doesn't wait for the fork and for the child to
+  // synchronise its PID with the zygote. Each one blocks on its own socket
+  // until the zygote passes it the fork request it is taking over.
+
+  struct PooledRenderer {
+    base::ProcessId pid;
+    int fd;  // The zygote's end of the socket the renderer waits on.
+  };
+
+  // Returns true if enough memory is free to keep renderers waiting around.
+  static bool HaveMemoryForRendererPool() {
+    struct sysinfo info;
+    if (sysinfo(&info) != 0)
+      return false;
+    // sysinfo() doesn't count the page cache, so this underestimates what's
+    // free and errs on the side of a smaller pool.
+    uint64 available =
+        (static_cast<uint64>(info.freeram) + info.bufferram) * info.mem_unit;
+    uint64 total = static_cast<uint64>(info.totalram) * info.mem_unit;
+    return available * 100 >= total * kRendererPoolMinFreeMemoryPercent;
+  }
+
+  // Forks renderers until the pool is full, or lets the pooled ones go if
+  // memory is short. Returns true in a pooled renderer once it has been
+  // handed out and needs to unwind back into ChromeMain.
+  bool FillRendererPool() {
+    if (renderer_pool_size_ == 0)
+      return false;
+
+    if (!HaveMemoryForRendererPool()) {
+      while (!renderer_pool_.empty()) {
+        ReapPooledRenderer(renderer_pool_.back());
+        renderer_pool_.pop_back();
+      }
+      return false;
+    }
+    if (renderer_pool_.size() >= static_cast<size_t>(renderer_pool_size_))
+      return false;
+
+    // A fork delegate that takes renderers needs the request's arguments
+    // before it forks, so it can't use the pool.
+    std::string uma_name;
+    int uma_sample;
+    int uma_boundary_value;
+    if (helper_ && helper_->CanHelp(switches::kRendererProcess, &uma_name,
+                                    &uma_sample, &uma_boundary_value)) {
+      return false;
+    }
+
+    while (renderer_pool_.size() < static_cast<size_t>(renderer_pool_size_)) {
+      int sockets[2];
+      if (socketpair(PF_UNIX, SOCK_SEQPACKET, 0, sockets) != 0) {
+        PLOG(ERROR) << "socketpair";
+        return false;
+      }
+
+      std::vector<int> no_fds;
+      base::ProcessId pid = ForkWithRealPid(switches::kRendererProcess,
+                                            no_fds, std::string(), &uma_name,
+                                            &uma_sample, &uma_boundary_value);
+      if (pid == 0) {
+        // This is the pooled renderer.
+        close(sockets[0]);
+        CloseRendererPool();
+        return WaitForForkRequest(sockets[1]);
+      }
+
+      close(sockets[1]);
+      if (pid < 0) {
+        close(sockets[0]);
+        return false;
+      }
+      PooledRenderer renderer = { pid, sockets[0] };
+      renderer_pool_.push_back(renderer);
+    }
+    return false;
+  }
+
+  // Runs in a pooled renderer: waits on |fd| for the fork request the zygote
+  // hands over, and sets the process up to handle it. Returns true so the
+  // caller unwinds back into ChromeMain.
+  bool WaitForForkRequest(int fd) {
+    std::vector<int> fds;
+    static const unsigned kMaxMessageLength = 2048;
+    char buf[kMaxMessageLength];
+    const ssize_t len = UnixDomainSocket::RecvMsg(fd, buf, sizeof(buf), &fds);
+    close(fd);
+    if (len <= 0) {
+      // The zygote let us go, or died.
+      _exit(0);
+    }
+
+    Pickle pickle(buf, len);
+    PickleIterator iter(pickle);
+    int kind;
+    std::vector<std::string> args;
+    base::GlobalDescriptors::Mapping mapping;
+    std::string process_type;
+    std::string channel_id;
+    if (!pickle.ReadInt(&iter, &kind) || kind != ZygoteHostImpl::kCmdFork ||
+        !ReadArgs(pickle, iter, fds, &process_type, &args, &channel_id,
+                  &mapping)) {
+      LOG(ERROR) << "Pooled renderer got a bad fork request";
+      _exit(1);
+    }
+    DCHECK_EQ(std::string(switches::kRendererProcess), process_type);
+
+    SetUpChild(args, mapping);
+    return true;
+  }
+
+  // Passes the fork request in |pickle| and |fds| on to a pooled renderer.
+  // Returns the renderer's PID, or -1 if the request isn't for a renderer or
+  // the pool is empty.
+  base::ProcessId TakePooledRenderer(const Pickle& pickle,
+                                     PickleIterator iter,
+                                     const std::vector<int>& fds) {
+    std::string process_type;
+    if (renderer_pool_.empty() || !pickle.ReadString(&iter, &process_type) ||
+        process_type != switches::kRendererProcess) {
+      return -1;
+    }
+
+    while (!renderer_pool_.empty()) {
+      PooledRenderer renderer = renderer_pool_.back();
+      renderer_pool_.pop_back();
+      bool sent = UnixDomainSocket::SendMsg(renderer.fd, pickle.data(),
+                                            pickle.size(), fds);
+      if (sent) {
+        close(renderer.fd);
+        return renderer.pid;
+      }
+      // It died while it waited.
+      PLOG(WARNING) << "Failed to hand a fork request to a pooled renderer";
+      ReapPooledRenderer(renderer);
+    }
+    return -1;
+  }
+
+  // Lets a pooled renderer go: it exits when its socket closes.
+  void ReapPooledRenderer(const PooledRenderer& renderer) {
+    close(renderer.fd);
+    base::ProcessId actual_pid = renderer.pid;
+    if (g_suid_sandbox_active) {
+      actual_pid = real_pids_to_sandbox_pids[renderer.pid];
+      real_pids_to_sandbox_pids.erase(renderer.pid);
+    }
+    if (actual_pid)
+      base::EnsureProcessTerminated(actual_pid);
+  }
+
+  // Closes the zygote's ends of the pooled renderers' sockets in a newly
+  // forked child, which mustn't keep them alive.
+  void CloseRendererPool() {
+    for (std::vector<PooledRenderer>::const_iterator
+         i = renderer_pool_.begin(); i != renderer_pool_.end(); ++i)
+      close(i->fd);
+    renderer_pool_.clear();
+  }
+
   // Handle a 'fork' request from the browser: this means that the browser
   // wishes to start a new renderer.  Returns true if we are in a new process,
   // otherwise writes the child_pid back to the browser via |fd|.  Writes a
@@ -501,11 +716,13 @@ class Zygote {
     std::string uma_name;
     int uma_sample;
     int uma_boundary_value;
-    base::ProcessId child_pid = ReadArgsAndFork(pickle, iter, fds,
-                                                &uma_name, &uma_sample,
-                                                &uma_boundary_value);
-    if (child_pid == 0)
-      return true;
+    base::ProcessId child_pid = TakePooledRenderer(pickle, iter, fds);
+    if (child_pid < 0) {
+      child_pid = ReadArgsAndFork(pickle, iter, fds, &uma_name, &uma_sample,
+                                  &uma_boundary_value);
+      if (child_pid == 0)
+        return true;
+    }
     for (std::vector<int>::const_iterator
          i = fds.begin(); i != fds.end(); ++i)
       close(*i);
@@ -529,7 +746,10 @@ class Zygote {
     if (HANDLE_EINTR(write(fd, reply_pickle.data(), reply_pickle.size())) !=
         static_cast<ssize_t> (reply_pickle.size()))
       PLOG(ERROR) << "write";
-    return false;
+
+    // Refill the pool now that the browser isn't waiting on us.
+    // This function call can return multiple times, once per fork().
+    return FillRendererPool();
   }
 
   bool HandleGetSandboxStatus(int fd,
@@ -557,6 +777,10 @@ class Zygote {
   std::string initial_uma_name_;
   int initial_uma_sample_;
   int initial_uma_boundary_value_;
+
+  // The number of renderers to keep in |renderer_pool_|.
+  int renderer_pool_size_;
+  std::vector<PooledRenderer> renderer_pool_;
 };
 
 // With SELinux we can carve out a precise sandbox, so we don't have to play
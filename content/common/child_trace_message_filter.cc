@@ -5,6 +5,7 @@
 #include "content/common/child_trace_message_filter.h"
 
 #include "base/bind.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/debug/trace_event.h"
 #include "base/message_loop.h"
 #include "content/common/child_process.h"
@@ -48,6 +49,7 @@ void ChildTraceMessageFilter::OnBeginTracing(
     const std::vector<std::string>& excluded_categories) {
   base::debug::TraceLog::GetInstance()->SetEnabled(included_categories,
                                                    excluded_categories);
+  base::debug::TraceHeapTagCounters();
 }
 
 void ChildTraceMessageFilter::OnEndTracing() {
@@ -56,6 +58,7 @@ void ChildTraceMessageFilter::OnEndTracing() {
   // EndTracingAck below.
   // We are already on the IO thread, so it is guaranteed that
   // OnTraceDataCollected is not deferred.
+  base::debug::TraceHeapTagCounters();
   base::debug::TraceLog::GetInstance()->SetDisabled();
 
   std::vector<std::string> categories;
@@ -5,6 +5,7 @@
 #include "content/common/gpu/client/command_buffer_proxy_impl.h"
 
 #include "base/callback.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
 #include "base/process_util.h"
@@ -170,6 +171,9 @@ gpu::CommandBuffer::State CommandBufferProxyImpl::GetState() {
 }
 
 gpu::CommandBuffer::State CommandBufferProxyImpl::GetLastState() {
+  // Reading the shared state is cheap and lets the helper see how far the
+  // service has got without a round trip.
+  TryUpdateState();
   return last_state_;
 }
 
@@ -228,6 +232,7 @@ void CommandBufferProxyImpl::SetGetOffset(int32 get_offset) {
 
 int32 CommandBufferProxyImpl::CreateTransferBuffer(
     size_t size, int32 id_request) {
+  base::debug::ScopedHeapTag heap_tag(base::debug::HEAP_TAG_GPU_CLIENT);
   if (last_state_.error != gpu::error::kNoError)
     return -1;
 
@@ -307,6 +312,7 @@ void CommandBufferProxyImpl::DestroyTransferBuffer(int32 id) {
 }
 
 Buffer CommandBufferProxyImpl::GetTransferBuffer(int32 id) {
+  base::debug::ScopedHeapTag heap_tag(base::debug::HEAP_TAG_GPU_CLIENT);
   if (last_state_.error != gpu::error::kNoError)
     return Buffer();
 
@@ -412,6 +418,16 @@ bool CommandBufferProxyImpl::EnsureBackbuffer() {
   return Send(new GpuCommandBufferMsg_EnsureBackbuffer(route_id_));
 }
 
+uint32 CommandBufferProxyImpl::InsertSyncPoint() {
+  if (last_state_.error != gpu::error::kNoError)
+    return 0;
+
+  uint32 sync_point = 0;
+  if (!Send(new GpuCommandBufferMsg_InsertSyncPoint(route_id_, &sync_point)))
+    return 0;
+  return sync_point;
+}
+
 bool CommandBufferProxyImpl::SetParent(
     CommandBufferProxy* parent_command_buffer,
     uint32 parent_texture_id) {
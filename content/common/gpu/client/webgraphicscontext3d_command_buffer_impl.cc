@@ -17,6 +17,7 @@
 #include "base/lazy_instance.h"
 #include "base/string_tokenizer.h"
 #include "base/command_line.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
 #include "base/message_loop.h"
@@ -329,6 +330,7 @@ bool WebGraphicsContext3DCommandBufferImpl::InitializeCommandBuffer(
 bool WebGraphicsContext3DCommandBufferImpl::CreateContext(
     bool onscreen,
     const char* allowed_extensions) {
+  base::debug::ScopedHeapTag heap_tag(base::debug::HEAP_TAG_GPU_CLIENT);
 
   // Ensure the gles2 library is initialized first in a thread safe way.
   g_gles2_initializer.Get();
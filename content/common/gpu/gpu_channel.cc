@@ -37,12 +37,14 @@ const int64 kHandleMoreWorkPeriodBusyMs = 1;
 GpuChannel::GpuChannel(GpuChannelManager* gpu_channel_manager,
                        GpuWatchdog* watchdog,
                        gfx::GLShareGroup* share_group,
+                       gpu::gles2::MailboxManager* mailbox_manager,
                        int client_id,
                        bool software)
     : gpu_channel_manager_(gpu_channel_manager),
       client_id_(client_id),
       share_group_(share_group ? share_group : new gfx::GLShareGroup),
-      mailbox_manager_(new gpu::gles2::MailboxManager),
+      mailbox_manager_(mailbox_manager ?
+          mailbox_manager : new gpu::gles2::MailboxManager),
       watchdog_(watchdog),
       software_(software),
       handle_messages_scheduled_(false),
@@ -299,8 +301,21 @@ void GpuChannel::HandleMessage() {
       // message to flush that command buffer.
       if (stub) {
         if (stub->HasUnprocessedCommands()) {
-          deferred_messages_.push_front(new GpuCommandBufferMsg_Rescheduled(
-              stub->route_id()));
+          IPC::Message* rescheduled =
+              new GpuCommandBufferMsg_Rescheduled(stub->route_id());
+          if (!stub->IsScheduled() || stub->IsHighPriority()) {
+            deferred_messages_.push_front(rescheduled);
+          } else {
+            // The command buffer used up its time slice. Let messages for
+            // other command buffers that arrived in the meantime go first,
+            // but keep it ahead of its own pending messages.
+            std::deque<IPC::Message*>::iterator it =
+                deferred_messages_.begin();
+            while (it != deferred_messages_.end() &&
+                   (*it)->routing_id() != stub->route_id())
+              ++it;
+            deferred_messages_.insert(it, rescheduled);
+          }
         }
 
         ScheduleDelayedWork(stub, kHandleMoreWorkPeriodMs);
@@ -39,10 +39,13 @@ class GpuChannel : public IPC::Channel::Listener,
                    public IPC::Message::Sender,
                    public base::RefCountedThreadSafe<GpuChannel> {
  public:
-  // Takes ownership of the renderer process handle.
+  // Takes ownership of the renderer process handle. |share_group| and
+  // |mailbox_manager| are either both NULL, in which case the channel gets its
+  // own, or both shared with other channels.
   GpuChannel(GpuChannelManager* gpu_channel_manager,
              GpuWatchdog* watchdog,
              gfx::GLShareGroup* share_group,
+             gpu::gles2::MailboxManager* mailbox_manager,
              int client_id,
              bool software);
 
@@ -156,6 +159,8 @@ class GpuChannel : public IPC::Channel::Listener,
   // process use.
   scoped_refptr<gfx::GLShareGroup> share_group_;
 
+  // Mailboxes only work between contexts in the same share group, so this is
+  // shared exactly when |share_group_| is.
   scoped_refptr<gpu::gles2::MailboxManager> mailbox_manager_;
 
 #if defined(ENABLE_GPU)
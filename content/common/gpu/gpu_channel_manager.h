@@ -8,6 +8,7 @@
 
 #include "base/hash_tables.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/message_loop_proxy.h"
 #include "build/build_config.h"
@@ -24,6 +25,12 @@ namespace gfx {
 class GLShareGroup;
 }
 
+namespace gpu {
+namespace gles2 {
+class MailboxManager;
+}
+}
+
 namespace IPC {
 struct ChannelHandle;
 }
@@ -31,6 +38,7 @@ struct ChannelHandle;
 class ChildThread;
 class GpuChannel;
 class GpuWatchdog;
+class SyncPointManager;
 struct GPUCreateCommandBufferConfig;
 
 // A GpuChannelManager is a thread responsible for issuing rendering commands
@@ -76,6 +84,14 @@ class GpuChannelManager : public IPC::Channel::Listener,
 
   GpuMemoryManager* gpu_memory_manager() { return &gpu_memory_manager_; }
 
+  // Shared by the channels that share |share_group_|, so that a texture put
+  // in a mailbox by one renderer can be taken out by another.
+  gpu::gles2::MailboxManager* mailbox_manager() {
+    return mailbox_manager_.get();
+  }
+
+  SyncPointManager* sync_point_manager() { return sync_point_manager_.get(); }
+
   GpuChannel* LookupChannel(int32 client_id);
 
  private:
@@ -104,8 +120,10 @@ class GpuChannelManager : public IPC::Channel::Listener,
   typedef base::hash_map<int, scoped_refptr<GpuChannel> > GpuChannelMap;
   GpuChannelMap gpu_channels_;
   scoped_refptr<gfx::GLShareGroup> share_group_;
+  scoped_refptr<gpu::gles2::MailboxManager> mailbox_manager_;
   GpuMemoryManager gpu_memory_manager_;
   GpuWatchdog* watchdog_;
+  scoped_ptr<SyncPointManager> sync_point_manager_;
 
   DISALLOW_COPY_AND_ASSIGN(GpuChannelManager);
 };
@@ -18,8 +18,10 @@
 #include "content/common/gpu/gpu_messages.h"
 #include "content/common/gpu/gpu_watchdog.h"
 #include "content/common/gpu/image_transport_surface.h"
+#include "content/common/gpu/sync_point_manager.h"
 #include "gpu/command_buffer/common/constants.h"
 #include "gpu/command_buffer/common/gles2_cmd_utils.h"
+#include "gpu/command_buffer/service/texture_manager.h"
 #include "ui/gfx/gl/gl_bindings.h"
 #include "ui/gfx/gl/gl_switches.h"
 
@@ -27,6 +29,16 @@
 #include "content/public/common/sandbox_init.h"
 #endif
 
+namespace {
+
+// How long a command buffer that nobody is looking at may run before it has
+// to yield to the other command buffers on its channel. Visible onscreen
+// command buffers are never preempted.
+const int64 kOffscreenTimeSliceMs = 4;
+const int64 kHiddenTimeSliceMs = 1;
+
+}  // namespace
+
 GpuCommandBufferStub::SurfaceState::SurfaceState(int32 surface_id,
                                                  bool visible,
                                                  base::TimeTicks last_used_time)
@@ -137,6 +149,10 @@ bool GpuCommandBufferStub::OnMessageReceived(const IPC::Message& message) {
     IPC_MESSAGE_HANDLER(
         GpuCommandBufferMsg_SetClientHasMemoryAllocationChangedCallback,
         OnSetClientHasMemoryAllocationChangedCallback)
+    IPC_MESSAGE_HANDLER_DELAY_REPLY(GpuCommandBufferMsg_InsertSyncPoint,
+                                    OnInsertSyncPoint)
+    IPC_MESSAGE_HANDLER(GpuCommandBufferMsg_RetireSyncPoint,
+                        OnRetireSyncPoint)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
 
@@ -210,6 +226,15 @@ void GpuCommandBufferStub::Destroy() {
     delayed_echos_.pop_front();
   }
 
+  // Don't leave other command buffers waiting on commands that will never be
+  // processed.
+  SyncPointManager* sync_point_manager =
+      channel_->gpu_channel_manager()->sync_point_manager();
+  while (!sync_points_.empty()) {
+    sync_point_manager->RetireSyncPoint(sync_points_.front());
+    sync_points_.pop_front();
+  }
+
   if (decoder_.get())
     decoder_->MakeCurrent();
   FOR_EACH_OBSERVER(DestructionObserver,
@@ -254,6 +279,7 @@ void GpuCommandBufferStub::OnInitialize(
                                          decoder_.get()));
 
   decoder_->set_engine(scheduler_.get());
+  UpdateTimeSlice();
 
   if (!handle_.is_null()) {
 #if defined(OS_MACOSX) || defined(UI_COMPOSITOR_IMAGE_TRANSPORT)
@@ -320,6 +346,9 @@ void GpuCommandBufferStub::OnInitialize(
   decoder_->SetMsgCallback(
       base::Bind(&GpuCommandBufferStub::SendConsoleMessage,
                  base::Unretained(this)));
+  decoder_->SetWaitSyncPointCallback(
+      base::Bind(&GpuCommandBufferStub::OnWaitSyncPoint,
+                 base::Unretained(this)));
 
   command_buffer_->SetPutOffsetChangeCallback(
       base::Bind(&gpu::GpuScheduler::PutChanged,
@@ -573,9 +602,24 @@ void GpuCommandBufferStub::OnSetSurfaceVisible(bool visible) {
   DCHECK(surface_state_.get());
   surface_state_->visible = visible;
   surface_state_->last_used_time = base::TimeTicks::Now();
+  UpdateTimeSlice();
   channel_->gpu_channel_manager()->gpu_memory_manager()->ScheduleManage();
 }
 
+bool GpuCommandBufferStub::IsHighPriority() const {
+  return surface_state_.get() && surface_state_->visible;
+}
+
+void GpuCommandBufferStub::UpdateTimeSlice() {
+  if (!scheduler_.get())
+    return;
+  int64 time_slice_ms = 0;
+  if (!IsHighPriority())
+    time_slice_ms = surface_state_.get() ? kHiddenTimeSliceMs :
+                                           kOffscreenTimeSliceMs;
+  scheduler_->SetTimeSlice(base::TimeDelta::FromMilliseconds(time_slice_ms));
+}
+
 void GpuCommandBufferStub::OnDiscardBackbuffer() {
   if (!surface_)
     return;
@@ -601,6 +645,54 @@ void GpuCommandBufferStub::OnSetClientHasMemoryAllocationChangedCallback(
   channel_->gpu_channel_manager()->gpu_memory_manager()->ScheduleManage();
 }
 
+void GpuCommandBufferStub::OnInsertSyncPoint(IPC::Message* reply_message) {
+  uint32 sync_point =
+      channel_->gpu_channel_manager()->sync_point_manager()->
+          GenerateSyncPoint();
+  sync_points_.push_back(sync_point);
+  GpuCommandBufferMsg_InsertSyncPoint::WriteReplyParams(reply_message,
+                                                        sync_point);
+  Send(reply_message);
+  // Queue the retirement behind this stub's unprocessed commands, which
+  // hold up every later message for it.
+  channel_->OnMessageReceived(
+      GpuCommandBufferMsg_RetireSyncPoint(route_id_, sync_point));
+}
+
+void GpuCommandBufferStub::OnRetireSyncPoint(uint32 sync_point) {
+  // Destroy() has already retired it if the stub failed to initialize.
+  if (sync_points_.empty())
+    return;
+  DCHECK_EQ(sync_points_.front(), sync_point);
+  sync_points_.pop_front();
+  // The waiting command buffer uses another context, so make sure the
+  // commands issued so far reach the driver before it goes ahead. The context
+  // was made current before this handler ran.
+  if (decoder_.get())
+    glFlush();
+  channel_->gpu_channel_manager()->sync_point_manager()->RetireSyncPoint(
+      sync_point);
+}
+
+void GpuCommandBufferStub::OnWaitSyncPoint(uint32 sync_point) {
+  SyncPointManager* sync_point_manager =
+      channel_->gpu_channel_manager()->sync_point_manager();
+  if (sync_point_manager->IsSyncPointRetired(sync_point))
+    return;
+  TRACE_EVENT_ASYNC_BEGIN1("gpu", "WaitSyncPoint", this,
+                           "sync_point", sync_point);
+  scheduler_->SetScheduled(false);
+  sync_point_manager->AddSyncPointCallback(
+      sync_point,
+      base::Bind(&GpuCommandBufferStub::OnSyncPointRetired, AsWeakPtr()));
+}
+
+void GpuCommandBufferStub::OnSyncPointRetired() {
+  TRACE_EVENT_ASYNC_END0("gpu", "WaitSyncPoint", this);
+  if (scheduler_.get())
+    scheduler_->SetScheduled(true);
+}
+
 void GpuCommandBufferStub::SendConsoleMessage(
     int32 id,
     const std::string& message) {
@@ -629,6 +721,12 @@ bool GpuCommandBufferStub::IsInSameContextShareGroup(
       static_cast<const GpuCommandBufferStub&>(other).context_group_;
 }
 
+size_t GpuCommandBufferStub::GetMemoryUsage() const {
+  gpu::gles2::TextureManager* texture_manager =
+      context_group_->texture_manager();
+  return texture_manager ? texture_manager->mem_represented() : 0;
+}
+
 bool GpuCommandBufferStub::
     client_has_memory_allocation_changed_callback() const {
   return client_has_memory_allocation_changed_callback_;
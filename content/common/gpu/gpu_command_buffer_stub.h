@@ -8,6 +8,7 @@
 
 #if defined(ENABLE_GPU)
 
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -70,6 +71,11 @@ class CONTENT_EXPORT GpuCommandBufferStubBase {
   virtual bool IsInSameContextShareGroup(
       const GpuCommandBufferStubBase& other) const = 0;
 
+  // Returns the estimated number of bytes of texture memory held by this
+  // stub's context share group. Stubs in the same share group report the
+  // same value.
+  virtual size_t GetMemoryUsage() const = 0;
+
   virtual void SendMemoryAllocationToProxy(
       const GpuMemoryAllocation& allocation) = 0;
 
@@ -124,6 +130,8 @@ class GpuCommandBufferStub
   virtual bool IsInSameContextShareGroup(
       const GpuCommandBufferStubBase& other) const OVERRIDE;
 
+  virtual size_t GetMemoryUsage() const OVERRIDE;
+
   // Sends memory allocation limits to render process.
   virtual void SendMemoryAllocationToProxy(
       const GpuMemoryAllocation& allocation) OVERRIDE;
@@ -144,6 +152,11 @@ class GpuCommandBufferStub
   // Whether there are commands in the buffer that haven't been processed.
   bool HasUnprocessedCommands();
 
+  // Whether this command buffer draws to a visible surface. Such command
+  // buffers run until they are out of commands; all others are preempted
+  // periodically so that they cannot starve the channel.
+  bool IsHighPriority() const;
+
   // Delay an echo message until the command buffer has been rescheduled.
   void DelayEcho(IPC::Message*);
 
@@ -204,11 +217,22 @@ class GpuCommandBufferStub
 
   void OnSetSurfaceVisible(bool visible);
 
+  // Gives the scheduler a time slice that matches the current priority.
+  void UpdateTimeSlice();
+
   void OnDiscardBackbuffer();
   void OnEnsureBackbuffer();
 
   void OnSetClientHasMemoryAllocationChangedCallback(bool);
 
+  void OnInsertSyncPoint(IPC::Message* reply_message);
+  void OnRetireSyncPoint(uint32 sync_point);
+
+  // Called by the decoder for glWaitSyncPointCHROMIUM. Deschedules the stub
+  // until |sync_point| is retired.
+  void OnWaitSyncPoint(uint32 sync_point);
+  void OnSyncPointRetired();
+
   void OnReschedule();
 
   void OnCommandProcessed();
@@ -252,6 +276,9 @@ class GpuCommandBufferStub
 
   std::deque<IPC::Message*> delayed_echos_;
 
+  // Sync points inserted but not yet retired, oldest first.
+  std::deque<uint32> sync_points_;
+
   // Zero or more video decoders owned by this stub, keyed by their
   // decoder_route_id.
   IDMap<GpuVideoDecodeAccelerator, IDMapOwnPointer> video_decoders_;
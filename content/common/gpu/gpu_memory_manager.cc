@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include "base/bind.h"
+#include "base/debug/trace_event.h"
 #include "base/message_loop.h"
 #include "content/common/gpu/gpu_command_buffer_stub.h"
 #include "content/common/gpu/gpu_memory_allocation.h"
@@ -34,6 +35,21 @@ void AssignMemoryAllocations(std::vector<GpuCommandBufferStubBase*>& stubs,
   }
 }
 
+// Sums the memory usage of |stubs|, counting each context share group once.
+size_t ComputeTotalMemoryUsage(
+    const std::vector<GpuCommandBufferStubBase*>& stubs) {
+  size_t total = 0;
+  std::vector<GpuCommandBufferStubBase*> counted;
+  for (std::vector<GpuCommandBufferStubBase*>::const_iterator it =
+      stubs.begin(); it != stubs.end(); ++it) {
+    if (IsInSameContextShareGroupAsAnyOf(*it, counted))
+      continue;
+    counted.push_back(*it);
+    total += (*it)->GetMemoryUsage();
+  }
+  return total;
+}
+
 }
 
 GpuMemoryManager::GpuMemoryManager(GpuMemoryManagerClient* client,
@@ -42,6 +58,7 @@ GpuMemoryManager::GpuMemoryManager(GpuMemoryManagerClient* client,
       manage_scheduled_(false),
       max_surfaces_with_frontbuffer_soft_limit_(
           max_surfaces_with_frontbuffer_soft_limit),
+      bytes_allocated_current_(0),
       weak_factory_(ALLOW_THIS_IN_INITIALIZER_LIST(this)) {
 }
 
@@ -98,6 +115,13 @@ void GpuMemoryManager::ScheduleManage() {
 // As such, the rule for categorizing contexts without a surface is:
 //  1. Find the most visible context-with-a-surface within each
 //     context-without-a-surface's share group, and inherit its visibilty.
+//
+// The byte budget left over after every foreground context has its minimum
+// allocation is handed out as a bonus to the foreground contexts with a
+// surface. It is split in proportion to how far each one's share group is
+// currently using texture memory beyond the minimum, so a heavy WebGL page
+// is not capped at the same limit as a mostly-static one; anything not needed
+// that way is split equally.
 void GpuMemoryManager::Manage() {
   manage_scheduled_ = false;
 
@@ -108,6 +132,12 @@ void GpuMemoryManager::Manage() {
     std::vector<GpuCommandBufferStubBase*> stubs;
     client_->AppendAllCommandBufferStubs(stubs);
 
+    // The client hands us the stubs of every channel, so this accounts for
+    // the texture memory of all renderer and browser processes together.
+    bytes_allocated_current_ = ComputeTotalMemoryUsage(stubs);
+    TRACE_COUNTER1("GpuMemoryManager", "GpuMemoryUsage",
+                   bytes_allocated_current_);
+
     for (std::vector<GpuCommandBufferStubBase*>::iterator it = stubs.begin();
         it != stubs.end(); ++it) {
       GpuCommandBufferStubBase* stub = *it;
@@ -168,17 +198,41 @@ void GpuMemoryManager::Manage() {
                               stubs_without_surface_foreground.size() +
                               stubs_without_surface_background.size();
   size_t base_allocation_size = kMinimumAllocationForTab * num_stubs_need_mem;
-  size_t bonus_allocation = 0;
-  if (base_allocation_size < kMaximumAllocationForTabs &&
-      !stubs_with_surface_foreground.empty())
-    bonus_allocation = (kMaximumAllocationForTabs - base_allocation_size) /
-                           stubs_with_surface_foreground.size();
+  size_t bonus_pool = 0;
+  if (base_allocation_size < kMaximumAllocationForTabs)
+    bonus_pool = kMaximumAllocationForTabs - base_allocation_size;
+
+  // Work out how much of the bonus pool each foreground stub wants, based on
+  // its share group's actual usage beyond the minimum allocation.
+  std::vector<size_t> bonus_needs(stubs_with_surface_foreground.size());
+  uint64 total_bonus_need = 0;
+  for (size_t i = 0; i < stubs_with_surface_foreground.size(); ++i) {
+    size_t usage = stubs_with_surface_foreground[i]->GetMemoryUsage();
+    if (usage > static_cast<size_t>(kMinimumAllocationForTab))
+      bonus_needs[i] = usage - kMinimumAllocationForTab;
+    total_bonus_need += bonus_needs[i];
+  }
+  size_t bonus_remainder = 0;
+  if (total_bonus_need <= bonus_pool &&
+      !stubs_with_surface_foreground.empty()) {
+    bonus_remainder = static_cast<size_t>(bonus_pool - total_bonus_need) /
+                          stubs_with_surface_foreground.size();
+  }
 
   // Now give out allocations to everyone.
-  AssignMemoryAllocations(stubs_with_surface_foreground,
-      GpuMemoryAllocation(kMinimumAllocationForTab + bonus_allocation,
-          GpuMemoryAllocation::kHasFrontbuffer |
-          GpuMemoryAllocation::kHasBackbuffer));
+  for (size_t i = 0; i < stubs_with_surface_foreground.size(); ++i) {
+    size_t bonus_allocation;
+    if (total_bonus_need <= bonus_pool) {
+      bonus_allocation = bonus_needs[i] + bonus_remainder;
+    } else {
+      bonus_allocation = static_cast<size_t>(
+          bonus_pool * static_cast<uint64>(bonus_needs[i]) / total_bonus_need);
+    }
+    stubs_with_surface_foreground[i]->SetMemoryAllocation(
+        GpuMemoryAllocation(kMinimumAllocationForTab + bonus_allocation,
+            GpuMemoryAllocation::kHasFrontbuffer |
+            GpuMemoryAllocation::kHasBackbuffer));
+  }
 
   AssignMemoryAllocations(stubs_with_surface_background,
       GpuMemoryAllocation(0, GpuMemoryAllocation::kHasFrontbuffer));
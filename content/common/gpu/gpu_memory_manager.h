@@ -51,6 +51,10 @@ class CONTENT_EXPORT GpuMemoryManager {
 
   void ScheduleManage();
 
+  // Estimated texture memory, in bytes, held by all context share groups
+  // across every GPU channel as of the last Manage().
+  size_t bytes_allocated_current() const { return bytes_allocated_current_; }
+
  private:
   friend class GpuMemoryManagerTest;
   void Manage();
@@ -64,6 +68,7 @@ class CONTENT_EXPORT GpuMemoryManager {
   GpuMemoryManagerClient* client_;
   bool manage_scheduled_;
   size_t max_surfaces_with_frontbuffer_soft_limit_;
+  size_t bytes_allocated_current_;
   base::WeakPtrFactory<GpuMemoryManager> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(GpuMemoryManager);
@@ -12,15 +12,18 @@ class FakeCommandBufferStub : public GpuCommandBufferStubBase {
  public:
   SurfaceState surface_state_;
   GpuMemoryAllocation allocation_;
+  size_t memory_usage_;
 
   FakeCommandBufferStub()
-      : surface_state_(0, false, base::TimeTicks()) {
+      : surface_state_(0, false, base::TimeTicks()),
+        memory_usage_(0) {
   }
 
   FakeCommandBufferStub(int32 surface_id,
                         bool visible,
                         base::TimeTicks last_used_time)
-      : surface_state_(surface_id, visible, last_used_time) {
+      : surface_state_(surface_id, visible, last_used_time),
+        memory_usage_(0) {
   }
 
   virtual bool client_has_memory_allocation_changed_callback() const {
@@ -37,6 +40,9 @@ class FakeCommandBufferStub : public GpuCommandBufferStubBase {
       const GpuCommandBufferStubBase& stub) const {
     return false;
   }
+  virtual size_t GetMemoryUsage() const {
+    return memory_usage_;
+  }
   virtual void SendMemoryAllocationToProxy(const GpuMemoryAllocation& alloc) {
   }
   virtual void SetMemoryAllocation(const GpuMemoryAllocation& alloc) {
@@ -48,8 +54,10 @@ class FakeCommandBufferStubWithoutSurface : public GpuCommandBufferStubBase {
  public:
   GpuMemoryAllocation allocation_;
   std::vector<GpuCommandBufferStubBase*> share_group_;
+  size_t memory_usage_;
 
-  FakeCommandBufferStubWithoutSurface() {
+  FakeCommandBufferStubWithoutSurface()
+      : memory_usage_(0) {
   }
 
   virtual bool client_has_memory_allocation_changed_callback() const {
@@ -70,6 +78,9 @@ class FakeCommandBufferStubWithoutSurface : public GpuCommandBufferStubBase {
                      share_group_.end(),
                      &stub) != share_group_.end();
   }
+  virtual size_t GetMemoryUsage() const {
+    return memory_usage_;
+  }
   virtual void SendMemoryAllocationToProxy(const GpuMemoryAllocation& alloc) {
   }
   virtual void SetMemoryAllocation(const GpuMemoryAllocation& alloc) {
@@ -523,6 +534,56 @@ TEST_F(GpuMemoryManagerTest, TestForegroundStubsGetBonusAllocation) {
             GpuMemoryManager::kMinimumAllocationForTab);
 }
 
+// Test that the bonus allocation follows actual texture usage: a foreground
+// stub using more than kMinimumAllocationForTab gets the memory it uses on top
+// of its equal share of what is left, and when usage exceeds the budget the
+// bonus is split in proportion to usage.
+TEST_F(GpuMemoryManagerTest, TestForegroundBonusFollowsMemoryUsage) {
+  const size_t kMinimum = GpuMemoryManager::kMinimumAllocationForTab;
+  const size_t kMaximum = GpuMemoryManager::kMaximumAllocationForTabs;
+  FakeCommandBufferStub stub1(GenerateUniqueSurfaceId(), true, older_),
+                        stub2(GenerateUniqueSurfaceId(), true, older_);
+  client_.stubs_.push_back(&stub1);
+  client_.stubs_.push_back(&stub2);
+
+  const size_t kExtraUsage = 16 * 1024 * 1024;
+  stub1.memory_usage_ = kMinimum + kExtraUsage;
+  Manage();
+  EXPECT_TRUE(IsAllocationForegroundForSurfaceYes(stub1.allocation_));
+  EXPECT_TRUE(IsAllocationForegroundForSurfaceYes(stub2.allocation_));
+  EXPECT_EQ(stub1.allocation_.gpu_resource_size_in_bytes,
+            stub2.allocation_.gpu_resource_size_in_bytes + kExtraUsage);
+  EXPECT_EQ(kMinimum + kExtraUsage, memory_manager_.bytes_allocated_current());
+
+  // Both stubs want more than the whole budget; stub1 wants three times as
+  // much bonus as stub2.
+  const size_t kBonusPool = kMaximum - 2 * kMinimum;
+  stub1.memory_usage_ = kMinimum + 3 * kBonusPool;
+  stub2.memory_usage_ = kMinimum + kBonusPool;
+  Manage();
+  size_t bonus1 = stub1.allocation_.gpu_resource_size_in_bytes - kMinimum;
+  size_t bonus2 = stub2.allocation_.gpu_resource_size_in_bytes - kMinimum;
+  EXPECT_LE(bonus1 + bonus2, kBonusPool);
+  EXPECT_NEAR(static_cast<double>(bonus1), 3.0 * bonus2, 3.0);
+}
+
+// Test that memory usage is accounted once per context share group.
+TEST_F(GpuMemoryManagerTest, TestMemoryUsageCountsShareGroupsOnce) {
+  FakeCommandBufferStub stub1(GenerateUniqueSurfaceId(), true, older_);
+  client_.stubs_.push_back(&stub1);
+  FakeCommandBufferStubWithoutSurface stub2;
+  client_.stubs_.push_back(&stub2);
+  stub1.memory_usage_ = 1000;
+  stub2.memory_usage_ = 1000;
+
+  Manage();
+  EXPECT_EQ(2000u, memory_manager_.bytes_allocated_current());
+
+  stub2.share_group_.push_back(&stub1);
+  Manage();
+  EXPECT_EQ(1000u, memory_manager_.bytes_allocated_current());
+}
+
 // Test GpuMemoryAllocation comparison operators: Iterate over all possible
 // combinations of gpu_resource_size_in_bytes, suggest_have_backbuffer, and
 // suggest_have_frontbuffer, and make sure allocations with equal values test
@@ -441,6 +441,19 @@ IPC_MESSAGE_ROUTED1(GpuCommandBufferMsg_SetSurfaceVisible, bool /* visible */)
 IPC_MESSAGE_ROUTED0(GpuCommandBufferMsg_DiscardBackbuffer)
 IPC_MESSAGE_ROUTED0(GpuCommandBufferMsg_EnsureBackbuffer)
 
+// Inserts a sync point after the commands flushed so far. The reply is sent
+// right away, but the sync point is only retired once those commands have been
+// processed. Sync points are shared across channels, so a command buffer on
+// another channel can wait on it with glWaitSyncPointCHROMIUM.
+IPC_SYNC_MESSAGE_ROUTED0_1(GpuCommandBufferMsg_InsertSyncPoint,
+                           uint32 /* sync_point */)
+
+// Retires the sync point. Sent by the stub to itself, so that it is handled
+// only once the commands flushed before the sync point was inserted have been
+// processed.
+IPC_MESSAGE_ROUTED1(GpuCommandBufferMsg_RetireSyncPoint,
+                    uint32 /* sync_point */)
+
 // Sent to proxy when the gpu memory manager changes its memory allocation.
 IPC_MESSAGE_ROUTED1(GpuCommandBufferMsg_SetMemoryAllocation,
                     GpuMemoryAllocationForRenderer /* allocation */)
@@ -0,0 +1,56 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/common/gpu/sync_point_manager.h"
+
+#include "base/logging.h"
+
+SyncPointManager::SyncPointManager()
+    : next_sync_point_(1) {
+}
+
+SyncPointManager::~SyncPointManager() {
+}
+
+uint32 SyncPointManager::GenerateSyncPoint() {
+  DCHECK(CalledOnValidThread());
+  uint32 sync_point = next_sync_point_++;
+  // 0 is reserved to mean no sync point, so skip it when wrapping around.
+  if (!next_sync_point_)
+    next_sync_point_ = 1;
+  DCHECK(sync_point_map_.find(sync_point) == sync_point_map_.end());
+  sync_point_map_.insert(std::make_pair(sync_point, ClosureList()));
+  return sync_point;
+}
+
+void SyncPointManager::RetireSyncPoint(uint32 sync_point) {
+  DCHECK(CalledOnValidThread());
+  SyncPointMap::iterator it = sync_point_map_.find(sync_point);
+  DCHECK(it != sync_point_map_.end());
+  if (it == sync_point_map_.end())
+    return;
+  // The callbacks may add or retire other sync points, so take them out of
+  // the map before running them.
+  ClosureList list;
+  list.swap(it->second);
+  sync_point_map_.erase(it);
+  for (ClosureList::iterator i = list.begin(); i != list.end(); ++i)
+    i->Run();
+}
+
+void SyncPointManager::AddSyncPointCallback(uint32 sync_point,
+                                            const base::Closure& callback) {
+  DCHECK(CalledOnValidThread());
+  SyncPointMap::iterator it = sync_point_map_.find(sync_point);
+  if (it == sync_point_map_.end()) {
+    callback.Run();
+    return;
+  }
+  it->second.push_back(callback);
+}
+
+bool SyncPointManager::IsSyncPointRetired(uint32 sync_point) {
+  DCHECK(CalledOnValidThread());
+  return sync_point_map_.find(sync_point) == sync_point_map_.end();
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_COMMON_GPU_SYNC_POINT_MANAGER_H_
+#define CONTENT_COMMON_GPU_SYNC_POINT_MANAGER_H_
+#pragma once
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/hash_tables.h"
+#include "base/threading/non_thread_safe.h"
+
+// Hands out sync points and keeps track of which ones have been retired. A
+// command buffer inserts a sync point after commands another command buffer
+// depends on, for example the drawing into a texture it then passes on through
+// a mailbox. The sync point is retired once those commands have been issued
+// to the driver, and a command buffer waiting on it is descheduled until then.
+// Lives on the GPU main thread, alongside every command buffer it serves.
+class SyncPointManager : public base::NonThreadSafe {
+ public:
+  SyncPointManager();
+  ~SyncPointManager();
+
+  // Generates a new sync point, not yet retired.
+  uint32 GenerateSyncPoint();
+
+  // Retires a sync point and runs the callbacks waiting on it.
+  void RetireSyncPoint(uint32 sync_point);
+
+  // Runs |callback| when |sync_point| is retired, or right away if it already
+  // has been.
+  void AddSyncPointCallback(uint32 sync_point, const base::Closure& callback);
+
+  bool IsSyncPointRetired(uint32 sync_point);
+
+ private:
+  typedef std::vector<base::Closure> ClosureList;
+  typedef base::hash_map<uint32, ClosureList> SyncPointMap;
+
+  // Sync points not yet retired, and the callbacks waiting on each.
+  SyncPointMap sync_point_map_;
+  uint32 next_sync_point_;
+
+  DISALLOW_COPY_AND_ASSIGN(SyncPointManager);
+};
+
+#endif  // CONTENT_COMMON_GPU_SYNC_POINT_MANAGER_H_
@@ -4,6 +4,8 @@
 
 #include "content/common/indexed_db/proxy_webidbcursor_impl.h"
 
+#include <algorithm>
+
 #include "content/common/child_thread.h"
 #include "content/common/indexed_db/indexed_db_messages.h"
 #include "content/common/indexed_db/indexed_db_dispatcher.h"
@@ -151,6 +153,18 @@ void RendererWebIDBCursorImpl::SetPrefetchData(
 
   used_prefetches_ = 0;
   pending_onsuccess_callbacks_ = 0;
+
+  // The prefetch amount grows while the page keeps iterating; keep the next
+  // batch within kMaxPrefetchBytes if these values turned out to be large.
+  size_t prefetch_bytes = 0;
+  for (size_t i = 0; i < values.size(); ++i)
+    prefetch_bytes += values[i].data().length() * sizeof(char16);
+  if (prefetch_bytes > kMaxPrefetchBytes) {
+    size_t average_value_bytes = prefetch_bytes / values.size();
+    size_t scaled_amount = kMaxPrefetchBytes / average_value_bytes;
+    prefetch_amount_ = std::max(static_cast<int>(scaled_amount),
+                                static_cast<int>(kMinPrefetchAmount));
+  }
 }
 
 void RendererWebIDBCursorImpl::CachedContinue(
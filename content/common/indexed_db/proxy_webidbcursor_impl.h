@@ -72,7 +72,10 @@ class RendererWebIDBCursorImpl : public WebKit::WebIDBCursor {
 
   enum { kPrefetchContinueThreshold = 2 };
   enum { kMinPrefetchAmount = 5 };
-  enum { kMaxPrefetchAmount = 100 };
+  enum { kMaxPrefetchAmount = 1000 };
+  // Approximate upper bound on the size of the values in one prefetch; the
+  // prefetch amount is scaled back when a batch of large values exceeds it.
+  enum { kMaxPrefetchBytes = 4 * 1024 * 1024 };
 };
 
 #endif  // CONTENT_COMMON_INDEXED_DB_PROXY_WEBIDBCURSOR_IMPL_H_
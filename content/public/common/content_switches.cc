@@ -259,6 +259,10 @@ const char kEnablePointerLock[]             = "enable-pointer-lock";
 // Enable the Gamepad API
 const char kEnableGamepad[]                 = "enable-gamepad";
 
+// Attribute sampled heap allocations to the subsystem that made them. The
+// result is shown on chrome://memory-internals and in traces.
+const char kEnableHeapTagging[]             = "enable-heap-tagging";
+
 // Force logging to be enabled.  Logging is disabled by default in release
 // builds.
 const char kEnableLogging[]                 = "enable-logging";
@@ -496,6 +500,11 @@ const char kRendererCleanExit[]             = "renderer-clean-exit";
 // command line. Useful values might be "valgrind" or "xterm -e gdb --args".
 const char kRendererCmdPrefix[]             = "renderer-cmd-prefix";
 
+// On Linux only: the number of renderers the zygote keeps forked ahead of
+// time, ready to be handed out when the browser asks for a new one. 0 turns
+// the pool off.
+const char kRendererPoolSize[]              = "renderer-pool-size";
+
 // Causes the process to run as renderer instead of as browser.
 const char kRendererProcess[]               = "renderer";
 
@@ -89,6 +89,7 @@ CONTENT_EXPORT extern const char kEnableFixedLayout[];
 CONTENT_EXPORT extern const char kDisableFullScreen[];
 extern const char kEnablePointerLock[];
 extern const char kEnableGamepad[];
+CONTENT_EXPORT extern const char kEnableHeapTagging[];
 CONTENT_EXPORT extern const char kEnableLogging[];
 extern const char kEnableMediaSource[];
 extern const char kEnableMediaStream[];
@@ -155,6 +156,7 @@ CONTENT_EXPORT extern const char kRendererAssertTest[];
 extern const char kRendererCleanExit[];
 #endif
 extern const char kRendererCmdPrefix[];
+extern const char kRendererPoolSize[];
 CONTENT_EXPORT extern const char kRendererProcess[];
 extern const char kRendererProcessLimit[];
 extern const char kRendererStartupDialog[];
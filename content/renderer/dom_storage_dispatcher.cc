@@ -0,0 +1,136 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/dom_storage_dispatcher.h"
+
+#include "base/logging.h"
+#include "base/string_number_conversions.h"
+#include "content/common/dom_storage_messages.h"
+#include "content/renderer/render_thread_impl.h"
+#include "webkit/dom_storage/dom_storage_cached_area.h"
+#include "webkit/dom_storage/dom_storage_proxy.h"
+
+using dom_storage::DomStorageCachedArea;
+using dom_storage::DomStorageProxy;
+using dom_storage::ValuesMap;
+
+// Sends the cached areas' changes to the browser as async messages, and
+// runs each completion callback when the browser acknowledges it.
+class DomStorageDispatcher::ProxyImpl : public DomStorageProxy {
+ public:
+  ProxyImpl() : next_operation_id_(1) {}
+
+  virtual void LoadArea(int connection_id, ValuesMap* values) OVERRIDE {
+    RenderThreadImpl::current()->Send(
+        new DOMStorageHostMsg_LoadStorageArea(connection_id, values));
+  }
+
+  virtual void SetItem(int connection_id, const string16& key,
+                       const string16& value, const GURL& page_url,
+                       const CompletionCallback& callback) OVERRIDE {
+    RenderThreadImpl::current()->Send(new DOMStorageHostMsg_SetItemAsync(
+        connection_id, PushPendingCallback(callback), key, value, page_url));
+  }
+
+  virtual void RemoveItem(int connection_id, const string16& key,
+                          const GURL& page_url,
+                          const CompletionCallback& callback) OVERRIDE {
+    RenderThreadImpl::current()->Send(new DOMStorageHostMsg_RemoveItemAsync(
+        connection_id, PushPendingCallback(callback), key, page_url));
+  }
+
+  virtual void ClearArea(int connection_id, const GURL& page_url,
+                         const CompletionCallback& callback) OVERRIDE {
+    RenderThreadImpl::current()->Send(new DOMStorageHostMsg_ClearAsync(
+        connection_id, PushPendingCallback(callback), page_url));
+  }
+
+  void CompleteOperation(int operation_id, bool success) {
+    PendingCallbackMap::iterator found =
+        pending_callbacks_.find(operation_id);
+    if (found == pending_callbacks_.end())
+      return;
+    CompletionCallback callback = found->second;
+    pending_callbacks_.erase(found);
+    callback.Run(success);
+  }
+
+ private:
+  typedef std::map<int, CompletionCallback> PendingCallbackMap;
+
+  virtual ~ProxyImpl() {}
+
+  int PushPendingCallback(const CompletionCallback& callback) {
+    int operation_id = next_operation_id_++;
+    pending_callbacks_[operation_id] = callback;
+    return operation_id;
+  }
+
+  PendingCallbackMap pending_callbacks_;
+  int next_operation_id_;
+};
+
+DomStorageDispatcher::CachedAreaHolder::CachedAreaHolder()
+    : open_count_(0) {
+}
+
+DomStorageDispatcher::CachedAreaHolder::~CachedAreaHolder() {}
+
+DomStorageDispatcher::DomStorageDispatcher()
+    : proxy_(new ProxyImpl()) {
+}
+
+DomStorageDispatcher::~DomStorageDispatcher() {}
+
+scoped_refptr<DomStorageCachedArea> DomStorageDispatcher::OpenCachedArea(
+    int connection_id, int64 namespace_id, const GURL& origin) {
+  CachedAreaHolder& holder =
+      cached_areas_[GetCachedAreaKey(namespace_id, origin)];
+  if (!holder.area_)
+    holder.area_ = new DomStorageCachedArea(namespace_id, origin, proxy_);
+  ++holder.open_count_;
+  return holder.area_;
+}
+
+void DomStorageDispatcher::CloseCachedArea(DomStorageCachedArea* area) {
+  CachedAreaMap::iterator found = cached_areas_.find(
+      GetCachedAreaKey(area->namespace_id(), area->origin()));
+  DCHECK(found != cached_areas_.end());
+  DCHECK_EQ(area, found->second.area_.get());
+  if (--found->second.open_count_ == 0)
+    cached_areas_.erase(found);
+}
+
+void DomStorageDispatcher::OnStorageEvent(
+    const DOMStorageMsg_Event_Params& params) {
+  // Changes made in this process were applied to the shared cache when
+  // they were made.
+  if (params.connection_id)
+    return;
+  CachedAreaMap::iterator found = cached_areas_.find(
+      GetCachedAreaKey(params.namespace_id, params.origin));
+  if (found != cached_areas_.end())
+    found->second.area_->ApplyMutation(params.key, params.new_value);
+}
+
+bool DomStorageDispatcher::OnMessageReceived(const IPC::Message& msg) {
+  bool handled = true;
+  IPC_BEGIN_MESSAGE_MAP(DomStorageDispatcher, msg)
+    IPC_MESSAGE_HANDLER(DOMStorageMsg_AsyncOperationComplete,
+                        OnAsyncOperationComplete)
+    IPC_MESSAGE_UNHANDLED(handled = false)
+  IPC_END_MESSAGE_MAP()
+  return handled;
+}
+
+// static
+std::string DomStorageDispatcher::GetCachedAreaKey(
+    int64 namespace_id, const GURL& origin) {
+  return base::Int64ToString(namespace_id) + origin.spec();
+}
+
+void DomStorageDispatcher::OnAsyncOperationComplete(
+    int operation_id, bool success) {
+  proxy_->CompleteOperation(operation_id, success);
+}
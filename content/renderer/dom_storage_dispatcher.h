@@ -0,0 +1,64 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_RENDERER_DOM_STORAGE_DISPATCHER_H_
+#define CONTENT_RENDERER_DOM_STORAGE_DISPATCHER_H_
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "ipc/ipc_channel.h"
+
+class GURL;
+struct DOMStorageMsg_Event_Params;
+
+namespace dom_storage {
+class DomStorageCachedArea;
+}
+
+// Owns the renderer-side caches of the storage areas opened in this process,
+// so that reads are answered locally and only changes go to the browser.
+// Areas opened for the same origin and namespace share one cache. There is
+// one instance per renderer process, used on the main render thread.
+class DomStorageDispatcher {
+ public:
+  DomStorageDispatcher();
+  ~DomStorageDispatcher();
+
+  // Returns the cache for the area, creating it if this is the first
+  // connection to it. Each call must be balanced by CloseCachedArea().
+  scoped_refptr<dom_storage::DomStorageCachedArea> OpenCachedArea(
+      int connection_id, int64 namespace_id, const GURL& origin);
+  void CloseCachedArea(dom_storage::DomStorageCachedArea* area);
+
+  // Keeps the caches coherent with changes made by other processes.
+  void OnStorageEvent(const DOMStorageMsg_Event_Params& params);
+
+  bool OnMessageReceived(const IPC::Message& msg);
+
+ private:
+  class ProxyImpl;
+
+  struct CachedAreaHolder {
+    scoped_refptr<dom_storage::DomStorageCachedArea> area_;
+    int open_count_;
+    CachedAreaHolder();
+    ~CachedAreaHolder();
+  };
+  typedef std::map<std::string, CachedAreaHolder> CachedAreaMap;
+
+  static std::string GetCachedAreaKey(int64 namespace_id, const GURL& origin);
+
+  void OnAsyncOperationComplete(int operation_id, bool success);
+
+  scoped_refptr<ProxyImpl> proxy_;
+  CachedAreaMap cached_areas_;
+
+  DISALLOW_COPY_AND_ASSIGN(DomStorageDispatcher);
+};
+
+#endif  // CONTENT_RENDERER_DOM_STORAGE_DISPATCHER_H_
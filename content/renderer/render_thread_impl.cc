@@ -47,6 +47,7 @@
 #include "content/public/renderer/render_process_observer.h"
 #include "content/public/renderer/render_view_visitor.h"
 #include "content/renderer/devtools_agent_filter.h"
+#include "content/renderer/dom_storage_dispatcher.h"
 #include "content/renderer/gpu/compositor_thread.h"
 #include "content/renderer/media/audio_input_message_filter.h"
 #include "content/renderer/media/audio_message_filter.h"
@@ -210,6 +211,7 @@ void RenderThreadImpl::Init() {
   compositor_initialized_ = false;
 
   appcache_dispatcher_.reset(new AppCacheDispatcher(Get()));
+  dom_storage_dispatcher_.reset(new DomStorageDispatcher());
   main_thread_indexed_db_dispatcher_.reset(new IndexedDBDispatcher());
 
   media_stream_center_ = NULL;
@@ -808,6 +810,7 @@ void RenderThreadImpl::OnSetZoomLevelForCurrentURL(const std::string& host,
 
 void RenderThreadImpl::OnDOMStorageEvent(
     const DOMStorageMsg_Event_Params& params) {
+  dom_storage_dispatcher_->OnStorageEvent(params);
   EnsureWebKitInitialized();
 
   bool originated_in_process = params.connection_id != 0;
@@ -855,6 +858,8 @@ bool RenderThreadImpl::OnControlMessageReceived(const IPC::Message& msg) {
   // Some messages are handled by delegates.
   if (appcache_dispatcher_->OnMessageReceived(msg))
     return true;
+  if (dom_storage_dispatcher_->OnMessageReceived(msg))
+    return true;
 
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP(RenderThreadImpl, msg)
@@ -101,10 +101,8 @@ RenderWidget::RenderWidget(WebKit::WebPopupType popup_type,
       opener_id_(MSG_ROUTING_NONE),
       host_window_(0),
       host_window_set_(false),
-      current_paint_buf_(NULL),
       next_paint_flags_(0),
       filtered_time_per_frame_(0.0f),
-      update_reply_pending_(false),
       using_asynchronous_swapbuffers_(false),
       num_swapbuffers_complete_pending_(0),
       did_show_(false),
@@ -136,9 +134,10 @@ RenderWidget::RenderWidget(WebKit::WebPopupType popup_type,
 RenderWidget::~RenderWidget() {
   DCHECK(!webwidget_) << "Leaking our WebWidget!";
   STLDeleteElements(&updates_pending_swap_);
-  if (current_paint_buf_) {
-    RenderProcess::current()->ReleaseTransportDIB(current_paint_buf_);
-    current_paint_buf_ = NULL;
+  for (std::deque<TransportDIB*>::iterator i = paint_bufs_pending_ack_.begin();
+       i != paint_bufs_pending_ack_.end(); ++i) {
+    if (*i)
+      RenderProcess::current()->ReleaseTransportDIB(*i);
   }
   // If we are swapped out, we have released already.
   if (!is_swapped_out_)
@@ -433,15 +432,16 @@ void RenderWidget::OnRequestMoveAck() {
 
 void RenderWidget::OnUpdateRectAck() {
   TRACE_EVENT0("renderer", "RenderWidget::OnUpdateRectAck");
-  DCHECK(update_reply_pending_);
-  update_reply_pending_ = false;
-
-  // If we sent an UpdateRect message with a zero-sized bitmap, then we should
-  // have no current paint buffer.
-  if (current_paint_buf_) {
-    RenderProcess::current()->ReleaseTransportDIB(current_paint_buf_);
-    current_paint_buf_ = NULL;
-  }
+  DCHECK(!paint_bufs_pending_ack_.empty());
+  if (paint_bufs_pending_ack_.empty())
+    return;
+
+  // If we sent an UpdateRect message with a zero-sized bitmap, then there is
+  // no paint buffer to release.
+  TransportDIB* paint_buf = paint_bufs_pending_ack_.front();
+  paint_bufs_pending_ack_.pop_front();
+  if (paint_buf)
+    RenderProcess::current()->ReleaseTransportDIB(paint_buf);
 
   // If swapbuffers is still pending, then defer the update until the
   // swapbuffers occurs.
@@ -517,7 +517,7 @@ void RenderWidget::OnSwapBuffersComplete() {
 
   // If update reply is still pending, then defer the update until that reply
   // occurs.
-  if (update_reply_pending_) {
+  if (!paint_bufs_pending_ack_.empty()) {
     TRACE_EVENT0("renderer", "EarlyOut_UpdateReplyPending");
     return;
   }
@@ -835,7 +835,7 @@ void RenderWidget::DoDeferredUpdate() {
     TRACE_EVENT0("renderer", "EarlyOut_NoHostWindow");
     return;
   }
-  if (update_reply_pending_) {
+  if (paint_bufs_pending_ack_.size() >= kMaxUpdateRepliesPending) {
     TRACE_EVENT0("renderer", "EarlyOut_UpdateReplyPending");
     return;
   }
@@ -924,8 +924,11 @@ void RenderWidget::DoDeferredUpdate() {
   //
   // This optimization only works when the entire invalid region is contained
   // within the plugin. There is a related optimization in PaintRect for the
-  // case where there may be multiple invalid regions.
+  // case where there may be multiple invalid regions. It also needs the
+  // browser to be done with the plugin's bitmap, since the plugin may start
+  // drawing into it again once the last update is flushed.
   TransportDIB* dib = NULL;
+  TransportDIB* paint_buf = NULL;
   gfx::Rect optimized_copy_rect, optimized_copy_location;
   DCHECK(!pending_update_params_.get());
   pending_update_params_.reset(new ViewHostMsg_UpdateRect_Params);
@@ -941,6 +944,7 @@ void RenderWidget::DoDeferredUpdate() {
 
   if (update.scroll_rect.IsEmpty() &&
       !is_accelerated_compositing_active_ &&
+      paint_bufs_pending_ack_.empty() &&
       GetBitmapForOptimizedPluginPaint(bounds, &dib, &optimized_copy_location,
                                        &optimized_copy_rect)) {
     // Only update the part of the plugin that actually changed.
@@ -951,10 +955,11 @@ void RenderWidget::DoDeferredUpdate() {
   } else if (!is_accelerated_compositing_active_) {
     // Compute a buffer for painting and cache it.
     scoped_ptr<skia::PlatformCanvas> canvas(
-        RenderProcess::current()->GetDrawingCanvas(&current_paint_buf_,
-                                                   bounds));
+        RenderProcess::current()->GetDrawingCanvas(&paint_buf, bounds));
     if (!canvas.get()) {
       NOTREACHED();
+      if (paint_buf)
+        RenderProcess::current()->ReleaseTransportDIB(paint_buf);
       return;
     }
 
@@ -967,7 +972,7 @@ void RenderWidget::DoDeferredUpdate() {
 
     HISTOGRAM_COUNTS_100("MPArch.RW_PaintRectCount", update.paint_rects.size());
 
-    pending_update_params_->bitmap = current_paint_buf_->id();
+    pending_update_params_->bitmap = paint_buf->id();
     pending_update_params_->bitmap_rect = bounds;
 
     std::vector<gfx::Rect>& copy_rects = pending_update_params_->copy_rects;
@@ -1009,10 +1014,14 @@ void RenderWidget::DoDeferredUpdate() {
   // the message now.
   if (pending_update_params_.get()) {
     // sending an ack to browser process that the paint is complete...
-    update_reply_pending_ = pending_update_params_->needs_ack;
+    if (pending_update_params_->needs_ack) {
+      paint_bufs_pending_ack_.push_back(paint_buf);
+      paint_buf = NULL;
+    }
     Send(new ViewHostMsg_UpdateRect(routing_id_, *pending_update_params_));
     pending_update_params_.reset();
   }
+  DCHECK(!paint_buf);
 
   // If we're software rendering then we're done initiating the paint.
   if (!is_accelerated_compositing_active_)
@@ -1036,7 +1045,7 @@ void RenderWidget::didInvalidateRect(const WebRect& rect) {
     return;
   if (!paint_aggregator_.HasPendingUpdate())
     return;
-  if (update_reply_pending_ ||
+  if (paint_bufs_pending_ack_.size() >= kMaxUpdateRepliesPending ||
       num_swapbuffers_complete_pending_ >= kMaxSwapBuffersPending)
     return;
 
@@ -1076,7 +1085,7 @@ void RenderWidget::didScrollRect(int dx, int dy, const WebRect& clip_rect) {
     return;
   if (!paint_aggregator_.HasPendingUpdate())
     return;
-  if (update_reply_pending_ ||
+  if (paint_bufs_pending_ack_.size() >= kMaxUpdateRepliesPending ||
       num_swapbuffers_complete_pending_ >= kMaxSwapBuffersPending)
     return;
 
@@ -1167,7 +1176,7 @@ void RenderWidget::didCommitAndDrawCompositorFrame() {
 void RenderWidget::didCompleteSwapBuffers() {
   DidFlushPaint();
 
-  if (update_reply_pending_)
+  if (!paint_bufs_pending_ack_.empty())
     return;
 
   if (!next_paint_flags_ && !plugin_window_moves_.size())
@@ -393,8 +393,10 @@ class CONTENT_EXPORT RenderWidget
   // The size of the RenderWidget.
   gfx::Size size_;
 
-  // The TransportDIB that is being used to transfer an image to the browser.
-  TransportDIB* current_paint_buf_;
+  // The TransportDIBs of the UpdateRect messages that are waiting for their
+  // ACK, oldest first. The browser ACKs them in the order they were sent. An
+  // entry is NULL if its message didn't carry a buffer of ours.
+  std::deque<TransportDIB*> paint_bufs_pending_ack_;
 
   PaintAggregator paint_aggregator_;
 
@@ -407,9 +409,6 @@ class CONTENT_EXPORT RenderWidget
   // Filtered time per frame based on UpdateRect messages.
   float filtered_time_per_frame_;
 
-  // True if we are expecting an UpdateRect_ACK message (i.e., that a
-  // UpdateRect message has been sent).
-  bool update_reply_pending_;
 
   // True if the underlying graphics context supports asynchronous swap.
   // Cached on the RenderWidget because determining support is costly.
@@ -426,6 +425,10 @@ class CONTENT_EXPORT RenderWidget
   // OnSwapBuffersComplete callback.
   static const int kMaxSwapBuffersPending = 2;
 
+  // The most software UpdateRect messages that may be waiting for their ACK.
+  // Two lets us paint the next frame while the browser copies the last one.
+  static const size_t kMaxUpdateRepliesPending = 2;
+
   // Set to true if we should ignore RenderWidget::Show calls.
   bool did_show_;
 
@@ -9,9 +9,10 @@
 #include "base/time.h"
 #include "base/utf_string_conversions.h"
 #include "content/common/dom_storage_messages.h"
+#include "content/renderer/dom_storage_dispatcher.h"
 #include "content/renderer/render_thread_impl.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/platform/WebURL.h"
-#include "webkit/dom_storage/dom_storage_types.h"
+#include "webkit/dom_storage/dom_storage_cached_area.h"
 
 using WebKit::WebString;
 using WebKit::WebURL;
@@ -37,10 +38,14 @@ RendererWebStorageAreaImpl::RendererWebStorageAreaImpl(
   RenderThreadImpl::current()->Send(
       new DOMStorageHostMsg_OpenStorageArea(
           connection_id_, namespace_id, GURL(origin)));
+  cached_area_ = RenderThreadImpl::current()->dom_storage_dispatcher()->
+      OpenCachedArea(connection_id_, namespace_id, GURL(origin));
 }
 
 RendererWebStorageAreaImpl::~RendererWebStorageAreaImpl() {
   g_all_areas_map.Pointer()->Remove(connection_id_);
+  RenderThreadImpl::current()->dom_storage_dispatcher()->
+      CloseCachedArea(cached_area_);
   RenderThreadImpl::current()->Send(
       new DOMStorageHostMsg_CloseStorageArea(connection_id_));
 }
@@ -58,51 +63,46 @@ RendererWebStorageAreaImpl::~RendererWebStorageAreaImpl() {
 // length       .017     0.6     2.0     12.0
 // key          .591     0.6     2.0     29.9
 // clear        1e-6     1.0     32.4    605.2
+//
+// Since getItem and key dominate, they and length are answered from a
+// cache of the area's values in this process, primed with one IPC on first
+// access. Changes are applied to the cache and sent to the browser without
+// waiting for a reply.
 
 unsigned RendererWebStorageAreaImpl::length() {
-  unsigned length;
-  RenderThreadImpl::current()->Send(
-      new DOMStorageHostMsg_Length(connection_id_, &length));
-  return length;
+  return cached_area_->GetLength(connection_id_);
 }
 
 WebString RendererWebStorageAreaImpl::key(unsigned index) {
-  NullableString16 key;
-  RenderThreadImpl::current()->Send(
-      new DOMStorageHostMsg_Key(connection_id_, index, &key));
-  return key;
+  return cached_area_->GetKey(connection_id_, index);
 }
 
 WebString RendererWebStorageAreaImpl::getItem(const WebString& key) {
-  NullableString16 value;
-  RenderThreadImpl::current()->Send(
-      new DOMStorageHostMsg_GetItem(connection_id_, key, &value));
-  return value;
+  return cached_area_->GetItem(connection_id_, key);
 }
 
 void RendererWebStorageAreaImpl::setItem(
     const WebString& key, const WebString& value, const WebURL& url,
     WebStorageArea::Result& result, WebString& old_value_webkit) {
-  if (key.length() + value.length() > dom_storage::kPerAreaQuota) {
+  NullableString16 old_value;
+  if (!cached_area_->SetItem(connection_id_, key, value, url, &old_value)) {
     result = ResultBlockedByQuota;
     return;
   }
-  NullableString16 old_value;
-  RenderThreadImpl::current()->Send(new DOMStorageHostMsg_SetItem(
-      connection_id_, key, value, url, &result, &old_value));
+  result = ResultOK;
   old_value_webkit = old_value;
 }
 
 void RendererWebStorageAreaImpl::removeItem(
     const WebString& key, const WebURL& url, WebString& old_value_webkit) {
-  NullableString16 old_value;
-  RenderThreadImpl::current()->Send(
-      new DOMStorageHostMsg_RemoveItem(connection_id_, key, url, &old_value));
-  old_value_webkit = old_value;
+  string16 old_value;
+  if (cached_area_->RemoveItem(connection_id_, key, url, &old_value))
+    old_value_webkit = old_value;
+  else
+    old_value_webkit = NullableString16(true);
 }
 
 void RendererWebStorageAreaImpl::clear(
     const WebURL& url, bool& cleared_something) {
-  RenderThreadImpl::current()->Send(
-      new DOMStorageHostMsg_Clear(connection_id_, url, &cleared_something));
+  cleared_something = cached_area_->Clear(connection_id_, url);
 }
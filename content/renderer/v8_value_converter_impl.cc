@@ -6,6 +6,7 @@
 
 #include <string>
 
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/values.h"
@@ -27,6 +28,7 @@ V8ValueConverterImpl::V8ValueConverterImpl()
 
 v8::Handle<v8::Value> V8ValueConverterImpl::ToV8Value(
     const Value* value, v8::Handle<v8::Context> context) const {
+  base::debug::ScopedHeapTag heap_tag(base::debug::HEAP_TAG_V8_BINDINGS);
   v8::Context::Scope context_scope(context);
   v8::HandleScope handle_scope;
   return handle_scope.Close(ToV8ValueImpl(value));
@@ -35,6 +37,7 @@ v8::Handle<v8::Value> V8ValueConverterImpl::ToV8Value(
 Value* V8ValueConverterImpl::FromV8Value(
     v8::Handle<v8::Value> val,
     v8::Handle<v8::Context> context) const {
+  base::debug::ScopedHeapTag heap_tag(base::debug::HEAP_TAG_V8_BINDINGS);
   v8::Context::Scope context_scope(context);
   v8::HandleScope handle_scope;
   return FromV8ValueImpl(val);
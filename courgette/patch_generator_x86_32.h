@@ -69,17 +69,6 @@ class PatchGeneratorX86_32 : public TransformationPatchGenerator {
       return old_parse_status;
     }
 
-    AssemblyProgram* new_program = NULL;
-    Status new_parse_status =
-        ParseDetectedExecutable(new_element_->region().start(),
-                                new_element_->region().length(),
-                                &new_program);
-    if (new_parse_status != C_OK) {
-      DeleteAssemblyProgram(old_program);
-      LOG(ERROR) << "Cannot parse as Win32X86PE " << new_element_->Name();
-      return new_parse_status;
-    }
-
     EncodedProgram* old_encoded = NULL;
     Status old_encode_status = Encode(old_program, &old_encoded);
     if (old_encode_status != C_OK) {
@@ -95,6 +84,20 @@ class PatchGeneratorX86_32 : public TransformationPatchGenerator {
       return old_write_status;
     }
 
+    // The new program is only parsed once the old one has been written, so
+    // that the old EncodedProgram and the new AssemblyProgram are never held
+    // at the same time.
+    AssemblyProgram* new_program = NULL;
+    Status new_parse_status =
+        ParseDetectedExecutable(new_element_->region().start(),
+                                new_element_->region().length(),
+                                &new_program);
+    if (new_parse_status != C_OK) {
+      DeleteAssemblyProgram(old_program);
+      LOG(ERROR) << "Cannot parse as Win32X86PE " << new_element_->Name();
+      return new_parse_status;
+    }
+
     Status adjust_status = Adjust(*old_program, new_program);
     DeleteAssemblyProgram(old_program);
     if (adjust_status != C_OK) {
@@ -26,6 +26,8 @@
  * Changelog:
  * 2009-03-31 - Change to use Streams.  Move CRC code to crc.{h,cc}
  *                --Stephen Adams <sra@chromium.org>
+ * 2012-06-01 - Copy runs of unchanged bytes in one write.  Report errors
+ *              from MBS_ApplyPatch.
  */
 
 // Copyright (c) 2009 The Chromium Authors. All rights reserved.
@@ -34,6 +36,8 @@
 
 #include "courgette/third_party/bsdiff.h"
 
+#include <algorithm>
+
 #include "courgette/crc.h"
 #include "courgette/streams.h"
 
@@ -103,20 +107,29 @@ BSDiffStatus MBS_ApplyPatch(const MBSPatchHeader *header,
     if (copy_count > static_cast<size_t>(old_end - old_position))
       return UNEXPECTED_ERROR;
 
-    // Add together bytes from the 'old' file and the 'diff' stream.
-    for (size_t i = 0;  i < copy_count;  ++i) {
+    // Add together bytes from the 'old' file and the 'diff' stream.  Most
+    // diff bytes are zero, so the runs between non-zero ones are copied from
+    // the 'old' file as they are.
+    size_t i = 0;
+    while (i < copy_count) {
+      size_t run = std::min(static_cast<size_t>(pending_diff_zeros),
+                            copy_count - i);
+      if (run && !new_stream->Write(old_position + i, run))
+        return MEM_ERROR;
+      pending_diff_zeros -= run;
+      i += run;
+      if (i == copy_count)
+        break;
+
       uint8 diff_byte = 0;
-      if (pending_diff_zeros) {
-        --pending_diff_zeros;
-      } else {
-        if (!diff_skips->ReadVarint32(&pending_diff_zeros))
-          return UNEXPECTED_ERROR;
-        if (!diff_bytes->Read(&diff_byte, 1))
-          return UNEXPECTED_ERROR;
-      }
+      if (!diff_skips->ReadVarint32(&pending_diff_zeros))
+        return UNEXPECTED_ERROR;
+      if (!diff_bytes->Read(&diff_byte, 1))
+        return UNEXPECTED_ERROR;
       uint8 byte = old_position[i] + diff_byte;
       if (!new_stream->Write(&byte, 1))
         return MEM_ERROR;
+      ++i;
     }
     old_position += copy_count;
 
@@ -163,9 +176,8 @@ BSDiffStatus ApplyBinaryPatch(SourceStream* old_stream,
   if (CalculateCrc(old_start, old_size) != header.scrc32)
     return CRC_ERROR;
 
-  MBS_ApplyPatch(&header, patch_stream, old_start, old_size, new_stream);
-
-  return OK;
+  return MBS_ApplyPatch(&header, patch_stream, old_start, old_size,
+                        new_stream);
 }
 
 }  // namespace
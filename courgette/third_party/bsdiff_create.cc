@@ -20,6 +20,8 @@
   2010-05-26 - Use a paged array for V and I. The address space may be too
                fragmented for these big arrays to be contiguous.
                  --Stephen Adams <sra@chromium.org>
+  2012-06-01 - Bucket suffixes by their first two bytes in qsufsort, which
+               saves the first and most expensive doubling pass.
 */
 
 #include "courgette/third_party/bsdiff.h"
@@ -42,8 +44,9 @@ namespace courgette {
 //
 // The following code is taken verbatim from 'bsdiff.c'. Please keep all the
 // code formatting and variable names.  The changes from the original are (1)
-// replacing tabs with spaces, (2) indentation, (3) using 'const', and (4)
-// changing the V and I parameters from int* to PagedArray<int>&.
+// replacing tabs with spaces, (2) indentation, (3) using 'const', (4)
+// changing the V and I parameters from int* to PagedArray<int>&, and (5)
+// the initial bucket sort in qsufsort using two bytes instead of one.
 //
 // The code appears to be a rewritten version of the suffix array algorithm
 // presented in "Faster Suffix Sorting" by N. Jesper Larsson and Kunihiko
@@ -111,26 +114,37 @@ split(PagedArray<int>& I,PagedArray<int>& V,int start,int len,int h)
   if(start+len>kk) split(I,V,kk,start+len-kk,h);
 }
 
+// The bucket of the suffix at |i|, ordered by its first two bytes.  A suffix
+// one byte long sorts before the longer ones starting with the same byte, so
+// it gets a bucket of its own and never needs comparing past the end.
+static inline int
+bucket2(const unsigned char *old,int oldsize,int i)
+{
+  return old[i]*257+(i+1<oldsize ? old[i+1]+1 : 0);
+}
+
 static void
 qsufsort(PagedArray<int>& I, PagedArray<int>& V,const unsigned char *old,int oldsize)
 {
-  int buckets[256];
+  const int kBuckets=256*257;
+  scoped_array<int> buckets(new int[kBuckets]);
   int i,h,len;
 
-  for(i=0;i<256;i++) buckets[i]=0;
-  for(i=0;i<oldsize;i++) buckets[old[i]]++;
-  for(i=1;i<256;i++) buckets[i]+=buckets[i-1];
-  for(i=255;i>0;i--) buckets[i]=buckets[i-1];
+  for(i=0;i<kBuckets;i++) buckets[i]=0;
+  for(i=0;i<oldsize;i++) buckets[bucket2(old,oldsize,i)]++;
+  for(i=1;i<kBuckets;i++) buckets[i]+=buckets[i-1];
+  for(i=kBuckets-1;i>0;i--) buckets[i]=buckets[i-1];
   buckets[0]=0;
 
-  for(i=0;i<oldsize;i++) I[++buckets[old[i]]]=i;
+  for(i=0;i<oldsize;i++) I[++buckets[bucket2(old,oldsize,i)]]=i;
   I[0]=oldsize;
-  for(i=0;i<oldsize;i++) V[i]=buckets[old[i]];
+  for(i=0;i<oldsize;i++) V[i]=buckets[bucket2(old,oldsize,i)];
   V[oldsize]=0;
-  for(i=1;i<256;i++) if(buckets[i]==buckets[i-1]+1) I[buckets[i]]=-1;
+  for(i=1;i<kBuckets;i++) if(buckets[i]==buckets[i-1]+1) I[buckets[i]]=-1;
   I[0]=-1;
 
-  for(h=1;I[0]!=-(oldsize+1);h+=h) {
+  // The suffixes are already sorted by two bytes, so doubling starts at 2.
+  for(h=2;I[0]!=-(oldsize+1);h+=h) {
     len=0;
     for(i=0;i<oldsize+1;) {
       if(I[i]<0) {
@@ -102,6 +102,12 @@ void ObjectProxy::CallMethod(MethodCall* method_call,
                                          callback));
 }
 
+ObjectProxy::TaskBatch::TaskBatch() {
+}
+
+ObjectProxy::TaskBatch::~TaskBatch() {
+}
+
 void ObjectProxy::CallMethodWithErrorCallback(MethodCall* method_call,
                                               int timeout_ms,
                                               ResponseCallback callback,
@@ -125,7 +131,7 @@ void ObjectProxy::CallMethodWithErrorCallback(MethodCall* method_call,
                                   error_callback,
                                   start_time);
   // Wait for the response in the D-Bus thread.
-  bus_->PostTaskToDBusThread(FROM_HERE, task);
+  PostTaskToDBusThreadBatched(task);
 }
 
 void ObjectProxy::ConnectToSignal(const std::string& interface_name,
@@ -134,13 +140,13 @@ void ObjectProxy::ConnectToSignal(const std::string& interface_name,
                                   OnConnectedCallback on_connected_callback) {
   bus_->AssertOnOriginThread();
 
-  bus_->PostTaskToDBusThread(FROM_HERE,
-                             base::Bind(&ObjectProxy::ConnectToSignalInternal,
-                                        this,
-                                        interface_name,
-                                        signal_name,
-                                        signal_callback,
-                                        on_connected_callback));
+  PostTaskToDBusThreadBatched(
+      base::Bind(&ObjectProxy::ConnectToSignalInternal,
+                 this,
+                 interface_name,
+                 signal_name,
+                 signal_callback,
+                 on_connected_callback));
 }
 
 void ObjectProxy::Detach() {
@@ -199,7 +205,7 @@ void ObjectProxy::StartAsyncMethodCall(int timeout_ms,
                                     error_callback,
                                     start_time,
                                     response_message);
-    bus_->PostTaskToOriginThread(FROM_HERE, task);
+    PostTaskToOriginThreadBatched(task);
 
     dbus_message_unref(request_message);
     return;
@@ -241,7 +247,7 @@ void ObjectProxy::OnPendingCallIsComplete(DBusPendingCall* pending_call,
                                   error_callback,
                                   start_time,
                                   response_message);
-  bus_->PostTaskToOriginThread(FROM_HERE, task);
+  PostTaskToOriginThreadBatched(task);
 }
 
 void ObjectProxy::RunResponseCallback(ResponseCallback response_callback,
@@ -339,8 +345,7 @@ void ObjectProxy::ConnectToSignalInternal(
   }
 
   // Run on_connected_callback in the origin thread.
-  bus_->PostTaskToOriginThread(
-      FROM_HERE,
+  PostTaskToOriginThreadBatched(
       base::Bind(&ObjectProxy::OnConnected,
                  this,
                  on_connected_callback,
@@ -398,12 +403,11 @@ DBusHandlerResult ObjectProxy::HandleMessage(
     // Transfer the ownership of |signal| to RunMethod().
     // |released_signal| will be deleted in RunMethod().
     Signal* released_signal = signal.release();
-    bus_->PostTaskToOriginThread(FROM_HERE,
-                                 base::Bind(&ObjectProxy::RunMethod,
-                                            this,
-                                            start_time,
-                                            iter->second,
-                                            released_signal));
+    PostTaskToOriginThreadBatched(base::Bind(&ObjectProxy::RunMethod,
+                                             this,
+                                             start_time,
+                                             iter->second,
+                                             released_signal));
   } else {
     const base::TimeTicks start_time = base::TimeTicks::Now();
     // If the D-Bus thread is not used, just call the callback on the
@@ -435,6 +439,45 @@ DBusHandlerResult ObjectProxy::HandleMessageThunk(
   return self->HandleMessage(connection, raw_message);
 }
 
+void ObjectProxy::PostTaskToDBusThreadBatched(const base::Closure& task) {
+  if (AddTaskToBatch(&dbus_thread_batch_, task)) {
+    bus_->PostTaskToDBusThread(FROM_HERE,
+                               base::Bind(&ObjectProxy::RunTaskBatch,
+                                          this,
+                                          &dbus_thread_batch_));
+  }
+}
+
+void ObjectProxy::PostTaskToOriginThreadBatched(const base::Closure& task) {
+  if (AddTaskToBatch(&origin_thread_batch_, task)) {
+    bus_->PostTaskToOriginThread(FROM_HERE,
+                                 base::Bind(&ObjectProxy::RunTaskBatch,
+                                            this,
+                                            &origin_thread_batch_));
+  }
+}
+
+// static
+bool ObjectProxy::AddTaskToBatch(TaskBatch* batch, const base::Closure& task) {
+  base::AutoLock lock(batch->lock);
+  batch->tasks.push_back(task);
+  return batch->tasks.size() == 1;
+}
+
+void ObjectProxy::RunTaskBatch(TaskBatch* batch) {
+  std::vector<base::Closure> tasks;
+  {
+    base::AutoLock lock(batch->lock);
+    tasks.swap(batch->tasks);
+  }
+  UMA_HISTOGRAM_COUNTS_100("DBus.TaskBatchSize", tasks.size());
+
+  // Tasks run in the order they were queued, so replies and signals are
+  // seen in the order the D-Bus thread received them.
+  for (size_t i = 0; i < tasks.size(); ++i)
+    tasks[i].Run();
+}
+
 void ObjectProxy::LogMethodCallFailure(
     const base::StringPiece& error_name,
     const base::StringPiece& error_message) const {
@@ -11,10 +11,12 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/string_piece.h"
+#include "base/synchronization/lock.h"
 #include "base/time.h"
 #include "dbus/object_path.h"
 
@@ -173,6 +175,17 @@ class ObjectProxy : public base::RefCountedThreadSafe<ObjectProxy> {
     base::TimeTicks start_time;
   };
 
+  // Tasks queued by one thread to run on the other. Only the task that
+  // finds the queue empty posts a task to run the queue, so a burst of
+  // method calls, replies or signals costs a single thread hop.
+  struct TaskBatch {
+    TaskBatch();
+    ~TaskBatch();
+
+    base::Lock lock;
+    std::vector<base::Closure> tasks;
+  };
+
   // Starts the async method call. This is a helper function to implement
   // CallMethod().
   void StartAsyncMethodCall(int timeout_ms,
@@ -225,6 +238,18 @@ class ObjectProxy : public base::RefCountedThreadSafe<ObjectProxy> {
                                               DBusMessage* raw_message,
                                               void* user_data);
 
+  // Queues |task| to run in the D-Bus thread or the origin thread,
+  // together with the other tasks queued before the thread gets to them.
+  void PostTaskToDBusThreadBatched(const base::Closure& task);
+  void PostTaskToOriginThreadBatched(const base::Closure& task);
+
+  // Adds |task| to |batch|. Returns true if |batch| was empty, in which
+  // case the caller has to post RunTaskBatch().
+  static bool AddTaskToBatch(TaskBatch* batch, const base::Closure& task);
+
+  // Runs the tasks queued in |batch|.
+  void RunTaskBatch(TaskBatch* batch);
+
   // Helper method for logging response errors appropriately.
   void LogMethodCallFailure(const base::StringPiece& error_name,
                             const base::StringPiece& error_message) const;
@@ -249,6 +274,11 @@ class ObjectProxy : public base::RefCountedThreadSafe<ObjectProxy> {
 
   const bool ignore_service_unknown_errors_;
 
+  // Method calls waiting to be started in the D-Bus thread, and replies and
+  // signals waiting to be dispatched in the origin thread.
+  TaskBatch dbus_thread_batch_;
+  TaskBatch origin_thread_batch_;
+
   DISALLOW_COPY_AND_ASSIGN(ObjectProxy);
 };
 
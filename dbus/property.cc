@@ -4,9 +4,12 @@
 
 #include "dbus/property.h"
 
+#include <algorithm>
+
 #include "base/basictypes.h"
 #include "base/bind.h"
 #include "base/logging.h"
+#include "base/message_loop.h"
 
 #include "dbus/message.h"
 #include "dbus/object_path.h"
@@ -154,8 +157,30 @@ bool PropertySet::UpdatePropertyFromReader(MessageReader* reader) {
 
 
 void PropertySet::NotifyPropertyChanged(const std::string& name) {
-  if (!property_changed_callback_.is_null())
-    property_changed_callback_.Run(name);
+  if (property_changed_callback_.is_null())
+    return;
+
+  // Services tend to send bursts of change signals for the same few
+  // properties; the callback is run once per changed property for each
+  // burst rather than once per signal.
+  if (std::find(changed_properties_.begin(), changed_properties_.end(),
+                name) != changed_properties_.end())
+    return;
+
+  changed_properties_.push_back(name);
+  if (changed_properties_.size() == 1) {
+    MessageLoop::current()->PostTask(
+        FROM_HERE,
+        base::Bind(&PropertySet::RunPropertyChangedCallbacks,
+                   weak_ptr_factory_.GetWeakPtr()));
+  }
+}
+
+void PropertySet::RunPropertyChangedCallbacks() {
+  std::vector<std::string> changed_properties;
+  changed_properties.swap(changed_properties_);
+  for (size_t i = 0; i < changed_properties.size(); ++i)
+    property_changed_callback_.Run(changed_properties[i]);
 }
 
 //
@@ -8,6 +8,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/bind.h"
@@ -243,6 +244,9 @@ class PropertySet {
   // Calls the property changed callback passed to the constructor, used
   // by sub-classes that do not call UpdatePropertiesFromReader() or
   // UpdatePropertyFromReader(). Takes the |name| of the changed property.
+  // The callback is run from a task posted to the current message loop, and
+  // only once for a property that changes several times before the task
+  // runs.
   void NotifyPropertyChanged(const std::string& name);
 
   // Retrieves the object proxy this property set was initialized with,
@@ -262,6 +266,9 @@ class PropertySet {
   }
 
  private:
+  // Runs the property changed callback for each of |changed_properties_|.
+  void RunPropertyChangedCallbacks();
+
   // Pointer to object proxy for making method calls, no ownership is taken
   // so this must outlive this class.
   ObjectProxy* object_proxy_;
@@ -274,6 +281,10 @@ class PropertySet {
   // Callback for property changes.
   PropertyChangedCallback property_changed_callback_;
 
+  // Names of the properties changed since the property changed callback
+  // was last run, in the order they first changed.
+  std::vector<std::string> changed_properties_;
+
   // Map of properties (as PropertyBase*) defined in the structure to
   // names as used in D-Bus method calls and signals. The base pointer
   // restricts property access via this map to type-unsafe and non-specific
@@ -246,3 +246,20 @@ TEST_F(PropertyTest, Set) {
 
   EXPECT_EQ("NewService", properties_->name.value());
 }
+
+TEST_F(PropertyTest, CoalescedNotifications) {
+  WaitForGetAll();
+
+  // Changes made before the notifications run are reported once per
+  // property, in the order the properties first changed.
+  properties_->NotifyPropertyChanged("Name");
+  properties_->NotifyPropertyChanged("Version");
+  properties_->NotifyPropertyChanged("Name");
+  while (updated_properties_.size() < 2)
+    message_loop_.Run();
+  message_loop_.RunAllPending();
+
+  ASSERT_EQ(2U, updated_properties_.size());
+  EXPECT_EQ("Name", updated_properties_[0]);
+  EXPECT_EQ("Version", updated_properties_[1]);
+}
@@ -13,6 +13,9 @@ namespace gpu {
 namespace {
 const int kCommandsPerFlushCheck = 100;
 const double kFlushDelay = 1.0 / (5.0 * 60.0);
+// Longest a periodic flush is held back while the reader is still busy with
+// the commands it was last sent.
+const double kBusyReaderFlushDelay = 1.0 / 60.0;
 }
 
 CommandBufferHelper::CommandBufferHelper(CommandBuffer* command_buffer)
@@ -234,9 +237,16 @@ void CommandBufferHelper::WaitForAvailableEntries(int32 count) {
     // amount of work has been done. On highend machines, this reduces the
     // latency of GPU commands. However, on Android, this can cause the
     // kernel to thrash between generating GPU commands and executing them.
-    clock_t current_time = clock();
-    if (current_time - last_flush_time_ > kFlushDelay * CLOCKS_PER_SEC)
-      Flush();
+    clock_t elapsed = clock() - last_flush_time_;
+    if (elapsed > kFlushDelay * CLOCKS_PER_SEC) {
+      // The reader only sees a new put offset once it has finished the
+      // commands it was last sent, so flushing while it is still busy costs
+      // an IPC without getting the commands executed any sooner. Keep
+      // batching them until it catches up.
+      if (get_offset() == last_put_sent_ ||
+          elapsed > kBusyReaderFlushDelay * CLOCKS_PER_SEC)
+        Flush();
+    }
 #endif
   }
 }
@@ -0,0 +1,269 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how many flushes CommandBufferHelper sends per frame, and how long
+// frames take, for a compositor-like stream of draws executed on another
+// thread.
+
+#include "base/bind.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop.h"
+#include "base/perftimer.h"
+#include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/time.h"
+#include "gpu/command_buffer/client/cmd_buffer_helper.h"
+#include "gpu/command_buffer/service/command_buffer_service.h"
+#include "gpu/command_buffer/service/common_decoder.h"
+#include "gpu/command_buffer/service/gpu_scheduler.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace gpu {
+
+namespace {
+
+const int32 kRingBufferSize = 1024 * 1024;
+const int kFrames = 200;
+
+// Each frame draws this many quads, and each quad takes a few commands, as
+// binding a texture, setting uniforms and drawing would.
+const int kQuadsPerFrame = 200;
+const int kCommandsPerQuad = 4;
+const uint32 kEntriesPerCommand = 4;
+
+// Time spent producing each quad on the client, and executing each command
+// on the service.
+const int64 kClientQuadCostUs = 20;
+const int64 kServiceCommandCostUs = 5;
+
+void Spin(int64 microseconds) {
+  base::TimeTicks end = base::TimeTicks::Now() +
+      base::TimeDelta::FromMicroseconds(microseconds);
+  while (base::TimeTicks::Now() < end) {
+  }
+}
+
+void RunAndSignal(const base::Closure& task, base::WaitableEvent* event) {
+  task.Run();
+  event->Signal();
+}
+
+// Executes the common commands, charging a fixed cost for each Noop, which
+// stand in for the draw commands.
+class FakeDecoder : public CommonDecoder {
+ public:
+  FakeDecoder() {}
+
+  virtual error::Error DoCommand(unsigned int command,
+                                 unsigned int arg_count,
+                                 const void* cmd_data) OVERRIDE {
+    if (command == cmd::kNoop)
+      Spin(kServiceCommandCostUs);
+    return DoCommonCommand(command, arg_count, cmd_data);
+  }
+
+  virtual const char* GetCommandName(unsigned int command_id) const OVERRIDE {
+    return GetCommonCommandName(static_cast<cmd::CommandId>(command_id));
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(FakeDecoder);
+};
+
+// Forwards the helper's calls to a CommandBufferService running on another
+// thread. Flush() posts a task without waiting, as the AsyncFlush IPC does,
+// and is counted.
+class ThreadedCommandBuffer : public CommandBuffer {
+ public:
+  ThreadedCommandBuffer(CommandBufferService* service, base::Thread* thread)
+      : service_(service),
+        thread_(thread),
+        last_put_offset_(-1),
+        flush_count_(0),
+        sync_count_(0) {
+  }
+
+  int flush_count() const { return flush_count_; }
+  int sync_count() const { return sync_count_; }
+
+  virtual bool Initialize() OVERRIDE {
+    NOTREACHED();
+    return false;
+  }
+
+  virtual State GetState() OVERRIDE {
+    ++sync_count_;
+    RunOnServiceThread(base::Bind(&ThreadedCommandBuffer::UpdateLastState,
+                                  base::Unretained(this)));
+    return GetLastState();
+  }
+
+  virtual State GetLastState() OVERRIDE {
+    base::AutoLock lock(lock_);
+    return last_state_;
+  }
+
+  virtual void Flush(int32 put_offset) OVERRIDE {
+    if (put_offset == last_put_offset_)
+      return;
+    last_put_offset_ = put_offset;
+    ++flush_count_;
+    thread_->message_loop()->PostTask(
+        FROM_HERE,
+        base::Bind(&ThreadedCommandBuffer::FlushOnServiceThread,
+                   base::Unretained(this), put_offset));
+  }
+
+  virtual State FlushSync(int32 put_offset, int32 last_known_get) OVERRIDE {
+    Flush(put_offset);
+    return GetState();
+  }
+
+  virtual void SetGetBuffer(int32 transfer_buffer_id) OVERRIDE {
+    RunOnServiceThread(base::Bind(&CommandBufferService::SetGetBuffer,
+                                  base::Unretained(service_),
+                                  transfer_buffer_id));
+  }
+
+  virtual void SetGetOffset(int32 get_offset) OVERRIDE {
+    NOTREACHED();
+  }
+
+  // The transfer buffer calls are only made while the helper is being
+  // initialized, before the service thread has any work.
+  virtual int32 CreateTransferBuffer(size_t size, int32 id_request) OVERRIDE {
+    return service_->CreateTransferBuffer(size, id_request);
+  }
+
+  virtual int32 RegisterTransferBuffer(base::SharedMemory* shared_memory,
+                                       size_t size,
+                                       int32 id_request) OVERRIDE {
+    return service_->RegisterTransferBuffer(shared_memory, size, id_request);
+  }
+
+  virtual void DestroyTransferBuffer(int32 id) OVERRIDE {
+    service_->DestroyTransferBuffer(id);
+  }
+
+  virtual Buffer GetTransferBuffer(int32 handle) OVERRIDE {
+    return service_->GetTransferBuffer(handle);
+  }
+
+  virtual void SetToken(int32 token) OVERRIDE {
+    NOTREACHED();
+  }
+
+  virtual void SetParseError(error::Error error) OVERRIDE {
+    NOTREACHED();
+  }
+
+  virtual void SetContextLostReason(error::ContextLostReason reason) OVERRIDE {
+    NOTREACHED();
+  }
+
+ private:
+  void RunOnServiceThread(const base::Closure& task) {
+    base::WaitableEvent done(false, false);
+    thread_->message_loop()->PostTask(
+        FROM_HERE, base::Bind(&RunAndSignal, task, &done));
+    done.Wait();
+  }
+
+  // These run on the service thread.
+  void FlushOnServiceThread(int32 put_offset) {
+    service_->Flush(put_offset);
+    UpdateLastState();
+  }
+
+  void UpdateLastState() {
+    State state = service_->GetState();
+    base::AutoLock lock(lock_);
+    last_state_ = state;
+  }
+
+  CommandBufferService* service_;
+  base::Thread* thread_;
+  int32 last_put_offset_;
+  int flush_count_;
+  int sync_count_;
+
+  base::Lock lock_;
+  State last_state_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadedCommandBuffer);
+};
+
+class CommandBufferHelperPerfTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    service_.reset(new CommandBufferService);
+    ASSERT_TRUE(service_->Initialize());
+    scheduler_.reset(new GpuScheduler(service_.get(), &decoder_, NULL));
+    decoder_.set_engine(scheduler_.get());
+    service_->SetPutOffsetChangeCallback(base::Bind(
+        &GpuScheduler::PutChanged, base::Unretained(scheduler_.get())));
+    service_->SetGetBufferChangeCallback(base::Bind(
+        &GpuScheduler::SetGetBuffer, base::Unretained(scheduler_.get())));
+
+    service_thread_.reset(new base::Thread("Service thread"));
+    ASSERT_TRUE(service_thread_->Start());
+
+    command_buffer_.reset(new ThreadedCommandBuffer(service_.get(),
+                                                    service_thread_.get()));
+    helper_.reset(new CommandBufferHelper(command_buffer_.get()));
+    ASSERT_TRUE(helper_->Initialize(kRingBufferSize));
+  }
+
+  virtual void TearDown() {
+    helper_->Finish();
+    helper_.reset();
+    service_thread_->Stop();
+  }
+
+  // Draws each quad as a run of Noops, then ends the frame with a token and
+  // an explicit flush, as SwapBuffers does. Like the compositor, keeps at
+  // most one frame in flight.
+  void DrawFrames() {
+    int32 last_frame_token = -1;
+    for (int frame = 0; frame < kFrames; ++frame) {
+      for (int quad = 0; quad < kQuadsPerFrame; ++quad) {
+        Spin(kClientQuadCostUs);
+        for (int command = 0; command < kCommandsPerQuad; ++command)
+          helper_->Noop(kEntriesPerCommand - 1);
+      }
+      int32 token = helper_->InsertToken();
+      helper_->Flush();
+      helper_->WaitForToken(last_frame_token);
+      last_frame_token = token;
+    }
+  }
+
+  MessageLoop message_loop_;
+  FakeDecoder decoder_;
+  scoped_ptr<CommandBufferService> service_;
+  scoped_ptr<GpuScheduler> scheduler_;
+  scoped_ptr<base::Thread> service_thread_;
+  scoped_ptr<ThreadedCommandBuffer> command_buffer_;
+  scoped_ptr<CommandBufferHelper> helper_;
+};
+
+}  // namespace
+
+TEST_F(CommandBufferHelperPerfTest, CompositorFrames) {
+  PerfTimer timer;
+  DrawFrames();
+  base::TimeDelta elapsed = timer.Elapsed();
+
+  LogPerfResult("CommandBufferHelper_frame_time",
+                elapsed.InMillisecondsF() / kFrames, "ms");
+  LogPerfResult("CommandBufferHelper_flushes_per_frame",
+                static_cast<double>(command_buffer_->flush_count()) / kFrames,
+                "flushes");
+  LogPerfResult("CommandBufferHelper_syncs_per_frame",
+                static_cast<double>(command_buffer_->sync_count()) / kFrames,
+                "syncs");
+}
+
+}  // namespace gpu
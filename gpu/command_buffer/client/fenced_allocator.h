@@ -7,7 +7,9 @@
 #ifndef GPU_COMMAND_BUFFER_CLIENT_FENCED_ALLOCATOR_H_
 #define GPU_COMMAND_BUFFER_CLIENT_FENCED_ALLOCATOR_H_
 
-#include <vector>
+#include <map>
+#include <set>
+#include <utility>
 
 #include "../../gpu_export.h"
 #include "../common/logging.h"
@@ -22,6 +24,11 @@ class CommandBufferHelper;
 // that is, the memory won't be reused until the command buffer has processed
 // that token.
 //
+// Free blocks are indexed by size, so allocations take the smallest block
+// that fits in logarithmic time, and blocks pending a token are indexed by
+// token, so the ones that have passed can be reclaimed without scanning the
+// whole buffer.
+//
 // NOTE: Although this class is intended to be used in the command buffer
 // environment which is multi-process, this class isn't "thread safe", because
 // it isn't meant to be shared across modules. It is thread-compatible though
@@ -99,41 +106,50 @@ class GPU_EXPORT FencedAllocator {
     int32 token;  // token to wait for in the FREE_PENDING_TOKEN case.
   };
 
-  // Comparison functor for memory block sorting.
-  class OffsetCmp {
-   public:
-    bool operator() (const Block &left, const Block &right) {
-      return left.offset < right.offset;
-    }
-  };
+  // All the blocks, keyed by offset. Together they cover the whole buffer.
+  typedef std::map<Offset, Block> Container;
+  typedef Container::iterator BlockIterator;
+
+  // The FREE blocks, as (size, offset) pairs.
+  typedef std::set<std::pair<unsigned int, Offset> > FreeBlockSet;
 
-  typedef std::vector<Block> Container;
-  typedef unsigned int BlockIndex;
+  // The FREE_PENDING_TOKEN blocks, as (token, offset) pairs.
+  typedef std::set<std::pair<int32, Offset> > PendingBlockSet;
 
   static const int32 kUnusedToken = 0;
 
-  // Gets the index of a memory block, given its offset.
-  BlockIndex GetBlockByOffset(Offset offset);
+  // Gets a memory block, given its offset.
+  BlockIterator GetBlockByOffset(Offset offset);
+
+  // Adds a block to |blocks_| and to the index matching its state.
+  void InsertBlock(const Block& block);
+
+  // Adds a block to, or removes it from, the index matching its state. Must
+  // be called around every state or size change of a block.
+  void AddToIndex(const Block& block);
+  void RemoveFromIndex(const Block& block);
+
+  // Gets the smallest FREE block of at least |size| bytes, or blocks_.end()
+  // if there is none.
+  BlockIterator FindBestFit(unsigned int size);
 
-  // Collapse a free block with its neighbours if they are free. Returns the
-  // index of the collapsed block.
-  // NOTE: this will invalidate block indices.
-  BlockIndex CollapseFreeBlock(BlockIndex index);
+  // Marks a block FREE and collapses it with its neighbours if they are free.
+  // Returns the collapsed block.
+  BlockIterator FreeBlock(BlockIterator it);
 
   // Waits for a FREE_PENDING_TOKEN block to be usable, and free it. Returns
-  // the new index of that block (since it may have been collapsed).
-  // NOTE: this will invalidate block indices.
-  BlockIndex WaitForTokenAndFreeBlock(BlockIndex index);
+  // the block it was collapsed into.
+  BlockIterator WaitForTokenAndFreeBlock(BlockIterator it);
 
   // Allocates a block of memory inside a given block, splitting it in two
   // (unless that block is of the exact requested size).
-  // NOTE: this will invalidate block indices.
-  // Returns the offset of the allocated block (NOTE: this is different from
-  // the other functions that return a block index).
-  Offset AllocInBlock(BlockIndex index, unsigned int size);
+  // Returns the offset of the allocated block.
+  Offset AllocInBlock(BlockIterator it, unsigned int size);
 
   CommandBufferHelper *helper_;
   Container blocks_;
+  FreeBlockSet free_blocks_;
+  PendingBlockSet pending_blocks_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(FencedAllocator);
 };
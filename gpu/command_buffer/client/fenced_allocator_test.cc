@@ -271,6 +271,37 @@ TEST_F(FencedAllocatorTest, FreeUnused) {
   EXPECT_FALSE(allocator_->InUse());
 }
 
+// Checks that allocations are made in the smallest free block that fits.
+TEST_F(FencedAllocatorTest, TestBestFit) {
+  EXPECT_TRUE(allocator_->CheckConsistency());
+
+  const unsigned int kSize = 16;
+  FencedAllocator::Offset offset0 = allocator_->Alloc(kSize);
+  FencedAllocator::Offset offset1 = allocator_->Alloc(kSize);
+  FencedAllocator::Offset offset2 = allocator_->Alloc(2 * kSize);
+  FencedAllocator::Offset offset3 = allocator_->Alloc(kSize);
+  ASSERT_NE(FencedAllocator::kInvalidOffset, offset0);
+  ASSERT_NE(FencedAllocator::kInvalidOffset, offset1);
+  ASSERT_NE(FencedAllocator::kInvalidOffset, offset2);
+  ASSERT_NE(FencedAllocator::kInvalidOffset, offset3);
+
+  // Leave free blocks of kSize, 2 * kSize and the rest of the buffer.
+  allocator_->Free(offset0);
+  allocator_->Free(offset2);
+  EXPECT_TRUE(allocator_->CheckConsistency());
+
+  EXPECT_EQ(offset2, allocator_->Alloc(2 * kSize));
+  EXPECT_EQ(offset0, allocator_->Alloc(kSize));
+  EXPECT_TRUE(allocator_->CheckConsistency());
+
+  allocator_->Free(offset0);
+  allocator_->Free(offset1);
+  allocator_->Free(offset2);
+  allocator_->Free(offset3);
+  EXPECT_TRUE(allocator_->CheckConsistency());
+  EXPECT_FALSE(allocator_->InUse());
+}
+
 // Tests GetLargestFreeSize
 TEST_F(FencedAllocatorTest, TestGetLargestFreeSize) {
   EXPECT_TRUE(allocator_->CheckConsistency());
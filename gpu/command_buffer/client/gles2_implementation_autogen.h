@@ -1578,5 +1578,11 @@ void ConsumeTextureCHROMIUM(GLenum target, const GLbyte* mailbox) {
   helper_->ConsumeTextureCHROMIUMImmediate(target, mailbox);
 }
 
+void WaitSyncPointCHROMIUM(GLuint sync_point) {
+  GPU_CLIENT_SINGLE_THREAD_CHECK();
+  GPU_CLIENT_LOG("[" << this << "] glWaitSyncPointCHROMIUM(" << sync_point << ")");  // NOLINT
+  helper_->WaitSyncPointCHROMIUM(sync_point);
+}
+
 #endif  // GPU_COMMAND_BUFFER_CLIENT_GLES2_IMPLEMENTATION_AUTOGEN_H_
 
@@ -15,16 +15,22 @@ void DeleteMemoryChunk(MemoryChunk* chunk) {
 }
 }
 
+#ifndef _MSC_VER
+const unsigned int MappedMemoryManager::kChunkIdleAllocs;
+#endif
+
 MemoryChunk::MemoryChunk(
     int32 shm_id, gpu::Buffer shm, CommandBufferHelper* helper)
     : shm_id_(shm_id),
       shm_(shm),
-      allocator_(shm.size, helper, shm.ptr) {
+      allocator_(shm.size, helper, shm.ptr),
+      last_used_(0) {
 }
 
 MappedMemoryManager::MappedMemoryManager(CommandBufferHelper* helper)
     : chunk_size_multiple_(1),
-      helper_(helper) {
+      helper_(helper),
+      alloc_count_(0) {
 }
 
 MappedMemoryManager::~MappedMemoryManager() {
@@ -38,11 +44,15 @@ void* MappedMemoryManager::Alloc(
     unsigned int size, int32* shm_id, unsigned int* shm_offset) {
   GPU_DCHECK(shm_id);
   GPU_DCHECK(shm_offset);
+  if (++alloc_count_ % kChunkIdleAllocs == 0)
+    FreeIdleChunks();
+
   // See if any of the chucks can satisfy this request.
   for (size_t ii = 0; ii < chunks_.size(); ++ii) {
     MemoryChunk* chunk = chunks_[ii];
     chunk->FreeUnused();
     if (chunk->GetLargestFreeSizeWithoutWaiting() >= size) {
+      chunk->set_last_used(alloc_count_);
       void* mem = chunk->Alloc(size);
       GPU_DCHECK(mem);
       *shm_id = chunk->shm_id();
@@ -62,6 +72,7 @@ void* MappedMemoryManager::Alloc(
   }
   gpu::Buffer shm = cmd_buf->GetTransferBuffer(id);
   MemoryChunk* mc = new MemoryChunk(id, shm, helper_);
+  mc->set_last_used(alloc_count_);
   chunks_.push_back(mc);
   void* mem = mc->Alloc(size);
   GPU_DCHECK(mem);
@@ -93,13 +104,23 @@ void MappedMemoryManager::FreePendingToken(void* pointer, int32 token) {
 }
 
 void MappedMemoryManager::FreeUnused() {
+  FreeChunks(false);
+}
+
+void MappedMemoryManager::FreeIdleChunks() {
+  FreeChunks(true);
+}
+
+void MappedMemoryManager::FreeChunks(bool only_idle) {
   CommandBuffer* cmd_buf = helper_->command_buffer();
   MemoryChunkVector::iterator iter = chunks_.begin();
   while (iter != chunks_.end()) {
     MemoryChunk* chunk = *iter;
     chunk->FreeUnused();
-    if (!chunk->InUse()) {
+    if (!chunk->InUse() &&
+        (!only_idle || alloc_count_ - chunk->last_used() >= kChunkIdleAllocs)) {
       cmd_buf->DestroyTransferBuffer(chunk->shm_id());
+      delete chunk;
       iter = chunks_.erase(iter);
     } else {
       ++iter;
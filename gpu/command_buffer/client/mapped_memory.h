@@ -96,10 +96,21 @@ class GPU_EXPORT MemoryChunk {
     return allocator_.InUse();
   }
 
+  // The MappedMemoryManager allocation count at which this chunk was last
+  // allocated from.
+  unsigned int last_used() const {
+    return last_used_;
+  }
+
+  void set_last_used(unsigned int last_used) {
+    last_used_ = last_used;
+  }
+
  private:
   int32 shm_id_;
   gpu::Buffer shm_;
   FencedAllocatorWrapper allocator_;
+  unsigned int last_used_;
 
   DISALLOW_COPY_AND_ASSIGN(MemoryChunk);
 };
@@ -146,19 +157,34 @@ class GPU_EXPORT MappedMemoryManager {
   // Free Any Shared memory that is not in use.
   void FreeUnused();
 
+  // Frees the chunks that are not in use and have not been allocated from
+  // during the last |kChunkIdleAllocs| allocations. Alloc() calls this
+  // periodically, so the shared memory held after a burst of allocations
+  // drops back to what is actually being used.
+  void FreeIdleChunks();
+
   // Used for testing
   size_t num_chunks() {
     return chunks_.size();
   }
 
+  static const unsigned int kChunkIdleAllocs = 1024;
+
  private:
   typedef std::vector<MemoryChunk*> MemoryChunkVector;
 
+  // Releases the chunks that are not in use. If |only_idle| is true, chunks
+  // allocated from during the last |kChunkIdleAllocs| allocations are kept.
+  void FreeChunks(bool only_idle);
+
   // size a chunk is rounded up to.
   unsigned int chunk_size_multiple_;
   CommandBufferHelper* helper_;
   MemoryChunkVector chunks_;
 
+  // Number of allocations made so far.
+  unsigned int alloc_count_;
+
   DISALLOW_COPY_AND_ASSIGN(MappedMemoryManager);
 };
 
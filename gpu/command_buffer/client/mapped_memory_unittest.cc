@@ -271,6 +271,29 @@ TEST_F(MappedMemoryManagerTest, FreeUnused) {
   EXPECT_EQ(0u, manager_->num_chunks());
 }
 
+TEST_F(MappedMemoryManagerTest, FreeIdleChunks) {
+  int32 id = -1;
+  unsigned int offset = 0xFFFFFFFFU;
+  void* m1 = manager_->Alloc(kBufferSize, &id, &offset);
+  void* m2 = manager_->Alloc(kBufferSize, &id, &offset);
+  ASSERT_TRUE(m1 != NULL);
+  ASSERT_TRUE(m2 != NULL);
+  EXPECT_EQ(2u, manager_->num_chunks());
+  manager_->Free(m1);
+  manager_->Free(m2);
+  // Both chunks were used recently.
+  manager_->FreeIdleChunks();
+  EXPECT_EQ(2u, manager_->num_chunks());
+  // Keep allocating from the first chunk only.
+  for (unsigned int i = 0; i < MappedMemoryManager::kChunkIdleAllocs; ++i) {
+    void* mem = manager_->Alloc(kBufferSize / 2, &id, &offset);
+    ASSERT_TRUE(mem != NULL);
+    manager_->Free(mem);
+  }
+  manager_->FreeIdleChunks();
+  EXPECT_EQ(1u, manager_->num_chunks());
+}
+
 TEST_F(MappedMemoryManagerTest, ChunkSizeMultiple) {
   const unsigned int kSize = 1024;
   manager_->set_chunk_size_multiple(kSize *  2);
@@ -227,6 +227,7 @@
   OP(ProduceTextureCHROMIUMImmediate)                          /* 470 */ \
   OP(ConsumeTextureCHROMIUM)                                   /* 471 */ \
   OP(ConsumeTextureCHROMIUMImmediate)                          /* 472 */ \
+  OP(WaitSyncPointCHROMIUM)                                    /* 473 */ \
 
 enum CommandId {
   kStartPoint = cmd::kLastCommonId,  // All GLES2 commands start after this.
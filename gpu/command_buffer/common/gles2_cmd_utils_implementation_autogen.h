@@ -296,6 +296,8 @@ static GLES2Util::EnumToString enum_to_string_table[] = {
   { 0x9241, "GL_UNPACK_PREMULTIPLY_ALPHA_CHROMIUM", },
   { 0x8B52, "GL_FLOAT_VEC4", },
   { 0x9240, "GL_UNPACK_FLIP_Y_CHROMIUM", },
+  { 0x6006, "GL_UNPACK_ASYNC_UPLOAD_CHROMIUM", },
+  { 0x6005, "GL_ASYNC_PIXEL_TRANSFERS_COMPLETED_CHROMIUM", },
   { 0x8B51, "GL_FLOAT_VEC3", },
   { 0x8B50, "GL_FLOAT_VEC2", },
   { 0x812F, "GL_CLAMP_TO_EDGE", },
@@ -893,6 +895,7 @@ std::string GLES2Util::GetStringPixelStore(uint32 value) {
     { GL_UNPACK_FLIP_Y_CHROMIUM, "GL_UNPACK_FLIP_Y_CHROMIUM" },
     { GL_UNPACK_PREMULTIPLY_ALPHA_CHROMIUM,
     "GL_UNPACK_PREMULTIPLY_ALPHA_CHROMIUM" },
+    { GL_UNPACK_ASYNC_UPLOAD_CHROMIUM, "GL_UNPACK_ASYNC_UPLOAD_CHROMIUM" },
   };
   return GLES2Util::GetQualifiedEnumString(
       string_table, arraysize(string_table), value);
@@ -948,6 +951,8 @@ std::string GLES2Util::GetStringQueryTarget(uint32 value) {
     { GL_ANY_SAMPLES_PASSED_CONSERVATIVE_EXT,
     "GL_ANY_SAMPLES_PASSED_CONSERVATIVE_EXT" },
     { GL_COMMANDS_ISSUED_CHROMIUM, "GL_COMMANDS_ISSUED_CHROMIUM" },
+    { GL_ASYNC_PIXEL_TRANSFERS_COMPLETED_CHROMIUM,
+    "GL_ASYNC_PIXEL_TRANSFERS_COMPLETED_CHROMIUM" },
   };
   return GLES2Util::GetQualifiedEnumString(
       string_table, arraysize(string_table), value);
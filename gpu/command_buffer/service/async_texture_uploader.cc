@@ -0,0 +1,169 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gpu/command_buffer/service/async_texture_uploader.h"
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/debug/trace_event.h"
+#include "base/logging.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "ui/gfx/gl/gl_context.h"
+#include "ui/gfx/gl/gl_surface.h"
+#include "ui/gfx/size.h"
+
+namespace gpu {
+namespace gles2 {
+
+struct AsyncTextureUploader::Upload {
+  GLuint service_id;
+  GLint level;
+  GLint xoffset;
+  GLint yoffset;
+  GLsizei width;
+  GLsizei height;
+  GLenum format;
+  GLenum type;
+  GLint unpack_alignment;
+  std::vector<uint8> pixels;
+};
+
+namespace {
+
+void RunAndSignal(const base::Closure& task, base::WaitableEvent* event) {
+  task.Run();
+  event->Signal();
+}
+
+}  // anonymous namespace.
+
+// static
+AsyncTextureUploader* AsyncTextureUploader::Create(
+    gfx::GLShareGroup* share_group) {
+  // A context on the other GPU of a dual GPU system could not share with the
+  // decoder's context.
+  if (gfx::GLContext::SupportsDualGpus())
+    return NULL;
+
+  scoped_ptr<AsyncTextureUploader> uploader(new AsyncTextureUploader);
+  if (!uploader->thread_->Start())
+    return NULL;
+
+  bool result = false;
+  base::WaitableEvent initialized(false, false);
+  uploader->thread_->message_loop()->PostTask(
+      FROM_HERE,
+      base::Bind(&RunAndSignal,
+                 base::Bind(&AsyncTextureUploader::InitializeOnUploadThread,
+                            base::Unretained(uploader.get()),
+                            make_scoped_refptr(share_group),
+                            &result),
+                 &initialized));
+  initialized.Wait();
+  if (!result)
+    return NULL;
+  return uploader.release();
+}
+
+AsyncTextureUploader::AsyncTextureUploader()
+    : thread_(new base::Thread("GpuTextureUploadThread")),
+      issued_count_(0),
+      completed_count_(0) {
+}
+
+AsyncTextureUploader::~AsyncTextureUploader() {
+  if (thread_->IsRunning()) {
+    thread_->message_loop()->PostTask(
+        FROM_HERE,
+        base::Bind(&AsyncTextureUploader::DestroyOnUploadThread,
+                   base::Unretained(this)));
+  }
+  // Runs every queued upload before joining the thread.
+  thread_->Stop();
+}
+
+void AsyncTextureUploader::TexSubImage2D(GLuint service_id,
+                                         GLint level,
+                                         GLint xoffset,
+                                         GLint yoffset,
+                                         GLsizei width,
+                                         GLsizei height,
+                                         GLenum format,
+                                         GLenum type,
+                                         GLint unpack_alignment,
+                                         const void* pixels,
+                                         uint32 pixels_size) {
+  Upload* upload = new Upload;
+  upload->service_id = service_id;
+  upload->level = level;
+  upload->xoffset = xoffset;
+  upload->yoffset = yoffset;
+  upload->width = width;
+  upload->height = height;
+  upload->format = format;
+  upload->type = type;
+  upload->unpack_alignment = unpack_alignment;
+  const uint8* data = static_cast<const uint8*>(pixels);
+  upload->pixels.assign(data, data + pixels_size);
+
+  ++issued_count_;
+  thread_->message_loop()->PostTask(
+      FROM_HERE,
+      base::Bind(&AsyncTextureUploader::PerformUpload,
+                 base::Unretained(this),
+                 base::Owned(upload)));
+}
+
+void AsyncTextureUploader::InitializeOnUploadThread(
+    gfx::GLShareGroup* share_group, bool* result) {
+  surface_ = gfx::GLSurface::CreateOffscreenGLSurface(false, gfx::Size(1, 1));
+  if (!surface_.get()) {
+    LOG(ERROR) << "AsyncTextureUploader: could not create surface.";
+    return;
+  }
+  context_ = gfx::GLContext::CreateGLContext(
+      share_group, surface_.get(), gfx::PreferIntegratedGpu);
+  if (!context_.get()) {
+    LOG(ERROR) << "AsyncTextureUploader: could not create context.";
+    surface_ = NULL;
+    return;
+  }
+  if (!context_->MakeCurrent(surface_.get())) {
+    LOG(ERROR) << "AsyncTextureUploader: could not make context current.";
+    context_ = NULL;
+    surface_ = NULL;
+    return;
+  }
+  *result = true;
+}
+
+void AsyncTextureUploader::DestroyOnUploadThread() {
+  if (context_.get()) {
+    context_->ReleaseCurrent(surface_.get());
+    context_ = NULL;
+  }
+  surface_ = NULL;
+}
+
+void AsyncTextureUploader::PerformUpload(const Upload* upload) {
+  TRACE_EVENT2("gpu", "AsyncTextureUploader::PerformUpload",
+               "width", upload->width, "height", upload->height);
+  glBindTexture(GL_TEXTURE_2D, upload->service_id);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, upload->unpack_alignment);
+  glTexSubImage2D(GL_TEXTURE_2D, upload->level,
+                  upload->xoffset, upload->yoffset,
+                  upload->width, upload->height,
+                  upload->format, upload->type,
+                  &upload->pixels[0]);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  // The decoder's context may sample the texture as soon as the completion is
+  // visible, so the upload has to have landed by then.
+  glFinish();
+  base::subtle::Release_Store(
+      &completed_count_, base::subtle::NoBarrier_Load(&completed_count_) + 1);
+}
+
+}  // namespace gles2
+}  // namespace gpu
@@ -0,0 +1,94 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef GPU_COMMAND_BUFFER_SERVICE_ASYNC_TEXTURE_UPLOADER_H_
+#define GPU_COMMAND_BUFFER_SERVICE_ASYNC_TEXTURE_UPLOADER_H_
+
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "gpu/command_buffer/service/gl_utils.h"
+#include "gpu/gpu_export.h"
+
+namespace base {
+class Thread;
+}
+
+namespace gfx {
+class GLContext;
+class GLShareGroup;
+class GLSurface;
+}
+
+namespace gpu {
+namespace gles2 {
+
+// Performs glTexSubImage2D calls on a dedicated thread, using a GL context
+// that shares textures with the decoder's context, so that large uploads do
+// not stall the GPU main thread and every other command buffer it serves.
+// Uploads complete in the order they were queued. Callers find out when an
+// upload is done by comparing completed_count() with the value of
+// issued_count() right after queuing it.
+class GPU_EXPORT AsyncTextureUploader {
+ public:
+  // Starts the upload thread and creates a context in |share_group| on it.
+  // Returns NULL if that fails.
+  static AsyncTextureUploader* Create(gfx::GLShareGroup* share_group);
+
+  ~AsyncTextureUploader();
+
+  // Copies |pixels| and queues an upload of them into |level| of the 2D
+  // texture |service_id|. The texture level must already be defined, and any
+  // GL commands it depends on must have been flushed by the caller.
+  void TexSubImage2D(GLuint service_id,
+                     GLint level,
+                     GLint xoffset,
+                     GLint yoffset,
+                     GLsizei width,
+                     GLsizei height,
+                     GLenum format,
+                     GLenum type,
+                     GLint unpack_alignment,
+                     const void* pixels,
+                     uint32 pixels_size);
+
+  // Number of uploads queued so far. Only valid on the decoder's thread.
+  uint32 issued_count() const {
+    return issued_count_;
+  }
+
+  // Number of uploads finished so far. May be called from any thread.
+  uint32 completed_count() const {
+    return static_cast<uint32>(base::subtle::Acquire_Load(&completed_count_));
+  }
+
+ private:
+  struct Upload;
+
+  AsyncTextureUploader();
+
+  // These run on the upload thread.
+  void InitializeOnUploadThread(gfx::GLShareGroup* share_group, bool* result);
+  void DestroyOnUploadThread();
+  void PerformUpload(const Upload* upload);
+
+  scoped_ptr<base::Thread> thread_;
+
+  // Only used on the upload thread.
+  scoped_refptr<gfx::GLSurface> surface_;
+  scoped_refptr<gfx::GLContext> context_;
+
+  uint32 issued_count_;
+  volatile base::subtle::Atomic32 completed_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncTextureUploader);
+};
+
+}  // namespace gles2
+}  // namespace gpu
+
+#endif  // GPU_COMMAND_BUFFER_SERVICE_ASYNC_TEXTURE_UPLOADER_H_
@@ -7,6 +7,7 @@
 #include <string>
 
 #include "base/command_line.h"
+#include "base/lazy_instance.h"
 #include "base/string_util.h"
 #include "gpu/command_buffer/common/id_allocator.h"
 #include "gpu/command_buffer/service/buffer_manager.h"
@@ -14,6 +15,7 @@
 #include "gpu/command_buffer/service/gles2_cmd_decoder.h"
 #include "gpu/command_buffer/service/gpu_switches.h"
 #include "gpu/command_buffer/service/mailbox_manager.h"
+#include "gpu/command_buffer/service/program_cache.h"
 #include "gpu/command_buffer/service/program_manager.h"
 #include "gpu/command_buffer/service/renderbuffer_manager.h"
 #include "gpu/command_buffer/service/shader_manager.h"
@@ -23,6 +25,28 @@
 namespace gpu {
 namespace gles2 {
 
+namespace {
+
+// Upper bound on the memory used by the cached program binaries.
+const size_t kMaxProgramCacheSizeBytes = 6 * 1024 * 1024;
+
+// Linked programs are cached for the whole process so that contexts created
+// later, e.g. by a new renderer, can skip linking programs seen before.
+class ProcessProgramCache : public ProgramCache {
+ public:
+  ProcessProgramCache() : ProgramCache(kMaxProgramCacheSizeBytes) {}
+};
+
+base::LazyInstance<ProcessProgramCache>::Leaky g_program_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+std::string GetGLString(GLenum name) {
+  const char* str = reinterpret_cast<const char*>(glGetString(name));
+  return str ? std::string(str) : std::string();
+}
+
+}  // anonymous namespace
+
 ContextGroup::ContextGroup(MailboxManager* mailbox_manager,
                            bool bind_generates_resource)
     : mailbox_manager_(mailbox_manager ? mailbox_manager : new MailboxManager),
@@ -124,7 +148,20 @@ bool ContextGroup::Initialize(const DisallowedFeatures& disallowed_features,
   renderbuffer_manager_.reset(new RenderbufferManager(
       max_renderbuffer_size, max_samples));
   shader_manager_.reset(new ShaderManager());
-  program_manager_.reset(new ProgramManager());
+  if (feature_info_->feature_flags().get_program_binary &&
+      !CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kDisableGpuProgramCache)) {
+    // Binaries are only valid for the driver that produced them, and the
+    // extensions can change the programs the decoder builds.
+    std::string gl_info = GetGLString(GL_VENDOR) + "\n" +
+                          GetGLString(GL_RENDERER) + "\n" +
+                          GetGLString(GL_VERSION) + "\n" +
+                          feature_info_->extensions();
+    program_manager_.reset(
+        new ProgramManager(g_program_cache.Pointer(), gl_info));
+  } else {
+    program_manager_.reset(new ProgramManager());
+  }
 
   // Lookup GL things we need to know.
   const GLint kGLES2RequiredMinimumVertexAttribs = 8u;
@@ -85,6 +85,10 @@
 // GL_CHROMIUM_command_buffer_query
 #define GL_COMMANDS_ISSUED_CHROMIUM            0x84F2
 
+// GL_CHROMIUM_async_pixel_transfers
+#define GL_ASYNC_PIXEL_TRANSFERS_COMPLETED_CHROMIUM 0x6005
+#define GL_UNPACK_ASYNC_UPLOAD_CHROMIUM        0x6006
+
 
 #define GL_GLEXT_PROTOTYPES 1
 
@@ -27,6 +27,7 @@
 #include "gpu/command_buffer/common/gles2_cmd_format.h"
 #include "gpu/command_buffer/common/gles2_cmd_utils.h"
 #include "gpu/command_buffer/common/id_allocator.h"
+#include "gpu/command_buffer/service/async_texture_uploader.h"
 #include "gpu/command_buffer/service/buffer_manager.h"
 #include "gpu/command_buffer/service/cmd_buffer_engine.h"
 #include "gpu/command_buffer/service/context_group.h"
@@ -498,6 +499,7 @@ class GLES2DecoderImpl : public base::SupportsWeakPtr<GLES2DecoderImpl>,
       const base::Callback<void(gfx::Size)>& callback);
 
   virtual void SetMsgCallback(const MsgCallback& callback);
+  virtual void SetWaitSyncPointCallback(const WaitSyncPointCallback& callback);
 
   virtual void SetStreamTextureManager(StreamTextureManager* manager);
   virtual bool GetServiceTextureId(uint32 client_texture_id,
@@ -729,6 +731,21 @@ class GLES2DecoderImpl : public base::SupportsWeakPtr<GLES2DecoderImpl>,
     GLenum type,
     const void * data);
 
+  // Hands a TexSubImage2D of the 2D texture |info| to the async texture
+  // uploader if the client asked for it with GL_UNPACK_ASYNC_UPLOAD_CHROMIUM.
+  // Returns false if the upload must be done synchronously instead.
+  bool MaybeAsyncTexSubImage2D(
+    TextureManager::TextureInfo* info,
+    GLenum target,
+    GLint level,
+    GLint xoffset,
+    GLint yoffset,
+    GLsizei width,
+    GLsizei height,
+    GLenum format,
+    GLenum type,
+    const void * data);
+
   // Wrapper for TexImageIOSurface2DCHROMIUM.
   void DoTexImageIOSurface2DCHROMIUM(
     GLenum target,
@@ -754,6 +771,8 @@ class GLES2DecoderImpl : public base::SupportsWeakPtr<GLES2DecoderImpl>,
   void DoProduceTextureCHROMIUM(GLenum target, const GLbyte* key);
   void DoConsumeTextureCHROMIUM(GLenum target, const GLbyte* key);
 
+  void DoWaitSyncPointCHROMIUM(GLuint sync_point);
+
   // Creates a ProgramInfo for the given program.
   ProgramManager::ProgramInfo* CreateProgramInfo(
       GLuint client_id, GLuint service_id) {
@@ -1361,6 +1380,9 @@ class GLES2DecoderImpl : public base::SupportsWeakPtr<GLES2DecoderImpl>,
   // unpack premultiply alpha as last set by glPixelStorei
   bool unpack_premultiply_alpha_;
 
+  // unpack async upload as last set by glPixelStorei
+  bool unpack_async_upload_;
+
   // The currently bound array buffer. If this is 0 it is illegal to call
   // glVertexAttribPointer.
   BufferManager::BufferInfo::Ref bound_array_buffer_;
@@ -1457,10 +1479,17 @@ class GLES2DecoderImpl : public base::SupportsWeakPtr<GLES2DecoderImpl>,
   scoped_ptr<QueryManager> query_manager_;
   QueryManager::Query::Ref current_query_;
 
+  // Created on the first async upload when --enable-gpu-async-texture-uploads
+  // is set. Cleared along with the flag if that fails.
+  bool async_texture_uploads_enabled_;
+  scoped_ptr<AsyncTextureUploader> async_texture_uploader_;
+
   base::Callback<void(gfx::Size)> resize_callback_;
 
   MsgCallback msg_callback_;
 
+  WaitSyncPointCallback wait_sync_point_callback_;
+
   StreamTextureManager* stream_texture_manager_;
 
   // The format of the back buffer_
@@ -1869,6 +1898,7 @@ GLES2DecoderImpl::GLES2DecoderImpl(ContextGroup* group)
       unpack_alignment_(4),
       unpack_flip_y_(false),
       unpack_premultiply_alpha_(false),
+      unpack_async_upload_(false),
       attrib_0_buffer_id_(0),
       attrib_0_buffer_matches_value_(true),
       attrib_0_size_(0),
@@ -1899,6 +1929,7 @@ GLES2DecoderImpl::GLES2DecoderImpl(ContextGroup* group)
       offscreen_target_samples_(0),
       offscreen_target_buffer_preserved_(true),
       offscreen_saved_color_format_(0),
+      async_texture_uploads_enabled_(false),
       stream_texture_manager_(NULL),
       back_buffer_color_format_(0),
       back_buffer_has_depth_(false),
@@ -1981,6 +2012,9 @@ bool GLES2DecoderImpl::Initialize(
   compile_shader_always_succeeds_ = CommandLine::ForCurrentProcess()->HasSwitch(
       switches::kCompileShaderAlwaysSucceeds);
 
+  async_texture_uploads_enabled_ = CommandLine::ForCurrentProcess()->HasSwitch(
+      switches::kEnableGpuAsyncTextureUploads);
+
   // Take ownership of the GLSurface. TODO(apatrick): once the parent / child
   // context is retired, the decoder should not take an initial surface as
   // an argument to this function.
@@ -2712,6 +2746,11 @@ void GLES2DecoderImpl::SetMsgCallback(const MsgCallback& callback) {
   msg_callback_ = callback;
 }
 
+void GLES2DecoderImpl::SetWaitSyncPointCallback(
+    const WaitSyncPointCallback& callback) {
+  wait_sync_point_callback_ = callback;
+}
+
 void GLES2DecoderImpl::SetStreamTextureManager(StreamTextureManager* manager) {
   stream_texture_manager_ = manager;
 }
@@ -2807,6 +2846,9 @@ void GLES2DecoderImpl::Destroy() {
     query_manager_.reset();
   }
 
+  // Finishes any uploads still in flight before the textures go away.
+  async_texture_uploader_.reset();
+
   if (group_) {
     group_->Destroy(have_context);
     group_ = NULL;
@@ -6231,6 +6273,11 @@ error::Error GLES2DecoderImpl::HandlePixelStorei(
                        "glPixelSTore: param GL_INVALID_VALUE");
             return error::kNoError;
         }
+        break;
+    case GL_UNPACK_ASYNC_UPLOAD_CHROMIUM:
+        // Handled entirely by the decoder; GL does not know this parameter.
+        unpack_async_upload_ = (param != 0);
+        return error::kNoError;
     default:
         break;
   }
@@ -7236,12 +7283,18 @@ void GLES2DecoderImpl::DoTexSubImage2D(
       SetGLError(GL_OUT_OF_MEMORY, "glTexSubImage2D: dimensions too big");
       return;
     }
-    glTexSubImage2D(
-        target, level, xoffset, yoffset, width, height, format, type, data);
+    if (!MaybeAsyncTexSubImage2D(info, target, level, xoffset, yoffset,
+                                 width, height, format, type, data)) {
+      glTexSubImage2D(
+          target, level, xoffset, yoffset, width, height, format, type, data);
+    }
     return;
   }
 
-  if (teximage2d_faster_than_texsubimage2d_ && !info->IsImmutable()) {
+  if (MaybeAsyncTexSubImage2D(info, target, level, xoffset, yoffset,
+                              width, height, format, type, data)) {
+    // Uploaded on the upload thread.
+  } else if (teximage2d_faster_than_texsubimage2d_ && !info->IsImmutable()) {
     // NOTE: In OpenGL ES 2.0 border is always zero and format is always the
     // same as internal_foramt. If that changes we'll need to look them up.
     WrappedTexImage2D(
@@ -7253,6 +7306,48 @@ void GLES2DecoderImpl::DoTexSubImage2D(
   texture_manager()->SetLevelCleared(info, target, level);
 }
 
+bool GLES2DecoderImpl::MaybeAsyncTexSubImage2D(
+  TextureManager::TextureInfo* info,
+  GLenum target,
+  GLint level,
+  GLint xoffset,
+  GLint yoffset,
+  GLsizei width,
+  GLsizei height,
+  GLenum format,
+  GLenum type,
+  const void * data) {
+  if (!unpack_async_upload_ || !async_texture_uploads_enabled_ ||
+      target != GL_TEXTURE_2D) {
+    return false;
+  }
+  uint32 data_size;
+  if (!GLES2Util::ComputeImageDataSizes(
+      width, height, format, type, unpack_alignment_, &data_size, NULL, NULL)) {
+    return false;
+  }
+  if (!async_texture_uploader_.get()) {
+    async_texture_uploader_.reset(
+        AsyncTextureUploader::Create(context_->share_group()));
+    if (!async_texture_uploader_.get()) {
+      async_texture_uploads_enabled_ = false;
+      return false;
+    }
+    query_manager_->set_async_texture_uploader(async_texture_uploader_.get());
+  }
+  // The texture may be sampled before the upload lands, so it must not expose
+  // uninitialized memory in the meantime.
+  if (!texture_manager()->ClearTextureLevel(this, info, target, level)) {
+    return false;
+  }
+  // The upload context must see the texture definition and the clear.
+  glFlush();
+  async_texture_uploader_->TexSubImage2D(
+      info->service_id(), level, xoffset, yoffset, width, height,
+      format, type, unpack_alignment_, data, data_size);
+  return true;
+}
+
 error::Error GLES2DecoderImpl::HandleTexSubImage2D(
     uint32 immediate_data_size, const gles2::TexSubImage2D& c) {
   TRACE_EVENT0("gpu", "GLES2DecoderImpl::HandleTexSubImage2D");
@@ -8050,6 +8145,7 @@ error::Error GLES2DecoderImpl::HandleBeginQueryEXT(
 
   switch (target) {
     case GL_COMMANDS_ISSUED_CHROMIUM:
+    case GL_ASYNC_PIXEL_TRANSFERS_COMPLETED_CHROMIUM:
       break;
     default:
       if (!feature_info_->feature_flags().occlusion_query_boolean) {
@@ -8608,6 +8704,14 @@ void GLES2DecoderImpl::DoConsumeTextureCHROMIUM(GLenum target,
   BindAndApplyTextureParameters(info);
 }
 
+void GLES2DecoderImpl::DoWaitSyncPointCHROMIUM(GLuint sync_point) {
+  // Without a callback there is nothing else the decoder can wait on, and
+  // everything it has issued is already ordered after its own commands.
+  if (wait_sync_point_callback_.is_null())
+    return;
+  wait_sync_point_callback_.Run(sync_point);
+}
+
 // Include the auto-generated part of this file. We split this because it means
 // we can easily edit the non-auto generated parts right here in this file
 // instead of having to edit some template or the code generator.
@@ -47,6 +47,7 @@ class GPU_EXPORT GLES2Decoder : public CommonDecoder {
  public:
   typedef error::Error Error;
   typedef base::Callback<void(int32 id, const std::string& msg)> MsgCallback;
+  typedef base::Callback<void(uint32 sync_point)> WaitSyncPointCallback;
 
   // Creates a decoder.
   static GLES2Decoder* Create(ContextGroup* group);
@@ -170,6 +171,11 @@ class GPU_EXPORT GLES2Decoder : public CommonDecoder {
   // A callback for messages from the decoder.
   virtual void SetMsgCallback(const MsgCallback& callback) = 0;
 
+  // A callback run by glWaitSyncPointCHROMIUM. It is expected to deschedule
+  // the decoder until |sync_point| has been retired.
+  virtual void SetWaitSyncPointCallback(
+      const WaitSyncPointCallback& callback) = 0;
+
   static bool IsAngle();
 
   // Used for testing only
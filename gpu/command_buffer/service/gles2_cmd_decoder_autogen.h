@@ -2828,5 +2828,12 @@ error::Error GLES2DecoderImpl::HandleConsumeTextureCHROMIUMImmediate(
   return error::kNoError;
 }
 
+error::Error GLES2DecoderImpl::HandleWaitSyncPointCHROMIUM(
+    uint32 immediate_data_size, const gles2::WaitSyncPointCHROMIUM& c) {
+  GLuint sync_point = static_cast<GLuint>(c.sync_point);
+  DoWaitSyncPointCHROMIUM(sync_point);
+  return error::kNoError;
+}
+
 #endif  // GPU_COMMAND_BUFFER_SERVICE_GLES2_CMD_DECODER_AUTOGEN_H_
 
@@ -72,6 +72,8 @@ class MockGLES2Decoder : public GLES2Decoder {
       int height,
       bool is_texture_immutable));
   MOCK_METHOD1(SetMsgCallback, void(const MsgCallback& callback));
+  MOCK_METHOD1(SetWaitSyncPointCallback,
+               void(const WaitSyncPointCallback& callback));
 
   DISALLOW_COPY_AND_ASSIGN(MockGLES2Decoder);
 };
@@ -39,5 +39,6 @@
 // TODO(gman): ProduceTextureCHROMIUMImmediate
 // TODO(gman): ConsumeTextureCHROMIUM
 // TODO(gman): ConsumeTextureCHROMIUMImmediate
+// TODO(gman): WaitSyncPointCHROMIUM
 #endif  // GPU_COMMAND_BUFFER_SERVICE_GLES2_CMD_DECODER_UNITTEST_3_AUTOGEN_H_
 
@@ -61,6 +61,13 @@ void GpuScheduler::PutChanged() {
   if (!IsScheduled())
     return;
 
+  base::TimeTicks start_time = base::TimeTicks::Now();
+  if (!preempted_time_.is_null()) {
+    TRACE_COUNTER_ID1("gpu", "GpuScheduler::SchedulingLatencyUs", this,
+                      (start_time - preempted_time_).InMicroseconds());
+    preempted_time_ = base::TimeTicks();
+  }
+
   error::Error error = error::kNoError;
   while (!parser_->IsEmpty()) {
     DCHECK(IsScheduled());
@@ -86,6 +93,15 @@ void GpuScheduler::PutChanged() {
 
     if (unscheduled_count_ > 0)
       return;
+
+    if (time_slice_ > base::TimeDelta() && !parser_->IsEmpty()) {
+      base::TimeTicks now = base::TimeTicks::Now();
+      if (now - start_time >= time_slice_) {
+        TRACE_EVENT_INSTANT1("gpu", "GpuScheduler:Preempted", "this", this);
+        preempted_time_ = now;
+        return;
+      }
+    }
   }
 }
 
@@ -136,6 +152,10 @@ bool GpuScheduler::IsScheduled() {
   return unscheduled_count_ == 0;
 }
 
+void GpuScheduler::SetTimeSlice(base::TimeDelta time_slice) {
+  time_slice_ = time_slice;
+}
+
 bool GpuScheduler::HasMoreWork() {
   return !unschedule_fences_.empty() ||
          (decoder_ && decoder_->ProcessPendingQueries());
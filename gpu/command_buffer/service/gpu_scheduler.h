@@ -12,6 +12,7 @@
 #include "base/memory/linked_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/shared_memory.h"
+#include "base/time.h"
 #include "gpu/command_buffer/common/command_buffer.h"
 #include "gpu/command_buffer/service/cmd_buffer_engine.h"
 #include "gpu/command_buffer/service/cmd_parser.h"
@@ -52,6 +53,13 @@ class GPU_EXPORT GpuScheduler
   // Returns whether the scheduler needs to be polled again in the future.
   bool HasMoreWork();
 
+  // Sets how long PutChanged may keep processing commands before it returns
+  // early so that other command buffers get a turn. The check is made between
+  // commands. Zero, the default, processes until the buffer is empty or the
+  // scheduler is unscheduled. The caller is responsible for calling
+  // PutChanged again when it has yielded.
+  void SetTimeSlice(base::TimeDelta time_slice);
+
   // Sets a callback that is invoked just before scheduler is rescheduled.
   // Takes ownership of callback object.
   void SetScheduledCallback(const base::Closure& scheduled_callback);
@@ -105,6 +113,12 @@ class GPU_EXPORT GpuScheduler
   // account of a timeout.
   int rescheduled_count_;
 
+  base::TimeDelta time_slice_;
+
+  // When PutChanged last yielded because its time slice ran out, or null. Used
+  // to trace how long the command buffer waited to be resumed.
+  base::TimeTicks preempted_time_;
+
   // A factory for outstanding rescheduling tasks that is invalidated whenever
   // the scheduler is rescheduled.
   base::WeakPtrFactory<GpuScheduler> reschedule_task_factory_;
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "base/message_loop.h"
+#include "base/threading/platform_thread.h"
 #include "gpu/command_buffer/common/command_buffer_mock.h"
 #include "gpu/command_buffer/service/gpu_scheduler.h"
 #include "gpu/command_buffer/service/gles2_cmd_decoder.h"
@@ -157,6 +158,43 @@ TEST_F(GpuSchedulerTest, ProcessesTwoCommands) {
   scheduler_->PutChanged();
 }
 
+ACTION_P(SleepAndReturn, duration) {
+  base::PlatformThread::Sleep(duration);
+  return error::kNoError;
+}
+
+TEST_F(GpuSchedulerTest, YieldsWhenTimeSliceExpires) {
+  CommandHeader* header = reinterpret_cast<CommandHeader*>(&buffer_[0]);
+  header[0].command = 7;
+  header[0].size = 2;
+  buffer_[1] = 123;
+  header[2].command = 8;
+  header[2].size = 1;
+
+  CommandBuffer::State state;
+
+  state.put_offset = 3;
+  EXPECT_CALL(*command_buffer_, GetState())
+    .WillRepeatedly(Return(state));
+
+  scheduler_->SetTimeSlice(base::TimeDelta::FromMilliseconds(1));
+
+  // The first command uses up the whole time slice, so the second one waits
+  // for the next PutChanged.
+  EXPECT_CALL(*decoder_, DoCommand(7, 1, &buffer_[0]))
+    .WillOnce(SleepAndReturn(base::TimeDelta::FromMilliseconds(2)));
+  EXPECT_CALL(*command_buffer_, SetGetOffset(2));
+  scheduler_->PutChanged();
+  EXPECT_EQ(2, scheduler_->GetGetOffset());
+  EXPECT_TRUE(scheduler_->IsScheduled());
+
+  EXPECT_CALL(*decoder_, DoCommand(8, 0, &buffer_[2]))
+    .WillOnce(Return(error::kNoError));
+  EXPECT_CALL(*command_buffer_, SetGetOffset(3));
+  scheduler_->PutChanged();
+  EXPECT_EQ(3, scheduler_->GetGetOffset());
+}
+
 TEST_F(GpuSchedulerTest, SetsErrorCodeOnCommandBuffer) {
   CommandHeader* header = reinterpret_cast<CommandHeader*>(&buffer_[0]);
   header[0].command = 7;
@@ -13,6 +13,14 @@ const char kCompileShaderAlwaysSucceeds[]   = "compile-shader-always-succeeds";
 // Disable the GLSL translator.
 const char kDisableGLSLTranslator[]         = "disable-glsl-translator";
 
+// Disable the cache of linked program binaries.
+const char kDisableGpuProgramCache[]        = "disable-gpu-program-cache";
+
+// Perform texture uploads requested with GL_UNPACK_ASYNC_UPLOAD_CHROMIUM on a
+// separate thread.
+const char kEnableGpuAsyncTextureUploads[]  =
+    "enable-gpu-async-texture-uploads";
+
 // Turn on Logging GPU commands.
 const char kEnableGPUCommandLogging[]       = "enable-gpu-command-logging";
 
@@ -25,6 +33,8 @@ const char kEnforceGLMinimums[]             = "enforce-gl-minimums";
 const char* kGpuSwitches[] = {
   kCompileShaderAlwaysSucceeds,
   kDisableGLSLTranslator,
+  kDisableGpuProgramCache,
+  kEnableGpuAsyncTextureUploads,
   kEnableGPUCommandLogging,
   kEnableGPUDebugging,
   kEnforceGLMinimums,
@@ -0,0 +1,128 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gpu/command_buffer/service/program_cache.h"
+
+#include "base/logging.h"
+#include "base/sha1.h"
+#include "base/string_number_conversions.h"
+
+namespace gpu {
+namespace gles2 {
+
+namespace {
+
+// Appends |str| to |key| prefixed with its length so that the concatenation
+// of several strings is unambiguous.
+void AppendKeyPart(const std::string& str, std::string* key) {
+  key->append(base::Uint64ToString(str.size()));
+  key->push_back(':');
+  key->append(str);
+}
+
+}  // anonymous namespace
+
+ProgramCache::ProgramBinary::ProgramBinary()
+    : format(0) {
+}
+
+ProgramCache::ProgramBinary::~ProgramBinary() {
+}
+
+ProgramCache::ProgramCache(size_t max_size_bytes)
+    : max_size_bytes_(max_size_bytes),
+      binaries_(BinaryMap::NO_AUTO_EVICT),
+      size_bytes_(0) {
+}
+
+ProgramCache::~ProgramCache() {
+}
+
+// static
+std::string ProgramCache::ComputeKey(
+    const std::string& vertex_source,
+    const std::string& fragment_source,
+    const std::map<std::string, GLint>& bind_attrib_location_map,
+    const std::string& gl_info) {
+  std::string key;
+  AppendKeyPart(gl_info, &key);
+  AppendKeyPart(vertex_source, &key);
+  AppendKeyPart(fragment_source, &key);
+  for (std::map<std::string, GLint>::const_iterator it =
+           bind_attrib_location_map.begin();
+       it != bind_attrib_location_map.end(); ++it) {
+    AppendKeyPart(it->first, &key);
+    AppendKeyPart(base::IntToString(it->second), &key);
+  }
+  return base::SHA1HashString(key);
+}
+
+bool ProgramCache::LoadProgram(const std::string& key, GLuint program) {
+  ProgramBinary binary;
+  {
+    base::AutoLock auto_lock(lock_);
+    BinaryMap::iterator it = binaries_.Get(key);
+    if (it == binaries_.end())
+      return false;
+    binary = it->second;
+  }
+
+  glProgramBinary(program, binary.format, binary.data.data(),
+                  static_cast<GLsizei>(binary.data.size()));
+  GLint success = 0;
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (success == GL_TRUE)
+    return true;
+
+  // The driver no longer accepts this binary, typically because it has been
+  // updated. Drop it so that the relinked program replaces it.
+  base::AutoLock auto_lock(lock_);
+  BinaryMap::iterator it = binaries_.Peek(key);
+  if (it != binaries_.end()) {
+    size_bytes_ -= it->second.data.size();
+    binaries_.Erase(it);
+  }
+  return false;
+}
+
+void ProgramCache::SaveProgram(const std::string& key, GLuint program) {
+  GLint length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0 || static_cast<size_t>(length) > max_size_bytes_)
+    return;
+
+  ProgramBinary binary;
+  binary.data.resize(length);
+  GLsizei returned_length = 0;
+  glGetProgramBinary(program, length, &returned_length, &binary.format,
+                     &binary.data[0]);
+  if (returned_length <= 0 || returned_length > length)
+    return;
+  binary.data.resize(returned_length);
+
+  base::AutoLock auto_lock(lock_);
+  BinaryMap::iterator it = binaries_.Peek(key);
+  if (it != binaries_.end())
+    size_bytes_ -= it->second.data.size();
+  size_bytes_ += binary.data.size();
+  binaries_.Put(key, binary);
+  EvictLocked();
+}
+
+size_t ProgramCache::size_in_bytes() const {
+  base::AutoLock auto_lock(lock_);
+  return size_bytes_;
+}
+
+void ProgramCache::EvictLocked() {
+  lock_.AssertAcquired();
+  while (size_bytes_ > max_size_bytes_ && !binaries_.empty()) {
+    BinaryMap::reverse_iterator oldest = binaries_.rbegin();
+    size_bytes_ -= oldest->second.data.size();
+    binaries_.Erase(oldest);
+  }
+}
+
+}  // namespace gles2
+}  // namespace gpu
@@ -0,0 +1,84 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef GPU_COMMAND_BUFFER_SERVICE_PROGRAM_CACHE_H_
+#define GPU_COMMAND_BUFFER_SERVICE_PROGRAM_CACHE_H_
+
+#include <map>
+#include <string>
+#include "base/basictypes.h"
+#include "base/memory/mru_cache.h"
+#include "base/synchronization/lock.h"
+#include "gpu/command_buffer/service/gl_utils.h"
+#include "gpu/gpu_export.h"
+
+namespace gpu {
+namespace gles2 {
+
+// Caches the binaries of linked programs, as returned by glGetProgramBinary,
+// so that a program whose shaders and attribute bindings have been linked
+// before can be loaded with glProgramBinary instead of being linked again.
+//
+// The cache may be shared by every context in the process, so it is keyed
+// on everything that can change the binary: the shader sources passed to GL,
+// the attribute bindings and a string describing the GL implementation.
+class GPU_EXPORT ProgramCache {
+ public:
+  // The cache evicts its least recently used programs once the binaries it
+  // holds exceed |max_size_bytes|.
+  explicit ProgramCache(size_t max_size_bytes);
+  ~ProgramCache();
+
+  // Computes the key for a program made of the given shader sources and
+  // bound with |bind_attrib_location_map|. |gl_info| must identify the GL
+  // implementation and its configuration, e.g. GL_RENDERER and GL_VERSION.
+  static std::string ComputeKey(
+      const std::string& vertex_source,
+      const std::string& fragment_source,
+      const std::map<std::string, GLint>& bind_attrib_location_map,
+      const std::string& gl_info);
+
+  // Loads the binary cached under |key| into |program|. Returns true if
+  // |program| is now successfully linked. A binary the driver rejects is
+  // dropped from the cache.
+  bool LoadProgram(const std::string& key, GLuint program);
+
+  // Reads back the binary of the successfully linked |program| and caches it
+  // under |key|.
+  void SaveProgram(const std::string& key, GLuint program);
+
+  // Returns the total size of the cached binaries.
+  size_t size_in_bytes() const;
+
+ private:
+  struct ProgramBinary {
+    ProgramBinary();
+    ~ProgramBinary();
+
+    GLenum format;
+    std::string data;
+  };
+
+  typedef base::MRUCache<std::string, ProgramBinary> BinaryMap;
+
+  // Evicts the least recently used binaries until the cache fits in
+  // |max_size_bytes_|. |lock_| must be held.
+  void EvictLocked();
+
+  const size_t max_size_bytes_;
+
+  // Protects the members below.
+  mutable base::Lock lock_;
+
+  BinaryMap binaries_;
+
+  size_t size_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProgramCache);
+};
+
+}  // namespace gles2
+}  // namespace gpu
+
+#endif  // GPU_COMMAND_BUFFER_SERVICE_PROGRAM_CACHE_H_
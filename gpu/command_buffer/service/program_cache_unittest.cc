@@ -0,0 +1,137 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gpu/command_buffer/service/program_cache.h"
+
+#include <string.h>
+
+#include "base/memory/scoped_ptr.h"
+#include "gpu/command_buffer/common/gl_mock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::SetArgumentPointee;
+
+namespace gpu {
+namespace gles2 {
+
+namespace {
+
+ACTION_P2(CopyBinary, binary, length) {
+  memcpy(arg4, binary, length);
+}
+
+}  // anonymous namespace
+
+class ProgramCacheTest : public testing::Test {
+ public:
+  static const size_t kMaxSizeBytes = 16;
+  static const GLuint kProgramId = 123;
+  static const GLenum kBinaryFormat = 0x1234;
+
+  ProgramCacheTest()
+      : cache_(kMaxSizeBytes) {
+  }
+
+ protected:
+  virtual void SetUp() {
+    gl_.reset(new ::testing::StrictMock< ::gfx::MockGLInterface>());
+    ::gfx::GLInterface::SetGLInterface(gl_.get());
+  }
+
+  virtual void TearDown() {
+    ::gfx::GLInterface::SetGLInterface(NULL);
+    gl_.reset();
+  }
+
+  void ExpectSave(const char* binary, GLsizei length) {
+    EXPECT_CALL(*gl_, GetProgramiv(kProgramId, GL_PROGRAM_BINARY_LENGTH, _))
+        .WillOnce(SetArgumentPointee<2>(length))
+        .RetiresOnSaturation();
+    EXPECT_CALL(*gl_, GetProgramBinary(kProgramId, length, _, _, _))
+        .WillOnce(DoAll(SetArgumentPointee<2>(length),
+                        SetArgumentPointee<3>(kBinaryFormat),
+                        CopyBinary(binary, length)))
+        .RetiresOnSaturation();
+  }
+
+  void ExpectLoad(GLsizei length, GLint link_status) {
+    EXPECT_CALL(*gl_, ProgramBinary(kProgramId, kBinaryFormat, _, length))
+        .Times(1)
+        .RetiresOnSaturation();
+    EXPECT_CALL(*gl_, GetProgramiv(kProgramId, GL_LINK_STATUS, _))
+        .WillOnce(SetArgumentPointee<2>(link_status))
+        .RetiresOnSaturation();
+  }
+
+  // Use StrictMock to make 100% sure we know how GL will be called.
+  scoped_ptr< ::testing::StrictMock< ::gfx::MockGLInterface> > gl_;
+  ProgramCache cache_;
+};
+
+// GCC requires these declarations, but MSVC requires they not be present
+#ifndef COMPILER_MSVC
+const size_t ProgramCacheTest::kMaxSizeBytes;
+const GLuint ProgramCacheTest::kProgramId;
+const GLenum ProgramCacheTest::kBinaryFormat;
+#endif
+
+TEST_F(ProgramCacheTest, ComputeKey) {
+  std::map<std::string, GLint> bindings;
+  const std::string key = ProgramCache::ComputeKey("vs", "fs", bindings, "gl");
+  EXPECT_EQ(key, ProgramCache::ComputeKey("vs", "fs", bindings, "gl"));
+  EXPECT_NE(key, ProgramCache::ComputeKey("vsf", "s", bindings, "gl"));
+  EXPECT_NE(key, ProgramCache::ComputeKey("vs", "fs", bindings, "gl2"));
+  bindings["a_position"] = 1;
+  EXPECT_NE(key, ProgramCache::ComputeKey("vs", "fs", bindings, "gl"));
+}
+
+TEST_F(ProgramCacheTest, SaveAndLoad) {
+  EXPECT_FALSE(cache_.LoadProgram("key", kProgramId));
+
+  ExpectSave("binary", 6);
+  cache_.SaveProgram("key", kProgramId);
+  EXPECT_EQ(6u, cache_.size_in_bytes());
+
+  ExpectLoad(6, GL_TRUE);
+  EXPECT_TRUE(cache_.LoadProgram("key", kProgramId));
+  EXPECT_EQ(6u, cache_.size_in_bytes());
+}
+
+TEST_F(ProgramCacheTest, RejectedBinaryIsDropped) {
+  ExpectSave("binary", 6);
+  cache_.SaveProgram("key", kProgramId);
+
+  ExpectLoad(6, GL_FALSE);
+  EXPECT_FALSE(cache_.LoadProgram("key", kProgramId));
+  EXPECT_EQ(0u, cache_.size_in_bytes());
+  EXPECT_FALSE(cache_.LoadProgram("key", kProgramId));
+}
+
+TEST_F(ProgramCacheTest, EvictsLeastRecentlyUsed) {
+  ExpectSave("binary1", 7);
+  cache_.SaveProgram("key1", kProgramId);
+  ExpectSave("binary2", 7);
+  cache_.SaveProgram("key2", kProgramId);
+
+  // Touch key1 so that key2 is evicted by the next save.
+  ExpectLoad(7, GL_TRUE);
+  EXPECT_TRUE(cache_.LoadProgram("key1", kProgramId));
+
+  ExpectSave("binary3", 7);
+  cache_.SaveProgram("key3", kProgramId);
+  EXPECT_EQ(14u, cache_.size_in_bytes());
+  EXPECT_FALSE(cache_.LoadProgram("key2", kProgramId));
+
+  // Binaries larger than the whole cache are not read back at all.
+  EXPECT_CALL(*gl_, GetProgramiv(kProgramId, GL_PROGRAM_BINARY_LENGTH, _))
+      .WillOnce(SetArgumentPointee<2>(static_cast<GLint>(kMaxSizeBytes + 1)))
+      .RetiresOnSaturation();
+  cache_.SaveProgram("key4", kProgramId);
+  EXPECT_EQ(14u, cache_.size_in_bytes());
+}
+
+}  // namespace gles2
+}  // namespace gpu
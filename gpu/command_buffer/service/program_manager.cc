@@ -11,9 +11,11 @@
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/string_number_conversions.h"
+#include "base/string_util.h"
 #include "gpu/command_buffer/common/gles2_cmd_format.h"
 #include "gpu/command_buffer/common/gles2_cmd_utils.h"
 #include "gpu/command_buffer/service/gles2_cmd_decoder.h"
+#include "gpu/command_buffer/service/program_cache.h"
 
 namespace gpu {
 namespace gles2 {
@@ -239,6 +241,17 @@ void ProgramManager::ProgramInfo::Update() {
   valid_ = true;
 }
 
+// static
+const std::string& ProgramManager::ProgramInfo::GetShaderSourceForLink(
+    const ShaderManager::ShaderInfo* info) {
+  // The translated source is what was handed to glShaderSource unless the
+  // translator is disabled.
+  const std::string* source = info->translated_source();
+  if (!source)
+    source = info->source();
+  return source ? *source : EmptyString();
+}
+
 void ProgramManager::ProgramInfo::ExecuteBindAttribLocationCalls() {
   for (std::map<std::string, GLint>::const_iterator it =
            bind_attrib_location_map_.begin();
@@ -260,11 +273,28 @@ bool ProgramManager::ProgramInfo::Link() {
     return false;
   }
   ExecuteBindAttribLocationCalls();
+
+  ProgramCache* program_cache = manager_->program_cache_;
+  std::string cache_key;
+  if (program_cache) {
+    cache_key = ProgramCache::ComputeKey(
+        GetShaderSourceForLink(attached_shaders_[0]),
+        GetShaderSourceForLink(attached_shaders_[1]),
+        bind_attrib_location_map_,
+        manager_->gl_info_);
+    if (program_cache->LoadProgram(cache_key, service_id())) {
+      Update();
+      return true;
+    }
+  }
+
   glLinkProgram(service_id());
   GLint success = 0;
   glGetProgramiv(service_id(), GL_LINK_STATUS, &success);
   if (success == GL_TRUE) {
     Update();
+    if (program_cache)
+      program_cache->SaveProgram(cache_key, service_id());
   } else {
     UpdateLogInfo();
   }
@@ -682,7 +712,17 @@ static int uniform_random_offset_ = 3;
 ProgramManager::ProgramManager()
     : uniform_swizzle_(uniform_random_offset_++ % 15),
       program_info_count_(0),
-      have_context_(true) {
+      have_context_(true),
+      program_cache_(NULL) {
+}
+
+ProgramManager::ProgramManager(ProgramCache* program_cache,
+                               const std::string& gl_info)
+    : uniform_swizzle_(uniform_random_offset_++ % 15),
+      program_info_count_(0),
+      have_context_(true),
+      program_cache_(program_cache),
+      gl_info_(gl_info) {
 }
 
 ProgramManager::~ProgramManager() {
@@ -20,6 +20,8 @@
 namespace gpu {
 namespace gles2 {
 
+class ProgramCache;
+
 // Tracks the Programs.
 //
 // NOTE: To support shared resources an instance of this class will
@@ -218,6 +220,10 @@ class GPU_EXPORT ProgramManager {
     // Clears all the uniforms.
     void ClearUniforms(std::vector<uint8>* zero_buffer);
 
+    // Returns the source of |info| as it was passed to GL.
+    static const std::string& GetShaderSourceForLink(
+        const ShaderManager::ShaderInfo* info);
+
     // If long attribate names are mapped during shader translation, call
     // glBindAttribLocation() again with the mapped names.
     // This is called right before the glLink() call, but after shaders are
@@ -290,6 +296,10 @@ class GPU_EXPORT ProgramManager {
   };
 
   ProgramManager();
+  // Successfully linked programs are saved to, and linked programs loaded
+  // from, |program_cache| if it is not NULL. It must outlive this manager.
+  // |gl_info| identifies the GL implementation in the cache keys.
+  ProgramManager(ProgramCache* program_cache, const std::string& gl_info);
   ~ProgramManager();
 
   // Must call before destruction.
@@ -342,6 +352,12 @@ class GPU_EXPORT ProgramManager {
 
   bool have_context_;
 
+  // Cache of linked program binaries. Not owned; may be NULL.
+  ProgramCache* program_cache_;
+
+  // Describes the GL implementation for |program_cache_| keys.
+  std::string gl_info_;
+
   // Used to clear uniforms.
   std::vector<uint8> zero_;
 
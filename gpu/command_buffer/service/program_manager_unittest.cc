@@ -13,6 +13,7 @@
 #include "gpu/command_buffer/common/gles2_cmd_format.h"
 #include "gpu/command_buffer/service/common_decoder.h"
 #include "gpu/command_buffer/service/mocks.h"
+#include "gpu/command_buffer/service/program_cache.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 using ::gfx::MockGLInterface;
@@ -253,6 +254,16 @@ class ProgramManagerWithShaderTest : public testing::Test {
         GetProgramiv(service_id, GL_LINK_STATUS, _))
         .WillOnce(SetArgumentPointee<2>(1))
         .RetiresOnSaturation();
+    SetupProgramUpdate(attribs, num_attribs, uniforms, num_uniforms,
+                       service_id);
+  }
+
+  // Sets up the GL calls made to query a program after it has been linked.
+  void SetupProgramUpdate(AttribInfo* attribs, size_t num_attribs,
+                          UniformInfo* uniforms, size_t num_uniforms,
+                          GLuint service_id) {
+    InSequence s;
+
     EXPECT_CALL(*gl_,
         GetProgramiv(service_id, GL_INFO_LOG_LENGTH, _))
         .WillOnce(SetArgumentPointee<2>(0))
@@ -1028,7 +1039,69 @@ TEST_F(ProgramManagerWithShaderTest, BindAttribLocationConflicts) {
   EXPECT_TRUE(LinkAsExpected(program_info, false));
 }
 
-}  // namespace gles2
-}  // namespace gpu
+TEST_F(ProgramManagerWithShaderTest, LinkUsesProgramCache) {
+  const GLuint kClientProgram1Id = 1001;
+  const GLuint kServiceProgram1Id = 2001;
+  const GLuint kClientProgram2Id = 1002;
+  const GLuint kServiceProgram2Id = 2002;
+  const GLenum kBinaryFormat = 0x1234;
+  const char kBinary[] = "binary";
+  const GLsizei kBinaryLength = sizeof(kBinary);
+  ProgramCache program_cache(1024);
+  ProgramManager manager(&program_cache, "gl info");
+  ShaderManager::ShaderInfo* vshader = shader_manager_.GetShaderInfo(
+      kVertexShaderClientId);
+  ShaderManager::ShaderInfo* fshader = shader_manager_.GetShaderInfo(
+      kFragmentShaderClientId);
+  ASSERT_TRUE(vshader != NULL && fshader != NULL);
+  vshader->UpdateSource("vertex source");
+  fshader->UpdateSource("fragment source");
+
+  // The first link is done by GL and read back into the cache.
+  ProgramManager::ProgramInfo* program_info1 =
+      manager.CreateProgramInfo(kClientProgram1Id, kServiceProgram1Id);
+  ASSERT_TRUE(program_info1 != NULL);
+  EXPECT_TRUE(program_info1->AttachShader(&shader_manager_, vshader));
+  EXPECT_TRUE(program_info1->AttachShader(&shader_manager_, fshader));
+  SetupShader(kAttribs, kNumAttribs, kUniforms, kNumUniforms,
+              kServiceProgram1Id);
+  EXPECT_CALL(*gl_, GetProgramiv(kServiceProgram1Id,
+                                 GL_PROGRAM_BINARY_LENGTH, _))
+      .WillOnce(SetArgumentPointee<2>(kBinaryLength))
+      .RetiresOnSaturation();
+  EXPECT_CALL(*gl_, GetProgramBinary(kServiceProgram1Id, kBinaryLength,
+                                     _, _, _))
+      .WillOnce(DoAll(SetArgumentPointee<2>(kBinaryLength),
+                      SetArgumentPointee<3>(kBinaryFormat)))
+      .RetiresOnSaturation();
+  EXPECT_TRUE(program_info1->Link());
+  EXPECT_EQ(static_cast<size_t>(kBinaryLength),
+            program_cache.size_in_bytes());
+
+  // A program with the same shaders is loaded from the cache without being
+  // linked.
+  ProgramManager::ProgramInfo* program_info2 =
+      manager.CreateProgramInfo(kClientProgram2Id, kServiceProgram2Id);
+  ASSERT_TRUE(program_info2 != NULL);
+  EXPECT_TRUE(program_info2->AttachShader(&shader_manager_, vshader));
+  EXPECT_TRUE(program_info2->AttachShader(&shader_manager_, fshader));
+  {
+    InSequence s;
+    EXPECT_CALL(*gl_, ProgramBinary(kServiceProgram2Id, kBinaryFormat, _,
+                                    kBinaryLength))
+        .Times(1)
+        .RetiresOnSaturation();
+    EXPECT_CALL(*gl_, GetProgramiv(kServiceProgram2Id, GL_LINK_STATUS, _))
+        .WillOnce(SetArgumentPointee<2>(1))
+        .RetiresOnSaturation();
+    SetupProgramUpdate(kAttribs, kNumAttribs, kUniforms, kNumUniforms,
+                       kServiceProgram2Id);
+  }
+  EXPECT_TRUE(program_info2->Link());
+  EXPECT_TRUE(program_info2->IsValid());
 
+  manager.Destroy(false);
+}
 
+}  // namespace gles2
+}  // namespace gpu
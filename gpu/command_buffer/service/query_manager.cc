@@ -7,6 +7,7 @@
 #include "base/logging.h"
 #include "base/time.h"
 #include "gpu/command_buffer/common/gles2_cmd_format.h"
+#include "gpu/command_buffer/service/async_texture_uploader.h"
 #include "gpu/command_buffer/service/common_decoder.h"
 
 namespace gpu {
@@ -115,12 +116,70 @@ void CommandsIssuedQuery::Destroy(bool /* have_context */) {
   }
 }
 
+// Completes once every async texture upload issued before the query ended has
+// finished. Completes immediately if there are none.
+class AsyncPixelTransfersCompletedQuery : public QueryManager::Query {
+ public:
+  AsyncPixelTransfersCompletedQuery(
+      QueryManager* manager, GLenum target, int32 shm_id, uint32 shm_offset);
+  virtual ~AsyncPixelTransfersCompletedQuery();
+
+  virtual bool Begin() OVERRIDE;
+  virtual bool End(uint32 submit_count) OVERRIDE;
+  virtual bool Process() OVERRIDE;
+  virtual void Destroy(bool have_context) OVERRIDE;
+
+ private:
+  // The uploader's issued count when the query ended.
+  uint32 wait_count_;
+};
+
+AsyncPixelTransfersCompletedQuery::AsyncPixelTransfersCompletedQuery(
+      QueryManager* manager, GLenum target, int32 shm_id, uint32 shm_offset)
+    : Query(manager, target, shm_id, shm_offset),
+      wait_count_(0) {
+}
+
+AsyncPixelTransfersCompletedQuery::~AsyncPixelTransfersCompletedQuery() {
+}
+
+bool AsyncPixelTransfersCompletedQuery::Begin() {
+  return true;
+}
+
+bool AsyncPixelTransfersCompletedQuery::End(uint32 submit_count) {
+  AsyncTextureUploader* uploader = manager()->async_texture_uploader();
+  if (!uploader) {
+    MarkAsPending(submit_count);
+    return MarkAsCompleted(1);
+  }
+  wait_count_ = uploader->issued_count();
+  return AddToPendingQueue(submit_count);
+}
+
+bool AsyncPixelTransfersCompletedQuery::Process() {
+  AsyncTextureUploader* uploader = manager()->async_texture_uploader();
+  DCHECK(uploader);
+  // Compare as a difference so that the counters may wrap.
+  if (static_cast<int32>(uploader->completed_count() - wait_count_) < 0) {
+    return true;
+  }
+  return MarkAsCompleted(1);
+}
+
+void AsyncPixelTransfersCompletedQuery::Destroy(bool /* have_context */) {
+  if (!IsDeleted()) {
+    MarkAsDeleted();
+  }
+}
+
 QueryManager::QueryManager(
     CommonDecoder* decoder,
     bool use_arb_occlusion_query2_for_occlusion_query_boolean)
     : decoder_(decoder),
       use_arb_occlusion_query2_for_occlusion_query_boolean_(
           use_arb_occlusion_query2_for_occlusion_query_boolean),
+      async_texture_uploader_(NULL),
       query_count_(0) {
 }
 
@@ -148,6 +207,10 @@ QueryManager::Query* QueryManager::CreateQuery(
     case GL_COMMANDS_ISSUED_CHROMIUM:
       query = new CommandsIssuedQuery(this, target, shm_id, shm_offset);
       break;
+    case GL_ASYNC_PIXEL_TRANSFERS_COMPLETED_CHROMIUM:
+      query = new AsyncPixelTransfersCompletedQuery(
+          this, target, shm_id, shm_offset);
+      break;
     default: {
       GLuint service_id = 0;
       glGenQueriesARB(1, &service_id);
@@ -20,6 +20,8 @@ class CommonDecoder;
 
 namespace gles2 {
 
+class AsyncTextureUploader;
+
 // This class keeps track of the queries and their state
 // As Queries are not shared there is one QueryManager per context.
 class GPU_EXPORT QueryManager {
@@ -158,6 +160,15 @@ class GPU_EXPORT QueryManager {
   // True if there are pending queries.
   bool HavePendingQueries();
 
+  // The uploader GL_ASYNC_PIXEL_TRANSFERS_COMPLETED_CHROMIUM queries wait on.
+  // NULL until the decoder starts one.
+  AsyncTextureUploader* async_texture_uploader() const {
+    return async_texture_uploader_;
+  }
+  void set_async_texture_uploader(AsyncTextureUploader* uploader) {
+    async_texture_uploader_ = uploader;
+  }
+
  private:
   void StartTracking(Query* query);
   void StopTracking(Query* query);
@@ -180,6 +191,9 @@ class GPU_EXPORT QueryManager {
 
   bool use_arb_occlusion_query2_for_occlusion_query_boolean_;
 
+  // Not owned.
+  AsyncTextureUploader* async_texture_uploader_;
+
   // Counts the number of Queries allocated with 'this' as their manager.
   // Allows checking no Query will outlive this.
   unsigned query_count_;
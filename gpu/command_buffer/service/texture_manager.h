@@ -493,6 +493,11 @@ class GPU_EXPORT TextureManager {
     return num_uncleared_mips_ > 0;
   }
 
+  // Estimated number of bytes held by all textures this manager tracks.
+  uint32 mem_represented() const {
+    return mem_represented_;
+  }
+
   GLuint black_texture_id(GLenum target) const {
     switch (target) {
       case GL_SAMPLER_2D:
@@ -37,6 +37,11 @@ class GPU_EXPORT CommandBufferProxy : public gpu::CommandBuffer {
   virtual bool DiscardBackbuffer() = 0;
   virtual bool EnsureBackbuffer() = 0;
 
+  // Inserts a sync point after the commands flushed so far, and returns it.
+  // Another command buffer can wait on it with glWaitSyncPointCHROMIUM.
+  // Returns 0 on failure.
+  virtual uint32 InsertSyncPoint() = 0;
+
   // Register a callback to invoke whenever we recieve a new memory allocation.
   virtual void SetMemoryAllocationChangedCallback(
       const base::Callback<void(const GpuMemoryAllocationForRenderer&)>&
@@ -54,6 +54,10 @@ class IPC_EXPORT Channel : public Message::Sender {
     // This method is not called when a channel is closed normally.
     virtual void OnChannelError() {}
 
+    // Called after the messages that arrived in one read from the channel
+    // have all been passed to OnMessageReceived.
+    virtual void OnMessageBatchEnd() {}
+
 #if defined(OS_POSIX)
     // Called on the server side when a channel that listens for connections
     // denies an attempt to connect.
@@ -102,10 +106,14 @@ class IPC_EXPORT Channel : public Message::Sender {
   // just the process id (pid).  The message has a special routing_id
   // (MSG_ROUTING_NONE) and type (HELLO_MESSAGE_TYPE).
   enum {
-    HELLO_MESSAGE_TYPE = kuint16max  // Maximum value of message type (uint16),
-                                     // to avoid conflicting with normal
-                                     // message types, which are enumeration
-                                     // constants starting from 0.
+    HELLO_MESSAGE_TYPE = kuint16max,  // Maximum value of message type (uint16),
+                                      // to avoid conflicting with normal
+                                      // message types, which are enumeration
+                                      // constants starting from 0.
+    // Internal message whose payload is a shared memory handle holding the
+    // serialized contents of another message. See
+    // SetSharedMemoryTransferThreshold().
+    SHARED_MEMORY_MESSAGE_TYPE = kuint16max - 1
   };
 
   // The maximum message size in bytes. Attempting to receive a message of this
@@ -193,6 +201,15 @@ class IPC_EXPORT Channel : public Message::Sender {
   void ResetToAcceptingConnectionState();
 #endif  // defined(OS_POSIX) && !defined(OS_NACL)
 
+#if defined(OS_POSIX) && !defined(OS_NACL)
+  // Messages of at least |threshold| bytes that do not carry file descriptors
+  // are copied once into a shared memory segment, and only a small descriptor
+  // message is written to the socket. The receiver dispatches the message
+  // directly from the mapped segment. Zero, the default, disables this.
+  // Both ends of the channel always understand such messages.
+  void SetSharedMemoryTransferThreshold(size_t threshold);
+#endif
+
   // Returns true if a named server channel is initialized on the given channel
   // ID. Even if true, the server may have already accepted a connection.
   static bool IsNamedServerInitialized(const std::string& channel_id);
@@ -30,6 +30,7 @@
 #include "base/memory/singleton.h"
 #include "base/process_util.h"
 #include "base/rand_util.h"
+#include "base/shared_memory.h"
 #include "base/stl_util.h"
 #include "base/string_util.h"
 #include "base/synchronization/lock.h"
@@ -315,6 +316,7 @@ Channel::ChannelImpl::ChannelImpl(const IPC::ChannelHandle& channel_handle,
       remote_fd_pipe_(-1),
 #endif  // IPC_USES_READWRITE
       pipe_name_(channel_handle.name),
+      shared_memory_threshold_(0),
       must_unlink_(false) {
   memset(input_cmsg_buf_, 0, sizeof(input_cmsg_buf_));
   if (!CreatePipe(channel_handle)) {
@@ -630,6 +632,11 @@ bool Channel::ChannelImpl::Send(Message* message) {
   Logging::GetInstance()->OnSendMessage(message, "");
 #endif  // IPC_MESSAGE_LOG_ENABLED
 
+  if (shared_memory_threshold_ && message->size() >= shared_memory_threshold_ &&
+      message->file_descriptor_set()->empty()) {
+    message = MoveToSharedMemory(message);
+  }
+
   output_queue_.push(message);
   if (!is_blocked_on_write_ && !waiting_connect_) {
     return ProcessOutgoingMessages();
@@ -638,6 +645,30 @@ bool Channel::ChannelImpl::Send(Message* message) {
   return true;
 }
 
+Message* Channel::ChannelImpl::MoveToSharedMemory(Message* message) {
+  base::SharedMemory shared_memory;
+  if (!shared_memory.CreateAndMapAnonymous(message->size()))
+    return message;
+  memcpy(shared_memory.memory(), message->data(), message->size());
+
+  // The duplicated handle is closed once the descriptor has been sent.
+  base::SharedMemoryHandle handle;
+  if (!shared_memory.GiveToProcess(base::GetCurrentProcessHandle(), &handle))
+    return message;
+
+  scoped_ptr<Message> wrapper(new Message(MSG_ROUTING_NONE,
+                                          SHARED_MEMORY_MESSAGE_TYPE,
+                                          message->priority()));
+  if (!wrapper->WriteUInt32(message->size()) ||
+      !wrapper->WriteFileDescriptor(handle)) {
+    base::SharedMemory::CloseHandle(handle);
+    return message;
+  }
+
+  delete message;
+  return wrapper.release();
+}
+
 int Channel::ChannelImpl::GetClientFileDescriptor() {
   base::AutoLock lock(client_pipe_lock_);
   return client_pipe_;
@@ -1017,6 +1048,43 @@ bool Channel::ChannelImpl::WillDispatchInputMessage(Message* msg) {
   return true;
 }
 
+bool Channel::ChannelImpl::DispatchSharedMemoryMessage(const Message& msg) {
+  PickleIterator iter(msg);
+  uint32 size;
+  base::FileDescriptor descriptor;
+  if (!msg.ReadUInt32(&iter, &size) ||
+      !msg.ReadFileDescriptor(&iter, &descriptor)) {
+    LOG(ERROR) << "Malformed shared memory message";
+    return false;
+  }
+
+  // |shared_memory| takes ownership of the descriptor.
+  base::SharedMemory shared_memory(
+      base::SharedMemoryHandle(descriptor.fd, true), false);
+  if (size < sizeof(Message::Header) || size >= kMaximumMessageSize ||
+      !shared_memory.Map(size)) {
+    LOG(ERROR) << "Unable to map shared memory message of " << size
+               << " bytes";
+    return false;
+  }
+
+  // The embedded message is dispatched in place, without copying it out of
+  // the mapping. It can't carry descriptors nor be another control message.
+  const char* data = static_cast<const char*>(shared_memory.memory());
+  if (Message::FindNext(data, data + size) != data + size) {
+    LOG(ERROR) << "Truncated shared memory message";
+    return false;
+  }
+  Message m(data, size);
+  if (m.header()->num_fds || IsHelloMessage(m) || IsSharedMemoryMessage(m)) {
+    LOG(ERROR) << "Invalid message in shared memory";
+    return false;
+  }
+
+  listener()->OnMessageReceived(m);
+  return true;
+}
+
 bool Channel::ChannelImpl::DidEmptyInputBuffers() {
   // When the input data buffer is empty, the fds should be too. If this is
   // not the case, we probably have a rogue renderer which is trying to fill
@@ -1165,6 +1233,10 @@ void Channel::ResetToAcceptingConnectionState() {
   channel_impl_->ResetToAcceptingConnectionState();
 }
 
+void Channel::SetSharedMemoryTransferThreshold(size_t threshold) {
+  channel_impl_->SetSharedMemoryTransferThreshold(threshold);
+}
+
 // static
 bool Channel::IsNamedServerInitialized(const std::string& channel_id) {
   return ChannelImpl::IsNamedServerInitialized(channel_id);
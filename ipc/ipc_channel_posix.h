@@ -66,6 +66,9 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   bool HasAcceptedConnection() const;
   bool GetClientEuid(uid_t* client_euid) const;
   void ResetToAcceptingConnectionState();
+  void SetSharedMemoryTransferThreshold(size_t threshold) {
+    shared_memory_threshold_ = threshold;
+  }
   base::ProcessId peer_pid() const { return peer_pid_; }
   static bool IsNamedServerInitialized(const std::string& channel_id);
 #if defined(OS_LINUX)
@@ -82,6 +85,11 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   int GetHelloMessageProcId();
   void QueueHelloMessage();
 
+  // Returns a SHARED_MEMORY_MESSAGE_TYPE message carrying the contents of
+  // |message| and deletes |message|. Returns |message| itself if it cannot be
+  // moved to shared memory.
+  Message* MoveToSharedMemory(Message* message);
+
   // ChannelReader implementation.
   virtual ReadState ReadData(char* buffer,
                              int buffer_len,
@@ -89,6 +97,7 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   virtual bool WillDispatchInputMessage(Message* msg) OVERRIDE;
   virtual bool DidEmptyInputBuffers() OVERRIDE;
   virtual void HandleHelloMessage(const Message& msg) OVERRIDE;
+  virtual bool DispatchSharedMemoryMessage(const Message& msg) OVERRIDE;
 
 #if defined(IPC_USES_READWRITE)
   // Reads the next message from the fd_pipe_ and appends them to the
@@ -156,6 +165,10 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   // Messages to be sent are queued here.
   std::queue<Message*> output_queue_;
 
+  // Messages of at least this size are sent through shared memory. Zero
+  // disables the shared memory transport.
+  size_t shared_memory_threshold_;
+
   // We assume a worst case: kReadBufferSize bytes of messages, where each
   // message has no payload and a full complement of descriptors.
   static const size_t kMaxReadFDs =
@@ -90,6 +90,32 @@ class IPCChannelPosixTestListener : public IPC::Channel::Listener {
   bool quit_only_on_message_;
 };
 
+// Records the string payload of the first message it receives.
+class IPCChannelPosixPayloadListener : public IPC::Channel::Listener {
+ public:
+  IPCChannelPosixPayloadListener() : received_(false) {}
+  virtual ~IPCChannelPosixPayloadListener() {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+    EXPECT_TRUE(message.ReadString(&iter, &payload_));
+    received_ = true;
+    MessageLoopForIO::current()->QuitNow();
+    return true;
+  }
+
+  virtual void OnChannelError() OVERRIDE {
+    MessageLoopForIO::current()->QuitNow();
+  }
+
+  bool received() const { return received_; }
+  const std::string& payload() const { return payload_; }
+
+ private:
+  bool received_;
+  std::string payload_;
+};
+
 }  // namespace
 
 class IPCChannelPosixTest : public base::MultiProcessTest {
@@ -383,6 +409,34 @@ TEST_F(IPCChannelPosixTest, IsNamedServerInitialized) {
       kConnectionSocketTestName));
 }
 
+TEST_F(IPCChannelPosixTest, SharedMemoryTransfer) {
+  // Messages above the threshold travel through shared memory and must arrive
+  // intact, as must the ones below it.
+  IPCChannelPosixTestListener server_listener(true);
+  IPCChannelPosixPayloadListener client_listener;
+  const std::string kChannelName("IPCChannelPosixTest_SharedMemoryTransfer");
+  IPC::Channel server(kChannelName, IPC::Channel::MODE_SERVER,
+                      &server_listener);
+  ASSERT_TRUE(server.Connect());
+  IPC::Channel client(kChannelName, IPC::Channel::MODE_CLIENT,
+                      &client_listener);
+  ASSERT_TRUE(client.Connect());
+  server.SetSharedMemoryTransferThreshold(4096);
+
+  const size_t kSizes[] = { 16, 256 * 1024 };
+  for (size_t i = 0; i < arraysize(kSizes); ++i) {
+    std::string payload(kSizes[i], static_cast<char>('a' + i));
+    IPC::Message* message = new IPC::Message(0,  // routing_id
+                                             kQuitMessage,  // message type
+                                             IPC::Message::PRIORITY_NORMAL);
+    message->WriteString(payload);
+    ASSERT_TRUE(server.Send(message));
+    SpinRunLoop(TestTimeouts::action_timeout_ms());
+    ASSERT_TRUE(client_listener.received());
+    EXPECT_EQ(payload, client_listener.payload());
+  }
+}
+
 // A long running process that connects to us
 MULTIPROCESS_TEST_MAIN(IPCChannelPosixTestConnectionProc) {
   MessageLoopForIO message_loop;
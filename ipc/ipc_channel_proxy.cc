@@ -46,6 +46,7 @@ ChannelProxy::Context::Context(Channel::Listener* listener,
       listener_(listener),
       ipc_message_loop_(ipc_message_loop),
       channel_connected_called_(false),
+      batch_dispatch_(false),
       peer_pid_(base::kNullProcessId) {
 }
 
@@ -92,11 +93,20 @@ bool ChannelProxy::Context::OnMessageReceivedNoFilter(const Message& message) {
   // this thread is active.  That should be a reasonable assumption, but it
   // feels risky.  We may want to invent some more indirect way of referring to
   // a MessageLoop if this becomes a problem.
+  if (batch_dispatch_) {
+    pending_messages_.push_back(message);
+    return true;
+  }
   listener_message_loop_->PostTask(
       FROM_HERE, base::Bind(&Context::OnDispatchMessage, this, message));
   return true;
 }
 
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::OnMessageBatchEnd() {
+  PostPendingMessages();
+}
+
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnChannelConnected(int32 peer_pid) {
   // Add any pending filters.  This avoids a race condition where someone
@@ -117,6 +127,9 @@ void ChannelProxy::Context::OnChannelConnected(int32 peer_pid) {
 
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnChannelError() {
+  // Messages that were read before the error must reach the listener first.
+  PostPendingMessages();
+
   for (size_t i = 0; i < filters_.size(); ++i)
     filters_[i]->OnChannelError();
 
@@ -157,6 +170,8 @@ void ChannelProxy::Context::OnChannelClosed() {
   // We don't need the filters anymore.
   filters_.clear();
 
+  PostPendingMessages();
+
   channel_.reset();
 
   // Balance with the reference taken during startup.  This may result in
@@ -252,6 +267,29 @@ void ChannelProxy::Context::OnDispatchMessage(const Message& message) {
 #endif
 }
 
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::PostPendingMessages() {
+  if (pending_messages_.empty())
+    return;
+
+  std::vector<Message>* messages = new std::vector<Message>;
+  messages->swap(pending_messages_);
+  // See above comment about using listener_message_loop_ here.
+  listener_message_loop_->PostTask(
+      FROM_HERE, base::Bind(&Context::OnDispatchMessages, this,
+                            base::Owned(messages)));
+}
+
+// Called on the listener's thread
+void ChannelProxy::Context::OnDispatchMessages(
+    std::vector<Message>* messages) {
+  for (size_t i = 0; i < messages->size(); ++i)
+    OnDispatchMessage((*messages)[i]);
+
+  if (listener_)
+    listener_->OnMessageBatchEnd();
+}
+
 // Called on the listener's thread
 void ChannelProxy::Context::OnDispatchConnected() {
   if (channel_connected_called_)
@@ -280,6 +318,13 @@ ChannelProxy::ChannelProxy(const IPC::ChannelHandle& channel_handle,
   Init(channel_handle, mode, true);
 }
 
+ChannelProxy::ChannelProxy(Channel::Listener* listener,
+                           base::MessageLoopProxy* ipc_thread)
+    : context_(new Context(listener, ipc_thread)),
+      outgoing_message_filter_(NULL),
+      did_init_(false) {
+}
+
 ChannelProxy::ChannelProxy(Context* context)
     : context_(context),
       outgoing_message_filter_(NULL),
@@ -361,6 +406,11 @@ void ChannelProxy::RemoveFilter(MessageFilter* filter) {
                             make_scoped_refptr(filter)));
 }
 
+void ChannelProxy::EnableBatchDispatch() {
+  DCHECK(!did_init_);
+  context_->batch_dispatch_ = true;
+}
+
 void ChannelProxy::ClearIPCMessageLoop() {
   context()->ClearIPCMessageLoop();
 }
@@ -172,6 +172,12 @@ class IPC_EXPORT ChannelProxy : public Message::Sender {
     outgoing_message_filter_ = filter;
   }
 
+  // Makes the proxy hand the listener all of the messages that arrive in one
+  // read from the channel in a single task, followed by a call to the
+  // listener's OnMessageBatchEnd, instead of posting a task per message.
+  // Must be called before Init.
+  void EnableBatchDispatch();
+
   // Called to clear the pointer to the IPC message loop when it's going away.
   void ClearIPCMessageLoop();
 
@@ -206,6 +212,9 @@ class IPC_EXPORT ChannelProxy : public Message::Sender {
     // Dispatches a message on the listener thread.
     void OnDispatchMessage(const Message& message);
 
+    // Dispatches a batch of messages on the listener thread.
+    void OnDispatchMessages(std::vector<Message>* messages);
+
    protected:
     friend class base::RefCountedThreadSafe<Context>;
     virtual ~Context();
@@ -214,6 +223,7 @@ class IPC_EXPORT ChannelProxy : public Message::Sender {
     virtual bool OnMessageReceived(const Message& message) OVERRIDE;
     virtual void OnChannelConnected(int32 peer_pid) OVERRIDE;
     virtual void OnChannelError() OVERRIDE;
+    virtual void OnMessageBatchEnd() OVERRIDE;
 
     // Like OnMessageReceived but doesn't try the filters.
     bool OnMessageReceivedNoFilter(const Message& message);
@@ -249,6 +259,10 @@ class IPC_EXPORT ChannelProxy : public Message::Sender {
     void OnDispatchConnected();
     void OnDispatchError();
 
+    // Posts the messages queued for batch dispatch to the listener thread.
+    // Called on the IPC thread.
+    void PostPendingMessages();
+
     scoped_refptr<base::MessageLoopProxy> listener_message_loop_;
     Channel::Listener* listener_;
 
@@ -259,6 +273,12 @@ class IPC_EXPORT ChannelProxy : public Message::Sender {
     std::string channel_id_;
     bool channel_connected_called_;
 
+    // Set by EnableBatchDispatch before the channel is created. When true,
+    // unfiltered messages are queued in |pending_messages_| on the IPC thread
+    // until the end of the read they arrived in.
+    bool batch_dispatch_;
+    std::vector<Message> pending_messages_;
+
     // Holds filters between the AddFilter call on the listerner thread and the
     // IPC thread when they're added to filters_.
     std::vector<scoped_refptr<MessageFilter> > pending_filters_;
@@ -40,6 +40,16 @@ bool ChannelReader::IsHelloMessage(const Message& m) const {
          m.type() == Channel::HELLO_MESSAGE_TYPE;
 }
 
+bool ChannelReader::IsSharedMemoryMessage(const Message& m) const {
+  return m.routing_id() == MSG_ROUTING_NONE &&
+         m.type() == Channel::SHARED_MEMORY_MESSAGE_TYPE;
+}
+
+bool ChannelReader::DispatchSharedMemoryMessage(const Message& msg) {
+  LOG(ERROR) << "Unexpected shared memory message";
+  return false;
+}
+
 bool ChannelReader::DispatchInputData(const char* input_data,
                                       int input_data_len) {
   const char* p;
@@ -62,6 +72,7 @@ bool ChannelReader::DispatchInputData(const char* input_data,
   }
 
   // Dispatch all complete messages in the data buffer.
+  bool dispatched = false;
   while (p < end) {
     const char* message_tail = Message::FindNext(p, end);
     if (message_tail) {
@@ -70,10 +81,16 @@ bool ChannelReader::DispatchInputData(const char* input_data,
       if (!WillDispatchInputMessage(&m))
         return false;
 
-      if (IsHelloMessage(m))
+      if (IsHelloMessage(m)) {
         HandleHelloMessage(m);
-      else
+      } else if (IsSharedMemoryMessage(m)) {
+        if (!DispatchSharedMemoryMessage(m))
+          return false;
+        dispatched = true;
+      } else {
         listener_->OnMessageReceived(m);
+        dispatched = true;
+      }
       p = message_tail;
     } else {
       // Last message is partial.
@@ -81,8 +98,25 @@ bool ChannelReader::DispatchInputData(const char* input_data,
     }
   }
 
-  // Save any partial data in the overflow buffer.
-  input_overflow_buf_.assign(p, end - p);
+  if (dispatched)
+    listener_->OnMessageBatchEnd();
+
+  // Save any partial data in the overflow buffer. When it is already there,
+  // only drop what was dispatched, keeping the buffer's storage.
+  if (input_overflow_buf_.empty())
+    input_overflow_buf_.assign(p, end - p);
+  else
+    input_overflow_buf_.erase(0, p - input_overflow_buf_.data());
+
+  // Once the header of the partial message is in, make room for all of it
+  // rather than letting the buffer double its way up to the message size.
+  size_t message_size = 0;
+  if (Message::PeekNext(input_overflow_buf_.data(),
+                        input_overflow_buf_.data() + input_overflow_buf_.size(),
+                        &message_size) &&
+      message_size <= Channel::kMaximumMessageSize) {
+    input_overflow_buf_.reserve(message_size);
+  }
 
   if (input_overflow_buf_.empty() && !DidEmptyInputBuffers())
     return false;
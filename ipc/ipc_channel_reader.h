@@ -79,6 +79,15 @@ class ChannelReader {
   // Handles the first message sent over the pipe which contains setup info.
   virtual void HandleHelloMessage(const Message& msg) = 0;
 
+  // Dispatches the message embedded in a SHARED_MEMORY_MESSAGE_TYPE message.
+  // Returns false on channel error. The default implementation rejects such
+  // messages, for platforms that cannot receive them.
+  virtual bool DispatchSharedMemoryMessage(const Message& msg);
+
+  // Returns true if the given message carries another message in shared
+  // memory.
+  bool IsSharedMemoryMessage(const Message& m) const;
+
  private:
   // Takes the given data received from the IPC channel and dispatches any
   // fully completed messages.
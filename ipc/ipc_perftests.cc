@@ -0,0 +1,191 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop.h"
+#include "base/perftimer.h"
+#include "base/stringprintf.h"
+#include "base/threading/thread.h"
+#include "base/time.h"
+#include "ipc/ipc_channel.h"
+#include "ipc/ipc_channel_proxy.h"
+#include "ipc/ipc_message.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// The sender writes this many small messages back to back, as a renderer
+// does with input acks and resource load updates, and waits for the burst to
+// be acknowledged before sending the next one.
+const int kBurstSize = 50;
+const int kMessages = 100000;
+
+// Sync-style round trips: every message is acknowledged before the next one
+// is sent.
+const int kRoundTrips = 20000;
+
+const uint32 kDataMessageType = 1;
+const uint32 kAckMessageType = 2;
+
+// Owns the child end of the channel on its own IO thread, standing in for
+// the renderer.
+class BurstSender : public IPC::Channel::Listener {
+ public:
+  BurstSender(int burst_size, int bursts)
+      : burst_size_(burst_size),
+        bursts_left_(bursts) {}
+
+  // Called on the sender thread.
+  void Start(const std::string& channel_name) {
+    channel_.reset(new IPC::Channel(channel_name, IPC::Channel::MODE_CLIENT,
+                                    this));
+    CHECK(channel_->Connect());
+    SendBurst();
+  }
+
+  // Called on the sender thread.
+  void Stop() {
+    channel_.reset();
+  }
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    DCHECK_EQ(kAckMessageType, message.type());
+    SendBurst();
+    return true;
+  }
+
+ private:
+  void SendBurst() {
+    if (bursts_left_ == 0)
+      return;
+    --bursts_left_;
+    for (int i = 0; i < burst_size_; ++i) {
+      IPC::Message* message = new IPC::Message(
+          MSG_ROUTING_NONE, kDataMessageType, IPC::Message::PRIORITY_NORMAL);
+      message->WriteInt(i);
+      channel_->Send(message);
+    }
+  }
+
+  scoped_ptr<IPC::Channel> channel_;
+  const int burst_size_;
+  int bursts_left_;
+};
+
+// Receives the messages on the listener thread of a ChannelProxy, standing in
+// for the browser's UI thread.
+class BurstReceiver : public IPC::Channel::Listener {
+ public:
+  BurstReceiver(int burst_size, int messages)
+      : sender_(NULL),
+        burst_size_(burst_size),
+        expected_messages_(messages),
+        messages_(0),
+        batches_(0) {}
+
+  void set_sender(IPC::Message::Sender* sender) { sender_ = sender; }
+  int batches() const { return batches_; }
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    DCHECK_EQ(kDataMessageType, message.type());
+    ++messages_;
+    if (messages_ == expected_messages_) {
+      MessageLoop::current()->Quit();
+    } else if (messages_ % burst_size_ == 0) {
+      sender_->Send(new IPC::Message(
+          MSG_ROUTING_NONE, kAckMessageType, IPC::Message::PRIORITY_NORMAL));
+    }
+    return true;
+  }
+
+  virtual void OnMessageBatchEnd() OVERRIDE {
+    ++batches_;
+  }
+
+ private:
+  IPC::Message::Sender* sender_;
+  const int burst_size_;
+  const int expected_messages_;
+  int messages_;
+  int batches_;
+};
+
+class IPCChannelProxyPerfTest : public testing::Test {
+ protected:
+  // Sends |messages| from a client thread to a ChannelProxy, in bursts of
+  // |burst_size| that are each acknowledged, and reports how many messages
+  // the listener thread dispatches per second.
+  void RunThroughputTest(int burst_size,
+                         int messages,
+                         bool batch_dispatch,
+                         const char* name) {
+    std::vector<double> samples;
+    std::vector<double> task_samples;
+    for (int run = 0; run < GetPerfRepetitions(); ++run) {
+      base::Thread::Options options;
+      options.message_loop_type = MessageLoop::TYPE_IO;
+      base::Thread ipc_thread("IPC thread");
+      ASSERT_TRUE(ipc_thread.StartWithOptions(options));
+      base::Thread sender_thread("Sender thread");
+      ASSERT_TRUE(sender_thread.StartWithOptions(options));
+
+      // Each run gets its own channel so that no state carries over.
+      std::string channel_name = base::StringPrintf("%s_%d", name, run);
+      BurstReceiver receiver(burst_size, messages);
+      BurstSender sender(burst_size, messages / burst_size);
+      {
+        IPC::ChannelProxy proxy(&receiver, ipc_thread.message_loop_proxy());
+        if (batch_dispatch)
+          proxy.EnableBatchDispatch();
+        proxy.Init(channel_name, IPC::Channel::MODE_SERVER, true);
+        receiver.set_sender(&proxy);
+
+        base::TimeTicks start = base::TimeTicks::Now();
+        sender_thread.message_loop()->PostTask(
+            FROM_HERE, base::Bind(&BurstSender::Start,
+                                  base::Unretained(&sender), channel_name));
+        MessageLoop::current()->Run();
+        base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+        samples.push_back(messages / elapsed.InSecondsF());
+        task_samples.push_back(receiver.batches());
+
+        sender_thread.message_loop()->PostTask(
+            FROM_HERE, base::Bind(&BurstSender::Stop,
+                                  base::Unretained(&sender)));
+        sender_thread.Stop();
+      }
+      ipc_thread.Stop();
+    }
+
+    LogPerfResultSamples(name, samples, "messages/s");
+    if (batch_dispatch) {
+      LogPerfResultSamples((std::string(name) + "_tasks").c_str(),
+                           task_samples, "tasks");
+    }
+  }
+
+ private:
+  MessageLoop message_loop_;
+};
+
+}  // namespace
+
+TEST_F(IPCChannelProxyPerfTest, SmallMessagesPerTask) {
+  RunThroughputTest(kBurstSize, kMessages, false,
+                    "IPC_small_messages_unbatched");
+}
+
+TEST_F(IPCChannelProxyPerfTest, SmallMessagesBatched) {
+  RunThroughputTest(kBurstSize, kMessages, true,
+                    "IPC_small_messages_batched");
+}
+
+TEST_F(IPCChannelProxyPerfTest, RoundTrips) {
+  RunThroughputTest(1, kRoundTrips, false, "IPC_round_trips");
+}
@@ -285,6 +285,11 @@ WaitableEvent* SyncChannel::SyncContext::GetSendDoneEvent() {
   return deserializers_.back().done_event;
 }
 
+size_t SyncChannel::SyncContext::GetPendingSendCount() {
+  base::AutoLock auto_lock(deserializers_lock_);
+  return deserializers_.size();
+}
+
 WaitableEvent* SyncChannel::SyncContext::GetDispatchEvent() {
   return received_sync_msgs_->dispatch_event();
 }
@@ -435,7 +440,10 @@ bool SyncChannel::SendWithTimeout(Message* message, int timeout_ms) {
   SyncMessage* sync_msg = static_cast<SyncMessage*>(message);
   context->Push(sync_msg);
   int message_id = SyncMessage::GetMessageId(*sync_msg);
+  uint32 message_type = sync_msg->type();
   WaitableEvent* pump_messages_event = sync_msg->pump_messages_event();
+  size_t depth = context->GetPendingSendCount();
+  TimeTicks send_start = TimeTicks::Now();
 
   ChannelProxy::Send(message);
 
@@ -451,14 +459,18 @@ bool SyncChannel::SendWithTimeout(Message* message, int timeout_ms) {
 
   // Wait for reply, or for any other incoming synchronous messages.
   // *this* might get deleted, so only call static functions at this point.
-  WaitForReply(context, pump_messages_event);
+  TimeDelta nested_time = WaitForReply(context, pump_messages_event);
+  SyncMessage::RecordSendTimes(message_type, TimeTicks::Now() - send_start,
+                               nested_time, depth);
 
   return context->Pop();
 }
 
-void SyncChannel::WaitForReply(
+TimeDelta SyncChannel::WaitForReply(
     SyncContext* context, WaitableEvent* pump_messages_event) {
+  TimeTicks dispatch_start = TimeTicks::Now();
   context->DispatchMessages();
+  TimeDelta nested_time = TimeTicks::Now() - dispatch_start;
   while (true) {
     WaitableEvent* objects[] = {
       context->GetDispatchEvent(),
@@ -472,15 +484,21 @@ void SyncChannel::WaitForReply(
       // We're waiting for a reply, but we received a blocking synchronous
       // call.  We must process it or otherwise a deadlock might occur.
       context->GetDispatchEvent()->Reset();
+      dispatch_start = TimeTicks::Now();
       context->DispatchMessages();
+      nested_time += TimeTicks::Now() - dispatch_start;
       continue;
     }
 
-    if (result == 2 /* pump_messages_event */)
+    if (result == 2 /* pump_messages_event */) {
+      dispatch_start = TimeTicks::Now();
       WaitForReplyWithNestedMessageLoop(context);  // Run a nested message loop.
+      nested_time += TimeTicks::Now() - dispatch_start;
+    }
 
     break;
   }
+  return nested_time;
 }
 
 void SyncChannel::WaitForReplyWithNestedMessageLoop(SyncContext* context) {
@@ -135,6 +135,9 @@ class IPC_EXPORT SyncChannel : public ChannelProxy,
     // process shut down.
     base::WaitableEvent* GetSendDoneEvent();
 
+    // Returns the number of sync sends on this channel waiting for a reply.
+    size_t GetPendingSendCount();
+
     // Returns an event that's set when an incoming message that's not the reply
     // needs to get dispatched (by calling SyncContext::DispatchMessages).
     base::WaitableEvent* GetDispatchEvent();
@@ -204,7 +207,9 @@ class IPC_EXPORT SyncChannel : public ChannelProxy,
 
   // Both these functions wait for a reply, timeout or process shutdown.  The
   // latter one also runs a nested message loop in the meantime.
-  static void WaitForReply(
+  // WaitForReply returns the time spent dispatching incoming messages and in
+  // the nested message loop while waiting.
+  static base::TimeDelta WaitForReply(
       SyncContext* context, base::WaitableEvent* pump_messages_event);
 
   // Runs a nested message loop until a reply arrives, times out, or the process
@@ -12,7 +12,11 @@
 #include "base/atomic_sequence_num.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/metrics/histogram.h"
+#include "base/stringprintf.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/time.h"
+#include "ipc/ipc_message_utils.h"
 #include "ipc/ipc_sync_message.h"
 
 namespace {
@@ -137,6 +141,35 @@ bool SyncMessage::WriteSyncHeader(Message* msg, const SyncHeader& header) {
   return true;
 }
 
+// static
+void SyncMessage::RecordSendTimes(uint32 type,
+                                  base::TimeDelta blocked_time,
+                                  base::TimeDelta nested_time,
+                                  size_t depth) {
+  // Same as IPC_MESSAGE_ID_CLASS, which lives in a header that is meant to be
+  // included by message definitions only.
+  int message_class = static_cast<int>(type >> 16);
+  UMA_HISTOGRAM_ENUMERATION("IPC.SyncSend.MessageClass", message_class,
+                            LastIPCMsgStart);
+  UMA_HISTOGRAM_TIMES("IPC.SyncSend.BlockedTime", blocked_time);
+  UMA_HISTOGRAM_TIMES("IPC.SyncSend.NestedDispatchTime", nested_time);
+  UMA_HISTOGRAM_COUNTS_100("IPC.SyncSend.Depth", static_cast<int>(depth));
+
+  // One histogram per message class, so that chrome://histograms shows which
+  // sync messages the time goes to. Like the histogram macros, the pointers
+  // are cached without locking; a race only repeats the lookup.
+  if (message_class >= LastIPCMsgStart)
+    return;
+  static base::Histogram* class_histograms[LastIPCMsgStart];
+  base::Histogram*& class_histogram = class_histograms[message_class];
+  if (!class_histogram) {
+    class_histogram = base::Histogram::FactoryTimeGet(
+        base::StringPrintf("IPC.SyncSend.BlockedTime.Class%d", message_class),
+        base::TimeDelta::FromMilliseconds(1), base::TimeDelta::FromSeconds(10),
+        50, base::Histogram::kNoFlags);
+  }
+  class_histogram->AddTime(blocked_time);
+}
 
 bool MessageReplyDeserializer::SerializeOutputParameters(const Message& msg) {
   return SerializeOutputParameters(msg, SyncMessage::GetDataIterator(&msg));
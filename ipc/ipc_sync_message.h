@@ -15,6 +15,7 @@
 #include "ipc/ipc_message.h"
 
 namespace base {
+class TimeDelta;
 class WaitableEvent;
 }
 
@@ -69,6 +70,15 @@ class IPC_EXPORT SyncMessage : public Message {
   // Generates a reply message to the given message.
   static Message* GenerateReply(const Message* msg);
 
+  // Records a completed sync send of a message of |type| in the IPC.SyncSend
+  // histograms. |blocked_time| is how long the sending thread waited for the
+  // reply, |nested_time| is the part of it spent dispatching other messages,
+  // and |depth| is the number of sync sends outstanding, including this one.
+  static void RecordSendTimes(uint32 type,
+                              base::TimeDelta blocked_time,
+                              base::TimeDelta nested_time,
+                              size_t depth);
+
  private:
   struct SyncHeader {
     // unique ID (unique per sender)
@@ -9,6 +9,7 @@
 #include "base/logging.h"
 #include "base/message_loop_proxy.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/time.h"
 #include "ipc/ipc_sync_message.h"
 
 using base::MessageLoopProxy;
@@ -36,12 +37,14 @@ bool SyncMessageFilter::Send(Message* message) {
     return true;
   }
 
+  uint32 message_type = message->type();
   base::WaitableEvent done_event(true, false);
   PendingSyncMsg pending_message(
       SyncMessage::GetMessageId(*message),
       reinterpret_cast<SyncMessage*>(message)->GetReplyDeserializer(),
       &done_event);
 
+  size_t depth;
   {
     base::AutoLock auto_lock(lock_);
     // Can't use this class on the main thread or else it can lead to deadlocks.
@@ -49,13 +52,19 @@ bool SyncMessageFilter::Send(Message* message) {
     DCHECK(MessageLoopProxy::current() != listener_loop_);
     DCHECK(MessageLoopProxy::current() != io_loop_);
     pending_sync_messages_.insert(&pending_message);
+    depth = pending_sync_messages_.size();
   }
 
+  base::TimeTicks send_start = base::TimeTicks::Now();
   io_loop_->PostTask(
       FROM_HERE, base::Bind(&SyncMessageFilter::SendOnIOThread, this, message));
 
   base::WaitableEvent* events[2] = { shutdown_event_, &done_event };
   base::WaitableEvent::WaitMany(events, 2);
+  // Nothing is dispatched on this thread while it waits.
+  SyncMessage::RecordSendTimes(message_type,
+                               base::TimeTicks::Now() - send_start,
+                               base::TimeDelta(), depth);
 
   {
     base::AutoLock auto_lock(lock_);
@@ -395,6 +395,89 @@ TEST_F(IPCChannelTest, SendMessageInChannelConnected) {
   base::CloseProcessHandle(process_handle);
 }
 
+// Counts the messages and batches a ChannelProxy dispatches, quitting once
+// |expected_messages| have arrived.
+class BatchCountingListener : public IPC::Channel::Listener {
+ public:
+  explicit BatchCountingListener(int expected_messages)
+      : expected_messages_(expected_messages),
+        messages_(0),
+        batches_(0),
+        messages_in_batch_(0),
+        in_order_(true) {
+  }
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    IPC::MessageIterator iter(message);
+    if (iter.NextInt() != messages_)
+      in_order_ = false;
+    ++messages_;
+    ++messages_in_batch_;
+    return true;
+  }
+
+  virtual void OnMessageBatchEnd() OVERRIDE {
+    EXPECT_LT(0, messages_in_batch_);
+    messages_in_batch_ = 0;
+    ++batches_;
+    if (messages_ == expected_messages_)
+      MessageLoop::current()->Quit();
+  }
+
+  virtual void OnChannelError() OVERRIDE {
+    MessageLoop::current()->Quit();
+  }
+
+  int messages() const { return messages_; }
+  int batches() const { return batches_; }
+  bool in_order() const { return in_order_; }
+
+ private:
+  int expected_messages_;
+  int messages_;
+  int batches_;
+  int messages_in_batch_;
+  bool in_order_;
+};
+
+// Messages read together are dispatched to the listener together, in order,
+// and each batch is followed by OnMessageBatchEnd.
+TEST_F(IPCChannelTest, ChannelProxyBatchDispatch) {
+  const int kMessages = 100;
+  const char kChannel[] = "B5";
+  BatchCountingListener listener(kMessages);
+  BatchCountingListener client_listener(0);
+
+  base::Thread thread("ChannelProxyBatchServer");
+  base::Thread::Options options;
+  options.message_loop_type = MessageLoop::TYPE_IO;
+  thread.StartWithOptions(options);
+  {
+    IPC::ChannelProxy proxy(&listener, thread.message_loop_proxy());
+    proxy.EnableBatchDispatch();
+    proxy.Init(kChannel, IPC::Channel::MODE_SERVER, true);
+
+    // The client end runs on this thread, so all of its messages are written
+    // before the listener sees any of them.
+    IPC::Channel client(kChannel, IPC::Channel::MODE_CLIENT,
+                        &client_listener);
+    ASSERT_TRUE(client.Connect());
+    for (int i = 0; i < kMessages; ++i) {
+      IPC::Message* message = new IPC::Message(0, 2,
+                                               IPC::Message::PRIORITY_NORMAL);
+      message->WriteInt(i);
+      client.Send(message);
+    }
+
+    MessageLoop::current()->Run();
+
+    EXPECT_EQ(kMessages, listener.messages());
+    EXPECT_TRUE(listener.in_order());
+    EXPECT_LE(1, listener.batches());
+  }
+  thread.Stop();
+}
+
 MULTIPROCESS_TEST_MAIN(RunTestClient) {
   MessageLoopForIO main_message_loop;
   MyChannelListener channel_listener;
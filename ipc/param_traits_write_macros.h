@@ -25,8 +25,11 @@
 #undef IPC_STRUCT_TRAITS_MEMBER
 #undef IPC_STRUCT_TRAITS_PARENT
 #undef IPC_STRUCT_TRAITS_END
+// Most structs serialize to about their in-memory size, so reserving that up
+// front saves growing the message once per few fields.
 #define IPC_STRUCT_TRAITS_BEGIN(struct_name) \
-  void ParamTraits<struct_name>::Write(Message* m, const param_type& p) {
+  void ParamTraits<struct_name>::Write(Message* m, const param_type& p) { \
+    m->Reserve(sizeof(param_type));
 #define IPC_STRUCT_TRAITS_MEMBER(name) WriteParam(m, p.name);
 #define IPC_STRUCT_TRAITS_PARENT(type) ParamTraits<type>::Write(m, p);
 #define IPC_STRUCT_TRAITS_END() }
@@ -33,12 +33,18 @@ int PushNotificationsListenTask::ProcessStart() {
 }
 
 int PushNotificationsListenTask::ProcessResponse() {
-  const buzz::XmlElement* stanza = NextStanza();
-  if (stanza == NULL) {
-    return STATE_BLOCKED;
+  // Drain every queued stanza in one pass so that a burst of notifications
+  // doesn't cost a trip through the task runner per stanza.
+  for (const buzz::XmlElement* stanza = NextStanza(); stanza != NULL;
+       stanza = NextStanza()) {
+    ProcessStanza(*stanza);
   }
+  return STATE_BLOCKED;
+}
 
-  VLOG(1) << "Received stanza " << XmlElementToString(*stanza);
+void PushNotificationsListenTask::ProcessStanza(
+    const buzz::XmlElement& stanza) {
+  VLOG(1) << "Received stanza " << XmlElementToString(stanza);
 
   // The push notifications service does not need us to acknowledge receipt of
   // the notification to the buzz server.
@@ -58,7 +64,7 @@ int PushNotificationsListenTask::ProcessResponse() {
   const buzz::QName kQnChannel(buzz::STR_EMPTY, "channel");
   const buzz::QName kQnData(kPushNotificationsNamespace, "data");
 
-  const buzz::XmlElement* push_element = stanza->FirstNamed(kQnPush);
+  const buzz::XmlElement* push_element = stanza.FirstNamed(kQnPush);
   if (push_element) {
     Notification notification;
     notification.channel = push_element->Attr(kQnChannel);
@@ -76,9 +82,8 @@ int PushNotificationsListenTask::ProcessResponse() {
     delegate_->OnNotificationReceived(notification);
   } else {
     LOG(WARNING) << "No push element found in stanza "
-                 << XmlElementToString(*stanza);
+                 << XmlElementToString(stanza);
   }
-  return STATE_RESPONSE;
 }
 
 bool PushNotificationsListenTask::HandleStanza(const buzz::XmlElement* stanza) {
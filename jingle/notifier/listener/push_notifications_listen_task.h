@@ -43,6 +43,8 @@ class PushNotificationsListenTask : public buzz::XmppTask {
   virtual bool HandleStanza(const buzz::XmlElement* stanza) OVERRIDE;
 
  private:
+  // Extracts the notification from |stanza| and passes it to the delegate.
+  void ProcessStanza(const buzz::XmlElement& stanza);
   bool IsValidNotification(const buzz::XmlElement* stanza);
 
   Delegate* delegate_;
@@ -9,6 +9,7 @@
 #include "base/bind.h"
 #include "base/compiler_specific.h"
 #include "base/message_loop.h"
+#include "base/threading/platform_thread.h"
 #include "base/time.h"
 #include "media/audio/audio_io.h"
 #include "media/audio/audio_output_proxy.h"
@@ -20,6 +21,10 @@ AudioOutputMixer::AudioOutputMixer(AudioManager* audio_manager,
                                    const AudioParameters& params,
                                    const base::TimeDelta& close_delay)
     : AudioOutputDispatcher(audio_manager, params),
+      playing_(false),
+      command_write_index_(0),
+      command_read_index_(0),
+      callback_count_(0),
       ALLOW_THIS_IN_INITIALIZER_LIST(weak_this_(this)),
       close_timer_(FROM_HERE,
                    close_delay,
@@ -28,6 +33,8 @@ AudioOutputMixer::AudioOutputMixer(AudioManager* audio_manager,
       pending_bytes_(0) {
   // TODO(enal): align data.
   mixer_data_.reset(new uint8[params_.GetBytesPerBuffer()]);
+  mix_buffer_.reset(new float[params_.GetBytesPerBuffer() /
+                              (params_.bits_per_sample() >> 3)]);
 }
 
 AudioOutputMixer::~AudioOutputMixer() {
@@ -64,59 +71,41 @@ bool AudioOutputMixer::StartStream(
 
   double volume = 0.0;
   stream_proxy->GetVolume(&volume);
-  bool should_start = proxies_.empty();
-  {
-    base::AutoLock lock(lock_);
-    ProxyData* proxy_data = &proxies_[stream_proxy];
-    proxy_data->audio_source_callback = callback;
-    proxy_data->volume = volume;
-    proxy_data->pending_bytes = 0;
-  }
-  // We cannot start physical stream under the lock,
-  // OnMoreData() would try acquiring it...
-  if (should_start) {
-    physical_stream_->SetVolume(1.0);
-    physical_stream_->Start(this);
-  }
+  // A proxy started again may come with a new callback, so the old one must
+  // be out of use before returning.
+  bool restarted = !proxies_.insert(stream_proxy).second;
+  Command command = { Command::ADD_PROXY, stream_proxy, callback, volume };
+  SendCommand(command, restarted);
+  if (!playing_)
+    StartPhysicalStream();
   return true;
 }
 
 void AudioOutputMixer::StopStream(AudioOutputProxy* stream_proxy) {
   DCHECK_EQ(MessageLoop::current(), message_loop_);
 
-  // Because of possible deadlock we cannot stop physical stream under the lock
-  // (physical_stream_->Stop() can call OnError(), and it acquires the lock to
-  // iterate through proxies), so acquire the lock, update proxy list, release
-  // the lock, and only then stop physical stream if necessary.
-  bool stop_physical_stream = false;
-  {
-    base::AutoLock lock(lock_);
-    ProxyMap::iterator it = proxies_.find(stream_proxy);
-    if (it != proxies_.end()) {
-      proxies_.erase(it);
-      stop_physical_stream = proxies_.empty();
-    }
+  if (proxies_.erase(stream_proxy)) {
+    // Stopping the physical stream first lets the proxy be removed without
+    // waiting for the hardware audio thread.
+    if (proxies_.empty() && playing_)
+      StopPhysicalStream();
+    Command command = { Command::REMOVE_PROXY, stream_proxy, NULL, 0.0 };
+    SendCommand(command, true);
   }
-  if (physical_stream_.get()) {
-    if (stop_physical_stream) {
-      physical_stream_->Stop();
-      pending_bytes_ = 0;  // Just in case.
-    }
+  if (physical_stream_.get())
     close_timer_.Reset();
-  }
 }
 
 void AudioOutputMixer::StreamVolumeSet(AudioOutputProxy* stream_proxy,
                                        double volume) {
   DCHECK_EQ(MessageLoop::current(), message_loop_);
 
-  ProxyMap::iterator it = proxies_.find(stream_proxy);
-
   // Do nothing if stream is not currently playing.
-  if (it != proxies_.end()) {
-    base::AutoLock lock(lock_);
-    it->second.volume = volume;
-  }
+  if (proxies_.find(stream_proxy) == proxies_.end())
+    return;
+
+  Command command = { Command::SET_VOLUME, stream_proxy, NULL, volume };
+  SendCommand(command, false);
 }
 
 void AudioOutputMixer::CloseStream(AudioOutputProxy* stream_proxy) {
@@ -132,7 +121,7 @@ void AudioOutputMixer::Shutdown() {
   weak_this_.InvalidateWeakPtrs();
 
   while (!proxies_.empty()) {
-    CloseStream(proxies_.begin()->first);
+    CloseStream(*proxies_.begin());
   }
   ClosePhysicalStream();
 
@@ -144,24 +133,133 @@ void AudioOutputMixer::Shutdown() {
 void AudioOutputMixer::ClosePhysicalStream() {
   DCHECK_EQ(MessageLoop::current(), message_loop_);
 
-  if (proxies_.empty() && physical_stream_.get() != NULL)
+  if (proxies_.empty() && physical_stream_.get() != NULL) {
+    DCHECK(!playing_);
     physical_stream_.release()->Close();
+  }
+}
+
+void AudioOutputMixer::StartPhysicalStream() {
+  DCHECK(!playing_);
+  playing_ = true;
+  physical_stream_->SetVolume(1.0);
+  physical_stream_->Start(this);
+}
+
+void AudioOutputMixer::StopPhysicalStream() {
+  DCHECK(playing_);
+  physical_stream_->Stop();
+  playing_ = false;
+  pending_bytes_ = 0;  // Just in case.
+
+  // The hardware audio thread is done with the queue; catch up with whatever
+  // it had not picked up yet.
+  ApplyCommands();
+}
+
+void AudioOutputMixer::SendCommand(const Command& command, bool wait) {
+  DCHECK_EQ(MessageLoop::current(), message_loop_);
+
+  if (!playing_) {
+    ApplyCommand(command);
+    return;
+  }
+
+  if (!PushCommand(command)) {
+    // The hardware audio thread has not called back in a long while. Stop
+    // it so that the queue can be emptied here.
+    StopPhysicalStream();
+    ApplyCommand(command);
+    if (!proxies_.empty())
+      StartPhysicalStream();
+    return;
+  }
+
+  if (!wait)
+    return;
+
+  // A callback that starts from now on applies the command before calling
+  // any source. Only one already in progress may have missed it, so wait for
+  // that one to finish. The barrier orders the push above before the load
+  // below, as the increment in OnMoreData() does the other way round.
+  base::subtle::MemoryBarrier();
+  base::subtle::Atomic32 callback_count =
+      base::subtle::Acquire_Load(&callback_count_);
+  if (callback_count % 2 == 0)
+    return;
+  while (base::subtle::Acquire_Load(&callback_count_) == callback_count)
+    base::PlatformThread::YieldCurrentThread();
+}
+
+bool AudioOutputMixer::PushCommand(const Command& command) {
+  uint32 write_index = static_cast<uint32>(
+      base::subtle::NoBarrier_Load(&command_write_index_));
+  uint32 read_index = static_cast<uint32>(
+      base::subtle::Acquire_Load(&command_read_index_));
+  if (write_index - read_index == kCommandQueueSize)
+    return false;
+
+  commands_[write_index % kCommandQueueSize] = command;
+  base::subtle::Release_Store(&command_write_index_,
+                              static_cast<base::subtle::Atomic32>(
+                                  write_index + 1));
+  return true;
+}
+
+void AudioOutputMixer::ApplyCommands() {
+  uint32 read_index = static_cast<uint32>(
+      base::subtle::NoBarrier_Load(&command_read_index_));
+  uint32 write_index = static_cast<uint32>(
+      base::subtle::Acquire_Load(&command_write_index_));
+  if (read_index == write_index)
+    return;
+
+  for (; read_index != write_index; ++read_index)
+    ApplyCommand(commands_[read_index % kCommandQueueSize]);
+  base::subtle::Release_Store(&command_read_index_,
+                              static_cast<base::subtle::Atomic32>(read_index));
+}
+
+void AudioOutputMixer::ApplyCommand(const Command& command) {
+  switch (command.type) {
+    case Command::ADD_PROXY: {
+      ProxyData* proxy_data = &mixing_proxies_[command.stream_proxy];
+      proxy_data->audio_source_callback = command.audio_source_callback;
+      proxy_data->volume = command.volume;
+      proxy_data->pending_bytes = 0;
+      break;
+    }
+    case Command::REMOVE_PROXY:
+      mixing_proxies_.erase(command.stream_proxy);
+      break;
+    case Command::SET_VOLUME: {
+      ProxyMap::iterator it = mixing_proxies_.find(command.stream_proxy);
+      if (it != mixing_proxies_.end())
+        it->second.volume = command.volume;
+      break;
+    }
+  }
 }
 
 // AudioSourceCallback implementation.
 uint32 AudioOutputMixer::OnMoreData(uint8* dest,
                                     uint32 max_size,
                                     AudioBuffersState buffers_state) {
+  base::subtle::Barrier_AtomicIncrement(&callback_count_, 1);
+  ApplyCommands();
+  uint32 size = MixProxies(dest, max_size, buffers_state);
+  base::subtle::Barrier_AtomicIncrement(&callback_count_, 1);
+  return size;
+}
+
+uint32 AudioOutputMixer::MixProxies(uint8* dest,
+                                    uint32 max_size,
+                                    AudioBuffersState buffers_state) {
   max_size = std::min(max_size,
                       static_cast<uint32>(params_.GetBytesPerBuffer()));
-  // TODO(enal): consider getting rid of lock as it is in time-critical code.
-  //             E.g. swap |proxies_| with local variable, and merge 2 lists
-  //             at the end. That would speed things up but complicate stopping
-  //             the stream.
-  base::AutoLock lock(lock_);
 
   DCHECK_GE(pending_bytes_, buffers_state.pending_bytes);
-  if (proxies_.empty()) {
+  if (mixing_proxies_.empty()) {
     pending_bytes_ = buffers_state.pending_bytes;
     return 0;
   }
@@ -172,10 +270,13 @@ uint32 AudioOutputMixer::OnMoreData(uint8* dest,
   // and mixing it into destination.
   // Minor optimization: for the first stream we are writing data directly into
   // destination. This way we don't have to mix the data when there is only one
-  // active stream, and net win in other cases, too.
-  bool first_stream = true;
+  // active stream. Only once a second stream turns up is the first one
+  // converted into |mix_buffer_|, where the rest are then added.
+  int mixed_streams = 0;
+  double first_volume = 0.0;
   uint8* actual_dest = dest;
-  for (ProxyMap::iterator it = proxies_.begin(); it != proxies_.end(); ++it) {
+  for (ProxyMap::iterator it = mixing_proxies_.begin();
+       it != mixing_proxies_.end(); ++it) {
     ProxyData* proxy_data = &it->second;
 
     // If proxy's pending bytes are the same as pending bytes for combined
@@ -201,33 +302,50 @@ uint32 AudioOutputMixer::OnMoreData(uint8* dest,
       continue;
 
     // Different handling for first and all subsequent streams.
-    if (first_stream) {
-      if (volume != 1.0) {
-        media::AdjustVolume(actual_dest,
-                            actual_size,
-                            params_.channels(),
-                            bytes_per_sample,
-                            volume);
-      }
-      if (actual_size < max_size)
-        memset(dest + actual_size, 0, max_size - actual_size);
-      first_stream = false;
+    if (mixed_streams == 0) {
+      first_volume = volume;
       actual_dest = mixer_data_.get();
       actual_total_size = actual_size;
     } else {
-      media::MixStreams(dest,
-                        actual_dest,
-                        actual_size,
-                        bytes_per_sample,
-                        volume);
+      if (mixed_streams == 1) {
+        memset(mix_buffer_.get(), 0,
+               max_size / bytes_per_sample * sizeof(float));
+        media::AccumulateToFloat(dest,
+                                 actual_total_size,
+                                 bytes_per_sample,
+                                 first_volume,
+                                 mix_buffer_.get());
+      }
+      media::AccumulateToFloat(actual_dest,
+                               actual_size,
+                               bytes_per_sample,
+                               volume,
+                               mix_buffer_.get());
       actual_total_size = std::max(actual_size, actual_total_size);
     }
+    ++mixed_streams;
+  }
+
+  if (mixed_streams == 1 && first_volume != 1.0) {
+    media::AdjustVolume(dest,
+                        actual_total_size,
+                        params_.channels(),
+                        bytes_per_sample,
+                        first_volume);
+  } else if (mixed_streams > 1) {
+    media::ClipFloatToInt(mix_buffer_.get(),
+                          actual_total_size / bytes_per_sample,
+                          bytes_per_sample,
+                          dest);
   }
+  if (actual_total_size < max_size)
+    memset(dest + actual_total_size, 0, max_size - actual_total_size);
 
   // Now go through all proxies once again and increase pending_bytes
   // for each proxy. Could not do it earlier because we did not know
   // actual_total_size.
-  for (ProxyMap::iterator it = proxies_.begin(); it != proxies_.end(); ++it) {
+  for (ProxyMap::iterator it = mixing_proxies_.begin();
+       it != mixing_proxies_.end(); ++it) {
     it->second.pending_bytes += actual_total_size;
   }
   pending_bytes_ = buffers_state.pending_bytes + actual_total_size;
@@ -235,18 +353,25 @@ uint32 AudioOutputMixer::OnMoreData(uint8* dest,
   return actual_total_size;
 }
 
+// Called on the hardware audio thread, or by the physical stream while it is
+// being stopped, after that thread is done.
 void AudioOutputMixer::OnError(AudioOutputStream* stream, int code) {
-  base::AutoLock lock(lock_);
-  for (ProxyMap::iterator it = proxies_.begin(); it != proxies_.end(); ++it) {
+  for (ProxyMap::iterator it = mixing_proxies_.begin();
+       it != mixing_proxies_.end(); ++it) {
     it->second.audio_source_callback->OnError(it->first, code);
   }
 }
 
 void AudioOutputMixer::WaitTillDataReady() {
-  base::AutoLock lock(lock_);
-  for (ProxyMap::iterator it = proxies_.begin(); it != proxies_.end(); ++it) {
+  // Calls into the sources just as OnMoreData() does, so must be seen as a
+  // callback in progress by SendCommand().
+  base::subtle::Barrier_AtomicIncrement(&callback_count_, 1);
+  ApplyCommands();
+  for (ProxyMap::iterator it = mixing_proxies_.begin();
+       it != mixing_proxies_.end(); ++it) {
     it->second.audio_source_callback->WaitTillDataReady();
   }
+  base::subtle::Barrier_AtomicIncrement(&callback_count_, 1);
 }
 
 }  // namespace media
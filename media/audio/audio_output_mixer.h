@@ -5,17 +5,24 @@
 // AudioOutputMixer is a class that implements browser-side audio mixer.
 // AudioOutputMixer implements both AudioOutputDispatcher and
 // AudioSourceCallback interfaces.
+//
+// The hardware audio thread never waits for the audio manager thread: changes
+// to the set of playing proxies and to their volumes reach it through a
+// lock-free single-producer/single-consumer command queue, which it drains at
+// the start of every OnMoreData(). Streams are mixed as floats and clipped
+// once at the end.
 
 #ifndef MEDIA_AUDIO_AUDIO_OUTPUT_MIXER_H_
 #define MEDIA_AUDIO_AUDIO_OUTPUT_MIXER_H_
 
 #include <map>
+#include <set>
 
+#include "base/atomicops.h"
 #include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
-#include "base/synchronization/lock.h"
 #include "base/timer.h"
 #include "media/audio/audio_io.h"
 #include "media/audio/audio_manager.h"
@@ -53,31 +60,88 @@ class MEDIA_EXPORT AudioOutputMixer
   friend class base::RefCountedThreadSafe<AudioOutputMixer>;
   virtual ~AudioOutputMixer();
 
+  // A change to the proxies being mixed, sent from the audio manager thread
+  // to the hardware audio thread.
+  struct Command {
+    enum Type {
+      ADD_PROXY,
+      REMOVE_PROXY,
+      SET_VOLUME
+    };
+    Type type;
+    AudioOutputProxy* stream_proxy;
+    AudioOutputStream::AudioSourceCallback* audio_source_callback;
+    double volume;
+  };
+
   // Called by |close_timer_|. Closes physical stream.
   void ClosePhysicalStream();
 
-  // The |lock_| must be acquired whenever we modify |proxies_| in the audio
-  // manager thread or accessing it in the hardware audio thread. Read in the
-  // audio manager thread is safe.
-  base::Lock lock_;
-
-  // List of audio output proxies currently being played.
-  // For every proxy we store aux structure containing data necessary for
-  // mixing.
+  // Start or stop the physical stream and keep |playing_| up to date.
+  // Stopping also applies any commands the hardware audio thread had not yet
+  // picked up.
+  void StartPhysicalStream();
+  void StopPhysicalStream();
+
+  // Hands |command| to the hardware audio thread, or applies it right away
+  // while the physical stream is stopped. If |wait| is true, returns only
+  // once the hardware audio thread can no longer be using what the command
+  // replaces.
+  void SendCommand(const Command& command, bool wait);
+
+  // Mixes the data of every proxy in |mixing_proxies_| into |dest|. Called by
+  // OnMoreData().
+  uint32 MixProxies(uint8* dest,
+                    uint32 max_size,
+                    AudioBuffersState buffers_state);
+
+  // Adds |command| to |commands_|. Returns false if the queue is full.
+  bool PushCommand(const Command& command);
+
+  // Applies the queued commands to |mixing_proxies_|. Called on the hardware
+  // audio thread, or on the audio manager thread while the physical stream is
+  // stopped.
+  void ApplyCommands();
+  void ApplyCommand(const Command& command);
+
+  // Proxies currently being played. Only used on the audio manager thread.
+  std::set<AudioOutputProxy*> proxies_;
+
+  // True while the physical stream is started, i.e. while the hardware audio
+  // thread may call OnMoreData(). Only used on the audio manager thread.
+  bool playing_;
+
+  // Ring buffer of commands. Only the audio manager thread advances
+  // |command_write_index_|, and only the thread applying commands advances
+  // |command_read_index_|. Both count up without wrapping to the queue size.
+  static const int kCommandQueueSize = 64;
+  Command commands_[kCommandQueueSize];
+  volatile base::subtle::Atomic32 command_write_index_;
+  volatile base::subtle::Atomic32 command_read_index_;
+
+  // Incremented by the hardware audio thread as it enters and as it leaves
+  // OnMoreData(), so it is odd while a callback is in progress.
+  volatile base::subtle::Atomic32 callback_count_;
+
+  // The proxies being mixed, with the data needed to mix each of them. Only
+  // used on the hardware audio thread, or on the audio manager thread while
+  // the physical stream is stopped.
   struct ProxyData {
     AudioOutputStream::AudioSourceCallback* audio_source_callback;
     double volume;
     int pending_bytes;
   };
   typedef std::map<AudioOutputProxy*, ProxyData> ProxyMap;
-  ProxyMap proxies_;
+  ProxyMap mixing_proxies_;
 
   // Physical stream for this mixer.
   scoped_ptr<AudioOutputStream> physical_stream_;
 
-  // Temporary buffer used when mixing. Allocated in the constructor
-  // to avoid constant allocation/deallocation in the callback.
+  // Temporary buffers used when mixing: the data of one stream, and the sum
+  // of the streams as floats. Allocated in the constructor to avoid constant
+  // allocation/deallocation in the callback.
   scoped_array<uint8> mixer_data_;
+  scoped_array<float> mix_buffer_;
 
   // Used to post delayed tasks to ourselves that we cancel inside Shutdown().
   base::WeakPtrFactory<AudioOutputMixer> weak_this_;
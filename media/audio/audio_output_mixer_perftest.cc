@@ -0,0 +1,192 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how long AudioOutputMixer takes to mix a buffer, and how many
+// buffers it fails to deliver within their own duration, as the number of
+// streams grows. Meanwhile the audio manager thread keeps changing the
+// volume of the streams, as pages fading <audio> elements in and out do.
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/bind.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop_proxy.h"
+#include "base/perftimer.h"
+#include "base/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/time.h"
+#include "media/audio/audio_manager.h"
+#include "media/audio/audio_output_mixer.h"
+#include "media/audio/audio_output_proxy.h"
+#include "media/audio/audio_parameters.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+namespace {
+
+const int kSampleRate = 48000;
+const int kBitsPerSample = 16;
+const int kFramesPerBuffer = 480;
+const int kBuffers = 2000;
+
+const int kStreamCounts[] = { 1, 2, 4, 8, 16, 32 };
+
+// How often the volumes change, about as often as a fade would.
+const int kVolumeChangeIntervalMs = 1;
+
+void RunAndSignal(const base::Closure& task, base::WaitableEvent* event) {
+  task.Run();
+  event->Signal();
+}
+
+// Plays a sine wave from a precomputed table, so that producing the data
+// costs next to nothing compared to mixing it.
+class TableAudioSource : public AudioOutputStream::AudioSourceCallback {
+ public:
+  explicit TableAudioSource(int period_in_samples)
+      : table_(period_in_samples),
+        position_(0) {
+    for (int i = 0; i < period_in_samples; ++i) {
+      table_[i] = static_cast<int16>(
+          8000 * sin(2.0 * 3.14159265358979 * i / period_in_samples));
+    }
+  }
+
+  virtual uint32 OnMoreData(uint8* dest,
+                            uint32 max_size,
+                            AudioBuffersState buffers_state) OVERRIDE {
+    int16* samples = reinterpret_cast<int16*>(dest);
+    int count = max_size / sizeof(int16);
+    for (int i = 0; i < count; ++i) {
+      samples[i] = table_[position_];
+      position_ = (position_ + 1) % table_.size();
+    }
+    return max_size;
+  }
+
+  virtual void OnError(AudioOutputStream* stream, int code) OVERRIDE {}
+
+ private:
+  std::vector<int16> table_;
+  size_t position_;
+
+  DISALLOW_COPY_AND_ASSIGN(TableAudioSource);
+};
+
+class AudioOutputMixerPerfTest : public testing::Test {
+ protected:
+  AudioOutputMixerPerfTest()
+      : audio_manager_(AudioManager::Create()),
+        params_(AudioParameters::AUDIO_MOCK, CHANNEL_LAYOUT_STEREO,
+                kSampleRate, kBitsPerSample, kFramesPerBuffer),
+        run_(0) {
+  }
+
+  void RunOnAudioThread(const base::Closure& task) {
+    base::WaitableEvent done(false, false);
+    audio_manager_->GetMessageLoop()->PostTask(
+        FROM_HERE, base::Bind(&RunAndSignal, task, &done));
+    done.Wait();
+  }
+
+  // These run on the audio manager thread.
+  void StartStreams(int count) {
+    mixer_ = new AudioOutputMixer(audio_manager_.get(), params_,
+                                  base::TimeDelta::FromSeconds(1));
+    for (int i = 0; i < count; ++i) {
+      sources_.push_back(new TableAudioSource(97 + i));
+      AudioOutputProxy* proxy = new AudioOutputProxy(mixer_);
+      ASSERT_TRUE(proxy->Open());
+      proxy->Start(sources_.back());
+      proxies_.push_back(proxy);
+    }
+  }
+
+  // Stops once RunTest() has moved on from |run|.
+  void ChangeVolumes(int run, double volume) {
+    if (base::subtle::Acquire_Load(&run_) != run)
+      return;
+    for (size_t i = 0; i < proxies_.size(); ++i)
+      proxies_[i]->SetVolume(volume);
+    audio_manager_->GetMessageLoop()->PostDelayedTask(
+        FROM_HERE,
+        base::Bind(&AudioOutputMixerPerfTest::ChangeVolumes,
+                   base::Unretained(this), run, volume > 0.5 ? 0.25 : 0.75),
+        base::TimeDelta::FromMilliseconds(kVolumeChangeIntervalMs));
+  }
+
+  void StopStreams() {
+    for (size_t i = 0; i < proxies_.size(); ++i) {
+      proxies_[i]->Stop();
+      proxies_[i]->Close();
+    }
+    proxies_.clear();
+    mixer_->Shutdown();
+    mixer_ = NULL;
+    for (size_t i = 0; i < sources_.size(); ++i)
+      delete sources_[i];
+    sources_.clear();
+  }
+
+  // Calls OnMoreData() as the hardware audio thread would, from this thread,
+  // while the audio manager thread changes volumes.
+  void RunTest(int stream_count) {
+    RunOnAudioThread(base::Bind(&AudioOutputMixerPerfTest::StartStreams,
+                                base::Unretained(this), stream_count));
+    int run = base::subtle::NoBarrier_Load(&run_);
+    audio_manager_->GetMessageLoop()->PostTask(
+        FROM_HERE,
+        base::Bind(&AudioOutputMixerPerfTest::ChangeVolumes,
+                   base::Unretained(this), run, 0.25));
+
+    const base::TimeDelta buffer_duration =
+        base::TimeDelta::FromMicroseconds(
+            base::Time::kMicrosecondsPerSecond * kFramesPerBuffer /
+            kSampleRate);
+    int bytes_per_buffer = params_.GetBytesPerBuffer();
+    scoped_array<uint8> dest(new uint8[bytes_per_buffer]);
+    int late_buffers = 0;
+    PerfTimer timer;
+    for (int i = 0; i < kBuffers; ++i) {
+      base::TimeTicks start = base::TimeTicks::HighResNow();
+      mixer_->OnMoreData(dest.get(), bytes_per_buffer,
+                         AudioBuffersState(bytes_per_buffer, 0));
+      if (base::TimeTicks::HighResNow() - start > buffer_duration)
+        ++late_buffers;
+    }
+    double us_per_buffer = timer.Elapsed().InMicroseconds() /
+        static_cast<double>(kBuffers);
+
+    base::subtle::Release_Store(&run_, run + 1);
+    RunOnAudioThread(base::Bind(&AudioOutputMixerPerfTest::StopStreams,
+                                base::Unretained(this)));
+
+    std::string suffix = base::StringPrintf("_%dstreams", stream_count);
+    LogPerfResult(("AudioOutputMixer_mix_time" + suffix).c_str(),
+                  us_per_buffer, "us");
+    LogPerfResult(("AudioOutputMixer_late_buffers" + suffix).c_str(),
+                  late_buffers, "buffers");
+  }
+
+  scoped_ptr<AudioManager> audio_manager_;
+  AudioParameters params_;
+  scoped_refptr<AudioOutputMixer> mixer_;
+  std::vector<AudioOutputProxy*> proxies_;
+  std::vector<TableAudioSource*> sources_;
+  volatile base::subtle::Atomic32 run_;
+};
+
+}  // namespace
+
+TEST_F(AudioOutputMixerPerfTest, MixStreams) {
+  for (size_t i = 0; i < arraysize(kStreamCounts); ++i)
+    RunTest(kStreamCounts[i]);
+}
+
+}  // namespace media
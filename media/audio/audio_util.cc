@@ -26,6 +26,7 @@
 #endif
 #include "media/audio/audio_parameters.h"
 #include "media/audio/audio_util.h"
+#include "media/base/cpu_features.h"
 #if defined(OS_MACOSX)
 #include "media/audio/mac/audio_low_latency_input_mac.h"
 #include "media/audio/mac/audio_low_latency_output_mac.h"
@@ -34,6 +35,9 @@
 #include "media/audio/win/audio_low_latency_input_win.h"
 #include "media/audio/win/audio_low_latency_output_win.h"
 #endif
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 using base::subtle::Atomic32;
 
@@ -337,6 +341,130 @@ void MixStreams(void* dst,
   }
 }
 
+// |Format| is the integer sample type, |bias| its value for silence.
+template<class Format, int bias>
+static void AccumulateToFloat(const Format* src, int count, float scale,
+                              float* dest) {
+  for (int i = 0; i < count; ++i)
+    dest[i] += scale * (static_cast<int>(src[i]) - bias);
+}
+
+// |Fixed| is a type larger than |Format| so that rounding cannot overflow.
+template<class Format, class Fixed, int bias>
+static void ClipFloatToInt(const float* src, int count, Format* dest) {
+  const Fixed max_value =
+      static_cast<Fixed>(std::numeric_limits<Format>::max()) - bias;
+  const Fixed min_value =
+      static_cast<Fixed>(std::numeric_limits<Format>::min()) - bias;
+  const float scale = static_cast<float>(max_value) + 1.0f;
+  for (int i = 0; i < count; ++i) {
+    float sample = std::max(-scale, std::min(scale, scale * src[i]));
+    Fixed value = static_cast<Fixed>(sample + (sample < 0.0f ? -0.5f : 0.5f));
+    value = std::max(min_value, std::min(max_value, value));
+    dest[i] = static_cast<Format>(value + bias);
+  }
+}
+
+#if defined(ARCH_CPU_X86_FAMILY)
+// 16-bit versions of the above, eight samples at a time.
+static void AccumulateToFloat_SSE2(const int16* src, int count, float scale,
+                                   float* dest) {
+  const __m128 scales = _mm_set1_ps(scale);
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i samples =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    // Widen to 32 bits, keeping the sign, by shifting each sample down from
+    // the top half of a 32-bit lane.
+    __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    _mm_storeu_ps(dest + i, _mm_add_ps(
+        _mm_loadu_ps(dest + i), _mm_mul_ps(_mm_cvtepi32_ps(low), scales)));
+    _mm_storeu_ps(dest + i + 4, _mm_add_ps(
+        _mm_loadu_ps(dest + i + 4), _mm_mul_ps(_mm_cvtepi32_ps(high), scales)));
+  }
+  AccumulateToFloat<int16, 0>(src + i, count - i, scale, dest + i);
+}
+
+static void ClipFloatToInt_SSE2(const float* src, int count, int16* dest) {
+  // The saturating pack does the clipping; the conversion rounds to nearest.
+  const __m128 scales = _mm_set1_ps(32768.0f);
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i low = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i), scales));
+    __m128i high =
+        _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scales));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_packs_epi32(low, high));
+  }
+  ClipFloatToInt<int16, int32, 0>(src + i, count - i, dest + i);
+}
+#endif
+
+bool AccumulateToFloat(const void* src,
+                       size_t buflen,
+                       int bytes_per_sample,
+                       float volume,
+                       float* dest) {
+  DCHECK(src);
+  DCHECK(dest);
+  switch (bytes_per_sample) {
+    case 1:
+      AccumulateToFloat<uint8, 128>(static_cast<const uint8*>(src), buflen,
+                                    volume / 128.0f, dest);
+      return true;
+    case 2:
+      DCHECK_EQ(0u, buflen % 2);
+#if defined(ARCH_CPU_X86_FAMILY)
+      if (hasSSE2()) {
+        AccumulateToFloat_SSE2(static_cast<const int16*>(src), buflen / 2,
+                               volume / 32768.0f, dest);
+        return true;
+      }
+#endif
+      AccumulateToFloat<int16, 0>(static_cast<const int16*>(src), buflen / 2,
+                                  volume / 32768.0f, dest);
+      return true;
+    case 4:
+      DCHECK_EQ(0u, buflen % 4);
+      AccumulateToFloat<int32, 0>(static_cast<const int32*>(src), buflen / 4,
+                                  volume / 2147483648.0f, dest);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool ClipFloatToInt(const float* src,
+                    size_t sample_count,
+                    int bytes_per_sample,
+                    void* dest) {
+  DCHECK(src);
+  DCHECK(dest);
+  switch (bytes_per_sample) {
+    case 1:
+      ClipFloatToInt<uint8, int32, 128>(src, sample_count,
+                                        static_cast<uint8*>(dest));
+      return true;
+    case 2:
+#if defined(ARCH_CPU_X86_FAMILY)
+      if (hasSSE2()) {
+        ClipFloatToInt_SSE2(src, sample_count, static_cast<int16*>(dest));
+        return true;
+      }
+#endif
+      ClipFloatToInt<int16, int32, 0>(src, sample_count,
+                                      static_cast<int16*>(dest));
+      return true;
+    case 4:
+      ClipFloatToInt<int32, int64, 0>(src, sample_count,
+                                      static_cast<int32*>(dest));
+      return true;
+    default:
+      return false;
+  }
+}
+
 int GetAudioHardwareSampleRate() {
 #if defined(OS_MACOSX)
   // Hardware sample-rate on the Mac can be configured, so we must query.
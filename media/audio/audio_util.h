@@ -48,6 +48,25 @@ MEDIA_EXPORT void MixStreams(void* dst,
                              int bytes_per_sample,
                              float volume);
 
+// AccumulateToFloat() scales the |buflen| bytes of integer samples in |src| by
+// |volume| and adds them to |dest|, which holds one float per sample in the
+// canonical range of -1.0 -> +1.0. Mixing many streams this way, then
+// clipping once with ClipFloatToInt(), avoids clipping at every step.
+// Returns false if |bytes_per_sample| is not supported.
+MEDIA_EXPORT bool AccumulateToFloat(const void* src,
+                                    size_t buflen,
+                                    int bytes_per_sample,
+                                    float volume,
+                                    float* dest);
+
+// ClipFloatToInt() converts |sample_count| floats in |src| to integer samples
+// in |dest|, clipping anything outside of -1.0 -> +1.0. Returns false if
+// |bytes_per_sample| is not supported.
+MEDIA_EXPORT bool ClipFloatToInt(const float* src,
+                                 size_t sample_count,
+                                 int bytes_per_sample,
+                                 void* dest);
+
 // FoldChannels() does a software multichannel folding down to stereo.
 // Channel order is assumed to be 5.1 Dolby standard which is
 // front left, front right, center, surround left, surround right.
@@ -161,6 +161,63 @@ TEST(AudioUtilTest, MixStreams_s32_FullVolume) {
   EXPECT_EQ(0, expected_test);
 }
 
+TEST(AudioUtilTest, AccumulateToFloat_u8) {
+  // Test AccumulateToFloat() and ClipFloatToInt() on 8 bit samples.
+  uint8 first_u8[kNumberOfSamples] = { 4, 0x40, 0x80, 0xff };
+  uint8 second_u8[kNumberOfSamples] = { 0x80, 0xc0, 0x80, 0x00 };
+  uint8 expected_u8[kNumberOfSamples] = { 4, 0x60, 0x80, 0xbf };
+  float mix[kNumberOfSamples] = { 0 };
+  EXPECT_TRUE(media::AccumulateToFloat(first_u8, sizeof(first_u8),
+                                       sizeof(first_u8[0]), 1.0f, mix));
+  EXPECT_TRUE(media::AccumulateToFloat(second_u8, sizeof(second_u8),
+                                       sizeof(second_u8[0]), 0.5f, mix));
+  uint8 result_u8[kNumberOfSamples];
+  EXPECT_TRUE(media::ClipFloatToInt(mix, kNumberOfSamples,
+                                    sizeof(result_u8[0]), result_u8));
+  int expected_test = memcmp(result_u8, expected_u8, sizeof(expected_u8));
+  EXPECT_EQ(0, expected_test);
+}
+
+TEST(AudioUtilTest, AccumulateToFloat_s16) {
+  // Test AccumulateToFloat() and ClipFloatToInt() on 16 bit samples. Uses
+  // more than eight samples so that any SIMD path and the remainder are both
+  // covered.
+  static const size_t kSamples = 11;
+  int16 first_s16[kSamples] =
+      { -4, 0x40, -32760, 32760, 100, -100, 0, 1000, -1000, 20000, 7 };
+  int16 second_s16[kSamples] =
+      { -4, 0x40, -123, 123, 100, -100, 0, 1000, -1000, 20000, 7 };
+  int16 expected_s16[kSamples] =
+      { -5, 0x50, -32768, 32767, 125, -125, 0, 1250, -1250, 25000, 9 };
+  float mix[kSamples] = { 0 };
+  EXPECT_TRUE(media::AccumulateToFloat(first_s16, sizeof(first_s16),
+                                       sizeof(first_s16[0]), 1.0f, mix));
+  EXPECT_TRUE(media::AccumulateToFloat(second_s16, sizeof(second_s16),
+                                       sizeof(second_s16[0]), 0.25f, mix));
+  int16 result_s16[kSamples];
+  EXPECT_TRUE(media::ClipFloatToInt(mix, kSamples, sizeof(result_s16[0]),
+                                    result_s16));
+  int expected_test = memcmp(result_s16, expected_s16, sizeof(expected_s16));
+  EXPECT_EQ(0, expected_test);
+}
+
+TEST(AudioUtilTest, AccumulateToFloat_s32) {
+  // Test AccumulateToFloat() and ClipFloatToInt() on 32 bit samples.
+  int32 first_s32[kNumberOfSamples] = { -4, 0x40, -32768, 2147483640 };
+  int32 second_s32[kNumberOfSamples] = { -4, 0x40, -32768, 123 };
+  int32 expected_s32[kNumberOfSamples] = { -5, 0x50, -40960, 2147483647 };
+  float mix[kNumberOfSamples] = { 0 };
+  EXPECT_TRUE(media::AccumulateToFloat(first_s32, sizeof(first_s32),
+                                       sizeof(first_s32[0]), 1.0f, mix));
+  EXPECT_TRUE(media::AccumulateToFloat(second_s32, sizeof(second_s32),
+                                       sizeof(second_s32[0]), 0.25f, mix));
+  int32 result_s32[kNumberOfSamples];
+  EXPECT_TRUE(media::ClipFloatToInt(mix, kNumberOfSamples,
+                                    sizeof(result_s32[0]), result_s32));
+  int expected_test = memcmp(result_s32, expected_s32, sizeof(expected_s32));
+  EXPECT_EQ(0, expected_test);
+}
+
 TEST(AudioUtilTest, FoldChannels_u8) {
   // Test FoldChannels() on 8 bit samples.
   uint8 samples_u8[6] = { 100, 150, 130, 70, 130, 170 };
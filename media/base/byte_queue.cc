@@ -72,11 +72,10 @@ void ByteQueue::Pop(int count) {
   offset_ += count;
   used_ -= count;
 
-  // Move the offset back to 0 if we have reached the end of the buffer.
-  if (offset_ == size_) {
-    DCHECK_EQ(used_, 0);
+  // Move the offset back to 0 once the queue is empty, so that the next Push()
+  // fills the buffer from the start instead of moving or outgrowing it.
+  if (used_ == 0)
     offset_ = 0;
-  }
 }
 
 uint8* ByteQueue::front() const { return buffer_.get() + offset_; }
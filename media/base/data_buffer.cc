@@ -4,6 +4,7 @@
 
 #include "base/logging.h"
 #include "media/base/data_buffer.h"
+#include "media/base/data_buffer_pool.h"
 #include "media/base/decrypt_config.h"
 #if !defined(OS_ANDROID)
 #include "media/ffmpeg/ffmpeg_common.h"
@@ -15,25 +16,25 @@ DataBuffer::DataBuffer(scoped_array<uint8> buffer, int buffer_size)
     : Buffer(base::TimeDelta(), base::TimeDelta()),
       data_(buffer.Pass()),
       buffer_size_(buffer_size),
-      data_size_(buffer_size) {
+      data_size_(buffer_size),
+      pooled_capacity_(0) {
 }
 
 DataBuffer::DataBuffer(int buffer_size)
     : Buffer(base::TimeDelta(), base::TimeDelta()),
-      data_(new uint8[buffer_size]),
       buffer_size_(buffer_size),
-      data_size_(0) {
-  CHECK(data_.get()) << "DataBuffer ctor failed to allocate memory";
-
-  // Prevent arbitrary pointers.
-  if (buffer_size == 0)
-    data_.reset(NULL);
+      data_size_(0),
+      pooled_capacity_(0) {
+  // Leave |data_| NULL for empty buffers rather than an arbitrary pointer.
+  if (buffer_size > 0)
+    AllocateFromPool();
 }
 
 DataBuffer::DataBuffer(const uint8* data, int data_size)
     : Buffer(base::TimeDelta(), base::TimeDelta()),
       buffer_size_(0),
-      data_size_(0) {
+      data_size_(0),
+      pooled_capacity_(0) {
   if (data_size == 0)
     return;
 
@@ -44,13 +45,23 @@ DataBuffer::DataBuffer(const uint8* data, int data_size)
 #endif
 
   buffer_size_ = data_size + padding_size;
-  data_.reset(new uint8[buffer_size_]);
+  AllocateFromPool();
   memcpy(data_.get(), data, data_size);
   memset(data_.get() + data_size, 0, padding_size);
   SetDataSize(data_size);
 }
 
-DataBuffer::~DataBuffer() {}
+DataBuffer::~DataBuffer() {
+  if (pooled_capacity_ > 0)
+    DataBufferPool::GetInstance()->Release(data_.release(), pooled_capacity_);
+}
+
+void DataBuffer::AllocateFromPool() {
+  DCHECK(!data_.get());
+  data_.reset(DataBufferPool::GetInstance()->Allocate(buffer_size_,
+                                                      &pooled_capacity_));
+  CHECK(data_.get()) << "DataBuffer failed to allocate memory";
+}
 
 scoped_refptr<DataBuffer> DataBuffer::CopyFrom(const uint8* data,
                                                int data_size) {
@@ -5,7 +5,8 @@
 // A simple implementation of Buffer that takes ownership of the given data
 // pointer.
 //
-// DataBuffer assumes that memory was allocated with new uint8[].
+// DataBuffer assumes that memory was allocated with new uint8[]. Memory it
+// allocates itself comes from, and goes back to, DataBufferPool.
 
 #ifndef MEDIA_BASE_DATA_BUFFER_H_
 #define MEDIA_BASE_DATA_BUFFER_H_
@@ -50,9 +51,16 @@ class MEDIA_EXPORT DataBuffer : public Buffer {
   virtual ~DataBuffer();
 
  private:
+  // Allocates |data_| from DataBufferPool to hold |buffer_size_| bytes.
+  void AllocateFromPool();
+
   scoped_array<uint8> data_;
   int buffer_size_;
   int data_size_;
+
+  // Size of |data_| as allocated by DataBufferPool, or 0 if |data_| was handed
+  // in and is not returned to the pool.
+  int pooled_capacity_;
   scoped_ptr<DecryptConfig> decrypt_config_;
 
   DISALLOW_COPY_AND_ASSIGN(DataBuffer);
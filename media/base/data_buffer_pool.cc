@@ -0,0 +1,98 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/data_buffer_pool.h"
+
+#include "base/logging.h"
+#include "base/memory/singleton.h"
+
+namespace media {
+
+// Size classes run from kMinBlockSize to kMinBlockSize << kOctaves, with
+// kClassesPerOctave evenly spaced sizes in each power of two.
+static const int kMinBlockSize = 256;
+static const int kOctaves = 13;
+static const int kClassesPerOctave = 4;
+static const int kNumSizeClasses = kOctaves * kClassesPerOctave + 1;
+
+// Released blocks beyond this many bytes are freed instead of pooled.
+static const int kMaxPooledBytes = 8 * 1024 * 1024;
+
+static int SizeOfClass(int size_class) {
+  return (kMinBlockSize << (size_class / kClassesPerOctave)) /
+      kClassesPerOctave * (kClassesPerOctave + size_class % kClassesPerOctave);
+}
+
+DataBufferPool::DataBufferPool()
+    : free_blocks_(kNumSizeClasses),
+      pooled_bytes_(0) {
+}
+
+DataBufferPool::~DataBufferPool() {
+  for (size_t i = 0; i < free_blocks_.size(); ++i) {
+    for (size_t j = 0; j < free_blocks_[i].size(); ++j)
+      delete [] free_blocks_[i][j];
+  }
+}
+
+// static
+DataBufferPool* DataBufferPool::GetInstance() {
+  return Singleton<DataBufferPool,
+                   LeakySingletonTraits<DataBufferPool> >::get();
+}
+
+uint8* DataBufferPool::Allocate(int size, int* capacity) {
+  DCHECK_GT(size, 0);
+  DCHECK(capacity);
+
+  int size_class = SizeClassFor(size);
+  if (size_class < 0) {
+    *capacity = size;
+    return new uint8[size];
+  }
+
+  *capacity = SizeOfClass(size_class);
+  {
+    base::AutoLock auto_lock(lock_);
+    std::vector<uint8*>& blocks = free_blocks_[size_class];
+    if (!blocks.empty()) {
+      uint8* data = blocks.back();
+      blocks.pop_back();
+      pooled_bytes_ -= *capacity;
+      return data;
+    }
+  }
+  return new uint8[*capacity];
+}
+
+void DataBufferPool::Release(uint8* data, int capacity) {
+  DCHECK(data);
+
+  int size_class = SizeClassFor(capacity);
+  if (size_class >= 0 && SizeOfClass(size_class) == capacity) {
+    base::AutoLock auto_lock(lock_);
+    if (pooled_bytes_ + capacity <= kMaxPooledBytes) {
+      free_blocks_[size_class].push_back(data);
+      pooled_bytes_ += capacity;
+      return;
+    }
+  }
+  delete [] data;
+}
+
+int DataBufferPool::pooled_bytes() {
+  base::AutoLock auto_lock(lock_);
+  return pooled_bytes_;
+}
+
+// static
+int DataBufferPool::SizeClassFor(int size) {
+  for (int i = 0; i < kNumSizeClasses; ++i) {
+    if (size <= SizeOfClass(i))
+      return i;
+  }
+  return -1;
+}
+
+}  // namespace media
@@ -0,0 +1,63 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// DataBufferPool recycles the memory behind DataBuffers, so that demuxing,
+// decoding and buffering network data at high bitrates doesn't hit the heap
+// for every packet.
+//
+// Requests are rounded up to one of a set of size classes, four per power of
+// two, which wastes at most a quarter of each block. Released blocks are kept
+// per size class up to a fixed total, and handed out again before anything
+// new is allocated. Requests too large for any size class bypass the pool.
+
+#ifndef MEDIA_BASE_DATA_BUFFER_POOL_H_
+#define MEDIA_BASE_DATA_BUFFER_POOL_H_
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/synchronization/lock.h"
+#include "media/base/media_export.h"
+
+template <typename T> struct LeakySingletonTraits;
+
+namespace media {
+
+// Thread safe.
+class MEDIA_EXPORT DataBufferPool {
+ public:
+  DataBufferPool();
+  ~DataBufferPool();
+
+  // Returns the pool shared by the whole media pipeline. It is never deleted,
+  // since buffers may be released after AtExit.
+  static DataBufferPool* GetInstance();
+
+  // Returns a block of at least |size| bytes, and sets |*capacity| to its
+  // actual size. |size| must be greater than zero.
+  uint8* Allocate(int size, int* capacity);
+
+  // Returns |data|, a block of |capacity| bytes from Allocate(), to the pool.
+  void Release(uint8* data, int capacity);
+
+  // Number of bytes held in released blocks.
+  int pooled_bytes();
+
+ private:
+  // Returns the index of the smallest size class holding |size| bytes, or -1
+  // if |size| is too large to pool.
+  static int SizeClassFor(int size);
+
+  base::Lock lock_;
+
+  // Released blocks, indexed by size class.
+  std::vector<std::vector<uint8*> > free_blocks_;
+  int pooled_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(DataBufferPool);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_BASE_DATA_BUFFER_POOL_H_
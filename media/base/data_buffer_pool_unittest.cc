@@ -0,0 +1,71 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/data_buffer_pool.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+TEST(DataBufferPoolTest, RoundsUpToSizeClass) {
+  DataBufferPool pool;
+  int capacity = 0;
+
+  uint8* data = pool.Allocate(1, &capacity);
+  EXPECT_EQ(256, capacity);
+  pool.Release(data, capacity);
+
+  // Size classes are a quarter of a power of two apart.
+  data = pool.Allocate(1025, &capacity);
+  EXPECT_EQ(1280, capacity);
+  pool.Release(data, capacity);
+
+  data = pool.Allocate(1280, &capacity);
+  EXPECT_EQ(1280, capacity);
+  pool.Release(data, capacity);
+}
+
+TEST(DataBufferPoolTest, ReusesReleasedBlocks) {
+  DataBufferPool pool;
+  int capacity = 0;
+
+  uint8* data = pool.Allocate(1000, &capacity);
+  pool.Release(data, capacity);
+  EXPECT_EQ(capacity, pool.pooled_bytes());
+
+  // Any size in the same class gets the same block back.
+  int new_capacity = 0;
+  EXPECT_EQ(data, pool.Allocate(900, &new_capacity));
+  EXPECT_EQ(capacity, new_capacity);
+  EXPECT_EQ(0, pool.pooled_bytes());
+  pool.Release(data, new_capacity);
+}
+
+TEST(DataBufferPoolTest, LargeBlocksBypassPool) {
+  DataBufferPool pool;
+  int capacity = 0;
+
+  const int kLargeSize = 4 * 1024 * 1024 + 1;
+  uint8* data = pool.Allocate(kLargeSize, &capacity);
+  EXPECT_EQ(kLargeSize, capacity);
+  pool.Release(data, capacity);
+  EXPECT_EQ(0, pool.pooled_bytes());
+}
+
+TEST(DataBufferPoolTest, LimitsPooledBytes) {
+  DataBufferPool pool;
+  const int kBlockSize = 1024 * 1024;
+  const int kBlocks = 16;
+
+  uint8* blocks[kBlocks];
+  int capacity = 0;
+  for (int i = 0; i < kBlocks; ++i)
+    blocks[i] = pool.Allocate(kBlockSize, &capacity);
+  for (int i = 0; i < kBlocks; ++i)
+    pool.Release(blocks[i], capacity);
+
+  EXPECT_GT(pool.pooled_bytes(), 0);
+  EXPECT_LT(pool.pooled_bytes(), kBlocks * kBlockSize);
+}
+
+}  // namespace media
@@ -251,6 +251,20 @@ void MediaLog::AddStatisticsUpdatedEvent() {
                            last_statistics_.video_frames_decoded);
   event->params.SetInteger("video_frames_dropped",
                            last_statistics_.video_frames_dropped);
+  event->params.SetDouble(
+      "audio_demuxer_wait_time",
+      last_statistics_.audio_demuxer_wait_time.InSecondsF());
+  event->params.SetDouble(
+      "video_demuxer_wait_time",
+      last_statistics_.video_demuxer_wait_time.InSecondsF());
+  event->params.SetDouble(
+      "audio_decode_time", last_statistics_.audio_decode_time.InSecondsF());
+  event->params.SetDouble(
+      "video_decode_time", last_statistics_.video_decode_time.InSecondsF());
+  if (last_statistics_.video_frames_queued >= 0) {
+    event->params.SetInteger("video_frames_queued",
+                             last_statistics_.video_frames_queued);
+  }
   AddEvent(event.Pass());
   stats_update_pending_ = false;
 }
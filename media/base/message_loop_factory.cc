@@ -4,6 +4,8 @@
 
 #include "media/base/message_loop_factory.h"
 
+#include "base/bind.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/threading/thread.h"
 
 namespace media {
@@ -40,6 +42,8 @@ base::Thread* MessageLoopFactory::GetThread(const std::string& name) {
 
   base::Thread* thread = new base::Thread(name.c_str());
   CHECK(thread->Start()) << "Failed to start thread: " << name;
+  thread->message_loop()->PostTask(FROM_HERE, base::Bind(
+      &base::debug::SetCurrentThreadHeapTag, base::debug::HEAP_TAG_MEDIA));
   threads_.push_back(std::make_pair(name, thread));
   return thread;
 }
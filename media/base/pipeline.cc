@@ -589,6 +589,12 @@ void Pipeline::OnUpdateStatistics(const PipelineStatistics& stats) {
   statistics_.video_bytes_decoded += stats.video_bytes_decoded;
   statistics_.video_frames_decoded += stats.video_frames_decoded;
   statistics_.video_frames_dropped += stats.video_frames_dropped;
+  statistics_.audio_demuxer_wait_time += stats.audio_demuxer_wait_time;
+  statistics_.video_demuxer_wait_time += stats.video_demuxer_wait_time;
+  statistics_.audio_decode_time += stats.audio_decode_time;
+  statistics_.video_decode_time += stats.video_decode_time;
+  if (stats.video_frames_queued >= 0)
+    statistics_.video_frames_queued = stats.video_frames_queued;
   media_log_->QueueStatisticsUpdatedEvent(statistics_);
 }
 
@@ -6,6 +6,7 @@
 #define MEDIA_BASE_PIPELINE_STATUS_H_
 
 #include "base/callback.h"
+#include "base/time.h"
 
 namespace media {
 
@@ -39,13 +40,24 @@ struct PipelineStatistics {
       : audio_bytes_decoded(0),
         video_bytes_decoded(0),
         video_frames_decoded(0),
-        video_frames_dropped(0) {
+        video_frames_dropped(0),
+        video_frames_queued(-1) {
   }
 
   uint32 audio_bytes_decoded;  // Should be uint64?
   uint32 video_bytes_decoded;  // Should be uint64?
   uint32 video_frames_decoded;
   uint32 video_frames_dropped;
+
+  // Time the decoders spent waiting on their DemuxerStream, and decoding.
+  base::TimeDelta audio_demuxer_wait_time;
+  base::TimeDelta video_demuxer_wait_time;
+  base::TimeDelta audio_decode_time;
+  base::TimeDelta video_decode_time;
+
+  // Decoded frames waiting in the video renderer, or -1 if not reported. Unlike
+  // the other fields this is a level, not an amount to add up.
+  int video_frames_queued;
 };
 
 // Used for updating pipeline statistics.
@@ -14,6 +14,8 @@ bool VideoDecoder::HasAlpha() const {
   return false;
 }
 
+void VideoDecoder::SkipNonReferenceFrames(bool skip) {}
+
 void VideoDecoder::PrepareForShutdownHack() {}
 
 }  // namespace media
@@ -74,6 +74,11 @@ class MEDIA_EXPORT VideoDecoder
   // that return formats with an alpha channel.
   virtual bool HasAlpha() const;
 
+  // Tells the decoder whether its frames are arriving too late to be shown.
+  // While |skip| is true the decoder may discard frames that no other frame
+  // refers to instead of decoding them. Default implementation does nothing.
+  virtual void SkipNonReferenceFrames(bool skip);
+
   // Prepare decoder for shutdown.  This is a HACK needed because
   // PipelineImpl::Stop() goes through a Pause/Flush/Stop dance to all its
   // filters, waiting for each state transition to complete before starting the
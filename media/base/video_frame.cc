@@ -4,6 +4,7 @@
 
 #include "media/base/video_frame.h"
 
+#include "base/callback_helpers.h"
 #include "base/logging.h"
 #include "base/string_piece.h"
 #include "media/base/limits.h"
@@ -60,7 +61,35 @@ scoped_refptr<VideoFrame> VideoFrame::WrapNativeTexture(
       new VideoFrame(NATIVE_TEXTURE, width, height, timestamp, duration));
   frame->texture_id_ = texture_id;
   frame->texture_target_ = texture_target;
-  frame->texture_no_longer_needed_ = no_longer_needed;
+  frame->no_longer_needed_ = no_longer_needed;
+  return frame;
+}
+
+// static
+scoped_refptr<VideoFrame> VideoFrame::WrapExternalYuvData(
+    Format format,
+    size_t width,
+    size_t height,
+    int32 y_stride,
+    int32 uv_stride,
+    uint8* y_data,
+    uint8* u_data,
+    uint8* v_data,
+    base::TimeDelta timestamp,
+    base::TimeDelta duration,
+    const base::Closure& no_longer_needed) {
+  DCHECK(format == YV12 || format == YV16) << format;
+  DCHECK(IsValidConfig(format, width, height));
+  DCHECK(!no_longer_needed.is_null());
+  scoped_refptr<VideoFrame> frame(
+      new VideoFrame(format, width, height, timestamp, duration));
+  frame->strides_[kYPlane] = y_stride;
+  frame->strides_[kUPlane] = uv_stride;
+  frame->strides_[kVPlane] = uv_stride;
+  frame->data_[kYPlane] = y_data;
+  frame->data_[kUPlane] = u_data;
+  frame->data_[kVPlane] = v_data;
+  frame->no_longer_needed_ = no_longer_needed;
   return frame;
 }
 
@@ -150,9 +179,10 @@ VideoFrame::VideoFrame(VideoFrame::Format format,
 }
 
 VideoFrame::~VideoFrame() {
-  if (format_ == NATIVE_TEXTURE && !texture_no_longer_needed_.is_null()) {
-    texture_no_longer_needed_.Run();
-    texture_no_longer_needed_.Reset();
+  // Frames with a |no_longer_needed_| callback don't own their data.
+  if (!no_longer_needed_.is_null()) {
+    base::ResetAndReturn(&no_longer_needed_).Run();
+    return;
   }
 
   // In multi-plane allocations, only a single block of memory is allocated
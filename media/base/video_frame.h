@@ -64,6 +64,22 @@ class MEDIA_EXPORT VideoFrame : public base::RefCountedThreadSafe<VideoFrame> {
       base::TimeDelta duration,
       const base::Closure& no_longer_needed);
 
+  // Wraps YV12 or YV16 planes owned by someone else with a VideoFrame. The
+  // planes must stay valid until |no_longer_needed.Run()| is called, which
+  // happens when the frame is destroyed.
+  static scoped_refptr<VideoFrame> WrapExternalYuvData(
+      Format format,
+      size_t width,
+      size_t height,
+      int32 y_stride,
+      int32 uv_stride,
+      uint8* y_data,
+      uint8* u_data,
+      uint8* v_data,
+      base::TimeDelta timestamp,
+      base::TimeDelta duration,
+      const base::Closure& no_longer_needed);
+
   // Creates a frame with format equals to VideoFrame::EMPTY, width, height
   // timestamp and duration are all 0.
   static scoped_refptr<VideoFrame> CreateEmptyFrame();
@@ -154,7 +170,9 @@ class MEDIA_EXPORT VideoFrame : public base::RefCountedThreadSafe<VideoFrame> {
   // Native texture ID, if this is a NATIVE_TEXTURE frame.
   uint32 texture_id_;
   uint32 texture_target_;
-  base::Closure texture_no_longer_needed_;
+
+  // Run on destruction if the frame wraps a texture or planes it does not own.
+  base::Closure no_longer_needed_;
 
   base::TimeDelta timestamp_;
   base::TimeDelta duration_;
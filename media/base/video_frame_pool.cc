@@ -0,0 +1,122 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/video_frame_pool.h"
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/stl_util.h"
+#include "media/base/buffers.h"
+
+namespace media {
+
+static size_t RoundUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// The planes of one frame, in a single allocation.
+class VideoFramePool::Buffer {
+ public:
+  Buffer(VideoFrame::Format format, size_t coded_width, size_t coded_height)
+      : format_(format),
+        coded_width_(coded_width),
+        coded_height_(coded_height) {
+    DCHECK(format == VideoFrame::YV12 || format == VideoFrame::YV16) << format;
+    // Rounding the Y stride up to twice the alignment keeps the half as wide
+    // chroma rows aligned too.
+    y_stride_ = RoundUp(coded_width, kFrameAlignment * 2);
+    uv_stride_ = y_stride_ / 2;
+    size_t y_rows = RoundUp(coded_height, 2);
+    size_t uv_rows = format == VideoFrame::YV12 ? y_rows / 2 : y_rows;
+    size_t y_bytes = y_stride_ * y_rows;
+    size_t uv_bytes = uv_stride_ * uv_rows;
+
+    // Over-allocate so the first plane can start on an aligned address.
+    storage_.reset(new uint8[y_bytes + uv_bytes * 2 + kFrameAlignment - 1]);
+    uintptr_t base = reinterpret_cast<uintptr_t>(storage_.get());
+    y_data_ = reinterpret_cast<uint8*>(RoundUp(base, kFrameAlignment));
+    u_data_ = y_data_ + y_bytes;
+    v_data_ = u_data_ + uv_bytes;
+  }
+
+  bool Matches(VideoFrame::Format format,
+               size_t coded_width,
+               size_t coded_height) const {
+    return format == format_ &&
+           coded_width == coded_width_ &&
+           coded_height == coded_height_;
+  }
+
+  int32 y_stride() const { return y_stride_; }
+  int32 uv_stride() const { return uv_stride_; }
+  uint8* y_data() const { return y_data_; }
+  uint8* u_data() const { return u_data_; }
+  uint8* v_data() const { return v_data_; }
+
+ private:
+  VideoFrame::Format format_;
+  size_t coded_width_;
+  size_t coded_height_;
+  int32 y_stride_;
+  int32 uv_stride_;
+  scoped_array<uint8> storage_;
+  uint8* y_data_;
+  uint8* u_data_;
+  uint8* v_data_;
+
+  DISALLOW_COPY_AND_ASSIGN(Buffer);
+};
+
+VideoFramePool::VideoFramePool() {}
+
+VideoFramePool::~VideoFramePool() {
+  STLDeleteElements(&free_buffers_);
+}
+
+scoped_refptr<VideoFrame> VideoFramePool::CreateFrame(
+    VideoFrame::Format format,
+    size_t width,
+    size_t height,
+    size_t coded_width,
+    size_t coded_height) {
+  DCHECK_LE(width, coded_width);
+  DCHECK_LE(height, coded_height);
+  Buffer* buffer = NULL;
+  {
+    base::AutoLock auto_lock(lock_);
+    // Buffers of any other size are left over from before a size change, and
+    // won't be needed again.
+    while (!free_buffers_.empty()) {
+      Buffer* free_buffer = free_buffers_.front();
+      free_buffers_.pop_front();
+      if (free_buffer->Matches(format, coded_width, coded_height)) {
+        buffer = free_buffer;
+        break;
+      }
+      delete free_buffer;
+    }
+  }
+  if (!buffer)
+    buffer = new Buffer(format, coded_width, coded_height);
+
+  return VideoFrame::WrapExternalYuvData(
+      format, width, height,
+      buffer->y_stride(), buffer->uv_stride(),
+      buffer->y_data(), buffer->u_data(), buffer->v_data(),
+      kNoTimestamp(), kNoTimestamp(),
+      base::Bind(&VideoFramePool::ReturnBuffer, this, buffer));
+}
+
+size_t VideoFramePool::GetFreeBufferCountForTesting() {
+  base::AutoLock auto_lock(lock_);
+  return free_buffers_.size();
+}
+
+void VideoFramePool::ReturnBuffer(Buffer* buffer) {
+  base::AutoLock auto_lock(lock_);
+  free_buffers_.push_back(buffer);
+}
+
+}  // namespace media
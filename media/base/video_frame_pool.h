@@ -0,0 +1,63 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEDIA_BASE_VIDEO_FRAME_POOL_H_
+#define MEDIA_BASE_VIDEO_FRAME_POOL_H_
+
+#include <list>
+
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "media/base/media_export.h"
+#include "media/base/video_frame.h"
+
+namespace media {
+
+// Hands out YV12 and YV16 VideoFrames backed by recycled buffers. A buffer
+// goes back to the pool when the last reference to its frame is dropped, so a
+// stream of frames of the same size needs no allocations once it is warmed
+// up. Frames may be released on any thread; the pool lives until the last of
+// them is.
+class MEDIA_EXPORT VideoFramePool
+    : public base::RefCountedThreadSafe<VideoFramePool> {
+ public:
+  // Plane addresses and strides are multiples of this, as the SIMD code in
+  // decoders writing straight into frames requires.
+  enum { kFrameAlignment = 32 };
+
+  VideoFramePool();
+
+  // Returns a frame of |width| by |height| visible pixels whose planes have
+  // room for |coded_width| by |coded_height| pixels, for decoders that write
+  // whole macroblocks past the visible edges. The contents are undefined.
+  scoped_refptr<VideoFrame> CreateFrame(VideoFrame::Format format,
+                                        size_t width,
+                                        size_t height,
+                                        size_t coded_width,
+                                        size_t coded_height);
+
+  // Number of buffers waiting to be reused. For testing.
+  size_t GetFreeBufferCountForTesting();
+
+ private:
+  friend class base::RefCountedThreadSafe<VideoFramePool>;
+  class Buffer;
+
+  ~VideoFramePool();
+
+  // Called when the frame wrapping |buffer| is destroyed.
+  void ReturnBuffer(Buffer* buffer);
+
+  // Protects |free_buffers_|, as frames are released on other threads.
+  base::Lock lock_;
+
+  // Buffers not wrapped by any frame. Owned by the pool.
+  std::list<Buffer*> free_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(VideoFramePool);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_BASE_VIDEO_FRAME_POOL_H_
@@ -0,0 +1,76 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/video_frame_pool.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+static bool IsAligned(uintptr_t value) {
+  return value % VideoFramePool::kFrameAlignment == 0;
+}
+
+TEST(VideoFramePoolTest, FrameLayout) {
+  scoped_refptr<VideoFramePool> pool(new VideoFramePool);
+  scoped_refptr<VideoFrame> frame =
+      pool->CreateFrame(VideoFrame::YV12, 321, 241, 336, 256);
+
+  EXPECT_EQ(VideoFrame::YV12, frame->format());
+  EXPECT_EQ(321u, frame->width());
+  EXPECT_EQ(241u, frame->height());
+  for (size_t plane = 0; plane < 3; ++plane) {
+    EXPECT_TRUE(IsAligned(reinterpret_cast<uintptr_t>(frame->data(plane))));
+    EXPECT_TRUE(IsAligned(frame->stride(plane)));
+  }
+  EXPECT_GE(frame->stride(VideoFrame::kYPlane), 336);
+  EXPECT_GE(frame->stride(VideoFrame::kUPlane), 168);
+
+  // The planes must not overlap, even across the coded size.
+  EXPECT_LE(frame->data(VideoFrame::kYPlane) +
+                frame->stride(VideoFrame::kYPlane) * 256,
+            frame->data(VideoFrame::kUPlane));
+  EXPECT_LE(frame->data(VideoFrame::kUPlane) +
+                frame->stride(VideoFrame::kUPlane) * 128,
+            frame->data(VideoFrame::kVPlane));
+}
+
+TEST(VideoFramePoolTest, ReusesBuffers) {
+  scoped_refptr<VideoFramePool> pool(new VideoFramePool);
+  scoped_refptr<VideoFrame> frame =
+      pool->CreateFrame(VideoFrame::YV12, 320, 240, 320, 240);
+  uint8* y_data = frame->data(VideoFrame::kYPlane);
+  EXPECT_EQ(0u, pool->GetFreeBufferCountForTesting());
+
+  frame = NULL;
+  EXPECT_EQ(1u, pool->GetFreeBufferCountForTesting());
+
+  frame = pool->CreateFrame(VideoFrame::YV12, 320, 240, 320, 240);
+  EXPECT_EQ(y_data, frame->data(VideoFrame::kYPlane));
+  EXPECT_EQ(0u, pool->GetFreeBufferCountForTesting());
+}
+
+TEST(VideoFramePoolTest, DropsBuffersOfOtherSizes) {
+  scoped_refptr<VideoFramePool> pool(new VideoFramePool);
+  pool->CreateFrame(VideoFrame::YV12, 320, 240, 320, 240);
+  EXPECT_EQ(1u, pool->GetFreeBufferCountForTesting());
+
+  scoped_refptr<VideoFrame> frame =
+      pool->CreateFrame(VideoFrame::YV12, 640, 480, 640, 480);
+  EXPECT_EQ(0u, pool->GetFreeBufferCountForTesting());
+  EXPECT_EQ(640u, frame->width());
+}
+
+TEST(VideoFramePoolTest, FrameOutlivesPool) {
+  scoped_refptr<VideoFramePool> pool(new VideoFramePool);
+  scoped_refptr<VideoFrame> frame =
+      pool->CreateFrame(VideoFrame::YV16, 320, 240, 320, 240);
+  pool = NULL;
+
+  // The frame's buffer must still be valid.
+  memset(frame->data(VideoFrame::kYPlane), 0,
+         frame->stride(VideoFrame::kYPlane) * frame->rows(VideoFrame::kYPlane));
+  frame = NULL;
+}
+
+}  // namespace media
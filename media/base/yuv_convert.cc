@@ -17,8 +17,17 @@
 
 #include "media/base/yuv_convert.h"
 
+#include <algorithm>
+
+#include "base/atomic_ref_count.h"
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/location.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/sys_info.h"
+#include "base/threading/worker_pool.h"
 #include "build/build_config.h"
 #include "media/base/cpu_features.h"
 #include "media/base/simd/convert_rgb_to_yuv.h"
@@ -102,21 +111,53 @@ const int kFractionBits = 16;
 const int kFractionMax = 1 << kFractionBits;
 const int kFractionMask = ((1 << kFractionBits) - 1);
 
-// Scale a frame of YUV to 32 bit ARGB.
-void ScaleYUVToRGB32(const uint8* y_buf,
-                     const uint8* u_buf,
-                     const uint8* v_buf,
-                     uint8* rgb_buf,
-                     int source_width,
-                     int source_height,
-                     int width,
-                     int height,
-                     int y_pitch,
-                     int uv_pitch,
-                     int rgb_pitch,
-                     YUVType yuv_type,
-                     Rotate view_rotate,
-                     ScaleFilter filter) {
+// The arguments of ScaleYUVToRGB32(), once rotation and scale factors have
+// been worked out, so that bands of destination rows can be scaled
+// independently.
+struct ScaleYUVToRGB32Params {
+  const uint8* y_buf;
+  const uint8* u_buf;
+  const uint8* v_buf;
+  uint8* rgb_buf;
+  int source_width;
+  int source_height;
+  int width;
+  int height;
+  int y_pitch;
+  int uv_pitch;
+  int rgb_pitch;
+  unsigned int y_shift;
+  ScaleFilter filter;
+  int source_dx;
+  int yscale_fixed;
+  FilterYUVRowsProc filter_proc;
+  ConvertYUVToRGB32RowProc convert_proc;
+  ScaleYUVToRGB32RowProc scale_proc;
+  ScaleYUVToRGB32RowProc linear_scale_proc;
+};
+
+// 4096 allows 3 buffers to fit in 12k.
+// Helps performance on CPU with 16K L1 cache.
+// Large enough for 3830x2160 and 30" displays which are 2560x1600.
+static const int kFilterBufferSize = 4096;
+
+// Fills in |params| for ScaleYUVToRGB32(). Returns false if there is nothing
+// to draw.
+static bool SetUpScaleYUVToRGB32(const uint8* y_buf,
+                                 const uint8* u_buf,
+                                 const uint8* v_buf,
+                                 uint8* rgb_buf,
+                                 int source_width,
+                                 int source_height,
+                                 int width,
+                                 int height,
+                                 int y_pitch,
+                                 int uv_pitch,
+                                 int rgb_pitch,
+                                 YUVType yuv_type,
+                                 Rotate view_rotate,
+                                 ScaleFilter filter,
+                                 ScaleYUVToRGB32Params* params) {
   static FilterYUVRowsProc filter_proc = NULL;
   static ConvertYUVToRGB32RowProc convert_proc = NULL;
   static ScaleYUVToRGB32RowProc scale_proc = NULL;
@@ -135,12 +176,8 @@ void ScaleYUVToRGB32(const uint8* y_buf,
   if ((yuv_type == YV12 && (source_width < 2 || source_height < 2)) ||
       (yuv_type == YV16 && (source_width < 2 || source_height < 1)) ||
       width == 0 || height == 0)
-    return;
+    return false;
 
-  // 4096 allows 3 buffers to fit in 12k.
-  // Helps performance on CPU with 16K L1 cache.
-  // Large enough for 3830x2160 and 30" displays which are 2560x1600.
-  const int kFilterBufferSize = 4096;
   // Disable filtering if the screen is too big (to avoid buffer overflows).
   // This should never happen to regular users: they don't have monitors
   // wider than 4096 pixels.
@@ -198,6 +235,51 @@ void ScaleYUVToRGB32(const uint8* y_buf,
     }
   }
 
+  params->y_buf = y_buf;
+  params->u_buf = u_buf;
+  params->v_buf = v_buf;
+  params->rgb_buf = rgb_buf;
+  params->source_width = source_width;
+  params->source_height = source_height;
+  params->width = width;
+  params->height = height;
+  params->y_pitch = y_pitch;
+  params->uv_pitch = uv_pitch;
+  params->rgb_pitch = rgb_pitch;
+  params->y_shift = y_shift;
+  params->filter = filter;
+  params->source_dx = source_dx;
+  // TODO(fbarchard): Fixed point math is off by 1 on negatives.
+  params->yscale_fixed = (source_height << kFractionBits) / height;
+  params->filter_proc = filter_proc;
+  params->convert_proc = convert_proc;
+  params->scale_proc = scale_proc;
+  params->linear_scale_proc = linear_scale_proc;
+  return true;
+}
+
+// Scales destination rows [|first_row|, |last_row|) as set up in |params|.
+// Each row only depends on its own index, so bands can be scaled in any order
+// and on any thread.
+static void ScaleYUVToRGB32Rows(const ScaleYUVToRGB32Params& params,
+                                int first_row,
+                                int last_row) {
+  const uint8* y_buf = params.y_buf;
+  const uint8* u_buf = params.u_buf;
+  const uint8* v_buf = params.v_buf;
+  uint8* rgb_buf = params.rgb_buf;
+  const int source_width = params.source_width;
+  const int source_height = params.source_height;
+  const int width = params.width;
+  const int y_pitch = params.y_pitch;
+  const int uv_pitch = params.uv_pitch;
+  const int rgb_pitch = params.rgb_pitch;
+  const unsigned int y_shift = params.y_shift;
+  const ScaleFilter filter = params.filter;
+  const int source_dx = params.source_dx;
+  const int yscale_fixed = params.yscale_fixed;
+  FilterYUVRowsProc filter_proc = params.filter_proc;
+
   // Need padding because FilterRows() will write 1 to 16 extra pixels
   // after the end for SSE2 version.
   uint8 yuvbuf[16 + kFilterBufferSize * 3 + 16];
@@ -205,11 +287,9 @@ void ScaleYUVToRGB32(const uint8* y_buf,
       reinterpret_cast<uint8*>(reinterpret_cast<uintptr_t>(yuvbuf + 15) & ~15);
   uint8* ubuf = ybuf + kFilterBufferSize;
   uint8* vbuf = ubuf + kFilterBufferSize;
-  // TODO(fbarchard): Fixed point math is off by 1 on negatives.
-  int yscale_fixed = (source_height << kFractionBits) / height;
 
   // TODO(fbarchard): Split this into separate function for better efficiency.
-  for (int y = 0; y < height; ++y) {
+  for (int y = first_row; y < last_row; ++y) {
     uint8* dest_pixel = rgb_buf + y * rgb_pitch;
     int source_y_subpixel = (y * yscale_fixed);
     if (yscale_fixed >= (kFractionMax * 2)) {
@@ -260,12 +340,13 @@ void ScaleYUVToRGB32(const uint8* y_buf,
       vbuf[uv_source_width] = vbuf[uv_source_width - 1];
     }
     if (source_dx == kFractionMax) {  // Not scaled
-      convert_proc(y_ptr, u_ptr, v_ptr, dest_pixel, width);
+      params.convert_proc(y_ptr, u_ptr, v_ptr, dest_pixel, width);
     } else {
       if (filter & FILTER_BILINEAR_H) {
-        linear_scale_proc(y_ptr, u_ptr, v_ptr, dest_pixel, width, source_dx);
+        params.linear_scale_proc(y_ptr, u_ptr, v_ptr, dest_pixel, width,
+                                 source_dx);
       } else {
-        scale_proc(y_ptr, u_ptr, v_ptr, dest_pixel, width, source_dx);
+        params.scale_proc(y_ptr, u_ptr, v_ptr, dest_pixel, width, source_dx);
       }
     }
   }
@@ -273,6 +354,30 @@ void ScaleYUVToRGB32(const uint8* y_buf,
   EmptyRegisterState();
 }
 
+// Scale a frame of YUV to 32 bit ARGB.
+void ScaleYUVToRGB32(const uint8* y_buf,
+                     const uint8* u_buf,
+                     const uint8* v_buf,
+                     uint8* rgb_buf,
+                     int source_width,
+                     int source_height,
+                     int width,
+                     int height,
+                     int y_pitch,
+                     int uv_pitch,
+                     int rgb_pitch,
+                     YUVType yuv_type,
+                     Rotate view_rotate,
+                     ScaleFilter filter) {
+  ScaleYUVToRGB32Params params;
+  if (!SetUpScaleYUVToRGB32(y_buf, u_buf, v_buf, rgb_buf,
+                            source_width, source_height, width, height,
+                            y_pitch, uv_pitch, rgb_pitch,
+                            yuv_type, view_rotate, filter, &params))
+    return;
+  ScaleYUVToRGB32Rows(params, 0, params.height);
+}
+
 // Scale a frame of YV12 to 32 bit ARGB for a specific rectangle.
 void ScaleYUVToRGB32WithRect(const uint8* y_buf,
                              const uint8* u_buf,
@@ -352,7 +457,6 @@ void ScaleYUVToRGB32WithRect(const uint8* y_buf,
   // The buffer is 16-byte aligned and padded with 16 extra bytes; some of the
   // FilterYUVRowProcs have alignment requirements, and the SSE version can
   // write up to 16 bytes past the end of the buffer.
-  const int kFilterBufferSize = 4096;
   if (source_width > kFilterBufferSize)
     filter_proc = NULL;
   uint8 yuv_temp[16 + kFilterBufferSize * 3 + 16];
@@ -554,4 +658,130 @@ void ConvertYUVToRGB32(const uint8* yplane,
 #endif
 }
 
+// Bands smaller than this are not worth handing to another thread.
+static const int kMinRowsPerBand = 64;
+
+// Returns how many bands to split |rows| destination rows into.
+static int GetBandCount(int rows) {
+  static int processor_count = 0;
+  if (!processor_count)
+    processor_count = base::SysInfo::NumberOfProcessors();
+  return std::max(1, std::min(processor_count, rows / kMinRowsPerBand));
+}
+
+typedef base::Callback<void(int band, int band_count)> BandCallback;
+
+static void RunBandAndSignal(const BandCallback& callback,
+                             int band,
+                             int band_count,
+                             base::AtomicRefCount* bands_left,
+                             base::WaitableEvent* done) {
+  callback.Run(band, band_count);
+  if (!base::AtomicRefCountDec(bands_left))
+    done->Signal();
+}
+
+// Runs |callback| for each of |band_count| bands, all but the last one on the
+// worker pool, and returns once they are all done.
+static void RunBands(const BandCallback& callback, int band_count) {
+  base::AtomicRefCount bands_left = band_count - 1;
+  base::WaitableEvent done(false, false);
+  for (int band = 0; band < band_count - 1; ++band) {
+    if (!base::WorkerPool::PostTask(
+            FROM_HERE,
+            base::Bind(&RunBandAndSignal, callback, band, band_count,
+                       &bands_left, &done),
+            false)) {
+      RunBandAndSignal(callback, band, band_count, &bands_left, &done);
+    }
+  }
+  callback.Run(band_count - 1, band_count);
+  if (band_count > 1)
+    done.Wait();
+}
+
+static void ScaleYUVToRGB32Band(const ScaleYUVToRGB32Params* params,
+                                int band,
+                                int band_count) {
+  ScaleYUVToRGB32Rows(*params,
+                      params->height * band / band_count,
+                      params->height * (band + 1) / band_count);
+}
+
+void ScaleYUVToRGB32Parallel(const uint8* y_buf,
+                             const uint8* u_buf,
+                             const uint8* v_buf,
+                             uint8* rgb_buf,
+                             int source_width,
+                             int source_height,
+                             int width,
+                             int height,
+                             int y_pitch,
+                             int uv_pitch,
+                             int rgb_pitch,
+                             YUVType yuv_type,
+                             Rotate view_rotate,
+                             ScaleFilter filter) {
+  ScaleYUVToRGB32Params params;
+  if (!SetUpScaleYUVToRGB32(y_buf, u_buf, v_buf, rgb_buf,
+                            source_width, source_height, width, height,
+                            y_pitch, uv_pitch, rgb_pitch,
+                            yuv_type, view_rotate, filter, &params))
+    return;
+  RunBands(base::Bind(&ScaleYUVToRGB32Band, &params),
+           GetBandCount(params.height));
+}
+
+// The arguments of ConvertYUVToRGB32(), bundled to be split into bands.
+struct ConvertYUVToRGB32Params {
+  const uint8* yplane;
+  const uint8* uplane;
+  const uint8* vplane;
+  uint8* rgbframe;
+  int width;
+  int height;
+  int ystride;
+  int uvstride;
+  int rgbstride;
+  YUVType yuv_type;
+};
+
+static void ConvertYUVToRGB32Band(const ConvertYUVToRGB32Params* params,
+                                  int band,
+                                  int band_count) {
+  // Start each band on an even row, so that YV12 bands begin with the first
+  // of the two rows sharing a chroma row.
+  int first_row = (params->height * band / band_count) & ~1;
+  int last_row = band == band_count - 1 ?
+      params->height : (params->height * (band + 1) / band_count) & ~1;
+  unsigned int y_shift = params->yuv_type;
+  ConvertYUVToRGB32(params->yplane + first_row * params->ystride,
+                    params->uplane + (first_row >> y_shift) * params->uvstride,
+                    params->vplane + (first_row >> y_shift) * params->uvstride,
+                    params->rgbframe + first_row * params->rgbstride,
+                    params->width,
+                    last_row - first_row,
+                    params->ystride,
+                    params->uvstride,
+                    params->rgbstride,
+                    params->yuv_type);
+}
+
+void ConvertYUVToRGB32Parallel(const uint8* yplane,
+                               const uint8* uplane,
+                               const uint8* vplane,
+                               uint8* rgbframe,
+                               int width,
+                               int height,
+                               int ystride,
+                               int uvstride,
+                               int rgbstride,
+                               YUVType yuv_type) {
+  ConvertYUVToRGB32Params params = {
+    yplane, uplane, vplane, rgbframe, width, height,
+    ystride, uvstride, rgbstride, yuv_type
+  };
+  RunBands(base::Bind(&ConvertYUVToRGB32Band, &params), GetBandCount(height));
+}
+
 }  // namespace media
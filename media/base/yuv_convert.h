@@ -67,6 +67,37 @@ void ScaleYUVToRGB32(const uint8* yplane,
                      Rotate view_rotate,
                      ScaleFilter filter);
 
+// Same as ConvertYUVToRGB32() and ScaleYUVToRGB32(), but split the destination
+// into bands of rows converted in parallel on the base::WorkerPool, one band
+// on the calling thread. They return once the whole frame is converted, so
+// must be called from a thread that is allowed to wait. Frames with too few
+// rows to be worth splitting are converted on the calling thread alone.
+void ConvertYUVToRGB32Parallel(const uint8* yplane,
+                               const uint8* uplane,
+                               const uint8* vplane,
+                               uint8* rgbframe,
+                               int width,
+                               int height,
+                               int ystride,
+                               int uvstride,
+                               int rgbstride,
+                               YUVType yuv_type);
+
+void ScaleYUVToRGB32Parallel(const uint8* yplane,
+                             const uint8* uplane,
+                             const uint8* vplane,
+                             uint8* rgbframe,
+                             int source_width,
+                             int source_height,
+                             int width,
+                             int height,
+                             int ystride,
+                             int uvstride,
+                             int rgbstride,
+                             YUVType yuv_type,
+                             Rotate view_rotate,
+                             ScaleFilter filter);
+
 // Biliner Scale a frame of YV12 to 32 bits ARGB on a specified rectangle.
 // |yplane|, etc and |rgbframe| should point to the top-left pixels of the
 // source and destination buffers.
@@ -0,0 +1,129 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how many frames per second ConvertYUVToRGB32() and
+// ScaleYUVToRGB32() manage at common video resolutions, on the calling thread
+// alone and split into bands across the worker pool.
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/perftimer.h"
+#include "base/stringprintf.h"
+#include "media/base/yuv_convert.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+namespace {
+
+const int kBpp = 4;
+
+// Enough frames for the timings to settle, without taking minutes at 1080p.
+const int kFrames = 100;
+
+struct Resolution {
+  const char* name;
+  int width;
+  int height;
+};
+
+const Resolution kResolutions[] = {
+  { "360p", 640, 360 },
+  { "720p", 1280, 720 },
+  { "1080p", 1920, 1080 },
+};
+
+// Scaled frames are drawn at this fraction of their size, as a video shown
+// in a page smaller than its natural size would be.
+const int kScaleNumerator = 2;
+const int kScaleDenominator = 3;
+
+class YUVConvertPerfTest : public testing::Test {
+ protected:
+  // Allocates a YV12 frame of |width| by |height| filled with a gradient, and
+  // an RGB frame large enough to hold it.
+  void AllocateFrames(int width, int height) {
+    width_ = width;
+    height_ = height;
+    int y_size = width * height;
+    int uv_size = (width / 2) * (height / 2);
+    yuv_bytes_.reset(new uint8[y_size + uv_size * 2]);
+    for (int i = 0; i < y_size + uv_size * 2; ++i)
+      yuv_bytes_[i] = static_cast<uint8>(i);
+    y_plane_ = yuv_bytes_.get();
+    u_plane_ = y_plane_ + y_size;
+    v_plane_ = u_plane_ + uv_size;
+    rgb_bytes_.reset(new uint8[y_size * kBpp]);
+  }
+
+  void Convert(bool parallel) {
+    if (parallel) {
+      ConvertYUVToRGB32Parallel(y_plane_, u_plane_, v_plane_, rgb_bytes_.get(),
+                                width_, height_,
+                                width_, width_ / 2, width_ * kBpp, YV12);
+    } else {
+      ConvertYUVToRGB32(y_plane_, u_plane_, v_plane_, rgb_bytes_.get(),
+                        width_, height_,
+                        width_, width_ / 2, width_ * kBpp, YV12);
+    }
+  }
+
+  void Scale(bool parallel) {
+    int scaled_width = width_ * kScaleNumerator / kScaleDenominator;
+    int scaled_height = height_ * kScaleNumerator / kScaleDenominator;
+    if (parallel) {
+      ScaleYUVToRGB32Parallel(y_plane_, u_plane_, v_plane_, rgb_bytes_.get(),
+                              width_, height_, scaled_width, scaled_height,
+                              width_, width_ / 2, scaled_width * kBpp,
+                              YV12, ROTATE_0, FILTER_BILINEAR);
+    } else {
+      ScaleYUVToRGB32(y_plane_, u_plane_, v_plane_, rgb_bytes_.get(),
+                      width_, height_, scaled_width, scaled_height,
+                      width_, width_ / 2, scaled_width * kBpp,
+                      YV12, ROTATE_0, FILTER_BILINEAR);
+    }
+  }
+
+  void RunTest(const char* function, bool scale) {
+    for (size_t i = 0; i < arraysize(kResolutions); ++i) {
+      AllocateFrames(kResolutions[i].width, kResolutions[i].height);
+      for (int parallel = 0; parallel < 2; ++parallel) {
+        PerfTimer timer;
+        for (int frame = 0; frame < kFrames; ++frame) {
+          if (scale)
+            Scale(parallel != 0);
+          else
+            Convert(parallel != 0);
+        }
+        double seconds = timer.Elapsed().InSecondsF();
+        std::string name = base::StringPrintf(
+            "%s%s_%s", function, parallel ? "Parallel" : "",
+            kResolutions[i].name);
+        LogPerfResult(name.c_str(), kFrames / seconds, "frames/s");
+      }
+    }
+  }
+
+  int width_;
+  int height_;
+  scoped_array<uint8> yuv_bytes_;
+  const uint8* y_plane_;
+  const uint8* u_plane_;
+  const uint8* v_plane_;
+  scoped_array<uint8> rgb_bytes_;
+};
+
+}  // namespace
+
+TEST_F(YUVConvertPerfTest, ConvertYUVToRGB32) {
+  RunTest("ConvertYUVToRGB32", false);
+}
+
+TEST_F(YUVConvertPerfTest, ScaleYUVToRGB32) {
+  RunTest("ScaleYUVToRGB32", true);
+}
+
+}  // namespace media
@@ -126,6 +126,47 @@ TEST(YUVConvertTest, YV16) {
   EXPECT_EQ(4222342047u, rgb_hash);
 }
 
+TEST(YUVConvertTest, YV12Parallel) {
+  scoped_array<uint8> yuv_bytes;
+  scoped_array<uint8> rgb_converted_bytes(new uint8[kRGBSizeConverted]);
+  ReadYV12Data(&yuv_bytes);
+
+  // Bands must not change the output, so this matches the YV12 test.
+  media::ConvertYUVToRGB32Parallel(yuv_bytes.get(),
+                                   yuv_bytes.get() + kSourceUOffset,
+                                   yuv_bytes.get() + kSourceVOffset,
+                                   rgb_converted_bytes.get(),
+                                   kSourceWidth, kSourceHeight,
+                                   kSourceWidth,
+                                   kSourceWidth / 2,
+                                   kSourceWidth * kBpp,
+                                   media::YV12);
+
+  uint32 rgb_hash = DJB2Hash(rgb_converted_bytes.get(), kRGBSizeConverted,
+                             kDJB2HashSeed);
+  EXPECT_EQ(2413171226u, rgb_hash);
+}
+
+TEST(YUVConvertTest, YV16Parallel) {
+  scoped_array<uint8> yuv_bytes;
+  scoped_array<uint8> rgb_converted_bytes(new uint8[kRGBSizeConverted]);
+  ReadYV16Data(&yuv_bytes);
+
+  media::ConvertYUVToRGB32Parallel(yuv_bytes.get(),
+                                   yuv_bytes.get() + kSourceUOffset,
+                                   yuv_bytes.get() + kSourceYSize * 3 / 2,
+                                   rgb_converted_bytes.get(),
+                                   kSourceWidth, kSourceHeight,
+                                   kSourceWidth,
+                                   kSourceWidth / 2,
+                                   kSourceWidth * kBpp,
+                                   media::YV16);
+
+  uint32 rgb_hash = DJB2Hash(rgb_converted_bytes.get(), kRGBSizeConverted,
+                             kDJB2HashSeed);
+  EXPECT_EQ(4222342047u, rgb_hash);
+}
+
 struct YUVScaleTestData {
   YUVScaleTestData(media::YUVType y, media::ScaleFilter s, uint32 r)
       : yuv_type(y),
@@ -188,6 +229,25 @@ TEST_P(YUVScaleTest, Normal) {
   EXPECT_EQ(GetParam().rgb_hash, rgb_hash);
 }
 
+TEST_P(YUVScaleTest, Parallel) {
+  media::ScaleYUVToRGB32Parallel(y_plane(),                    // Y
+                                 u_plane(),                    // U
+                                 v_plane(),                    // V
+                                 rgb_bytes_.get(),             // RGB output
+                                 kSourceWidth, kSourceHeight,  // Dimensions
+                                 kScaledWidth, kScaledHeight,  // Dimensions
+                                 kSourceWidth,                 // YStride
+                                 kSourceWidth / 2,             // UvStride
+                                 kScaledWidth * kBpp,          // RgbStride
+                                 GetParam().yuv_type,
+                                 media::ROTATE_0,
+                                 GetParam().scale_filter);
+
+  // Bands must not change the output, so this matches the Normal test.
+  uint32 rgb_hash = DJB2Hash(rgb_bytes_.get(), kRGBSizeScaled, kDJB2HashSeed);
+  EXPECT_EQ(GetParam().rgb_hash, rgb_hash);
+}
+
 TEST_P(YUVScaleTest, ZeroSourceSize) {
   media::ScaleYUVToRGB32(y_plane(),                    // Y
                          u_plane(),                    // U
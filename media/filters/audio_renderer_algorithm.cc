@@ -5,12 +5,20 @@
 #include "media/filters/audio_renderer_algorithm.h"
 
 #include <algorithm>
+#include <cfloat>
 #include <cmath>
+#include <cstdlib>
 
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
+#include "build/build_config.h"
 #include "media/audio/audio_util.h"
 #include "media/base/buffers.h"
+#include "media/base/cpu_features.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <xmmintrin.h>
+#endif
 
 namespace media {
 
@@ -29,12 +37,52 @@ static const double kWindowDuration = 0.08;
 // Duration of crossfade between audio segments (in seconds).
 static const double kCrossfadeDuration = 0.008;
 
+// How far the intro of a sped-up window may move from its nominal position to
+// line up with the outtro (in seconds). Long enough to cover a full period of
+// any pitch above 100Hz.
+static const double kSearchDuration = 0.01;
+
 // Max/min supported playback rates for fast/slow audio. Audio outside of these
 // ranges are muted.
 // Audio at these speeds would sound better under a frequency domain algorithm.
 static const float kMinPlaybackRate = 0.5f;
 static const float kMaxPlaybackRate = 4.0f;
 
+typedef float (*DotProductProc)(const float* a, const float* b, int length);
+
+static float DotProduct_C(const float* a, const float* b, int length) {
+  float sum = 0.0f;
+  for (int i = 0; i < length; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+
+#if defined(ARCH_CPU_X86_FAMILY)
+static float DotProduct_SSE(const float* a, const float* b, int length) {
+  // Candidate segments start at any frame, so neither input is aligned.
+  __m128 sums = _mm_setzero_ps();
+  int i = 0;
+  for (; i + 4 <= length; i += 4)
+    sums = _mm_add_ps(sums, _mm_mul_ps(_mm_loadu_ps(a + i),
+                                       _mm_loadu_ps(b + i)));
+  float partial_sums[4];
+  _mm_storeu_ps(partial_sums, sums);
+  float sum = partial_sums[0] + partial_sums[1] + partial_sums[2] +
+      partial_sums[3];
+  for (; i < length; ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+#endif
+
+static DotProductProc ChooseDotProductProc() {
+#if defined(ARCH_CPU_X86_FAMILY)
+  if (hasSSE())
+    return &DotProduct_SSE;
+#endif
+  return &DotProduct_C;
+}
+
 AudioRendererAlgorithm::AudioRendererAlgorithm()
     : channels_(0),
       samples_per_second_(0),
@@ -47,6 +95,8 @@ AudioRendererAlgorithm::AudioRendererAlgorithm()
       crossfade_frame_number_(0),
       muted_(false),
       needs_more_data_(false),
+      search_range_(0),
+      drift_(0),
       window_size_(0) {
 }
 
@@ -102,6 +152,17 @@ void AudioRendererAlgorithm::Initialize(
   AlignToFrameBoundary(&bytes_in_crossfade_);
 
   crossfade_buffer_.reset(new uint8[bytes_in_crossfade_]);
+  intro_frame_.reset(new uint8[bytes_per_frame_]);
+
+  search_range_ =
+      samples_per_second_ * bytes_per_channel_ * channels_ * kSearchDuration;
+  AlignToFrameBoundary(&search_range_);
+  drift_ = 0;
+
+  int search_bytes = 2 * search_range_ + bytes_in_crossfade_;
+  search_buffer_.reset(new uint8[search_bytes]);
+  outtro_samples_.reset(new float[bytes_in_crossfade_ / bytes_per_channel_]);
+  search_samples_.reset(new float[search_bytes / bytes_per_channel_]);
 }
 
 int AudioRendererAlgorithm::FillBuffer(
@@ -154,11 +215,13 @@ bool AudioRendererAlgorithm::OutputFasterPlayback(uint8* dest) {
   //
   //  a) Output raw data.
   //  b) Save bytes for crossfade in |crossfade_buffer_|.
-  //  c) Drop data.
+  //  c) Drop data, up to the intro that best matches the saved outtro.
   //  d) Output crossfaded audio leading up to the next window.
   //
   // The duration of each phase is computed below based on the |window_size_|
-  // and |playback_rate_|.
+  // and |playback_rate_|. Phase c) may drop up to |search_range_| more or less
+  // than its nominal duration; |index_into_window_| always advances by the
+  // nominal amount and the difference is tracked in |drift_|.
   int input_step = window_size_;
   int output_step = ceil(window_size_ / playback_rate_);
   AlignToFrameBoundary(&output_step);
@@ -200,8 +263,13 @@ bool AudioRendererAlgorithm::OutputFasterPlayback(uint8* dest) {
     index_into_window_ += bytes_per_frame_;
   }
 
-  // c) Drop frames until we reach the intro crossfade section.
-  while (index_into_window_ < intro_crossfade_begin) {
+  // c) Drop frames until we reach the region searched for the intro.
+  int search_begin = intro_crossfade_begin;
+  if (bytes_to_crossfade > 0) {
+    search_begin = std::max(outtro_crossfade_end,
+                            intro_crossfade_begin - search_range_);
+  }
+  while (index_into_window_ < search_begin) {
     if (audio_buffer_.forward_bytes() < bytes_per_frame_)
       return false;
 
@@ -209,6 +277,23 @@ bool AudioRendererAlgorithm::OutputFasterPlayback(uint8* dest) {
     index_into_window_ += bytes_per_frame_;
   }
 
+  // Then skip to the intro that best matches the outtro, aiming for where the
+  // intro would be had the previous intros been placed at their nominal
+  // positions.
+  if (index_into_window_ < intro_crossfade_begin) {
+    int nominal_offset = intro_crossfade_begin - index_into_window_;
+    int offset = FindBestIntroOffset(nominal_offset - drift_);
+    if (offset < 0)
+      return false;
+
+    audio_buffer_.Seek(offset);
+    if (!IsQueueFull())
+      request_read_cb_.Run();
+    drift_ += offset - nominal_offset;
+    DCHECK_LE(std::abs(drift_), search_range_);
+    index_into_window_ = intro_crossfade_begin;
+  }
+
   // Return if we have run out of data after Phase c).
   if (audio_buffer_.forward_bytes() < bytes_per_frame_)
     return false;
@@ -224,9 +309,8 @@ bool AudioRendererAlgorithm::OutputFasterPlayback(uint8* dest) {
   int offset_into_buffer = index_into_window_ - intro_crossfade_begin;
   memcpy(dest, crossfade_buffer_.get() + offset_into_buffer,
          bytes_per_frame_);
-  scoped_array<uint8> intro_frame_ptr(new uint8[bytes_per_frame_]);
-  audio_buffer_.Read(intro_frame_ptr.get(), bytes_per_frame_);
-  OutputCrossfadedFrame(dest, intro_frame_ptr.get());
+  audio_buffer_.Read(intro_frame_.get(), bytes_per_frame_);
+  OutputCrossfadedFrame(dest, intro_frame_.get());
   index_into_window_ += bytes_per_frame_;
   return true;
 }
@@ -349,6 +433,73 @@ void AudioRendererAlgorithm::DropFrame() {
     request_read_cb_.Run();
 }
 
+int AudioRendererAlgorithm::FindBestIntroOffset(int target_offset) {
+  DCHECK_EQ(target_offset % bytes_per_frame_, 0);
+  int min_offset = std::max(0, target_offset - search_range_);
+  int max_offset = target_offset + search_range_;
+  int search_bytes = max_offset - min_offset + bytes_in_crossfade_;
+  if (audio_buffer_.forward_bytes() < min_offset + search_bytes)
+    return -1;
+
+  int copied =
+      audio_buffer_.Peek(search_buffer_.get(), search_bytes, min_offset);
+  DCHECK_EQ(search_bytes, copied);
+
+  int samples_in_crossfade = bytes_in_crossfade_ / bytes_per_channel_;
+  ConvertToFloat(crossfade_buffer_.get(), samples_in_crossfade,
+                 outtro_samples_.get());
+  ConvertToFloat(search_buffer_.get(), search_bytes / bytes_per_channel_,
+                 search_samples_.get());
+
+  // Score each candidate by its normalized cross-correlation with the outtro.
+  // The outtro's own energy is the same for every candidate, so it is left
+  // out. Should every candidate be silent, the target is kept.
+  DotProductProc dot_product = ChooseDotProductProc();
+  int best_offset = std::max(min_offset, target_offset);
+  float best_score = -FLT_MAX;
+  for (int offset = min_offset; offset <= max_offset;
+       offset += bytes_per_frame_) {
+    const float* candidate =
+        search_samples_.get() + (offset - min_offset) / bytes_per_channel_;
+    float energy = dot_product(candidate, candidate, samples_in_crossfade);
+    if (energy <= 0.0f)
+      continue;
+
+    float score = dot_product(outtro_samples_.get(), candidate,
+                              samples_in_crossfade) / sqrt(energy);
+    if (score > best_score) {
+      best_score = score;
+      best_offset = offset;
+    }
+  }
+  return best_offset;
+}
+
+void AudioRendererAlgorithm::ConvertToFloat(
+    const uint8* src, int samples, float* dest) {
+  switch (bytes_per_channel_) {
+    case 4: {
+      const int32* src32 = reinterpret_cast<const int32*>(src);
+      for (int i = 0; i < samples; ++i)
+        dest[i] = src32[i];
+      break;
+    }
+    case 2: {
+      const int16* src16 = reinterpret_cast<const int16*>(src);
+      for (int i = 0; i < samples; ++i)
+        dest[i] = src16[i];
+      break;
+    }
+    case 1:
+      // 8-bit samples are unsigned, centered on 128.
+      for (int i = 0; i < samples; ++i)
+        dest[i] = static_cast<int>(src[i]) - 128;
+      break;
+    default:
+      NOTREACHED() << "Unsupported audio bit depth in search.";
+  }
+}
+
 void AudioRendererAlgorithm::OutputCrossfadedFrame(
     uint8* outtro, const uint8* intro) {
   DCHECK_LE(index_into_window_, window_size_);
@@ -392,6 +543,7 @@ void AudioRendererAlgorithm::SetPlaybackRate(float new_rate) {
       playback_rate_ < kMinPlaybackRate || playback_rate_ > kMaxPlaybackRate;
 
   ResetWindow();
+  drift_ = 0;
 }
 
 void AudioRendererAlgorithm::AlignToFrameBoundary(int* value) {
@@ -400,6 +552,7 @@ void AudioRendererAlgorithm::AlignToFrameBoundary(int* value) {
 
 void AudioRendererAlgorithm::FlushBuffers() {
   ResetWindow();
+  drift_ = 0;
 
   // Clear the queue of decoded packets (releasing the buffers).
   audio_buffer_.Clear();
@@ -15,7 +15,9 @@
 //
 // AudioRendererAlgorithm uses a simple pitch-preservation algorithm to
 // stretch and compress audio data to meet playback speeds less than and
-// greater than the natural playback of the audio stream.
+// greater than the natural playback of the audio stream. When speeding up, the
+// segments being joined are aligned with a waveform similarity search (WSOLA)
+// so that they crossfade in phase.
 //
 // Audio at very low or very high playback rates are muted to preserve quality.
 
@@ -113,7 +115,9 @@ class MEDIA_EXPORT AudioRendererAlgorithm {
   // audio output while preserving pitch. Essentially, we play a bit of audio
   // data at normal speed, then we "fast forward" by dropping the next bit of
   // audio data, and then we stich the pieces together by crossfading from one
-  // audio chunk to the next.
+  // audio chunk to the next. Where the next chunk starts is picked, within
+  // |search_range_| of its nominal position, so that it best matches the end
+  // of the previous one.
   bool OutputFasterPlayback(uint8* dest);
 
   // Fills |dest| with one frame of audio data at slower than normal speed.
@@ -149,6 +153,16 @@ class MEDIA_EXPORT AudioRendererAlgorithm {
   template <class Type>
   void CrossfadeFrame(uint8* outtro, const uint8* intro);
 
+  // Returns the forward offset into |audio_buffer_|, within |search_range_| of
+  // |target_offset| but not before the current position, of the
+  // |bytes_in_crossfade_| long segment that best matches the outtro saved in
+  // |crossfade_buffer_|. Returns -1 if |audio_buffer_| does not hold all of
+  // the segments to compare yet.
+  int FindBestIntroOffset(int target_offset);
+
+  // Converts |samples| samples of |src| to floats centered on zero.
+  void ConvertToFloat(const uint8* src, int samples, float* dest);
+
   // Rounds |*value| down to the nearest frame boundary.
   void AlignToFrameBoundary(int* value);
 
@@ -192,6 +206,24 @@ class MEDIA_EXPORT AudioRendererAlgorithm {
   // Temporary buffer to hold crossfade data.
   scoped_array<uint8> crossfade_buffer_;
 
+  // Temporary buffer to hold the intro frame being crossfaded.
+  scoped_array<uint8> intro_frame_;
+
+  // How far, in bytes, the intro of a sped-up window may move from its nominal
+  // position to line up with the outtro.
+  int search_range_;
+
+  // Bytes consumed beyond what |playback_rate_| calls for, because of where
+  // the intros were placed. Kept within |search_range_| by steering later
+  // searches back towards zero.
+  int drift_;
+
+  // Scratch buffers for FindBestIntroOffset(): the raw region searched, and
+  // the outtro and that region converted to floats.
+  scoped_array<uint8> search_buffer_;
+  scoped_array<float> outtro_samples_;
+  scoped_array<float> search_samples_;
+
   // Window size, in bytes (calculated from audio properties).
   int window_size_;
 
@@ -9,6 +9,7 @@
 // expectation that FillBuffer() will fill as much as it can but no more.
 
 #include <cmath>
+#include <cstdlib>
 
 #include "base/bind.h"
 #include "base/callback.h"
@@ -20,13 +21,16 @@ static const size_t kRawDataSize = 10 * 1024;
 static const int kSamplesPerSecond = 44100;
 static const int kDefaultChannels = 2;
 static const int kDefaultSampleBits = 16;
+static const int kSineAmplitude = 10000;
+static const double kPi = 3.14159265358979323846;
 
 namespace media {
 
 class AudioRendererAlgorithmTest : public testing::Test {
  public:
   AudioRendererAlgorithmTest()
-      : bytes_enqueued_(0) {
+      : bytes_enqueued_(0),
+        sine_period_in_frames_(0) {
   }
 
   ~AudioRendererAlgorithmTest() {}
@@ -48,6 +52,13 @@ class AudioRendererAlgorithmTest : public testing::Test {
     CHECK_EQ(kRawDataSize % algorithm_.bytes_per_channel(), 0u);
     CHECK_EQ(kRawDataSize % algorithm_.bytes_per_frame(), 0u);
     size_t length = kRawDataSize / algorithm_.bytes_per_channel();
+    if (sine_period_in_frames_ > 0) {
+      WriteSineData(audio_data.get(), length);
+      algorithm_.EnqueueBuffer(new DataBuffer(audio_data.Pass(),
+                                              kRawDataSize));
+      bytes_enqueued_ += kRawDataSize;
+      return;
+    }
     switch (algorithm_.bytes_per_channel()) {
       case 4:
         WriteFakeData<int32>(audio_data.get(), length);
@@ -75,6 +86,23 @@ class AudioRendererAlgorithmTest : public testing::Test {
     }
   }
 
+  // Writes a sine wave of |kSineAmplitude| and |sine_period_in_frames_|
+  // frames to every channel, continuing from the previous buffer. Only used
+  // with 16-bit audio.
+  void WriteSineData(uint8* audio_data, size_t length) {
+    CHECK_EQ(algorithm_.bytes_per_channel(), 2);
+    int16* output = reinterpret_cast<int16*>(audio_data);
+    int channels =
+        algorithm_.bytes_per_frame() / algorithm_.bytes_per_channel();
+    int frames_enqueued = bytes_enqueued_ / algorithm_.bytes_per_frame();
+    for (size_t i = 0; i < length; i++) {
+      int frame = frames_enqueued + i / channels;
+      output[i] = static_cast<int16>(kSineAmplitude * sin(
+          2.0 * kPi * (frame % sine_period_in_frames_) /
+          sine_period_in_frames_));
+    }
+  }
+
   void CheckFakeData(uint8* audio_data, int frames_written,
                      double playback_rate) {
     size_t length =
@@ -181,6 +209,7 @@ class AudioRendererAlgorithmTest : public testing::Test {
  protected:
   AudioRendererAlgorithm algorithm_;
   int bytes_enqueued_;
+  int sine_period_in_frames_;
 };
 
 TEST_F(AudioRendererAlgorithmTest, FillBuffer_NormalRate) {
@@ -266,6 +295,41 @@ TEST_F(AudioRendererAlgorithmTest, FillBuffer_SmallBufferSize) {
   TestPlaybackRate(1.5, kBufferSizeInFrames, kFramesRequested);
 }
 
+// Joining two segments of a sine wave out of phase would make its amplitude
+// dip through the crossfade; the intro search should line them up instead.
+TEST_F(AudioRendererAlgorithmTest, FillBuffer_FasterPlaybackKeepsPhase) {
+  static const int kPeriodInFrames = 100;
+  static const int kFramesRequested = 2 * kSamplesPerSecond;
+  sine_period_in_frames_ = kPeriodInFrames;
+  Initialize();
+
+  for (int i = 0; i < 3; ++i) {
+    static const double kPlaybackRates[] = { 1.25, 1.5, 2.0 };
+    algorithm_.SetPlaybackRate(kPlaybackRates[i]);
+
+    scoped_array<int16> buffer(new int16[kFramesRequested * kDefaultChannels]);
+    uint8* dest = reinterpret_cast<uint8*>(buffer.get());
+    int frames_written = 0;
+    while (frames_written < kFramesRequested) {
+      int frames = algorithm_.FillBuffer(
+          dest + frames_written * algorithm_.bytes_per_frame(),
+          kFramesRequested - frames_written);
+      CHECK_GT(frames, 0);
+      frames_written += frames;
+    }
+
+    // Every period of the output should still reach close to full amplitude.
+    for (int start = 0; start + kPeriodInFrames <= kFramesRequested;
+         start += kPeriodInFrames) {
+      int peak = 0;
+      for (int frame = start; frame < start + kPeriodInFrames; ++frame)
+        peak = std::max(peak, std::abs(buffer[frame * kDefaultChannels]));
+      EXPECT_GE(peak, kSineAmplitude * 9 / 10)
+          << "rate " << kPlaybackRates[i] << ", frame " << start;
+    }
+  }
+}
+
 TEST_F(AudioRendererAlgorithmTest, FillBuffer_LowerQualityAudio) {
   static const int kChannels = 1;
   static const int kSampleBits = 8;
@@ -11,6 +11,7 @@
 #include "media/base/stream_parser_buffer.h"
 #include "media/base/video_decoder_config.h"
 #include "media/filters/chunk_demuxer_client.h"
+#include "media/filters/source_buffer_stream.h"
 #include "media/webm/webm_stream_parser.h"
 
 namespace media {
@@ -18,6 +19,12 @@ namespace media {
 // TODO(acolwell): Remove this when fixing http://crbug.com/122909 .
 const char* kDefaultSourceType = "video/webm; codecs=\"vp8, vorbis\"";
 
+// Bytes of buffered data each stream holds before evicting the data furthest
+// behind the read position. Audio needs far less than video for the same
+// duration.
+static const int kAudioMemoryLimit = 12 * 1024 * 1024;
+static const int kVideoMemoryLimit = 150 * 1024 * 1024;
+
 class ChunkDemuxerStream : public DemuxerStream {
  public:
   typedef std::deque<scoped_refptr<StreamParserBuffer> > BufferQueue;
@@ -37,12 +44,11 @@ class ChunkDemuxerStream : public DemuxerStream {
   void AddBuffers(const BufferQueue& buffers);
   void Shutdown();
 
-  // Gets the time range buffered by this object.
-  // Returns true if there is buffered data. |start_out| & |end_out| are set to
-  //    the start and end time of the buffered data respectively.
-  // Returns false if no data is buffered.
-  bool GetBufferedRange(base::TimeDelta* start_out,
-                        base::TimeDelta* end_out) const;
+  // Returns true if the last Seek() is still waiting for data to be appended.
+  bool IsSeekPending() const;
+
+  // Returns the time ranges buffered by this object, in order.
+  ChunkDemuxer::Ranges GetBufferedRanges() const;
 
   bool GetLastBufferTimestamp(base::TimeDelta* timestamp) const;
 
@@ -71,7 +77,7 @@ class ChunkDemuxerStream : public DemuxerStream {
   void DeferRead_Locked(const ReadCB& read_cb);
 
   // Creates closures that bind ReadCBs in |read_cbs_| to data in
-  // |buffers_| and pops the callbacks & buffers from the respecive queues.
+  // |stream_| and pops the callbacks & buffers from the respecive queues.
   void CreateReadDoneClosures_Locked(ClosureQueue* closures);
 
   Type type_;
@@ -81,7 +87,10 @@ class ChunkDemuxerStream : public DemuxerStream {
   mutable base::Lock lock_;
   State state_;
   ReadCBQueue read_cbs_;
-  BufferQueue buffers_;
+
+  // Buffers appended to this stream, kept across seeks so that seeking into
+  // buffered time needs no new data.
+  SourceBufferStream stream_;
 
   // Keeps track of the timestamp of the last buffer we have
   // added to |buffers_|. This is used to enforce buffers with strictly
@@ -94,6 +103,7 @@ class ChunkDemuxerStream : public DemuxerStream {
 ChunkDemuxerStream::ChunkDemuxerStream(const AudioDecoderConfig& audio_config)
     : type_(AUDIO),
       state_(RETURNING_DATA_FOR_READS),
+      stream_(kAudioMemoryLimit),
       last_buffer_timestamp_(kNoTimestamp()) {
   audio_config_.CopyFrom(audio_config);
 }
@@ -102,6 +112,7 @@ ChunkDemuxerStream::ChunkDemuxerStream(const AudioDecoderConfig& audio_config)
 ChunkDemuxerStream::ChunkDemuxerStream(const VideoDecoderConfig& video_config)
     : type_(VIDEO),
       state_(RETURNING_DATA_FOR_READS),
+      stream_(kVideoMemoryLimit),
       last_buffer_timestamp_(kNoTimestamp()) {
   video_config_.CopyFrom(video_config);
 }
@@ -113,7 +124,7 @@ void ChunkDemuxerStream::Flush() {
   ReadCBQueue read_cbs;
   {
     base::AutoLock auto_lock(lock_);
-    buffers_.clear();
+    stream_.Flush();
     ChangeState_Locked(WAITING_FOR_SEEK);
     last_buffer_timestamp_ = kNoTimestamp();
 
@@ -130,11 +141,13 @@ void ChunkDemuxerStream::Seek(base::TimeDelta time) {
   DCHECK(read_cbs_.empty());
 
   if (state_ == WAITING_FOR_SEEK) {
+    stream_.Seek(time);
     ChangeState_Locked(RETURNING_DATA_FOR_READS);
     return;
   }
 
   if (state_ == RECEIVED_EOS_WHILE_WAITING_FOR_SEEK) {
+    stream_.Seek(time);
     ChangeState_Locked(RECEIVED_EOS);
     return;
   }
@@ -183,7 +196,7 @@ void ChunkDemuxerStream::AddBuffers(const BufferQueue& buffers) {
         }
 
         last_buffer_timestamp_ = current_ts;
-        buffers_.push_back(*itr);
+        stream_.Append(*itr);
       }
     }
 
@@ -201,7 +214,6 @@ void ChunkDemuxerStream::Shutdown() {
     ChangeState_Locked(SHUTDOWN);
 
     std::swap(read_cbs_, read_cbs);
-    buffers_.clear();
   }
 
   // Pass end of stream buffers to all callbacks to signal that no more data
@@ -210,31 +222,24 @@ void ChunkDemuxerStream::Shutdown() {
     it->Run(StreamParserBuffer::CreateEOSBuffer());
 }
 
-bool ChunkDemuxerStream::GetBufferedRange(
-    base::TimeDelta* start_out, base::TimeDelta* end_out) const {
+bool ChunkDemuxerStream::IsSeekPending() const {
   base::AutoLock auto_lock(lock_);
+  return stream_.IsSeekPending();
+}
 
-  if (buffers_.empty())
-    return false;
-
-  *start_out = buffers_.front()->GetTimestamp();
-  *end_out = buffers_.back()->GetTimestamp();
-
-  base::TimeDelta end_duration = buffers_.back()->GetDuration();
-  if (end_duration != kNoTimestamp())
-    *end_out += end_duration;
-
-  return true;
+ChunkDemuxer::Ranges ChunkDemuxerStream::GetBufferedRanges() const {
+  base::AutoLock auto_lock(lock_);
+  return stream_.GetBufferedRanges();
 }
 
 bool ChunkDemuxerStream::GetLastBufferTimestamp(
     base::TimeDelta* timestamp) const {
   base::AutoLock auto_lock(lock_);
 
-  if (buffers_.empty())
+  if (last_buffer_timestamp_ == kNoTimestamp())
     return false;
 
-  *timestamp = buffers_.back()->GetTimestamp();
+  *timestamp = last_buffer_timestamp_;
   return true;
 }
 
@@ -253,46 +258,39 @@ static void RunOnMessageLoop(const DemuxerStream::ReadCB& read_cb,
 
 // DemuxerStream methods.
 void ChunkDemuxerStream::Read(const ReadCB& read_cb) {
-  scoped_refptr<Buffer> buffer;
+  scoped_refptr<StreamParserBuffer> buffer;
 
   {
     base::AutoLock auto_lock(lock_);
 
     switch (state_) {
       case RETURNING_DATA_FOR_READS:
-        // If we don't have any buffers ready or already have
-        // pending reads, then defer this read.
-        if (buffers_.empty() || !read_cbs_.empty()) {
+        // If we already have pending reads or don't have the next buffer
+        // ready, then defer this read.
+        if (!read_cbs_.empty() || !stream_.GetNextBuffer(&buffer)) {
           DeferRead_Locked(read_cb);
           return;
         }
-
-        buffer = buffers_.front();
-        buffers_.pop_front();
         break;
 
       case WAITING_FOR_SEEK:
       case RECEIVED_EOS_WHILE_WAITING_FOR_SEEK:
         // Null buffers should be returned in this state since we are waiting
-        // for a seek. Any buffers in |buffers_| should NOT be returned because
+        // for a seek. Any buffers in |stream_| should NOT be returned because
         // they are associated with the seek.
         DCHECK(read_cbs_.empty());
         break;
       case RECEIVED_EOS:
         DCHECK(read_cbs_.empty());
 
-        if (buffers_.empty()) {
+        if (!stream_.GetNextBuffer(&buffer)) {
           ChangeState_Locked(RETURNING_EOS_FOR_READS);
           buffer = StreamParserBuffer::CreateEOSBuffer();
-        } else {
-          buffer = buffers_.front();
-          buffers_.pop_front();
         }
         break;
 
       case RETURNING_EOS_FOR_READS:
       case SHUTDOWN:
-        DCHECK(buffers_.empty());
         DCHECK(read_cbs_.empty());
         buffer = StreamParserBuffer::CreateEOSBuffer();
     }
@@ -334,13 +332,14 @@ void ChunkDemuxerStream::CreateReadDoneClosures_Locked(ClosureQueue* closures) {
   if (state_ != RETURNING_DATA_FOR_READS && state_ != RECEIVED_EOS)
     return;
 
-  while (!buffers_.empty() && !read_cbs_.empty()) {
-    closures->push_back(base::Bind(read_cbs_.front(), buffers_.front()));
-    buffers_.pop_front();
+  scoped_refptr<StreamParserBuffer> buffer;
+  while (!read_cbs_.empty() && stream_.GetNextBuffer(&buffer)) {
+    closures->push_back(base::Bind(read_cbs_.front(), buffer));
     read_cbs_.pop_front();
   }
 
-  if (state_ != RECEIVED_EOS || !buffers_.empty() || read_cbs_.empty())
+  // Any read still pending has run out of buffers.
+  if (state_ != RECEIVED_EOS || read_cbs_.empty())
     return;
 
   // Push enough EOS buffers to satisfy outstanding Read() requests.
@@ -358,8 +357,7 @@ ChunkDemuxer::ChunkDemuxer(ChunkDemuxerClient* client)
     : state_(WAITING_FOR_INIT),
       host_(NULL),
       client_(client),
-      buffered_bytes_(0),
-      seek_waits_for_data_(true) {
+      buffered_bytes_(0) {
   DCHECK(client);
 }
 
@@ -411,7 +409,7 @@ void ChunkDemuxer::Seek(base::TimeDelta time, const PipelineStatusCB& cb) {
       if (video_)
         video_->Seek(time);
 
-      if (seek_waits_for_data_) {
+      if (IsSeekPending_Locked()) {
         DVLOG(1) << "Seek() : waiting for more data to arrive.";
         seek_cb_ = cb;
         return;
@@ -477,7 +475,6 @@ void ChunkDemuxer::FlushData() {
 
   source_buffer_->Flush();
 
-  seek_waits_for_data_ = true;
   ChangeState_Locked(INITIALIZED);
 }
 
@@ -508,33 +505,18 @@ bool ChunkDemuxer::GetBufferedRanges(const std::string& id,
   DCHECK(ranges_out);
 
   base::AutoLock auto_lock(lock_);
-  base::TimeDelta start = kNoTimestamp();
-  base::TimeDelta end;
-  base::TimeDelta tmp_start;
-  base::TimeDelta tmp_end;
-
-  if (audio_ && audio_->GetBufferedRange(&tmp_start, &tmp_end)) {
-    start = tmp_start;
-    end = tmp_end;
-  }
-
-  if (video_ && video_->GetBufferedRange(&tmp_start, &tmp_end)) {
-    if (start == kNoTimestamp()) {
-      start = tmp_start;
-      end = tmp_end;
-    } else {
-      start = std::min(start, tmp_start);
-      end = std::max(end, tmp_end);
-    }
+  if (audio_ && video_) {
+    *ranges_out = ComputeIntersection(audio_->GetBufferedRanges(),
+                                      video_->GetBufferedRanges());
+  } else if (audio_) {
+    *ranges_out = audio_->GetBufferedRanges();
+  } else if (video_) {
+    *ranges_out = video_->GetBufferedRanges();
+  } else {
+    ranges_out->clear();
   }
 
-  if (start == kNoTimestamp())
-    return false;
-
-  ranges_out->resize(1);
-  (*ranges_out)[0].first = start;
-  (*ranges_out)[0].second = end;
-  return true;
+  return !ranges_out->empty();
 }
 
 bool ChunkDemuxer::AppendData(const std::string& id,
@@ -559,11 +541,6 @@ bool ChunkDemuxer::AppendData(const std::string& id,
   {
     base::AutoLock auto_lock(lock_);
 
-    // Capture |seek_waits_for_data_| state before we start parsing.
-    // Its state can be changed by OnAudioBuffers() or OnVideoBuffers()
-    // calls during the parse.
-    bool old_seek_waits_for_data = seek_waits_for_data_;
-
     switch (state_) {
       case INITIALIZING:
         if (!source_buffer_->AppendData(data, length)) {
@@ -588,12 +565,10 @@ bool ChunkDemuxer::AppendData(const std::string& id,
         return false;
     }
 
-    // Check to see if parsing triggered seek_waits_for_data_ to go from true to
-    // false. This indicates we have parsed enough data to complete the seek.
-    if (old_seek_waits_for_data && !seek_waits_for_data_ &&
-        !seek_cb_.is_null()) {
+    // Check to see if parsing provided the data a pending seek was waiting
+    // for.
+    if (!seek_cb_.is_null() && !IsSeekPending_Locked())
       std::swap(cb, seek_cb_);
-    }
 
     base::TimeDelta tmp;
     if (audio_.get() && audio_->GetLastBufferTimestamp(&tmp) &&
@@ -696,6 +671,38 @@ void ChunkDemuxer::Shutdown() {
   client_->DemuxerClosed();
 }
 
+bool ChunkDemuxer::IsSeekPending_Locked() const {
+  lock_.AssertAcquired();
+
+  // The seek completes as soon as any stream has data for it.
+  if (audio_ && !audio_->IsSeekPending())
+    return false;
+  if (video_ && !video_->IsSeekPending())
+    return false;
+  return true;
+}
+
+// static
+ChunkDemuxer::Ranges ChunkDemuxer::ComputeIntersection(const Ranges& a,
+                                                       const Ranges& b) {
+  Ranges result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < a.size() && j < b.size()) {
+    base::TimeDelta start = std::max(a[i].first, b[j].first);
+    base::TimeDelta end = std::min(a[i].second, b[j].second);
+    if (start < end)
+      result.push_back(std::make_pair(start, end));
+
+    // Move past whichever range ends first.
+    if (a[i].second < b[j].second)
+      ++i;
+    else
+      ++j;
+  }
+  return result;
+}
+
 void ChunkDemuxer::ChangeState_Locked(State new_state) {
   lock_.AssertAcquired();
   state_ = new_state;
@@ -783,7 +790,6 @@ bool ChunkDemuxer::OnAudioBuffers(const StreamParser::BufferQueue& buffers) {
     return false;
 
   audio_->AddBuffers(buffers);
-  seek_waits_for_data_ = false;
 
   return true;
 }
@@ -796,7 +802,6 @@ bool ChunkDemuxer::OnVideoBuffers(const StreamParser::BufferQueue& buffers) {
     return false;
 
   video_->AddBuffers(buffers);
-  seek_waits_for_data_ = false;
 
   return true;
 }
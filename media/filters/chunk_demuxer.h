@@ -65,7 +65,8 @@ class MEDIA_EXPORT ChunkDemuxer : public Demuxer {
   // AddId().
   void RemoveId(const std::string& id);
 
-  // Gets the currently buffered ranges for the specified ID.
+  // Gets the currently buffered ranges for the specified ID. When there is
+  // both audio and video, only the times buffered for both are reported.
   // Returns true if data is buffered & |ranges_out| is set to the
   // time ranges currently buffered.
   // Returns false if no data is buffered.
@@ -101,6 +102,13 @@ class MEDIA_EXPORT ChunkDemuxer : public Demuxer {
 
   void OnSourceBufferInitDone(bool success, base::TimeDelta duration);
 
+  // Returns true if no stream has the data to complete the last Seek().
+  bool IsSeekPending_Locked() const;
+
+  // Returns the time ranges present in both |a| and |b|, which must each be
+  // sorted and disjoint.
+  static Ranges ComputeIntersection(const Ranges& a, const Ranges& b);
+
   // SourceBuffer callbacks.
   bool OnNewConfigs(const AudioDecoderConfig& audio_config,
                     const VideoDecoderConfig& video_config);
@@ -125,10 +133,6 @@ class MEDIA_EXPORT ChunkDemuxer : public Demuxer {
 
   scoped_ptr<SourceBuffer> source_buffer_;
 
-  // Should a Seek() call wait for more data before calling the
-  // callback.
-  bool seek_waits_for_data_;
-
   // TODO(acolwell): Remove this when fixing http://crbug.com/122909
   std::string source_id_;
 
@@ -5,6 +5,7 @@
 #include "media/filters/ffmpeg_audio_decoder.h"
 
 #include "base/bind.h"
+#include "base/debug/trace_event.h"
 #include "media/base/audio_decoder_config.h"
 #include "media/base/data_buffer.h"
 #include "media/base/demuxer.h"
@@ -200,11 +201,20 @@ void FFmpegAudioDecoder::DoDecodeBuffer(const scoped_refptr<Buffer>& input) {
 
   PipelineStatistics statistics;
   statistics.audio_bytes_decoded = input->GetDataSize();
+  base::TimeTicks decode_start_time = base::TimeTicks::HighResNow();
+  statistics.audio_demuxer_wait_time =
+      decode_start_time - demuxer_read_start_time_;
 
   int decoded_audio_size = decoded_audio_size_;
-  int result = avcodec_decode_audio3(
-      codec_context_, reinterpret_cast<int16_t*>(decoded_audio_),
-      &decoded_audio_size, &packet);
+  int result;
+  {
+    TRACE_EVENT0("media", "FFmpegAudioDecoder::Decode");
+    result = avcodec_decode_audio3(
+        codec_context_, reinterpret_cast<int16_t*>(decoded_audio_),
+        &decoded_audio_size, &packet);
+  }
+  statistics.audio_decode_time =
+      base::TimeTicks::HighResNow() - decode_start_time;
 
   if (IsErrorResult(result, decoded_audio_size)) {
     DCHECK(!input->IsEndOfStream())
@@ -253,6 +263,7 @@ void FFmpegAudioDecoder::DoDecodeBuffer(const scoped_refptr<Buffer>& input) {
 void FFmpegAudioDecoder::ReadFromDemuxerStream() {
   DCHECK(!read_cb_.is_null());
 
+  demuxer_read_start_time_ = base::TimeTicks::HighResNow();
   demuxer_stream_->Read(base::Bind(&FFmpegAudioDecoder::DecodeBuffer, this));
 }
 
@@ -71,6 +71,9 @@ class MEDIA_EXPORT FFmpegAudioDecoder : public AudioDecoder {
 
   base::TimeDelta estimated_next_timestamp_;
 
+  // When the pending read from |demuxer_stream_| was issued.
+  base::TimeTicks demuxer_read_start_time_;
+
   // Holds decoded audio. As required by FFmpeg, input/output buffers should
   // be allocated with suitable padding and alignment. av_malloc() provides
   // us that guarantee.
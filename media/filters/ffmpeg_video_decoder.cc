@@ -7,6 +7,7 @@
 #include "base/bind.h"
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
+#include "base/debug/trace_event.h"
 #include "base/message_loop.h"
 #include "base/string_number_conversions.h"
 #include "media/base/demuxer_stream.h"
@@ -15,7 +16,7 @@
 #include "media/base/pipeline.h"
 #include "media/base/video_decoder_config.h"
 #include "media/base/video_frame.h"
-#include "media/base/video_util.h"
+#include "media/base/video_frame_pool.h"
 #include "media/ffmpeg/ffmpeg_common.h"
 
 namespace media {
@@ -56,7 +57,67 @@ FFmpegVideoDecoder::FFmpegVideoDecoder(
       codec_context_(NULL),
       av_frame_(NULL),
       frame_rate_numerator_(0),
-      frame_rate_denominator_(0) {
+      frame_rate_denominator_(0),
+      frame_pool_(new VideoFramePool) {
+}
+
+int FFmpegVideoDecoder::GetVideoBuffer(AVCodecContext* codec_context,
+                                       AVFrame* frame) {
+  // Don't use |codec_context_| here! With threaded decoding, this may be
+  // called on a decoding thread's copy of it.
+  VideoFrame::Format format = PixelFormatToVideoFormat(codec_context->pix_fmt);
+  if (format == VideoFrame::INVALID)
+    return AVERROR(EINVAL);
+  DCHECK(format == VideoFrame::YV12 || format == VideoFrame::YV16);
+
+  int width = codec_context->width;
+  int height = codec_context->height;
+  if (!VideoFrame::IsValidConfig(format, width, height))
+    return AVERROR(EINVAL);
+
+  // Decoders write whole macroblocks, and some of them read a line past the
+  // last one; this works out how much room that takes for this codec.
+  int coded_width = width;
+  int coded_height = height;
+  int linesize_align[AV_NUM_DATA_POINTERS];
+  avcodec_align_dimensions2(codec_context, &coded_width, &coded_height,
+                            linesize_align);
+  DCHECK_EQ(VideoFramePool::kFrameAlignment % linesize_align[0], 0);
+
+  scoped_refptr<VideoFrame> video_frame = frame_pool_->CreateFrame(
+      format, width, height, coded_width, coded_height);
+
+  for (int i = 0; i < 3; ++i) {
+    frame->base[i] = video_frame->data(i);
+    frame->data[i] = video_frame->data(i);
+    frame->linesize[i] = video_frame->stride(i);
+  }
+
+  // The AVFrame holds a reference to |video_frame| until FFmpeg releases it.
+  frame->opaque = video_frame.get();
+  video_frame->AddRef();
+
+  frame->type = FF_BUFFER_TYPE_USER;
+  frame->reordered_opaque = codec_context->reordered_opaque;
+  frame->pkt_pts =
+      codec_context->pkt ? codec_context->pkt->pts : AV_NOPTS_VALUE;
+  frame->width = width;
+  frame->height = height;
+  frame->format = codec_context->pix_fmt;
+  return 0;
+}
+
+static int GetVideoBufferImpl(AVCodecContext* s, AVFrame* frame) {
+  FFmpegVideoDecoder* decoder = static_cast<FFmpegVideoDecoder*>(s->opaque);
+  return decoder->GetVideoBuffer(s, frame);
+}
+
+static void ReleaseVideoBufferImpl(AVCodecContext* s, AVFrame* frame) {
+  static_cast<VideoFrame*>(frame->opaque)->Release();
+  frame->opaque = NULL;
+
+  // The FFmpeg API expects us to zero the data pointers in this callback.
+  memset(frame->data, 0, sizeof(frame->data));
 }
 
 FFmpegVideoDecoder::~FFmpegVideoDecoder() {
@@ -106,6 +167,17 @@ void FFmpegVideoDecoder::Initialize(const scoped_refptr<DemuxerStream>& stream,
   codec_context_->error_concealment = FF_EC_GUESS_MVS | FF_EC_DEBLOCK;
   codec_context_->err_recognition = AV_EF_CAREFUL;
   codec_context_->thread_count = GetThreadCount(codec_context_->codec_id);
+  // Decode several frames at once where the codec supports it, falling back
+  // to slices otherwise.
+  codec_context_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+  // Decode straight into VideoFrames from |frame_pool_|, instead of copying
+  // out of FFmpeg's own buffers. Skipping the edge emulation borders keeps
+  // the frames the size of the picture.
+  codec_context_->opaque = this;
+  codec_context_->flags |= CODEC_FLAG_EMU_EDGE;
+  codec_context_->get_buffer = GetVideoBufferImpl;
+  codec_context_->release_buffer = ReleaseVideoBufferImpl;
 
   AVCodec* codec = avcodec_find_decoder(codec_context_->codec_id);
   if (!codec) {
@@ -175,6 +247,19 @@ const gfx::Size& FFmpegVideoDecoder::natural_size() {
   return natural_size_;
 }
 
+void FFmpegVideoDecoder::SkipNonReferenceFrames(bool skip) {
+  if (MessageLoop::current() != message_loop_) {
+    message_loop_->PostTask(FROM_HERE, base::Bind(
+        &FFmpegVideoDecoder::SkipNonReferenceFrames, this, skip));
+    return;
+  }
+
+  // FFmpeg then returns no picture for the packets it discards, and
+  // DoDecodeBuffer() reads on to the next one.
+  if (codec_context_)
+    codec_context_->skip_frame = skip ? AVDISCARD_NONREF : AVDISCARD_DEFAULT;
+}
+
 AesDecryptor* FFmpegVideoDecoder::decryptor() {
   return &decryptor_;
 }
@@ -205,6 +290,7 @@ void FFmpegVideoDecoder::ReadFromDemuxerStream() {
   DCHECK_NE(state_, kDecodeFinished);
   DCHECK(!read_cb_.is_null());
 
+  demuxer_read_start_time_ = base::TimeTicks::HighResNow();
   demuxer_stream_->Read(base::Bind(&FFmpegVideoDecoder::DecodeBuffer, this));
 }
 
@@ -272,6 +358,7 @@ void FFmpegVideoDecoder::DoDecodeBuffer(const scoped_refptr<Buffer>& buffer) {
     }
   }
 
+  base::TimeTicks decode_start_time = base::TimeTicks::HighResNow();
   scoped_refptr<VideoFrame> video_frame;
   if (!Decode(unencrypted_buffer, &video_frame)) {
     state_ = kDecodeFinished;
@@ -283,6 +370,10 @@ void FFmpegVideoDecoder::DoDecodeBuffer(const scoped_refptr<Buffer>& buffer) {
   if (buffer->GetDataSize()) {
     PipelineStatistics statistics;
     statistics.video_bytes_decoded = buffer->GetDataSize();
+    statistics.video_demuxer_wait_time =
+        decode_start_time - demuxer_read_start_time_;
+    statistics.video_decode_time =
+        base::TimeTicks::HighResNow() - decode_start_time;
     statistics_cb_.Run(statistics);
   }
 
@@ -321,6 +412,7 @@ bool FFmpegVideoDecoder::Decode(
   // |av_frame_->reordered_opaque|
   av_frame_->reordered_opaque = codec_context_->reordered_opaque;
 
+  TRACE_EVENT0("media", "FFmpegVideoDecoder::Decode");
   int frame_decoded = 0;
   int result = avcodec_decode_video2(codec_context_,
                                      av_frame_,
@@ -347,7 +439,7 @@ bool FFmpegVideoDecoder::Decode(
 
   // TODO(fbarchard): Work around for FFmpeg http://crbug.com/27675
   // The decoder is in a bad state and not decoding correctly.
-  // Checking for NULL avoids a crash in CopyPlane().
+  // Checking for NULL avoids handing out a frame with no planes.
   if (!av_frame_->data[VideoFrame::kYPlane] ||
       !av_frame_->data[VideoFrame::kUPlane] ||
       !av_frame_->data[VideoFrame::kVPlane]) {
@@ -356,13 +448,15 @@ bool FFmpegVideoDecoder::Decode(
     return false;
   }
 
-  // We've got a frame! Make sure we have a place to store it.
-  *video_frame = AllocateVideoFrame();
-  if (!(*video_frame)) {
-    LOG(ERROR) << "Failed to allocate video frame";
+  if (!av_frame_->opaque) {
+    LOG(ERROR) << "VideoFrame object associated with frame data not set.";
+    *video_frame = NULL;
     return false;
   }
 
+  // FFmpeg decoded straight into this frame, and won't write to it again.
+  *video_frame = static_cast<VideoFrame*>(av_frame_->opaque);
+
   // Determine timestamp and calculate the duration based on the repeat picture
   // count.  According to FFmpeg docs, the total duration can be calculated as
   // follows:
@@ -381,19 +475,6 @@ bool FFmpegVideoDecoder::Decode(
   (*video_frame)->SetDuration(
       ConvertFromTimeBase(doubled_time_base, 2 + av_frame_->repeat_pict));
 
-  // Copy the frame data since FFmpeg reuses internal buffers for AVFrame
-  // output, meaning the data is only valid until the next
-  // avcodec_decode_video() call.
-  int y_rows = codec_context_->height;
-  int uv_rows = codec_context_->height;
-  if (codec_context_->pix_fmt == PIX_FMT_YUV420P) {
-    uv_rows /= 2;
-  }
-
-  CopyYPlane(av_frame_->data[0], av_frame_->linesize[0], y_rows, *video_frame);
-  CopyUPlane(av_frame_->data[1], av_frame_->linesize[1], uv_rows, *video_frame);
-  CopyVPlane(av_frame_->data[2], av_frame_->linesize[2], uv_rows, *video_frame);
-
   return true;
 }
 
@@ -416,13 +497,4 @@ void FFmpegVideoDecoder::ReleaseFFmpegResources() {
   }
 }
 
-scoped_refptr<VideoFrame> FFmpegVideoDecoder::AllocateVideoFrame() {
-  VideoFrame::Format format = PixelFormatToVideoFormat(codec_context_->pix_fmt);
-  size_t width = codec_context_->width;
-  size_t height = codec_context_->height;
-
-  return VideoFrame::CreateFrame(format, width, height,
-                                 kNoTimestamp(), kNoTimestamp());
-}
-
 }  // namespace media
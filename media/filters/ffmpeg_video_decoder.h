@@ -19,6 +19,8 @@ struct AVFrame;
 
 namespace media {
 
+class VideoFramePool;
+
 class MEDIA_EXPORT FFmpegVideoDecoder : public VideoDecoder {
  public:
   FFmpegVideoDecoder(const base::Callback<MessageLoop*()>& message_loop_cb);
@@ -32,9 +34,15 @@ class MEDIA_EXPORT FFmpegVideoDecoder : public VideoDecoder {
   virtual void Reset(const base::Closure& closure) OVERRIDE;
   virtual void Stop(const base::Closure& closure) OVERRIDE;
   virtual const gfx::Size& natural_size() OVERRIDE;
+  virtual void SkipNonReferenceFrames(bool skip) OVERRIDE;
 
   AesDecryptor* decryptor();
 
+  // Callback called from within FFmpeg to allocate a buffer based on
+  // the dimensions of |codec_context|. See AVCodecContext.get_buffer
+  // documentation inside FFmpeg.
+  int GetVideoBuffer(AVCodecContext* codec_context, AVFrame* frame);
+
  private:
   enum DecoderState {
     kUninitialized,
@@ -65,10 +73,6 @@ class MEDIA_EXPORT FFmpegVideoDecoder : public VideoDecoder {
   // Reset decoder and call |reset_cb_|.
   void DoReset();
 
-  // Allocates a video frame based on the current format and dimensions based on
-  // the current state of |codec_context_|.
-  scoped_refptr<VideoFrame> AllocateVideoFrame();
-
   // This is !is_null() iff Initialize() hasn't been called.
   base::Callback<MessageLoop*()> message_loop_factory_cb_;
 
@@ -96,8 +100,15 @@ class MEDIA_EXPORT FFmpegVideoDecoder : public VideoDecoder {
   // Pointer to the demuxer stream that will feed us compressed buffers.
   scoped_refptr<DemuxerStream> demuxer_stream_;
 
+  // When the pending read from |demuxer_stream_| was issued.
+  base::TimeTicks demuxer_read_start_time_;
+
   AesDecryptor decryptor_;
 
+  // Backs the buffers FFmpeg decodes into. Frames handed out downstream keep
+  // it alive after the decoder is gone.
+  scoped_refptr<VideoFramePool> frame_pool_;
+
   DISALLOW_COPY_AND_ASSIGN(FFmpegVideoDecoder);
 };
 
@@ -0,0 +1,471 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/filters/source_buffer_stream.h"
+
+#include <algorithm>
+#include <map>
+
+#include "base/logging.h"
+#include "base/stl_util.h"
+
+namespace media {
+
+// Spacing assumed between buffers whose duration is unknown when a range
+// holds too few buffers to tell.
+static const int kDefaultBufferDurationInMs = 125;
+
+static bool BufferTimestampLessThan(
+    const scoped_refptr<StreamParserBuffer>& buffer,
+    base::TimeDelta timestamp) {
+  return buffer->GetTimestamp() < timestamp;
+}
+
+// A run of buffers with increasing timestamps that are read in sequence,
+// with their keyframes indexed by timestamp.
+class SourceBufferRange {
+ public:
+  SourceBufferRange();
+
+  // Appends |buffer|, which must be later than every buffer in the range. The
+  // first buffer of a range is always a seek point, keyframe or not.
+  void Append(const scoped_refptr<StreamParserBuffer>& buffer);
+
+  // Moves the read position to the keyframe at or before |timestamp|, or to
+  // the start of the range if |timestamp| precedes it.
+  void Seek(base::TimeDelta timestamp);
+
+  // Moves the read position past the last buffer, so that the next buffer
+  // appended is the next one read.
+  void SeekToEnd() { next_buffer_index_ = buffers_.size(); }
+
+  void ClearReadPosition() { next_buffer_index_ = -1; }
+  bool has_read_position() const { return next_buffer_index_ >= 0; }
+
+  // Sets |out_buffer| to the buffer at the read position and advances it.
+  // Returns false if the read position is at the end of the range.
+  bool GetNextBuffer(scoped_refptr<StreamParserBuffer>* out_buffer);
+
+  // Removes the buffers at or after |timestamp|. A read position in the
+  // removed part moves to the new end of the range, where the buffers
+  // replacing them will be appended. Returns the number of bytes freed.
+  int TruncateAt(base::TimeDelta timestamp);
+
+  // Removes the buffers up to and including |timestamp|, along with the
+  // buffers depending on them up to the next keyframe. A read position in the
+  // removed part is cleared. Returns the number of bytes freed.
+  int DeleteUpTo(base::TimeDelta timestamp);
+
+  // Removes the first GOP unless it is the only one or holds the read
+  // position. Returns the number of bytes freed.
+  int DeleteFirstGOP();
+
+  // Returns true if a buffer at |timestamp| would carry on from the end of
+  // this range.
+  bool IsAdjacentTo(base::TimeDelta timestamp) const;
+
+  bool empty() const { return buffers_.empty(); }
+  int size_in_bytes() const { return size_in_bytes_; }
+  base::TimeDelta start_timestamp() const;
+  base::TimeDelta last_timestamp() const;
+
+  // Returns the timestamp just past the last buffer.
+  base::TimeDelta GetEndTimestamp() const;
+
+ private:
+  typedef std::deque<scoped_refptr<StreamParserBuffer> > BufferQueue;
+
+  // Maps the timestamp of each seek point to its index in |buffers_| plus
+  // |keyframe_index_base_|, which grows as buffers are removed from the front
+  // so that the remaining entries need not be rewritten.
+  typedef std::map<base::TimeDelta, int> KeyframeMap;
+
+  // Returns the duration of the last buffer, or an estimate of it.
+  base::TimeDelta GetBufferDuration() const;
+
+  // Removes the first |count| buffers.
+  void EraseFront(int count);
+
+  BufferQueue buffers_;
+  KeyframeMap keyframe_map_;
+  int keyframe_index_base_;
+
+  // Index in |buffers_| of the next buffer to read, -1 if none.
+  int next_buffer_index_;
+
+  int size_in_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(SourceBufferRange);
+};
+
+SourceBufferRange::SourceBufferRange()
+    : keyframe_index_base_(0),
+      next_buffer_index_(-1),
+      size_in_bytes_(0) {
+}
+
+void SourceBufferRange::Append(
+    const scoped_refptr<StreamParserBuffer>& buffer) {
+  DCHECK(buffers_.empty() || buffer->GetTimestamp() > last_timestamp());
+
+  if (buffers_.empty() || buffer->IsKeyframe()) {
+    keyframe_map_[buffer->GetTimestamp()] =
+        keyframe_index_base_ + buffers_.size();
+  }
+  buffers_.push_back(buffer);
+  size_in_bytes_ += buffer->GetDataSize();
+}
+
+void SourceBufferRange::Seek(base::TimeDelta timestamp) {
+  if (keyframe_map_.empty()) {
+    next_buffer_index_ = 0;
+    return;
+  }
+
+  KeyframeMap::const_iterator it = keyframe_map_.upper_bound(timestamp);
+  if (it != keyframe_map_.begin())
+    --it;
+  next_buffer_index_ = it->second - keyframe_index_base_;
+}
+
+bool SourceBufferRange::GetNextBuffer(
+    scoped_refptr<StreamParserBuffer>* out_buffer) {
+  if (next_buffer_index_ < 0 ||
+      next_buffer_index_ >= static_cast<int>(buffers_.size())) {
+    return false;
+  }
+
+  *out_buffer = buffers_[next_buffer_index_++];
+  return true;
+}
+
+int SourceBufferRange::TruncateAt(base::TimeDelta timestamp) {
+  BufferQueue::iterator first_removed = std::lower_bound(
+      buffers_.begin(), buffers_.end(), timestamp, BufferTimestampLessThan);
+
+  int bytes_freed = 0;
+  for (BufferQueue::iterator it = first_removed; it != buffers_.end(); ++it)
+    bytes_freed += (*it)->GetDataSize();
+  buffers_.erase(first_removed, buffers_.end());
+  size_in_bytes_ -= bytes_freed;
+
+  keyframe_map_.erase(keyframe_map_.lower_bound(timestamp),
+                      keyframe_map_.end());
+
+  int size = buffers_.size();
+  if (next_buffer_index_ > size)
+    next_buffer_index_ = size;
+  return bytes_freed;
+}
+
+int SourceBufferRange::DeleteUpTo(base::TimeDelta timestamp) {
+  KeyframeMap::const_iterator next_keyframe =
+      keyframe_map_.upper_bound(timestamp);
+  int count = buffers_.size();
+  if (next_keyframe != keyframe_map_.end())
+    count = next_keyframe->second - keyframe_index_base_;
+
+  int bytes_before = size_in_bytes_;
+  EraseFront(count);
+  return bytes_before - size_in_bytes_;
+}
+
+int SourceBufferRange::DeleteFirstGOP() {
+  if (keyframe_map_.size() < 2)
+    return 0;
+
+  KeyframeMap::const_iterator second_keyframe = keyframe_map_.begin();
+  ++second_keyframe;
+  int count = second_keyframe->second - keyframe_index_base_;
+  if (has_read_position() && next_buffer_index_ < count)
+    return 0;
+
+  int bytes_before = size_in_bytes_;
+  EraseFront(count);
+  return bytes_before - size_in_bytes_;
+}
+
+bool SourceBufferRange::IsAdjacentTo(base::TimeDelta timestamp) const {
+  return !buffers_.empty() && timestamp > last_timestamp() &&
+      timestamp <= GetEndTimestamp() + GetBufferDuration();
+}
+
+base::TimeDelta SourceBufferRange::start_timestamp() const {
+  DCHECK(!buffers_.empty());
+  return buffers_.front()->GetTimestamp();
+}
+
+base::TimeDelta SourceBufferRange::last_timestamp() const {
+  DCHECK(!buffers_.empty());
+  return buffers_.back()->GetTimestamp();
+}
+
+base::TimeDelta SourceBufferRange::GetEndTimestamp() const {
+  return last_timestamp() + GetBufferDuration();
+}
+
+base::TimeDelta SourceBufferRange::GetBufferDuration() const {
+  DCHECK(!buffers_.empty());
+  base::TimeDelta duration = buffers_.back()->GetDuration();
+  if (duration > base::TimeDelta())
+    return duration;
+
+  if (buffers_.size() < 2)
+    return base::TimeDelta::FromMilliseconds(kDefaultBufferDurationInMs);
+
+  // The average spacing of the buffers.
+  return (last_timestamp() - start_timestamp()) /
+      static_cast<int64>(buffers_.size() - 1);
+}
+
+void SourceBufferRange::EraseFront(int count) {
+  DCHECK_LE(count, static_cast<int>(buffers_.size()));
+  for (int i = 0; i < count; ++i) {
+    size_in_bytes_ -= buffers_.front()->GetDataSize();
+    buffers_.pop_front();
+  }
+
+  keyframe_index_base_ += count;
+  while (!keyframe_map_.empty() &&
+         keyframe_map_.begin()->second < keyframe_index_base_) {
+    keyframe_map_.erase(keyframe_map_.begin());
+  }
+
+  if (has_read_position()) {
+    next_buffer_index_ = next_buffer_index_ < count ?
+        -1 : next_buffer_index_ - count;
+  }
+}
+
+SourceBufferStream::SourceBufferStream(int memory_limit)
+    : selected_range_(NULL),
+      seek_pending_(true),
+      append_range_(NULL),
+      segment_start_range_(NULL),
+      memory_limit_(memory_limit),
+      buffered_bytes_(0) {
+}
+
+SourceBufferStream::~SourceBufferStream() {
+  STLDeleteElements(&ranges_);
+}
+
+void SourceBufferStream::Append(
+    const scoped_refptr<StreamParserBuffer>& buffer) {
+  DCHECK(!buffer->IsEndOfStream());
+  base::TimeDelta timestamp = buffer->GetTimestamp();
+
+  if (!append_range_) {
+    StartSegment(buffer);
+    segment_start_range_ = append_range_;
+    segment_start_timestamp_ = timestamp;
+  }
+  DCHECK(append_range_->empty() ||
+         timestamp > append_range_->last_timestamp());
+
+  // Remove what the later ranges hold of the time this buffer replaces. If
+  // that includes the read position, reading carries on from this buffer.
+  RangeList::iterator next =
+      std::find(ranges_.begin(), ranges_.end(), append_range_);
+  DCHECK(next != ranges_.end());
+  ++next;
+  while (next != ranges_.end() && (*next)->start_timestamp() <= timestamp) {
+    SourceBufferRange* range = *next;
+    buffered_bytes_ -= range->DeleteUpTo(timestamp);
+    if (range == selected_range_ && !range->has_read_position()) {
+      selected_range_ = append_range_;
+      selected_range_->SeekToEnd();
+    }
+    if (!range->empty())
+      break;
+    next = DeleteRange(next);
+  }
+
+  append_range_->Append(buffer);
+  buffered_bytes_ += buffer->GetDataSize();
+
+  if (seek_pending_) {
+    selected_range_ = append_range_;
+    selected_range_->Seek(timestamp);
+    seek_pending_ = false;
+  }
+
+  GarbageCollect();
+}
+
+void SourceBufferStream::Flush() {
+  if (selected_range_)
+    selected_range_->ClearReadPosition();
+  selected_range_ = NULL;
+  seek_pending_ = true;
+  append_range_ = NULL;
+  segment_start_range_ = NULL;
+}
+
+void SourceBufferStream::Seek(base::TimeDelta timestamp) {
+  if (selected_range_)
+    selected_range_->ClearReadPosition();
+  selected_range_ = NULL;
+
+  RangeList::iterator it = FindRangeContaining(timestamp);
+  if (it != ranges_.end()) {
+    selected_range_ = *it;
+    selected_range_->Seek(timestamp);
+  } else if (segment_start_range_) {
+    selected_range_ = segment_start_range_;
+    selected_range_->Seek(segment_start_timestamp_);
+  }
+
+  seek_pending_ = !selected_range_;
+}
+
+bool SourceBufferStream::IsSeekPending() const {
+  return seek_pending_;
+}
+
+bool SourceBufferStream::GetNextBuffer(
+    scoped_refptr<StreamParserBuffer>* out_buffer) {
+  if (!selected_range_)
+    return false;
+
+  if (selected_range_->GetNextBuffer(out_buffer))
+    return true;
+
+  // Carry on into the next range if it follows on from this one.
+  RangeList::iterator next =
+      std::find(ranges_.begin(), ranges_.end(), selected_range_);
+  DCHECK(next != ranges_.end());
+  ++next;
+  if (next == ranges_.end() ||
+      !selected_range_->IsAdjacentTo((*next)->start_timestamp())) {
+    return false;
+  }
+
+  selected_range_->ClearReadPosition();
+  selected_range_ = *next;
+  selected_range_->Seek(selected_range_->start_timestamp());
+  return selected_range_->GetNextBuffer(out_buffer);
+}
+
+SourceBufferStream::Ranges SourceBufferStream::GetBufferedRanges() const {
+  Ranges ranges;
+  const SourceBufferRange* previous = NULL;
+  for (RangeList::const_iterator it = ranges_.begin(); it != ranges_.end();
+       ++it) {
+    const SourceBufferRange* range = *it;
+    if (range->empty())
+      continue;
+
+    if (previous && previous->IsAdjacentTo(range->start_timestamp())) {
+      ranges.back().second = range->GetEndTimestamp();
+    } else {
+      ranges.push_back(std::make_pair(range->start_timestamp(),
+                                      range->GetEndTimestamp()));
+    }
+    previous = range;
+  }
+  return ranges;
+}
+
+SourceBufferStream::RangeList::iterator
+SourceBufferStream::FindRangeContaining(base::TimeDelta timestamp) {
+  for (RangeList::iterator it = ranges_.begin(); it != ranges_.end(); ++it) {
+    SourceBufferRange* range = *it;
+    if (range->empty() || range->start_timestamp() > timestamp)
+      continue;
+    if (timestamp < range->GetEndTimestamp())
+      return it;
+  }
+  return ranges_.end();
+}
+
+void SourceBufferStream::StartSegment(
+    const scoped_refptr<StreamParserBuffer>& buffer) {
+  DCHECK(!append_range_);
+  base::TimeDelta timestamp = buffer->GetTimestamp();
+
+  // A segment starting inside a range replaces the rest of it.
+  RangeList::iterator it = FindRangeContaining(timestamp);
+  if (it != ranges_.end()) {
+    append_range_ = *it;
+    buffered_bytes_ -= append_range_->TruncateAt(timestamp);
+    return;
+  }
+
+  // Otherwise it either carries on from the range before it, or starts a new
+  // one.
+  RangeList::iterator next = ranges_.begin();
+  while (next != ranges_.end() && (*next)->start_timestamp() < timestamp)
+    ++next;
+
+  if (next != ranges_.begin()) {
+    RangeList::iterator previous = next;
+    --previous;
+    if ((*previous)->IsAdjacentTo(timestamp)) {
+      append_range_ = *previous;
+      return;
+    }
+  }
+
+  append_range_ = new SourceBufferRange();
+  ranges_.insert(next, append_range_);
+}
+
+SourceBufferStream::RangeList::iterator SourceBufferStream::DeleteRange(
+    RangeList::iterator range) {
+  DCHECK_NE(*range, selected_range_);
+  DCHECK_NE(*range, append_range_);
+
+  if (*range == segment_start_range_)
+    segment_start_range_ = NULL;
+  buffered_bytes_ -= (*range)->size_in_bytes();
+  delete *range;
+  return ranges_.erase(range);
+}
+
+void SourceBufferStream::GarbageCollect() {
+  while (buffered_bytes_ > memory_limit_) {
+    // The oldest range behind the read position goes first.
+    bool freed = false;
+    for (RangeList::iterator it = ranges_.begin();
+         it != ranges_.end() && *it != selected_range_; ++it) {
+      if (*it == append_range_)
+        continue;
+      DeleteRange(it);
+      freed = true;
+      break;
+    }
+    if (freed)
+      continue;
+
+    // Then the GOPs already read from the range being read, or from the range
+    // being appended to if nothing is being read.
+    SourceBufferRange* range =
+        selected_range_ ? selected_range_ : append_range_;
+    if (range) {
+      int bytes_freed = range->DeleteFirstGOP();
+      if (bytes_freed > 0) {
+        buffered_bytes_ -= bytes_freed;
+        continue;
+      }
+    }
+
+    // Finally the range furthest ahead of the read position.
+    RangeList::iterator it = ranges_.end();
+    while (it != ranges_.begin()) {
+      --it;
+      if (*it == selected_range_)
+        break;
+      if (*it == append_range_)
+        continue;
+      DeleteRange(it);
+      freed = true;
+      break;
+    }
+    if (!freed)
+      break;
+  }
+}
+
+}  // namespace media
@@ -0,0 +1,116 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// SourceBufferStream holds the buffers appended to one stream of a
+// SourceBuffer and hands them out in decode order from a seek point.
+//
+// Buffers are kept in disjoint ranges sorted by timestamp. Each range indexes
+// its keyframes by timestamp, so seeking within buffered data is a binary
+// search instead of a walk over every buffer. Data appended over a time span
+// that is already buffered replaces the older data. Once the buffers held
+// exceed a memory limit, whole ranges and then GOPs furthest behind the read
+// position are evicted; data ahead of the read position in its range never is.
+
+#ifndef MEDIA_FILTERS_SOURCE_BUFFER_STREAM_H_
+#define MEDIA_FILTERS_SOURCE_BUFFER_STREAM_H_
+
+#include <deque>
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/time.h"
+#include "media/base/media_export.h"
+#include "media/base/stream_parser_buffer.h"
+
+namespace media {
+
+class SourceBufferRange;
+
+// Not thread safe; ChunkDemuxerStream calls it under its lock.
+class MEDIA_EXPORT SourceBufferStream {
+ public:
+  typedef std::vector<std::pair<base::TimeDelta, base::TimeDelta> > Ranges;
+
+  // |memory_limit| is the number of bytes of buffer data to hold before
+  // evicting older data.
+  explicit SourceBufferStream(int memory_limit);
+  ~SourceBufferStream();
+
+  // Appends |buffer|, which must have a timestamp later than the buffer
+  // appended before it since construction or the last Flush(). The first
+  // buffer after either starts a new media segment.
+  void Append(const scoped_refptr<StreamParserBuffer>& buffer);
+
+  // Drops the read position and ends the current media segment, keeping the
+  // buffered data. Reading resumes after the next Seek().
+  void Flush();
+
+  // Moves the read position to the keyframe at or before |timestamp| if it is
+  // buffered. Otherwise moves it to the start of the media segment appended
+  // since the last Flush(), or failing that waits for the next buffer to be
+  // appended.
+  void Seek(base::TimeDelta timestamp);
+
+  // Returns true if the read position is waiting for a buffer to be appended
+  // after a Seek(), or since construction.
+  bool IsSeekPending() const;
+
+  // Sets |out_buffer| to the buffer at the read position and advances it.
+  // Returns false if that buffer has not been appended yet.
+  bool GetNextBuffer(scoped_refptr<StreamParserBuffer>* out_buffer);
+
+  // Returns the buffered time ranges in order. Ranges separated by less than
+  // a buffer's duration are reported as one.
+  Ranges GetBufferedRanges() const;
+
+  int buffered_bytes() const { return buffered_bytes_; }
+
+ private:
+  typedef std::list<SourceBufferRange*> RangeList;
+
+  // Returns the range holding a buffer at or around |timestamp|, or the end of
+  // |ranges_|.
+  RangeList::iterator FindRangeContaining(base::TimeDelta timestamp);
+
+  // Sets |append_range_| to the range |buffer| should be appended to at the
+  // start of a media segment, truncating the buffered data it replaces.
+  void StartSegment(const scoped_refptr<StreamParserBuffer>& buffer);
+
+  // Removes |range| from |ranges_| and deletes it, clearing any member that
+  // refers to it. Returns the iterator following |range|.
+  RangeList::iterator DeleteRange(RangeList::iterator range);
+
+  // Evicts data until |buffered_bytes_| is within |memory_limit_|, or nothing
+  // more can be evicted.
+  void GarbageCollect();
+
+  // Ranges ordered by start timestamp; owned.
+  RangeList ranges_;
+
+  // The range the read position is in, NULL while a seek is pending.
+  SourceBufferRange* selected_range_;
+  bool seek_pending_;
+
+  // The range buffers of the current media segment are appended to, NULL
+  // until the first buffer after construction or Flush().
+  SourceBufferRange* append_range_;
+
+  // Where the current media segment starts, so that a Seek() to unbuffered
+  // time can start from it. |segment_start_range_| is NULL if the segment was
+  // evicted or has no buffers yet.
+  SourceBufferRange* segment_start_range_;
+  base::TimeDelta segment_start_timestamp_;
+
+  int memory_limit_;
+  int buffered_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(SourceBufferStream);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_FILTERS_SOURCE_BUFFER_STREAM_H_
@@ -0,0 +1,225 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/filters/source_buffer_stream.h"
+
+#include <string>
+
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+static const int kBufferDurationInMs = 40;
+static const int kKeyframeInterval = 5;
+static const int kDataSize = 100;
+static const int kMemoryLimit = 1024 * 1024;
+
+class SourceBufferStreamTest : public testing::Test {
+ protected:
+  SourceBufferStreamTest()
+      : stream_(new SourceBufferStream(kMemoryLimit)) {
+  }
+
+  void SetMemoryLimit(int memory_limit) {
+    stream_.reset(new SourceBufferStream(memory_limit));
+  }
+
+  // Appends |count| buffers of |data_size| bytes, starting with buffer number
+  // |first|, with a keyframe every kKeyframeInterval buffers.
+  void Append(int first, int count, int data_size) {
+    uint8 data[kDataSize * 2] = { 0 };
+    CHECK_LE(data_size, static_cast<int>(sizeof(data)));
+    for (int i = first; i < first + count; ++i) {
+      scoped_refptr<StreamParserBuffer> buffer = StreamParserBuffer::CopyFrom(
+          data, data_size, i % kKeyframeInterval == 0);
+      buffer->SetTimestamp(Timestamp(i));
+      stream_->Append(buffer);
+    }
+  }
+
+  void Append(int first, int count) {
+    Append(first, count, kDataSize);
+  }
+
+  // Reads |count| buffers and checks that they are numbered consecutively
+  // from |first|, and have |data_size| bytes each.
+  void ExpectRead(int first, int count, int data_size) {
+    for (int i = first; i < first + count; ++i) {
+      scoped_refptr<StreamParserBuffer> buffer;
+      ASSERT_TRUE(stream_->GetNextBuffer(&buffer)) << "buffer " << i;
+      EXPECT_EQ(Timestamp(i), buffer->GetTimestamp());
+      EXPECT_EQ(data_size, buffer->GetDataSize());
+    }
+  }
+
+  void ExpectRead(int first, int count) {
+    ExpectRead(first, count, kDataSize);
+  }
+
+  void ExpectNoBuffer() {
+    scoped_refptr<StreamParserBuffer> buffer;
+    EXPECT_FALSE(stream_->GetNextBuffer(&buffer));
+  }
+
+  void ExpectRanges(const char* expected) {
+    SourceBufferStream::Ranges ranges = stream_->GetBufferedRanges();
+    std::string actual;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+      if (i > 0)
+        actual += " ";
+      actual += base::StringPrintf(
+          "[%d,%d)",
+          static_cast<int>(ranges[i].first / Timestamp(1)),
+          static_cast<int>(ranges[i].second / Timestamp(1)));
+    }
+    EXPECT_EQ(expected, actual);
+  }
+
+  static base::TimeDelta Timestamp(int buffer_number) {
+    return base::TimeDelta::FromMilliseconds(
+        buffer_number * kBufferDurationInMs);
+  }
+
+  scoped_ptr<SourceBufferStream> stream_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SourceBufferStreamTest);
+};
+
+TEST_F(SourceBufferStreamTest, AppendAndRead) {
+  EXPECT_TRUE(stream_->IsSeekPending());
+  Append(0, 20);
+  EXPECT_FALSE(stream_->IsSeekPending());
+
+  ExpectRanges("[0,20)");
+  ExpectRead(0, 20);
+  ExpectNoBuffer();
+
+  // Reading carries on as more buffers arrive.
+  Append(20, 5);
+  ExpectRead(20, 5);
+}
+
+TEST_F(SourceBufferStreamTest, SeekWithinRange) {
+  Append(0, 20);
+
+  // Seeking lands on the keyframe at or before the seek time.
+  stream_->Flush();
+  stream_->Seek(Timestamp(13));
+  EXPECT_FALSE(stream_->IsSeekPending());
+  ExpectRead(10, 10);
+
+  stream_->Flush();
+  stream_->Seek(Timestamp(5));
+  ExpectRead(5, 15);
+}
+
+TEST_F(SourceBufferStreamTest, SeekBetweenRanges) {
+  Append(0, 10);
+  stream_->Flush();
+  Append(50, 10);
+  stream_->Flush();
+  Append(100, 10);
+  ExpectRanges("[0,10) [50,60) [100,110)");
+
+  stream_->Seek(Timestamp(57));
+  ExpectRead(55, 5);
+  ExpectNoBuffer();
+
+  stream_->Flush();
+  stream_->Seek(Timestamp(2));
+  ExpectRead(0, 10);
+  ExpectNoBuffer();
+}
+
+TEST_F(SourceBufferStreamTest, SeekToUnbufferedTime) {
+  Append(0, 10);
+  stream_->Flush();
+  stream_->Seek(Timestamp(30));
+  EXPECT_TRUE(stream_->IsSeekPending());
+  ExpectNoBuffer();
+
+  // The next segment appended is read from its start.
+  Append(30, 10);
+  EXPECT_FALSE(stream_->IsSeekPending());
+  ExpectRead(30, 10);
+  ExpectRanges("[0,10) [30,40)");
+}
+
+TEST_F(SourceBufferStreamTest, SeekToSegmentAppendedBeforeSeek) {
+  Append(0, 10);
+  stream_->Flush();
+  Append(31, 9);
+
+  // The seek time is not buffered, but the segment appended for it since the
+  // flush is.
+  stream_->Seek(Timestamp(30));
+  EXPECT_FALSE(stream_->IsSeekPending());
+  ExpectRead(31, 9);
+}
+
+TEST_F(SourceBufferStreamTest, ReadIntoAdjacentRange) {
+  Append(10, 10);
+  stream_->Flush();
+  Append(0, 10);
+  ExpectRanges("[0,20)");
+
+  stream_->Flush();
+  stream_->Seek(Timestamp(0));
+  ExpectRead(0, 20);
+}
+
+TEST_F(SourceBufferStreamTest, OverlapReplacesTail) {
+  Append(0, 20);
+  ExpectRead(0, 12);
+
+  // A new segment over the end of the range replaces it, and is read in its
+  // place.
+  stream_->Flush();
+  stream_->Seek(Timestamp(12));
+  Append(10, 15, kDataSize * 2);
+  ExpectRanges("[0,25)");
+  ExpectRead(10, 15, kDataSize * 2);
+}
+
+TEST_F(SourceBufferStreamTest, OverlapReplacesStartOfNextRange) {
+  Append(20, 20);
+  stream_->Flush();
+
+  // Appending over the start of the range removes what it replaces, along
+  // with the buffers up to the next keyframe that depended on it.
+  Append(10, 15, kDataSize * 2);
+  ExpectRanges("[10,40)");
+
+  stream_->Flush();
+  stream_->Seek(Timestamp(10));
+  ExpectRead(10, 15, kDataSize * 2);
+  ExpectRead(25, 15);
+}
+
+TEST_F(SourceBufferStreamTest, GarbageCollectBehindReadPosition) {
+  SetMemoryLimit(20 * kDataSize);
+
+  // A range not being read is evicted first.
+  Append(100, 10);
+  stream_->Flush();
+  stream_->Seek(Timestamp(0));
+  Append(0, 15);
+  ExpectRanges("[0,15)");
+
+  // Then the GOPs already read.
+  ExpectRead(0, 12);
+  Append(15, 10);
+  EXPECT_LE(stream_->buffered_bytes(), 20 * kDataSize);
+  ExpectRanges("[5,25)");
+
+  // Buffers ahead of the read position are never evicted.
+  ExpectRead(12, 13);
+  ExpectNoBuffer();
+}
+
+}  // namespace media
@@ -5,6 +5,7 @@
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/callback_helpers.h"
+#include "base/debug/trace_event.h"
 #include "base/threading/platform_thread.h"
 #include "media/base/buffers.h"
 #include "media/base/filter_host.h"
@@ -25,6 +26,7 @@ VideoRendererBase::VideoRendererBase(const base::Closure& paint_cb,
       pending_paint_(false),
       pending_paint_with_last_available_(false),
       drop_frames_(drop_frames),
+      skipping_non_reference_frames_(false),
       playback_rate_(0),
       paint_cb_(paint_cb),
       set_opaque_cb_(set_opaque_cb) {
@@ -56,6 +58,9 @@ void VideoRendererBase::Flush(const base::Closure& callback) {
   flush_cb_ = callback;
   state_ = kFlushingDecoder;
 
+  // Whatever comes after the flush should be decoded in full.
+  SkipNonReferenceFrames_Locked(false);
+
   // We must unlock here because the callback might run within the Flush()
   // call.
   // TODO: Remove this line when fixing http://crbug.com/125020
@@ -195,8 +200,15 @@ void VideoRendererBase::ThreadMain() {
       continue;
     }
 
-    // Remain idle until we have the next frame ready for rendering.
+    // Remain idle until we have the next frame ready for rendering. If the
+    // current frame has already expired the decoder is not keeping up, so let
+    // it skip what it can.
     if (ready_frames_.empty()) {
+      if (drop_frames_ && current_frame_ &&
+          current_frame_->GetTimestamp() + current_frame_->GetDuration() <
+              host()->GetTime()) {
+        SkipNonReferenceFrames_Locked(true);
+      }
       frame_available_.TimedWait(kIdleTimeDelta);
       continue;
     }
@@ -277,12 +289,29 @@ void VideoRendererBase::ThreadMain() {
         ready_frames_.pop_front();
         AttemptRead_Locked();
       }
+      if (frames_dropped > 0)
+        SkipNonReferenceFrames_Locked(true);
+
       // Continue waiting for the current paint to finish.
       frame_available_.TimedWait(kIdleTimeDelta);
       continue;
     }
 
 
+    // Don't bother painting a frame whose successor will be due before the
+    // paint could finish; skip straight to the successor instead.
+    if (drop_frames_) {
+      base::TimeDelta paint_deadline =
+          host()->GetTime() + average_paint_duration_;
+      while (ready_frames_.size() > 1 &&
+             !ready_frames_[1]->IsEndOfStream() &&
+             ready_frames_[1]->GetTimestamp() <= paint_deadline) {
+        ++frames_dropped;
+        ready_frames_.pop_front();
+        AttemptRead_Locked();
+      }
+    }
+
     // Congratulations! You've made it past the video frame timing gauntlet.
     //
     // We can now safely update the current frame, request another frame, and
@@ -293,6 +322,17 @@ void VideoRendererBase::ThreadMain() {
     ready_frames_.pop_front();
     AttemptRead_Locked();
 
+    // Keep the decoder skipping while frames are being dropped, until it has
+    // a frame decoded ahead of time again.
+    if (frames_dropped > 0) {
+      SkipNonReferenceFrames_Locked(true);
+    } else if (!ready_frames_.empty() &&
+               (ready_frames_.front()->IsEndOfStream() ||
+                ready_frames_.front()->GetTimestamp() >
+                    host()->GetTime() + average_paint_duration_)) {
+      SkipNonReferenceFrames_Locked(false);
+    }
+
     base::AutoUnlock auto_unlock(lock_);
     paint_cb_.Run();
   }
@@ -322,11 +362,20 @@ void VideoRendererBase::GetCurrentFrame(scoped_refptr<VideoFrame>* frame_out) {
     *frame_out = last_available_frame_;
     pending_paint_with_last_available_ = true;
   }
+  paint_start_time_ = base::TimeTicks::Now();
 }
 
 void VideoRendererBase::PutCurrentFrame(scoped_refptr<VideoFrame> frame) {
   base::AutoLock auto_lock(lock_);
 
+  if (!paint_start_time_.is_null()) {
+    base::TimeDelta paint_duration =
+        base::TimeTicks::Now() - paint_start_time_;
+    average_paint_duration_ =
+        (average_paint_duration_ * 7 + paint_duration) / 8;
+    paint_start_time_ = base::TimeTicks();
+  }
+
   // Note that we do not claim |pending_paint_| when we return NULL frame, in
   // that case, |current_frame_| could be changed before PutCurrentFrame.
   if (pending_paint_) {
@@ -430,8 +479,12 @@ void VideoRendererBase::FrameReady(VideoDecoder::DecoderStatus status,
     time_cb_.Run(frame->GetTimestamp() + frame->GetDuration());
   frame_available_.Signal();
 
+  int frames_queued = static_cast<int>(ready_frames_.size());
+  TRACE_COUNTER1("media", "VideoRendererBase::ready_frames", frames_queued);
+
   PipelineStatistics statistics;
   statistics.video_frames_decoded = 1;
+  statistics.video_frames_queued = frames_queued;
   statistics_cb_.Run(statistics);
 
   // Always request more decoded video if we have capacity. This serves two
@@ -541,4 +594,12 @@ int VideoRendererBase::NumFrames_Locked() const {
   return ready_frames_.size() + outstanding_frames;
 }
 
+void VideoRendererBase::SkipNonReferenceFrames_Locked(bool skip) {
+  lock_.AssertAcquired();
+  if (skip == skipping_non_reference_frames_)
+    return;
+  skipping_non_reference_frames_ = skip;
+  decoder_->SkipNonReferenceFrames(skip);
+}
+
 }  // namespace media
@@ -11,6 +11,7 @@
 #include "base/synchronization/condition_variable.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/platform_thread.h"
+#include "base/time.h"
 #include "media/base/filters.h"
 #include "media/base/pipeline_status.h"
 #include "media/base/video_decoder.h"
@@ -38,7 +39,10 @@ class MEDIA_EXPORT VideoRendererBase
   // instead post a task to a common/worker thread to handle rendering.  Slowing
   // down the video thread may result in losing synchronization with audio.
   //
-  // Setting |drop_frames_| to true causes the renderer to drop expired frames.
+  // Setting |drop_frames_| to true causes the renderer to drop expired frames,
+  // as well as frames that would expire before the client could finish
+  // painting them, and to have the decoder skip non-reference frames while it
+  // is falling behind.
   //
   // TODO(scherkus): pass the VideoFrame* to this callback and remove
   // Get/PutCurrentFrame() http://crbug.com/108435
@@ -107,6 +111,10 @@ class MEDIA_EXPORT VideoRendererBase
   // Return the number of frames currently held by this class.
   int NumFrames_Locked() const;
 
+  // Tells |decoder_| to start or stop skipping non-reference frames, if that
+  // changes what it was last told.
+  void SkipNonReferenceFrames_Locked(bool skip);
+
   // Used for accessing data members.
   base::Lock lock_;
 
@@ -191,6 +199,16 @@ class MEDIA_EXPORT VideoRendererBase
 
   bool drop_frames_;
 
+  // How long the client takes from GetCurrentFrame() to PutCurrentFrame(),
+  // averaged over recent paints, and when the paint in progress started.
+  // Frames whose successor is due before a paint started now would finish are
+  // dropped without being painted.
+  base::TimeDelta average_paint_duration_;
+  base::TimeTicks paint_start_time_;
+
+  // True while |decoder_| has been told to skip non-reference frames.
+  bool skipping_non_reference_frames_;
+
   float playback_rate_;
 
   // Filter callbacks.
@@ -4,8 +4,12 @@
 
 #include "net/base/filter.h"
 
+#include <vector>
+
 #include "base/file_path.h"
+#include "base/lazy_instance.h"
 #include "base/string_util.h"
+#include "base/synchronization/lock.h"
 #include "net/base/gzip_filter.h"
 #include "net/base/io_buffer.h"
 #include "net/base/mime_util.h"
@@ -37,6 +41,69 @@ const char kTextHtml[]             = "text/html";
 // Buffer size allocated when de-compressing data.
 const int kFilterBufSize = 32 * 1024;
 
+// The most buffers of kFilterBufSize bytes kept for reuse.
+const size_t kMaxPooledBuffers = 8;
+
+// Keeps the stream buffers of destroyed filters, so that the filters of the
+// next responses don't have to allocate their own.  Filters live on several
+// threads, so the pool is locked.
+class FilterBufferPool {
+ public:
+  FilterBufferPool() {}
+
+  ~FilterBufferPool() {
+    for (size_t i = 0; i < buffers_.size(); ++i)
+      delete[] buffers_[i];
+  }
+
+  // Returns a block of kFilterBufSize bytes.
+  char* Take() {
+    {
+      base::AutoLock lock(lock_);
+      if (!buffers_.empty()) {
+        char* buffer = buffers_.back();
+        buffers_.pop_back();
+        return buffer;
+      }
+    }
+    return new char[kFilterBufSize];
+  }
+
+  // Takes ownership of |buffer|, which must have come from Take().
+  void Return(char* buffer) {
+    {
+      base::AutoLock lock(lock_);
+      if (buffers_.size() < kMaxPooledBuffers) {
+        buffers_.push_back(buffer);
+        return;
+      }
+    }
+    delete[] buffer;
+  }
+
+ private:
+  base::Lock lock_;
+  std::vector<char*> buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(FilterBufferPool);
+};
+
+base::LazyInstance<FilterBufferPool> g_filter_buffer_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+// A stream buffer of kFilterBufSize bytes that goes back to the pool when it
+// is released.
+class PooledFilterBuffer : public net::IOBuffer {
+ public:
+  PooledFilterBuffer() : net::IOBuffer(g_filter_buffer_pool.Get().Take()) {}
+
+ private:
+  virtual ~PooledFilterBuffer() {
+    g_filter_buffer_pool.Get().Return(data_);
+    data_ = NULL;
+  }
+};
+
 }  // namespace
 
 namespace net {
@@ -392,7 +459,10 @@ Filter* Filter::PrependNewFilter(FilterType type_id,
 void Filter::InitBuffer(int buffer_size) {
   DCHECK(!stream_buffer());
   DCHECK_GT(buffer_size, 0);
-  stream_buffer_ = new IOBuffer(buffer_size);
+  if (buffer_size == kFilterBufSize)
+    stream_buffer_ = new PooledFilterBuffer();
+  else
+    stream_buffer_ = new IOBuffer(buffer_size);
   stream_buffer_size_ = buffer_size;
 }
 
@@ -10,9 +10,86 @@
 #include "third_party/zlib/zlib.h"
 #endif
 
+#include <vector>
+
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/synchronization/lock.h"
 #include "net/base/gzip_header.h"
 
+namespace {
+
+// The most inflate streams kept for reuse.  Each one holds on to about 40KB:
+// the inflate state and a 32KB window.
+const size_t kMaxPooledStreams = 4;
+
+// Keeps the inflate streams of destroyed filters, so that new filters can
+// reset one instead of allocating and initializing a fresh stream.  Filters
+// live on several threads, so the pool is locked.
+class InflateStreamPool {
+ public:
+  InflateStreamPool() {}
+
+  ~InflateStreamPool() {
+    for (size_t i = 0; i < streams_.size(); ++i)
+      DeleteStream(streams_[i]);
+  }
+
+  // Returns a stream ready to inflate with |window_bits| (as passed to
+  // inflateInit2), or NULL if zlib fails to set one up.
+  z_stream* Take(int window_bits) {
+    z_stream* stream = NULL;
+    {
+      base::AutoLock lock(lock_);
+      if (!streams_.empty()) {
+        stream = streams_.back();
+        streams_.pop_back();
+      }
+    }
+    if (stream) {
+      if (inflateReset2(stream, window_bits) == Z_OK)
+        return stream;
+      DeleteStream(stream);
+    }
+
+    stream = new z_stream;
+    memset(stream, 0, sizeof(z_stream));
+    if (inflateInit2(stream, window_bits) != Z_OK) {
+      delete stream;
+      return NULL;
+    }
+    return stream;
+  }
+
+  // Takes ownership of |stream|, which must have come from Take().
+  void Return(z_stream* stream) {
+    {
+      base::AutoLock lock(lock_);
+      if (streams_.size() < kMaxPooledStreams) {
+        streams_.push_back(stream);
+        return;
+      }
+    }
+    DeleteStream(stream);
+  }
+
+ private:
+  static void DeleteStream(z_stream* stream) {
+    inflateEnd(stream);
+    delete stream;
+  }
+
+  base::Lock lock_;
+  std::vector<z_stream*> streams_;
+
+  DISALLOW_COPY_AND_ASSIGN(InflateStreamPool);
+};
+
+base::LazyInstance<InflateStreamPool> g_inflate_stream_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 namespace net {
 
 GZipFilter::GZipFilter()
@@ -25,25 +102,19 @@ GZipFilter::GZipFilter()
 }
 
 GZipFilter::~GZipFilter() {
-  if (decoding_status_ != DECODING_UNINITIALIZED) {
-    inflateEnd(zlib_stream_.get());
-  }
+  if (zlib_stream_.get())
+    g_inflate_stream_pool.Get().Return(zlib_stream_.release());
 }
 
 bool GZipFilter::InitDecoding(Filter::FilterType filter_type) {
   if (decoding_status_ != DECODING_UNINITIALIZED)
     return false;
 
-  // Initialize zlib control block
-  zlib_stream_.reset(new z_stream);
-  if (!zlib_stream_.get())
-    return false;
-  memset(zlib_stream_.get(), 0, sizeof(z_stream));
-
-  // Set decoding mode
+  // Set decoding mode, and get a zlib control block from the pool.
   switch (filter_type) {
     case Filter::FILTER_TYPE_DEFLATE: {
-      if (inflateInit(zlib_stream_.get()) != Z_OK)
+      zlib_stream_.reset(g_inflate_stream_pool.Get().Take(MAX_WBITS));
+      if (!zlib_stream_.get())
         return false;
       decoding_mode_ = DECODE_MODE_DEFLATE;
       break;
@@ -55,7 +126,8 @@ bool GZipFilter::InitDecoding(Filter::FilterType filter_type) {
       gzip_header_.reset(new GZipHeader());
       if (!gzip_header_.get())
         return false;
-      if (inflateInit2(zlib_stream_.get(), -MAX_WBITS) != Z_OK)
+      zlib_stream_.reset(g_inflate_stream_pool.Get().Take(-MAX_WBITS));
+      if (!zlib_stream_.get())
         return false;
       decoding_mode_ = DECODE_MODE_GZIP;
       break;
@@ -0,0 +1,134 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#if defined(USE_SYSTEM_ZLIB)
+#include <zlib.h>
+#else
+#include "third_party/zlib/zlib.h"
+#endif
+
+#include "base/file_path.h"
+#include "base/file_util.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/path_service.h"
+#include "base/perftimer.h"
+#include "net/base/filter.h"
+#include "net/base/io_buffer.h"
+#include "net/base/mock_filter_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// How many times the sample page is decoded, each time by a new filter as
+// for a separate response.
+const int kIterations = 20000;
+
+// The buffer the decoded data is read into, as URLRequestJob does.
+const int kReadBufferSize = 32 * 1024;
+
+// Compresses |source| into |dest|, adding a gzip header and footer if |gzip|.
+bool Compress(bool gzip, const std::string& source, std::string* dest) {
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  // The window bits for gzip are offset by 16, see zlib.h.
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                   gzip ? MAX_WBITS + 16 : MAX_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+  dest->resize(deflateBound(&stream, source.size()));
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(source.data()));
+  stream.avail_in = source.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&(*dest)[0]);
+  stream.avail_out = dest->size();
+  int code = deflate(&stream, Z_FINISH);
+  dest->resize(dest->size() - stream.avail_out);
+  deflateEnd(&stream);
+  return code == Z_STREAM_END;
+}
+
+// Decodes |encoded| with a new filter of type |type|, feeding it one stream
+// buffer at a time.  Returns the number of decoded bytes, or -1 on error.
+int Decode(Filter::FilterType type, const std::string& encoded,
+           const MockFilterContext& filter_context, char* read_buffer) {
+  std::vector<Filter::FilterType> filter_types;
+  filter_types.push_back(type);
+  scoped_ptr<Filter> filter(Filter::Factory(filter_types, filter_context));
+  if (!filter.get())
+    return -1;
+
+  int decoded = 0;
+  size_t offset = 0;
+  while (offset < encoded.size()) {
+    int chunk = std::min(static_cast<size_t>(filter->stream_buffer_size()),
+                         encoded.size() - offset);
+    memcpy(filter->stream_buffer()->data(), encoded.data() + offset, chunk);
+    filter->FlushStreamBuffer(chunk);
+    offset += chunk;
+
+    Filter::FilterStatus status;
+    do {
+      int read = kReadBufferSize;
+      status = filter->ReadData(read_buffer, &read);
+      if (status == Filter::FILTER_ERROR)
+        return -1;
+      decoded += read;
+    } while (status == Filter::FILTER_OK);
+    if (status == Filter::FILTER_DONE)
+      break;
+  }
+  return decoded;
+}
+
+class GZipFilterPerfTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    FilePath file_path;
+    PathService::Get(base::DIR_SOURCE_ROOT, &file_path);
+    file_path = file_path.AppendASCII("net");
+    file_path = file_path.AppendASCII("data");
+    file_path = file_path.AppendASCII("filter_unittests");
+    file_path = file_path.AppendASCII("google.txt");
+    ASSERT_TRUE(file_util::ReadFileToString(file_path, &page_));
+    ASSERT_FALSE(page_.empty());
+  }
+
+  // Decodes the page |kIterations| times and reports the decoded bytes per
+  // second, which includes setting up and tearing down the filters.
+  void RunDecodeTest(Filter::FilterType type, const char* name) {
+    std::string encoded;
+    ASSERT_TRUE(Compress(type == Filter::FILTER_TYPE_GZIP, page_, &encoded));
+
+    PerfTimer timer;
+    for (int i = 0; i < kIterations; ++i) {
+      ASSERT_EQ(static_cast<int>(page_.size()),
+                Decode(type, encoded, filter_context_, read_buffer_));
+    }
+    double seconds = timer.Elapsed().InSecondsF();
+    LogPerfResult(name, page_.size() * kIterations / (seconds * 1024 * 1024),
+                  "MB/s");
+  }
+
+  MockFilterContext filter_context_;
+  std::string page_;
+  char read_buffer_[kReadBufferSize];
+};
+
+}  // namespace
+
+TEST_F(GZipFilterPerfTest, Deflate) {
+  RunDecodeTest(Filter::FILTER_TYPE_DEFLATE, "Deflate_filter_decode");
+}
+
+TEST_F(GZipFilterPerfTest, GZip) {
+  RunDecodeTest(Filter::FILTER_TYPE_GZIP, "GZip_filter_decode");
+}
+
+}  // namespace net
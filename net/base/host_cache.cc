@@ -13,7 +13,8 @@ namespace net {
 
 HostCache::Entry::Entry(int error, const AddressList& addrlist)
     : error(error),
-      addrlist(addrlist) {
+      addrlist(addrlist),
+      hit_count(0) {
 }
 
 HostCache::Entry::~Entry() {
@@ -34,7 +35,10 @@ const HostCache::Entry* HostCache::Lookup(const Key& key,
   if (caching_is_disabled())
     return NULL;
 
-  return entries_.Get(key, now);
+  const Entry* entry = entries_.Get(key, now);
+  if (entry)
+    ++entry->hit_count;
+  return entry;
 }
 
 void HostCache::Set(const Key& key,
@@ -46,7 +50,26 @@ void HostCache::Set(const Key& key,
   if (caching_is_disabled())
     return;
 
-  entries_.Put(key, Entry(error, addrlist), now, ttl);
+  Entry entry(error, addrlist);
+  const Entry* old_entry = entries_.Get(key, now);
+  if (old_entry)
+    entry.hit_count = old_entry->hit_count;
+  entries_.Put(key, entry, now, ttl);
+}
+
+void HostCache::GetHotEntries(base::TimeTicks now,
+                              base::TimeDelta window,
+                              int min_hits,
+                              std::vector<Key>* keys) const {
+  DCHECK(CalledOnValidThread());
+  for (EntryMap::Iterator it(entries_); it.HasNext(); it.Advance()) {
+    const Entry& entry = it.value();
+    if (entry.error != OK || entry.hit_count < min_hits)
+      continue;
+    if (it.expiration() <= now || it.expiration() > now + window)
+      continue;
+    keys->push_back(it.key());
+  }
 }
 
 void HostCache::clear() {
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "base/gtest_prod_util.h"
 #include "base/threading/non_thread_safe.h"
@@ -29,6 +30,11 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
     // The resolve results for this entry.
     int error;
     AddressList addrlist;
+
+    // Number of successful lookups of this entry. The count is carried over
+    // when the entry is overwritten by Set(), so refreshed entries stay hot.
+    // Lookup() only hands out const entries, hence mutable.
+    mutable int hit_count;
   };
 
   struct Key {
@@ -74,6 +80,14 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
            base::TimeTicks now,
            base::TimeDelta ttl);
 
+  // Fills |keys| with the keys of the positive entries that were looked up at
+  // least |min_hits| times and that are still valid at time |now| but will
+  // expire before |now| + |window|.
+  void GetHotEntries(base::TimeTicks now,
+                     base::TimeDelta window,
+                     int min_hits,
+                     std::vector<Key>* keys) const;
+
   // Empties the cache
   void clear();
 
@@ -287,6 +287,49 @@ TEST(HostCacheTest, Clear) {
   EXPECT_EQ(0u, cache.size());
 }
 
+TEST(HostCacheTest, HotEntries) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  const base::TimeDelta kWindow = base::TimeDelta::FromSeconds(2);
+
+  HostCache cache(kMaxCacheEntries);
+
+  // Set t=0.
+  base::TimeTicks now;
+
+  HostCache::Key hot = Key("hot.com");
+  HostCache::Key cold = Key("cold.com");
+  HostCache::Key negative = Key("negative.com");
+  cache.Set(hot, OK, AddressList(), now, kTTL);
+  cache.Set(cold, OK, AddressList(), now, kTTL);
+  cache.Set(negative, ERR_NAME_NOT_RESOLVED, AddressList(), now, kTTL);
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(cache.Lookup(hot, now));
+    EXPECT_TRUE(cache.Lookup(negative, now));
+  }
+  EXPECT_TRUE(cache.Lookup(cold, now));
+  EXPECT_EQ(4, cache.Lookup(hot, now)->hit_count);
+
+  // Nothing expires within the window yet.
+  std::vector<HostCache::Key> keys;
+  cache.GetHotEntries(now, kWindow, 2, &keys);
+  EXPECT_TRUE(keys.empty());
+
+  // Advance to t=9; only the hot positive entry qualifies.
+  now += base::TimeDelta::FromSeconds(9);
+  cache.GetHotEntries(now, kWindow, 2, &keys);
+  ASSERT_EQ(1u, keys.size());
+  EXPECT_EQ("hot.com", keys[0].hostname);
+
+  // Refreshing the entry keeps its hit count.
+  cache.Set(hot, OK, AddressList(), now, kTTL);
+  EXPECT_EQ(5, cache.Lookup(hot, now)->hit_count);
+
+  keys.clear();
+  cache.GetHotEntries(now, kWindow, 2, &keys);
+  EXPECT_TRUE(keys.empty());
+}
+
 // Tests the less than and equal operators for HostCache::Key work.
 TEST(HostCacheTest, KeyComparators) {
   struct {
@@ -10,6 +10,7 @@
 #include <netdb.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <vector>
@@ -63,6 +64,16 @@ const unsigned kCacheEntryTTLSeconds = 60;
 // Default TTL for unsuccessful resolutions with ProcTask.
 const unsigned kNegativeCacheEntryTTLSeconds = 0;
 
+// How often to look for hot cache entries to refresh.
+const int kCacheRefreshIntervalSeconds = 5;
+
+// Hot cache entries are refreshed when they expire within this window. It must
+// be larger than the refresh interval so that no entry slips through.
+const int kCacheRefreshWindowSeconds = 15;
+
+// Minimum number of cache hits for an entry to be considered hot.
+const int kCacheRefreshMinHits = 3;
+
 // Maximum of 6 concurrent resolver threads (excluding retries).
 // Some routers (or resolvers) appear to start to provide host-not-found if
 // too many simultaneous resolutions are pending.  This number needs to be
@@ -70,6 +81,10 @@ const unsigned kNegativeCacheEntryTTLSeconds = 0;
 // that limit this to 6, so we're temporarily holding it at that level.
 static const size_t kDefaultMaxProcTasks = 6u;
 
+// The share of the jobs which IDLE requests, such as speculative lookups from
+// the Predictor and cache refreshes, can't use.
+static const size_t kReservedJobsDivisor = 3u;
+
 // Helper to mutate the linked list contained by AddressList to the given
 // port. Note that in general this is dangerous since the AddressList's
 // data might be shared (and you should use AddressList::SetPort).
@@ -441,17 +456,9 @@ HostResolver* CreateHostResolver(size_t max_concurrent_resolves,
                                  HostCache* cache,
                                  scoped_ptr<DnsConfigService> config_service,
                                  NetLog* net_log) {
-  if (max_concurrent_resolves == HostResolver::kDefaultParallelism)
-    max_concurrent_resolves = kDefaultMaxProcTasks;
-
-  // TODO(szym): Add experiments with reserved slots for higher priority
-  // requests.
-
-  PrioritizedDispatcher::Limits limits(NUM_PRIORITIES, max_concurrent_resolves);
-
   HostResolverImpl* resolver = new HostResolverImpl(
       cache,
-      limits,
+      HostResolverImpl::GetDefaultLimits(max_concurrent_resolves),
       HostResolverImpl::ProcTaskParams(NULL, max_retry_attempts),
       config_service.Pass(),
       net_log);
@@ -1576,12 +1583,37 @@ HostResolverImpl::~HostResolverImpl() {
 #endif
 }
 
+// static
+PrioritizedDispatcher::Limits HostResolverImpl::GetDefaultLimits(
+    size_t max_concurrent_resolves) {
+  if (max_concurrent_resolves == HostResolver::kDefaultParallelism)
+    max_concurrent_resolves = kDefaultMaxProcTasks;
+
+  PrioritizedDispatcher::Limits limits(NUM_PRIORITIES, max_concurrent_resolves);
+  // With a single job there is nothing left to reserve; IDLE requests must
+  // still be able to run.
+  if (max_concurrent_resolves > 1) {
+    limits.reserved_slots[LOWEST] = std::max<size_t>(
+        1u, max_concurrent_resolves / kReservedJobsDivisor);
+  }
+  return limits;
+}
+
 void HostResolverImpl::SetMaxQueuedJobs(size_t value) {
   DCHECK_EQ(0u, dispatcher_.num_queued_jobs());
   DCHECK_GT(value, 0u);
   max_queued_jobs_ = value;
 }
 
+void HostResolverImpl::EnableCacheRefresh() {
+  DCHECK(CalledOnValidThread());
+  if (!cache_.get() || cache_refresh_timer_.IsRunning())
+    return;
+  cache_refresh_timer_.Start(
+      FROM_HERE, base::TimeDelta::FromSeconds(kCacheRefreshIntervalSeconds),
+      this, &HostResolverImpl::RefreshHotCacheEntries);
+}
+
 int HostResolverImpl::Resolve(const RequestInfo& info,
                               AddressList* addresses,
                               const CompletionCallback& callback,
@@ -1868,6 +1900,49 @@ HostResolverImpl::Key HostResolverImpl::GetEffectiveKeyForRequest(
   return Key(info.hostname(), effective_address_family, effective_flags);
 }
 
+void HostResolverImpl::RefreshHotCacheEntries() {
+  DCHECK(CalledOnValidThread());
+  if (!cache_.get())
+    return;
+
+  std::vector<Key> keys;
+  cache_->GetHotEntries(base::TimeTicks::Now(),
+                        base::TimeDelta::FromSeconds(kCacheRefreshWindowSeconds),
+                        kCacheRefreshMinHits,
+                        &keys);
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const Key& key = keys[i];
+    if (!pending_cache_refreshes_.insert(key).second)
+      continue;
+
+    RequestInfo info(HostPortPair(key.hostname, 0));
+    info.set_address_family(key.address_family);
+    info.set_host_resolver_flags(key.host_resolver_flags);
+    info.set_allow_cached_response(false);
+    info.set_is_speculative(true);
+    info.set_priority(IDLE);
+
+    // Pending requests are cancelled without running their callback when the
+    // resolver is destroyed, so |addresses| is owned by the callback.
+    AddressList* addresses = new AddressList;
+    int rv = Resolve(info, addresses,
+                     base::Bind(&HostResolverImpl::OnCacheRefreshComplete,
+                                base::Unretained(this), key,
+                                base::Owned(addresses)),
+                     NULL, BoundNetLog());
+    if (rv != ERR_IO_PENDING)
+      pending_cache_refreshes_.erase(key);
+  }
+}
+
+void HostResolverImpl::OnCacheRefreshComplete(const Key& key,
+                                              AddressList* addresses,
+                                              int rv) {
+  // The result has already been stored in the cache by the Job.
+  pending_cache_refreshes_.erase(key);
+}
+
 void HostResolverImpl::AbortAllInProgressJobs() {
   // In Abort, a Request callback could spawn new Jobs with matching keys, so
   // first collect and remove all running jobs from |jobs_|.
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <map>
+#include <set>
 
 #include "base/basictypes.h"
 #include "base/gtest_prod_util.h"
@@ -15,6 +16,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/threading/non_thread_safe.h"
 #include "base/time.h"
+#include "base/timer.h"
 #include "net/base/capturing_net_log.h"
 #include "net/base/host_cache.h"
 #include "net/base/host_resolver.h"
@@ -125,10 +127,24 @@ class NET_EXPORT HostResolverImpl
   // be called.
   virtual ~HostResolverImpl();
 
+  // Returns the job limits used by the Create*HostResolver() functions for
+  // |max_concurrent_resolves| running jobs, or the default number if it is
+  // kDefaultParallelism. Some of the jobs are reserved for requests above
+  // IDLE priority, so that speculative lookups can't starve the ones a user
+  // is waiting for.
+  static PrioritizedDispatcher::Limits GetDefaultLimits(
+      size_t max_concurrent_resolves);
+
   // Configures maximum number of Jobs in the queue. Exposed for testing.
   // Only allowed when the queue is empty.
   void SetMaxQueuedJobs(size_t value);
 
+  // Starts re-resolving, in the background and at the lowest priority, cache
+  // entries that have been looked up repeatedly and are about to expire, so
+  // that popular hosts are not subject to a cold lookup when their TTL runs
+  // out. Has no effect if there is no cache.
+  void EnableCacheRefresh();
+
   // HostResolver methods:
   virtual int Resolve(const RequestInfo& info,
                       AddressList* addresses,
@@ -217,6 +233,13 @@ class NET_EXPORT HostResolverImpl
   // Attempts to serve each Job in |jobs_| from the HOSTS file.
   void TryServingAllJobsFromHosts();
 
+  // Called periodically by |cache_refresh_timer_|. Issues a refresh request
+  // for every hot cache entry that is about to expire.
+  void RefreshHotCacheEntries();
+
+  // Completion callback of the requests issued by RefreshHotCacheEntries().
+  void OnCacheRefreshComplete(const Key& key, AddressList* addresses, int rv);
+
   // NetworkChangeNotifier::IPAddressObserver:
   virtual void OnIPAddressChanged() OVERRIDE;
 
@@ -246,6 +269,12 @@ class NET_EXPORT HostResolverImpl
   // Limit on the maximum number of jobs queued in |dispatcher_|.
   size_t max_queued_jobs_;
 
+  // Drives RefreshHotCacheEntries() once EnableCacheRefresh() is called.
+  base::RepeatingTimer<HostResolverImpl> cache_refresh_timer_;
+
+  // Keys with an outstanding refresh request.
+  std::set<Key> pending_cache_refreshes_;
+
   // Parameters for ProcTask.
   ProcTaskParams proc_params_;
 
@@ -0,0 +1,125 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/host_resolver_impl.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop.h"
+#include "base/perftimer.h"
+#include "base/stringprintf.h"
+#include "base/threading/platform_thread.h"
+#include "base/time.h"
+#include "net/base/address_list.h"
+#include "net/base/host_cache.h"
+#include "net/base/mock_host_resolver.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/dns/dns_config_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// The number of lookups sent to the resolver at once, as during start-up
+// when the predictor resolves the hosts from the last session.
+const int kRequests = 1000;
+
+// Every fifth request is one a user is waiting for; the rest are IDLE.
+const int kInteractiveInterval = 5;
+
+// How long the system resolver takes for each host.
+const int kLatencyMs = 10;
+
+// A HostResolverProc that takes |kLatencyMs| to resolve any host.
+class SlowHostResolverProc : public HostResolverProc {
+ public:
+  SlowHostResolverProc() : HostResolverProc(NULL) {}
+
+  virtual int Resolve(const std::string& host,
+                      AddressFamily address_family,
+                      HostResolverFlags host_resolver_flags,
+                      AddressList* addrlist,
+                      int* os_error) OVERRIDE {
+    base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(kLatencyMs));
+    return ParseAddressList("127.0.0.1", host, addrlist);
+  }
+
+ protected:
+  virtual ~SlowHostResolverProc() {}
+};
+
+class HostResolverImplPerfTest : public testing::Test {
+ protected:
+  HostResolverImplPerfTest() : pending_(0) {}
+
+  // Sends |kRequests| lookups for distinct hosts through a resolver with
+  // |limits| and reports the 99th percentile latency of the non-IDLE ones.
+  void RunLatencyTest(const PrioritizedDispatcher::Limits& limits,
+                      const char* name) {
+    scoped_ptr<HostResolverImpl> resolver(new HostResolverImpl(
+        HostCache::CreateDefaultCache(),
+        limits,
+        HostResolverImpl::ProcTaskParams(new SlowHostResolverProc(), 0u),
+        scoped_ptr<DnsConfigService>(NULL),
+        NULL));
+
+    std::vector<AddressList> addresses(kRequests);
+    latencies_.clear();
+    pending_ = kRequests;
+    for (int i = 0; i < kRequests; ++i) {
+      bool interactive = (i % kInteractiveInterval == 0);
+      HostResolver::RequestInfo info(
+          HostPortPair(base::StringPrintf("host%d.example.com", i), 80));
+      info.set_priority(interactive ? MEDIUM : IDLE);
+      HostResolver::RequestHandle handle = NULL;
+      int rv = resolver->Resolve(
+          info, &addresses[i],
+          base::Bind(&HostResolverImplPerfTest::OnComplete,
+                     base::Unretained(this), interactive,
+                     base::TimeTicks::Now()),
+          &handle, BoundNetLog());
+      ASSERT_EQ(ERR_IO_PENDING, rv);
+    }
+    MessageLoop::current()->Run();
+
+    ASSERT_FALSE(latencies_.empty());
+    std::sort(latencies_.begin(), latencies_.end());
+    size_t p99 = std::min(latencies_.size() - 1, latencies_.size() * 99 / 100);
+    LogPerfResult(name, latencies_[p99].InMillisecondsF(), "ms");
+  }
+
+ private:
+  void OnComplete(bool interactive, base::TimeTicks start, int result) {
+    EXPECT_EQ(OK, result);
+    if (interactive)
+      latencies_.push_back(base::TimeTicks::Now() - start);
+    if (--pending_ == 0)
+      MessageLoop::current()->Quit();
+  }
+
+  MessageLoopForIO message_loop_;
+  std::vector<base::TimeDelta> latencies_;
+  int pending_;
+};
+
+}  // namespace
+
+// All of the jobs can be taken by IDLE requests, so the interactive ones
+// wait behind the backlog that started before them.
+TEST_F(HostResolverImplPerfTest, InteractiveLatencyNoReservedJobs) {
+  RunLatencyTest(PrioritizedDispatcher::Limits(NUM_PRIORITIES, 6u),
+                 "Host_resolver_interactive_p99_unreserved");
+}
+
+TEST_F(HostResolverImplPerfTest, InteractiveLatencyDefaultLimits) {
+  RunLatencyTest(HostResolverImpl::GetDefaultLimits(6u),
+                 "Host_resolver_interactive_p99_default");
+}
+
+}  // namespace net
@@ -12,6 +12,7 @@
 #include "base/memory/scoped_vector.h"
 #include "base/message_loop.h"
 #include "base/string_util.h"
+#include "base/stringprintf.h"
 #include "base/synchronization/condition_variable.h"
 #include "base/synchronization/lock.h"
 #include "base/test/test_timeouts.h"
@@ -996,6 +997,41 @@ TEST_F(HostResolverImplTest, HigherPriorityRequestsStartedFirst) {
   EXPECT_EQ("req6", capture_list[6].hostname);
 }
 
+// Test that with the default limits, IDLE requests leave some jobs for
+// requests of higher priority.
+TEST_F(HostResolverImplTest, IdleRequestsLeaveReservedJobs) {
+  const size_t kMaxConcurrentResolves = 6u;
+  PrioritizedDispatcher::Limits limits =
+      HostResolverImpl::GetDefaultLimits(kMaxConcurrentResolves);
+  size_t reserved_jobs = limits.reserved_slots[LOWEST];
+  ASSERT_LT(0u, reserved_jobs);
+  resolver_.reset(new HostResolverImpl(HostCache::CreateDefaultCache(),
+                                       limits,
+                                       DefaultParams(proc_),
+                                       scoped_ptr<DnsConfigService>(NULL),
+                                       NULL));
+
+  for (size_t i = 0; i < kMaxConcurrentResolves; ++i)
+    CreateRequest(base::StringPrintf("idle%d", static_cast<int>(i)), 80, IDLE);
+  CreateRequest("medium", 80, MEDIUM);
+  for (size_t i = 0; i < requests_.size(); ++i)
+    EXPECT_EQ(ERR_IO_PENDING, requests_[i]->Resolve()) << i;
+
+  // The MEDIUM request starts right away, even though it came last.
+  size_t running_jobs = kMaxConcurrentResolves - reserved_jobs + 1;
+  EXPECT_TRUE(proc_->WaitFor(running_jobs));
+  MockHostResolverProc::CaptureList capture_list = proc_->GetCaptureList();
+  ASSERT_EQ(running_jobs, capture_list.size());
+  bool medium_started = false;
+  for (size_t i = 0; i < capture_list.size(); ++i)
+    medium_started |= capture_list[i].hostname == "medium";
+  EXPECT_TRUE(medium_started);
+
+  proc_->SignalMultiple(requests_.size());
+  for (size_t i = 0; i < requests_.size(); ++i)
+    EXPECT_EQ(OK, requests_[i]->WaitForResult()) << i;
+}
+
 // Try cancelling a job which has not started yet.
 TEST_F(HostResolverImplTest, CancelPendingRequest) {
   CreateSerialResolver();
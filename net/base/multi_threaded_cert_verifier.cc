@@ -4,6 +4,7 @@
 
 #include "net/base/multi_threaded_cert_verifier.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "base/bind.h"
@@ -11,6 +12,7 @@
 #include "base/compiler_specific.h"
 #include "base/message_loop.h"
 #include "base/metrics/histogram.h"
+#include "base/pickle.h"
 #include "base/stl_util.h"
 #include "base/synchronization/lock.h"
 #include "base/time.h"
@@ -77,6 +79,32 @@ const unsigned kMaxCacheEntries = 256;
 // The number of seconds for which we'll cache a cache entry.
 const unsigned kTTLSecs = 1800;  // 30 minutes.
 
+// The version of the format written by SerializeCache().
+const int kCacheVersion = 1;
+
+// These values can be bit-wise combined to form the properties field of a
+// serialized cache entry.
+enum {
+  CACHED_RESULT_HAS_MD5 = 1 << 0,
+  CACHED_RESULT_HAS_MD2 = 1 << 1,
+  CACHED_RESULT_HAS_MD4 = 1 << 2,
+  CACHED_RESULT_HAS_MD5_CA = 1 << 3,
+  CACHED_RESULT_HAS_MD2_CA = 1 << 4,
+  CACHED_RESULT_IS_ISSUED_BY_KNOWN_ROOT = 1 << 5,
+  // This bit is set if the entry has the verified certificate chain at the
+  // end.
+  CACHED_RESULT_HAS_VERIFIED_CERT = 1 << 6,
+};
+
+bool ReadFingerprint(const Pickle& pickle, PickleIterator* iter,
+                     SHA1Fingerprint* fingerprint) {
+  const char* data;
+  if (!pickle.ReadBytes(iter, &data, sizeof(fingerprint->data)))
+    return false;
+  memcpy(fingerprint->data, data, sizeof(fingerprint->data));
+  return true;
+}
+
 }  // namespace
 
 MultiThreadedCertVerifier::CachedResult::CachedResult() : error(ERR_FAILED) {}
@@ -138,8 +166,10 @@ class CertVerifierWorker {
                      const std::string& hostname,
                      int flags,
                      CRLSet* crl_set,
+                     const MultiThreadedCertVerifier::RequestParams& key,
                      MultiThreadedCertVerifier* cert_verifier)
       : verify_proc_(verify_proc),
+        key_(key),
         cert_(cert),
         hostname_(hostname),
         flags_(flags),
@@ -197,10 +227,8 @@ class CertVerifierWorker {
       // this case, we will end up deleting a locked Lock, which can lead to
       // memory leaks or worse errors.
       base::AutoLock locked(lock_);
-      if (!canceled_) {
-        cert_verifier_->HandleResult(cert_, hostname_, flags_,
-                                     error_, verify_result_);
-      }
+      if (!canceled_)
+        cert_verifier_->HandleResult(key_, error_, verify_result_);
     }
     delete this;
   }
@@ -233,6 +261,7 @@ class CertVerifierWorker {
   }
 
   scoped_refptr<CertVerifyProc> verify_proc_;
+  const MultiThreadedCertVerifier::RequestParams key_;
   scoped_refptr<X509Certificate> cert_;
   const std::string hostname_;
   const int flags_;
@@ -332,7 +361,8 @@ MultiThreadedCertVerifier::MultiThreadedCertVerifier()
       requests_(0),
       cache_hits_(0),
       inflight_joins_(0),
-      verify_proc_(CertVerifyProc::CreateDefault()) {
+      verify_proc_(CertVerifyProc::CreateDefault()),
+      delegate_(NULL) {
   CertDatabase::AddObserver(this);
 }
 
@@ -359,8 +389,7 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
 
   requests_++;
 
-  const RequestParams key(cert->fingerprint(), cert->ca_fingerprint(),
-                          hostname, flags);
+  const RequestParams key = MakeKey(cert, hostname, flags, crl_set);
   const CertVerifierCache::value_type* cached_entry =
       cache_.Get(key, base::TimeTicks::Now());
   if (cached_entry) {
@@ -375,15 +404,15 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
   std::map<RequestParams, CertVerifierJob*>::const_iterator j;
   j = inflight_.find(key);
   if (j != inflight_.end()) {
-    // An identical request is in flight already. We'll just attach our
-    // callback.
+    // An identical request, or one for another hostname that |cert| is
+    // valid for, is in flight already. We'll just attach our callback.
     inflight_joins_++;
     job = j->second;
   } else {
     // Need to make a new request.
     CertVerifierWorker* worker = new CertVerifierWorker(verify_proc_, cert,
                                                         hostname, flags,
-                                                        crl_set, this);
+                                                        crl_set, key, this);
     job = new CertVerifierJob(
         worker,
         BoundNetLog::Make(net_log.net_log(), NetLog::SOURCE_CERT_VERIFIER_JOB));
@@ -411,24 +440,176 @@ void MultiThreadedCertVerifier::CancelRequest(RequestHandle req) {
   request->Cancel();
 }
 
-// HandleResult is called by CertVerifierWorker on the origin message loop.
-// It deletes CertVerifierJob.
-void MultiThreadedCertVerifier::HandleResult(
+void MultiThreadedCertVerifier::SetDelegate(Delegate* delegate) {
+  DCHECK(CalledOnValidThread());
+  delegate_ = delegate;
+}
+
+void MultiThreadedCertVerifier::SerializeCache(std::string* output) const {
+  DCHECK(CalledOnValidThread());
+
+  const base::TimeTicks now_ticks = base::TimeTicks::Now();
+  const base::Time now = base::Time::Now();
+  int count = 0;
+  for (CertVerifierCache::Iterator it(cache_); it.HasNext(); it.Advance()) {
+    if (it.key().hostname.empty() && it.expiration() > now_ticks)
+      ++count;
+  }
+
+  Pickle pickle;
+  pickle.WriteInt(kCacheVersion);
+  pickle.WriteInt(count);
+  for (CertVerifierCache::Iterator it(cache_); it.HasNext(); it.Advance()) {
+    if (!it.key().hostname.empty() || it.expiration() <= now_ticks)
+      continue;
+    const RequestParams& key = it.key();
+    const CachedResult& cached_result = it.value();
+    const CertVerifyResult& result = cached_result.result;
+    // TimeTicks don't survive a restart, so store the expiration as a wall
+    // clock time.
+    const base::Time expiration = now + (it.expiration() - now_ticks);
+
+    int properties = 0;
+    if (result.has_md5)
+      properties |= CACHED_RESULT_HAS_MD5;
+    if (result.has_md2)
+      properties |= CACHED_RESULT_HAS_MD2;
+    if (result.has_md4)
+      properties |= CACHED_RESULT_HAS_MD4;
+    if (result.has_md5_ca)
+      properties |= CACHED_RESULT_HAS_MD5_CA;
+    if (result.has_md2_ca)
+      properties |= CACHED_RESULT_HAS_MD2_CA;
+    if (result.is_issued_by_known_root)
+      properties |= CACHED_RESULT_IS_ISSUED_BY_KNOWN_ROOT;
+    if (result.verified_cert)
+      properties |= CACHED_RESULT_HAS_VERIFIED_CERT;
+
+    pickle.WriteBytes(key.cert_fingerprint.data,
+                      sizeof(key.cert_fingerprint.data));
+    pickle.WriteBytes(key.ca_fingerprint.data,
+                      sizeof(key.ca_fingerprint.data));
+    pickle.WriteInt(key.flags);
+    pickle.WriteUInt32(key.crl_set_sequence);
+    pickle.WriteInt64(expiration.ToInternalValue());
+    pickle.WriteInt(cached_result.error);
+    pickle.WriteUInt32(result.cert_status);
+    pickle.WriteInt(properties);
+    pickle.WriteInt(static_cast<int>(result.public_key_hashes.size()));
+    for (size_t j = 0; j < result.public_key_hashes.size(); ++j) {
+      pickle.WriteBytes(result.public_key_hashes[j].data,
+                        sizeof(result.public_key_hashes[j].data));
+    }
+    if (result.verified_cert)
+      result.verified_cert->Persist(&pickle);
+  }
+
+  output->assign(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+bool MultiThreadedCertVerifier::LoadCache(const std::string& serialized) {
+  DCHECK(CalledOnValidThread());
+
+  Pickle pickle(serialized.data(), serialized.size());
+  PickleIterator iter(pickle);
+  int version;
+  int count;
+  if (!pickle.ReadInt(&iter, &version) || version != kCacheVersion ||
+      !pickle.ReadInt(&iter, &count) || count < 0) {
+    return false;
+  }
+
+  std::vector<std::pair<RequestParams, CachedResult> > results;
+  std::vector<base::Time> expirations;
+  for (int i = 0; i < count; ++i) {
+    RequestParams key(SHA1Fingerprint(), SHA1Fingerprint(), std::string(), 0,
+                      0);
+    CachedResult cached_result;
+    CertVerifyResult& result = cached_result.result;
+    int64 expiration;
+    int properties;
+    int num_hashes;
+    if (!ReadFingerprint(pickle, &iter, &key.cert_fingerprint) ||
+        !ReadFingerprint(pickle, &iter, &key.ca_fingerprint) ||
+        !pickle.ReadInt(&iter, &key.flags) ||
+        !pickle.ReadUInt32(&iter, &key.crl_set_sequence) ||
+        !pickle.ReadInt64(&iter, &expiration) ||
+        !pickle.ReadInt(&iter, &cached_result.error) ||
+        !pickle.ReadUInt32(&iter, &result.cert_status) ||
+        !pickle.ReadInt(&iter, &properties) ||
+        !pickle.ReadInt(&iter, &num_hashes) || num_hashes < 0) {
+      return false;
+    }
+    result.public_key_hashes.resize(num_hashes);
+    for (int j = 0; j < num_hashes; ++j) {
+      if (!ReadFingerprint(pickle, &iter, &result.public_key_hashes[j]))
+        return false;
+    }
+    if (properties & CACHED_RESULT_HAS_VERIFIED_CERT) {
+      result.verified_cert = X509Certificate::CreateFromPickle(
+          pickle, &iter, X509Certificate::PICKLETYPE_CERTIFICATE_CHAIN_V3);
+      if (!result.verified_cert)
+        return false;
+    }
+    result.has_md5 = (properties & CACHED_RESULT_HAS_MD5) != 0;
+    result.has_md2 = (properties & CACHED_RESULT_HAS_MD2) != 0;
+    result.has_md4 = (properties & CACHED_RESULT_HAS_MD4) != 0;
+    result.has_md5_ca = (properties & CACHED_RESULT_HAS_MD5_CA) != 0;
+    result.has_md2_ca = (properties & CACHED_RESULT_HAS_MD2_CA) != 0;
+    result.is_issued_by_known_root =
+        (properties & CACHED_RESULT_IS_ISSUED_BY_KNOWN_ROOT) != 0;
+
+    results.push_back(std::make_pair(key, cached_result));
+    expirations.push_back(base::Time::FromInternalValue(expiration));
+  }
+
+  const base::TimeTicks now_ticks = base::TimeTicks::Now();
+  const base::Time now = base::Time::Now();
+  const base::TimeDelta max_ttl = base::TimeDelta::FromSeconds(kTTLSecs);
+  for (size_t i = 0; i < results.size(); ++i) {
+    // Don't let a clock that was set back keep results beyond their TTL.
+    base::TimeDelta ttl = std::min(expirations[i] - now, max_ttl);
+    if (ttl <= base::TimeDelta())
+      continue;
+    // Results obtained in this run are more recent.
+    if (cache_.Get(results[i].first, now_ticks))
+      continue;
+    cache_.Put(results[i].first, results[i].second, now_ticks, ttl);
+  }
+  return true;
+}
+
+// static
+MultiThreadedCertVerifier::RequestParams MultiThreadedCertVerifier::MakeKey(
     X509Certificate* cert,
     const std::string& hostname,
     int flags,
+    CRLSet* crl_set) {
+  // The hostname is only used to check that the certificate is valid for it,
+  // so the results for all the hostnames that pass that check are the same.
+  std::string key_hostname;
+  if (!cert->VerifyNameMatch(hostname))
+    key_hostname = hostname;
+  return RequestParams(cert->fingerprint(), cert->ca_fingerprint(),
+                       key_hostname, flags,
+                       crl_set ? crl_set->sequence() : 0);
+}
+
+// HandleResult is called by CertVerifierWorker on the origin message loop.
+// It deletes CertVerifierJob.
+void MultiThreadedCertVerifier::HandleResult(
+    const RequestParams& key,
     int error,
     const CertVerifyResult& verify_result) {
   DCHECK(CalledOnValidThread());
 
-  const RequestParams key(cert->fingerprint(), cert->ca_fingerprint(),
-                          hostname, flags);
-
   CachedResult cached_result;
   cached_result.error = error;
   cached_result.result = verify_result;
   cache_.Put(key, cached_result, base::TimeTicks::Now(),
              base::TimeDelta::FromSeconds(kTTLSecs));
+  if (delegate_ && key.hostname.empty())
+    delegate_->CacheIsDirty(this);
 
   std::map<RequestParams, CertVerifierJob*>::iterator j;
   j = inflight_.find(key);
@@ -450,6 +631,12 @@ void MultiThreadedCertVerifier::OnCertTrustChanged(
   ClearCache();
 }
 
+void MultiThreadedCertVerifier::ClearCache() {
+  cache_.Clear();
+  if (delegate_)
+    delegate_->CacheIsDirty(this);
+}
+
 void MultiThreadedCertVerifier::SetCertVerifyProc(CertVerifyProc* verify_proc) {
   verify_proc_ = verify_proc;
 }
@@ -36,6 +36,18 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier :
     NON_EXPORTED_BASE(public base::NonThreadSafe),
     public CertDatabase::Observer {
  public:
+  // Receives notifications when the cache of verification results changes,
+  // so that it can be persisted with SerializeCache().
+  class NET_EXPORT_PRIVATE Delegate {
+   public:
+    // Called on the verifier's thread. This function may not block and must
+    // not reenter the MultiThreadedCertVerifier object.
+    virtual void CacheIsDirty(MultiThreadedCertVerifier* verifier) = 0;
+
+   protected:
+    virtual ~Delegate() {}
+  };
+
   MultiThreadedCertVerifier();
 
   // When the verifier is destroyed, all certificate verifications requests are
@@ -54,6 +66,20 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier :
 
   virtual void CancelRequest(CertVerifier::RequestHandle req) OVERRIDE;
 
+  // Assigns a |Delegate| for persisting the cache. May be NULL.
+  void SetDelegate(Delegate* delegate);
+
+  // Serializes the unexpired verification results that don't depend on the
+  // hostname into |output|. Results for hostnames that don't match the
+  // certificate are left out, so no hostnames are written.
+  void SerializeCache(std::string* output) const;
+
+  // Adds the results serialized by SerializeCache(), possibly by an earlier
+  // run of the browser, to the cache. Results that have expired since are
+  // dropped. Returns false if |serialized| could not be parsed, in which
+  // case no results are added.
+  bool LoadCache(const std::string& serialized);
+
  private:
   friend class CertVerifierWorker;  // Calls HandleResult.
   friend class CertVerifierRequest;
@@ -65,24 +91,39 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier :
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, CancelRequest);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
                            RequestParamsComparators);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           MatchingHostnamesShareResult);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           InflightJoinAcrossHostnames);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           SerializeAndLoadCache);
 
   // Input parameters of a certificate verification request.
+  //
+  // The result of verifying a certificate for a hostname that it matches
+  // doesn't depend on the hostname, so the key of such a request has an
+  // empty |hostname| and all of them share a result.
   struct RequestParams {
     RequestParams(const SHA1Fingerprint& cert_fingerprint_arg,
                   const SHA1Fingerprint& ca_fingerprint_arg,
                   const std::string& hostname_arg,
-                  int flags_arg)
+                  int flags_arg,
+                  uint32 crl_set_sequence_arg)
         : cert_fingerprint(cert_fingerprint_arg),
           ca_fingerprint(ca_fingerprint_arg),
           hostname(hostname_arg),
-          flags(flags_arg) {}
+          flags(flags_arg),
+          crl_set_sequence(crl_set_sequence_arg) {}
 
     bool operator<(const RequestParams& other) const {
-      // |flags| is compared before |cert_fingerprint|, |ca_fingerprint|, and
-      // |hostname| under assumption that integer comparisons are faster than
-      // memory and string comparisons.
+      // |flags| and |crl_set_sequence| are compared before
+      // |cert_fingerprint|, |ca_fingerprint|, and |hostname| under assumption
+      // that integer comparisons are faster than memory and string
+      // comparisons.
       if (flags != other.flags)
         return flags < other.flags;
+      if (crl_set_sequence != other.crl_set_sequence)
+        return crl_set_sequence < other.crl_set_sequence;
       int rv = memcmp(cert_fingerprint.data, other.cert_fingerprint.data,
                       sizeof(cert_fingerprint.data));
       if (rv != 0)
@@ -98,6 +139,8 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier :
     SHA1Fingerprint ca_fingerprint;
     std::string hostname;
     int flags;
+    // The sequence number of the CRLSet used, or 0 if there was none.
+    uint32 crl_set_sequence;
   };
 
   // CachedResult contains the result of a certificate verification.
@@ -109,9 +152,14 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier :
     CertVerifyResult result;  // The output of CertVerifier::Verify.
   };
 
-  void HandleResult(X509Certificate* cert,
-                    const std::string& hostname,
-                    int flags,
+  // Returns the key under which the result of verifying |cert| for
+  // |hostname| is cached.
+  static RequestParams MakeKey(X509Certificate* cert,
+                               const std::string& hostname,
+                               int flags,
+                               CRLSet* crl_set);
+
+  void HandleResult(const RequestParams& key,
                     int error,
                     const CertVerifyResult& verify_result);
 
@@ -119,7 +167,7 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier :
   virtual void OnCertTrustChanged(const X509Certificate* cert) OVERRIDE;
 
   // For unit testing.
-  void ClearCache() { cache_.Clear(); }
+  void ClearCache();
   size_t GetCacheSize() const { return cache_.size(); }
   uint64 cache_hits() const { return cache_hits_; }
   uint64 requests() const { return requests_; }
@@ -140,6 +188,8 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier :
 
   scoped_refptr<CertVerifyProc> verify_proc_;
 
+  Delegate* delegate_;
+
   DISALLOW_COPY_AND_ASSIGN(MultiThreadedCertVerifier);
 };
 
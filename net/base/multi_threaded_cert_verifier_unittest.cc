@@ -242,6 +242,135 @@ TEST_F(MultiThreadedCertVerifierTest, CancelRequestThenQuit) {
   // Destroy |verifier| by going out of scope.
 }
 
+// Tests that requests for different hostnames that the certificate is valid
+// for share a cache entry.
+TEST_F(MultiThreadedCertVerifierTest, MatchingHostnamesShareResult) {
+  FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_NE(static_cast<X509Certificate*>(NULL), test_cert);
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+
+  error = verifier_.Verify(test_cert, "127.0.0.1", 0, NULL,
+                           &verify_result, callback.callback(),
+                           &request_handle, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  ASSERT_TRUE(request_handle != NULL);
+  error = callback.WaitForResult();
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_EQ(1u, verifier_.GetCacheSize());
+
+  // The absolute form of the name matches the certificate too.
+  error = verifier_.Verify(test_cert, "127.0.0.1.", 0, NULL,
+                           &verify_result, callback.callback(),
+                           &request_handle, BoundNetLog());
+  ASSERT_NE(ERR_IO_PENDING, error);
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_TRUE(request_handle == NULL);
+  ASSERT_EQ(1u, verifier_.cache_hits());
+  ASSERT_EQ(1u, verifier_.GetCacheSize());
+
+  // A hostname that doesn't match gets its own entry.
+  error = verifier_.Verify(test_cert, "www.example.com", 0, NULL,
+                           &verify_result, callback.callback(),
+                           &request_handle, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  error = callback.WaitForResult();
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_EQ(1u, verifier_.cache_hits());
+  ASSERT_EQ(2u, verifier_.GetCacheSize());
+}
+
+// Tests an inflight join of requests for different hostnames that the
+// certificate is valid for.
+TEST_F(MultiThreadedCertVerifierTest, InflightJoinAcrossHostnames) {
+  FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_NE(static_cast<X509Certificate*>(NULL), test_cert);
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+  CertVerifyResult verify_result2;
+  TestCompletionCallback callback2;
+  CertVerifier::RequestHandle request_handle2;
+
+  error = verifier_.Verify(test_cert, "127.0.0.1", 0, NULL,
+                           &verify_result, callback.callback(),
+                           &request_handle, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  ASSERT_TRUE(request_handle != NULL);
+  error = verifier_.Verify(
+      test_cert, "127.0.0.1.", 0, NULL, &verify_result2,
+      callback2.callback(), &request_handle2, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  ASSERT_TRUE(request_handle2 != NULL);
+  error = callback.WaitForResult();
+  ASSERT_TRUE(IsCertificateError(error));
+  error = callback2.WaitForResult();
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_EQ(2u, verifier_.requests());
+  ASSERT_EQ(1u, verifier_.inflight_joins());
+  ASSERT_EQ(1u, verifier_.GetCacheSize());
+}
+
+// Tests that a result survives a round trip through SerializeCache and
+// LoadCache, and that results for hostnames the certificate isn't valid for
+// are not serialized.
+TEST_F(MultiThreadedCertVerifierTest, SerializeAndLoadCache) {
+  FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_NE(static_cast<X509Certificate*>(NULL), test_cert);
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+
+  error = verifier_.Verify(test_cert, "127.0.0.1", 0, NULL,
+                           &verify_result, callback.callback(),
+                           &request_handle, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  const int expected_error = callback.WaitForResult();
+  error = verifier_.Verify(test_cert, "www.example.com", 0, NULL,
+                           &verify_result, callback.callback(),
+                           &request_handle, BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  callback.WaitForResult();
+  ASSERT_EQ(2u, verifier_.GetCacheSize());
+
+  std::string serialized;
+  verifier_.SerializeCache(&serialized);
+
+  MultiThreadedCertVerifier verifier2;
+  verifier2.SetCertVerifyProc(new MockCertVerifyProc());
+  ASSERT_TRUE(verifier2.LoadCache(serialized));
+  ASSERT_EQ(1u, verifier2.GetCacheSize());
+
+  error = verifier2.Verify(test_cert, "127.0.0.1", 0, NULL,
+                           &verify_result, callback.callback(),
+                           &request_handle, BoundNetLog());
+  // Synchronous completion.
+  ASSERT_EQ(expected_error, error);
+  ASSERT_TRUE(request_handle == NULL);
+  ASSERT_EQ(1u, verifier2.cache_hits());
+  ASSERT_EQ(CERT_STATUS_COMMON_NAME_INVALID, verify_result.cert_status);
+  ASSERT_TRUE(verify_result.verified_cert != NULL);
+  EXPECT_TRUE(test_cert->Equals(verify_result.verified_cert));
+}
+
+TEST_F(MultiThreadedCertVerifierTest, LoadCacheRejectsGarbage) {
+  EXPECT_FALSE(verifier_.LoadCache(std::string()));
+  EXPECT_FALSE(verifier_.LoadCache("not a serialized cache"));
+}
+
 TEST_F(MultiThreadedCertVerifierTest, RequestParamsComparators) {
   SHA1Fingerprint a_key;
   memset(a_key.data, 'a', sizeof(a_key.data));
@@ -262,42 +391,51 @@ TEST_F(MultiThreadedCertVerifierTest, RequestParamsComparators) {
   } tests[] = {
     {  // Test for basic equivalence.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0),
+                                               0, 0),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0),
+                                               0, 0),
       0,
     },
     {  // Test that different certificates but with the same CA and for
        // the same host are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0),
+                                               0, 0),
       MultiThreadedCertVerifier::RequestParams(z_key, a_key, "www.example.test",
-                                               0),
+                                               0, 0),
       -1,
     },
     {  // Test that the same EE certificate for the same host, but with
        // different chains are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, z_key, "www.example.test",
-                                               0),
+                                               0, 0),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               0),
+                                               0, 0),
       1,
     },
     {  // The same certificate, with the same chain, but for different
        // hosts are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key,
-                                               "www1.example.test", 0),
+                                               "www1.example.test", 0, 0),
       MultiThreadedCertVerifier::RequestParams(a_key, a_key,
-                                               "www2.example.test", 0),
+                                               "www2.example.test", 0, 0),
       -1,
     },
     {  // The same certificate, chain, and host, but with different flags
        // are different validation keys.
       MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
-                                               X509Certificate::VERIFY_EV_CERT),
-      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
+                                               X509Certificate::VERIFY_EV_CERT,
                                                0),
+      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
+                                               0, 0),
       1,
+    },
+    {  // The same certificate, chain, host, and flags, but checked against
+       // different CRLSets are different validation keys.
+      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
+                                               0, 1),
+      MultiThreadedCertVerifier::RequestParams(a_key, a_key, "www.example.test",
+                                               0, 2),
+      -1,
     }
   };
   for (size_t i = 0; i < ARRAYSIZE_UNSAFE(tests); ++i) {
@@ -498,6 +498,22 @@ EVENT_TYPE(SSL_SNAP_START)
 // we merged the verification with the SSLHostInfo.
 EVENT_TYPE(SSL_VERIFICATION_MERGED)
 
+// Logged when an SSL handshake completes, with the time spent on each part of
+// it:
+//   {
+//     "server_first_flight_ms": <Time from the start of the handshake until
+//                                the server's certificate arrived. Omitted
+//                                for resumed sessions>,
+//     "handshake_ms": <Time until the handshake completed, before
+//                      certificate verification>,
+//     "cert_verification_ms": <Time spent verifying the certificate>,
+//     "resumed": <True if a cached session was resumed>,
+//     "false_start_allowed": <True if False Start could be used>,
+//     "predicted_cert_chain_correct": <True if the certificates predicted by
+//                                      the SSLHostInfo were correct>,
+//   }
+EVENT_TYPE(SSL_HANDSHAKE_TIMES)
+
 // An SSL error occurred while calling an NSS function not directly related to
 // one of the above activities.  Can also be used when more information than
 // is provided by just an error code is needed:
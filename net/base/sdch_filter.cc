@@ -1,4 +1,4 @@
-// Copyright (c) 2011 The Chromium Authors. All rights reserved.
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
@@ -17,6 +17,54 @@
 
 namespace net {
 
+namespace {
+
+// Collects the output of VCDiffStreamingDecoder::DecodeChunk() straight into
+// the caller's buffer, and only keeps the part which does not fit in
+// |excess|. This avoids copying all decoded data through a string.
+class DirectOutput {
+ public:
+  DirectOutput(char* buffer, size_t buffer_size, std::string* excess)
+      : buffer_(buffer),
+        buffer_size_(buffer_size),
+        buffer_used_(0),
+        excess_(excess) {
+    DCHECK(excess_->empty());
+  }
+
+  // The interface used by open_vcdiff::OutputString<>.
+  void append(const char* data, size_t length) {
+    size_t amount = std::min(length, buffer_size_ - buffer_used_);
+    memcpy(buffer_ + buffer_used_, data, amount);
+    buffer_used_ += amount;
+    if (amount < length)
+      excess_->append(data + amount, length - amount);
+  }
+  void clear() {
+    buffer_used_ = 0;
+    excess_->clear();
+  }
+  void push_back(char c) { append(&c, 1); }
+  void reserve(size_t size) {
+    if (size > buffer_size_)
+      excess_->reserve(size - buffer_size_);
+  }
+  size_t size() const { return buffer_used_ + excess_->size(); }
+
+  // The number of bytes written to the caller's buffer.
+  size_t buffer_used() const { return buffer_used_; }
+
+ private:
+  char* const buffer_;
+  const size_t buffer_size_;
+  size_t buffer_used_;
+  std::string* const excess_;
+
+  DISALLOW_COPY_AND_ASSIGN(DirectOutput);
+};
+
+}  // namespace
+
 SdchFilter::SdchFilter(const FilterContext& filter_context)
     : filter_context_(filter_context),
       decoding_status_(DECODING_UNINITIALIZED),
@@ -288,13 +336,16 @@ Filter::FilterStatus SdchFilter::ReadFilteredData(char* dest_buffer,
   if (!next_stream_data_ || stream_data_len_ <= 0)
     return FILTER_NEED_MORE_DATA;
 
+  // Decode into |dest_buffer|; whatever doesn't fit is kept in
+  // |dest_buffer_excess_| for the next call.
+  DirectOutput output(dest_buffer, available_space, &dest_buffer_excess_);
   bool ret = vcdiff_streaming_decoder_->DecodeChunk(
-    next_stream_data_, stream_data_len_, &dest_buffer_excess_);
+    next_stream_data_, stream_data_len_, &output);
   // Assume all data was used in decoding.
   next_stream_data_ = NULL;
   source_bytes_ += stream_data_len_;
   stream_data_len_ = 0;
-  output_bytes_ += dest_buffer_excess_.size();
+  output_bytes_ += output.size();
   if (!ret) {
     vcdiff_streaming_decoder_.reset(NULL);  // Don't call it again.
     decoding_status_ = DECODING_ERROR;
@@ -302,12 +353,9 @@ Filter::FilterStatus SdchFilter::ReadFilteredData(char* dest_buffer,
     return FILTER_ERROR;
   }
 
-  amount = OutputBufferExcess(dest_buffer, available_space);
-  *dest_len += amount;
-  dest_buffer += amount;
-  available_space -= amount;
-  if (0 == available_space && !dest_buffer_excess_.empty())
-      return FILTER_OK;
+  *dest_len += output.buffer_used();
+  if (!dest_buffer_excess_.empty())
+    return FILTER_OK;
   return FILTER_NEED_MORE_DATA;
 }
 
@@ -38,6 +38,10 @@ namespace {
 const int kKeySizeInBits = 1024;
 const int kValidityPeriodInDays = 365;
 
+// Number of key pairs to keep pregenerated. Channel IDs are created for a new
+// domain at a time, so a couple of keys covers the bursts seen on startup.
+const size_t kKeyPoolSize = 2;
+
 bool IsSupportedCertType(uint8 type) {
   switch(type) {
     case CLIENT_CERT_ECDSA_SIGN:
@@ -77,6 +81,21 @@ void RecordGetDomainBoundCertResult(GetCertResult result) {
                             GET_CERT_RESULT_MAX);
 }
 
+// Runs on a worker thread to generate a key pair for the key pool.
+void GeneratePooledKey(scoped_ptr<crypto::ECPrivateKey>* key) {
+  base::TimeTicks start = base::TimeTicks::Now();
+  key->reset(crypto::ECPrivateKey::Create());
+  UMA_HISTOGRAM_CUSTOM_TIMES("DomainBoundCerts.GeneratePooledKeyTime",
+                             base::TimeTicks::Now() - start,
+                             base::TimeDelta::FromMilliseconds(1),
+                             base::TimeDelta::FromMinutes(5),
+                             50);
+#if defined(USE_NSS)
+  // See ServerBoundCertServiceWorker::Run().
+  PR_DetachThread();
+#endif
+}
+
 void RecordGetCertTime(base::TimeDelta request_time) {
   UMA_HISTOGRAM_CUSTOM_TIMES("DomainBoundCerts.GetCertTime",
                              request_time,
@@ -166,13 +185,17 @@ class ServerBoundCertServiceRequest {
 // if Start() succeeds.
 class ServerBoundCertServiceWorker {
  public:
+  // Takes ownership of |key|, which may be NULL. See
+  // ServerBoundCertService::GenerateCert().
   ServerBoundCertServiceWorker(
       const std::string& server_identifier,
       SSLClientCertType type,
+      crypto::ECPrivateKey* key,
       ServerBoundCertService* server_bound_cert_service)
       : server_identifier_(server_identifier),
         type_(type),
         serial_number_(base::RandInt(0, std::numeric_limits<int>::max())),
+        key_(key),
         origin_loop_(MessageLoop::current()),
         server_bound_cert_service_(server_bound_cert_service),
         canceled_(false),
@@ -202,6 +225,7 @@ class ServerBoundCertServiceWorker {
     error_ = ServerBoundCertService::GenerateCert(server_identifier_,
                                                   type_,
                                                   serial_number_,
+                                                  key_.release(),
                                                   &creation_time_,
                                                   &expiration_time_,
                                                   &private_key_,
@@ -267,6 +291,7 @@ class ServerBoundCertServiceWorker {
   // Note that serial_number_ must be initialized on a non-worker thread
   // (see documentation for ServerBoundCertService::GenerateCert).
   uint32 serial_number_;
+  scoped_ptr<crypto::ECPrivateKey> key_;
   MessageLoop* const origin_loop_;
   ServerBoundCertService* const server_bound_cert_service_;
 
@@ -355,12 +380,22 @@ const char ServerBoundCertService::kEPKIPassword[] = "";
 ServerBoundCertService::ServerBoundCertService(
     ServerBoundCertStore* server_bound_cert_store)
     : server_bound_cert_store_(server_bound_cert_store),
+      key_pool_refill_pending_(false),
       requests_(0),
       cert_store_hits_(0),
-      inflight_joins_(0) {}
+      inflight_joins_(0),
+      ALLOW_THIS_IN_INITIALIZER_LIST(weak_ptr_factory_(this)) {}
 
 ServerBoundCertService::~ServerBoundCertService() {
   STLDeleteValues(&inflight_);
+  STLDeleteElements(&key_pool_);
+}
+
+void ServerBoundCertService::Prefetch() {
+  DCHECK(CalledOnValidThread());
+  MessageLoop::current()->PostTask(
+      FROM_HERE, base::Bind(&ServerBoundCertService::DoPrefetch,
+                            weak_ptr_factory_.GetWeakPtr()));
 }
 
 //static
@@ -464,10 +499,17 @@ int ServerBoundCertService::GetDomainBoundCert(
     }
     inflight_joins_++;
   } else {
-    // Need to make a new request.
+    // Need to make a new request. Start from a pregenerated key pair if there
+    // is one, so the worker only has to create the cert.
+    crypto::ECPrivateKey* key = NULL;
+    if (preferred_type == CLIENT_CERT_ECDSA_SIGN) {
+      key = TakePooledKey();
+      UMA_HISTOGRAM_BOOLEAN("DomainBoundCerts.UsedPooledKey", key != NULL);
+    }
     ServerBoundCertServiceWorker* worker = new ServerBoundCertServiceWorker(
             domain,
             preferred_type,
+            key,
             this);
     job = new ServerBoundCertServiceJob(worker, preferred_type);
     if (!worker->Start()) {
@@ -479,6 +521,7 @@ int ServerBoundCertService::GetDomainBoundCert(
       return ERR_INSUFFICIENT_RESOURCES;  // Just a guess.
     }
     inflight_[domain] = job;
+    RefillKeyPool();
   }
 
   ServerBoundCertServiceRequest* request = new ServerBoundCertServiceRequest(
@@ -496,10 +539,12 @@ ServerBoundCertStore* ServerBoundCertService::GetCertStore() {
 int ServerBoundCertService::GenerateCert(const std::string& server_identifier,
                                          SSLClientCertType type,
                                          uint32 serial_number,
+                                         crypto::ECPrivateKey* key,
                                          base::Time* creation_time,
                                          base::Time* expiration_time,
                                          std::string* private_key,
                                          std::string* cert) {
+  scoped_ptr<crypto::ECPrivateKey> pooled_key(key);
   base::TimeTicks start = base::TimeTicks::Now();
   base::Time not_valid_before = base::Time::Now();
   base::Time not_valid_after =
@@ -508,7 +553,8 @@ int ServerBoundCertService::GenerateCert(const std::string& server_identifier,
   std::vector<uint8> private_key_info;
   switch (type) {
     case CLIENT_CERT_ECDSA_SIGN: {
-      scoped_ptr<crypto::ECPrivateKey> key(crypto::ECPrivateKey::Create());
+      scoped_ptr<crypto::ECPrivateKey> key(pooled_key.get() ?
+          pooled_key.release() : crypto::ECPrivateKey::Create());
       if (!key.get()) {
         DLOG(ERROR) << "Unable to create key pair for client";
         return ERR_KEY_GENERATION_FAILED;
@@ -589,6 +635,47 @@ void ServerBoundCertService::HandleResult(const std::string& server_identifier,
   delete job;
 }
 
+void ServerBoundCertService::DoPrefetch() {
+  DCHECK(CalledOnValidThread());
+  // Any call loads the whole backing store in one go.
+  server_bound_cert_store_->GetCertCount();
+  RefillKeyPool();
+}
+
+crypto::ECPrivateKey* ServerBoundCertService::TakePooledKey() {
+  if (key_pool_.empty())
+    return NULL;
+  crypto::ECPrivateKey* key = key_pool_.back();
+  key_pool_.pop_back();
+  return key;
+}
+
+void ServerBoundCertService::RefillKeyPool() {
+  DCHECK(CalledOnValidThread());
+  if (key_pool_refill_pending_ || key_pool_.size() >= kKeyPoolSize)
+    return;
+  scoped_ptr<crypto::ECPrivateKey>* key = new scoped_ptr<crypto::ECPrivateKey>;
+  key_pool_refill_pending_ = base::WorkerPool::PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(&GeneratePooledKey, key),
+      base::Bind(&ServerBoundCertService::OnPooledKeyGenerated,
+                 weak_ptr_factory_.GetWeakPtr(), base::Owned(key)),
+      true /* task is slow */);
+}
+
+void ServerBoundCertService::OnPooledKeyGenerated(
+    scoped_ptr<crypto::ECPrivateKey>* key) {
+  DCHECK(CalledOnValidThread());
+  key_pool_refill_pending_ = false;
+  if (!key->get()) {
+    // Leave it to the next cert request to try again.
+    DLOG(ERROR) << "Unable to pregenerate key pair";
+    return;
+  }
+  key_pool_.push_back(key->release());
+  RefillKeyPool();
+}
+
 int ServerBoundCertService::cert_count() {
   return server_bound_cert_store_->GetCertCount();
 }
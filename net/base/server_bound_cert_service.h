@@ -12,12 +12,17 @@
 
 #include "base/basictypes.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/threading/non_thread_safe.h"
 #include "base/time.h"
 #include "net/base/completion_callback.h"
 #include "net/base/net_export.h"
 #include "net/base/ssl_client_cert_type.h"
 
+namespace crypto {
+class ECPrivateKey;
+}
+
 namespace net {
 
 class ServerBoundCertServiceJob;
@@ -49,6 +54,12 @@ class NET_EXPORT ServerBoundCertService
   // the origin otherwise.
   static std::string GetDomainForHost(const std::string& host);
 
+  // Loads the backing store and starts filling the pool of pregenerated key
+  // pairs, so that neither happens while a TLS handshake is waiting on
+  // GetDomainBoundCert(). The work is posted to the current message loop, so
+  // this is cheap to call while setting up the request context.
+  void Prefetch();
+
   // Fetches the domain bound cert for the specified origin of the specified
   // type if one exists and creates one otherwise. Returns OK if successful or
   // an error code upon failure.
@@ -89,6 +100,7 @@ class NET_EXPORT ServerBoundCertService
   uint64 requests() const { return requests_; }
   uint64 cert_store_hits() const { return cert_store_hits_; }
   uint64 inflight_joins() const { return inflight_joins_; }
+  size_t pooled_key_count() const { return key_pool_.size(); }
 
  private:
   friend class ServerBoundCertServiceWorker;  // Calls HandleResult.
@@ -101,9 +113,12 @@ class NET_EXPORT ServerBoundCertService
   // |serial_number| is passed in because it is created with the function
   // base::RandInt, which opens the file /dev/urandom. /dev/urandom is opened
   // with a LazyInstance, which is not allowed on a worker thread.
+  // If |key| is not NULL it is a pregenerated key pair of the right type to
+  // use instead of generating one. Takes ownership of |key|.
   static int GenerateCert(const std::string& server_identifier,
                           SSLClientCertType type,
                           uint32 serial_number,
+                          crypto::ECPrivateKey* key,
                           base::Time* creation_time,
                           base::Time* expiration_time,
                           std::string* private_key,
@@ -117,8 +132,25 @@ class NET_EXPORT ServerBoundCertService
                     const std::string& private_key,
                     const std::string& cert);
 
+  void DoPrefetch();
+
+  // Removes a pregenerated key pair from |key_pool_| and returns it, or
+  // returns NULL if the pool is empty. The caller takes ownership.
+  crypto::ECPrivateKey* TakePooledKey();
+
+  // Starts generating a key pair on a worker thread if |key_pool_| is not
+  // full and no generation is in flight.
+  void RefillKeyPool();
+
+  void OnPooledKeyGenerated(scoped_ptr<crypto::ECPrivateKey>* key);
+
   scoped_ptr<ServerBoundCertStore> server_bound_cert_store_;
 
+  // Key pairs generated ahead of time, so that creating a cert for a new
+  // domain only has to sign it. Owned.
+  std::vector<crypto::ECPrivateKey*> key_pool_;
+  bool key_pool_refill_pending_;
+
   // inflight_ maps from a server to an active generation which is taking
   // place.
   std::map<std::string, ServerBoundCertServiceJob*> inflight_;
@@ -127,6 +159,8 @@ class NET_EXPORT ServerBoundCertService
   uint64 cert_store_hits_;
   uint64 inflight_joins_;
 
+  base::WeakPtrFactory<ServerBoundCertService> weak_ptr_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(ServerBoundCertService);
 };
 
@@ -9,6 +9,8 @@
 
 #include "base/bind.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/message_loop.h"
+#include "base/threading/platform_thread.h"
 #include "crypto/ec_private_key.h"
 #include "net/base/asn1_util.h"
 #include "net/base/default_server_bound_cert_store.h"
@@ -411,6 +413,39 @@ TEST(ServerBoundCertServiceTest, Expiration) {
   EXPECT_LT(1U, der_cert2.size());
 }
 
+TEST(ServerBoundCertServiceTest, PooledKeys) {
+  ServerBoundCertService service(new DefaultServerBoundCertStore(NULL));
+  EXPECT_EQ(0u, service.pooled_key_count());
+
+  // Wait for Prefetch() to fill the key pool.
+  service.Prefetch();
+  while (service.pooled_key_count() < 2u) {
+    MessageLoop::current()->RunAllPending();
+    base::PlatformThread::Sleep(base::TimeDelta::FromMilliseconds(10));
+  }
+
+  int error;
+  std::vector<uint8> types;
+  types.push_back(CLIENT_CERT_ECDSA_SIGN);
+  TestCompletionCallback callback;
+  ServerBoundCertService::RequestHandle request_handle;
+
+  // A new cert takes one of the pooled keys.
+  SSLClientCertType type;
+  std::string private_key_info, der_cert;
+  error = service.GetDomainBoundCert(
+      "https://encrypted.google.com:443", types, &type, &private_key_info,
+      &der_cert, callback.callback(), &request_handle);
+  EXPECT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(1u, service.pooled_key_count());
+  error = callback.WaitForResult();
+  EXPECT_EQ(OK, error);
+  EXPECT_EQ(1, service.cert_count());
+  EXPECT_EQ(CLIENT_CERT_ECDSA_SIGN, type);
+  EXPECT_FALSE(private_key_info.empty());
+  EXPECT_FALSE(der_cert.empty());
+}
+
 #endif  // !defined(USE_OPENSSL)
 
 }  // namespace
@@ -115,7 +115,16 @@ bool TransportSecurityState::GetDomainState(const std::string& host,
 
   bool has_preload = GetStaticDomainState(canonicalized_host, sni_enabled,
                                           &state);
-  std::string canonicalized_preload = CanonicalizeHost(state.domain);
+  std::string canonicalized_preload;
+  if (has_preload)
+    canonicalized_preload = CanonicalizeHost(state.domain);
+
+  // Without dynamic entries, there is nothing to hash each label for.
+  if (enabled_hosts_.empty()) {
+    if (has_preload)
+      *result = state;
+    return has_preload;
+  }
 
   base::Time current_time(base::Time::Now());
 
@@ -588,41 +597,67 @@ struct HSTSPreload {
   SecondLevelDomainName second_level_domain_name;
 };
 
+// Orders HSTSPreload entries the way transport_security_state_static.h is
+// sorted: by length, then by name.
+struct HSTSPreloadLess {
+  bool operator()(const HSTSPreload& entry,
+                  const std::pair<const char*, size_t>& name) const {
+    if (entry.length != name.second)
+      return entry.length < name.second;
+    return memcmp(entry.dns_name, name.first, name.second) < 0;
+  }
+};
+
+// Returns the entry of |entries| whose name is the |length| bytes at |name|,
+// or NULL if there is none. |entries| must be sorted as by HSTSPreloadLess.
+static const struct HSTSPreload* FindPreload(
+    const struct HSTSPreload* entries, size_t num_entries,
+    const char* name, size_t length) {
+  const std::pair<const char*, size_t> key(name, length);
+  const struct HSTSPreload* end = entries + num_entries;
+  const struct HSTSPreload* entry =
+      std::lower_bound(entries, end, key, HSTSPreloadLess());
+  if (entry == end || entry->length != length ||
+      memcmp(entry->dns_name, name, length) != 0) {
+    return NULL;
+  }
+  return entry;
+}
+
 static bool HasPreload(const struct HSTSPreload* entries, size_t num_entries,
                        const std::string& canonicalized_host, size_t i,
                        TransportSecurityState::DomainState* out, bool* ret) {
-  for (size_t j = 0; j < num_entries; j++) {
-    if (entries[j].length == canonicalized_host.size() - i &&
-        memcmp(entries[j].dns_name, &canonicalized_host[i],
-               entries[j].length) == 0) {
-      if (!entries[j].include_subdomains && i != 0) {
-        *ret = false;
-      } else {
-        out->include_subdomains = entries[j].include_subdomains;
-        *ret = true;
-        if (!entries[j].https_required)
-          out->upgrade_mode = TransportSecurityState::DomainState::MODE_DEFAULT;
-        if (entries[j].pins.required_hashes) {
-          const char* const* hash = entries[j].pins.required_hashes;
-          while (*hash) {
-            bool ok = AddHash(*hash, &out->static_spki_hashes);
-            DCHECK(ok) << " failed to parse " << *hash;
-            hash++;
-          }
-        }
-        if (entries[j].pins.excluded_hashes) {
-          const char* const* hash = entries[j].pins.excluded_hashes;
-          while (*hash) {
-            bool ok = AddHash(*hash, &out->bad_static_spki_hashes);
-            DCHECK(ok) << " failed to parse " << *hash;
-            hash++;
-          }
-        }
+  const struct HSTSPreload* entry =
+      FindPreload(entries, num_entries, &canonicalized_host[i],
+                  canonicalized_host.size() - i);
+  if (!entry)
+    return false;
+
+  if (!entry->include_subdomains && i != 0) {
+    *ret = false;
+  } else {
+    out->include_subdomains = entry->include_subdomains;
+    *ret = true;
+    if (!entry->https_required)
+      out->upgrade_mode = TransportSecurityState::DomainState::MODE_DEFAULT;
+    if (entry->pins.required_hashes) {
+      const char* const* hash = entry->pins.required_hashes;
+      while (*hash) {
+        bool ok = AddHash(*hash, &out->static_spki_hashes);
+        DCHECK(ok) << " failed to parse " << *hash;
+        hash++;
+      }
+    }
+    if (entry->pins.excluded_hashes) {
+      const char* const* hash = entry->pins.excluded_hashes;
+      while (*hash) {
+        bool ok = AddHash(*hash, &out->bad_static_spki_hashes);
+        DCHECK(ok) << " failed to parse " << *hash;
+        hash++;
       }
-      return true;
     }
   }
-  return false;
+  return true;
 }
 
 #include "net/base/transport_security_state_static.h"
@@ -638,17 +673,11 @@ static const struct HSTSPreload* GetHSTSPreload(
     const struct HSTSPreload* entries,
     size_t num_entries) {
   for (size_t i = 0; canonicalized_host[i]; i += canonicalized_host[i] + 1) {
-    for (size_t j = 0; j < num_entries; j++) {
-      const struct HSTSPreload* entry = entries + j;
-
-      if (i != 0 && !entry->include_subdomains)
-        continue;
-
-      if (entry->length == canonicalized_host.size() - i &&
-          memcmp(entry->dns_name, &canonicalized_host[i], entry->length) == 0) {
-        return entry;
-      }
-    }
+    const struct HSTSPreload* entry =
+        FindPreload(entries, num_entries, &canonicalized_host[i],
+                    canonicalized_host.size() - i);
+    if (entry && (i == 0 || entry->include_subdomains))
+      return entry;
   }
 
   return NULL;
@@ -703,24 +732,27 @@ bool TransportSecurityState::GetStaticDomainState(
   out->upgrade_mode = DomainState::MODE_FORCE_HTTPS;
   out->include_subdomains = false;
 
+  // This runs for every request, so the name of each label is only built
+  // once it matched, and the forced hosts are only hashed if there are any.
   for (size_t i = 0; canonicalized_host[i]; i += canonicalized_host[i] + 1) {
-    std::string host_sub_chunk(&canonicalized_host[i],
-                               canonicalized_host.size() - i);
-    out->domain = DNSDomainToString(host_sub_chunk);
-    std::string hashed_host(HashHost(host_sub_chunk));
-    if (forced_hosts_.find(hashed_host) != forced_hosts_.end()) {
-      *out = forced_hosts_[hashed_host];
-      out->domain = DNSDomainToString(host_sub_chunk);
-      return true;
+    if (!forced_hosts_.empty()) {
+      std::string host_sub_chunk(&canonicalized_host[i],
+                                 canonicalized_host.size() - i);
+      std::map<std::string, DomainState>::const_iterator j =
+          forced_hosts_.find(HashHost(host_sub_chunk));
+      if (j != forced_hosts_.end()) {
+        *out = j->second;
+        out->domain = DNSDomainToString(host_sub_chunk);
+        return true;
+      }
     }
     bool ret;
     if (HasPreload(kPreloadedSTS, kNumPreloadedSTS, canonicalized_host, i, out,
-                   &ret)) {
-      return ret;
-    }
-    if (sni_enabled &&
-        HasPreload(kPreloadedSNISTS, kNumPreloadedSNISTS, canonicalized_host, i,
-                   out, &ret)) {
+                   &ret) ||
+        (sni_enabled &&
+         HasPreload(kPreloadedSNISTS, kNumPreloadedSNISTS, canonicalized_host,
+                    i, out, &ret))) {
+      out->domain = DNSDomainToString(canonicalized_host.substr(i));
       return ret;
     }
   }
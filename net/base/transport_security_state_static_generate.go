@@ -28,6 +28,7 @@ import (
 	"io"
 	"os"
 	"regexp"
+	"sort"
 	"strings"
 )
 
@@ -121,7 +122,9 @@ func process(jsonFileName, certsFileName string) error {
 	out := bufio.NewWriter(outFile)
 	writeHeader(out)
 	writeCertsOutput(out, pins)
-	writeHSTSOutput(out, preloaded)
+	if err := writeHSTSOutput(out, preloaded); err != nil {
+		return err
+	}
 	writeFooter(out)
 	out.Flush()
 
@@ -471,6 +474,51 @@ func domainConstant(s string) string {
 	return fmt.Sprintf("DOMAIN_%s_%s", domain, gtld)
 }
 
+// toWire returns the domain name |s| in the length-prefixed form of toDNS,
+// unescaped, as it is compared by the C++ code.
+func toWire(s string) []byte {
+	var wire []byte
+	for _, label := range strings.Split(s, ".") {
+		wire = append(wire, byte(len(label)))
+		wire = append(wire, label...)
+	}
+	return append(wire, 0)
+}
+
+// hstsEntries sorts entries in the order that TransportSecurityState binary
+// searches them in: by the length of the DNS name, then by its bytes.
+type hstsEntries []hsts
+
+func (e hstsEntries) Len() int      { return len(e) }
+func (e hstsEntries) Swap(i, j int) { e[i], e[j] = e[j], e[i] }
+func (e hstsEntries) Less(i, j int) bool {
+	a, b := toWire(e[i].Name), toWire(e[j].Name)
+	if len(a) != len(b) {
+		return len(a) < len(b)
+	}
+	return bytes.Compare(a, b) < 0
+}
+
+// writeHSTSEntries writes the entries of |entries| which are SNI-only if
+// |sniOnly|, or not SNI-only otherwise, in sorted order.
+func writeHSTSEntries(out *bufio.Writer, entries []hsts, sniOnly bool) error {
+	var selected hstsEntries
+	for _, entry := range entries {
+		if entry.SNIOnly == sniOnly {
+			selected = append(selected, entry)
+		}
+	}
+	sort.Sort(selected)
+
+	for i, entry := range selected {
+		if i > 0 && entry.Name == selected[i-1].Name {
+			return fmt.Errorf("duplicate HSTS entry for %s", entry.Name)
+		}
+		writeHSTSEntry(out, entry)
+	}
+	return nil
+}
+
 func writeHSTSEntry(out *bufio.Writer, entry hsts) {
 	dnsName, dnsLen := toDNS(entry.Name)
 	domain := "DOMAIN_NOT_PINNED"
@@ -515,14 +563,12 @@ static const char* const kNoRejectedPublicKeys[] = {
   NULL, NULL, \
 }
 
+// The entries are sorted by the length of |dns_name|, then by its bytes.
 static const struct HSTSPreload kPreloadedSTS[] = {
 `)
 
-	for _, entry := range hsts.Entries {
-		if entry.SNIOnly {
-			continue
-		}
-		writeHSTSEntry(out, entry)
+	if err := writeHSTSEntries(out, hsts.Entries, false); err != nil {
+		return err
 	}
 
 	out.WriteString(`};
@@ -531,11 +577,8 @@ static const size_t kNumPreloadedSTS = ARRAYSIZE_UNSAFE(kPreloadedSTS);
 static const struct HSTSPreload kPreloadedSNISTS[] = {
 `)
 
-	for _, entry := range hsts.Entries {
-		if !entry.SNIOnly {
-			continue
-		}
-		writeHSTSEntry(out, entry)
+	if err := writeHSTSEntries(out, hsts.Entries, true); err != nil {
+		return err
 	}
 
 	out.WriteString(`};
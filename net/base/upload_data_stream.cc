@@ -4,15 +4,34 @@
 
 #include "net/base/upload_data_stream.h"
 
+#include "base/bind.h"
 #include "base/file_util.h"
+#include "base/location.h"
 #include "base/logging.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/threading/worker_pool.h"
 #include "net/base/file_stream.h"
 #include "net/base/io_buffer.h"
 #include "net/base/net_errors.h"
 
 namespace net {
 
+namespace {
+
+// Reads up to |buf_len| bytes of the element at |index| into |buf|. Runs on
+// the worker pool.
+void ReadFileElement(UploadData* upload_data,
+                     size_t index,
+                     IOBuffer* buf,
+                     int buf_len,
+                     int* bytes_read) {
+  UploadData::Element& element = (*upload_data->elements())[index];
+  DCHECK_EQ(UploadData::TYPE_FILE, element.type());
+  *bytes_read = element.ReadSync(buf->data(), buf_len);
+}
+
+}  // namespace
+
 bool UploadDataStream::merge_chunks_ = true;
 
 UploadDataStream::UploadDataStream(UploadData* upload_data)
@@ -20,7 +39,9 @@ UploadDataStream::UploadDataStream(UploadData* upload_data)
       element_index_(0),
       total_size_(0),
       current_position_(0),
-      initialized_successfully_(false) {
+      initialized_successfully_(false),
+      file_read_in_progress_(false),
+      ALLOW_THIS_IN_INITIALIZER_LIST(weak_ptr_factory_(this)) {
 }
 
 UploadDataStream::~UploadDataStream() {
@@ -63,13 +84,55 @@ int UploadDataStream::Init() {
   return OK;
 }
 
-int UploadDataStream::Read(IOBuffer* buf, int buf_len) {
+int UploadDataStream::Read(IOBuffer* buf, int buf_len,
+                           const CompletionCallback& callback) {
+  DCHECK(!callback.is_null());
+  DCHECK(!file_read_in_progress_);
+
+  int result = ReadElements(buf, buf_len, true);
+  if (result != 0 || element_index_ == upload_data_->elements()->size())
+    return result;
+
+  UploadData::Element& element = (*upload_data_->elements())[element_index_];
+  if (element.type() != UploadData::TYPE_FILE)
+    return result;
+
+  // The element with data left is a file. The task holds on to
+  // |upload_data_| and |buf|, so the read can safely complete after this
+  // stream is gone.
+  file_read_in_progress_ = true;
+  int* bytes_read = new int(0);
+  const bool task_is_slow = true;
+  const bool posted = base::WorkerPool::PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(&ReadFileElement, upload_data_, element_index_,
+                 make_scoped_refptr(buf), buf_len, bytes_read),
+      base::Bind(&UploadDataStream::OnFileElementRead,
+                 weak_ptr_factory_.GetWeakPtr(), callback,
+                 base::Owned(bytes_read)),
+      task_is_slow);
+  DCHECK(posted);
+  return ERR_IO_PENDING;
+}
+
+int UploadDataStream::ReadSync(IOBuffer* buf, int buf_len) {
+  DCHECK(!file_read_in_progress_);
+  return ReadElements(buf, buf_len, false);
+}
+
+int UploadDataStream::ReadElements(IOBuffer* buf, int buf_len,
+                                   bool stop_at_file) {
   std::vector<UploadData::Element>& elements = *upload_data_->elements();
 
   int bytes_copied = 0;
   while (bytes_copied < buf_len && element_index_ < elements.size()) {
     UploadData::Element& element = elements[element_index_];
 
+    if (stop_at_file && element.type() == UploadData::TYPE_FILE &&
+        element.BytesRemaining() > 0) {
+      break;
+    }
+
     bytes_copied += element.ReadSync(buf->data() + bytes_copied,
                                      buf_len - bytes_copied);
 
@@ -87,6 +150,19 @@ int UploadDataStream::Read(IOBuffer* buf, int buf_len) {
   return bytes_copied;
 }
 
+void UploadDataStream::OnFileElementRead(const CompletionCallback& callback,
+                                         const int* bytes_read) {
+  DCHECK(file_read_in_progress_);
+  file_read_in_progress_ = false;
+
+  UploadData::Element& element = (*upload_data_->elements())[element_index_];
+  if (element.BytesRemaining() == 0)
+    ++element_index_;
+  current_position_ += *bytes_read;
+
+  callback.Run(*bytes_read);
+}
+
 bool UploadDataStream::IsEOF() const {
   const std::vector<UploadData::Element>& elements = *upload_data_->elements();
 
@@ -7,6 +7,8 @@
 #pragma once
 
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "net/base/completion_callback.h"
 #include "net/base/net_export.h"
 #include "net/base/upload_data.h"
 
@@ -38,11 +40,21 @@ class NET_EXPORT UploadDataStream {
   // upload data is smaller than size()), zeros are padded to ensure that
   // size() bytes can be read, which can happen for TYPE_FILE payloads.
   //
+  // TYPE_FILE elements are read on the worker pool: if the read reaches one,
+  // ERR_IO_PENDING is returned and |callback| is run with the number of bytes
+  // read once it is done. |buf| must stay untouched until then. Data that
+  // precedes the file in the same call is returned right away instead, and
+  // the file is read by the next call.
+  //
   // If the upload data stream is chunked (i.e. is_chunked() is true),
-  // ERR_IO_PENDING is returned to indicate there is nothing to read at the
-  // moment, but more data to come at a later time. If not chunked, reads
-  // won't fail.
-  int Read(IOBuffer* buf, int buf_len);
+  // ERR_IO_PENDING is also returned to indicate there is nothing to read at
+  // the moment, but more data to come at a later time. In that case the chunk
+  // callback is run instead of |callback|. If not chunked, reads won't fail.
+  int Read(IOBuffer* buf, int buf_len, const CompletionCallback& callback);
+
+  // Like Read(), but reads TYPE_FILE elements synchronously, on the calling
+  // thread.
+  int ReadSync(IOBuffer* buf, int buf_len);
 
   // Sets the callback to be invoked when new chunks are available to upload.
   void set_chunk_callback(ChunkCallback* callback) {
@@ -69,6 +81,15 @@ class NET_EXPORT UploadDataStream {
   static void set_merge_chunks(bool merge) { merge_chunks_ = merge; }
 
  private:
+  // Copies up to |buf_len| bytes of element data into |buf|. If
+  // |stop_at_file| is true, stops before a TYPE_FILE element that has data
+  // left; otherwise reads the file synchronously.
+  int ReadElements(IOBuffer* buf, int buf_len, bool stop_at_file);
+
+  // Called back when a TYPE_FILE element has been read on the worker pool.
+  void OnFileElementRead(const CompletionCallback& callback,
+                         const int* bytes_read);
+
   scoped_refptr<UploadData> upload_data_;
 
   // Index of the current upload element (i.e. the element currently being
@@ -83,10 +104,15 @@ class NET_EXPORT UploadDataStream {
   // True if the initialization was successful.
   bool initialized_successfully_;
 
+  // True while a TYPE_FILE element is being read on the worker pool.
+  bool file_read_in_progress_;
+
   // TODO(satish): Remove this once we have a better way to unit test POST
   // requests with chunked uploads.
   static bool merge_chunks_;
 
+  base::WeakPtrFactory<UploadDataStream> weak_ptr_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(UploadDataStream);
 };
 
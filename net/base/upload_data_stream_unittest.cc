@@ -15,6 +15,7 @@
 #include "base/time.h"
 #include "net/base/io_buffer.h"
 #include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
 #include "net/base/upload_data.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
@@ -60,7 +61,7 @@ TEST_F(UploadDataStreamTest, ConsumeAll) {
   EXPECT_FALSE(stream->IsEOF());
   scoped_refptr<IOBuffer> buf = new IOBuffer(kTestBufferSize);
   while (!stream->IsEOF()) {
-    int bytes_read = stream->Read(buf, kTestBufferSize);
+    int bytes_read = stream->ReadSync(buf, kTestBufferSize);
     ASSERT_LE(0, bytes_read);  // Not an error.
   }
   EXPECT_EQ(kTestDataSize, stream->position());
@@ -91,7 +92,7 @@ TEST_F(UploadDataStreamTest, FileSmallerThanLength) {
   uint64 read_counter = 0;
   scoped_refptr<IOBuffer> buf = new IOBuffer(kTestBufferSize);
   while (!stream->IsEOF()) {
-    int bytes_read = stream->Read(buf, kTestBufferSize);
+    int bytes_read = stream->ReadSync(buf, kTestBufferSize);
     ASSERT_LE(0, bytes_read);  // Not an error.
     read_counter += bytes_read;
     EXPECT_EQ(read_counter, stream->position());
@@ -104,6 +105,41 @@ TEST_F(UploadDataStreamTest, FileSmallerThanLength) {
   file_util::Delete(temp_file_path, false);
 }
 
+// Read() returns the data in memory right away, and reads files on the worker
+// pool.
+TEST_F(UploadDataStreamTest, ReadFileAsynchronously) {
+  FilePath temp_file_path;
+  ASSERT_TRUE(file_util::CreateTemporaryFile(&temp_file_path));
+  ASSERT_EQ(static_cast<int>(kTestDataSize),
+            file_util::WriteFile(temp_file_path, kTestData, kTestDataSize));
+
+  upload_data_->AppendBytes("abc", 3);
+  upload_data_->AppendFileRange(temp_file_path, 0, kuint64max, base::Time());
+  upload_data_->AppendBytes("xyz", 3);
+
+  scoped_ptr<UploadDataStream> stream(new UploadDataStream(upload_data_));
+  ASSERT_EQ(OK, stream->Init());
+  EXPECT_EQ(kTestDataSize + 6, stream->size());
+
+  scoped_refptr<IOBuffer> buf = new IOBuffer(kTestBufferSize);
+  std::string data;
+  while (!stream->IsEOF()) {
+    TestCompletionCallback callback;
+    int bytes_read = stream->Read(buf, kTestBufferSize, callback.callback());
+    if (bytes_read == ERR_IO_PENDING) {
+      // Only the file is read asynchronously.
+      EXPECT_EQ(3U, data.size());
+      bytes_read = callback.WaitForResult();
+    }
+    ASSERT_LT(0, bytes_read);
+    data.append(buf->data(), bytes_read);
+    EXPECT_EQ(data.size(), stream->position());
+  }
+  EXPECT_EQ("abc" + std::string(kTestData) + "xyz", data);
+
+  file_util::Delete(temp_file_path, false);
+}
+
 void UploadDataStreamTest::FileChangedHelper(const FilePath& file_path,
                                              const base::Time& time,
                                              bool error_expected) {
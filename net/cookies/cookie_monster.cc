@@ -108,6 +108,9 @@ typedef std::vector<CookieMonster::CanonicalCookie*> CanonicalCookieVector;
 // will update it again.
 const int kDefaultAccessUpdateThresholdSeconds = 60;
 
+// Maximum number of entries kept by CookieMonster::GetKey()'s memoization.
+const size_t kMaxKeyCacheSize = 1000;
+
 // Comparator to sort cookies from highest creation date to lowest
 // creation date.
 struct OrderByCreationTimeDesc {
@@ -1788,6 +1791,7 @@ void CookieMonster::FindCookiesForKey(
 
   const std::string scheme(url.scheme());
   const std::string host(url.host());
+  const std::string path(url.path());
   bool secure = url.SchemeIsSecure();
 
   for (CookieMapItPair its = cookies_.equal_range(key);
@@ -1814,7 +1818,7 @@ void CookieMonster::FindCookiesForKey(
     if (!cc->IsDomainMatch(scheme, host))
       continue;
 
-    if (!cc->IsOnPath(url.path()))
+    if (!cc->IsOnPath(path))
       continue;
 
     // Add this cookie to the set of matching cookies.  Update the access
@@ -2162,13 +2166,23 @@ int CookieMonster::GarbageCollectDeleteList(
 // be worth it, but is still too much trouble to solve what is currently a
 // non-problem).
 std::string CookieMonster::GetKey(const std::string& domain) const {
+  KeyCache::const_iterator cached = key_cache_.find(domain);
+  if (cached != key_cache_.end())
+    return cached->second;
+
   std::string effective_domain(
       RegistryControlledDomainService::GetDomainAndRegistry(domain));
   if (effective_domain.empty())
     effective_domain = domain;
 
   if (!effective_domain.empty() && effective_domain[0] == '.')
-    return effective_domain.substr(1);
+    effective_domain.erase(0, 1);
+
+  // Hosts are not evicted individually; when the cache is full just start
+  // over, which is cheap compared to the lookups it saves.
+  if (key_cache_.size() >= kMaxKeyCacheSize)
+    key_cache_.clear();
+  key_cache_.insert(std::make_pair(domain, effective_domain));
   return effective_domain;
 }
 
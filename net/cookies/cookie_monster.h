@@ -548,7 +548,9 @@ class NET_EXPORT CookieMonster : public CookieStore {
                                std::vector<CookieMap::iterator>& cookie_its);
 
   // Find the key (for lookup in cookies_) based on the given domain.
-  // See comment on keys before the CookieMap typedef.
+  // See comment on keys before the CookieMap typedef.  Results are memoized
+  // in |key_cache_|, since computing the key requires walking the registry
+  // controlled domain tables and it is done on every cookie lookup.
   std::string GetKey(const std::string& domain) const;
 
   bool HasCookieableScheme(const GURL& url);
@@ -593,6 +595,12 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   CookieMap cookies_;
 
+  // Maps hosts and cookie domains to their CookieMap key; see GetKey().  The
+  // mapping only depends on the registry controlled domain data, so entries
+  // never become stale.  The cache is bounded by kMaxKeyCacheSize.
+  typedef std::map<std::string, std::string> KeyCache;
+  mutable KeyCache key_cache_;
+
   // Indicates whether the cookie store has been initialized. This happens
   // lazily in InitStoreIfNecessary().
   bool initialized_;
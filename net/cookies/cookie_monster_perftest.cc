@@ -357,6 +357,50 @@ TEST_F(CookieMonsterTest, TestImport) {
   EXPECT_EQ("domain_1.com", cm->GetKey("www.Domain_1.com"));
 }
 
+// Measures lookups against stores of increasing size, where the cookies are
+// spread over 10 cookies per eTLD+1 and the probed host has its own cookies
+// as well as domain cookies inherited from its eTLD+1.
+TEST_F(CookieMonsterTest, TestGetCookiesScaling) {
+  const int kStoreSizes[] = { 3000, 10000, 50000 };
+  const int kCookiesPerDomain = 10;
+
+  for (size_t i = 0; i < arraysize(kStoreSizes); ++i) {
+    scoped_refptr<MockPersistentCookieStore> store(
+        new MockPersistentCookieStore);
+    std::vector<CookieMonster::CanonicalCookie*> initial_cookies;
+    GetCookiesCallback getCookiesCallback;
+    int64 time_tick(base::Time::Now().ToInternalValue());
+
+    int num_domains = kStoreSizes[i] / kCookiesPerDomain;
+    for (int domain_num = 0; domain_num < num_domains; domain_num++) {
+      std::string domain_name(base::StringPrintf(".domain%d.com", domain_num));
+      std::string host_name("www" + domain_name);
+      for (int cookie_num = 0; cookie_num < kCookiesPerDomain; cookie_num++) {
+        std::string cookie_line(base::StringPrintf("c%d=1; Path=/",
+                                                   cookie_num));
+        // Alternate between host cookies and domain cookies.
+        AddCookieToList(cookie_num % 2 ? host_name : domain_name, cookie_line,
+                        base::Time::FromInternalValue(time_tick++),
+                        &initial_cookies);
+      }
+    }
+    store->SetLoadExpectation(true, initial_cookies);
+
+    scoped_refptr<CookieMonster> cm(new CookieMonster(store, NULL));
+    GURL probe_gurl(base::StringPrintf("http://www.domain%d.com/",
+                                       num_domains / 2));
+    // The first access triggers the import.
+    std::string cookie_line = getCookiesCallback.GetCookies(cm, probe_gurl);
+    EXPECT_EQ(kCookiesPerDomain, CountInString(cookie_line, '='));
+
+    PerfTimeLogger timer(base::StringPrintf(
+        "Cookie_monster_get_cookies_%d", kStoreSizes[i]).c_str());
+    for (int j = 0; j < kNumCookies; j++)
+      getCookiesCallback.GetCookies(cm, probe_gurl);
+    timer.Done();
+  }
+}
+
 TEST_F(CookieMonsterTest, TestGetKey) {
   scoped_refptr<CookieMonster> cm(new CookieMonster(NULL, NULL));
   PerfTimeLogger timer("Cookie_monster_get_key");
@@ -0,0 +1,7 @@
+// Only looks at the host, so its results can be cached per host.
+function FindProxyForURL(url, host) {
+  var ip = dnsResolve(host);
+  if (ip && isInNet(ip, "10.0.0.0", "255.0.0.0"))
+    return "DIRECT";
+  return "PROXY " + host + ":8080";
+}
@@ -52,6 +52,9 @@ const int kDefaultCacheSize = 80 * 1024 * 1024;
 // Avoid trimming the cache for the first 5 minutes (10 timer ticks).
 const int kTrimDelay = 10;
 
+// Number of threads that perform file IO when kParallelIO is set.
+const int kNumIOThreads = 4;
+
 int DesiredIndexTableLen(int32 storage_size) {
   if (storage_size <= k64kEntriesStore)
     return kBaseTableLen;
@@ -421,6 +424,11 @@ int BackendImpl::SyncInit() {
   num_refs_ = num_pending_io_ = max_refs_ = 0;
   entry_count_ = byte_count_ = 0;
 
+  // Only the raw file IO moves to the pool; index and rankings updates still
+  // happen in order on this thread.
+  if (user_flags_ & kParallelIO)
+    File::SetNumIOThreads(kNumIOThreads);
+
   if (!restarted_) {
     buffer_bytes_ = 0;
     trace_object_ = TraceObject::GetTraceObject();
@@ -1074,7 +1082,9 @@ bool BackendImpl::IsLoaded() const {
   if (user_flags_ & kNoLoadProtection)
     return false;
 
-  return (num_pending_io_ > 5 || user_load_);
+  // With parallel IO we can sustain more outstanding operations.
+  int max_pending_io = (user_flags_ & kParallelIO) ? kNumIOThreads * 5 : 5;
+  return (num_pending_io_ > max_pending_io || user_load_);
 }
 
 std::string BackendImpl::HistogramName(const char* name, int experiment) const {
@@ -35,7 +35,9 @@ enum BackendFlags {
   kNewEviction = 1 << 4,        // Use of new eviction was specified.
   kNoRandom = 1 << 5,           // Don't add randomness to the behavior.
   kNoLoadProtection = 1 << 6,   // Don't act conservatively under load.
-  kNoBuffering = 1 << 7         // Disable extended IO buffering.
+  kNoBuffering = 1 << 7,        // Disable extended IO buffering.
+  kParallelIO = 1 << 8,         // Use a dedicated pool of threads for file IO.
+  kSizeAwareEviction = 1 << 9   // Weigh entry size when ranking for eviction.
 };
 
 // This class implements the Backend interface. An object of this
@@ -531,6 +531,22 @@ TEST_F(DiskCacheBackendTest, MemoryOnlySetSize) {
   BackendSetSize();
 }
 
+// Tests that the memory used by each entry counts towards the cache size.
+TEST_F(DiskCacheBackendTest, MemoryOnlyEntryOverhead) {
+  SetMemoryOnlyMode();
+  SetMaxSize(0x10000);
+  InitCache();
+
+  // The keys alone use much less than the cache size.
+  const int kNumEntries = 1000;
+  disk_cache::Entry* entry;
+  for (int i = 0; i < kNumEntries; i++) {
+    ASSERT_EQ(net::OK, CreateEntry(StringPrintf("Key %d", i), &entry));
+    entry->Close();
+  }
+  EXPECT_GT(kNumEntries, cache_->GetEntryCount());
+}
+
 void DiskCacheBackendTest::BackendLoad() {
   InitCache();
   int seed = static_cast<int>(Time::Now().ToInternalValue());
@@ -651,6 +667,41 @@ TEST_F(DiskCacheBackendTest, NewEvictionTrim) {
   entry->Close();
 }
 
+// Tests that with size aware eviction a large entry that is reused is kept
+// over a small one.
+TEST_F(DiskCacheBackendTest, NewEvictionTrimSizeAware) {
+  SetNewEviction();
+  SetMaxSize(0x400000);
+  SetDirectMode();
+  InitCache();
+  cache_impl_->SetFlags(disk_cache::kSizeAwareEviction);
+
+  const int kLargeSize = 0x10000;
+  const int kSmallSize = 100;
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(kLargeSize));
+  CacheTestFillBuffer(buffer->data(), kLargeSize, false);
+
+  disk_cache::Entry* entry;
+  ASSERT_EQ(net::OK, CreateEntry("large", &entry));
+  EXPECT_EQ(kLargeSize, WriteData(entry, 1, 0, buffer, kLargeSize, false));
+  entry->Close();
+  ASSERT_EQ(net::OK, CreateEntry("small", &entry));
+  EXPECT_EQ(kSmallSize, WriteData(entry, 1, 0, buffer, kSmallSize, false));
+  entry->Close();
+
+  // Without the size, the large entry would be the least recently used one on
+  // the LOW_USE list.
+  ASSERT_EQ(net::OK, OpenEntry("large", &entry));
+  entry->Close();
+  ASSERT_EQ(net::OK, OpenEntry("small", &entry));
+  entry->Close();
+
+  TrimForTest(false);
+  EXPECT_NE(net::OK, OpenEntry("small", &entry));
+  ASSERT_EQ(net::OK, OpenEntry("large", &entry));
+  entry->Close();
+}
+
 // Before looking for invalid entries, let's check a valid entry.
 void DiskCacheBackendTest::BackendValidEntry() {
   SetDirectMode();
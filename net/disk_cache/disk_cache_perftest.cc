@@ -2,13 +2,16 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/perftimer.h"
 #include "base/string_util.h"
+#include "base/stringprintf.h"
 #include "base/threading/thread.h"
 #include "base/test/test_file_util.h"
 #include "base/timer.h"
@@ -20,6 +23,7 @@
 #include "net/disk_cache/disk_cache.h"
 #include "net/disk_cache/disk_cache_test_base.h"
 #include "net/disk_cache/disk_cache_test_util.h"
+#include "net/disk_cache/file.h"
 #include "net/disk_cache/hash.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
@@ -138,6 +142,101 @@ bool TimeRead(int num_entries, disk_cache::Backend* cache,
   return (expected == helper.callbacks_called());
 }
 
+// Opens every entry listed on |entries| and then issues all the reads at once,
+// so that |num_readers| independent entries are in flight at the same time.
+bool TimeConcurrentRead(int num_readers, disk_cache::Backend* cache,
+                        const TestEntries& entries, const char* message) {
+  std::vector<disk_cache::Entry*> cache_entries;
+  std::vector<scoped_refptr<net::IOBuffer> > buffers;
+  for (int i = 0; i < num_readers; i++) {
+    disk_cache::Entry* cache_entry;
+    net::TestCompletionCallback cb;
+    int rv = cache->OpenEntry(entries[i].key, &cache_entry, cb.callback());
+    if (net::OK != cb.GetResult(rv))
+      break;
+    cache_entries.push_back(cache_entry);
+    buffers.push_back(new net::IOBuffer(kMaxSize));
+  }
+  if (cache_entries.size() != static_cast<size_t>(num_readers)) {
+    for (size_t i = 0; i < cache_entries.size(); i++)
+      cache_entries[i]->Close();
+    return false;
+  }
+
+  int expected = 0;
+  int64 total_bytes = 0;
+
+  MessageLoopHelper helper;
+  CallbackTest callback(&helper, true);
+
+  PerfTimer timer;
+
+  bool failed = false;
+  for (int i = 0; i < num_readers; i++) {
+    int ret = cache_entries[i]->ReadData(
+        1, 0, buffers[i], entries[i].data_len,
+        base::Bind(&CallbackTest::Run, base::Unretained(&callback)));
+    if (net::ERR_IO_PENDING == ret)
+      expected++;
+    else if (entries[i].data_len != ret)
+      failed = true;
+    total_bytes += entries[i].data_len;
+  }
+
+  helper.WaitUntilCacheIoFinished(expected);
+  double seconds = timer.Elapsed().InSecondsF();
+  LogPerfResult(message, seconds ? total_bytes / 1024.0 / seconds : 0, "KB/s");
+
+  for (size_t i = 0; i < cache_entries.size(); i++)
+    cache_entries[i]->Close();
+
+  return !failed && (expected == helper.callbacks_called());
+}
+
+// Replays |trace| against |cache|, writing the entries that are missing, and
+// logs the fraction of requests and bytes served from the cache.
+bool ReplayTrace(const std::vector<int>& trace, const std::vector<int>& sizes,
+                 disk_cache::Backend* cache, const std::string& message) {
+  int max_size = 0;
+  for (size_t i = 0; i < sizes.size(); i++)
+    max_size = std::max(max_size, sizes[i]);
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(max_size));
+  CacheTestFillBuffer(buffer->data(), max_size, false);
+
+  int hits = 0;
+  int64 total_bytes = 0;
+  int64 hit_bytes = 0;
+  for (size_t i = 0; i < trace.size(); i++) {
+    int id = trace[i];
+    std::string key = StringPrintf("trace entry %d", id);
+    total_bytes += sizes[id];
+
+    disk_cache::Entry* cache_entry;
+    net::TestCompletionCallback cb;
+    int rv = cache->OpenEntry(key, &cache_entry, cb.callback());
+    if (net::OK == cb.GetResult(rv)) {
+      hits++;
+      hit_bytes += sizes[id];
+      cache_entry->Close();
+      continue;
+    }
+
+    rv = cache->CreateEntry(key, &cache_entry, cb.callback());
+    if (net::OK != cb.GetResult(rv))
+      return false;
+    rv = cache_entry->WriteData(1, 0, buffer, sizes[id], cb.callback(), false);
+    cache_entry->Close();
+    if (sizes[id] != cb.GetResult(rv))
+      return false;
+  }
+
+  LogPerfResult((message + " hit ratio").c_str(),
+                hits * 100.0 / trace.size(), "%");
+  LogPerfResult((message + " byte hit ratio").c_str(),
+                total_bytes ? hit_bytes * 100.0 / total_bytes : 0, "%");
+  return true;
+}
+
 int BlockSize() {
   // We can use form 1 to 4 blocks.
   return (rand() & 0x3) + 1;
@@ -206,6 +305,99 @@ TEST_F(DiskCacheTest, CacheBackendPerformance) {
   delete cache;
 }
 
+// Measures the throughput of many readers operating on independent entries at
+// the same time, with and without the dedicated file IO pool.
+TEST_F(DiskCacheTest, CacheBackendConcurrentReadPerformance) {
+  base::Thread cache_thread("CacheThread");
+  ASSERT_TRUE(cache_thread.StartWithOptions(
+                  base::Thread::Options(MessageLoop::TYPE_IO, 0)));
+
+  ASSERT_TRUE(CleanupCacheDir());
+  net::TestCompletionCallback cb;
+  disk_cache::Backend* cache;
+  int rv = disk_cache::CreateCacheBackend(
+      net::DISK_CACHE, cache_path_, 0, false,
+      cache_thread.message_loop_proxy(), NULL, &cache, cb.callback());
+  ASSERT_EQ(net::OK, cb.GetResult(rv));
+
+  int seed = static_cast<int>(Time::Now().ToInternalValue());
+  srand(seed);
+
+  TestEntries entries;
+  const int kNumReaders = 500;
+  EXPECT_TRUE(TimeWrite(kNumReaders, cache, &entries));
+
+  MessageLoop::current()->RunAllPending();
+  delete cache;
+
+  const uint32 kFlags[] = { disk_cache::kNone, disk_cache::kParallelIO };
+  const char* kMessages[] = { "Concurrent disk cache reads (shared pool)",
+                              "Concurrent disk cache reads (parallel IO)" };
+  for (size_t i = 0; i < arraysize(kFlags); i++) {
+    disk_cache::BackendImpl* cache_impl = new disk_cache::BackendImpl(
+        cache_path_, cache_thread.message_loop_proxy(), NULL);
+    cache_impl->SetFlags(kFlags[i]);
+    rv = cache_impl->Init(cb.callback());
+    ASSERT_EQ(net::OK, cb.GetResult(rv));
+
+    EXPECT_TRUE(TimeConcurrentRead(kNumReaders, cache_impl, entries,
+                                   kMessages[i]));
+
+    MessageLoop::current()->RunAllPending();
+    delete cache_impl;
+  }
+  disk_cache::File::SetNumIOThreads(0);
+}
+
+// Replays the same synthetic trace, a skewed mix of small entries and a few
+// large media entries, with each eviction policy, and reports how much of it
+// is served from the cache.
+TEST_F(DiskCacheTest, EvictionPolicyTraceReplay) {
+  base::Thread cache_thread("CacheThread");
+  ASSERT_TRUE(cache_thread.StartWithOptions(
+                  base::Thread::Options(MessageLoop::TYPE_IO, 0)));
+
+  // Use a fixed seed so that both policies see the same requests.
+  srand(1);
+  const int kNumSmall = 2000;
+  const int kNumLarge = 40;
+  std::vector<int> sizes;
+  for (int i = 0; i < kNumSmall; i++)
+    sizes.push_back(1024 + rand() % (16 * 1024));
+  for (int i = 0; i < kNumLarge; i++)
+    sizes.push_back(128 * 1024 + rand() % (384 * 1024));
+
+  // Small entries are requested with a long tail of rarely seen keys, and one
+  // request out of ten goes to one of the large entries.
+  std::vector<int> trace;
+  for (int i = 0; i < 20000; i++) {
+    if (rand() % 10)
+      trace.push_back(rand() % (1 + rand() % kNumSmall));
+    else
+      trace.push_back(kNumSmall + rand() % kNumLarge);
+  }
+
+  const uint32 kFlags[] = { disk_cache::kNone, disk_cache::kSizeAwareEviction };
+  const char* kMessages[] = { "Trace replay (new eviction)",
+                              "Trace replay (size aware eviction)" };
+  for (size_t i = 0; i < arraysize(kFlags); i++) {
+    ASSERT_TRUE(CleanupCacheDir());
+    disk_cache::BackendImpl* cache_impl = new disk_cache::BackendImpl(
+        cache_path_, cache_thread.message_loop_proxy(), NULL);
+    ASSERT_TRUE(cache_impl->SetMaxSize(8 * 1024 * 1024));
+    cache_impl->SetNewEviction();
+    cache_impl->SetFlags(disk_cache::kNoRandom | kFlags[i]);
+    net::TestCompletionCallback cb;
+    int rv = cache_impl->Init(cb.callback());
+    ASSERT_EQ(net::OK, cb.GetResult(rv));
+
+    EXPECT_TRUE(ReplayTrace(trace, sizes, cache_impl, kMessages[i]));
+
+    MessageLoop::current()->RunAllPending();
+    delete cache_impl;
+  }
+}
+
 // Creating and deleting "entries" on a block-file is something quite frequent
 // (after all, almost everything is stored on block files). The operation is
 // almost free when the file is empty, but can be expensive if the file gets
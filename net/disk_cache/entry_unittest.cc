@@ -1514,6 +1514,27 @@ void DiskCacheEntryTest::GetAvailableRange() {
   EXPECT_EQ(1, cb.GetResult(rv));
   EXPECT_EQ(0x20F0000, start);
 
+  // Write across the end of the child at 32 MB, and make sure that the data is
+  // returned as a single range.
+  EXPECT_EQ(kSize, WriteSparseData(entry, 0x20FE000, buf, kSize));
+  start = 0;
+  rv = entry->GetAvailableRange(0x20FE000 - kSize, kSize * 3, &start,
+                                cb.callback());
+  EXPECT_EQ(kSize, cb.GetResult(rv));
+  EXPECT_EQ(0x20FE000, start);
+  EXPECT_EQ(kSize, ReadSparseData(entry, start, buf, kSize));
+
+  start = 0;
+  rv = entry->GetAvailableRange(0x20FF000, kSize, &start, cb.callback());
+  EXPECT_EQ(0x3000, cb.GetResult(rv));
+  EXPECT_EQ(0x20FF000, start);
+
+  // A query that ends with the child doesn't look into the next one.
+  start = 0;
+  rv = entry->GetAvailableRange(0x20FE000, 0x2000, &start, cb.callback());
+  EXPECT_EQ(0x2000, cb.GetResult(rv));
+  EXPECT_EQ(0x20FE000, start);
+
   entry->Close();
 }
 
@@ -26,6 +26,11 @@
 // size so that we have a chance to see an element again and move it to another
 // list.
 
+// With kSizeAwareEviction, an entry that takes a large share of the cache is
+// moved straight to the HIGH_USE list the first time it is reused: fetching it
+// again from the network costs as much as many small entries, so once it has
+// proven to be useful it should not be the first thing to go.
+
 #include "net/disk_cache/eviction.h"
 
 #include "base/bind.h"
@@ -49,6 +54,8 @@ const int kCleanUpMargin = 1024 * 1024;
 const int kHighUse = 10;  // Reuse count to be on the HIGH_USE list.
 const int kTargetTime = 24 * 7;  // Time to be evicted (hours since last use).
 const int kMaxDelayedTrims = 60;
+// An entry bigger than 1/kLargeEntryRatio of the cache is considered large.
+const int kLargeEntryRatio = 64;
 
 int LowWaterAdjust(int high_water) {
   if (high_water < kCleanUpMargin)
@@ -397,8 +404,10 @@ void Eviction::OnOpenEntryV2(EntryImpl* entry) {
 
     // We may need to move this to a new list.
     if (1 == info->reuse_count) {
+      if (IsLargeEntry(entry))
+        info->reuse_count = kHighUse;
       rankings_->Remove(entry->rankings(), Rankings::NO_USE, true);
-      rankings_->Insert(entry->rankings(), false, Rankings::LOW_USE);
+      rankings_->Insert(entry->rankings(), false, GetListForEntryV2(entry));
       entry->entry()->Store();
     } else if (kHighUse == info->reuse_count) {
       rankings_->Remove(entry->rankings(), Rankings::LOW_USE, true);
@@ -475,6 +484,17 @@ Rankings::List Eviction::GetListForEntryV2(EntryImpl* entry) {
   return Rankings::HIGH_USE;
 }
 
+bool Eviction::IsLargeEntry(EntryImpl* entry) {
+  if (!(backend_->user_flags_ & kSizeAwareEviction))
+    return false;
+
+  EntryStore* info = entry->entry()->Data();
+  int64 size = 0;
+  for (size_t i = 0; i < arraysize(info->data_size); i++)
+    size += info->data_size[i];
+  return size > max_size_ / kLargeEntryRatio;
+}
+
 // This is a minimal implementation that just discards the oldest nodes.
 // TODO(rvargas): Do something better here.
 void Eviction::TrimDeleted(bool empty) {
@@ -63,6 +63,7 @@ class Eviction {
   void OnDoomEntryV2(EntryImpl* entry);
   void OnDestroyEntryV2(EntryImpl* entry);
   Rankings::List GetListForEntryV2(EntryImpl* entry);
+  bool IsLargeEntry(EntryImpl* entry);
   void TrimDeleted(bool empty);
   bool RemoveDeletedNode(CacheRankingsBlock* node);
 
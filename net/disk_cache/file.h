@@ -71,6 +71,14 @@ class NET_EXPORT_PRIVATE File : public base::RefCounted<File> {
   // Drops current pending operations without waiting for them to complete.
   static void DropPendingIO();
 
+  // Dispatches asynchronous operations to a dedicated pool of up to
+  // |num_threads| workers instead of the shared WorkerPool, so that IO on
+  // independent files (or independent ranges of a block file) can proceed in
+  // parallel without competing with unrelated background work. A value of zero
+  // restores the default behavior. This is a no-op on platforms that perform
+  // overlapped IO.
+  static void SetNumIOThreads(int num_threads);
+
  protected:
   virtual ~File();
 
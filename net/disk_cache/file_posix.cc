@@ -9,6 +9,7 @@
 #include "base/bind.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/threading/sequenced_worker_pool.h"
 #include "base/threading/worker_pool.h"
 #include "net/base/net_errors.h"
 #include "net/disk_cache/disk_cache.h"
@@ -110,14 +111,29 @@ void FileBackgroundIO::Write() {
 
 // ---------------------------------------------------------------------------
 
+// The dedicated pool used for file IO, if any. This object is deliberately
+// leaked because tasks are posted with CONTINUE_ON_SHUTDOWN semantics and the
+// pool may outlive any given cache instance.
+base::SequencedWorkerPool* s_io_pool = NULL;
+bool s_use_io_pool = false;
+
+// Runs |task| on the dedicated IO pool when enabled, or on the WorkerPool.
+void PostFileTask(const base::Closure& task) {
+  if (s_use_io_pool) {
+    s_io_pool->PostWorkerTaskWithShutdownBehavior(
+        FROM_HERE, task, base::SequencedWorkerPool::CONTINUE_ON_SHUTDOWN);
+    return;
+  }
+  base::WorkerPool::PostTask(FROM_HERE, task, true);
+}
+
 void FileInFlightIO::PostRead(disk_cache::File *file, void* buf, size_t buf_len,
                           size_t offset, disk_cache::FileIOCallback *callback) {
   scoped_refptr<FileBackgroundIO> operation(
       new FileBackgroundIO(file, buf, buf_len, offset, callback, this));
   file->AddRef();  // Balanced on OnOperationComplete()
 
-  base::WorkerPool::PostTask(FROM_HERE,
-      base::Bind(&FileBackgroundIO::Read, operation.get()), true);
+  PostFileTask(base::Bind(&FileBackgroundIO::Read, operation.get()));
   OnOperationPosted(operation);
 }
 
@@ -128,8 +144,7 @@ void FileInFlightIO::PostWrite(disk_cache::File* file, const void* buf,
       new FileBackgroundIO(file, buf, buf_len, offset, callback, this));
   file->AddRef();  // Balanced on OnOperationComplete()
 
-  base::WorkerPool::PostTask(FROM_HERE,
-      base::Bind(&FileBackgroundIO::Write, operation.get()), true);
+  PostFileTask(base::Bind(&FileBackgroundIO::Write, operation.get()));
   OnOperationPosted(operation);
 }
 
@@ -288,6 +303,18 @@ void File::DropPendingIO() {
   DeleteFileInFlightIO();
 }
 
+// Static.
+void File::SetNumIOThreads(int num_threads) {
+  DCHECK_GE(num_threads, 0);
+  s_use_io_pool = num_threads > 0;
+  if (!s_use_io_pool || s_io_pool)
+    return;
+
+  // The size of the pool is fixed the first time it is created.
+  s_io_pool = new base::SequencedWorkerPool(num_threads, "CacheIO");
+  s_io_pool->AddRef();  // Leaked on purpose.
+}
+
 File::~File() {
   if (IsValid())
     base::ClosePlatformFile(platform_file_);
@@ -269,4 +269,9 @@ void File::DropPendingIO() {
   // Nothing to do here.
 }
 
+// Static.
+void File::SetNumIOThreads(int num_threads) {
+  // Overlapped IO is already completed by the system without tying up threads.
+}
+
 }  // namespace disk_cache
@@ -45,6 +45,10 @@ std::string GenerateChildName(const std::string& base_name, int child_id) {
 
 namespace disk_cache {
 
+// Memory used by each entry besides its key and data. It is charged to the
+// cache so that the size limit holds for caches full of tiny entries.
+const int32 kEntryOverhead = static_cast<int32>(sizeof(MemEntryImpl));
+
 MemEntryImpl::MemEntryImpl(MemBackendImpl* backend) {
   doomed_ = false;
   backend_ = backend;
@@ -71,7 +75,8 @@ bool MemEntryImpl::CreateEntry(const std::string& key, net::NetLog* net_log) {
   last_modified_ = current;
   last_used_ = current;
   Open();
-  backend_->ModifyStorageSize(0, static_cast<int32>(key.size()));
+  backend_->ModifyStorageSize(
+      0, static_cast<int32>(key.size()) + kEntryOverhead);
   return true;
 }
 
@@ -144,6 +149,8 @@ void MemEntryImpl::Close() {
   DCHECK_GE(ref_count_, 0);
   if (!ref_count_ && doomed_)
     InternalDoom();
+  else if (!ref_count_)
+    Compact();
 }
 
 std::string MemEntryImpl::GetKey() const {
@@ -263,7 +270,8 @@ int MemEntryImpl::ReadyForSparseIO(const CompletionCallback& callback) {
 MemEntryImpl::~MemEntryImpl() {
   for (int i = 0; i < NUM_STREAMS; i++)
     backend_->ModifyStorageSize(data_size_[i], 0);
-  backend_->ModifyStorageSize(static_cast<int32>(key_.size()), 0);
+  backend_->ModifyStorageSize(
+      static_cast<int32>(key_.size()) + kEntryOverhead, 0);
   net_log_.EndEvent(net::NetLog::TYPE_DISK_CACHE_MEM_ENTRY_IMPL, NULL);
 }
 
@@ -518,6 +526,16 @@ void MemEntryImpl::PrepareTarget(int index, int offset, int buf_len) {
   memset(&(data_[index])[entry_size], 0, offset - entry_size);
 }
 
+void MemEntryImpl::Compact() {
+  for (int i = 0; i < NUM_STREAMS; i++) {
+    if (data_[i].capacity() == static_cast<size_t>(data_size_[i]))
+      continue;
+    std::vector<char> data(data_[i].begin(),
+                           data_[i].begin() + data_size_[i]);
+    data_[i].swap(data);
+  }
+}
+
 void MemEntryImpl::UpdateRank(bool modified) {
   Time current = Time::Now();
   last_used_ = current;
@@ -564,6 +582,8 @@ bool MemEntryImpl::InitChildEntry(MemEntryImpl* parent, int child_id,
   Time current = Time::Now();
   last_modified_ = current;
   last_used_ = current;
+  // Account for this entry before it can be picked for eviction.
+  backend_->ModifyStorageSize(0, kEntryOverhead);
   // Insert this to the backend's ranking list.
   backend_->InsertIntoRankingList(this);
   return true;
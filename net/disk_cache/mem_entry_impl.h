@@ -136,6 +136,11 @@ class MemEntryImpl : public Entry {
   // Grows and cleans up the data buffer.
   void PrepareTarget(int index, int offset, int buf_len);
 
+  // Releases the memory reserved by the data buffers beyond the stored data.
+  // Writes grow the buffers geometrically, so this is done once the entry is
+  // no longer in use.
+  void Compact();
+
   // Updates ranking information.
   void UpdateRank(bool modified);
 
@@ -756,46 +756,64 @@ bool SparseControl::DoChildIO() {
 }
 
 int SparseControl::DoGetAvailableRange() {
-  if (!child_)
-    return child_len_;  // Move on to the next child.
-
-  // Check that there are no holes in this range.
-  int last_bit = (child_offset_ + child_len_ + 1023) >> 10;
-  int start = child_offset_ >> 10;
-  int partial_start_bytes = PartialBlockLength(start);
-  int found = start;
-  int bits_found = child_map_.FindBits(&found, last_bit, true);
-
-  // We don't care if there is a partial block in the middle of the range.
-  int block_offset = child_offset_ & (kBlockSize - 1);
-  if (!bits_found && partial_start_bytes <= block_offset)
-    return child_len_;
-
-  // We are done. Just break the loop and reset result_ to our real result.
-  range_found_ = true;
-
-  // found now points to the first 1. Lets see if we have zeros before it.
-  int empty_start = std::max((found << 10) - child_offset_, 0);
+  int available = 0;
+  int empty_start = 0;
+  if (child_) {
+    // Check that there are no holes in this range.
+    int last_bit = (child_offset_ + child_len_ + 1023) >> 10;
+    int start = child_offset_ >> 10;
+    int partial_start_bytes = PartialBlockLength(start);
+    int found = start;
+    int bits_found = child_map_.FindBits(&found, last_bit, true);
+
+    // We don't care if there is a partial block in the middle of the range.
+    int block_offset = child_offset_ & (kBlockSize - 1);
+    if (bits_found) {
+      // found now points to the first 1. Lets see if we have zeros before it.
+      empty_start = std::max((found << 10) - child_offset_, 0);
+
+      int bytes_found = bits_found << 10;
+      bytes_found += PartialBlockLength(found + bits_found);
+
+      if (start == found)
+        bytes_found -= block_offset;
+
+      // If the user is searching past the end of this child, bits_found is the
+      // right result; otherwise, we have some empty space at the start of this
+      // query that we have to subtract from the range that we searched.
+      available = std::min(bytes_found, child_len_ - empty_start);
+    } else if (partial_start_bytes > block_offset) {
+      available = std::min(partial_start_bytes - block_offset, child_len_);
+    }
+  }
 
-  int bytes_found = bits_found << 10;
-  bytes_found += PartialBlockLength(found + bits_found);
+  if (!range_found_) {
+    if (!available)
+      return child_len_;  // Move on to the next child.
 
-  if (start == found)
-    bytes_found -= block_offset;
+    range_found_ = true;
+    result_ = 0;
 
-  // If the user is searching past the end of this child, bits_found is the
-  // right result; otherwise, we have some empty space at the start of this
-  // query that we have to subtract from the range that we searched.
-  result_ = std::min(bytes_found, child_len_ - empty_start);
+    // Only update offset_ when this query found zeros at the start.
+    offset_ += empty_start;
+    buf_len_ -= empty_start;
+  } else if (empty_start) {
+    // This data is not contiguous with the range found on the previous child.
+    available = 0;
+  }
 
-  if (!bits_found) {
-    result_ = std::min(partial_start_bytes - block_offset, child_len_);
-    empty_start = 0;
+  // If the range goes all the way to the end of this child, it may continue on
+  // the next one, so keep looking instead of making the caller issue a new
+  // query (and a new range request) for every child.
+  if (available && available == child_len_ - empty_start &&
+      buf_len_ > available) {
+    return available;
   }
 
-  // Only update offset_ when this query found zeros at the start.
-  if (empty_start)
-    offset_ += empty_start;
+  // We are done. Just break the loop and set offset_ and result_ to the start
+  // and length of the whole range.
+  offset_ -= result_;
+  result_ += available;
 
   // This will actually break the loop.
   buf_len_ = 0;
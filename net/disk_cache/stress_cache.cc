@@ -114,6 +114,11 @@ void StressTheCache(int iteration) {
   cache->SetMaxSize(cache_size);
   cache->SetFlags(disk_cache::kNoLoadProtection);
 
+  // Alternate between eviction policies so that both are exercised on the same
+  // files, and the lists left behind by one are valid for the other.
+  if (iteration % 2)
+    cache->SetFlags(disk_cache::kSizeAwareEviction);
+
   net::TestCompletionCallback cb;
   int rv = cache->Init(cb.callback());
 
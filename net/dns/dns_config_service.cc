@@ -145,6 +145,11 @@ void DnsConfigService::StartTimer() {
 
 void DnsConfigService::OnTimeout() {
   DCHECK(CalledOnValidThread());
+  // If only the hosts are still being read and the receiver already has the
+  // rest of the config, let it keep resolving with the old hosts until the
+  // new ones are parsed, which can take a while for a large HOSTS file.
+  if (have_config_ && !need_update_)
+    return;
   // Indicate that even if there is no change in On*Read, we will need to
   // update the receiver when the config becomes complete.
   need_update_ = true;
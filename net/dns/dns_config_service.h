@@ -125,7 +125,8 @@ class NET_EXPORT_PRIVATE DnsConfigService
   // True if receiver needs to be updated when the config becomes complete.
   bool need_update_;
 
-  // Started in Invalidate*, cleared in On*Read.
+  // Started in Invalidate*, cleared in On*Read. Withdraws the config from the
+  // receiver on expiry, unless only the hosts are pending.
   base::OneShotTimer<DnsConfigService> timer_;
 
  private:
@@ -129,10 +129,30 @@ TEST_F(DnsConfigServiceTest, Timeout) {
   service_->OnConfigRead(config);
   EXPECT_TRUE(last_config_.Equals(config));
 
+  service_->InvalidateConfig();
   service_->InvalidateHosts();
   WaitForConfig(TestTimeouts::action_timeout());
   EXPECT_FALSE(last_config_.IsValid());
 
+  service_->OnConfigRead(config);
+  service_->OnHostsRead(config.hosts);
+  EXPECT_TRUE(last_config_.Equals(config));
+}
+
+TEST_F(DnsConfigServiceTest, KeepConfigWhileReadingHosts) {
+  DnsConfig config = MakeConfig(1);
+  config.hosts = MakeHosts(1);
+
+  service_->OnConfigRead(config);
+  service_->OnHostsRead(config.hosts);
+  EXPECT_TRUE(last_config_.Equals(config));
+
+  // Only the hosts are pending, so the old config is not withdrawn.
+  service_->InvalidateHosts();
+  WaitForConfig(TestTimeouts::tiny_timeout() * 5);
+  EXPECT_TRUE(last_config_.Equals(config));
+
+  config.hosts = MakeHosts(2);
   service_->OnHostsRead(config.hosts);
   EXPECT_TRUE(last_config_.Equals(config));
 }
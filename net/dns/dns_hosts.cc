@@ -4,45 +4,70 @@
 
 #include "net/dns/dns_hosts.h"
 
+#include <algorithm>
+
 #include "base/file_util.h"
 #include "base/logging.h"
-#include "base/string_tokenizer.h"
+#include "base/metrics/histogram.h"
+#include "base/string_piece.h"
 #include "base/string_util.h"
+#include "base/time.h"
 
 namespace net {
 
+namespace {
+
+// Splits [|begin|, |end|) at spaces and tabs into |tokens|, which point into
+// the original buffer.
+void TokenizeLine(const char* begin,
+                  const char* end,
+                  std::vector<base::StringPiece>* tokens) {
+  tokens->clear();
+  const char* pos = begin;
+  while (pos < end) {
+    while (pos < end && (*pos == ' ' || *pos == '\t'))
+      ++pos;
+    const char* token_begin = pos;
+    while (pos < end && *pos != ' ' && *pos != '\t')
+      ++pos;
+    if (pos > token_begin)
+      tokens->push_back(base::StringPiece(token_begin, pos - token_begin));
+  }
+}
+
+}  // namespace
+
 void ParseHosts(const std::string& contents, DnsHosts* dns_hosts) {
   CHECK(dns_hosts);
   DnsHosts& hosts = *dns_hosts;
-  // Split into lines. Accept CR for Windows.
-  StringTokenizer contents_lines(contents, "\n\r");
-  while (contents_lines.GetNext()) {
+  // Walk |contents| in place; only the host names that end up in |hosts| are
+  // copied.
+  const char* pos = contents.data();
+  const char* const end = pos + contents.size();
+  std::vector<base::StringPiece> tokens;
+  while (pos < end) {
+    // Split into lines. Accept CR for Windows.
+    const char* line_end = pos;
+    while (line_end < end && *line_end != '\n' && *line_end != '\r')
+      ++line_end;
     // Ignore comments after '#'.
-    std::string line = contents_lines.token();
-    StringTokenizer line_parts(line, "#");
-    line_parts.set_options(StringTokenizer::RETURN_DELIMS);
-
-    if (line_parts.GetNext() && !line_parts.token_is_delim()) {
-      // Split and trim whitespace.
-      std::string part = line_parts.token();
-      StringTokenizer tokens(part, " \t");
-
-      if (tokens.GetNext()) {
-        IPAddressNumber ip;
-        // TODO(szym): handle %iface notation on mac
-        if (!ParseIPLiteralToNumber(tokens.token(), &ip))
-          continue;  // Ignore malformed lines.
-        AddressFamily fam = (ip.size() == 4) ? ADDRESS_FAMILY_IPV4 :
-                                               ADDRESS_FAMILY_IPV6;
-        while (tokens.GetNext()) {
-          DnsHostsKey key(tokens.token(), fam);
-          StringToLowerASCII(&(key.first));
-          IPAddressNumber& mapped_ip = hosts[key];
-          if (mapped_ip.empty())
-            mapped_ip = ip;
-          // else ignore this entry (first hit counts)
-        }
-      }
+    TokenizeLine(pos, std::find(pos, line_end, '#'), &tokens);
+    pos = line_end + 1;
+
+    if (tokens.size() < 2)
+      continue;
+
+    IPAddressNumber ip;
+    // TODO(szym): handle %iface notation on mac
+    if (!ParseIPLiteralToNumber(tokens[0].as_string(), &ip))
+      continue;  // Ignore malformed lines.
+    AddressFamily fam = (ip.size() == 4) ? ADDRESS_FAMILY_IPV4 :
+                                           ADDRESS_FAMILY_IPV6;
+    for (size_t i = 1; i < tokens.size(); ++i) {
+      DnsHostsKey key(tokens[i].as_string(), fam);
+      StringToLowerASCII(&(key.first));
+      // insert() leaves an existing entry alone (first hit counts).
+      hosts.insert(std::make_pair(key, ip));
     }
   }
 }
@@ -80,10 +105,13 @@ void DnsHostsReader::DoWork() {
   }
 
   std::string contents;
-  const int64 kMaxHostsSize = 1 << 16;
+  const int64 kMaxHostsSize = 1 << 25;  // 32MB
   if (ReadFile(path_, kMaxHostsSize, &contents)) {
     success_ = true;
+    base::TimeTicks start_time = base::TimeTicks::Now();
     ParseHosts(contents, &dns_hosts_);
+    UMA_HISTOGRAM_TIMES("AsyncDNS.HostsParseDuration",
+                        base::TimeTicks::Now() - start_time);
   }
 }
 
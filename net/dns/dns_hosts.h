@@ -6,13 +6,13 @@
 #define NET_DNS_DNS_HOSTS_H_
 #pragma once
 
-#include <map>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/callback.h"
 #include "base/file_path.h"
+#include "base/hash_tables.h"
 #include "net/base/address_family.h"
 #include "net/base/net_export.h"
 #include "net/base/net_util.h"  // can't forward-declare IPAddressNumber
@@ -31,7 +31,34 @@ namespace net {
 // 10.0.0.1 localhost
 // The expected resolution of localhost is 127.0.0.1.
 typedef std::pair<std::string, AddressFamily> DnsHostsKey;
-typedef std::map<DnsHostsKey, IPAddressNumber> DnsHosts;
+
+}  // namespace net
+
+namespace BASE_HASH_NAMESPACE {
+#if defined(COMPILER_GCC)
+
+template<>
+struct hash<net::DnsHostsKey> {
+  std::size_t operator()(const net::DnsHostsKey& key) const {
+    hash<std::string> string_hash;
+    return string_hash(key.first) + key.second;
+  }
+};
+
+#elif defined(COMPILER_MSVC)
+
+inline size_t hash_value(const net::DnsHostsKey& key) {
+  return hash_value(key.first) + key.second;
+}
+
+#endif  // COMPILER
+}  // namespace BASE_HASH_NAMESPACE
+
+namespace net {
+
+// Hash-indexed, as HOSTS files used for blocking can have 100k+ entries and
+// are consulted on every lookup.
+typedef base::hash_map<DnsHostsKey, IPAddressNumber> DnsHosts;
 
 // Parses |contents| (as read from /etc/hosts or equivalent) and stores results
 // in |dns_hosts|. Invalid lines are ignored (as in most implementations).
@@ -4,6 +4,7 @@
 
 #include "net/dns/dns_hosts.h"
 
+#include "base/stringprintf.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace net {
@@ -55,6 +56,26 @@ TEST(DnsHostsTest, ParseHosts) {
   ASSERT_EQ(expected, hosts);
 }
 
+TEST(DnsHostsTest, ParseHostsLarge) {
+  std::string contents;
+  const int kNumLines = 100000;
+  for (int i = 0; i < kNumLines; ++i) {
+    contents.append(base::StringPrintf(
+        "0.0.0.0 ads%d.example.com\tAds%d.Example.Net # blocked\n", i, i));
+  }
+
+  DnsHosts hosts;
+  ParseHosts(contents, &hosts);
+  EXPECT_EQ(2u * kNumLines, hosts.size());
+
+  IPAddressNumber expected_ip;
+  ASSERT_TRUE(ParseIPLiteralToNumber("0.0.0.0", &expected_ip));
+  DnsHosts::const_iterator it =
+      hosts.find(DnsHostsKey("ads99999.example.net", ADDRESS_FAMILY_IPV4));
+  ASSERT_TRUE(it != hosts.end());
+  EXPECT_EQ(expected_ip, it->second);
+}
+
 }  // namespace
 
 }  // namespace net
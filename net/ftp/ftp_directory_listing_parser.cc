@@ -21,14 +21,45 @@ namespace net {
 
 namespace {
 
+// Returns true if |name| consists only of printable ASCII characters.
+bool IsPrintableASCII(const string16& name) {
+  for (size_t i = 0; i < name.size(); i++) {
+    if (name[i] < 0x20 || name[i] > 0x7e)
+      return false;
+  }
+  return true;
+}
+
+// Returns true if |encoding| represents printable ASCII characters as
+// themselves, as UTF-8 and the ISO-8859 and Windows code pages do.
+bool IsPrintableASCIICompatible(const std::string& encoding) {
+  string16 printable;
+  for (char16 c = 0x20; c <= 0x7e; c++)
+    printable.push_back(c);
+  std::string encoded;
+  return base::UTF16ToCodepage(printable, encoding.c_str(),
+                               base::OnStringConversionError::FAIL,
+                               &encoded) &&
+         encoded == UTF16ToASCII(printable);
+}
+
 // Fills in |raw_name| for all |entries| using |encoding|. Returns network
 // error code.
 int FillInRawName(const std::string& encoding,
                   std::vector<FtpDirectoryListingEntry>* entries) {
+  // Most names are plain ASCII. When |encoding| agrees with ASCII they can be
+  // copied as they are, rather than going through a converter for each entry
+  // of what can be a very long listing.
+  bool ascii_compatible = IsPrintableASCIICompatible(encoding);
   for (size_t i = 0; i < entries->size(); i++) {
-    if (!base::UTF16ToCodepage(entries->at(i).name, encoding.c_str(),
+    FtpDirectoryListingEntry* entry = &entries->at(i);
+    if (ascii_compatible && IsPrintableASCII(entry->name)) {
+      entry->raw_name = UTF16ToASCII(entry->name);
+      continue;
+    }
+    if (!base::UTF16ToCodepage(entry->name, encoding.c_str(),
                                base::OnStringConversionError::FAIL,
-                               &entries->at(i).raw_name)) {
+                               &entry->raw_name)) {
       return ERR_ENCODING_CONVERSION_FAILED;
     }
   }
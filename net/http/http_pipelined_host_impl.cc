@@ -4,6 +4,8 @@
 
 #include "net/http/http_pipelined_host_impl.h"
 
+#include <algorithm>
+
 #include "base/stl_util.h"
 #include "base/values.h"
 #include "net/http/http_pipelined_connection_impl.h"
@@ -19,6 +21,10 @@ namespace net {
 // costing too much performance. Until then, this is just a bad guess.
 static const int kNumKnownSuccessesThreshold = 3;
 
+// Pipelines to PIPELINE_CAPABLE hosts grow one request deeper every
+// kNumKnownSuccessesThreshold successes, up to this depth.
+static const int kMaxLearnedPipelineDepth = 6;
+
 HttpPipelinedHostImpl::HttpPipelinedHostImpl(
     HttpPipelinedHost::Delegate* delegate,
     const HttpPipelinedHost::Key& key,
@@ -149,10 +155,20 @@ void HttpPipelinedHostImpl::OnPipelineFeedback(
   }
 }
 
-int HttpPipelinedHostImpl::GetPipelineCapacity() const {
+int HttpPipelinedHostImpl::GetPipelineCapacity(
+    HttpPipelinedConnection* pipeline) const {
   int capacity = 0;
   switch (capability_) {
-    case PIPELINE_CAPABLE:
+    case PIPELINE_CAPABLE: {
+      PipelineInfoMap::const_iterator it = pipelines_.find(pipeline);
+      CHECK(it != pipelines_.end());
+      capacity = std::min(kMaxLearnedPipelineDepth,
+                          max_pipeline_depth() +
+                              it->second.num_successes /
+                                  kNumKnownSuccessesThreshold);
+      break;
+    }
+
     case PIPELINE_PROBABLY_CAPABLE:
       capacity = max_pipeline_depth();
       break;
@@ -175,7 +191,7 @@ bool HttpPipelinedHostImpl::CanPipelineAcceptRequests(
   return capability_ != PIPELINE_INCAPABLE &&
       pipeline->usable() &&
       pipeline->active() &&
-      pipeline->depth() < GetPipelineCapacity();
+      pipeline->depth() < GetPipelineCapacity(pipeline);
 }
 
 void HttpPipelinedHostImpl::NotifyAllPipelinesHaveCapacity() {
@@ -198,7 +214,7 @@ Value* HttpPipelinedHostImpl::PipelineInfoToValue() const {
     pipeline_dict->SetString("host", key_.origin().ToString());
     pipeline_dict->SetBoolean("forced", false);
     pipeline_dict->SetInteger("depth", it->first->depth());
-    pipeline_dict->SetInteger("capacity", GetPipelineCapacity());
+    pipeline_dict->SetInteger("capacity", GetPipelineCapacity(it->first));
     pipeline_dict->SetBoolean("usable", it->first->usable());
     pipeline_dict->SetBoolean("active", it->first->active());
     pipeline_dict->SetInteger("source_id", it->first->net_log().source().id);
@@ -73,7 +73,8 @@ class NET_EXPORT_PRIVATE HttpPipelinedHostImpl
   virtual base::Value* PipelineInfoToValue() const OVERRIDE;
 
   // Returns the maximum number of in-flight pipelined requests we'll allow on a
-  // single connection.
+  // new connection. Connections to PIPELINE_CAPABLE hosts may grow deeper as
+  // they complete requests.
   static int max_pipeline_depth() { return 3; }
 
  private:
@@ -91,9 +92,10 @@ class NET_EXPORT_PRIVATE HttpPipelinedHostImpl
   // Adds the next pending request to the pipeline if it's still usuable.
   void AddRequestToPipeline(HttpPipelinedConnection* pipeline);
 
-  // Returns the current pipeline capacity based on |capability_|. This should
-  // not be called if |capability_| is INCAPABLE.
-  int GetPipelineCapacity() const;
+  // Returns the current capacity of |pipeline| based on |capability_| and the
+  // number of requests it has completed. This should not be called if
+  // |capability_| is INCAPABLE.
+  int GetPipelineCapacity(HttpPipelinedConnection* pipeline) const;
 
   // Returns true if |pipeline| can handle a new request. This is true if the
   // |pipeline| is active, usable, has capacity, and |capability_| is
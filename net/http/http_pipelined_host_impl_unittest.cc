@@ -267,6 +267,22 @@ TEST_F(HttpPipelinedHostImplTest, SuccessesLeadToCapable) {
   ClearTestPipeline(pipeline);
 }
 
+TEST_F(HttpPipelinedHostImplTest, CapablePipelineGrowsWithSuccesses) {
+  MockPipeline* pipeline = AddTestPipeline(
+      HttpPipelinedHostImpl::max_pipeline_depth(), true, true);
+  EXPECT_FALSE(host_->IsExistingPipelineAvailable());
+
+  for (int i = 0; i < 3; ++i)
+    host_->OnPipelineFeedback(pipeline, HttpPipelinedConnection::OK);
+  EXPECT_TRUE(host_->IsExistingPipelineAvailable());
+
+  pipeline->SetState(HttpPipelinedHostImpl::max_pipeline_depth() + 1,
+                     true, true);
+  EXPECT_FALSE(host_->IsExistingPipelineAvailable());
+
+  ClearTestPipeline(pipeline);
+}
+
 TEST_F(HttpPipelinedHostImplTest, IgnoresSocketErrorOnFirstRequest) {
   SetCapability(PIPELINE_UNKNOWN);
   MockPipeline* pipeline = AddTestPipeline(1, true, true);
@@ -97,6 +97,58 @@ bool ShouldUpdateHeader(const std::string::const_iterator& name_begin,
   return true;
 }
 
+// The names of the headers that are looked up for most responses, by
+// HttpCache::Transaction, HttpNetworkTransaction and the methods of this
+// class.  Headers with these names are linked together when parsed, so that
+// finding them doesn't take a scan of all the headers.
+struct IndexedHeader {
+  const char* name;
+  size_t length;
+};
+
+#define INDEXED_HEADER(name) { name, sizeof(name) - 1 }
+const IndexedHeader kIndexedHeaders[] = {
+  INDEXED_HEADER("accept-ranges"),
+  INDEXED_HEADER("age"),
+  INDEXED_HEADER("cache-control"),
+  INDEXED_HEADER("connection"),
+  INDEXED_HEADER("content-encoding"),
+  INDEXED_HEADER("content-length"),
+  INDEXED_HEADER("content-range"),
+  INDEXED_HEADER("content-type"),
+  INDEXED_HEADER("date"),
+  INDEXED_HEADER("etag"),
+  INDEXED_HEADER("expires"),
+  INDEXED_HEADER("keep-alive"),
+  INDEXED_HEADER("last-modified"),
+  INDEXED_HEADER("location"),
+  INDEXED_HEADER("pragma"),
+  INDEXED_HEADER("proxy-authenticate"),
+  INDEXED_HEADER("proxy-connection"),
+  INDEXED_HEADER("public-key-pins"),
+  INDEXED_HEADER("set-cookie"),
+  INDEXED_HEADER("strict-transport-security"),
+  INDEXED_HEADER("transfer-encoding"),
+  INDEXED_HEADER("vary"),
+  INDEXED_HEADER("www-authenticate"),
+};
+#undef INDEXED_HEADER
+
+const int kNotIndexed = -1;
+
+// Returns the position of the header name [name_begin, name_end) in
+// kIndexedHeaders (case-insensitive), or kNotIndexed.
+int GetIndexedHeaderId(std::string::const_iterator name_begin,
+                       std::string::const_iterator name_end) {
+  const size_t length = name_end - name_begin;
+  for (size_t i = 0; i < arraysize(kIndexedHeaders); ++i) {
+    if (kIndexedHeaders[i].length == length &&
+        LowerCaseEqualsASCII(name_begin, name_end, kIndexedHeaders[i].name))
+      return static_cast<int>(i);
+  }
+  return kNotIndexed;
+}
+
 // Functions for histogram initialization.  The code 0 is put in the
 // response map to track response codes that are invalid.
 // TODO(gavinp): Greatly prune the collected codes once we learn which
@@ -143,12 +195,18 @@ struct HttpResponseHeaders::ParsedHeader {
   std::string::const_iterator name_end;
   std::string::const_iterator value_begin;
   std::string::const_iterator value_end;
+
+  // If the name is indexed, the index in parsed_ of the next header with the
+  // same name, or std::string::npos.
+  size_t next_with_same_name;
 };
 
 //-----------------------------------------------------------------------------
 
 HttpResponseHeaders::HttpResponseHeaders(const std::string& raw_input)
     : response_code_(-1) {
+  COMPILE_ASSERT(arraysize(kIndexedHeaders) == kNumIndexedHeaders,
+                 indexed_headers_count_mismatch);
   Parse(raw_input);
 
   // The most important thing to do with this histogram is find out
@@ -172,6 +230,7 @@ HttpResponseHeaders::HttpResponseHeaders(const std::string& raw_input)
 HttpResponseHeaders::HttpResponseHeaders(const Pickle& pickle,
                                          PickleIterator* iter)
     : response_code_(-1) {
+  IndexHeaders();
   std::string raw_input;
   if (pickle.ReadString(iter, &raw_input))
     Parse(raw_input);
@@ -412,6 +471,7 @@ void HttpResponseHeaders::Parse(const std::string& raw_input) {
 
     DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 2]);
     DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 1]);
+    IndexHeaders();
     return;
   }
 
@@ -440,6 +500,7 @@ void HttpResponseHeaders::Parse(const std::string& raw_input) {
               headers.values_begin(),
               headers.values_end());
   }
+  IndexHeaders();
 
   DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 2]);
   DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 1]);
@@ -611,6 +672,7 @@ bool HttpResponseHeaders::HasHeader(const std::string& name) const {
 }
 
 HttpResponseHeaders::HttpResponseHeaders() : response_code_(-1) {
+  IndexHeaders();
 }
 
 HttpResponseHeaders::~HttpResponseHeaders() {
@@ -735,6 +797,16 @@ void HttpResponseHeaders::ParseStatusLine(
 
 size_t HttpResponseHeaders::FindHeader(size_t from,
                                        const std::string& search) const {
+  int id = GetIndexedHeaderId(search.begin(), search.end());
+  if (id != kNotIndexed) {
+    for (size_t i = first_indexed_header_[id]; i != std::string::npos;
+         i = parsed_[i].next_with_same_name) {
+      if (i >= from)
+        return i;
+    }
+    return std::string::npos;
+  }
+
   for (size_t i = from; i < parsed_.size(); ++i) {
     if (parsed_[i].is_continuation())
       continue;
@@ -749,12 +821,36 @@ size_t HttpResponseHeaders::FindHeader(size_t from,
   return std::string::npos;
 }
 
+void HttpResponseHeaders::IndexHeaders() {
+  size_t last_indexed_header[kNumIndexedHeaders];
+  for (size_t id = 0; id < kNumIndexedHeaders; ++id) {
+    first_indexed_header_[id] = std::string::npos;
+    last_indexed_header[id] = std::string::npos;
+  }
+
+  for (size_t i = 0; i < parsed_.size(); ++i) {
+    parsed_[i].next_with_same_name = std::string::npos;
+    if (parsed_[i].is_continuation())
+      continue;
+    int id = GetIndexedHeaderId(parsed_[i].name_begin, parsed_[i].name_end);
+    if (id == kNotIndexed)
+      continue;
+    if (last_indexed_header[id] == std::string::npos)
+      first_indexed_header_[id] = i;
+    else
+      parsed_[last_indexed_header[id]].next_with_same_name = i;
+    last_indexed_header[id] = i;
+  }
+}
+
 void HttpResponseHeaders::AddHeader(std::string::const_iterator name_begin,
                                     std::string::const_iterator name_end,
                                     std::string::const_iterator values_begin,
                                     std::string::const_iterator values_end) {
-  // If the header can be coalesced, then we should split it up.
+  // If the header can be coalesced, then we should split it up.  Most values
+  // have no comma, and are kept whole either way.
   if (values_begin == values_end ||
+      std::find(values_begin, values_end, ',') == values_end ||
       HttpUtil::IsNonCoalescingHeader(name_begin, name_end)) {
     AddToParsed(name_begin, name_end, values_begin, values_end);
   } else {
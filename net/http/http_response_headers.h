@@ -289,6 +289,10 @@ class NET_EXPORT HttpResponseHeaders
   // index |from|.  Returns string::npos if not found.
   size_t FindHeader(size_t from, const std::string& name) const;
 
+  // Links the headers of parsed_ that have one of the indexed names (see
+  // kIndexedHeaders in the .cc file), so FindHeader() can go straight to them.
+  void IndexHeaders();
+
   // Add a header->value pair to our list.  If we already have header in our
   // list, append the value to it.
   void AddHeader(std::string::const_iterator name_begin,
@@ -344,6 +348,13 @@ class NET_EXPORT HttpResponseHeaders
   // header-value pairs within raw_headers_.
   HeaderList parsed_;
 
+  // The number of names in kIndexedHeaders.
+  static const size_t kNumIndexedHeaders = 23;
+
+  // For each indexed header name, the index in parsed_ of the first header
+  // with that name, or std::string::npos.
+  size_t first_indexed_header_[kNumIndexedHeaders];
+
   // The raw_headers_ consists of the normalized status line (terminated with a
   // null byte) and then followed by the raw null-terminated headers from the
   // input that was passed to our constructor.  We preserve the input [*] to
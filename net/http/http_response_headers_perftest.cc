@@ -0,0 +1,161 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/perftimer.h"
+#include "base/time.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kIterations = 20000;
+
+// Response headers as sent by a few popular sites, with the cookies and
+// identifiers shortened.
+const char* const kCapturedHeaders[] = {
+  "HTTP/1.1 200 OK\r\n"
+  "Date: Tue, 15 May 2012 18:20:31 GMT\r\n"
+  "Expires: -1\r\n"
+  "Cache-Control: private, max-age=0\r\n"
+  "Content-Type: text/html; charset=UTF-8\r\n"
+  "Set-Cookie: PREF=ID=0123456789abcdef:FF=0:TM=1337106031:LM=1337106031:"
+  "S=abcdefghijklmnop; expires=Thu, 15-May-2014 18:20:31 GMT; path=/; "
+  "domain=.example.com\r\n"
+  "Set-Cookie: NID=59=abcdefghijklmnopqrstuvwxyz0123456789; "
+  "expires=Wed, 14-Nov-2012 18:20:31 GMT; path=/; domain=.example.com; "
+  "HttpOnly\r\n"
+  "P3P: CP=\"This is not a P3P policy!\"\r\n"
+  "Content-Encoding: gzip\r\n"
+  "Server: gws\r\n"
+  "Content-Length: 18431\r\n"
+  "X-XSS-Protection: 1; mode=block\r\n"
+  "X-Frame-Options: SAMEORIGIN\r\n"
+  "\r\n",
+
+  "HTTP/1.1 200 OK\r\n"
+  "Server: Apache\r\n"
+  "X-Content-Type-Options: nosniff\r\n"
+  "Cache-Control: s-maxage=3, must-revalidate, max-age=0\r\n"
+  "Last-Modified: Tue, 15 May 2012 18:08:02 GMT\r\n"
+  "Content-Encoding: gzip\r\n"
+  "Content-Length: 15384\r\n"
+  "Content-Type: text/html; charset=UTF-8\r\n"
+  "Accept-Ranges: bytes\r\n"
+  "Date: Tue, 15 May 2012 18:20:32 GMT\r\n"
+  "Age: 12\r\n"
+  "Connection: keep-alive\r\n"
+  "Vary: Accept-Encoding,Cookie\r\n"
+  "X-Cache: HIT from cp1001.example.net, MISS from cp1002.example.net\r\n"
+  "X-Cache-Lookup: HIT from cp1001.example.net:3128\r\n"
+  "Via: 1.1 cp1001.example.net:3128 (squid/2.7.STABLE9), "
+  "1.0 cp1002.example.net (squid/2.7.STABLE9)\r\n"
+  "\r\n",
+
+  "HTTP/1.1 200 OK\r\n"
+  "Server: nginx\r\n"
+  "Date: Tue, 15 May 2012 18:20:33 GMT\r\n"
+  "Content-Type: image/png\r\n"
+  "Content-Length: 4021\r\n"
+  "Connection: keep-alive\r\n"
+  "Last-Modified: Mon, 07 May 2012 21:13:05 GMT\r\n"
+  "ETag: \"4fa83b51-fb5\"\r\n"
+  "Expires: Thu, 15 May 2014 18:20:33 GMT\r\n"
+  "Cache-Control: max-age=63072000\r\n"
+  "Cache-Control: public\r\n"
+  "Accept-Ranges: bytes\r\n"
+  "\r\n",
+
+  "HTTP/1.1 301 Moved Permanently\r\n"
+  "Location: http://www.example.com/\r\n"
+  "Content-Type: text/html; charset=UTF-8\r\n"
+  "Date: Tue, 15 May 2012 18:20:34 GMT\r\n"
+  "Expires: Thu, 14 Jun 2012 18:20:34 GMT\r\n"
+  "Cache-Control: public, max-age=2592000\r\n"
+  "Server: gws\r\n"
+  "Content-Length: 219\r\n"
+  "X-XSS-Protection: 1; mode=block\r\n"
+  "X-Frame-Options: SAMEORIGIN\r\n"
+  "\r\n",
+};
+
+// Queries the headers the way HttpCache::Transaction and
+// HttpNetworkTransaction do for every response.
+bool QueryHeaders(const HttpResponseHeaders& headers) {
+  base::Time now = base::Time::Now();
+  bool result = headers.RequiresValidation(now, now, now);
+  result ^= headers.HasHeaderValue("cache-control", "no-store");
+  result ^= headers.HasHeaderValue("pragma", "no-cache");
+  result ^= headers.HasHeaderValue("vary", "*");
+  result ^= headers.HasStrongValidators();
+  result ^= headers.IsKeepAlive();
+  result ^= headers.GetContentLength() > 0;
+  result ^= headers.IsChunkEncoded();
+  result ^= headers.HasHeader("content-range");
+  result ^= headers.IsRedirect(NULL);
+  std::string value;
+  result ^= headers.GetMimeType(&value);
+  result ^= headers.GetCharset(&value);
+  result ^= headers.HasHeader("strict-transport-security");
+  result ^= headers.HasHeader("public-key-pins");
+  result ^= headers.HasHeader("www-authenticate");
+  void* iter = NULL;
+  while (headers.EnumerateHeader(&iter, "set-cookie", &value))
+    result = !result;
+  return result;
+}
+
+class HttpResponseHeadersPerfTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    for (size_t i = 0; i < arraysize(kCapturedHeaders); ++i) {
+      std::string raw(kCapturedHeaders[i]);
+      raw_headers_.push_back(
+          HttpUtil::AssembleRawHeaders(raw.data(), raw.size()));
+    }
+  }
+
+  std::vector<std::string> raw_headers_;
+};
+
+}  // namespace
+
+TEST_F(HttpResponseHeadersPerfTest, Parse) {
+  PerfTimeLogger timer("Http_response_headers_parse");
+  for (int i = 0; i < kIterations; ++i) {
+    for (size_t j = 0; j < raw_headers_.size(); ++j) {
+      scoped_refptr<HttpResponseHeaders> headers(
+          new HttpResponseHeaders(raw_headers_[j]));
+      ASSERT_LT(0, headers->response_code());
+    }
+  }
+  timer.Done();
+}
+
+TEST_F(HttpResponseHeadersPerfTest, Query) {
+  std::vector<scoped_refptr<HttpResponseHeaders> > headers;
+  for (size_t i = 0; i < raw_headers_.size(); ++i)
+    headers.push_back(new HttpResponseHeaders(raw_headers_[i]));
+
+  int count = 0;
+  PerfTimeLogger timer("Http_response_headers_query");
+  for (int i = 0; i < kIterations; ++i) {
+    for (size_t j = 0; j < headers.size(); ++j) {
+      if (QueryHeaders(*headers[j]))
+        ++count;
+    }
+  }
+  timer.Done();
+  // Keeps the compiler from dropping the queries.
+  EXPECT_LE(0, count);
+}
+
+}  // namespace net
@@ -507,6 +507,43 @@ TEST(HttpResponseHeadersTest, EnumerateHeader_Coalesced) {
   EXPECT_FALSE(parsed->EnumerateHeader(&iter, "cache-control", &value));
 }
 
+// Headers with common names are looked up through an index; make sure it sees
+// every occurrence, in order, whatever the case of the names.
+TEST(HttpResponseHeadersTest, EnumerateHeader_Interleaved) {
+  std::string headers =
+      "HTTP/1.1 200 OK\n"
+      "Set-Cookie: a=1\n"
+      "X-Foo: bar\n"
+      "SET-COOKIE: b=2\n"
+      "Vary: accept-encoding, cookie\n"
+      "set-cookie: c=3\n";
+  HeadersToRaw(&headers);
+  scoped_refptr<net::HttpResponseHeaders> parsed(
+      new net::HttpResponseHeaders(headers));
+
+  void* iter = NULL;
+  std::string value;
+  EXPECT_TRUE(parsed->EnumerateHeader(&iter, "Set-Cookie", &value));
+  EXPECT_EQ("a=1", value);
+  EXPECT_TRUE(parsed->EnumerateHeader(&iter, "Set-Cookie", &value));
+  EXPECT_EQ("b=2", value);
+  EXPECT_TRUE(parsed->EnumerateHeader(&iter, "Set-Cookie", &value));
+  EXPECT_EQ("c=3", value);
+  EXPECT_FALSE(parsed->EnumerateHeader(&iter, "Set-Cookie", &value));
+
+  EXPECT_TRUE(parsed->HasHeaderValue("vary", "cookie"));
+  EXPECT_TRUE(parsed->HasHeader("x-foo"));
+  EXPECT_FALSE(parsed->HasHeader("etag"));
+
+  // The index is rebuilt when the headers change.
+  parsed->RemoveHeader("x-foo");
+  parsed->AddHeader("ETag: \"1\"");
+  EXPECT_TRUE(parsed->HasHeader("etag"));
+  iter = NULL;
+  EXPECT_TRUE(parsed->EnumerateHeader(&iter, "set-cookie", &value));
+  EXPECT_EQ("a=1", value);
+}
+
 TEST(HttpResponseHeadersTest, EnumerateHeader_Challenge) {
   // Even though WWW-Authenticate has commas, it should not be treated as
   // coalesced values.
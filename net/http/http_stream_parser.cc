@@ -247,7 +247,7 @@ int HttpStreamParser::SendRequest(const std::string& request_line,
 
     size_t todo = request_body_->size();
     while (todo) {
-      int consumed = request_body_->Read(request_headers_, todo);
+      int consumed = request_body_->ReadSync(request_headers_, todo);
       DCHECK_GT(consumed, 0);  // Read() won't fail if not chunked.
       request_headers_->DidConsume(consumed);
       todo -= consumed;
@@ -374,6 +374,9 @@ int HttpStreamParser::DoLoop(int result) {
         else
           result = DoSendNonChunkedBody(result);
         break;
+      case STATE_SEND_REQUEST_READ_BODY_COMPLETE:
+        result = DoSendRequestReadBodyComplete(result);
+        break;
       case STATE_REQUEST_SENT:
         DCHECK(result != ERR_IO_PENDING);
         can_do_more = false;
@@ -455,7 +458,8 @@ int HttpStreamParser::DoSendChunkedBody(int result) {
     return OK;
   }
 
-  const int consumed = request_body_->Read(chunk_buf_, chunk_buf_->size());
+  const int consumed = request_body_->ReadSync(chunk_buf_,
+                                               chunk_buf_->size());
   if (consumed == 0) {  // Reached the end.
     DCHECK(request_body_->IsEOF());
     request_body_buf_->Clear();
@@ -498,12 +502,19 @@ int HttpStreamParser::DoSendNonChunkedBody(int result) {
   }
 
   request_body_buf_->Clear();
-  const int consumed = request_body_->Read(request_body_buf_,
-                                           request_body_buf_->capacity());
-  if (consumed == 0) {  // Reached the end.
+  io_state_ = STATE_SEND_REQUEST_READ_BODY_COMPLETE;
+  // File data is read on the worker pool, and comes back in OnIOComplete().
+  return request_body_->Read(request_body_buf_, request_body_buf_->capacity(),
+                             io_callback_);
+}
+
+int HttpStreamParser::DoSendRequestReadBodyComplete(int result) {
+  // |result| is the number of bytes read from the request body.
+  if (result == 0) {  // Reached the end.
     io_state_ = STATE_REQUEST_SENT;
-  } else if (consumed > 0) {
-    request_body_buf_->DidAppend(consumed);
+  } else if (result > 0) {
+    request_body_buf_->DidAppend(result);
+    io_state_ = STATE_SENDING_NON_CHUNKED_BODY;
     result = connection_->socket()->Write(request_body_buf_,
                                           request_body_buf_->BytesRemaining(),
                                           io_callback_);
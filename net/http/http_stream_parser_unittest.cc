@@ -9,9 +9,19 @@
 #include "base/scoped_temp_dir.h"
 #include "base/string_piece.h"
 #include "base/stringprintf.h"
+#include "googleurl/src/gurl.h"
+#include "net/base/address_list.h"
+#include "net/base/io_buffer.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/test_completion_callback.h"
 #include "net/base/upload_data.h"
 #include "net/base/upload_data_stream.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_request_info.h"
+#include "net/http/http_response_info.h"
+#include "net/socket/client_socket_handle.h"
+#include "net/socket/socket_test_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace net {
@@ -150,4 +160,53 @@ TEST(HttpStreamParser, ShouldMergeRequestHeadersAndBody_LargeBodyInMemory) {
       "some header", body.get()));
 }
 
+// The body of a file upload is read off the IO thread, and sent after the
+// headers.
+TEST(HttpStreamParser, SendFileBody) {
+  ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  FilePath temp_file_path;
+  ASSERT_TRUE(file_util::CreateTemporaryFileInDir(temp_dir.path(),
+                                                  &temp_file_path));
+  const char kBody[] = "0123456789";
+  ASSERT_EQ(static_cast<int>(strlen(kBody)),
+            file_util::WriteFile(temp_file_path, kBody, strlen(kBody)));
+
+  scoped_refptr<UploadData> upload_data = new UploadData;
+  upload_data->AppendFileRange(temp_file_path, 0, kuint64max, base::Time());
+  scoped_ptr<UploadDataStream> body(new UploadDataStream(upload_data));
+  ASSERT_EQ(OK, body->Init());
+
+  MockWrite writes[] = {
+    MockWrite(SYNCHRONOUS,
+              "POST / HTTP/1.1\r\n"
+              "Content-Length: 10\r\n\r\n"),
+    MockWrite(ASYNC, kBody),
+  };
+  StaticSocketDataProvider data(NULL, 0, writes, arraysize(writes));
+  data.set_connect_data(MockConnect(SYNCHRONOUS, OK));
+
+  scoped_ptr<MockTCPClientSocket> transport(
+      new MockTCPClientSocket(AddressList(), NULL, &data));
+  TestCompletionCallback callback;
+  ASSERT_EQ(OK, transport->Connect(callback.callback()));
+  ClientSocketHandle handle;
+  handle.set_socket(transport.release());
+
+  HttpRequestInfo request;
+  request.method = "POST";
+  request.url = GURL("http://localhost");
+  HttpRequestHeaders headers;
+  headers.SetHeader("Content-Length", "10");
+  HttpResponseInfo response;
+  scoped_refptr<GrowableIOBuffer> read_buffer(new GrowableIOBuffer);
+  HttpStreamParser parser(&handle, &request, read_buffer, BoundNetLog());
+
+  int rv = parser.SendRequest("POST / HTTP/1.1\r\n", headers, body.release(),
+                              &response, callback.callback());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_TRUE(data.at_write_eof());
+}
+
 }  // namespace net
@@ -75,6 +75,39 @@ static PacPerfTest kPerfTests[] = {
       {NULL, NULL}
     },
   },
+
+  // This test uses a PAC script like those found on corporate networks:
+  // domain lists, shell expression matching, and DNS resolves which are
+  // checked against the intranet subnets. Most pages load many resources
+  // from the same few hosts, which the queries mimic. The script only looks
+  // at the host, so ProxyResolverV8 caches its results.
+  { "corporate.pac",
+    { // queries:
+      {"http://wiki.corp.example.com/", "DIRECT"},
+      {"http://wiki.corp.example.com/static/style.css", "DIRECT"},
+      {"http://wiki.corp.example.com/static/logo.png", "DIRECT"},
+      {"https://mail.example.com/inbox", "PROXY proxy.corp.example.com:8080;"
+                                         "DIRECT"},
+      {"http://www.partner-one.com/orders?id=1", "PROXY "
+                                           "partner-gw.corp.example.com:3128"},
+      {"http://www.partner-one.com/orders?id=2", "PROXY "
+                                           "partner-gw.corp.example.com:3128"},
+      {"http://intranet", "DIRECT"},
+      {"http://10.1.2.3/status", "DIRECT"},
+      {"http://www.example.com/", "PROXY proxy.corp.example.com:8080;DIRECT"},
+      {"http://www.example.com/script.js", "PROXY proxy.corp.example.com:8080;"
+                                           "DIRECT"},
+      {"http://www.example.com/image.jpg", "PROXY proxy.corp.example.com:8080;"
+                                           "DIRECT"},
+      {"http://cdn.example.net/lib.js", "PROXY proxy.corp.example.com:8080;"
+                                        "DIRECT"},
+      {"http://portal-eu.vendor.example.com/", "PROXY "
+                                           "partner-gw.corp.example.com:3128"},
+      {"http://build.eng.example.com/results", "DIRECT"},
+      {"http://8.8.8.8/", "PROXY proxy.corp.example.com:8080;DIRECT"},
+      {NULL, NULL}
+    },
+  },
 };
 
 int PacPerfTest::NumQueries() const {
@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <set>
+#include <vector>
 
 #include "net/proxy/proxy_resolver_v8.h"
 
@@ -329,6 +331,332 @@ bool IsInNetEx(const std::string& ip_address, const std::string& ip_prefix) {
   return IPNumberMatchesPrefix(address, prefix, prefix_length_in_bits);
 }
 
+// A javascript token, as split up by TokenizeScript().
+struct ScriptToken {
+  enum Type {
+    IDENTIFIER,  // Includes keywords.
+    PUNCTUATOR,
+    LITERAL,     // A string, number or regular expression.
+  };
+
+  ScriptToken(Type type, const string16& text, int depth)
+      : type(type), text(text), depth(depth) {}
+
+  bool Is(Type t, const char* s) const {
+    return type == t && text == ASCIIToUTF16(s);
+  }
+
+  Type type;
+  string16 text;
+  // The number of enclosing function bodies.
+  int depth;
+};
+
+typedef std::vector<ScriptToken> ScriptTokens;
+
+// Returns true if |c| can be part of a javascript identifier.
+bool IsIdentifierChar(char16 c) {
+  return IsAsciiAlpha(c) || IsAsciiDigit(c) || c == '_' || c == '$' || c > 127;
+}
+
+// Returns true if a '/' following |previous| starts a regular expression
+// rather than being a division.
+bool SlashStartsRegExp(const ScriptTokens& tokens) {
+  if (tokens.empty())
+    return true;
+  const ScriptToken& previous = tokens.back();
+  if (previous.type == ScriptToken::LITERAL)
+    return false;
+  if (previous.type == ScriptToken::PUNCTUATOR)
+    return !previous.Is(ScriptToken::PUNCTUATOR, ")") &&
+           !previous.Is(ScriptToken::PUNCTUATOR, "]");
+  static const char* const kKeywordsBeforeExpression[] = {
+    "case", "delete", "do", "else", "in", "instanceof", "new", "return",
+    "throw", "typeof", "void",
+  };
+  for (size_t i = 0; i < arraysize(kKeywordsBeforeExpression); ++i) {
+    if (previous.Is(ScriptToken::IDENTIFIER, kKeywordsBeforeExpression[i]))
+      return true;
+  }
+  return false;
+}
+
+// Splits |script| into tokens, dropping whitespace and comments. This is only
+// as precise as needed by IsHostOnlyPacScript(); anything it gets wrong can
+// only make a script look less cacheable.
+ScriptTokens TokenizeScript(const string16& script) {
+  // Longest first, so that the first match is the longest one.
+  static const char* const kPunctuators[] = {
+    ">>>=", "===", "!==", "<<=", ">>=", ">>>", "==", "!=", "<=", ">=", "&&",
+    "||", "++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<",
+    ">>",
+  };
+
+  ScriptTokens tokens;
+  // Whether each enclosing brace began a function body.
+  std::vector<bool> braces;
+  bool in_function_header = false;
+  int depth = 0;
+  size_t i = 0;
+  while (i < script.size()) {
+    char16 c = script[i];
+    size_t begin = i;
+    if (IsWhitespace(c)) {
+      ++i;
+    } else if (c == '/' && i + 1 < script.size() && script[i + 1] == '/') {
+      while (i < script.size() && script[i] != '\n')
+        ++i;
+    } else if (c == '/' && i + 1 < script.size() && script[i + 1] == '*') {
+      i = script.find(ASCIIToUTF16("*/"), i + 2);
+      i = i == string16::npos ? script.size() : i + 2;
+    } else if (c == '"' || c == '\'' ||
+               (c == '/' && SlashStartsRegExp(tokens))) {
+      // Strings and regular expressions; the latter may contain an unescaped
+      // '/' inside of a character class.
+      bool in_class = false;
+      for (++i; i < script.size(); ++i) {
+        if (script[i] == '\\') {
+          ++i;
+        } else if (c == '/' && script[i] == '[') {
+          in_class = true;
+        } else if (c == '/' && script[i] == ']') {
+          in_class = false;
+        } else if (script[i] == c && !in_class) {
+          break;
+        }
+      }
+      // Skip the closing quote, and the flags of a regular expression.
+      for (++i; c == '/' && i < script.size() && IsIdentifierChar(script[i]);
+           ++i) {}
+      i = std::min(i, script.size());
+      tokens.push_back(ScriptToken(ScriptToken::LITERAL,
+                                   script.substr(begin, i - begin), depth));
+    } else if (IsAsciiDigit(c)) {
+      while (i < script.size() &&
+             (IsIdentifierChar(script[i]) || script[i] == '.')) {
+        ++i;
+      }
+      tokens.push_back(ScriptToken(ScriptToken::LITERAL,
+                                   script.substr(begin, i - begin), depth));
+    } else if (IsIdentifierChar(c)) {
+      while (i < script.size() && IsIdentifierChar(script[i]))
+        ++i;
+      tokens.push_back(ScriptToken(ScriptToken::IDENTIFIER,
+                                   script.substr(begin, i - begin), depth));
+      if (tokens.back().Is(ScriptToken::IDENTIFIER, "function"))
+        in_function_header = true;
+    } else {
+      size_t length = 1;
+      for (size_t j = 0; j < arraysize(kPunctuators); ++j) {
+        string16 punctuator = ASCIIToUTF16(kPunctuators[j]);
+        if (script.compare(i, punctuator.size(), punctuator) == 0) {
+          length = punctuator.size();
+          break;
+        }
+      }
+      if (c == '}' && !braces.empty()) {
+        if (braces.back())
+          --depth;
+        braces.pop_back();
+      }
+      tokens.push_back(ScriptToken(ScriptToken::PUNCTUATOR,
+                                   script.substr(i, length), depth));
+      if (c == '{') {
+        // The parameter list can't contain braces, so the first one after
+        // "function" opens its body.
+        braces.push_back(in_function_header);
+        if (in_function_header)
+          ++depth;
+        in_function_header = false;
+      }
+      i += length;
+    }
+  }
+  return tokens;
+}
+
+// Adds the identifier following each of the comma separated declarations
+// which start at |tokens[begin]|, as in "var a = 1, b = [2, 3];", to
+// |names|.
+void AddDeclaredNames(const ScriptTokens& tokens, size_t begin,
+                      std::set<string16>* names) {
+  int nesting = 0;
+  bool expect_name = true;
+  for (size_t i = begin; i < tokens.size(); ++i) {
+    const ScriptToken& token = tokens[i];
+    if (expect_name && token.type == ScriptToken::IDENTIFIER)
+      names->insert(token.text);
+    expect_name = false;
+    if (token.type != ScriptToken::PUNCTUATOR)
+      continue;
+    if (token.text[0] == '(' || token.text[0] == '[' || token.text[0] == '{') {
+      ++nesting;
+    } else if (token.text[0] == ')' || token.text[0] == ']' ||
+               token.text[0] == '}') {
+      if (--nesting < 0)
+        return;
+    } else if (nesting == 0 && token.text[0] == ';') {
+      return;
+    } else if (nesting == 0 && token.text[0] == ',') {
+      expect_name = true;
+    }
+  }
+}
+
+// Returns true if no function in |tokens| can change state which outlives the
+// call, such as a global counter: every variable they assign to must be
+// declared locally with "var" or as a parameter, and properties must not be
+// assigned at all. Names which are also declared at the top level never count
+// as locals, since the assignment may be to the global one.
+bool HasNoPersistentState(const ScriptTokens& tokens) {
+  std::set<string16> locals;
+  std::set<string16> globals;
+  for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+    const ScriptToken& token = tokens[i];
+    if (token.Is(ScriptToken::IDENTIFIER, "var")) {
+      AddDeclaredNames(tokens, i + 1, token.depth == 0 ? &globals : &locals);
+    } else if (token.Is(ScriptToken::IDENTIFIER, "function") ||
+               token.Is(ScriptToken::IDENTIFIER, "catch")) {
+      size_t params = i + 1;
+      if (tokens[params].type == ScriptToken::IDENTIFIER) {
+        if (token.depth == 0)
+          globals.insert(tokens[params].text);
+        ++params;
+      }
+      if (params < tokens.size() &&
+          tokens[params].Is(ScriptToken::PUNCTUATOR, "(")) {
+        for (size_t j = params + 1; j < tokens.size() &&
+             !tokens[j].Is(ScriptToken::PUNCTUATOR, ")"); ++j) {
+          if (tokens[j].type == ScriptToken::IDENTIFIER)
+            locals.insert(tokens[j].text);
+        }
+      }
+    }
+  }
+  for (std::set<string16>::const_iterator it = globals.begin();
+       it != globals.end(); ++it) {
+    locals.erase(*it);
+  }
+
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const ScriptToken& token = tokens[i];
+    if (token.depth == 0 || token.type != ScriptToken::PUNCTUATOR)
+      continue;
+    const string16& op = token.text;
+    bool is_update = op == ASCIIToUTF16("++") || op == ASCIIToUTF16("--");
+    bool is_assignment = op[op.size() - 1] == '=' &&
+        op != ASCIIToUTF16("==") && op != ASCIIToUTF16("===") &&
+        op != ASCIIToUTF16("!=") && op != ASCIIToUTF16("!==") &&
+        op != ASCIIToUTF16("<=") && op != ASCIIToUTF16(">=");
+    if (!is_update && !is_assignment)
+      continue;
+
+    // Find the variable being written to, which precedes assignments, and
+    // either precedes or follows increments and decrements.
+    size_t target = i - 1;
+    if (i == 0 || (is_update && tokens[i - 1].type != ScriptToken::IDENTIFIER &&
+                   !tokens[i - 1].Is(ScriptToken::PUNCTUATOR, "]") &&
+                   !tokens[i - 1].Is(ScriptToken::PUNCTUATOR, ")"))) {
+      target = i + 1;
+    }
+    if (target >= tokens.size() ||
+        tokens[target].type != ScriptToken::IDENTIFIER ||
+        locals.find(tokens[target].text) == locals.end()) {
+      return false;
+    }
+    // A property of a local may still be shared, as in "var a = g; a.x = 1;".
+    if (target > 0 && tokens[target - 1].Is(ScriptToken::PUNCTUATOR, "."))
+      return false;
+    if (target + 1 < tokens.size() && target + 1 != i &&
+        (tokens[target + 1].Is(ScriptToken::PUNCTUATOR, ".") ||
+         tokens[target + 1].Is(ScriptToken::PUNCTUATOR, "["))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Identifiers which make the result of a PAC script depend on something other
+// than the host: the date and time, randomness, the argument list (through
+// which the URL can be reached without naming it), or code generated at run
+// time. "this" and "constructor" lead to the same globals without naming
+// them. The rest change objects in place, which HasNoPersistentState() can't
+// see. alert() is included as the alerts must be reported on every call.
+const char* const kUncacheableIdentifiers[] = {
+  "alert",
+  "arguments",
+  "caller",
+  "constructor",
+  "Date",
+  "dateRange",
+  "delete",
+  "eval",
+  "Function",
+  "Math",
+  "Object",
+  "pop",
+  "push",
+  "reverse",
+  "setInterval",
+  "setTimeout",
+  "shift",
+  "sort",
+  "splice",
+  "this",
+  "timeRange",
+  "unshift",
+  "weekdayRange",
+};
+
+// Returns true if the entry point of a PAC script only depends on the host
+// it is called with, so that its results can be cached per host. |script| is
+// the text of the PAC script, and |find_proxy_source| the source of its
+// FindProxyForURL() function, as given by toString().
+//
+// This is a conservative lexical check: a script which never looks at the URL
+// but still fails it only loses the cache.
+bool IsHostOnlyPacScript(const string16& script,
+                         const string16& find_proxy_source) {
+  ScriptTokens tokens = TokenizeScript(script);
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    for (size_t j = 0; j < arraysize(kUncacheableIdentifiers); ++j) {
+      if (tokens[i].Is(ScriptToken::IDENTIFIER, kUncacheableIdentifiers[j]))
+        return false;
+    }
+  }
+  if (!HasNoPersistentState(tokens))
+    return false;
+
+  // The URL is the first parameter. Without parameters it can only be reached
+  // through |arguments|, which was ruled out above.
+  ScriptTokens function = TokenizeScript(find_proxy_source);
+  size_t i = 0;
+  while (i < function.size() &&
+         !function[i].Is(ScriptToken::PUNCTUATOR, "(")) {
+    ++i;
+  }
+  if (i + 1 >= function.size())
+    return false;
+  const ScriptToken& url_param = function[i + 1];
+  if (url_param.type != ScriptToken::IDENTIFIER)
+    return url_param.Is(ScriptToken::PUNCTUATOR, ")");
+
+  // The body can only pass the URL on to other functions by naming it.
+  bool in_body = false;
+  for (++i; i < function.size(); ++i) {
+    if (function[i].Is(ScriptToken::PUNCTUATOR, "{"))
+      in_body = true;
+    // A function implemented in C++ reads "function f() { [native code] }".
+    if (function[i].Is(ScriptToken::IDENTIFIER, "native"))
+      return false;
+    if (in_body && function[i].type == ScriptToken::IDENTIFIER &&
+        function[i].text == url_param.text) {
+      return false;
+    }
+  }
+  return in_body;
+}
+
 }  // namespace
 
 // ProxyResolverV8::Context ---------------------------------------------------
@@ -337,6 +665,7 @@ class ProxyResolverV8::Context {
  public:
   explicit Context(ProxyResolverJSBindings* js_bindings)
       : is_resolving_host_(false),
+        is_host_only_(false),
         js_bindings_(js_bindings) {
     DCHECK(js_bindings != NULL);
   }
@@ -480,9 +809,14 @@ class ProxyResolverV8::Context {
       return ERR_PAC_SCRIPT_FAILED;
     }
 
+    is_host_only_ = IsHostOnlyPacScript(
+        pac_script->utf16(), V8StringToUTF16(function->ToString()));
     return OK;
   }
 
+  // Returns true if FindProxyForURL() only depends on the host of the URL.
+  bool is_host_only() const { return is_host_only_; }
+
   void SetCurrentRequestContext(ProxyResolverRequestContext* context) {
     js_bindings_->set_current_request_context(context);
   }
@@ -713,6 +1047,7 @@ class ProxyResolverV8::Context {
 
   mutable base::Lock lock_;
   bool is_resolving_host_;
+  bool is_host_only_;
   ProxyResolverJSBindings* js_bindings_;
   v8::Persistent<v8::External> v8_this_;
   v8::Persistent<v8::Context> v8_context_;
@@ -720,14 +1055,30 @@ class ProxyResolverV8::Context {
 
 // ProxyResolverV8 ------------------------------------------------------------
 
+namespace {
+
+// The number of hosts whose results are cached.
+const size_t kMaxCachedResults = 256;
+
+// How long a cached result is used for. The result may depend on DNS, so this
+// matches how long HostResolverImpl caches successful resolutions.
+const int kCachedResultTTLSeconds = 60;
+
+}  // namespace
+
 ProxyResolverV8::ProxyResolverV8(
     ProxyResolverJSBindings* custom_js_bindings)
     : ProxyResolver(true /*expects_pac_bytes*/),
-      js_bindings_(custom_js_bindings) {
+      js_bindings_(custom_js_bindings),
+      result_cache_(kMaxCachedResults) {
 }
 
 ProxyResolverV8::~ProxyResolverV8() {}
 
+bool ProxyResolverV8::IsResultCacheEnabled() const {
+  return context_.get() && context_->is_host_only();
+}
+
 int ProxyResolverV8::GetProxyForURL(
     const GURL& query_url, ProxyInfo* results,
     const CompletionCallback& /*callback*/,
@@ -738,6 +1089,20 @@ int ProxyResolverV8::GetProxyForURL(
   if (!context_.get())
     return ERR_FAILED;
 
+  const bool use_cache = context_->is_host_only();
+  std::string host;
+  if (use_cache) {
+    host = query_url.HostNoBrackets();
+    ResultCache::iterator it = result_cache_.Get(host);
+    if (it != result_cache_.end()) {
+      if (base::TimeTicks::Now() < it->second.expiration) {
+        results->UsePacString(it->second.pac_string);
+        return OK;
+      }
+      result_cache_.Erase(it);
+    }
+  }
+
   // Associate some short-lived context with this request. This context will be
   // available to any of the javascript "bindings" that are subsequently invoked
   // from the javascript.
@@ -754,6 +1119,14 @@ int ProxyResolverV8::GetProxyForURL(
   int rv = context_->ResolveProxy(query_url, results);
   context_->SetCurrentRequestContext(NULL);
 
+  if (use_cache && rv == OK) {
+    CachedResult result;
+    result.pac_string = results->ToPacString();
+    result.expiration = base::TimeTicks::Now() +
+        base::TimeDelta::FromSeconds(kCachedResultTTLSeconds);
+    result_cache_.Put(host, result);
+  }
+
   return rv;
 }
 
@@ -778,6 +1151,7 @@ void ProxyResolverV8::CancelSetPacScript() {
 }
 
 void ProxyResolverV8::PurgeMemory() {
+  result_cache_.Clear();
   context_->PurgeMemory();
 }
 
@@ -789,6 +1163,7 @@ int ProxyResolverV8::SetPacScript(
     const scoped_refptr<ProxyResolverScriptData>& script_data,
     const CompletionCallback& /*callback*/) {
   DCHECK(script_data.get());
+  result_cache_.Clear();
   context_.reset();
   if (script_data->utf16().empty())
     return ERR_PAC_SCRIPT_FAILED;
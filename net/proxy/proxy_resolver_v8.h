@@ -6,8 +6,12 @@
 #define NET_PROXY_PROXY_RESOLVER_V8_H_
 #pragma once
 
+#include <string>
+
 #include "base/compiler_specific.h"
+#include "base/memory/mru_cache.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/time.h"
 #include "net/base/net_export.h"
 #include "net/proxy/proxy_resolver.h"
 
@@ -33,6 +37,15 @@ class ProxyResolverJSBindings;
 // This is the case with the V8 instance used by chromium's renderer -- it runs
 // on a different thread from ProxyResolver (renderer thread vs PAC thread),
 // and does not use locking since it expects to be alone.
+//
+// ----------------------------------------------------------------------------
+// Result cache:
+// ----------------------------------------------------------------------------
+// Scripts whose FindProxyForURL() provably never looks at the URL (only at the
+// host) give the same answer for every URL on a host, so their results are
+// kept in a small per-host cache for a short while. The cache is dropped
+// whenever a new script is set, which ProxyService also does after IP address
+// changes, and when memory is purged.
 class NET_EXPORT_PRIVATE ProxyResolverV8 : public ProxyResolver {
  public:
   // Constructs a ProxyResolverV8 with custom bindings. ProxyResolverV8 takes
@@ -44,6 +57,10 @@ class NET_EXPORT_PRIVATE ProxyResolverV8 : public ProxyResolver {
 
   ProxyResolverJSBindings* js_bindings() const { return js_bindings_.get(); }
 
+  // Returns true if the current PAC script only depends on the host of the
+  // URL being resolved, which makes its results cacheable.
+  bool IsResultCacheEnabled() const;
+
   // ProxyResolver implementation:
   virtual int GetProxyForURL(const GURL& url,
                              ProxyInfo* results,
@@ -70,6 +87,17 @@ class NET_EXPORT_PRIVATE ProxyResolverV8 : public ProxyResolver {
 
   scoped_ptr<ProxyResolverJSBindings> js_bindings_;
 
+  // A cached FindProxyForURL() result, as a PAC string.
+  struct CachedResult {
+    std::string pac_string;
+    base::TimeTicks expiration;
+  };
+  typedef base::MRUCache<std::string, CachedResult> ResultCache;
+
+  // Results for the hosts most recently resolved by a host-only script, keyed
+  // by host.
+  ResultCache result_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(ProxyResolverV8);
 };
 
@@ -569,5 +569,73 @@ TEST(ProxyResolverV8Test, IPv6HostnamesNotBracketed) {
   EXPECT_EQ("abcd::efff", resolver.mock_js_bindings()->dns_resolves_ex[0]);
 }
 
+// Test that the results of a script which only looks at the host are cached
+// per host, until the script is set again.
+TEST(ProxyResolverV8Test, CachesHostOnlyResults) {
+  ProxyResolverV8WithMockBindings resolver;
+  EXPECT_EQ(OK, resolver.SetPacScriptFromDisk("host_only.js"));
+  EXPECT_TRUE(resolver.IsResultCacheEnabled());
+
+  MockJSBindings* bindings = resolver.mock_js_bindings();
+  bindings->dns_resolve_result = "10.1.2.3";
+
+  ProxyInfo proxy_info;
+  EXPECT_EQ(OK, resolver.GetProxyForURL(
+      GURL("http://foo.com/a"), &proxy_info, CompletionCallback(), NULL,
+      BoundNetLog()));
+  EXPECT_TRUE(proxy_info.is_direct());
+  EXPECT_EQ(1U, bindings->dns_resolves.size());
+
+  // The same host on another path and scheme comes from the cache, even
+  // though the script would now give a different answer.
+  bindings->dns_resolve_result = "192.168.1.1";
+  EXPECT_EQ(OK, resolver.GetProxyForURL(
+      GURL("https://foo.com/b?c"), &proxy_info, CompletionCallback(), NULL,
+      BoundNetLog()));
+  EXPECT_TRUE(proxy_info.is_direct());
+  EXPECT_EQ(1U, bindings->dns_resolves.size());
+
+  // Another host runs the script.
+  EXPECT_EQ(OK, resolver.GetProxyForURL(
+      GURL("http://bar.com/"), &proxy_info, CompletionCallback(), NULL,
+      BoundNetLog()));
+  EXPECT_EQ("PROXY bar.com:8080", proxy_info.ToPacString());
+  EXPECT_EQ(2U, bindings->dns_resolves.size());
+
+  // Setting the script again, as is done after network changes, drops the
+  // cached results.
+  EXPECT_EQ(OK, resolver.SetPacScriptFromDisk("host_only.js"));
+  EXPECT_EQ(OK, resolver.GetProxyForURL(
+      GURL("http://foo.com/a"), &proxy_info, CompletionCallback(), NULL,
+      BoundNetLog()));
+  EXPECT_EQ("PROXY foo.com:8080", proxy_info.ToPacString());
+  EXPECT_EQ(3U, bindings->dns_resolves.size());
+
+  // So does purging memory.
+  bindings->dns_resolve_result = "10.1.2.3";
+  resolver.PurgeMemory();
+  EXPECT_EQ(OK, resolver.GetProxyForURL(
+      GURL("http://foo.com/a"), &proxy_info, CompletionCallback(), NULL,
+      BoundNetLog()));
+  EXPECT_TRUE(proxy_info.is_direct());
+  EXPECT_EQ(4U, bindings->dns_resolves.size());
+}
+
+// Test that scripts which look at the URL, or which keep state between calls,
+// are not cached.
+TEST(ProxyResolverV8Test, NoResultCacheForOtherScripts) {
+  static const char* const filenames[] = {
+    "passthrough.js",  // Uses the URL.
+    "side_effects.js",  // Counts the calls in a global.
+    "bindings.js",  // Calls alert().
+  };
+
+  for (size_t i = 0; i < arraysize(filenames); ++i) {
+    ProxyResolverV8WithMockBindings resolver;
+    EXPECT_EQ(OK, resolver.SetPacScriptFromDisk(filenames[i]));
+    EXPECT_FALSE(resolver.IsResultCacheEnabled()) << filenames[i];
+  }
+}
+
 }  // namespace
 }  // namespace net
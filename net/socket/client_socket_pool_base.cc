@@ -18,6 +18,7 @@
 #include "net/base/net_log.h"
 #include "net/base/net_errors.h"
 #include "net/socket/client_socket_handle.h"
+#include "net/socket/client_socket_pool_histograms.h"
 
 using base::TimeDelta;
 
@@ -39,6 +40,30 @@ const int kCleanupInterval = 10;  // DO NOT INCREASE THIS TIMEOUT.
 // after a certain timeout has passed without receiving an ACK.
 bool g_connect_backup_jobs_enabled = true;
 
+// Indicate whether pools should keep spare sockets for groups in steady use.
+bool g_warm_pool_enabled = false;
+
+// Indicate whether an IP address change lets pending requests and connect
+// jobs finish instead of aborting them.
+bool g_drain_on_ip_address_change = false;
+
+// Time constant, in seconds, of the decay of a group's request rate.
+const double kWarmPoolRateTimeConstant = 60;
+
+// A group is kept warm once its decayed request rate reaches this many
+// requests per second, i.e. about three requests in the last minute.
+const double kWarmPoolMinRequestRate = 0.05;
+
+// The number of spare sockets kept for a warm group.
+const int kWarmPoolSocketsPerGroup = 1;
+
+// The warm pool doesn't open spare sockets once a pool has this many idle
+// sockets.
+const int kWarmPoolMaxIdleSockets = 6;
+
+// The maximum number of groups whose demand is tracked.
+const size_t kWarmPoolMaxTrackedGroups = 64;
+
 double g_socket_reuse_policy_penalty_exponent = -1;
 int g_socket_reuse_policy = -1;
 
@@ -178,6 +203,7 @@ ClientSocketPoolBaseHelper::Request::~Request() {}
 ClientSocketPoolBaseHelper::ClientSocketPoolBaseHelper(
     int max_sockets,
     int max_sockets_per_group,
+    ClientSocketPoolHistograms* histograms,
     base::TimeDelta unused_idle_socket_timeout,
     base::TimeDelta used_idle_socket_timeout,
     ConnectJobFactory* connect_job_factory)
@@ -191,6 +217,8 @@ ClientSocketPoolBaseHelper::ClientSocketPoolBaseHelper(
       used_idle_socket_timeout_(used_idle_socket_timeout),
       connect_job_factory_(connect_job_factory),
       connect_backup_jobs_enabled_(false),
+      use_warm_pool_(g_warm_pool_enabled),
+      histograms_(histograms),
       pool_generation_number_(0),
       ALLOW_THIS_IN_INITIALIZER_LIST(weak_factory_(this)) {
   DCHECK_LE(0, max_sockets_per_group);
@@ -265,6 +293,11 @@ int ClientSocketPoolBaseHelper::RequestSocket(
   Group* group = GetOrCreateGroup(group_name);
 
   int rv = RequestSocketInternal(group_name, request);
+  if (use_warm_pool_) {
+    bool idle_hit = rv == OK &&
+        request->handle()->reuse_type() != ClientSocketHandle::UNUSED;
+    RecordGroupDemand(group_name, idle_hit);
+  }
   if (rv != ERR_IO_PENDING) {
     request->net_log().EndEventWithNetErrorCode(NetLog::TYPE_SOCKET_POOL, rv);
     CHECK(!request->handle()->is_initialized());
@@ -542,6 +575,9 @@ bool ClientSocketPoolBaseHelper::HasGroup(const std::string& group_name) const {
 void ClientSocketPoolBaseHelper::CloseIdleSockets() {
   CleanupIdleSockets(true);
   DCHECK_EQ(0, idle_socket_count_);
+  // This is how idle sockets are released under memory pressure, so don't
+  // open spare sockets again until demand has been relearned.
+  group_demand_.clear();
 }
 
 int ClientSocketPoolBaseHelper::IdleSocketCountInGroup(
@@ -733,6 +769,111 @@ void ClientSocketPoolBaseHelper::EnableConnectBackupJobs() {
   connect_backup_jobs_enabled_ = g_connect_backup_jobs_enabled;
 }
 
+// static
+bool ClientSocketPoolBaseHelper::warm_pool_enabled() {
+  return g_warm_pool_enabled;
+}
+
+// static
+bool ClientSocketPoolBaseHelper::set_warm_pool_enabled(bool enabled) {
+  bool old_value = g_warm_pool_enabled;
+  g_warm_pool_enabled = enabled;
+  return old_value;
+}
+
+// static
+bool ClientSocketPoolBaseHelper::drain_on_ip_address_change() {
+  return g_drain_on_ip_address_change;
+}
+
+// static
+bool ClientSocketPoolBaseHelper::set_drain_on_ip_address_change(bool enabled) {
+  bool old_value = g_drain_on_ip_address_change;
+  g_drain_on_ip_address_change = enabled;
+  return old_value;
+}
+
+void ClientSocketPoolBaseHelper::WarmGroup(const std::string& group_name,
+                                           const Request& request) {
+  DCHECK(use_warm_pool_);
+  DCHECK(request.flags() & NO_IDLE_SOCKETS);
+  DCHECK(!request.ignore_limits());
+  if (!IsWarmGroup(group_name, base::TimeTicks::Now()))
+    return;
+  if (idle_socket_count_ >= kWarmPoolMaxIdleSockets ||
+      ReachedMaxSocketsLimit()) {
+    return;
+  }
+
+  int num_sockets = kWarmPoolSocketsPerGroup;
+  GroupMap::const_iterator it = group_map_.find(group_name);
+  if (it != group_map_.end()) {
+    const Group* group = it->second;
+    // Spare sockets are the idle sockets and connect jobs no request is
+    // waiting for.
+    int spare_sockets = static_cast<int>(group->idle_sockets().size() +
+                                         group->jobs().size()) -
+        static_cast<int>(group->pending_requests().size());
+    if (spare_sockets < 0 || spare_sockets >= kWarmPoolSocketsPerGroup)
+      return;
+    num_sockets = group->NumActiveSocketSlots() + kWarmPoolSocketsPerGroup -
+        spare_sockets;
+  }
+  RequestSockets(group_name, request, num_sockets);
+}
+
+ClientSocketPoolBaseHelper::GroupDemand::GroupDemand()
+    : request_rate(0),
+      request_count(0),
+      idle_hit_count(0) {
+}
+
+double ClientSocketPoolBaseHelper::GroupDemand::RequestRate(
+    base::TimeTicks now) const {
+  double elapsed = (now - last_request_time).InSecondsF();
+  return request_rate * exp(-elapsed / kWarmPoolRateTimeConstant);
+}
+
+void ClientSocketPoolBaseHelper::GroupDemand::AddRequest(base::TimeTicks now,
+                                                         bool idle_hit) {
+  request_rate = RequestRate(now) + 1 / kWarmPoolRateTimeConstant;
+  last_request_time = now;
+  request_count++;
+  if (idle_hit)
+    idle_hit_count++;
+}
+
+void ClientSocketPoolBaseHelper::RecordGroupDemand(
+    const std::string& group_name, bool idle_hit) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  GroupDemandMap::iterator it = group_demand_.find(group_name);
+  if (it == group_demand_.end()) {
+    if (group_demand_.size() >= kWarmPoolMaxTrackedGroups) {
+      // Make room by forgetting the groups that have gone cold.
+      for (GroupDemandMap::iterator j = group_demand_.begin();
+           j != group_demand_.end();) {
+        if (j->second.RequestRate(now) < kWarmPoolMinRequestRate)
+          group_demand_.erase(j++);
+        else
+          ++j;
+      }
+      if (group_demand_.size() >= kWarmPoolMaxTrackedGroups)
+        return;
+    }
+    it = group_demand_.insert(std::make_pair(group_name, GroupDemand())).first;
+  } else if (it->second.RequestRate(now) >= kWarmPoolMinRequestRate) {
+    histograms_->AddWarmPoolResult(idle_hit);
+  }
+  it->second.AddRequest(now, idle_hit);
+}
+
+bool ClientSocketPoolBaseHelper::IsWarmGroup(const std::string& group_name,
+                                             base::TimeTicks now) const {
+  GroupDemandMap::const_iterator it = group_demand_.find(group_name);
+  return it != group_demand_.end() &&
+      it->second.RequestRate(now) >= kWarmPoolMinRequestRate;
+}
+
 void ClientSocketPoolBaseHelper::IncrementIdleCount() {
   if (++idle_socket_count_ == 1 && use_cleanup_timer_)
     StartIdleSocketTimer();
@@ -909,7 +1050,14 @@ void ClientSocketPoolBaseHelper::OnConnectJobComplete(
 }
 
 void ClientSocketPoolBaseHelper::OnIPAddressChanged() {
-  Flush();
+  if (!g_drain_on_ip_address_change) {
+    Flush();
+    return;
+  }
+  // Sockets from before the change are not reused once released, but the
+  // requests and connect jobs in flight are left to complete.
+  pool_generation_number_++;
+  CloseIdleSockets();
 }
 
 void ClientSocketPoolBaseHelper::Flush() {
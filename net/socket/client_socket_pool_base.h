@@ -50,6 +50,7 @@
 namespace net {
 
 class ClientSocketHandle;
+class ClientSocketPoolHistograms;
 
 // Returns the client socket reuse policy.
 NET_EXPORT_PRIVATE int GetSocketReusePolicy();
@@ -234,6 +235,7 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   ClientSocketPoolBaseHelper(
       int max_sockets,
       int max_sockets_per_group,
+      ClientSocketPoolHistograms* histograms,
       base::TimeDelta unused_idle_socket_timeout,
       base::TimeDelta used_idle_socket_timeout,
       ConnectJobFactory* connect_job_factory);
@@ -338,6 +340,27 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
   void EnableConnectBackupJobs();
 
+  // Called to enable/disable the warm pool. When enabled, pools created
+  // afterwards learn how often each group is requested and keep a spare
+  // connected socket for the groups in steady use, so that their next request
+  // doesn't wait for a connect. The spare sockets time out like any other
+  // unused idle socket, and CloseIdleSockets() forgets what was learned.
+  static bool warm_pool_enabled();
+  static bool set_warm_pool_enabled(bool enabled);
+
+  bool use_warm_pool() const { return use_warm_pool_; }
+
+  // Called to enable/disable draining on IP address changes. When enabled, an
+  // IP address change only closes the idle sockets and keeps the sockets in
+  // use from being reused; pending requests and connect jobs are not aborted.
+  static bool drain_on_ip_address_change();
+  static bool set_drain_on_ip_address_change(bool enabled);
+
+  // Opens spare sockets for |group_name| using |request|, which is set up as
+  // for RequestSockets(), if the group is in steady use and the pool's warm
+  // budget allows it. Never closes other idle sockets to make room.
+  void WarmGroup(const std::string& group_name, const Request& request);
+
   // ConnectJob::Delegate methods:
   virtual void OnConnectJobComplete(int result, ConnectJob* job) OVERRIDE;
 
@@ -443,6 +466,28 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
   typedef std::map<std::string, Group*> GroupMap;
 
+  // How often a group is requested. Unlike its Group, it outlives the gaps
+  // between the group's requests, so the warm pool can tell which groups are
+  // in steady use.
+  struct GroupDemand {
+    GroupDemand();
+
+    // Returns the exponentially decayed number of requests per second as of
+    // |now|.
+    double RequestRate(base::TimeTicks now) const;
+
+    // Counts a request made at |now|. |idle_hit| is true if an idle socket
+    // served it.
+    void AddRequest(base::TimeTicks now, bool idle_hit);
+
+    double request_rate;
+    base::TimeTicks last_request_time;
+    int request_count;
+    int idle_hit_count;
+  };
+
+  typedef std::map<std::string, GroupDemand> GroupDemandMap;
+
   typedef std::set<ConnectJob*> ConnectJobSet;
 
   struct CallbackResultPair {
@@ -467,6 +512,13 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   void RemoveGroup(const std::string& group_name);
   void RemoveGroup(GroupMap::iterator it);
 
+  // Counts a request for |group_name| towards the group's demand, and records
+  // whether it was served by an idle socket if the group is kept warm.
+  void RecordGroupDemand(const std::string& group_name, bool idle_hit);
+
+  // Returns true if |group_name| is requested often enough to be kept warm.
+  bool IsWarmGroup(const std::string& group_name, base::TimeTicks now) const;
+
   // Called when the number of idle sockets changes.
   void IncrementIdleCount();
   void DecrementIdleCount();
@@ -589,6 +641,14 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   // TODO(vandebo) Remove when backup jobs move to TransportClientSocketPool
   bool connect_backup_jobs_enabled_;
 
+  // Whether to keep spare sockets for groups in steady use.
+  const bool use_warm_pool_;
+
+  // Demand of recently requested groups. Only maintained with the warm pool.
+  GroupDemandMap group_demand_;
+
+  ClientSocketPoolHistograms* const histograms_;
+
   // A unique id for the pool.  It gets incremented every time we Flush() the
   // pool.  This is so that when sockets get released back to the pool, we can
   // make sure that they are discarded rather than reused.
@@ -655,7 +715,7 @@ class ClientSocketPoolBase {
       base::TimeDelta used_idle_socket_timeout,
       ConnectJobFactory* connect_job_factory)
       : histograms_(histograms),
-        helper_(max_sockets, max_sockets_per_group,
+        helper_(max_sockets, max_sockets_per_group, histograms,
                 unused_idle_socket_timeout, used_idle_socket_timeout,
                 new ConnectJobFactoryAdaptor(connect_job_factory)) {}
 
@@ -683,7 +743,20 @@ class ClientSocketPoolBase {
                     internal::ClientSocketPoolBaseHelper::NORMAL,
                     params->ignore_limits(),
                     params, net_log);
-    return helper_.RequestSocket(group_name, request);
+    int rv = helper_.RequestSocket(group_name, request);
+    if (helper_.use_warm_pool()) {
+      // Spare sockets are never worth going over the pool's limits for.
+      const Request warm_request(
+          NULL /* no handle */,
+          CompletionCallback(),
+          IDLE,
+          internal::ClientSocketPoolBaseHelper::NO_IDLE_SOCKETS,
+          false /* ignore_limits */,
+          params,
+          BoundNetLog());
+      helper_.WarmGroup(group_name, warm_request);
+    }
+    return rv;
   }
 
   // RequestSockets bundles up the parameters into a Request and then forwards
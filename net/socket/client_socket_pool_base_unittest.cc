@@ -21,6 +21,7 @@
 #include "net/base/net_errors.h"
 #include "net/base/net_log.h"
 #include "net/base/net_log_unittest.h"
+#include "net/base/network_change_notifier.h"
 #include "net/base/request_priority.h"
 #include "net/base/test_completion_callback.h"
 #include "net/http/http_response_headers.h"
@@ -609,6 +610,10 @@ class ClientSocketPoolBaseTest : public testing::Test {
     internal::ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(true);
     cleanup_timer_enabled_ =
         internal::ClientSocketPoolBaseHelper::cleanup_timer_enabled();
+    warm_pool_enabled_ =
+        internal::ClientSocketPoolBaseHelper::warm_pool_enabled();
+    drain_on_ip_address_change_ =
+        internal::ClientSocketPoolBaseHelper::drain_on_ip_address_change();
   }
 
   virtual ~ClientSocketPoolBaseTest() {
@@ -616,6 +621,10 @@ class ClientSocketPoolBaseTest : public testing::Test {
         connect_backup_jobs_enabled_);
     internal::ClientSocketPoolBaseHelper::set_cleanup_timer_enabled(
         cleanup_timer_enabled_);
+    internal::ClientSocketPoolBaseHelper::set_warm_pool_enabled(
+        warm_pool_enabled_);
+    internal::ClientSocketPoolBaseHelper::set_drain_on_ip_address_change(
+        drain_on_ip_address_change_);
   }
 
   void CreatePool(int max_sockets, int max_sockets_per_group) {
@@ -666,6 +675,8 @@ class ClientSocketPoolBaseTest : public testing::Test {
 
   bool connect_backup_jobs_enabled_;
   bool cleanup_timer_enabled_;
+  bool warm_pool_enabled_;
+  bool drain_on_ip_address_change_;
   MockClientSocketFactory client_socket_factory_;
   TestConnectJobFactory* connect_job_factory_;
   scoped_refptr<TestSocketParams> params_;
@@ -3416,6 +3427,103 @@ TEST_F(ClientSocketPoolBaseTest, PreconnectWithBackupJob) {
   EXPECT_EQ(1, pool_->NumActiveSocketsInGroup("a"));
 }
 
+// A group that is requested often gets a spare socket, which the next request
+// uses.
+TEST_F(ClientSocketPoolBaseTest, WarmPoolKeepsSpareSocket) {
+  internal::ClientSocketPoolBaseHelper::set_warm_pool_enabled(true);
+  CreatePool(16, 8);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+  EXPECT_EQ(0, pool_->IdleSocketCountInGroup("a"));
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+  EXPECT_EQ(4, pool_->NumActiveSocketsInGroup("a"));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("a"));
+
+  // The next request takes the spare socket, and another one is opened.
+  EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+  EXPECT_EQ(ClientSocketHandle::UNUSED_IDLE,
+            request(requests_size() - 1)->handle()->reuse_type());
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("a"));
+
+  // Other groups are not warmed.
+  EXPECT_EQ(OK, StartRequest("b", kDefaultPriority));
+  EXPECT_EQ(0, pool_->IdleSocketCountInGroup("b"));
+
+  ReleaseAllConnections(ClientSocketPoolTest::NO_KEEP_ALIVE);
+}
+
+// The warm pool never goes over the pool's socket limits.
+TEST_F(ClientSocketPoolBaseTest, WarmPoolRespectsLimits) {
+  internal::ClientSocketPoolBaseHelper::set_warm_pool_enabled(true);
+  CreatePool(4, 4);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+  EXPECT_EQ(4, pool_->NumActiveSocketsInGroup("a"));
+  EXPECT_EQ(0, pool_->IdleSocketCountInGroup("a"));
+
+  ReleaseAllConnections(ClientSocketPoolTest::NO_KEEP_ALIVE);
+}
+
+// Closing idle sockets, as done under memory pressure, also forgets which
+// groups were kept warm.
+TEST_F(ClientSocketPoolBaseTest, WarmPoolCloseIdleSockets) {
+  internal::ClientSocketPoolBaseHelper::set_warm_pool_enabled(true);
+  CreatePool(16, 8);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockJob);
+
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+  EXPECT_EQ(1, pool_->IdleSocketCountInGroup("a"));
+
+  pool_->CloseIdleSockets();
+  EXPECT_EQ(0, pool_->IdleSocketCount());
+
+  EXPECT_EQ(OK, StartRequest("a", kDefaultPriority));
+  EXPECT_EQ(0, pool_->IdleSocketCountInGroup("a"));
+
+  ReleaseAllConnections(ClientSocketPoolTest::NO_KEEP_ALIVE);
+}
+
+// With draining enabled, an IP address change lets a pending request finish,
+// but the socket it gets is not reused afterwards.
+TEST_F(ClientSocketPoolBaseTest, DrainOnIPAddressChange) {
+  internal::ClientSocketPoolBaseHelper::set_drain_on_ip_address_change(true);
+  CreatePool(kDefaultMaxSockets, kDefaultMaxSocketsPerGroup);
+  connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
+
+  ClientSocketHandle handle;
+  TestCompletionCallback callback;
+  EXPECT_EQ(ERR_IO_PENDING, handle.Init("a",
+                                        params_,
+                                        kDefaultPriority,
+                                        callback.callback(),
+                                        pool_.get(),
+                                        BoundNetLog()));
+
+  NetworkChangeNotifier::NotifyObserversOfIPAddressChangeForTests();
+  MessageLoop::current()->RunAllPending();
+
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(ClientSocketHandle::UNUSED, handle.reuse_type());
+
+  handle.Reset();
+  MessageLoop::current()->RunAllPending();
+  EXPECT_EQ(0, pool_->IdleSocketCount());
+
+  EXPECT_EQ(ERR_IO_PENDING, handle.Init("a",
+                                        params_,
+                                        kDefaultPriority,
+                                        callback.callback(),
+                                        pool_.get(),
+                                        BoundNetLog()));
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(ClientSocketHandle::UNUSED, handle.reuse_type());
+}
+
 }  // namespace
 
 }  // namespace net
@@ -12,6 +12,7 @@
 
 namespace net {
 
+using base::BooleanHistogram;
 using base::Histogram;
 using base::LinearHistogram;
 
@@ -41,6 +42,10 @@ ClientSocketPoolHistograms::ClientSocketPoolHistograms(
       base::TimeDelta::FromMilliseconds(1),
       base::TimeDelta::FromMinutes(6),
       100, Histogram::kUmaTargetedHistogramFlag);
+  // UMA_HISTOGRAM_BOOLEAN
+  warm_pool_hit_ = BooleanHistogram::FactoryGet(
+      "Net.SocketWarmPoolHit_" + pool_name,
+      Histogram::kUmaTargetedHistogramFlag);
 
   if (pool_name == "HTTPProxy")
     is_http_proxy_connection_ = true;
@@ -86,4 +91,8 @@ void ClientSocketPoolHistograms::AddReusedIdleTime(base::TimeDelta time) const {
   reused_idle_time_->AddTime(time);
 }
 
+void ClientSocketPoolHistograms::AddWarmPoolResult(bool hit) const {
+  warm_pool_hit_->AddBoolean(hit);
+}
+
 }  // namespace net
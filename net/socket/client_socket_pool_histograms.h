@@ -27,12 +27,16 @@ class NET_EXPORT_PRIVATE ClientSocketPoolHistograms {
   void AddRequestTime(base::TimeDelta time) const;
   void AddUnusedIdleTime(base::TimeDelta time) const;
   void AddReusedIdleTime(base::TimeDelta time) const;
+  // Records whether a request to a group kept warm by the pool was served by
+  // an idle socket.
+  void AddWarmPoolResult(bool hit) const;
 
  private:
   base::Histogram* socket_type_;
   base::Histogram* request_time_;
   base::Histogram* unused_idle_time_;
   base::Histogram* reused_idle_time_;
+  base::Histogram* warm_pool_hit_;
 
   bool is_http_proxy_connection_;
   bool is_socks_connection_;
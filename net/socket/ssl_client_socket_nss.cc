@@ -422,6 +422,54 @@ DNSValidationResult CheckDNSSECChain(
   return r;
 }
 
+// Parameters for the SSL_HANDSHAKE_TIMES NetLog event.
+class HandshakeTimesParams : public NetLog::EventParameters {
+ public:
+  HandshakeTimesParams(base::TimeDelta server_first_flight,
+                       base::TimeDelta handshake,
+                       base::TimeDelta cert_verification,
+                       bool resumed,
+                       bool false_start_allowed,
+                       bool predicted_cert_chain_correct)
+      : server_first_flight_(server_first_flight),
+        handshake_(handshake),
+        cert_verification_(cert_verification),
+        resumed_(resumed),
+        false_start_allowed_(false_start_allowed),
+        predicted_cert_chain_correct_(predicted_cert_chain_correct) {
+  }
+
+  virtual base::Value* ToValue() const OVERRIDE {
+    base::DictionaryValue* dict = new base::DictionaryValue();
+    if (!resumed_) {
+      dict->SetInteger("server_first_flight_ms",
+                       static_cast<int>(server_first_flight_.InMilliseconds()));
+    }
+    dict->SetInteger("handshake_ms",
+                     static_cast<int>(handshake_.InMilliseconds()));
+    dict->SetInteger("cert_verification_ms",
+                     static_cast<int>(cert_verification_.InMilliseconds()));
+    dict->SetBoolean("resumed", resumed_);
+    dict->SetBoolean("false_start_allowed", false_start_allowed_);
+    dict->SetBoolean("predicted_cert_chain_correct",
+                     predicted_cert_chain_correct_);
+    return dict;
+  }
+
+ protected:
+  virtual ~HandshakeTimesParams() {}
+
+ private:
+  const base::TimeDelta server_first_flight_;
+  const base::TimeDelta handshake_;
+  const base::TimeDelta cert_verification_;
+  const bool resumed_;
+  const bool false_start_allowed_;
+  const bool predicted_cert_chain_correct_;
+
+  DISALLOW_COPY_AND_ASSIGN(HandshakeTimesParams);
+};
+
 }  // namespace
 
 SSLClientSocketNSS::SSLClientSocketNSS(ClientSocketHandle* transport_socket,
@@ -571,6 +619,7 @@ int SSLClientSocketNSS::Connect(const CompletionCallback& callback) {
   EnsureThreadIdAssigned();
 
   net_log_.BeginEvent(NetLog::TYPE_SSL_CONNECT, NULL);
+  start_handshake_time_ = base::TimeTicks::Now();
 
   int rv = Init();
   if (rv != OK) {
@@ -648,6 +697,9 @@ void SSLClientSocketNSS::Disconnect() {
   ssl_connection_status_ = 0;
   completed_handshake_   = false;
   eset_mitm_detected_    = false;
+  start_handshake_time_ = base::TimeTicks();
+  server_first_flight_time_ = base::TimeTicks();
+  end_handshake_time_ = base::TimeTicks();
   start_cert_verification_time_ = base::TimeTicks();
   predicted_cert_chain_correct_ = false;
   nss_bufs_              = NULL;
@@ -1051,6 +1103,16 @@ int SSLClientSocketNSS::InitializeSSLPeerName() {
   if (!ssl_session_cache_shard_.empty()) {
     peer_id += "/" + ssl_session_cache_shard_;
   }
+  // Connections with a restricted set of protocol versions, such as the SSL
+  // 3.0 fallback, get their own entries. When NSS finds a cached session with
+  // a version it can't offer, it removes it from the cache; a single fallback
+  // would otherwise cost every later connection to the server a full
+  // handshake.
+  if (!ssl_config_.ssl3_enabled || !ssl_config_.tls1_enabled) {
+    peer_id += base::StringPrintf("/%s%s",
+                                  ssl_config_.ssl3_enabled ? "ssl3" : "",
+                                  ssl_config_.tls1_enabled ? "tls1" : "");
+  }
   SECStatus rv = SSL_SetSockPeerID(nss_fd_, const_cast<char*>(peer_id.c_str()));
   if (rv != SECSuccess)
     LogFailedNSSFunction(net_log_, "SSL_SetSockPeerID", peer_id.c_str());
@@ -1510,6 +1572,8 @@ int SSLClientSocketNSS::DoHandshake() {
 #endif
 
         SaveSSLHostInfo();
+        if (end_handshake_time_.is_null())
+          end_handshake_time_ = base::TimeTicks::Now();
         // SSL handshake is completed. Let's verify the certificate.
         GotoState(STATE_VERIFY_DNSSEC);
       }
@@ -1733,8 +1797,10 @@ int SSLClientSocketNSS::DoVerifyCertComplete(int result) {
   // TODO(hclam): Skip logging if server cert was expected to be bad because
   // |server_cert_verify_result_| doesn't contain all the information about
   // the cert.
-  if (result == OK)
+  if (result == OK) {
     LogConnectionTypeMetrics();
+    LogHandshakeTimes();
+  }
 
   completed_handshake_ = true;
 
@@ -1845,6 +1911,49 @@ int SSLClientSocketNSS::DoPayloadWrite() {
   return rv;
 }
 
+void SSLClientSocketNSS::LogHandshakeTimes() {
+  // Renegotiations and sockets that resumed verification from another path
+  // may get here without a measured handshake.
+  if (start_handshake_time_.is_null() || end_handshake_time_.is_null())
+    return;
+
+  PRBool last_handshake_resumed = PR_FALSE;
+  SSL_HandshakeResumedSession(nss_fd_, &last_handshake_resumed);
+  bool resumed = last_handshake_resumed ? true : false;
+  // NSS only uses False Start on full handshakes with servers that support
+  // NPN; see OwnAuthCertHandler().
+  bool false_start_allowed = ssl_config_.false_start_enabled && !resumed &&
+                             next_proto_status_ == kNextProtoNegotiated;
+
+  base::TimeDelta server_first_flight;
+  if (!server_first_flight_time_.is_null())
+    server_first_flight = server_first_flight_time_ - start_handshake_time_;
+  base::TimeDelta handshake = end_handshake_time_ - start_handshake_time_;
+  base::TimeDelta cert_verification;
+  if (!start_cert_verification_time_.is_null()) {
+    cert_verification =
+        base::TimeTicks::Now() - start_cert_verification_time_;
+  }
+
+  net_log_.AddEvent(
+      NetLog::TYPE_SSL_HANDSHAKE_TIMES,
+      make_scoped_refptr(new HandshakeTimesParams(
+          server_first_flight, handshake, cert_verification, resumed,
+          false_start_allowed, predicted_cert_chain_correct_)));
+
+  if (resumed) {
+    UMA_HISTOGRAM_TIMES("Net.SSLHandshakeTime_Resume", handshake);
+    return;
+  }
+  UMA_HISTOGRAM_TIMES("Net.SSLHandshakeTime_Full", handshake);
+  if (!server_first_flight_time_.is_null())
+    UMA_HISTOGRAM_TIMES("Net.SSLServerFirstFlightTime", server_first_flight);
+  if (false_start_allowed)
+    UMA_HISTOGRAM_TIMES("Net.SSLHandshakeTime_FalseStart", handshake);
+  if (predicted_cert_chain_correct_)
+    UMA_HISTOGRAM_TIMES("Net.SSLHandshakeTime_PredictedCerts", handshake);
+}
+
 void SSLClientSocketNSS::LogConnectionTypeMetrics() const {
   UpdateConnectionTypeHistograms(CONNECTION_SSL);
   if (server_cert_verify_result_->has_md5)
@@ -1942,11 +2051,16 @@ int SSLClientSocketNSS::BufferSend(void) {
 
   int rv = 0;
   if (len) {
-    scoped_refptr<IOBuffer> send_buffer(new IOBuffer(len));
-    memcpy(send_buffer->data(), buf1, len1);
-    memcpy(send_buffer->data() + len1, buf2, len2);
+    // As with |recv_buffer_|, reuse the send buffer unless the transport
+    // still holds it or the pending data no longer fits.
+    if (!send_buffer_ || !send_buffer_->HasOneRef() ||
+        send_buffer_->size() < static_cast<int>(len)) {
+      send_buffer_ = new IOBufferWithSize(std::max<int>(len, kRecvBufferSize));
+    }
+    memcpy(send_buffer_->data(), buf1, len1);
+    memcpy(send_buffer_->data() + len1, buf2, len2);
     rv = transport_->socket()->Write(
-        send_buffer, len,
+        send_buffer_, len,
         base::Bind(&SSLClientSocketNSS::BufferSendComplete,
                    base::Unretained(this)));
     if (rv == ERR_IO_PENDING) {
@@ -1979,7 +2093,12 @@ int SSLClientSocketNSS::BufferRecv(void) {
     // buffer too full to read into, so no I/O possible at moment
     rv = ERR_IO_PENDING;
   } else {
-    recv_buffer_ = new IOBuffer(nb);
+    // The buffer is kept for the life of the socket rather than allocated for
+    // every transport read. A transport socket may still hold a reference to
+    // it after a cancelled read, in which case a fresh one is needed.
+    if (!recv_buffer_ || !recv_buffer_->HasOneRef())
+      recv_buffer_ = new IOBuffer(kRecvBufferSize);
+    DCHECK_LE(nb, kRecvBufferSize);
     rv = transport_->socket()->Read(
         recv_buffer_, nb,
         base::Bind(&SSLClientSocketNSS::BufferRecvComplete,
@@ -1990,7 +2109,6 @@ int SSLClientSocketNSS::BufferRecv(void) {
       if (rv > 0)
         memcpy(buf, recv_buffer_->data(), rv);
       memio_PutReadResult(nss_bufs_, MapErrorToNSS(rv));
-      recv_buffer_ = NULL;
     }
   }
   LeaveFunction(rv);
@@ -2004,7 +2122,6 @@ void SSLClientSocketNSS::BufferRecvComplete(int result) {
     memio_GetReadParams(nss_bufs_, &buf);
     memcpy(buf, recv_buffer_->data(), result);
   }
-  recv_buffer_ = NULL;
   memio_PutReadResult(nss_bufs_, MapErrorToNSS(result));
   transport_recv_busy_ = false;
   OnRecvComplete(result);
@@ -2053,8 +2170,11 @@ SECStatus SSLClientSocketNSS::OwnAuthCertHandler(void* arg,
                                                  PRFileDesc* socket,
                                                  PRBool checksig,
                                                  PRBool is_server) {
-#ifdef SSL_ENABLE_FALSE_START
   SSLClientSocketNSS* that = reinterpret_cast<SSLClientSocketNSS*>(arg);
+  if (that->server_first_flight_time_.is_null())
+    that->server_first_flight_time_ = base::TimeTicks::Now();
+
+#ifdef SSL_ENABLE_FALSE_START
   if (!that->server_cert_nss_) {
     // Only need to turn off False Start in the initial handshake. Also, it is
     // unsafe to call SSL_OptionSet in a renegotiation because the "first
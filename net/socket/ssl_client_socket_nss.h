@@ -35,6 +35,7 @@ namespace net {
 class BoundNetLog;
 class CertVerifier;
 class ClientSocketHandle;
+class IOBufferWithSize;
 class ServerBoundCertService;
 class SingleRequestCertVerifier;
 class SSLHostInfo;
@@ -146,6 +147,9 @@ class SSLClientSocketNSS : public SSLClientSocket {
   int DoPayloadRead();
   int DoPayloadWrite();
   void LogConnectionTypeMetrics() const;
+  // Records how long each phase of the handshake took, and which shortcuts
+  // it used, to the NetLog and to histograms.
+  void LogHandshakeTimes();
   void SaveSSLHostInfo();
 
   bool DoTransportIO();
@@ -210,7 +214,9 @@ class SSLClientSocketNSS : public SSLClientSocket {
 
   bool transport_send_busy_;
   bool transport_recv_busy_;
+  // Buffers for the transport reads and writes, reused between operations.
   scoped_refptr<IOBuffer> recv_buffer_;
+  scoped_refptr<IOBufferWithSize> send_buffer_;
 
   scoped_ptr<ClientSocketHandle> transport_;
   HostPortPair host_and_port_;
@@ -286,6 +292,13 @@ class SSLClientSocketNSS : public SSLClientSocket {
 
   BoundNetLog net_log_;
 
+  // When Connect() was called, when the server's certificate arrived (the
+  // end of its first flight in a full handshake) and when the handshake
+  // completed, before certificate verification.
+  base::TimeTicks start_handshake_time_;
+  base::TimeTicks server_first_flight_time_;
+  base::TimeTicks end_handshake_time_;
+
   base::TimeTicks start_cert_verification_time_;
 
   scoped_ptr<SSLHostInfo> ssl_host_info_;
@@ -51,6 +51,19 @@ struct DictionaryIds {
 // initialized lazily to avoid static initializers.
 base::LazyInstance<DictionaryIds>::Leaky g_dictionary_ids;
 
+// Writes a header block length field at |*out| and advances |*out| past it.
+void WriteLength(size_t length, bool short_lengths, char** out) {
+  if (short_lengths) {
+    uint16 value = htons(static_cast<uint16>(length));
+    memcpy(*out, &value, sizeof(value));
+    *out += sizeof(value);
+  } else {
+    uint32 value = htonl(static_cast<uint32>(length));
+    memcpy(*out, &value, sizeof(value));
+    *out += sizeof(value);
+  }
+}
+
 }  // namespace
 
 const int SpdyFramer::kMinSpdyVersion = 2;
@@ -126,6 +139,7 @@ SpdyFramer::SpdyFramer(int version)
       remaining_control_header_(0),
       current_frame_buffer_(new char[kControlFrameBufferSize]),
       current_frame_len_(0),
+      header_scratch_size_(0),
       enable_compression_(true),
       visitor_(NULL),
       display_protocol_("SPDY"),
@@ -661,6 +675,96 @@ void SpdyFramer::WriteHeaderBlock(SpdyFrameBuilder* frame,
   }
 }
 
+size_t SpdyFramer::GetHeaderBlockCapacity(const SpdyHeaderBlock* headers,
+                                          z_stream* compressor) const {
+  size_t serialized_length = GetSerializedLength(headers);
+  if (!compressor)
+    return serialized_length;
+  return deflateBound(compressor, serialized_length);
+}
+
+void SpdyFramer::SerializeHeaderBlockToScratch(
+    const SpdyHeaderBlock* headers,
+    size_t serialized_length) {
+  if (header_scratch_size_ < serialized_length) {
+    header_scratch_.reset(new char[serialized_length]);
+    header_scratch_size_ = serialized_length;
+  }
+
+  char* out = header_scratch_.get();
+  const bool short_lengths = spdy_version_ < 3;
+  WriteLength(headers->size(), short_lengths, &out);
+  SpdyHeaderBlock::const_iterator it;
+  for (it = headers->begin(); it != headers->end(); ++it) {
+    WriteLength(it->first.size(), short_lengths, &out);
+    memcpy(out, it->first.data(), it->first.size());
+    out += it->first.size();
+    WriteLength(it->second.size(), short_lengths, &out);
+    memcpy(out, it->second.data(), it->second.size());
+    out += it->second.size();
+  }
+  DCHECK_EQ(serialized_length,
+            static_cast<size_t>(out - header_scratch_.get()));
+}
+
+SpdyControlFrame* SpdyFramer::FinishHeaderBlockFrame(
+    SpdyFrameBuilder* frame,
+    const SpdyHeaderBlock* headers,
+    size_t header_block_capacity,
+    z_stream* compressor) {
+  if (!compressor) {
+    WriteHeaderBlock(frame, headers);
+    return reinterpret_cast<SpdyControlFrame*>(frame->take());
+  }
+
+  base::StatsCounter compressed_frames("spdy.CompressedFrames");
+  base::StatsCounter pre_compress_bytes("spdy.PreCompressSize");
+  base::StatsCounter post_compress_bytes("spdy.PostCompressSize");
+
+  // Serialize the header block into the framer's scratch buffer and deflate
+  // it straight into the tail of the frame's buffer, which the caller sized
+  // for the fixed fields plus |header_block_capacity|.
+  size_t serialized_length = GetSerializedLength(headers);
+  SerializeHeaderBlockToScratch(headers, serialized_length);
+
+  size_t header_length = frame->length();
+  scoped_ptr<SpdyControlFrame> new_frame(
+      reinterpret_cast<SpdyControlFrame*>(frame->take()));
+  compressor->next_in = reinterpret_cast<Bytef*>(header_scratch_.get());
+  compressor->avail_in = serialized_length;
+  compressor->next_out = reinterpret_cast<Bytef*>(new_frame->data()) +
+                         header_length;
+  compressor->avail_out = header_block_capacity;
+
+  // Make sure that all the data we pass to zlib is defined.
+  // This way, all Valgrind reports on the compressed data are zlib's fault.
+  (void)VALGRIND_CHECK_MEM_IS_DEFINED(compressor->next_in,
+                                      compressor->avail_in);
+
+  int rv = deflate(compressor, Z_SYNC_FLUSH);
+  if (rv != Z_OK) {
+    LOG(WARNING) << "deflate failure: " << rv;
+    return NULL;
+  }
+
+  int compressed_size = header_block_capacity - compressor->avail_out;
+
+  // We trust zlib. Also, we can't do anything about it.
+  // See http://www.zlib.net/zlib_faq.html#faq36
+  (void)VALGRIND_MAKE_MEM_DEFINED(new_frame->data() + header_length,
+                                  compressed_size);
+
+  new_frame->set_length(
+      header_length + compressed_size - SpdyFrame::kHeaderSize);
+
+  pre_compress_bytes.Add(serialized_length);
+  post_compress_bytes.Add(new_frame->length());
+
+  compressed_frames.Increment();
+
+  return new_frame.release();
+}
+
 
 size_t SpdyFramer::ProcessControlFrameBeforeHeaderBlock(const char* data,
                                                         size_t len) {
@@ -1031,11 +1135,19 @@ SpdySynStreamControlFrame* SpdyFramer::CreateSynStream(
   DCHECK_EQ(0u, stream_id & ~kStreamIdMask);
   DCHECK_EQ(0u, associated_stream_id & ~kStreamIdMask);
 
+  z_stream* compressor = NULL;
+  if (compressed && enable_compression_) {
+    compressor = GetHeaderCompressor();
+    if (!compressor)
+      return NULL;
+  }
+
   // Find our length.
-  size_t frame_size = SpdySynStreamControlFrame::size() +
-                      GetSerializedLength(headers);
+  size_t frame_size = SpdySynStreamControlFrame::size();
+  size_t header_block_capacity = GetHeaderBlockCapacity(headers, compressor);
 
-  SpdyFrameBuilder frame(SYN_STREAM, flags, spdy_version_, frame_size);
+  SpdyFrameBuilder frame(SYN_STREAM, flags, spdy_version_,
+                         frame_size + header_block_capacity);
   frame.WriteUInt32(stream_id);
   frame.WriteUInt32(associated_stream_id);
   // Cap as appropriate.
@@ -1046,16 +1158,11 @@ SpdySynStreamControlFrame* SpdyFramer::CreateSynStream(
   // Priority is 2 bits for <spdy3, 3 bits otherwise.
   frame.WriteUInt8(priority << ((spdy_version_ < 3) ? 6 : 5));
   frame.WriteUInt8((spdy_version_ < 3) ? 0 : credential_slot);
-  WriteHeaderBlock(&frame, headers);
   DCHECK_EQ(frame.length(), frame_size);
 
-  scoped_ptr<SpdySynStreamControlFrame> syn_frame(
-      reinterpret_cast<SpdySynStreamControlFrame*>(frame.take()));
-  if (compressed) {
-    return reinterpret_cast<SpdySynStreamControlFrame*>(
-        CompressControlFrame(*syn_frame.get()));
-  }
-  return syn_frame.release();
+  return reinterpret_cast<SpdySynStreamControlFrame*>(
+      FinishHeaderBlockFrame(&frame, headers, header_block_capacity,
+                             compressor));
 }
 
 SpdySynReplyControlFrame* SpdyFramer::CreateSynReply(
@@ -1066,29 +1173,32 @@ SpdySynReplyControlFrame* SpdyFramer::CreateSynReply(
   DCHECK_GT(stream_id, 0u);
   DCHECK_EQ(0u, stream_id & ~kStreamIdMask);
 
+  z_stream* compressor = NULL;
+  if (compressed && enable_compression_) {
+    compressor = GetHeaderCompressor();
+    if (!compressor)
+      return NULL;
+  }
+
   // Find our length.
-  size_t frame_size = SpdySynReplyControlFrame::size() +
-                      GetSerializedLength(headers);
+  size_t frame_size = SpdySynReplyControlFrame::size();
   // In SPDY 2, there were 2 unused bytes before payload.
   if (spdy_version_ < 3) {
     frame_size += 2;
   }
+  size_t header_block_capacity = GetHeaderBlockCapacity(headers, compressor);
 
-  SpdyFrameBuilder frame(SYN_REPLY, flags, spdy_version_, frame_size);
+  SpdyFrameBuilder frame(SYN_REPLY, flags, spdy_version_,
+                         frame_size + header_block_capacity);
   frame.WriteUInt32(stream_id);
   if (spdy_version_ < 3) {
     frame.WriteUInt16(0);  // Unused
   }
-  WriteHeaderBlock(&frame, headers);
   DCHECK_EQ(frame.length(), frame_size);
 
-  scoped_ptr<SpdySynReplyControlFrame> reply_frame(
-      reinterpret_cast<SpdySynReplyControlFrame*>(frame.take()));
-  if (compressed) {
-    return reinterpret_cast<SpdySynReplyControlFrame*>(
-        CompressControlFrame(*reply_frame.get()));
-  }
-  return reply_frame.release();
+  return reinterpret_cast<SpdySynReplyControlFrame*>(
+      FinishHeaderBlockFrame(&frame, headers, header_block_capacity,
+                             compressor));
 }
 
 SpdyRstStreamControlFrame* SpdyFramer::CreateRstStream(
@@ -1162,29 +1272,32 @@ SpdyHeadersControlFrame* SpdyFramer::CreateHeaders(
   DCHECK_GT(stream_id, 0u);
   DCHECK_EQ(0u, stream_id & ~kStreamIdMask);
 
+  z_stream* compressor = NULL;
+  if (compressed && enable_compression_) {
+    compressor = GetHeaderCompressor();
+    if (!compressor)
+      return NULL;
+  }
+
   // Find our length.
-  size_t frame_size = SpdyHeadersControlFrame::size() +
-                      GetSerializedLength(headers);
+  size_t frame_size = SpdyHeadersControlFrame::size();
   // In SPDY 2, there were 2 unused bytes before payload.
   if (spdy_version_ < 3) {
     frame_size += 2;
   }
+  size_t header_block_capacity = GetHeaderBlockCapacity(headers, compressor);
 
-  SpdyFrameBuilder frame(HEADERS, flags, spdy_version_, frame_size);
+  SpdyFrameBuilder frame(HEADERS, flags, spdy_version_,
+                         frame_size + header_block_capacity);
   frame.WriteUInt32(stream_id);
   if (spdy_version_ < 3) {
     frame.WriteUInt16(0);  // Unused
   }
-  WriteHeaderBlock(&frame, headers);
   DCHECK_EQ(frame.length(), frame_size);
 
-  scoped_ptr<SpdyHeadersControlFrame> headers_frame(
-      reinterpret_cast<SpdyHeadersControlFrame*>(frame.take()));
-  if (compressed) {
-    return reinterpret_cast<SpdyHeadersControlFrame*>(
-        CompressControlFrame(*headers_frame.get()));
-  }
-  return headers_frame.release();
+  return reinterpret_cast<SpdyHeadersControlFrame*>(
+      FinishHeaderBlockFrame(&frame, headers, header_block_capacity,
+                             compressor));
 }
 
 SpdyWindowUpdateControlFrame* SpdyFramer::CreateWindowUpdate(
@@ -497,6 +497,27 @@ class NET_EXPORT_PRIVATE SpdyFramer {
   void WriteHeaderBlock(SpdyFrameBuilder* frame,
                         const SpdyHeaderBlock* headers) const;
 
+  // Returns the number of bytes to reserve for |headers| after the fixed
+  // fields of a frame: their serialized length, or the most that deflating
+  // them can produce when |compressor| is non-NULL.
+  size_t GetHeaderBlockCapacity(const SpdyHeaderBlock* headers,
+                                z_stream* compressor) const;
+
+  // Serializes |headers|, which take |serialized_length| bytes, into
+  // |header_scratch_|, growing it if needed.
+  void SerializeHeaderBlockToScratch(const SpdyHeaderBlock* headers,
+                                     size_t serialized_length);
+
+  // Appends |headers| to |frame|, whose fixed fields have been written and
+  // which has room for |header_block_capacity| more bytes, and takes the
+  // frame. When |compressor| is non-NULL the header block is deflated from
+  // the scratch buffer straight into the frame's buffer, without building an
+  // uncompressed copy of the frame. Returns NULL if compression fails.
+  SpdyControlFrame* FinishHeaderBlockFrame(SpdyFrameBuilder* frame,
+                                           const SpdyHeaderBlock* headers,
+                                           size_t header_block_capacity,
+                                           z_stream* compressor);
+
   // Set the error code and moves the framer into the error state.
   void set_error(SpdyError error);
 
@@ -539,6 +560,11 @@ class NET_EXPORT_PRIVATE SpdyFramer {
   // current_frame_buffer_.
   SpdySettingsScratch settings_scratch_;
 
+  // Reused buffer that header blocks are serialized into before they are
+  // compressed.
+  scoped_array<char> header_scratch_;
+  size_t header_scratch_size_;
+
   bool enable_compression_;  // Controls all compression
   // SPDY header compressors.
   scoped_ptr<z_stream> header_compressor_;
@@ -0,0 +1,79 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "base/memory/scoped_ptr.h"
+#include "base/perftimer.h"
+#include "base/stringprintf.h"
+#include "net/spdy/spdy_framer.h"
+#include "net/spdy/spdy_protocol.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kNumFrames = 20000;
+
+// A header block the size of a typical browser request.
+void BuildRequestHeaders(SpdyHeaderBlock* headers) {
+  (*headers)[":method"] = "GET";
+  (*headers)[":path"] = "/index.html?query=some+search+terms&page=2";
+  (*headers)[":version"] = "HTTP/1.1";
+  (*headers)[":host"] = "www.example.com";
+  (*headers)[":scheme"] = "https";
+  (*headers)["accept"] =
+      "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8";
+  (*headers)["accept-encoding"] = "gzip,deflate,sdch";
+  (*headers)["accept-language"] = "en-US,en;q=0.8";
+  (*headers)["cookie"] = std::string(200, 'c');
+  (*headers)["user-agent"] =
+      "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/536.5 (KHTML, like Gecko)";
+}
+
+void RunSynStreamPerfTest(int spdy_version, bool compressed) {
+  SpdyFramer framer(spdy_version);
+  framer.set_enable_compression(compressed);
+  SpdyHeaderBlock headers;
+  BuildRequestHeaders(&headers);
+
+  std::string name = base::StringPrintf(
+      "Spdy%d_framer_syn_stream_%s", spdy_version,
+      compressed ? "compressed" : "uncompressed");
+  std::vector<double> rate_samples;
+  int64 total_bytes = 0;
+  for (int run = 0; run < GetPerfRepetitions(); ++run) {
+    // Stream ids keep increasing across runs, as they would on one session.
+    int stream_id_base = run * kNumFrames;
+    total_bytes = 0;
+    PerfTimer timer;
+    for (int i = 0; i < kNumFrames; ++i) {
+      scoped_ptr<SpdyFrame> frame(framer.CreateSynStream(
+          2 * (stream_id_base + i) + 1, 0, 0, 0, CONTROL_FLAG_NONE,
+          compressed, &headers));
+      ASSERT_TRUE(frame.get() != NULL);
+      total_bytes += frame->length() + SpdyFrame::kHeaderSize;
+    }
+    rate_samples.push_back(kNumFrames / timer.Elapsed().InSecondsF());
+  }
+
+  LogPerfResultSamples((name + "_rate").c_str(), rate_samples, "frames/s");
+  LogPerfResult((name + "_size").c_str(),
+                static_cast<double>(total_bytes) / kNumFrames, "bytes/frame");
+}
+
+}  // namespace
+
+TEST(SpdyFramerPerfTest, SynStreamSpdy2) {
+  RunSynStreamPerfTest(2, false);
+  RunSynStreamPerfTest(2, true);
+}
+
+TEST(SpdyFramerPerfTest, SynStreamSpdy3) {
+  RunSynStreamPerfTest(3, false);
+  RunSynStreamPerfTest(3, true);
+}
+
+}  // namespace net
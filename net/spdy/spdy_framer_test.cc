@@ -1197,6 +1197,36 @@ TEST_P(SpdyFramerTest, HeaderCompression) {
   EXPECT_EQ(kValue3, decompressed_headers[kHeader3]);
 }
 
+// Header blocks that are deflated while they are serialized decompress to
+// exactly the bytes of the uncompressed frame, across several frames sharing
+// the compression context.
+TEST_P(SpdyFramerTest, CompressedHeaderBlockMatchesUncompressed) {
+  SpdyFramer send_framer(spdy_version_);
+  SpdyFramer recv_framer(spdy_version_);
+  SpdyFramer plain_framer(spdy_version_);
+  send_framer.set_enable_compression(true);
+  recv_framer.set_enable_compression(true);
+
+  SpdyHeaderBlock block;
+  block["empty"] = "";
+  block["method"] = "GET";
+  for (int i = 0; i < 3; ++i) {
+    block["long"] = string(200 * (i + 1), 'a' + i);
+    scoped_ptr<SpdyFrame> compressed(send_framer.CreateSynStream(
+        2 * i + 1, 0, 0, 0, CONTROL_FLAG_NONE, true, &block));
+    ASSERT_TRUE(compressed.get() != NULL);
+    scoped_ptr<SpdyFrame> plain(plain_framer.CreateSynStream(
+        2 * i + 1, 0, 0, 0, CONTROL_FLAG_NONE, false, &block));
+    scoped_ptr<SpdyFrame> decompressed(SpdyFramerTestUtil::DecompressFrame(
+        &recv_framer, *compressed.get()));
+    ASSERT_TRUE(decompressed.get() != NULL);
+    CompareFrame("SYN_STREAM frame",
+                 *decompressed,
+                 reinterpret_cast<const unsigned char*>(plain->data()),
+                 plain->length() + SpdyFrame::kHeaderSize);
+  }
+}
+
 // Verify we don't leak when we leave streams unclosed
 TEST_P(SpdyFramerTest, UnclosedStreamDataCompressors) {
   SpdyFramer send_framer(spdy_version_);
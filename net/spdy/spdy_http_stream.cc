@@ -317,7 +317,7 @@ int SpdyHttpStream::OnSendBodyComplete(int status, bool* eof) {
     return OK;
 
   // Read the data from the request body stream.
-  const int bytes_read = request_body_stream_->Read(
+  const int bytes_read = request_body_stream_->ReadSync(
       raw_request_body_buf_, raw_request_body_buf_->size());
   if (request_body_stream_->is_chunked() && bytes_read == ERR_IO_PENDING)
     return ERR_IO_PENDING;
@@ -5,6 +5,7 @@
 #include "net/spdy/spdy_session.h"
 
 #include <map>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
@@ -302,6 +303,7 @@ NextProto g_default_protocol = kProtoUnknown;
 size_t g_init_max_concurrent_streams = 10;
 size_t g_max_concurrent_stream_limit = 256;
 bool g_enable_ping_based_connection_checking = true;
+bool g_enable_write_coalescing = true;
 
 }  // namespace
 
@@ -320,6 +322,11 @@ void SpdySession::set_enable_ping_based_connection_checking(bool enable) {
   g_enable_ping_based_connection_checking = enable;
 }
 
+// static
+void SpdySession::set_enable_write_coalescing(bool enable) {
+  g_enable_write_coalescing = enable;
+}
+
 // static
 void SpdySession::set_init_max_concurrent_streams(size_t value) {
   g_init_max_concurrent_streams =
@@ -333,6 +340,7 @@ void SpdySession::ResetStaticSettingsToInit() {
   g_init_max_concurrent_streams = 10;
   g_max_concurrent_stream_limit = 256;
   g_enable_ping_based_connection_checking = true;
+  g_enable_write_coalescing = true;
 }
 
 SpdySession::SpdySession(const HostPortProxyPair& host_port_proxy_pair,
@@ -349,7 +357,9 @@ SpdySession::SpdySession(const HostPortProxyPair& host_port_proxy_pair,
       read_buffer_(new IOBuffer(kReadBufferSize)),
       read_pending_(false),
       stream_hi_water_mark_(1),  // Always start at 1 for the first stream id.
+      write_queue_(kMaxSpdyFrameChunkSize + SpdyFrame::kHeaderSize),
       write_pending_(false),
+      in_flight_frame_bytes_written_(0),
       delayed_write_pending_(false),
       is_secure_(false),
       certificate_error_code_(OK),
@@ -369,6 +379,7 @@ SpdySession::SpdySession(const HostPortProxyPair& host_port_proxy_pair,
       received_data_time_(base::TimeTicks::Now()),
       trailing_ping_pending_(false),
       check_ping_status_pending_(false),
+      draining_(false),
       need_to_send_ping_(false),
       flow_control_(false),
       initial_send_window_size_(kSpdyStreamInitialWindowSize),
@@ -395,6 +406,13 @@ SpdySession::PendingCreateStream::~PendingCreateStream() {}
 
 SpdySession::CallbackResultPair::~CallbackResultPair() {}
 
+SpdySession::InFlightFrame::InFlightFrame(SpdyStream* stream, int size)
+    : stream(stream),
+      size(size) {
+}
+
+SpdySession::InFlightFrame::~InFlightFrame() {}
+
 SpdySession::~SpdySession() {
   if (state_ != CLOSED) {
     state_ = CLOSED;
@@ -908,40 +926,43 @@ void SpdySession::OnReadComplete(int bytes_read) {
 
 void SpdySession::OnWriteComplete(int result) {
   DCHECK(write_pending_);
-  DCHECK(in_flight_write_.size());
+  DCHECK(in_flight_write_);
 
   write_pending_ = false;
 
-  scoped_refptr<SpdyStream> stream = in_flight_write_.stream();
-
   if (result >= 0) {
     // It should not be possible to have written more bytes than our
     // in_flight_write_.
-    DCHECK_LE(result, in_flight_write_.buffer()->BytesRemaining());
+    DCHECK_LE(result, in_flight_write_->BytesRemaining());
+
+    in_flight_write_->DidConsume(result);
+    in_flight_frame_bytes_written_ += result;
 
-    in_flight_write_.buffer()->DidConsume(result);
+    // We only notify a stream when we've fully written its frame.
+    while (!in_flight_frames_.empty() &&
+           in_flight_frame_bytes_written_ >= in_flight_frames_.front().size) {
+      InFlightFrame frame = in_flight_frames_.front();
+      in_flight_frames_.pop_front();
+      in_flight_frame_bytes_written_ -= frame.size;
 
-    // We only notify the stream when we've fully written the pending frame.
-    if (!in_flight_write_.buffer()->BytesRemaining()) {
-      if (stream) {
+      // It is possible that the stream was cancelled while we were writing
+      // to the socket.
+      if (frame.stream && !frame.stream->cancelled()) {
         // Report the number of bytes written to the caller, but exclude the
         // frame size overhead.  NOTE: if this frame was compressed the
         // reported bytes written is the compressed size, not the original
         // size.
-        if (result > 0) {
-          result = in_flight_write_.buffer()->size();
-          DCHECK_GE(result, static_cast<int>(SpdyFrame::kHeaderSize));
-          result -= static_cast<int>(SpdyFrame::kHeaderSize);
-        }
-
-        // It is possible that the stream was cancelled while we were writing
-        // to the socket.
-        if (!stream->cancelled())
-          stream->OnWriteComplete(result);
+        DCHECK_GE(frame.size, static_cast<int>(SpdyFrame::kHeaderSize));
+        frame.stream->OnWriteComplete(
+            frame.size - static_cast<int>(SpdyFrame::kHeaderSize));
       }
+    }
 
-      // Cleanup the write which just completed.
-      in_flight_write_.release();
+    // Cleanup the write which just completed.
+    if (!in_flight_write_->BytesRemaining()) {
+      DCHECK(in_flight_frames_.empty());
+      in_flight_write_ = NULL;
+      in_flight_frame_bytes_written_ = 0;
     }
 
     // Write more data.  We're already in a continuation, so we can
@@ -949,7 +970,9 @@ void SpdySession::OnWriteComplete(int result) {
     // message loop).
     WriteSocketLater();
   } else {
-    in_flight_write_.release();
+    in_flight_write_ = NULL;
+    in_flight_frames_.clear();
+    in_flight_frame_bytes_written_ = 0;
 
     // The stream is now errored.  Close it down.
     CloseSessionOnError(
@@ -1025,52 +1048,18 @@ void SpdySession::WriteSocket() {
   // Loop sending frames until we've sent everything or until the write
   // returns error (or ERR_IO_PENDING).
   DCHECK(buffered_spdy_framer_.get());
-  while (in_flight_write_.buffer() || !queue_.empty()) {
-    if (!in_flight_write_.buffer()) {
-      // Grab the next SpdyFrame to send.
-      SpdyIOBuffer next_buffer = queue_.top();
-      queue_.pop();
-
-      // We've deferred compression until just before we write it to the socket,
-      // which is now.  At this time, we don't compress our data frames.
-      SpdyFrame uncompressed_frame(next_buffer.buffer()->data(), false);
-      size_t size;
-      if (buffered_spdy_framer_->IsCompressible(uncompressed_frame)) {
-        DCHECK(uncompressed_frame.is_control_frame());
-        scoped_ptr<SpdyFrame> compressed_frame(
-            buffered_spdy_framer_->CompressControlFrame(
-                reinterpret_cast<const SpdyControlFrame&>(uncompressed_frame)));
-        if (!compressed_frame.get()) {
-          RecordProtocolErrorHistogram(
-              PROTOCOL_ERROR_SPDY_COMPRESSION_FAILURE);
-          CloseSessionOnError(
-              net::ERR_SPDY_PROTOCOL_ERROR, true, "SPDY Compression failure.");
-          return;
-        }
-
-        size = compressed_frame->length() + SpdyFrame::kHeaderSize;
-
-        DCHECK_GT(size, 0u);
-
-        // TODO(mbelshe): We have too much copying of data here.
-        IOBufferWithSize* buffer = new IOBufferWithSize(size);
-        memcpy(buffer->data(), compressed_frame->data(), size);
-
-        // Attempt to send the frame.
-        in_flight_write_ = SpdyIOBuffer(buffer, size, HIGHEST,
-                                        next_buffer.stream());
-      } else {
-        size = uncompressed_frame.length() + SpdyFrame::kHeaderSize;
-        in_flight_write_ = next_buffer;
-      }
+  while (in_flight_write_ || !write_queue_.empty()) {
+    if (!in_flight_write_) {
+      if (!PrepareNextWrite())
+        return;
     } else {
-      DCHECK(in_flight_write_.buffer()->BytesRemaining());
+      DCHECK(in_flight_write_->BytesRemaining());
     }
 
     write_pending_ = true;
     int rv = connection_->socket()->Write(
-        in_flight_write_.buffer(),
-        in_flight_write_.buffer()->BytesRemaining(),
+        in_flight_write_,
+        in_flight_write_->BytesRemaining(),
         base::Bind(&SpdySession::OnWriteComplete, base::Unretained(this)));
     if (rv == net::ERR_IO_PENDING)
       break;
@@ -1085,6 +1074,72 @@ void SpdySession::WriteSocket() {
   }
 }
 
+bool SpdySession::PrepareNextWrite() {
+  DCHECK(!in_flight_write_);
+  DCHECK(in_flight_frames_.empty());
+
+  std::vector<scoped_refptr<IOBuffer> > buffers;
+  int total_size = 0;
+  SpdyIOBuffer next_buffer;
+  while (write_queue_.Pop(&next_buffer)) {
+    // We've deferred compression until just before we write it to the socket,
+    // which is now.  At this time, we don't compress our data frames.
+    SpdyFrame uncompressed_frame(next_buffer.buffer()->data(), false);
+    scoped_refptr<IOBuffer> buffer = next_buffer.buffer();
+    int size;
+    if (buffered_spdy_framer_->IsCompressible(uncompressed_frame)) {
+      DCHECK(uncompressed_frame.is_control_frame());
+      scoped_ptr<SpdyFrame> compressed_frame(
+          buffered_spdy_framer_->CompressControlFrame(
+              reinterpret_cast<const SpdyControlFrame&>(uncompressed_frame)));
+      if (!compressed_frame.get()) {
+        RecordProtocolErrorHistogram(
+            PROTOCOL_ERROR_SPDY_COMPRESSION_FAILURE);
+        in_flight_frames_.clear();
+        CloseSessionOnError(
+            net::ERR_SPDY_PROTOCOL_ERROR, true, "SPDY Compression failure.");
+        return false;
+      }
+
+      size = compressed_frame->length() + SpdyFrame::kHeaderSize;
+
+      DCHECK_GT(size, 0);
+
+      // TODO(mbelshe): We have too much copying of data here.
+      buffer = new IOBuffer(size);
+      memcpy(buffer->data(), compressed_frame->data(), size);
+    } else {
+      size = uncompressed_frame.length() + SpdyFrame::kHeaderSize;
+    }
+
+    buffers.push_back(buffer);
+    in_flight_frames_.push_back(
+        InFlightFrame(next_buffer.stream().get(), size));
+    total_size += size;
+
+    // Keep the write small enough that frames queued while it is in flight,
+    // possibly at a higher priority, don't wait long.
+    if (!g_enable_write_coalescing || total_size >= kMaxSpdyCoalescedWriteSize)
+      break;
+  }
+  DCHECK(!buffers.empty());
+
+  if (buffers.size() == 1) {
+    in_flight_write_ = new DrainableIOBuffer(buffers[0], total_size);
+  } else {
+    scoped_refptr<IOBuffer> coalesced_buffer(new IOBuffer(total_size));
+    int offset = 0;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      memcpy(coalesced_buffer->data() + offset, buffers[i]->data(),
+             in_flight_frames_[i].size);
+      offset += in_flight_frames_[i].size;
+    }
+    in_flight_write_ = new DrainableIOBuffer(coalesced_buffer, total_size);
+  }
+  in_flight_frame_bytes_written_ = 0;
+  return true;
+}
+
 void SpdySession::CloseAllStreams(net::Error status) {
   base::StatsCounter abandoned_streams("spdy.abandoned_streams");
   base::StatsCounter abandoned_push_streams(
@@ -1117,8 +1172,7 @@ void SpdySession::CloseAllStreams(net::Error status) {
   }
 
   // We also need to drain the queue.
-  while (queue_.size())
-    queue_.pop();
+  write_queue_.Clear();
 }
 
 int SpdySession::GetNewStreamId() {
@@ -1135,7 +1189,7 @@ void SpdySession::QueueFrame(SpdyFrame* frame,
   int length = SpdyFrame::kHeaderSize + frame->length();
   IOBuffer* buffer = new IOBuffer(length);
   memcpy(buffer->data(), frame->data(), length);
-  queue_.push(SpdyIOBuffer(buffer, length, priority, stream));
+  write_queue_.Push(SpdyIOBuffer(buffer, length, priority, stream));
 
   WriteSocketLater();
 }
@@ -1264,6 +1318,16 @@ void SpdySession::DeleteStream(SpdyStreamId id, int status) {
   if (stream)
     stream->OnClose(status);
   ProcessPendingCreateStreams();
+
+  if (draining_ && active_streams_.empty() && !IsClosed())
+    CloseSessionOnError(net::ERR_ABORTED, false, "Drained.");
+}
+
+void SpdySession::Drain() {
+  DCHECK(!spdy_session_pool_);
+  draining_ = true;
+  if (active_streams_.empty() && !IsClosed())
+    CloseSessionOnError(net::ERR_ABORTED, false, "Drained.");
 }
 
 void SpdySession::RemoveFromPool() {
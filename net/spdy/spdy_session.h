@@ -7,6 +7,7 @@
 #pragma once
 
 #include <algorithm>
+#include <deque>
 #include <list>
 #include <map>
 #include <queue>
@@ -31,6 +32,7 @@
 #include "net/spdy/spdy_io_buffer.h"
 #include "net/spdy/spdy_protocol.h"
 #include "net/spdy/spdy_session_pool.h"
+#include "net/spdy/spdy_write_queue.h"
 
 namespace base {
 class Value;
@@ -45,6 +47,10 @@ namespace net {
 const int kMss = 1430;
 const int kMaxSpdyFrameChunkSize = (2 * kMss) - SpdyFrame::kHeaderSize;
 
+// When write coalescing is enabled, queued frames are gathered into a single
+// socket write until it holds at least this many bytes.
+const int kMaxSpdyCoalescedWriteSize = 16 * 1024;
+
 class BoundNetLog;
 class SpdyStream;
 class SSLInfo;
@@ -228,6 +234,9 @@ class NET_EXPORT SpdySession : public base::RefCounted<SpdySession>,
   // Enable sending of PING frame with each request.
   static void set_enable_ping_based_connection_checking(bool enable);
 
+  // Enable writing several queued frames with a single socket write.
+  static void set_enable_write_coalescing(bool enable);
+
   // The initial max concurrent streams per session, can be overridden by the
   // server via SETTINGS.
   static void set_init_max_concurrent_streams(size_t value);
@@ -239,6 +248,11 @@ class NET_EXPORT SpdySession : public base::RefCounted<SpdySession>,
   // If session is closed, no new streams/transactions should be created.
   bool IsClosed() const { return state_ == CLOSED; }
 
+  // Called after the session has been taken out of its pool, so that no new
+  // streams will be created on it. Lets the active streams finish and closes
+  // the session once the last one is done.
+  void Drain();
+
   // Closes this session.  This will close all active streams and mark
   // the session as permanently closed.
   // |err| should not be OK; this function is intended to be called on
@@ -354,7 +368,16 @@ class NET_EXPORT SpdySession : public base::RefCounted<SpdySession>,
   typedef std::map<int, scoped_refptr<SpdyStream> > ActiveStreamMap;
   // Only HTTP push a stream.
   typedef std::map<std::string, scoped_refptr<SpdyStream> > PushedStreamMap;
-  typedef std::priority_queue<SpdyIOBuffer> OutputQueue;
+
+  // A frame that is part of the write in progress.
+  struct InFlightFrame {
+    InFlightFrame(SpdyStream* stream, int size);
+    ~InFlightFrame();
+
+    // The stream that wrote the frame, or NULL.
+    scoped_refptr<SpdyStream> stream;
+    int size;
+  };
 
   struct CallbackResultPair {
     CallbackResultPair(const CompletionCallback& callback_in, int result_in)
@@ -431,6 +454,10 @@ class NET_EXPORT SpdySession : public base::RefCounted<SpdySession>,
   void WriteSocketLater();
   void WriteSocket();
 
+  // Takes the next frames to write off |write_queue_| and puts them in
+  // |in_flight_write_|. Returns false if the session was closed.
+  bool PrepareNextWrite();
+
   // Get a new stream id.
   int GetNewStreamId();
 
@@ -573,12 +600,17 @@ class NET_EXPORT SpdySession : public base::RefCounted<SpdySession>,
   // server, but do not have consumers yet.
   PushedStreamMap unclaimed_pushed_streams_;
 
-  // As we gather data to be sent, we put it into the output queue.
-  OutputQueue queue_;
+  // As we gather data to be sent, we put it into the write queue.
+  SpdyWriteQueue write_queue_;
 
   // The packet we are currently sending.
-  bool write_pending_;            // Will be true when a write is in progress.
-  SpdyIOBuffer in_flight_write_;  // This is the write buffer in progress.
+  bool write_pending_;  // Will be true when a write is in progress.
+  // This is the write buffer in progress. It holds the frames in
+  // |in_flight_frames_|, in order.
+  scoped_refptr<DrainableIOBuffer> in_flight_write_;
+  std::deque<InFlightFrame> in_flight_frames_;
+  // The number of bytes of the first of |in_flight_frames_| already written.
+  int in_flight_frame_bytes_written_;
 
   // Flag if we have a pending message scheduled for WriteSocket.
   bool delayed_write_pending_;
@@ -632,6 +664,9 @@ class NET_EXPORT SpdySession : public base::RefCounted<SpdySession>,
   // status.
   bool check_ping_status_pending_;
 
+  // True once Drain() has been called.
+  bool draining_;
+
   // Indicate if we need to send a ping (generally, a trailing ping). This helps
   // us to decide if we need yet another trailing ping, or if it would be a
   // waste of effort (and MUST not be done).
@@ -4,6 +4,8 @@
 
 #include "net/spdy/spdy_session_pool.h"
 
+#include <vector>
+
 #include "base/logging.h"
 #include "base/metrics/histogram.h"
 #include "base/values.h"
@@ -39,6 +41,7 @@ static const size_t kMaxSessionsPerDomain = 1;
 size_t SpdySessionPool::g_max_sessions_per_domain = kMaxSessionsPerDomain;
 bool SpdySessionPool::g_force_single_domain = false;
 bool SpdySessionPool::g_enable_ip_pooling = true;
+bool SpdySessionPool::g_drain_sessions_on_ip_address_change = false;
 
 SpdySessionPool::SpdySessionPool(
     HostResolver* resolver,
@@ -240,7 +243,10 @@ Value* SpdySessionPool::SpdySessionPoolInfoToValue() const {
 }
 
 void SpdySessionPool::OnIPAddressChanged() {
-  CloseCurrentSessions();
+  if (g_drain_sessions_on_ip_address_change)
+    DrainCurrentSessions();
+  else
+    CloseCurrentSessions();
   http_server_properties_->ClearSpdySettings();
 }
 
@@ -418,6 +424,28 @@ void SpdySessionPool::CloseAllSessions() {
   }
 }
 
+void SpdySessionPool::DrainCurrentSessions() {
+  SpdySessionsMap old_map;
+  old_map.swap(sessions_);
+
+  std::vector<scoped_refptr<SpdySession> > sessions;
+  while (!old_map.empty()) {
+    SpdySessionList* list = old_map.begin()->second;
+    CHECK(list);
+    for (SpdySessionList::const_iterator it = list->begin();
+         it != list->end(); ++it) {
+      (*it)->set_spdy_session_pool(NULL);
+      sessions.push_back(*it);
+    }
+    delete list;
+    RemoveAliases(old_map.begin()->first);
+    old_map.erase(old_map.begin());
+  }
+
+  for (size_t i = 0; i < sessions.size(); ++i)
+    sessions[i]->Drain();
+}
+
 void SpdySessionPool::CloseCurrentSessions() {
   SpdySessionsMap old_map;
   old_map.swap(sessions_);
@@ -103,6 +103,10 @@ class NET_EXPORT SpdySessionPool
   void CloseCurrentSessions();
   // Close only the idle SpdySessions.
   void CloseIdleSessions();
+  // Take the currently existing SpdySessions out of the pool so that new
+  // streams go to new sessions, and let each one close once its active streams
+  // complete.
+  void DrainCurrentSessions();
 
   // Removes a SpdySession from the SpdySessionPool. This should only be called
   // by SpdySession, because otherwise session->state_ is not set to CLOSED.
@@ -120,7 +124,8 @@ class NET_EXPORT SpdySessionPool
 
   // We flush all idle sessions and release references to the active ones so
   // they won't get re-used.  The active ones will either complete successfully
-  // or error out due to the IP address change.
+  // or error out due to the IP address change. Unless draining is enabled, the
+  // streams on the active sessions are aborted.
   virtual void OnIPAddressChanged() OVERRIDE;
 
   // SSLConfigService::Observer methods:
@@ -135,6 +140,12 @@ class NET_EXPORT SpdySessionPool
   // which share IP address resolutions.
   static void enable_ip_pooling(bool value) { g_enable_ip_pooling = value; }
 
+  // Controls whether an IP address change drains the current sessions
+  // instead of closing them.
+  static void set_drain_sessions_on_ip_address_change(bool value) {
+    g_drain_sessions_on_ip_address_change = value;
+  }
+
   // CertDatabase::Observer methods:
   virtual void OnUserCertAdded(const X509Certificate* cert) OVERRIDE;
   virtual void OnCertTrustChanged(const X509Certificate* cert) OVERRIDE;
@@ -202,6 +213,7 @@ class NET_EXPORT SpdySessionPool
   static size_t g_max_sessions_per_domain;
   static bool g_force_single_domain;
   static bool g_enable_ip_pooling;
+  static bool g_drain_sessions_on_ip_address_change;
 
   const scoped_refptr<SSLConfigService> ssl_config_service_;
   HostResolver* const resolver_;
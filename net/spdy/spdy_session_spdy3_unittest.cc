@@ -1199,4 +1199,66 @@ TEST_F(SpdySessionSpdy3Test, UpdateStreamsSendWindowSize) {
   spdy_stream2 = NULL;
 }
 
+// Frames queued together go out in a single socket write when coalescing is
+// enabled.
+TEST_F(SpdySessionSpdy3Test, CoalesceWrites) {
+  SpdySession::set_enable_write_coalescing(true);
+
+  SpdySessionDependencies session_deps;
+  session_deps.host_resolver->set_synchronous_mode(true);
+
+  MockConnect connect_data(SYNCHRONOUS, OK);
+  MockRead reads[] = {
+    MockRead(SYNCHRONOUS, ERR_IO_PENDING)  // Stall forever.
+  };
+
+  scoped_ptr<SpdyFrame> rst1(ConstructSpdyRstStream(1, CANCEL));
+  scoped_ptr<SpdyFrame> rst2(ConstructSpdyRstStream(3, CANCEL));
+  const SpdyFrame* frames[] = { rst1.get(), rst2.get() };
+  char combined[100];
+  int combined_size =
+      CombineFrames(frames, arraysize(frames), combined, sizeof(combined));
+  MockWrite writes[] = {
+    MockWrite(SYNCHRONOUS, combined, combined_size),
+  };
+
+  StaticSocketDataProvider data(
+      reads, arraysize(reads), writes, arraysize(writes));
+  data.set_connect_data(connect_data);
+  session_deps.socket_factory->AddSocketDataProvider(&data);
+
+  SSLSocketDataProvider ssl(SYNCHRONOUS, OK);
+  session_deps.socket_factory->AddSSLSocketDataProvider(&ssl);
+
+  scoped_refptr<HttpNetworkSession> http_session(
+      SpdySessionDependencies::SpdyCreateSession(&session_deps));
+
+  const std::string kTestHost("www.foo.com");
+  const int kTestPort = 80;
+  HostPortPair test_host_port_pair(kTestHost, kTestPort);
+  HostPortProxyPair pair(test_host_port_pair, ProxyServer::Direct());
+
+  SpdySessionPool* spdy_session_pool(http_session->spdy_session_pool());
+  scoped_refptr<SpdySession> session =
+      spdy_session_pool->Get(pair, BoundNetLog());
+
+  scoped_refptr<TransportSocketParams> transport_params(
+      new TransportSocketParams(test_host_port_pair,
+                                MEDIUM,
+                                false,
+                                false));
+  scoped_ptr<ClientSocketHandle> connection(new ClientSocketHandle);
+  EXPECT_EQ(OK, connection->Init(test_host_port_pair.ToString(),
+                                 transport_params, MEDIUM, CompletionCallback(),
+                                 http_session->GetTransportSocketPool(
+                                     HttpNetworkSession::NORMAL_SOCKET_POOL),
+                                 BoundNetLog()));
+  EXPECT_EQ(OK, session->InitializeWithSocket(connection.release(), false, OK));
+
+  session->ResetStream(1, CANCEL, "");
+  session->ResetStream(3, CANCEL, "");
+  MessageLoop::current()->RunAllPending();
+  EXPECT_TRUE(data.at_write_eof());
+}
+
 }  // namespace net
@@ -1007,6 +1007,8 @@ const SpdyHeaderInfo MakeSpdyHeader(SpdyControlType type) {
 SpdyTestStateHelper::SpdyTestStateHelper() {
   // Pings can be non-deterministic, because they are sent via timer.
   SpdySession::set_enable_ping_based_connection_checking(false);
+  // Coalesced frames would not line up with the MockWrites tests expect.
+  SpdySession::set_enable_write_coalescing(false);
   // Compression is per-session which makes it impossible to create
   // SPDY frames with static methods.
   BufferedSpdyFramer::set_enable_compression_default(false);
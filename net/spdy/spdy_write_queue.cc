@@ -0,0 +1,106 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/spdy_write_queue.h"
+
+#include "base/logging.h"
+#include "net/spdy/spdy_stream.h"
+
+namespace net {
+
+SpdyWriteQueue::StreamFrames::StreamFrames(SpdyStream* stream)
+    : stream(stream),
+      deficit(0) {
+}
+
+SpdyWriteQueue::StreamFrames::~StreamFrames() {}
+
+SpdyWriteQueue::SpdyWriteQueue(int quantum)
+    : quantum_(quantum),
+      size_(0) {
+  DCHECK_GT(quantum_, 0);
+}
+
+SpdyWriteQueue::~SpdyWriteQueue() {}
+
+void SpdyWriteQueue::Push(const SpdyIOBuffer& buffer) {
+  DCHECK_GE(buffer.priority(), MINIMUM_PRIORITY);
+  DCHECK_LT(buffer.priority(), NUM_PRIORITIES);
+  ++size_;
+
+  SpdyStream* stream = buffer.stream().get();
+  if (!stream) {
+    session_frames_[buffer.priority()].push_back(buffer);
+    return;
+  }
+
+  StreamList& streams = streams_[buffer.priority()];
+  for (StreamList::iterator it = streams.begin(); it != streams.end(); ++it) {
+    if (it->stream == stream) {
+      it->frames.push_back(buffer);
+      return;
+    }
+  }
+
+  streams.push_back(StreamFrames(stream));
+  streams.back().frames.push_back(buffer);
+  // A stream that is alone at its priority starts its turn right away.
+  if (streams.size() == 1)
+    streams.front().deficit = quantum_;
+}
+
+bool SpdyWriteQueue::Pop(SpdyIOBuffer* buffer) {
+  for (int priority = NUM_PRIORITIES - 1; priority >= MINIMUM_PRIORITY;
+       --priority) {
+    std::deque<SpdyIOBuffer>& session_frames = session_frames_[priority];
+    if (!session_frames.empty()) {
+      *buffer = session_frames.front();
+      session_frames.pop_front();
+      --size_;
+      return true;
+    }
+
+    StreamList& streams = streams_[priority];
+    if (streams.empty())
+      continue;
+
+    // Streams whose next frame doesn't fit in what is left of their turn
+    // carry the remainder over to their next turn, so this terminates.
+    while (static_cast<int>(streams.front().frames.front().size()) >
+           streams.front().deficit) {
+      StartNextTurn(&streams);
+    }
+
+    StreamFrames& current = streams.front();
+    *buffer = current.frames.front();
+    current.frames.pop_front();
+    current.deficit -= buffer->size();
+    if (current.frames.empty()) {
+      streams.pop_front();
+      if (!streams.empty())
+        streams.front().deficit += quantum_;
+    }
+    --size_;
+    return true;
+  }
+  DCHECK_EQ(0u, size_);
+  return false;
+}
+
+void SpdyWriteQueue::Clear() {
+  for (int i = 0; i < NUM_PRIORITIES; ++i) {
+    session_frames_[i].clear();
+    streams_[i].clear();
+  }
+  size_ = 0;
+}
+
+void SpdyWriteQueue::StartNextTurn(StreamList* streams) {
+  DCHECK(!streams->empty());
+  if (streams->size() > 1)
+    streams->splice(streams->end(), *streams, streams->begin());
+  streams->front().deficit += quantum_;
+}
+
+}  // namespace net
@@ -0,0 +1,82 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_SPDY_WRITE_QUEUE_H_
+#define NET_SPDY_SPDY_WRITE_QUEUE_H_
+#pragma once
+
+#include <deque>
+#include <list>
+
+#include "base/basictypes.h"
+#include "net/base/net_export.h"
+#include "net/base/request_priority.h"
+#include "net/spdy/spdy_io_buffer.h"
+
+namespace net {
+
+class SpdyStream;
+
+// The frames a SpdySession has yet to write.
+//
+// Frames are dequeued strictly by priority. Within a priority, the streams
+// with pending frames take turns using deficit round robin: each turn a
+// stream may write up to |quantum| bytes, and a frame larger than that waits
+// until the stream has saved up enough turns. Frames that don't belong to a
+// stream (SETTINGS, PING, RST_STREAM, ...) go ahead of the streams at their
+// priority. Frames of a single stream are always written in the order they
+// were queued.
+class NET_EXPORT_PRIVATE SpdyWriteQueue {
+ public:
+  explicit SpdyWriteQueue(int quantum);
+  ~SpdyWriteQueue();
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // Queues |buffer| at its priority.
+  void Push(const SpdyIOBuffer& buffer);
+
+  // Removes the next frame to write and stores it in |buffer|. Returns false
+  // if the queue is empty.
+  bool Pop(SpdyIOBuffer* buffer);
+
+  // Drops every queued frame.
+  void Clear();
+
+ private:
+  // The queued frames of one stream.
+  struct StreamFrames {
+    explicit StreamFrames(SpdyStream* stream);
+    ~StreamFrames();
+
+    SpdyStream* stream;
+    std::deque<SpdyIOBuffer> frames;
+    // Bytes the stream may still write before its turn ends.
+    int deficit;
+  };
+
+  // The streams with queued frames at one priority, in turn order. The front
+  // stream is the one whose turn it is.
+  typedef std::list<StreamFrames> StreamList;
+
+  // Ends the turn of the front stream of |streams| and starts the next one.
+  void StartNextTurn(StreamList* streams);
+
+  const int quantum_;
+
+  // Frames that don't belong to a stream, by priority.
+  std::deque<SpdyIOBuffer> session_frames_[NUM_PRIORITIES];
+
+  // Streams with queued frames, by priority.
+  StreamList streams_[NUM_PRIORITIES];
+
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpdyWriteQueue);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_SPDY_WRITE_QUEUE_H_
@@ -0,0 +1,89 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/perftimer.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_log.h"
+#include "net/spdy/spdy_session.h"
+#include "net/spdy/spdy_stream.h"
+#include "net/spdy/spdy_write_queue.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kNumStreams = 100;
+const int kFramesPerStream = 100;
+const int kFrameSize = kMaxSpdyFrameChunkSize + SpdyFrame::kHeaderSize;
+
+class SpdyWriteQueuePerfTest : public testing::Test {
+ protected:
+  SpdyWriteQueuePerfTest()
+      : queue_(kFrameSize),
+        buffer_(new IOBuffer(kFrameSize)) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      streams_.push_back(
+          new SpdyStream(NULL, 2 * i + 1, false, BoundNetLog()));
+    }
+  }
+
+  // Queues |kFramesPerStream| full DATA frames for each of the streams.
+  void QueueBulkData(RequestPriority priority) {
+    for (int i = 0; i < kFramesPerStream; ++i) {
+      for (size_t j = 0; j < streams_.size(); ++j) {
+        queue_.Push(
+            SpdyIOBuffer(buffer_, kFrameSize, priority, streams_[j]));
+      }
+    }
+  }
+
+  SpdyWriteQueue queue_;
+  scoped_refptr<IOBuffer> buffer_;
+  std::vector<scoped_refptr<SpdyStream> > streams_;
+};
+
+}  // namespace
+
+TEST_F(SpdyWriteQueuePerfTest, PushPop) {
+  PerfTimeLogger timer("Spdy_write_queue_push_pop");
+  QueueBulkData(LOW);
+  SpdyIOBuffer buffer;
+  int frames = 0;
+  while (queue_.Pop(&buffer))
+    ++frames;
+  timer.Done();
+  EXPECT_EQ(kNumStreams * kFramesPerStream, frames);
+}
+
+// Measures how many bytes go out ahead of a HIGHEST frame that is queued
+// while a session is busy sending bulk data at a lower priority.
+TEST_F(SpdyWriteQueuePerfTest, HighPriorityUnderLoad) {
+  scoped_refptr<SpdyStream> urgent(
+      new SpdyStream(NULL, 2 * kNumStreams + 1, false, BoundNetLog()));
+  QueueBulkData(LOW);
+
+  SpdyIOBuffer buffer;
+  int bytes_before_urgent = 0;
+  // Drain half the bulk data before the urgent request shows up.
+  for (int i = 0; i < kNumStreams * kFramesPerStream / 2; ++i) {
+    ASSERT_TRUE(queue_.Pop(&buffer));
+  }
+  queue_.Push(SpdyIOBuffer(buffer_, 100, HIGHEST, urgent));
+  PerfTimeLogger timer("Spdy_write_queue_high_priority_under_load");
+  while (queue_.Pop(&buffer)) {
+    if (buffer.stream() == urgent)
+      break;
+    bytes_before_urgent += buffer.size();
+  }
+  timer.Done();
+  LogPerfResult("Spdy_write_queue_bytes_before_high_priority",
+                bytes_before_urgent, "bytes");
+  EXPECT_EQ(0, bytes_before_urgent);
+}
+
+}  // namespace net
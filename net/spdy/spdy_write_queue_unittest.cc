@@ -0,0 +1,155 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/spdy_write_queue.h"
+
+#include "base/memory/ref_counted.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_log.h"
+#include "net/spdy/spdy_stream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kQuantum = 100;
+
+SpdyIOBuffer MakeBuffer(int size, RequestPriority priority,
+                        SpdyStream* stream) {
+  return SpdyIOBuffer(new IOBuffer(size), size, priority, stream);
+}
+
+// Pops the next buffer off |queue| and returns its stream and size.
+void PopNext(SpdyWriteQueue* queue, SpdyStream** stream, int* size) {
+  SpdyIOBuffer buffer;
+  ASSERT_TRUE(queue->Pop(&buffer));
+  *stream = buffer.stream().get();
+  *size = static_cast<int>(buffer.size());
+}
+
+class SpdyWriteQueueTest : public testing::Test {
+ protected:
+  SpdyWriteQueueTest()
+      : queue_(kQuantum),
+        stream1_(new SpdyStream(NULL, 1, false, BoundNetLog())),
+        stream2_(new SpdyStream(NULL, 3, false, BoundNetLog())) {
+  }
+
+  SpdyWriteQueue queue_;
+  scoped_refptr<SpdyStream> stream1_;
+  scoped_refptr<SpdyStream> stream2_;
+};
+
+}  // namespace
+
+TEST_F(SpdyWriteQueueTest, Empty) {
+  EXPECT_TRUE(queue_.empty());
+  SpdyIOBuffer buffer;
+  EXPECT_FALSE(queue_.Pop(&buffer));
+}
+
+TEST_F(SpdyWriteQueueTest, HigherPriorityFirst) {
+  queue_.Push(MakeBuffer(10, LOW, stream1_));
+  queue_.Push(MakeBuffer(20, MEDIUM, NULL));
+  queue_.Push(MakeBuffer(30, HIGHEST, stream2_));
+  EXPECT_EQ(3u, queue_.size());
+
+  SpdyStream* stream = NULL;
+  int size = 0;
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream2_.get(), stream);
+  EXPECT_EQ(30, size);
+  PopNext(&queue_, &stream, &size);
+  EXPECT_TRUE(stream == NULL);
+  EXPECT_EQ(20, size);
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream1_.get(), stream);
+  EXPECT_EQ(10, size);
+  EXPECT_TRUE(queue_.empty());
+}
+
+TEST_F(SpdyWriteQueueTest, SessionFramesGoFirst) {
+  queue_.Push(MakeBuffer(10, MEDIUM, stream1_));
+  queue_.Push(MakeBuffer(20, MEDIUM, NULL));
+
+  SpdyStream* stream = NULL;
+  int size = 0;
+  PopNext(&queue_, &stream, &size);
+  EXPECT_TRUE(stream == NULL);
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream1_.get(), stream);
+}
+
+// A stream with a lot of data doesn't hold back another stream at the same
+// priority.
+TEST_F(SpdyWriteQueueTest, StreamsTakeTurns) {
+  for (int i = 0; i < 3; ++i)
+    queue_.Push(MakeBuffer(kQuantum, LOW, stream1_));
+  queue_.Push(MakeBuffer(10, LOW, stream2_));
+
+  SpdyStream* stream = NULL;
+  int size = 0;
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream1_.get(), stream);
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream2_.get(), stream);
+  EXPECT_EQ(10, size);
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream1_.get(), stream);
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream1_.get(), stream);
+  EXPECT_TRUE(queue_.empty());
+}
+
+// A stream writes as many frames as fit in its quantum before its turn ends.
+TEST_F(SpdyWriteQueueTest, SmallFramesShareATurn) {
+  for (int i = 0; i < 3; ++i)
+    queue_.Push(MakeBuffer(kQuantum / 2, LOW, stream1_));
+  queue_.Push(MakeBuffer(kQuantum / 2, LOW, stream2_));
+
+  SpdyStream* expected[] = {
+    stream1_.get(), stream1_.get(), stream2_.get(), stream1_.get()
+  };
+  for (size_t i = 0; i < arraysize(expected); ++i) {
+    SpdyStream* stream = NULL;
+    int size = 0;
+    PopNext(&queue_, &stream, &size);
+    EXPECT_EQ(expected[i], stream) << i;
+  }
+  EXPECT_TRUE(queue_.empty());
+}
+
+// A frame larger than the quantum is written once its stream has saved up
+// enough turns, and frames of one stream stay in order.
+TEST_F(SpdyWriteQueueTest, LargeFrame) {
+  queue_.Push(MakeBuffer(3 * kQuantum, LOW, stream1_));
+  queue_.Push(MakeBuffer(1, LOW, stream1_));
+  queue_.Push(MakeBuffer(kQuantum, LOW, stream2_));
+  queue_.Push(MakeBuffer(kQuantum, LOW, stream2_));
+
+  SpdyStream* stream = NULL;
+  int size = 0;
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream2_.get(), stream);
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream2_.get(), stream);
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream1_.get(), stream);
+  EXPECT_EQ(3 * kQuantum, size);
+  PopNext(&queue_, &stream, &size);
+  EXPECT_EQ(stream1_.get(), stream);
+  EXPECT_EQ(1, size);
+}
+
+TEST_F(SpdyWriteQueueTest, Clear) {
+  queue_.Push(MakeBuffer(10, LOW, stream1_));
+  queue_.Push(MakeBuffer(10, HIGHEST, NULL));
+  queue_.Clear();
+  EXPECT_TRUE(queue_.empty());
+  SpdyIOBuffer buffer;
+  EXPECT_FALSE(queue_.Pop(&buffer));
+}
+
+}  // namespace net
@@ -55,6 +55,24 @@ class NET_EXPORT DatagramServerSocket : public DatagramSocket {
                      const IPEndPoint& address,
                      const CompletionCallback& callback) = 0;
 
+  // Like RecvFrom(), but reads up to |count| datagrams at once, using a single
+  // system call where the platform allows it.
+  // |buf| is divided into |count| slots of |buf_len| bytes each.  The i-th
+  //   datagram is read into the i-th slot.
+  // |sizes| and |addresses| are arrays of |count| elements that receive the
+  //   size and the sender address of each datagram.
+  // Returns the number of datagrams read, a net error code, or ERR_IO_PENDING
+  // if the IO is in progress, in which case the callback is run with the
+  // number of datagrams read.  Fewer than |count| datagrams may be read even
+  // if more are queued.  If ERR_IO_PENDING is returned, the caller must keep
+  // |buf|, |sizes| and |addresses| alive until the callback is called.
+  virtual int RecvMultipleFrom(IOBuffer* buf,
+                               int buf_len,
+                               int count,
+                               int* sizes,
+                               IPEndPoint* addresses,
+                               const CompletionCallback& callback) = 0;
+
   // Set the receive buffer size (in bytes) for the socket.
   virtual bool SetReceiveBufferSize(int32 size) = 0;
 
@@ -37,6 +37,16 @@ int UDPServerSocket::SendTo(IOBuffer* buf,
   return socket_.SendTo(buf, buf_len, address, callback);
 }
 
+int UDPServerSocket::RecvMultipleFrom(IOBuffer* buf,
+                                      int buf_len,
+                                      int count,
+                                      int* sizes,
+                                      IPEndPoint* addresses,
+                                      const CompletionCallback& callback) {
+  return socket_.RecvMultipleFrom(buf, buf_len, count, sizes, addresses,
+                                  callback);
+}
+
 bool UDPServerSocket::SetReceiveBufferSize(int32 size) {
   return socket_.SetReceiveBufferSize(size);
 }
@@ -32,6 +32,12 @@ class NET_EXPORT UDPServerSocket : public DatagramServerSocket {
                      int buf_len,
                      const IPEndPoint& address,
                      const CompletionCallback& callback) OVERRIDE;
+  virtual int RecvMultipleFrom(IOBuffer* buf,
+                               int buf_len,
+                               int count,
+                               int* sizes,
+                               IPEndPoint* addresses,
+                               const CompletionCallback& callback) OVERRIDE;
   virtual bool SetReceiveBufferSize(int32 size) OVERRIDE;
   virtual bool SetSendBufferSize(int32 size) OVERRIDE;
   virtual void Close() OVERRIDE;
@@ -8,7 +8,13 @@
 #include <fcntl.h>
 #include <netdb.h>
 #include <sys/socket.h>
+#if defined(OS_LINUX)
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
 
+#include "base/atomicops.h"
 #include "base/eintr_wrapper.h"
 #include "base/logging.h"
 #include "base/message_loop.h"
@@ -30,6 +36,23 @@ static const int kBindRetries = 10;
 static const int kPortStart = 1024;
 static const int kPortEnd = 65535;
 
+#if defined(OS_LINUX) && defined(__NR_recvmmsg)
+#define USE_RECVMMSG
+
+// The most datagrams read by one recvmmsg() call.
+const int kMaxDatagramsPerRead = 16;
+
+// Same layout as struct mmsghdr, which older C libraries don't declare.
+// recvmmsg() is called through syscall() for the same reason.
+struct MultipleMessageHeader {
+  struct msghdr msg_hdr;
+  unsigned int msg_len;
+};
+
+// Set once the kernel is found not to implement recvmmsg().
+base::subtle::Atomic32 g_recvmmsg_unsupported = 0;
+#endif
+
 }  // namespace net
 
 namespace net {
@@ -46,6 +69,8 @@ UDPSocketLibevent::UDPSocketLibevent(
           write_watcher_(this),
           read_buf_len_(0),
           recv_from_address_(NULL),
+          read_count_(0),
+          read_sizes_(NULL),
           write_buf_len_(0),
           net_log_(BoundNetLog::Make(net_log, NetLog::SOURCE_UDP_SOCKET)) {
   scoped_refptr<NetLog::EventParameters> params;
@@ -72,6 +97,8 @@ void UDPSocketLibevent::Close() {
   read_buf_len_ = 0;
   read_callback_.Reset();
   recv_from_address_ = NULL;
+  read_count_ = 0;
+  read_sizes_ = NULL;
   write_buf_ = NULL;
   write_buf_len_ = 0;
   write_callback_.Reset();
@@ -169,6 +196,44 @@ int UDPSocketLibevent::RecvFrom(IOBuffer* buf,
   return ERR_IO_PENDING;
 }
 
+int UDPSocketLibevent::RecvMultipleFrom(IOBuffer* buf,
+                                        int buf_len,
+                                        int count,
+                                        int* sizes,
+                                        IPEndPoint* addresses,
+                                        const CompletionCallback& callback) {
+  DCHECK(CalledOnValidThread());
+  DCHECK_NE(kInvalidSocket, socket_);
+  DCHECK(read_callback_.is_null());
+  DCHECK(!recv_from_address_);
+  DCHECK(!callback.is_null());  // Synchronous operation not supported
+  DCHECK_GT(buf_len, 0);
+  DCHECK_GT(count, 0);
+  DCHECK(sizes);
+  DCHECK(addresses);
+
+  int result = InternalRecvMultipleFrom(buf, buf_len, count, sizes, addresses);
+  if (result != ERR_IO_PENDING)
+    return result;
+
+  if (!MessageLoopForIO::current()->WatchFileDescriptor(
+          socket_, true, MessageLoopForIO::WATCH_READ,
+          &read_socket_watcher_, &read_watcher_)) {
+    PLOG(ERROR) << "WatchFileDescriptor failed on read";
+    int result = MapSystemError(errno);
+    LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  read_buf_ = buf;
+  read_buf_len_ = buf_len;
+  recv_from_address_ = addresses;
+  read_count_ = count;
+  read_sizes_ = sizes;
+  read_callback_ = callback;
+  return ERR_IO_PENDING;
+}
+
 int UDPSocketLibevent::Write(IOBuffer* buf,
                              int buf_len,
                              const CompletionCallback& callback) {
@@ -304,11 +369,19 @@ void UDPSocketLibevent::DoWriteCallback(int rv) {
 }
 
 void UDPSocketLibevent::DidCompleteRead() {
-  int result = InternalRecvFrom(read_buf_, read_buf_len_, recv_from_address_);
+  int result;
+  if (read_count_) {
+    result = InternalRecvMultipleFrom(read_buf_, read_buf_len_, read_count_,
+                                      read_sizes_, recv_from_address_);
+  } else {
+    result = InternalRecvFrom(read_buf_, read_buf_len_, recv_from_address_);
+  }
   if (result != ERR_IO_PENDING) {
     read_buf_ = NULL;
     read_buf_len_ = 0;
     recv_from_address_ = NULL;
+    read_count_ = 0;
+    read_sizes_ = NULL;
     bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
     DCHECK(ok);
     DoReadCallback(result);
@@ -417,6 +490,70 @@ int UDPSocketLibevent::InternalRecvFrom(IOBuffer* buf, int buf_len,
   return result;
 }
 
+int UDPSocketLibevent::InternalRecvMultipleFrom(IOBuffer* buf, int buf_len,
+                                                int count, int* sizes,
+                                                IPEndPoint* addresses) {
+#if defined(USE_RECVMMSG)
+  if (!base::subtle::NoBarrier_Load(&g_recvmmsg_unsupported)) {
+    count = std::min(count, kMaxDatagramsPerRead);
+
+    struct sockaddr_storage addr_storage[kMaxDatagramsPerRead];
+    struct iovec iov[kMaxDatagramsPerRead];
+    MultipleMessageHeader headers[kMaxDatagramsPerRead];
+    memset(headers, 0, sizeof(headers[0]) * count);
+    for (int i = 0; i < count; ++i) {
+      iov[i].iov_base = buf->data() + i * buf_len;
+      iov[i].iov_len = buf_len;
+      headers[i].msg_hdr.msg_name = &addr_storage[i];
+      headers[i].msg_hdr.msg_namelen = sizeof(addr_storage[i]);
+      headers[i].msg_hdr.msg_iov = &iov[i];
+      headers[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int datagrams = HANDLE_EINTR(syscall(__NR_recvmmsg, socket_, headers,
+                                         count, 0, NULL));
+    if (datagrams >= 0) {
+      for (int i = 0; i < datagrams; ++i) {
+        const struct msghdr& header = headers[i].msg_hdr;
+        const struct sockaddr* addr =
+            reinterpret_cast<const struct sockaddr*>(header.msg_name);
+        if (!addresses[i].FromSockAddr(addr, header.msg_namelen)) {
+          LogRead(ERR_FAILED, NULL, 0, NULL);
+          return ERR_FAILED;
+        }
+        sizes[i] = headers[i].msg_len;
+        LogRead(sizes[i], static_cast<const char*>(iov[i].iov_base),
+                header.msg_namelen, addr);
+      }
+      return datagrams;
+    }
+
+    if (errno != ENOSYS) {
+      int result = MapSystemError(errno);
+      if (result != ERR_IO_PENDING)
+        LogRead(result, NULL, 0, NULL);
+      return result;
+    }
+    base::subtle::NoBarrier_Store(&g_recvmmsg_unsupported, 1);
+  }
+#endif
+
+  // Read the datagrams one at a time.
+  int datagrams = 0;
+  for (; datagrams < count; ++datagrams) {
+    scoped_refptr<IOBuffer> slot(
+        new WrappedIOBuffer(buf->data() + datagrams * buf_len));
+    int result = InternalRecvFrom(slot, buf_len, &addresses[datagrams]);
+    if (result < 0) {
+      // Report the datagrams already read; a lasting error will be returned
+      // by the next read.
+      return datagrams ? datagrams : result;
+    }
+    sizes[datagrams] = result;
+  }
+  return datagrams;
+}
+
 int UDPSocketLibevent::InternalSendTo(IOBuffer* buf, int buf_len,
                                       const IPEndPoint* address) {
   struct sockaddr_storage addr_storage;
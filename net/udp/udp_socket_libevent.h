@@ -94,6 +94,24 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
              const IPEndPoint& address,
              const CompletionCallback& callback);
 
+  // Like RecvFrom(), but reads up to |count| datagrams at once, using a single
+  // recvmmsg() system call where the kernel supports it.
+  // |buf| is divided into |count| slots of |buf_len| bytes each.  The i-th
+  //   datagram is read into the i-th slot.
+  // |sizes| and |addresses| are arrays of |count| elements that receive the
+  //   size and the sender address of each datagram.
+  // Returns the number of datagrams read, a net error code, or ERR_IO_PENDING
+  // if the IO is in progress, in which case the callback is run with the
+  // number of datagrams read.  Fewer than |count| datagrams may be read even
+  // if more are queued.  If ERR_IO_PENDING is returned, the caller must keep
+  // |buf|, |sizes| and |addresses| alive until the callback is called.
+  int RecvMultipleFrom(IOBuffer* buf,
+                       int buf_len,
+                       int count,
+                       int* sizes,
+                       IPEndPoint* addresses,
+                       const CompletionCallback& callback);
+
   // Set the receive buffer size (in bytes) for the socket.
   bool SetReceiveBufferSize(int32 size);
 
@@ -172,6 +190,8 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
 
   int InternalConnect(const IPEndPoint& address);
   int InternalRecvFrom(IOBuffer* buf, int buf_len, IPEndPoint* address);
+  int InternalRecvMultipleFrom(IOBuffer* buf, int buf_len, int count,
+                               int* sizes, IPEndPoint* addresses);
   int InternalSendTo(IOBuffer* buf, int buf_len, const IPEndPoint* address);
 
   int DoBind(const IPEndPoint& address);
@@ -204,6 +224,12 @@ class NET_EXPORT UDPSocketLibevent : public base::NonThreadSafe {
   int read_buf_len_;
   IPEndPoint* recv_from_address_;
 
+  // Set when the pending read comes from RecvMultipleFrom(), in which case
+  // |read_buf_| holds |read_count_| slots, and |recv_from_address_| points to
+  // as many addresses.
+  int read_count_;
+  int* read_sizes_;
+
   // The buffer used by InternalWrite() to retry Write requests
   scoped_refptr<IOBuffer> write_buf_;
   int write_buf_len_;
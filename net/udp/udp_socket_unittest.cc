@@ -426,6 +426,66 @@ TEST_F(UDPSocketTest, ServerGetPeerAddress) {
   EXPECT_EQ(rv, ERR_SOCKET_NOT_CONNECTED);
 }
 
+// Make sure that queued datagrams are read together, and that a pending
+// RecvMultipleFrom() completes when the next one arrives.
+TEST_F(UDPSocketTest, RecvMultipleFrom) {
+  const int kDatagrams = 3;
+  const int kCount = 4;
+
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", 0, &bind_address);
+  UDPServerSocket server(NULL, NetLog::Source());
+  ASSERT_EQ(OK, server.Listen(bind_address));
+  IPEndPoint server_address;
+  ASSERT_EQ(OK, server.GetLocalAddress(&server_address));
+
+  UDPClientSocket client(DatagramSocket::DEFAULT_BIND, RandIntCallback(),
+                         NULL, NetLog::Source());
+  ASSERT_EQ(OK, client.Connect(server_address));
+  IPEndPoint client_address;
+  ASSERT_EQ(OK, client.GetLocalAddress(&client_address));
+
+  std::string messages[kDatagrams] = { "first", "second", "" };
+  messages[2].assign(kMaxRead, 'x');
+  for (int i = 0; i < kDatagrams; ++i) {
+    EXPECT_EQ(static_cast<int>(messages[i].size()),
+              WriteSocket(&client, messages[i]));
+  }
+
+  scoped_refptr<IOBuffer> buf(new IOBuffer(kMaxRead * kCount));
+  int sizes[kCount];
+  IPEndPoint addresses[kCount];
+  TestCompletionCallback callback;
+
+  // Loopback datagrams may show up a little later, and aren't guaranteed to
+  // be read together, so read until all of them are there.
+  int read = 0;
+  while (read < kDatagrams) {
+    int rv = server.RecvMultipleFrom(buf, kMaxRead, kCount, sizes, addresses,
+                                     callback.callback());
+    if (rv == ERR_IO_PENDING)
+      rv = callback.WaitForResult();
+    ASSERT_GT(rv, 0);
+    ASSERT_LE(read + rv, kDatagrams);
+    for (int i = 0; i < rv; ++i) {
+      EXPECT_EQ(messages[read + i],
+                std::string(buf->data() + i * kMaxRead, sizes[i]));
+      EXPECT_TRUE(client_address == addresses[i]);
+    }
+    read += rv;
+  }
+
+  // Nothing is left, so the next read is pending until a datagram arrives.
+  int rv = server.RecvMultipleFrom(buf, kMaxRead, kCount, sizes, addresses,
+                                   callback.callback());
+  ASSERT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(static_cast<int>(messages[0].size()),
+            WriteSocket(&client, messages[0]));
+  EXPECT_EQ(1, callback.WaitForResult());
+  EXPECT_EQ(messages[0], std::string(buf->data(), sizes[0]));
+  EXPECT_TRUE(client_address == addresses[0]);
+}
+
 // Close the socket while read is pending.
 TEST_F(UDPSocketTest, CloseWithPendingRead) {
   IPEndPoint bind_address;
@@ -6,6 +6,7 @@
 
 #include <mstcpip.h>
 
+#include "base/bind.h"
 #include "base/eintr_wrapper.h"
 #include "base/logging.h"
 #include "base/message_loop.h"
@@ -27,6 +28,17 @@ static const int kBindRetries = 10;
 static const int kPortStart = 1024;
 static const int kPortEnd = 65535;
 
+// Completes a RecvMultipleFrom() that read a single datagram of |result| bytes.
+void DidRecvSingleDatagram(int* size,
+                           const net::CompletionCallback& callback,
+                           int result) {
+  if (result >= 0) {
+    *size = result;
+    result = 1;
+  }
+  callback.Run(result);
+}
+
 }  // namespace net
 
 namespace net {
@@ -172,6 +184,21 @@ int UDPSocketWin::SendTo(IOBuffer* buf,
   return SendToOrWrite(buf, buf_len, &address, callback);
 }
 
+int UDPSocketWin::RecvMultipleFrom(IOBuffer* buf,
+                                   int buf_len,
+                                   int count,
+                                   int* sizes,
+                                   IPEndPoint* addresses,
+                                   const CompletionCallback& callback) {
+  DCHECK_GT(count, 0);
+  int result = RecvFrom(buf, buf_len, addresses,
+                        base::Bind(&DidRecvSingleDatagram, sizes, callback));
+  if (result < 0)
+    return result;
+  sizes[0] = result;
+  return 1;
+}
+
 int UDPSocketWin::SendToOrWrite(IOBuffer* buf,
                                 int buf_len,
                                 const IPEndPoint* address,
@@ -95,6 +95,15 @@ class NET_EXPORT UDPSocketWin : NON_EXPORTED_BASE(public base::NonThreadSafe) {
              const IPEndPoint& address,
              const CompletionCallback& callback);
 
+  // Same interface as UDPSocketLibevent::RecvMultipleFrom().  Overlapped IO
+  // reads a single datagram at a time, so this reads at most one.
+  int RecvMultipleFrom(IOBuffer* buf,
+                       int buf_len,
+                       int count,
+                       int* sizes,
+                       IPEndPoint* addresses,
+                       const CompletionCallback& callback);
+
   // Set the receive buffer size (in bytes) for the socket.
   bool SetReceiveBufferSize(int32 size);
 
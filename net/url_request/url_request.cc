@@ -8,6 +8,7 @@
 #include "base/bind_helpers.h"
 #include "base/callback.h"
 #include "base/compiler_specific.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/lazy_instance.h"
 #include "base/memory/singleton.h"
 #include "base/message_loop.h"
@@ -392,6 +393,7 @@ void URLRequest::set_delegate(Delegate* delegate) {
 }
 
 void URLRequest::Start() {
+  base::debug::ScopedHeapTag heap_tag(base::debug::HEAP_TAG_NET);
   g_url_requests_started = true;
   response_info_.request_time = Time::Now();
 
@@ -521,6 +523,7 @@ void URLRequest::DoCancel(int error, const SSLInfo& ssl_info) {
 }
 
 bool URLRequest::Read(IOBuffer* dest, int dest_size, int* bytes_read) {
+  base::debug::ScopedHeapTag heap_tag(base::debug::HEAP_TAG_NET);
   DCHECK(job_);
   DCHECK(bytes_read);
   *bytes_read = 0;
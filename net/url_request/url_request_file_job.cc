@@ -307,22 +307,26 @@ void URLRequestFileJob::DidResolve(
   if (!exists) {
     rv = ERR_FILE_NOT_FOUND;
   } else if (!is_directory_) {
-    // URL requests should not block on the disk!
-    //   http://code.google.com/p/chromium/issues/detail?id=59849
-    base::ThreadRestrictions::ScopedAllowIO allow_io;
-
     int flags = base::PLATFORM_FILE_OPEN |
                 base::PLATFORM_FILE_READ |
                 base::PLATFORM_FILE_ASYNC;
-    rv = stream_.OpenSync(file_path_, flags);
+    rv = stream_.Open(file_path_, flags,
+                      base::Bind(&URLRequestFileJob::DidOpen,
+                                 base::Unretained(this), file_info.size));
+    if (rv == ERR_IO_PENDING)
+      return;
   }
 
-  if (rv != OK) {
-    NotifyDone(URLRequestStatus(URLRequestStatus::FAILED, rv));
+  DidOpen(file_info.size, rv);
+}
+
+void URLRequestFileJob::DidOpen(int64 file_size, int result) {
+  if (result != OK) {
+    NotifyDone(URLRequestStatus(URLRequestStatus::FAILED, result));
     return;
   }
 
-  if (!byte_range_.ComputeBounds(file_info.size)) {
+  if (!byte_range_.ComputeBounds(file_size)) {
     NotifyDone(URLRequestStatus(URLRequestStatus::FAILED,
                ERR_REQUEST_RANGE_NOT_SATISFIABLE));
     return;
@@ -332,19 +336,24 @@ void URLRequestFileJob::DidResolve(
                      byte_range_.first_byte_position() + 1;
   DCHECK_GE(remaining_bytes_, 0);
 
-  // URL requests should not block on the disk!
-  //   http://code.google.com/p/chromium/issues/detail?id=59849
-  {
-    base::ThreadRestrictions::ScopedAllowIO allow_io;
-    // Do the seek at the beginning of the request.
-    if (remaining_bytes_ > 0 &&
-        byte_range_.first_byte_position() != 0 &&
-        byte_range_.first_byte_position() !=
-        stream_.SeekSync(FROM_BEGIN, byte_range_.first_byte_position())) {
-      NotifyDone(URLRequestStatus(URLRequestStatus::FAILED,
-                                  ERR_REQUEST_RANGE_NOT_SATISFIABLE));
-      return;
-    }
+  // Do the seek at the beginning of the request.
+  if (remaining_bytes_ > 0 && byte_range_.first_byte_position() != 0) {
+    int rv = stream_.Seek(FROM_BEGIN, byte_range_.first_byte_position(),
+                          base::Bind(&URLRequestFileJob::DidSeek,
+                                     base::Unretained(this)));
+    if (rv != ERR_IO_PENDING)
+      DidSeek(rv);
+    return;
+  }
+
+  DidSeek(byte_range_.first_byte_position());
+}
+
+void URLRequestFileJob::DidSeek(int64 result) {
+  if (result != byte_range_.first_byte_position()) {
+    NotifyDone(URLRequestStatus(URLRequestStatus::FAILED,
+                                ERR_REQUEST_RANGE_NOT_SATISFIABLE));
+    return;
   }
 
   set_expected_content_size(remaining_bytes_);
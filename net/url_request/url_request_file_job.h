@@ -56,6 +56,14 @@ class NET_EXPORT URLRequestFileJob : public URLRequestJob {
   // Callback after fetching file info on a background thread.
   void DidResolve(bool exists, const base::PlatformFileInfo& file_info);
 
+  // Callback after the file is opened on a background thread. |file_size| is
+  // the size fetched by DidResolve().
+  void DidOpen(int64 file_size, int result);
+
+  // Callback after seeking to the start of |byte_range_|. |result| is the new
+  // position or a network error code.
+  void DidSeek(int64 result);
+
   // Callback after data is asynchronously read from the file.
   void DidRead(int result);
 
@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/compiler_specific.h"
+#include "base/debug/tagged_heap_profiler.h"
 #include "base/message_loop.h"
 #include "base/string_number_conversions.h"
 #include "base/string_util.h"
@@ -255,6 +256,7 @@ bool URLRequestJob::CanSetCookie(const std::string& cookie_line,
 }
 
 void URLRequestJob::NotifyHeadersComplete() {
+  base::debug::ScopedHeapTag heap_tag(base::debug::HEAP_TAG_NET);
   if (!request_ || !request_->has_delegate())
     return;  // The request was destroyed, so there is no more work to do.
 
@@ -337,6 +339,7 @@ void URLRequestJob::NotifyHeadersComplete() {
 }
 
 void URLRequestJob::NotifyReadComplete(int bytes_read) {
+  base::debug::ScopedHeapTag heap_tag(base::debug::HEAP_TAG_NET);
   if (!request_ || !request_->has_delegate())
     return;  // The request was destroyed, so there is no more work to do.
 
@@ -111,13 +111,17 @@ URLRequestJob* URLRequestJobFactory::MaybeInterceptResponse(
 
 bool URLRequestJobFactory::IsHandledProtocol(const std::string& scheme) const {
   DCHECK(CalledOnValidThread());
+  // This runs for every request and response, so ask the interceptors last:
+  // they can be slow, and the common schemes never need them.
+  if (ContainsKey(protocol_handler_map_, scheme) ||
+      URLRequestJobManager::GetInstance()->SupportsScheme(scheme))
+    return true;
   InterceptorList::const_iterator i;
   for (i = interceptors_.begin(); i != interceptors_.end(); ++i) {
     if ((*i)->WillHandleProtocol(scheme))
       return true;
   }
-  return ContainsKey(protocol_handler_map_, scheme) ||
-      URLRequestJobManager::GetInstance()->SupportsScheme(scheme);
+  return false;
 }
 
 bool URLRequestJobFactory::IsHandledURL(const GURL& url) const {
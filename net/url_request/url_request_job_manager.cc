@@ -42,6 +42,17 @@ static const SchemeToFactory kBuiltinFactories[] = {
   { "data", URLRequestDataJob::Factory },
 };
 
+// Returns the built-in protocol factory for |scheme|, or NULL if there is
+// none. The table is immutable, so this needs no locking.
+static URLRequest::ProtocolFactory* GetBuiltinFactory(
+    const std::string& scheme) {
+  for (size_t i = 0; i < arraysize(kBuiltinFactories); ++i) {
+    if (LowerCaseEqualsASCII(scheme, kBuiltinFactories[i].scheme))
+      return kBuiltinFactories[i].factory;
+  }
+  return NULL;
+}
+
 // static
 URLRequestJobManager* URLRequestJobManager::GetInstance() {
   return Singleton<URLRequestJobManager>::get();
@@ -112,12 +123,11 @@ URLRequestJob* URLRequestJobManager::CreateJob(
   }
 
   // See if the request should be handled by a built-in protocol factory.
-  for (size_t i = 0; i < arraysize(kBuiltinFactories); ++i) {
-    if (scheme == kBuiltinFactories[i].scheme) {
-      URLRequestJob* job = (kBuiltinFactories[i].factory)(request, scheme);
-      DCHECK(job);  // The built-in factories are not expected to fail!
-      return job;
-    }
+  URLRequest::ProtocolFactory* builtin_factory = GetBuiltinFactory(scheme);
+  if (builtin_factory) {
+    URLRequestJob* job = builtin_factory(request, scheme);
+    DCHECK(job);  // The built-in factories are not expected to fail!
+    return job;
   }
 
   // If we reached here, then it means that a registered protocol factory
@@ -203,18 +213,14 @@ URLRequestJob* URLRequestJobManager::MaybeInterceptResponse(
 }
 
 bool URLRequestJobManager::SupportsScheme(const std::string& scheme) const {
-  // The set of registered factories may change on another thread.
-  {
-    base::AutoLock locked(lock_);
-    if (factories_.find(scheme) != factories_.end())
-      return true;
-  }
+  // Nearly every request is for a built-in scheme, so check those first to
+  // avoid taking the lock.
+  if (GetBuiltinFactory(scheme))
+    return true;
 
-  for (size_t i = 0; i < arraysize(kBuiltinFactories); ++i)
-    if (LowerCaseEqualsASCII(scheme, kBuiltinFactories[i].scheme))
-      return true;
-
-  return false;
+  // The set of registered factories may change on another thread.
+  base::AutoLock locked(lock_);
+  return factories_.find(scheme) != factories_.end();
 }
 
 URLRequest::ProtocolFactory* URLRequestJobManager::RegisterProtocolFactory(
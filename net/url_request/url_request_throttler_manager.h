@@ -6,11 +6,11 @@
 #define NET_URL_REQUEST_URL_REQUEST_THROTTLER_MANAGER_H_
 #pragma once
 
-#include <map>
 #include <set>
 #include <string>
 
 #include "base/basictypes.h"
+#include "base/memory/mru_cache.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/threading/non_thread_safe.h"
 #include "base/threading/platform_thread.h"
@@ -30,9 +30,9 @@ class NetLog;
 //
 // URLRequestThrottlerManager maintains a map of URL IDs to URL request
 // throttler entries. It creates URL request throttler entries when new URLs
-// are registered, and does garbage collection from time to time in order to
-// clean out outdated entries. URL ID consists of lowercased scheme, host, port
-// and path. All URLs converted to the same ID will share the same entry.
+// are registered, and on each registration cleans out the least recently used
+// entries if they are outdated. URL ID consists of lowercased scheme, host,
+// port and path. All URLs converted to the same ID will share the same entry.
 class NET_EXPORT URLRequestThrottlerManager
     : NON_EXPORTED_BASE(public base::NonThreadSafe),
       public NetworkChangeNotifier::IPAddressObserver,
@@ -91,12 +91,12 @@ class NET_EXPORT URLRequestThrottlerManager
   // transformation.
   std::string GetIdFromUrl(const GURL& url) const;
 
-  // Method that ensures the map gets cleaned from time to time. The period at
-  // which garbage collecting happens is adjustable with the
-  // kRequestBetweenCollecting constant.
+  // Method that ensures the map gets cleaned as requests are made. It looks at
+  // no more than kEntriesCheckedPerRequest of the least recently used entries,
+  // so a request never pays for a sweep of the whole map.
   void GarbageCollectEntriesIfNecessary();
 
-  // Method that does the actual work of garbage collecting.
+  // Method that sweeps the whole map for outdated entries.
   void GarbageCollectEntries();
 
   // When we switch from online to offline or change IP addresses, we
@@ -113,8 +113,10 @@ class NET_EXPORT URLRequestThrottlerManager
 
  private:
   // From each URL we generate an ID composed of the scheme, host, port and path
-  // that allows us to uniquely map an entry to it.
-  typedef std::map<std::string, scoped_refptr<URLRequestThrottlerEntry> >
+  // that allows us to uniquely map an entry to it. The map is kept in most
+  // recently used order and holds at most kMaximumNumberOfEntries entries.
+  typedef base::HashingMRUCache<std::string,
+                                scoped_refptr<URLRequestThrottlerEntry> >
       UrlEntryMap;
 
   // We maintain a set of hosts that have opted out of exponential
@@ -123,8 +125,10 @@ class NET_EXPORT URLRequestThrottlerManager
 
   // Maximum number of entries that we are willing to collect in our map.
   static const unsigned int kMaximumNumberOfEntries;
-  // Number of requests that will be made between garbage collection.
-  static const unsigned int kRequestsBetweenCollecting;
+  // Number of least recently used entries looked at on each request. Since a
+  // request adds at most one entry, this needs to be more than one for
+  // outdated entries to be collected faster than they are added.
+  static const unsigned int kEntriesCheckedPerRequest;
 
   // Map that contains a list of URL ID and their matching
   // URLRequestThrottlerEntry.
@@ -133,10 +137,6 @@ class NET_EXPORT URLRequestThrottlerManager
   // Set of hosts that have opted out.
   OptOutHosts opt_out_hosts_;
 
-  // This keeps track of how many requests have been made. Used with
-  // GarbageCollectEntries.
-  unsigned int requests_since_last_gc_;
-
   // Valid after construction.
   GURL::Replacements url_id_replacements_;
 
@@ -423,6 +423,23 @@ TEST(URLRequestThrottlerManager, AreEntriesBeingCollected) {
   EXPECT_EQ(3, manager.GetNumberOfEntries());
 }
 
+TEST(URLRequestThrottlerManager, AreEntriesCollectedOnRegister) {
+  MockURLRequestThrottlerManager manager;
+
+  manager.CreateEntry(true);  // true = Entry is outdated.
+  EXPECT_EQ(1, manager.GetNumberOfEntries());
+
+  // The outdated entry is the least recently used one, so registering a new
+  // URL collects it without a full sweep.
+  scoped_refptr<net::URLRequestThrottlerEntryInterface> entry =
+      manager.RegisterRequestUrl(GURL("http://www.example.com/"));
+  EXPECT_EQ(1, manager.GetNumberOfEntries());
+
+  // Entries that are still in use are left alone.
+  manager.RegisterRequestUrl(GURL("http://www.example.com/"));
+  EXPECT_EQ(1, manager.GetNumberOfEntries());
+}
+
 TEST(URLRequestThrottlerManager, IsHostBeingRegistered) {
   MockURLRequestThrottlerManager manager;
 
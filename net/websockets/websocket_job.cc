@@ -649,8 +649,27 @@ void WebSocketJob::SendPending() {
     return;
   }
 
+  // Send everything that was queued while the last buffer was in flight in
+  // one write, rather than a frame at a time. Otherwise each small message in
+  // a burst needs its own write and its own trip through the message loop.
   scoped_refptr<IOBufferWithSize> next_buffer = send_buffer_queue_.front();
-  send_buffer_queue_.pop_front();
+  if (send_buffer_queue_.size() > 1) {
+    int size = 0;
+    for (std::deque<scoped_refptr<IOBufferWithSize> >::const_iterator iter =
+             send_buffer_queue_.begin();
+         iter != send_buffer_queue_.end(); ++iter) {
+      size += (*iter)->size();
+    }
+    next_buffer = new IOBufferWithSize(size);
+    char* data = next_buffer->data();
+    for (std::deque<scoped_refptr<IOBufferWithSize> >::const_iterator iter =
+             send_buffer_queue_.begin();
+         iter != send_buffer_queue_.end(); ++iter) {
+      memcpy(data, (*iter)->data(), (*iter)->size());
+      data += (*iter)->size();
+    }
+  }
+  send_buffer_queue_.clear();
   current_send_buffer_ = new DrainableIOBuffer(next_buffer,
                                                next_buffer->size());
   SendDataInternal(current_send_buffer_->data(),
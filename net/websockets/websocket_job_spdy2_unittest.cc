@@ -458,6 +458,7 @@ class WebSocketJobSpdy2Test : public PlatformTest {
   void TestHandshakeWithCookieButNotAllowed();
   void TestHSTSUpgrade();
   void TestInvalidSendData();
+  void TestCoalescedSendData();
   void TestConnectByWebSocket(ThrottlingOption throttling);
   void TestConnectBySpdy(SpdyOption spdy, ThrottlingOption throttling);
 
@@ -816,6 +817,43 @@ void WebSocketJobSpdy2Test::TestInvalidSendData() {
   CloseWebSocketJob();
 }
 
+void WebSocketJobSpdy2Test::TestCoalescedSendData() {
+  GURL url("ws://example.com/demo");
+  MockSocketStreamDelegate delegate;
+  InitWebSocketJob(url, &delegate, STREAM_MOCK_SOCKET);
+  SkipToConnecting();
+
+  DoSendRequest();
+  MessageLoop::current()->RunAllPending();
+  websocket_->OnSentData(socket_.get(),
+                         kHandshakeRequestWithoutCookieLength);
+  websocket_->OnReceivedData(socket_.get(),
+                             kHandshakeResponseWithoutCookie,
+                             kHandshakeResponseWithoutCookieLength);
+  MessageLoop::current()->RunAllPending();
+  EXPECT_EQ(WebSocketJob::OPEN, GetWebSocketJobState());
+
+  // The first frame is written right away, and the ones sent while it is in
+  // flight are queued.
+  EXPECT_TRUE(websocket_->SendData(kDataHello, kDataHelloLength));
+  EXPECT_TRUE(websocket_->SendData(kDataWorld, kDataWorldLength));
+  EXPECT_TRUE(websocket_->SendData(kDataWorld, kDataWorldLength));
+  std::string expected_sent_data(kHandshakeRequestWithoutCookie);
+  expected_sent_data += kDataHello;
+  EXPECT_EQ(expected_sent_data, sent_data());
+
+  // Once it has been sent, the queued frames go out in a single write.
+  websocket_->OnSentData(socket_.get(), kDataHelloLength);
+  MessageLoop::current()->RunAllPending();
+  expected_sent_data += kDataWorld;
+  expected_sent_data += kDataWorld;
+  EXPECT_EQ(expected_sent_data, sent_data());
+  websocket_->OnSentData(socket_.get(), kDataWorldLength * 2);
+  EXPECT_EQ(kHandshakeRequestWithoutCookieLength + kDataHelloLength +
+            kDataWorldLength * 2, delegate.amount_sent());
+  CloseWebSocketJob();
+}
+
 // Following tests verify cooperation between WebSocketJob and SocketStream.
 // Other former tests use MockSocketStream as SocketStream, so we could not
 // check SocketStream behavior.
@@ -1043,6 +1081,11 @@ TEST_F(WebSocketJobSpdy2Test, InvalidSendData) {
   TestInvalidSendData();
 }
 
+TEST_F(WebSocketJobSpdy2Test, CoalescedSendData) {
+  WebSocketJob::set_websocket_over_spdy_enabled(false);
+  TestCoalescedSendData();
+}
+
 TEST_F(WebSocketJobSpdy2Test, SimpleHandshakeSpdyEnabled) {
   WebSocketJob::set_websocket_over_spdy_enabled(true);
   TestSimpleHandshake();
@@ -1073,6 +1116,11 @@ TEST_F(WebSocketJobSpdy2Test, InvalidSendDataSpdyEnabled) {
   TestInvalidSendData();
 }
 
+TEST_F(WebSocketJobSpdy2Test, CoalescedSendDataSpdyEnabled) {
+  WebSocketJob::set_websocket_over_spdy_enabled(true);
+  TestCoalescedSendData();
+}
+
 TEST_F(WebSocketJobSpdy2Test, ConnectByWebSocket) {
   WebSocketJob::set_websocket_over_spdy_enabled(false);
   TestConnectByWebSocket(THROTTLING_OFF);
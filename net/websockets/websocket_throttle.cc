@@ -13,6 +13,7 @@
 #include "base/string_number_conversions.h"
 #include "base/string_util.h"
 #include "base/stringprintf.h"
+#include "base/sys_byteorder.h"
 #include "net/base/io_buffer.h"
 #include "net/base/sys_addrinfo.h"
 #include "net/socket_stream/socket_stream.h"
@@ -20,23 +21,28 @@
 
 namespace net {
 
+// The key includes the port: RFC 6455 section 4.1 only requires a connection
+// to wait for others to the same IP address and port, so servers behind one
+// address on different ports can be connected to in parallel.
 static std::string AddrinfoToHashkey(const struct addrinfo* addrinfo) {
   switch (addrinfo->ai_family) {
     case AF_INET: {
       const struct sockaddr_in* const addr =
           reinterpret_cast<const sockaddr_in*>(addrinfo->ai_addr);
-      return base::StringPrintf("%d:%s",
+      return base::StringPrintf("%d:%s:%d",
                                 addrinfo->ai_family,
-                                base::HexEncode(&addr->sin_addr, 4).c_str());
+                                base::HexEncode(&addr->sin_addr, 4).c_str(),
+                                base::NetToHost16(addr->sin_port));
       }
     case AF_INET6: {
       const struct sockaddr_in6* const addr6 =
           reinterpret_cast<const sockaddr_in6*>(addrinfo->ai_addr);
       return base::StringPrintf(
-          "%d:%s",
+          "%d:%s:%d",
           addrinfo->ai_family,
           base::HexEncode(&addr6->sin6_addr,
-                          sizeof(addr6->sin6_addr)).c_str());
+                          sizeof(addr6->sin6_addr)).c_str(),
+          base::NetToHost16(addr6->sin6_port));
       }
     default:
       return base::StringPrintf("%d:%s",
@@ -7,6 +7,7 @@
 #include <string>
 
 #include "base/message_loop.h"
+#include "base/sys_byteorder.h"
 #include "googleurl/src/gurl.h"
 #include "net/base/address_list.h"
 #include "net/base/sys_addrinfo.h"
@@ -41,7 +42,7 @@ class WebSocketThrottleTest : public PlatformTest {
     int addrlen = sizeof(struct sockaddr_in);
     addrinfo->ai_addrlen = addrlen;
     addrinfo->ai_addr = reinterpret_cast<sockaddr*>(new char[addrlen]);
-    memset(addrinfo->ai_addr, 0, sizeof(addrlen));
+    memset(addrinfo->ai_addr, 0, addrlen);
     struct sockaddr_in* addr =
         reinterpret_cast<sockaddr_in*>(addrinfo->ai_addr);
     int addrint = ((a1 & 0xff) << 24) |
@@ -299,6 +300,56 @@ TEST_F(WebSocketThrottleTest, Throttle) {
   MessageLoopForIO::current()->RunAllPending();
 }
 
+TEST_F(WebSocketThrottleTest, NoThrottleForDifferentPort) {
+  scoped_refptr<URLRequestContext> context(new TestURLRequestContext);
+  DummySocketStreamDelegate delegate;
+  WebSocketJob::set_websocket_over_spdy_enabled(true);
+
+  // For host1: 1.2.3.4:80
+  struct addrinfo* addr = AddAddr(1, 2, 3, 4, NULL);
+  reinterpret_cast<sockaddr_in*>(addr->ai_addr)->sin_port =
+      base::HostToNet16(80);
+  scoped_refptr<WebSocketJob> w1(new WebSocketJob(&delegate));
+  scoped_refptr<SocketStream> s1(
+      new SocketStream(GURL("ws://host1/"), w1.get()));
+  s1->set_context(context.get());
+  w1->InitSocketStream(s1.get());
+  WebSocketThrottleTest::MockSocketStreamConnect(s1, addr);
+  DeleteAddrInfo(addr);
+
+  DVLOG(1) << "socket1";
+  TestCompletionCallback callback_s1;
+  // Trying to open connection to host1 will start without wait.
+  EXPECT_EQ(OK, w1->OnStartOpenConnection(s1, callback_s1.callback()));
+
+  // For host2: 1.2.3.4:8080
+  addr = AddAddr(1, 2, 3, 4, NULL);
+  reinterpret_cast<sockaddr_in*>(addr->ai_addr)->sin_port =
+      base::HostToNet16(8080);
+  scoped_refptr<WebSocketJob> w2(new WebSocketJob(&delegate));
+  scoped_refptr<SocketStream> s2(
+      new SocketStream(GURL("ws://host2:8080/"), w2.get()));
+  s2->set_context(context.get());
+  w2->InitSocketStream(s2.get());
+  WebSocketThrottleTest::MockSocketStreamConnect(s2, addr);
+  DeleteAddrInfo(addr);
+
+  DVLOG(1) << "socket2";
+  TestCompletionCallback callback_s2;
+  // Trying to open connection to host2 will start without wait, since only
+  // the address is shared with host1, not the port.
+  EXPECT_EQ(OK, w2->OnStartOpenConnection(s2, callback_s2.callback()));
+
+  DVLOG(1) << "socket1 close";
+  w1->OnClose(s1.get());
+  s1->DetachDelegate();
+  DVLOG(1) << "socket2 close";
+  w2->OnClose(s2.get());
+  s2->DetachDelegate();
+  DVLOG(1) << "Done";
+  MessageLoopForIO::current()->RunAllPending();
+}
+
 TEST_F(WebSocketThrottleTest, NoThrottleForDuplicateAddress) {
   scoped_refptr<URLRequestContext> context(new TestURLRequestContext);
   DummySocketStreamDelegate delegate;
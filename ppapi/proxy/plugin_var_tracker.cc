@@ -50,7 +50,8 @@ PP_Var PluginVarTracker::ReceiveObjectPassRef(const PP_Var& host_var,
   PP_Var ret = GetOrCreateObjectVarID(object.get());
 
   VarInfo& info = GetLiveVar(ret)->second;
-  if (info.ref_count > 0) {
+  if (info.ref_count > 0 ||
+      deferred_release_var_ids_.erase(static_cast<int32>(ret.value.as_id))) {
     // We already had a reference to it before. That means the renderer now has
     // two references on our behalf. We want to transfer that extra reference
     // to our list. This means we addref in the plugin, and release the extra
@@ -180,6 +181,10 @@ void PluginVarTracker::TrackedObjectGettingOneRef(VarMap::const_iterator iter) {
 
   DCHECK(iter->second.ref_count == 0);
 
+  // If our release of the host's reference was deferred, we still hold it.
+  if (deferred_release_var_ids_.erase(iter->first))
+    return;
+
   // Got an AddRef for an object we have no existing reference for.
   // We need to tell the browser we've taken a ref. This comes up when the
   // browser passes an object as an input param and holds a ref for us.
@@ -196,9 +201,14 @@ void PluginVarTracker::ObjectGettingZeroRef(VarMap::iterator iter) {
     return;
   }
 
-  // Notify the host we're no longer holding our ref.
+  // Notify the host we're no longer holding our ref. While the object is
+  // still tracked, the plugin may well take another reference, so wait until
+  // tracking stops.
   DCHECK(iter->second.ref_count == 0);
-  SendReleaseObjectMsg(*object);
+  if (iter->second.track_with_no_reference_count > 0)
+    deferred_release_var_ids_.insert(iter->first);
+  else
+    SendReleaseObjectMsg(*object);
 
   // This will optionally delete the info from live_vars_.
   VarTracker::ObjectGettingZeroRef(iter);
@@ -210,6 +220,11 @@ bool PluginVarTracker::DeleteObjectInfoIfNecessary(VarMap::iterator iter) {
   ProxyObjectVar* object = iter->second.var->AsProxyObjectVar();
   HostVar host_var(object->dispatcher(), object->host_var_id());
 
+  if (iter->second.ref_count == 0 &&
+      iter->second.track_with_no_reference_count == 0 &&
+      deferred_release_var_ids_.erase(iter->first))
+    SendReleaseObjectMsg(*object);
+
   if (!VarTracker::DeleteObjectInfoIfNecessary(iter))
     return false;
 
@@ -6,6 +6,7 @@
 #define PPAPI_PROXY_PLUGIN_VAR_TRACKER_H_
 
 #include <map>
+#include <set>
 #include <string>
 
 #include "base/basictypes.h"
@@ -106,6 +107,13 @@ class PPAPI_PROXY_EXPORT PluginVarTracker : public VarTracker {
   typedef std::map<HostVar, int32> HostVarToPluginVarMap;
   HostVarToPluginVarMap host_var_to_plugin_var_;
 
+  // Plugin var IDs of objects whose refcount dropped to zero while they were
+  // still tracked with no reference. The host keeps our reference on them
+  // until tracking stops, so a plugin that releases and re-adds a reference
+  // to an object it was passed doesn't cost a release and a sync addref
+  // message each time.
+  std::set<int32> deferred_release_var_ids_;
+
   DISALLOW_COPY_AND_ASSIGN(PluginVarTracker);
 };
 
@@ -0,0 +1,56 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/command_line.h"
+#include "base/perftimer.h"
+#include "base/string_number_conversions.h"
+#include "ipc/ipc_test_sink.h"
+#include "ppapi/proxy/plugin_var_tracker.h"
+#include "ppapi/proxy/ppapi_proxy_test.h"
+
+namespace ppapi {
+namespace proxy {
+
+typedef PluginProxyTest PluginVarTrackerPerfTest;
+
+// Tests the cost of a plugin repeatedly taking and dropping references to an
+// object it was passed by the host, as scripting plugins do while handling a
+// call.
+TEST_F(PluginVarTrackerPerfTest, TrackedObjectRefChurn) {
+  int iterations = 100000;
+  int refs_per_call = 10;
+  CommandLine* command_line = CommandLine::ForCurrentProcess();
+  if (command_line) {
+    if (command_line->HasSwitch("iterations")) {
+      base::StringToInt(command_line->GetSwitchValueASCII("iterations"),
+                        &iterations);
+    }
+    if (command_line->HasSwitch("refs_per_call")) {
+      base::StringToInt(command_line->GetSwitchValueASCII("refs_per_call"),
+                        &refs_per_call);
+    }
+  }
+
+  PP_Var host_object = { PP_VARTYPE_OBJECT };
+  host_object.value.as_id = 12345;
+  size_t messages_sent = 0;
+  PerfTimeLogger logger("PluginVarTrackerPerfTest.TrackedObjectRefChurn");
+  for (int i = 0; i < iterations; ++i) {
+    PP_Var plugin_var = var_tracker().TrackObjectWithNoReference(
+        host_object, plugin_dispatcher());
+    for (int j = 0; j < refs_per_call; ++j) {
+      var_tracker().AddRefVar(plugin_var);
+      var_tracker().ReleaseVar(plugin_var);
+    }
+    var_tracker().StopTrackingObjectWithNoReference(plugin_var);
+    messages_sent += sink().message_count();
+    sink().ClearMessages();
+  }
+  logger.Done();
+  LOG(INFO) << "Messages sent per call: "
+            << static_cast<double>(messages_sent) / iterations;
+}
+
+}  // namespace proxy
+}  // namespace ppapi
@@ -102,16 +102,17 @@ TEST_F(PluginVarTrackerTest, FreeTrackedAndReferencedObject) {
   EXPECT_EQ(1,
             var_tracker().GetTrackedWithNoReferenceCountForObject(plugin_var));
 
-  // Free via the refcount, this should release the object to the browser but
-  // maintain the tracked object.
+  // Free via the refcount, this should maintain the tracked object and defer
+  // releasing the object to the browser until tracking stops.
   var_tracker().ReleaseVar(plugin_var);
   EXPECT_EQ(0, var_tracker().GetRefCountForObject(plugin_var));
-  EXPECT_EQ(1u, sink().message_count());
-  EXPECT_EQ(host_object.value.as_id, GetObjectIDForUniqueReleaseObject());
+  EXPECT_EQ(0u, sink().message_count());
 
   // Now free via the tracked object, this should free it.
   var_tracker().StopTrackingObjectWithNoReference(plugin_var);
   EXPECT_EQ(-1, var_tracker().GetRefCountForObject(plugin_var));
+  EXPECT_EQ(1u, sink().message_count());
+  EXPECT_EQ(host_object.value.as_id, GetObjectIDForUniqueReleaseObject());
 
   // Phase two: Receive via a tracked, then get an addref.
   sink().ClearMessages();
@@ -136,6 +137,31 @@ TEST_F(PluginVarTrackerTest, FreeTrackedAndReferencedObject) {
   EXPECT_EQ(host_object.value.as_id, GetObjectIDForUniqueReleaseObject());
 }
 
+TEST_F(PluginVarTrackerTest, RefChurnOnTrackedObject) {
+  PP_Var host_object = MakeObject(12345);
+
+  // Take a reference to an object that we were passed.
+  PP_Var plugin_var = var_tracker().TrackObjectWithNoReference(
+      host_object, plugin_dispatcher());
+  var_tracker().AddRefVar(plugin_var);
+  EXPECT_TRUE(sink().GetUniqueMessageMatching(
+      PpapiHostMsg_PPBVar_AddRefObject::ID));
+  sink().ClearMessages();
+
+  // Dropping and retaking the reference while the object is still tracked
+  // shouldn't send anything to the host.
+  var_tracker().ReleaseVar(plugin_var);
+  var_tracker().AddRefVar(plugin_var);
+  var_tracker().ReleaseVar(plugin_var);
+  EXPECT_EQ(0, var_tracker().GetRefCountForObject(plugin_var));
+  EXPECT_EQ(0u, sink().message_count());
+
+  // The host's reference is released once tracking stops.
+  var_tracker().StopTrackingObjectWithNoReference(plugin_var);
+  EXPECT_EQ(-1, var_tracker().GetRefCountForObject(plugin_var));
+  EXPECT_EQ(host_object.value.as_id, GetObjectIDForUniqueReleaseObject());
+}
+
 TEST_F(PluginVarTrackerTest, RecursiveTrackWithNoRef) {
   PP_Var host_object = MakeObject(12345);
 
@@ -61,6 +61,11 @@ bool PpapiCommandBufferProxy::EnsureBackbuffer() {
   return true;
 }
 
+uint32 PpapiCommandBufferProxy::InsertSyncPoint() {
+  NOTIMPLEMENTED();
+  return 0;
+}
+
 void PpapiCommandBufferProxy::SetMemoryAllocationChangedCallback(
       const base::Callback<void(const GpuMemoryAllocationForRenderer&)>&
           callback) {
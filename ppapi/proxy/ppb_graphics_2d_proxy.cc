@@ -6,6 +6,9 @@
 
 #include <string.h>  // For memset.
 
+#include <algorithm>
+#include <vector>
+
 #include "base/compiler_specific.h"
 #include "base/logging.h"
 #include "ppapi/c/pp_completion_callback.h"
@@ -15,6 +18,7 @@
 #include "ppapi/proxy/enter_proxy.h"
 #include "ppapi/proxy/plugin_dispatcher.h"
 #include "ppapi/proxy/ppapi_messages.h"
+#include "ppapi/proxy/ppb_image_data_proxy.h"
 #include "ppapi/shared_impl/tracked_callback.h"
 #include "ppapi/thunk/enter.h"
 #include "ppapi/thunk/ppb_graphics_2d_api.h"
@@ -62,6 +66,12 @@ class Graphics2D : public Resource, public thunk::PPB_Graphics2D_API {
   // pointer is non-NULL, we're waiting for a flush ACK.
   scoped_refptr<TrackedCallback> current_flush_callback_;
 
+  // Images painted since the last Flush, and images painted before the Flush
+  // that is waiting for an ACK. The host reads them until the ACK, so these
+  // refs keep them from being recycled for a new frame before then.
+  std::vector<scoped_refptr<ImageData> > unflushed_images_;
+  std::vector<scoped_refptr<ImageData> > flushing_images_;
+
   DISALLOW_COPY_AND_ASSIGN(Graphics2D);
 };
 
@@ -91,12 +101,18 @@ void Graphics2D::PaintImageData(PP_Resource image_data,
                                 const PP_Rect* src_rect) {
   Resource* image_object =
       PpapiGlobals::Get()->GetResourceTracker()->GetResource(image_data);
-  if (!image_object || pp_instance() != image_object->pp_instance()) {
+  if (!image_object || !image_object->AsPPB_ImageData_API() ||
+      pp_instance() != image_object->pp_instance()) {
     Log(PP_LOGLEVEL_ERROR,
         "PPB_Graphics2D.PaintImageData: Bad image resource.");
     return;
   }
 
+  ImageData* image = static_cast<ImageData*>(image_object);
+  if (std::find(unflushed_images_.begin(), unflushed_images_.end(), image) ==
+      unflushed_images_.end())
+    unflushed_images_.push_back(image);
+
   PP_Rect dummy;
   memset(&dummy, 0, sizeof(PP_Rect));
   GetDispatcher()->Send(new PpapiHostMsg_PPBGraphics2D_PaintImageData(
@@ -116,11 +132,13 @@ void Graphics2D::Scroll(const PP_Rect* clip_rect,
 void Graphics2D::ReplaceContents(PP_Resource image_data) {
   Resource* image_object =
       PpapiGlobals::Get()->GetResourceTracker()->GetResource(image_data);
-  if (!image_object || pp_instance() != image_object->pp_instance()) {
+  if (!image_object || !image_object->AsPPB_ImageData_API() ||
+      pp_instance() != image_object->pp_instance()) {
     Log(PP_LOGLEVEL_ERROR,
         "PPB_Graphics2D.PaintImageData: Bad image resource.");
     return;
   }
+  static_cast<ImageData*>(image_object)->set_used_in_replace_contents();
 
   GetDispatcher()->Send(new PpapiHostMsg_PPBGraphics2D_ReplaceContents(
       kApiID, host_resource(), image_object->host_resource()));
@@ -135,6 +153,8 @@ int32_t Graphics2D::Flush(PP_CompletionCallback callback) {
   if (TrackedCallback::IsPending(current_flush_callback_))
     return PP_ERROR_INPROGRESS;  // Can't have >1 flush pending.
   current_flush_callback_ = new TrackedCallback(this, callback);
+  flushing_images_.swap(unflushed_images_);
+  unflushed_images_.clear();
 
   GetDispatcher()->Send(new PpapiHostMsg_PPBGraphics2D_Flush(kApiID,
                                                              host_resource()));
@@ -142,6 +162,7 @@ int32_t Graphics2D::Flush(PP_CompletionCallback callback) {
 }
 
 void Graphics2D::FlushACK(int32_t result_code) {
+  flushing_images_.clear();
   TrackedCallback::ClearAndRun(&current_flush_callback_, result_code);
 }
 
@@ -6,9 +6,13 @@
 
 #include <string.h>  // For memcpy
 
+#include <list>
+#include <map>
 #include <vector>
 
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted.h"
 #include "build/build_config.h"
 #include "ppapi/c/pp_completion_callback.h"
 #include "ppapi/c/pp_errors.h"
@@ -29,11 +33,83 @@
 namespace ppapi {
 namespace proxy {
 
+namespace {
+
+// Number of released images kept per instance. Two covers a plugin that
+// paints one frame while the previous one is being flushed.
+const size_t kMaxRecycledImagesPerInstance = 2;
+
+// Holds images the plugin has released so they can be handed out again by
+// CreateProxyResource. Each entry keeps a real ref to its image, so the
+// image's host resource and shared memory stay alive while it is cached.
+class ImageDataCache {
+ public:
+  ImageDataCache() {}
+  ~ImageDataCache() {}
+
+  // Takes a ref to |image|, evicting the oldest image for the same instance
+  // if there are too many.
+  void Add(ImageData* image) {
+    ImageList& images = instances_[image->pp_instance()];
+    images.push_front(image);
+    if (images.size() > kMaxRecycledImagesPerInstance)
+      images.pop_back();
+  }
+
+  // Removes and returns a matching image that nothing else refers to, or NULL.
+  // Images painted into a Graphics2D are also referenced by it until the
+  // host acknowledges the next flush, so they are skipped until then.
+  scoped_refptr<ImageData> Take(PP_Instance instance,
+                                PP_ImageDataFormat format,
+                                const PP_Size& size) {
+    InstanceMap::iterator found = instances_.find(instance);
+    if (found == instances_.end())
+      return NULL;
+    ImageList& images = found->second;
+    for (ImageList::iterator i = images.begin(); i != images.end(); ++i) {
+      const PP_ImageDataDesc& desc = (*i)->desc();
+      if ((*i)->HasOneRef() && desc.format == format &&
+          desc.size.width == size.width && desc.size.height == size.height) {
+        scoped_refptr<ImageData> image = *i;
+        images.erase(i);
+        return image;
+      }
+    }
+    return NULL;
+  }
+
+  void DidDeleteInstance(PP_Instance instance) {
+    InstanceMap::iterator found = instances_.find(instance);
+    if (found == instances_.end())
+      return;
+    // Releasing the images deletes them, so take them out of the map first.
+    ImageList images;
+    images.swap(found->second);
+    instances_.erase(found);
+  }
+
+ private:
+  typedef std::list<scoped_refptr<ImageData> > ImageList;
+  typedef std::map<PP_Instance, ImageList> InstanceMap;
+
+  InstanceMap instances_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImageDataCache);
+};
+
+// Leaked so that cached images aren't released after the resource tracker
+// is gone.
+base::LazyInstance<ImageDataCache>::Leaky g_image_data_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 ImageData::ImageData(const HostResource& resource,
                      const PP_ImageDataDesc& desc,
                      ImageHandle handle)
     : Resource(OBJECT_IS_PROXY, resource),
-      desc_(desc) {
+      desc_(desc),
+      used_in_replace_contents_(false) {
 #if defined(OS_NACL)
   // TODO(brettw) implement NaCl ImageData. This will involve just
   // memory-mapping the handle as raw memory rather than as a transport DIB.
@@ -52,6 +128,22 @@ thunk::PPB_ImageData_API* ImageData::AsPPB_ImageData_API() {
   return this;
 }
 
+void ImageData::LastPluginRefWasDeleted() {
+#if !defined(OS_NACL)
+  // The host may still be reading an image passed to ReplaceContents after
+  // the plugin releases it, so only recycle images that stayed the plugin's.
+  if (!used_in_replace_contents_ && pp_instance())
+    g_image_data_cache.Get().Add(this);
+#endif
+}
+
+void ImageData::InstanceWasDeleted() {
+  PP_Instance instance = pp_instance();
+  Resource::InstanceWasDeleted();
+  // This may delete |this|, so it must be the last thing done here.
+  g_image_data_cache.Get().DidDeleteInstance(instance);
+}
+
 PP_Bool ImageData::Describe(PP_ImageDataDesc* desc) {
   memcpy(desc, &desc_, sizeof(PP_ImageDataDesc));
   return PP_TRUE;
@@ -100,6 +192,14 @@ skia::PlatformCanvas* ImageData::GetPlatformCanvas() {
 #endif
 }
 
+// static
+scoped_refptr<ImageData> ImageData::TakeRecycledImage(
+    PP_Instance instance,
+    PP_ImageDataFormat format,
+    const PP_Size& size) {
+  return g_image_data_cache.Get().Take(instance, format, size);
+}
+
 // static
 ImageHandle ImageData::NullHandle() {
 #if defined(OS_WIN)
@@ -137,6 +237,20 @@ PP_Resource PPB_ImageData_Proxy::CreateProxyResource(PP_Instance instance,
   if (!dispatcher)
     return 0;
 
+  scoped_refptr<ImageData> recycled =
+      ImageData::TakeRecycledImage(instance, format, size);
+  if (recycled) {
+    PP_Resource resource = recycled->GetReference();
+    if (PP_ToBool(init_to_zero)) {
+      void* bits = recycled->Map();
+      if (bits) {
+        memset(bits, 0,
+               recycled->desc().stride * recycled->desc().size.height);
+      }
+    }
+    return resource;
+  }
+
   HostResource result;
   std::string image_data_desc;
   ImageHandle image_handle = ImageData::NullHandle();
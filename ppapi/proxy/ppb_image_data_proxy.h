@@ -5,6 +5,7 @@
 #ifndef PPAPI_PPB_IMAGE_DATA_PROXY_H_
 #define PPAPI_PPB_IMAGE_DATA_PROXY_H_
 
+#include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "build/build_config.h"
 #include "ppapi/c/pp_bool.h"
@@ -39,6 +40,8 @@ class ImageData : public ppapi::Resource,
 
   // Resource overrides.
   virtual ppapi::thunk::PPB_ImageData_API* AsPPB_ImageData_API() OVERRIDE;
+  virtual void LastPluginRefWasDeleted() OVERRIDE;
+  virtual void InstanceWasDeleted() OVERRIDE;
 
   // PPB_ImageData API.
   virtual PP_Bool Describe(PP_ImageDataDesc* desc) OVERRIDE;
@@ -49,12 +52,27 @@ class ImageData : public ppapi::Resource,
 
   const PP_ImageDataDesc& desc() const { return desc_; }
 
+  // Called by Graphics2D when the host takes ownership of this image's
+  // memory. Such images are never recycled once the plugin releases them.
+  void set_used_in_replace_contents() { used_in_replace_contents_ = true; }
+
+  // Returns a recycled image of the given format and size that the plugin
+  // released earlier, and that no Graphics2D still needs for a flush in
+  // progress, or NULL if there isn't one. Reusing an image saves a sync
+  // message to the renderer, an allocation and a mapping for plugins that
+  // create a new image for every frame.
+  static scoped_refptr<ImageData> TakeRecycledImage(PP_Instance instance,
+                                      PP_ImageDataFormat format,
+                                      const PP_Size& size);
+
   static ImageHandle NullHandle();
   static ImageHandle HandleFromInt(int32_t i);
 
  private:
   PP_ImageDataDesc desc_;
 
+  bool used_in_replace_contents_;
+
 #if defined(OS_NACL)
   // TODO(brettw) implement this (see .cc file).
 #else
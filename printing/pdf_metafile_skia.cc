@@ -28,8 +28,12 @@
 namespace printing {
 
 struct PdfMetafileSkiaData {
+  PdfMetafileSkiaData() : pdf_doc_(new SkPDFDocument) {}
+
   SkRefPtr<SkPDFDevice> current_page_;
-  SkPDFDocument pdf_doc_;
+  // The pages appended so far. Released once the document is emitted to
+  // |pdf_stream_|, since it holds every page's content and resources.
+  scoped_ptr<SkPDFDocument> pdf_doc_;
   SkDynamicMemoryWStream pdf_stream_;
 #if defined(OS_MACOSX)
   PdfMetafileCg pdf_cg_;
@@ -78,8 +82,9 @@ bool PdfMetafileSkia::StartPage(const gfx::Size& page_size,
 
 bool PdfMetafileSkia::FinishPage() {
   DCHECK(data_->current_page_.get());
+  DCHECK(data_->pdf_doc_.get());
 
-  data_->pdf_doc_.appendPage(data_->current_page_.get());
+  data_->pdf_doc_->appendPage(data_->current_page_.get());
   page_outstanding_ = false;
   return true;
 }
@@ -95,7 +100,7 @@ bool PdfMetafileSkia::FinishDocument() {
   data_->current_page_ = NULL;
 
   int font_counts[SkAdvancedTypefaceMetrics::kNotEmbeddable_Font + 1];
-  data_->pdf_doc_.getCountOfFontTypes(font_counts);
+  data_->pdf_doc_->getCountOfFontTypes(font_counts);
   for (int type = 0;
        type <= SkAdvancedTypefaceMetrics::kNotEmbeddable_Font;
        type++) {
@@ -106,7 +111,9 @@ bool PdfMetafileSkia::FinishDocument() {
     }
   }
 
-  return data_->pdf_doc_.emitPDF(&data_->pdf_stream_);
+  bool result = data_->pdf_doc_->emitPDF(&data_->pdf_stream_);
+  data_->pdf_doc_.reset();
+  return result;
 }
 
 uint32 PdfMetafileSkia::GetDataSize() const {
@@ -118,8 +125,9 @@ bool PdfMetafileSkia::GetData(void* dst_buffer,
   if (dst_buffer_size < GetDataSize())
     return false;
 
-  SkAutoDataUnref data(data_->pdf_stream_.copyToData());
-  memcpy(dst_buffer, data.bytes(), dst_buffer_size);
+  // Copy straight out of the stream's blocks, rather than through a
+  // contiguous copy of the whole document.
+  data_->pdf_stream_.copyTo(dst_buffer);
   return true;
 }
 
@@ -142,15 +142,23 @@ void DecoderVp8::RenderFrame(const SkISize& view_size,
     return;
   }
 
+  // Determine the scaled area affected by the changed rectangles first.
+  // ScaleRect() rounds outwards, so when down-scaling the scaled rectangles
+  // of neighbouring updates overlap; merging them means each output pixel is
+  // converted only once.
+  SkRegion scaled_region;
   for (SkRegion::Iterator i(updated_region_); !i.done(); i.next()) {
-    // Determine the scaled area affected by this rectangle changing.
     SkIRect rect = i.rect();
     if (!rect.intersect(source_clip))
       continue;
     rect = ScaleRect(rect, screen_size_, view_size);
     if (!rect.intersect(clip_area))
       continue;
+    scaled_region.op(rect, SkRegion::kUnion_Op);
+  }
 
+  for (SkRegion::Iterator i(scaled_region); !i.done(); i.next()) {
+    const SkIRect& rect = i.rect();
     ConvertAndScaleYUVToRGB32Rect(last_image_->planes[0],
                                   last_image_->planes[1],
                                   last_image_->planes[2],
@@ -163,9 +171,8 @@ void DecoderVp8::RenderFrame(const SkISize& view_size,
                                   view_size,
                                   clip_area,
                                   rect);
-
-    output_region->op(rect, SkRegion::kUnion_Op);
   }
+  output_region->op(scaled_region, SkRegion::kUnion_Op);
 
   updated_region_.op(ScaleRect(clip_area, view_size, screen_size_),
                      SkRegion::kDifference_Op);
@@ -146,6 +146,14 @@ bool EncoderVp8::Init(const SkISize& size) {
   // on motion estimation and inter-prediction mode.
   if (vpx_codec_control(codec_.get(), VP8E_SET_NOISE_SENSITIVITY, 0))
     return false;
+
+  // Each macroblock row's tokens go to partition (row % partitions). With a
+  // single partition the threads of DecoderVp8 take turns on one bool
+  // decoder, so match the two threads it uses.
+  if (vpx_codec_control(codec_.get(), VP8E_SET_TOKEN_PARTITIONS,
+                        VP8_TWO_TOKENPARTITION)) {
+    return false;
+  }
   return true;
 }
 
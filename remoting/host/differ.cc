@@ -59,7 +59,10 @@ void Differ::MarkDirtyBlocks(const void* prev_buffer, const void* curr_buffer) {
   // Offset from the start of one block-column to the next.
   int block_x_offset = bytes_per_pixel_ * kBlockSize;
   // Offset from the start of one block-row to the next.
-  int block_y_stride = (width_ * bytes_per_pixel_) * kBlockSize;
+  int block_y_stride = bytes_per_row_ * kBlockSize;
+  // Number of bytes from the first pixel of a block-row to the last.
+  int block_row_bytes =
+      bytes_per_row_ * (kBlockSize - 1) + width_ * bytes_per_pixel_;
   // Offset from the start of one diff_info row to the next.
   int diff_info_stride = diff_info_width_ * sizeof(DiffInfo);
 
@@ -68,25 +71,31 @@ void Differ::MarkDirtyBlocks(const void* prev_buffer, const void* curr_buffer) {
   DiffInfo* diff_info_row_start = static_cast<DiffInfo*>(diff_info_.get());
 
   for (int y = 0; y < y_full_blocks; y++) {
-    const uint8* prev_block = prev_block_row_start;
-    const uint8* curr_block = curr_block_row_start;
-    DiffInfo* diff_info = diff_info_row_start;
-
-    for (int x = 0; x < x_full_blocks; x++) {
-      // Mark this block as being modified so that it gets incorporated into
-      // a dirty rect.
-      *diff_info = BlockDifference(prev_block, curr_block, bytes_per_row_);
-      prev_block += block_x_offset;
-      curr_block += block_x_offset;
-      diff_info += sizeof(DiffInfo);
-    }
+    // Most of the screen is usually unchanged, and a single memcmp() of a
+    // whole block-row is much faster than comparing it block by block. Only
+    // block-rows that differ somewhere are looked at block by block.
+    if (memcmp(prev_block_row_start, curr_block_row_start,
+               block_row_bytes) != 0) {
+      const uint8* prev_block = prev_block_row_start;
+      const uint8* curr_block = curr_block_row_start;
+      DiffInfo* diff_info = diff_info_row_start;
+
+      for (int x = 0; x < x_full_blocks; x++) {
+        // Mark this block as being modified so that it gets incorporated into
+        // a dirty rect.
+        *diff_info = BlockDifference(prev_block, curr_block, bytes_per_row_);
+        prev_block += block_x_offset;
+        curr_block += block_x_offset;
+        diff_info += sizeof(DiffInfo);
+      }
 
-    // If there is a partial column at the end, handle it.
-    // This condition should rarely, if ever, occur.
-    if (partial_column_width != 0) {
-      *diff_info = DiffPartialBlock(prev_block, curr_block, bytes_per_row_,
-                                    partial_column_width, kBlockSize);
-      diff_info += sizeof(DiffInfo);
+      // If there is a partial column at the end, handle it.
+      // This condition should rarely, if ever, occur.
+      if (partial_column_width != 0) {
+        *diff_info = DiffPartialBlock(prev_block, curr_block, bytes_per_row_,
+                                      partial_column_width, kBlockSize);
+        diff_info += sizeof(DiffInfo);
+      }
     }
 
     // Update pointers for next row.
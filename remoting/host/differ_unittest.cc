@@ -25,11 +25,15 @@ class DifferTest : public testing::Test {
 
  protected:
   void InitDiffer(int width, int height) {
+    InitDiffer(width, height, kBytesPerPixel * width);
+  }
+
+  void InitDiffer(int width, int height, int stride) {
     width_ = width;
     height_ = height;
     bytes_per_pixel_ = kBytesPerPixel;
-    stride_ = (kBytesPerPixel * width);
-    buffer_size_ = width_ * height_ * bytes_per_pixel_;
+    stride_ = stride;
+    buffer_size_ = height_ * stride_;
 
     differ_.reset(new Differ(width_, height_, bytes_per_pixel_, stride_));
 
@@ -256,6 +260,27 @@ TEST_F(DifferTest, MarkDirtyBlocks_Sampling) {
   EXPECT_EQ(0, GetDiffInfo(2, 2));
 }
 
+TEST_F(DifferTest, MarkDirtyBlocks_Stride) {
+  // Rows are padded to a stride wider than the screen.
+  InitDiffer(kScreenWidth, kScreenHeight,
+             kBytesPerPixel * (kScreenWidth + kBlockSize));
+  ClearDiffInfo();
+
+  // Changes to the padding are not part of the screen.
+  for (int y = 0; y < kScreenHeight; y++)
+    WritePixel(curr_.get(), kScreenWidth + 1, y, 0xff00ff);
+  WriteBlockPixel(curr_.get(), 2, 1, 10, 10, 0xff00ff);
+
+  MarkDirtyBlocks(prev_.get(), curr_.get());
+
+  for (int y = 0; y < GetDiffInfoHeight() - 1; y++) {
+    for (int x = 0; x < GetDiffInfoWidth() - 1; x++) {
+      EXPECT_EQ(x == 2 && y == 1 ? 1 : 0, GetDiffInfo(x, y))
+          << "when x = " << x << ", and y = " << y;
+    }
+  }
+}
+
 TEST_F(DifferTest, DiffBlock) {
   InitDiffer(kScreenWidth, kScreenHeight);
 
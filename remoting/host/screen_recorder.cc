@@ -183,7 +183,7 @@ void ScreenRecorder::DoCapture() {
                         &ScreenRecorder::DoCapture);
 
   // And finally perform one capture.
-  capture_start_time_ = base::Time::Now();
+  capture_start_time_ = base::TimeTicks::Now();
   capturer()->CaptureInvalidRegion(
       base::Bind(&ScreenRecorder::CaptureDoneCallback, this));
 }
@@ -196,7 +196,8 @@ void ScreenRecorder::CaptureDoneCallback(
     return;
 
   if (capture_data) {
-    base::TimeDelta capture_time = base::Time::Now() - capture_start_time_;
+    base::TimeDelta capture_time =
+        base::TimeTicks::Now() - capture_start_time_;
     int capture_time_ms =
         static_cast<int>(capture_time.InMilliseconds());
     capture_data->set_capture_time_ms(capture_time_ms);
@@ -301,7 +302,7 @@ void ScreenRecorder::DoEncode(
     return;
   }
 
-  encode_start_time_ = base::Time::Now();
+  encode_start_time_ = base::TimeTicks::Now();
   encoder()->Encode(
       capture_data, false,
       base::Bind(&ScreenRecorder::EncodedDataAvailableCallback, this));
@@ -327,7 +328,8 @@ void ScreenRecorder::EncodedDataAvailableCallback(
 
   bool last = (packet->flags() & VideoPacket::LAST_PACKET) != 0;
   if (last) {
-    base::TimeDelta encode_time = base::Time::Now() - encode_start_time_;
+    base::TimeDelta encode_time =
+        base::TimeTicks::Now() - encode_start_time_;
     int encode_time_ms =
         static_cast<int>(encode_time.InMilliseconds());
     packet->set_encode_time_ms(encode_time_ms);
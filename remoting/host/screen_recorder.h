@@ -187,10 +187,10 @@ class ScreenRecorder : public base::RefCountedThreadSafe<ScreenRecorder> {
   int frame_skipped_;
 
   // Time when capture is started.
-  base::Time capture_start_time_;
+  base::TimeTicks capture_start_time_;
 
   // Time when encode is started.
-  base::Time encode_start_time_;
+  base::TimeTicks encode_start_time_;
 
   // This is a number updated by client to trace performance.
   int64 sequence_number_;
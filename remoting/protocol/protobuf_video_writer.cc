@@ -5,15 +5,49 @@
 #include "remoting/protocol/protobuf_video_writer.h"
 
 #include "base/bind.h"
+#include "net/base/io_buffer.h"
 #include "net/socket/stream_socket.h"
 #include "remoting/base/constants.h"
 #include "remoting/proto/video.pb.h"
+#include "remoting/protocol/buffered_socket_writer.h"
 #include "remoting/protocol/session.h"
 #include "remoting/protocol/util.h"
+#include "third_party/libjingle/source/talk/base/byteorder.h"
+#include "third_party/protobuf/src/google/protobuf/io/coded_stream.h"
+#include "third_party/protobuf/src/google/protobuf/wire_format_lite.h"
+
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
 
 namespace remoting {
 namespace protocol {
 
+namespace {
+
+// IOBufferWithSize that takes over the contents of a string instead of
+// copying them.
+class SwappedStringIOBuffer : public net::IOBufferWithSize {
+ public:
+  explicit SwappedStringIOBuffer(std::string* data)
+      : net::IOBufferWithSize(static_cast<char*>(NULL), data->size()) {
+    string_data_.swap(*data);
+    data_ = const_cast<char*>(string_data_.data());
+  }
+
+ private:
+  virtual ~SwappedStringIOBuffer() {
+    // We haven't allocated the buffer, so remove it before the base class
+    // destructor tries to delete[] it.
+    data_ = NULL;
+  }
+
+  std::string string_data_;
+
+  DISALLOW_COPY_AND_ASSIGN(SwappedStringIOBuffer);
+};
+
+}  // namespace
+
 ProtobufVideoWriter::ProtobufVideoWriter(base::MessageLoopProxy* message_loop)
     : session_(NULL),
       buffered_writer_(new BufferedSocketWriter(message_loop)) {
@@ -63,7 +97,37 @@ bool ProtobufVideoWriter::is_connected() {
 
 void ProtobufVideoWriter::ProcessVideoPacket(scoped_ptr<VideoPacket> packet,
                                              const base::Closure& done) {
-  buffered_writer_->Write(SerializeAndFrameMessage(*packet), done);
+  if (!packet->has_data() || packet->data().empty()) {
+    buffered_writer_->Write(SerializeAndFrameMessage(*packet), done);
+    return;
+  }
+
+  // The encoded frame is the bulk of the packet, so rather than serializing
+  // it into the framed message, take it out of |packet| and queue it as a
+  // buffer of its own behind the rest of the message. Fields may appear in
+  // any order on the wire, so the data field is simply encoded last.
+  scoped_refptr<net::IOBufferWithSize> data(
+      new SwappedStringIOBuffer(packet->mutable_data()));
+  packet->clear_data();
+
+  const uint32 tag = WireFormatLite::MakeTag(
+      VideoPacket::kDataFieldNumber,
+      WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  const int kExtraBytes = sizeof(int32);
+  int header_size = packet->ByteSize() +
+      CodedOutputStream::VarintSize32(tag) +
+      CodedOutputStream::VarintSize32(data->size());
+  scoped_refptr<net::IOBufferWithSize> header(
+      new net::IOBufferWithSize(kExtraBytes + header_size));
+  talk_base::SetBE32(header->data(), header_size + data->size());
+  uint8* end = reinterpret_cast<uint8*>(header->data()) + kExtraBytes;
+  end = packet->SerializeWithCachedSizesToArray(end);
+  end = CodedOutputStream::WriteTagToArray(tag, end);
+  end = CodedOutputStream::WriteVarint32ToArray(data->size(), end);
+  DCHECK_EQ(reinterpret_cast<uint8*>(header->data()) + header->size(), end);
+
+  buffered_writer_->Write(header, base::Closure());
+  buffered_writer_->Write(data, done);
 }
 
 int ProtobufVideoWriter::GetPendingPackets() {
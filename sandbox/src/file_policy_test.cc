@@ -155,6 +155,38 @@ SBOX_TESTS_COMMAND int File_OpenSys32(int argc, wchar_t **argv) {
   return SBOX_TEST_FAILED;
 }
 
+// Opens the file in the second parameter with the NtOpenFile api as many times
+// as the first parameter says. Used to time the round trip to the broker.
+SBOX_TESTS_COMMAND int File_OpenSys32Repeatedly(int argc, wchar_t **argv) {
+  BINDNTDLL(NtOpenFile);
+  BINDNTDLL(RtlInitUnicodeString);
+  if (!NtOpenFile || !RtlInitUnicodeString)
+    return SBOX_TEST_FAILED_TO_EXECUTE_COMMAND;
+
+  if (argc != 2)
+    return SBOX_TEST_FAILED_TO_EXECUTE_COMMAND;
+
+  int count = _wtoi(argv[0]);
+  std::wstring file = MakePathToSys(argv[1], true);
+  UNICODE_STRING object_name;
+  RtlInitUnicodeString(&object_name, file.c_str());
+
+  OBJECT_ATTRIBUTES obj_attributes = {0};
+  InitializeObjectAttributes(&obj_attributes, &object_name,
+                             OBJ_CASE_INSENSITIVE, NULL, NULL);
+
+  for (int i = 0; i < count; ++i) {
+    HANDLE handle;
+    IO_STATUS_BLOCK io_block = {0};
+    NTSTATUS status = NtOpenFile(&handle, FILE_READ_DATA, &obj_attributes,
+                                 &io_block, kSharing, 0);
+    if (!NT_SUCCESS(status))
+      return SBOX_TEST_FAILED;
+    ::CloseHandle(handle);
+  }
+  return SBOX_TEST_SUCCEEDED;
+}
+
 SBOX_TESTS_COMMAND int File_GetDiskSpace(int argc, wchar_t **argv) {
   std::wstring sys_path = MakePathToSys(L"", false);
   if (sys_path.empty()) {
@@ -345,6 +377,31 @@ TEST(FilePolicyTest, AllowNtCreatePatternRule) {
   EXPECT_EQ(SBOX_TEST_SUCCEEDED, runner.RunTest(L"File_OpenSys32 appwiz.cpl"));
 }
 
+// Measures how many intercepted NtOpenFile calls per second go through the
+// broker. The time of a single call, which includes the process startup, is
+// taken out.
+TEST(FilePolicyTest, InterceptionThroughput) {
+  const int kCalls = 2000;
+  TestRunner runner;
+  runner.SetTimeout(60000);
+  EXPECT_TRUE(runner.AddRuleSys32(TargetPolicy::FILES_ALLOW_ANY, L"App*.dll"));
+
+  DWORD start = ::GetTickCount();
+  ASSERT_EQ(SBOX_TEST_SUCCEEDED,
+            runner.RunTest(L"File_OpenSys32Repeatedly 1 appmgmts.dll"));
+  DWORD single_call_ms = ::GetTickCount() - start;
+
+  wchar_t command[MAX_PATH];
+  wsprintf(command, L"File_OpenSys32Repeatedly %d appmgmts.dll", kCalls);
+  start = ::GetTickCount();
+  ASSERT_EQ(SBOX_TEST_SUCCEEDED, runner.RunTest(command));
+  DWORD calls_ms = ::GetTickCount() - start;
+
+  DWORD elapsed_ms = calls_ms > single_call_ms ? calls_ms - single_call_ms : 1;
+  printf("Intercepted NtOpenFile: %d calls in %lu ms, %.0f calls/s\n",
+         kCalls - 1, elapsed_ms, (kCalls - 1) * 1000.0 / elapsed_ms);
+}
+
 TEST(FilePolicyTest, CheckNotFound) {
   TestRunner runner;
   EXPECT_TRUE(runner.AddRuleSys32(TargetPolicy::FILES_ALLOW_ANY, L"n*.dll"));
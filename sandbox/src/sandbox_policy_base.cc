@@ -35,6 +35,8 @@ const size_t kOneMemPage = 4096;
 // The IPC and Policy shared memory sizes.
 const size_t kIPCMemSize = kOneMemPage * 2;
 const size_t kPolMemSize = kOneMemPage * 14;
+// The number of EvalPolicy() results kept before the cache starts over.
+const size_t kMaxEvalCacheEntries = 1024;
 
 // Helper function to allocate space (on the heap) for policy.
 sandbox::PolicyGlobal* MakeBrokerPolicyMemory() {
@@ -46,6 +48,36 @@ sandbox::PolicyGlobal* MakeBrokerPolicyMemory() {
   policy->data_size = kTotalPolicySz - sizeof(sandbox::PolicyGlobal);
   return policy;
 }
+
+// Builds the key under which the result of evaluating |params| for |service|
+// is cached. Returns false if one of the parameters can't be part of a key.
+bool MakeEvalCacheKey(int service,
+                      sandbox::CountedParameterSetBase* params,
+                      std::wstring* key) {
+  key->assign(1, static_cast<wchar_t>(service));
+  for (int i = 0; i < params->count; i++) {
+    const sandbox::ParameterSet& param = params->parameters[i];
+    unsigned long number = 0;
+    const void* pointer = NULL;
+    const wchar_t* string = NULL;
+    if (param.Get(&number)) {
+      key->push_back(L'u');
+      key->append(reinterpret_cast<const wchar_t*>(&number),
+                  sizeof(number) / sizeof(wchar_t));
+    } else if (param.Get(&pointer)) {
+      key->push_back(L'p');
+      key->append(reinterpret_cast<const wchar_t*>(&pointer),
+                  sizeof(pointer) / sizeof(wchar_t));
+    } else if (param.Get(&string) && string) {
+      key->push_back(L's');
+      key->append(string);
+      key->push_back(L'\0');
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
 }
 
 namespace sandbox {
@@ -70,6 +102,7 @@ PolicyBase::PolicyBase()
       use_alternate_desktop_(false),
       use_alternate_winstation_(false) {
   ::InitializeCriticalSection(&lock_);
+  ::InitializeCriticalSection(&eval_cache_lock_);
   // Initialize the IPC dispatcher array.
   memset(&ipc_targets_, NULL, sizeof(ipc_targets_));
   Dispatcher* dispatcher = NULL;
@@ -117,6 +150,7 @@ PolicyBase::~PolicyBase() {
   delete ipc_targets_[IPC_DUPLICATEHANDLEPROXY_TAG];
   delete policy_maker_;
   delete policy_;
+  ::DeleteCriticalSection(&eval_cache_lock_);
   ::DeleteCriticalSection(&lock_);
 }
 
@@ -229,6 +263,7 @@ ResultCode PolicyBase::CreateAlternateDesktop(bool alternate_winstation) {
 bool PolicyBase::AddTarget(TargetProcess* target) {
   if (NULL != policy_)
     policy_maker_->Done();
+  ClearEvalCache();
 
   if (!SetupAllInterceptions(target))
     return false;
@@ -355,19 +390,42 @@ EvalResult PolicyBase::EvalPolicy(int service,
         return SIGNAL_ALARM;
       }
     }
+    std::wstring key;
+    bool cacheable = MakeEvalCacheKey(service, params, &key);
+    if (cacheable) {
+      AutoLock lock(&eval_cache_lock_);
+      EvalCache::const_iterator it = eval_cache_.find(key);
+      if (it != eval_cache_.end())
+        return it->second;
+    }
+
+    EvalResult eval = DENY_ACCESS;
     PolicyProcessor pol_evaluator(policy_->entry[service]);
     PolicyResult result =  pol_evaluator.Evaluate(kShortEval,
                                                   params->parameters,
                                                   params->count);
     if (POLICY_MATCH == result) {
-      return pol_evaluator.GetAction();
+      eval = pol_evaluator.GetAction();
     }
     DCHECK(POLICY_ERROR != result);
+
+    if (cacheable) {
+      AutoLock lock(&eval_cache_lock_);
+      if (eval_cache_.size() >= kMaxEvalCacheEntries)
+        eval_cache_.clear();
+      eval_cache_[key] = eval;
+    }
+    return eval;
   }
 
   return DENY_ACCESS;
 }
 
+void PolicyBase::ClearEvalCache() {
+  AutoLock lock(&eval_cache_lock_);
+  eval_cache_.clear();
+}
+
 // When an IPC is ready in any of the targets we get called. We manage an array
 // of IPC dispatchers which are keyed on the IPC tag so we normally delegate
 // to the appropriate dispatcher unless we can handle the IPC call ourselves.
@@ -8,6 +8,8 @@
 #include <windows.h>
 
 #include <list>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "base/basictypes.h"
@@ -144,6 +146,9 @@ class PolicyBase : public Dispatcher, public TargetPolicy {
   // Sets up the handle closer for a new target.
   bool SetupHandleCloser(TargetProcess* target);
 
+  // Forgets the cached EvalPolicy() results.
+  void ClearEvalCache();
+
   // This lock synchronizes operations on the targets_ collection.
   CRITICAL_SECTION lock_;
   // Maintains the list of target process associated with this policy.
@@ -177,6 +182,13 @@ class PolicyBase : public Dispatcher, public TargetPolicy {
   // target process. A null set means we need to close all handles of the
   // given type.
   HandleCloser handle_closer_;
+  // The results of EvalPolicy(), keyed on the service and the parameter
+  // values. The policy doesn't change once the targets run, and they ask for
+  // the same files and keys over and over.
+  typedef std::map<std::wstring, EvalResult> EvalCache;
+  EvalCache eval_cache_;
+  // This lock synchronizes access to eval_cache_ from the IPC threads.
+  CRITICAL_SECTION eval_cache_lock_;
 
   static HDESK alternate_desktop_handle_;
   static HWINSTA alternate_winstation_handle_;
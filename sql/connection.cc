@@ -8,6 +8,7 @@
 
 #include "base/file_path.h"
 #include "base/logging.h"
+#include "base/metrics/histogram.h"
 #include "base/string_util.h"
 #include "base/stringprintf.h"
 #include "base/utf_string_conversions.h"
@@ -21,6 +22,9 @@ namespace {
 // TODO(shess): Better story on this.  http://crbug.com/56559
 const int kBusyTimeoutSeconds = 1;
 
+// Default for Connection::set_slow_step_threshold().
+const int kSlowStepThresholdSeconds = 1;
+
 class ScopedBusyTimeout {
  public:
   explicit ScopedBusyTimeout(sqlite3* db)
@@ -87,14 +91,29 @@ Connection::Connection()
       page_size_(0),
       cache_size_(0),
       exclusive_locking_(false),
+      write_ahead_log_(false),
+      read_only_(false),
       transaction_nesting_(0),
-      needs_rollback_(false) {
+      needs_rollback_(false),
+      step_time_histogram_(NULL),
+      slow_step_threshold_(
+          base::TimeDelta::FromSeconds(kSlowStepThresholdSeconds)) {
 }
 
 Connection::~Connection() {
   Close();
 }
 
+void Connection::set_histogram_tag(const std::string& tag) {
+  histogram_tag_ = tag;
+  step_time_histogram_ = base::Histogram::FactoryTimeGet(
+      "Sqlite.StepTime." + tag,
+      base::TimeDelta::FromMilliseconds(1),
+      base::TimeDelta::FromSeconds(10),
+      50,
+      base::Histogram::kUmaTargetedHistogramFlag);
+}
+
 bool Connection::Open(const FilePath& path) {
 #if defined(OS_WIN)
   return OpenInternal(WideToUTF8(path.value()));
@@ -461,7 +480,10 @@ bool Connection::OpenInternal(const std::string& file_name) {
     return false;
   }
 
-  int err = sqlite3_open(file_name.c_str(), &db_);
+  DCHECK(!(write_ahead_log_ && (exclusive_locking_ || read_only_)));
+  int flags = read_only_ ? SQLITE_OPEN_READONLY :
+                           SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+  int err = sqlite3_open_v2(file_name.c_str(), &db_, flags, NULL);
   if (err != SQLITE_OK) {
     OnSqliteError(err, NULL);
     Close();
@@ -492,17 +514,6 @@ bool Connection::OpenInternal(const std::string& file_name) {
       DLOG(FATAL) << "Could not set locking mode: " << GetErrorMessage();
   }
 
-  // http://www.sqlite.org/pragma.html#pragma_journal_mode
-  // DELETE (default) - delete -journal file to commit.
-  // TRUNCATE - truncate -journal file to commit.
-  // PERSIST - zero out header of -journal file to commit.
-  // journal_size_limit provides size to trim to in PERSIST.
-  // TODO(shess): Figure out if PERSIST and journal_size_limit really
-  // matter.  In theory, it keeps pages pre-allocated, so if
-  // transactions usually fit, it should be faster.
-  ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
-  ignore_result(Execute("PRAGMA journal_size_limit = 16384"));
-
   const base::TimeDelta kBusyTimeout =
     base::TimeDelta::FromSeconds(kBusyTimeoutSeconds);
 
@@ -523,6 +534,28 @@ bool Connection::OpenInternal(const std::string& file_name) {
       DLOG(FATAL) << "Could not set cache size: " << GetErrorMessage();
   }
 
+  // http://www.sqlite.org/pragma.html#pragma_journal_mode
+  // DELETE (default) - delete -journal file to commit.
+  // TRUNCATE - truncate -journal file to commit.
+  // PERSIST - zero out header of -journal file to commit.
+  // WAL - append to a -wal file, which is checkpointed into the database.
+  // journal_size_limit provides size to trim to in PERSIST and WAL.
+  // TODO(shess): Figure out if PERSIST and journal_size_limit really
+  // matter.  In theory, it keeps pages pre-allocated, so if
+  // transactions usually fit, it should be faster.
+  // This comes after setting the page size, which can't change once a
+  // database in WAL mode has been written. A read-only connection leaves
+  // the journal alone, since the connection that owns the database may be
+  // using it.
+  if (write_ahead_log_) {
+    if (!ExecuteWithTimeout("PRAGMA journal_mode = WAL", kBusyTimeout))
+      DLOG(FATAL) << "Could not enable write-ahead log: " << GetErrorMessage();
+  } else if (!read_only_) {
+    ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
+  }
+  if (!read_only_)
+    ignore_result(Execute("PRAGMA journal_size_limit = 16384"));
+
   if (!ExecuteWithTimeout("PRAGMA secure_delete=ON", kBusyTimeout)) {
     DLOG(FATAL) << "Could not enable secure_delete: " << GetErrorMessage();
     Close();
@@ -562,6 +595,18 @@ void Connection::ClearCache() {
     (*i)->Close();
 }
 
+void Connection::RecordStepTime(sqlite3_stmt* stmt, base::TimeDelta elapsed) {
+  if (step_time_histogram_)
+    step_time_histogram_->AddTime(elapsed);
+
+  if (slow_step_threshold_ > base::TimeDelta() &&
+      elapsed >= slow_step_threshold_) {
+    LOG(WARNING) << "Slow SQL step (" << elapsed.InMilliseconds() << "ms"
+                 << (histogram_tag_.empty() ? "" : ", ") << histogram_tag_
+                 << "): " << sqlite3_sql(stmt);
+  }
+}
+
 int Connection::OnSqliteError(int err, sql::Statement *stmt) {
   if (error_delegate_.get())
     return error_delegate_->OnError(err, this, stmt);
@@ -20,6 +20,10 @@ class FilePath;
 struct sqlite3;
 struct sqlite3_stmt;
 
+namespace base {
+class Histogram;
+}
+
 namespace sql {
 
 class Statement;
@@ -139,6 +143,23 @@ class SQL_EXPORT Connection {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to use a write-ahead log instead of a rollback journal. Other
+  // connections to the same file can then read the last committed state while
+  // this one is in a write transaction, and commits do not wait for them to
+  // finish reading. Do not combine with set_exclusive_locking(), which keeps
+  // other connections out.
+  //
+  // This must be called before Open() to have an effect.
+  void set_write_ahead_log() { write_ahead_log_ = true; }
+
+  // Call to open the database read-only, for example to run queries on a
+  // second thread against a database whose owner uses set_write_ahead_log().
+  // The database must already exist, and its settings are left as the owner
+  // made them.
+  //
+  // This must be called before Open() to have an effect.
+  void set_read_only() { read_only_ = true; }
+
   // Sets the object that will handle errors. Recomended that it should be set
   // before calling Open(). If not set, the default is to ignore errors on
   // release and assert on debug builds.
@@ -146,6 +167,18 @@ class SQL_EXPORT Connection {
     error_delegate_ = delegate;
   }
 
+  // Names the database for profiling, e.g. "History". The time taken by each
+  // step of its statements is recorded in the Sqlite.StepTime.<tag>
+  // histogram. Nothing is recorded for untagged databases.
+  void set_histogram_tag(const std::string& tag);
+
+  // Steps taking at least |threshold| are logged along with their SQL, to
+  // point at queries that need an index. Defaults to one second; zero turns
+  // the log off.
+  void set_slow_step_threshold(base::TimeDelta threshold) {
+    slow_step_threshold_ = threshold;
+  }
+
   // Initialization ------------------------------------------------------------
 
   // Initializes the SQL connection for the given file, returning true if the
@@ -380,6 +413,10 @@ class SQL_EXPORT Connection {
   // Frees all cached statements from statement_cache_.
   void ClearCache();
 
+  // Called by Statement objects after each sqlite3_step() of |stmt|, with
+  // the time it took.
+  void RecordStepTime(sqlite3_stmt* stmt, base::TimeDelta elapsed);
+
   // Called by Statement objects when an sqlite function returns an error.
   // The return value is the error code reflected back to client code.
   int OnSqliteError(int err, Statement* stmt);
@@ -397,6 +434,8 @@ class SQL_EXPORT Connection {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool write_ahead_log_;
+  bool read_only_;
 
   // All cached statements. Keeping a reference to these statements means that
   // they'll remain active.
@@ -422,6 +461,14 @@ class SQL_EXPORT Connection {
   // commands or statements. It can be null which means default handling.
   scoped_refptr<ErrorDelegate> error_delegate_;
 
+  // See set_histogram_tag(). |step_time_histogram_| is NULL when there is no
+  // tag.
+  std::string histogram_tag_;
+  base::Histogram* step_time_histogram_;
+
+  // See set_slow_step_threshold().
+  base::TimeDelta slow_step_threshold_;
+
   DISALLOW_COPY_AND_ASSIGN(Connection);
 };
 
@@ -261,3 +261,40 @@ TEST_F(SQLConnectionTest, RazeLocked) {
 // TODO(shess): Spin up a background thread to hold other_db, to more
 // closely match real life.  That would also allow testing
 // RazeWithTimeout().
+
+TEST_F(SQLConnectionTest, ReadWhileWriting) {
+  db().Close();
+  sql::Connection writer;
+  writer.set_write_ahead_log();
+  ASSERT_TRUE(writer.Open(db_path()));
+  ASSERT_TRUE(writer.Execute("CREATE TABLE foo (a)"));
+  ASSERT_TRUE(writer.Execute("INSERT INTO foo (a) VALUES (1)"));
+
+  sql::Connection reader;
+  reader.set_read_only();
+  ASSERT_TRUE(reader.Open(db_path()));
+
+  // The reader sees the last commit while the writer's transaction is open.
+  ASSERT_TRUE(writer.BeginTransaction());
+  ASSERT_TRUE(writer.Execute("INSERT INTO foo (a) VALUES (2)"));
+  {
+    sql::Statement s(reader.GetUniqueStatement("SELECT COUNT(*) FROM foo"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(1, s.ColumnInt(0));
+  }
+
+  // The writer can commit while a read is in progress.
+  {
+    sql::Statement s(reader.GetUniqueStatement("SELECT a FROM foo"));
+    ASSERT_TRUE(s.Step());
+    ASSERT_TRUE(writer.CommitTransaction());
+  }
+  {
+    sql::Statement s(reader.GetUniqueStatement("SELECT COUNT(*) FROM foo"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(2, s.ColumnInt(0));
+  }
+
+  EXPECT_EQ(SQLITE_READONLY,
+            reader.ExecuteAndReturnErrorCode("INSERT INTO foo (a) VALUES (3)"));
+}
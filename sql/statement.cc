@@ -4,6 +4,7 @@
 
 #include "sql/statement.h"
 
+#include "base/debug/trace_event.h"
 #include "base/logging.h"
 #include "base/string_util.h"
 #include "base/utf_string_conversions.h"
@@ -41,6 +42,16 @@ void Statement::Clear() {
   succeeded_ = false;
 }
 
+int Statement::StepInternal() {
+  TRACE_EVENT1("sql", "Statement::Step",
+               "sql", TRACE_STR_COPY(sqlite3_sql(ref_->stmt())));
+  base::TimeTicks start = base::TimeTicks::Now();
+  int err = sqlite3_step(ref_->stmt());
+  ref_->connection()->RecordStepTime(ref_->stmt(),
+                                     base::TimeTicks::Now() - start);
+  return CheckError(err);
+}
+
 bool Statement::CheckValid() const {
   if (!is_valid())
     DLOG(FATAL) << "Cannot call mutating statements on an invalid statement.";
@@ -51,14 +62,14 @@ bool Statement::Run() {
   if (!CheckValid())
     return false;
 
-  return CheckError(sqlite3_step(ref_->stmt())) == SQLITE_DONE;
+  return StepInternal() == SQLITE_DONE;
 }
 
 bool Statement::Step() {
   if (!CheckValid())
     return false;
 
-  return CheckError(sqlite3_step(ref_->stmt())) == SQLITE_ROW;
+  return StepInternal() == SQLITE_ROW;
 }
 
 void Statement::Reset(bool clear_bound_vars) {
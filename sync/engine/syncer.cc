@@ -229,11 +229,27 @@ void Syncer::SyncShare(sessions::SyncSession* session,
         break;
       }
       case PROCESS_COMMIT_RESPONSE: {
+        StatusController* status = session->mutable_status_controller();
+        const int successful_commits_before =
+            status->syncer_status().num_successful_commits;
         ProcessCommitResponseCommand process_response_command;
-        session->mutable_status_controller()->
-            set_last_process_commit_response_result(
-                process_response_command.Execute(session));
-        next_step = RESOLVE_CONFLICTS;
+        SyncerError result = process_response_command.Execute(session);
+        status->set_last_process_commit_response_result(result);
+
+        // If every item in the batch was committed and more are waiting,
+        // commit the next batch right away rather than going through another
+        // sync cycle, and another GetUpdates, for each batch.  The committed
+        // items are no longer unsynced, so this terminates.
+        const size_t committed = static_cast<size_t>(
+            status->syncer_status().num_successful_commits -
+            successful_commits_before);
+        if (result == SYNCER_OK &&
+            committed == status->commit_ids().size() &&
+            committed < status->unsynced_handles().size()) {
+          next_step = BUILD_COMMIT_REQUEST;
+        } else {
+          next_step = RESOLVE_CONFLICTS;
+        }
         break;
       }
       case RESOLVE_CONFLICTS: {
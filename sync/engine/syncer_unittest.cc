@@ -2705,12 +2705,12 @@ TEST_F(SyncerTest, CommitManyItemsInOneGo) {
       e.Put(SPECIFICS, DefaultBookmarkSpecifics());
     }
   }
-  uint32 num_loops = 0;
-  while (SyncShareNudge()) {
-    num_loops++;
-    ASSERT_LT(num_loops, max_batches * 2);
-  }
-  EXPECT_GE(mock_server_->commit_messages().size(), max_batches);
+  mock_server_->GetAndClearNumGetUpdatesRequests();
+
+  // All the batches are committed in one sync cycle, with one GetUpdates.
+  EXPECT_FALSE(SyncShareNudge());
+  EXPECT_EQ(max_batches, mock_server_->commit_messages().size());
+  EXPECT_EQ(1, mock_server_->GetAndClearNumGetUpdatesRequests());
 }
 
 TEST_F(SyncerTest, HugeConflict) {
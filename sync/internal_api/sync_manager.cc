@@ -4,6 +4,7 @@
 
 #include "sync/internal_api/sync_manager.h"
 
+#include <algorithm>
 #include <string>
 
 #include "base/base64.h"
@@ -2034,10 +2035,15 @@ void SyncManager::SyncInternal::RequestNudgeForDataTypes(
 
   debug_info_event_listener_.OnNudgeFromDatatype(types.First().Get());
 
-  // TODO(lipalani) : Calculate the nudge delay based on all types.
+  // Pending nudges are coalesced to the earliest start time, so a nudge for
+  // several types is as urgent as its most urgent type.
   base::TimeDelta nudge_delay = NudgeStrategy::GetNudgeDelayTimeDelta(
       types.First().Get(),
       this);
+  for (ModelTypeSet::Iterator it = types.First(); it.Good(); it.Inc()) {
+    nudge_delay = std::min(
+        nudge_delay, NudgeStrategy::GetNudgeDelayTimeDelta(it.Get(), this));
+  }
   scheduler()->ScheduleNudge(nudge_delay,
                              browser_sync::NUDGE_SOURCE_LOCAL,
                              types,
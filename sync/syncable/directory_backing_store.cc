@@ -41,9 +41,11 @@ extern const int32 kCurrentDBVersion;  // Global visibility for our unittest.
 const int32 kCurrentDBVersion = 78;
 
 // Iterate over the fields of |entry| and bind each to |statement| for
-// updating.  Returns the number of args bound.
-void BindFields(const EntryKernel& entry,
-                sql::Statement* statement) {
+// updating, leaving out the specifics unless |bind_specifics| is set.
+// Returns the number of args bound.
+int BindFields(const EntryKernel& entry,
+               bool bind_specifics,
+               sql::Statement* statement) {
   int index = 0;
   int i = 0;
   for (i = BEGIN_FIELDS; i < INT64_FIELDS_END; ++i) {
@@ -63,11 +65,14 @@ void BindFields(const EntryKernel& entry,
   for ( ; i < STRING_FIELDS_END; ++i) {
     statement->BindString(index++, entry.ref(static_cast<StringField>(i)));
   }
+  if (!bind_specifics)
+    return index;
   std::string temp;
   for ( ; i < PROTO_FIELDS_END; ++i) {
     entry.ref(static_cast<ProtoField>(i)).SerializeToString(&temp);
     statement->BindBlob(index++, temp.data(), temp.length());
   }
+  return index;
 }
 
 // The caller owns the returned EntryKernel*.  Assumes the statement currently
@@ -98,6 +103,8 @@ EntryKernel* UnpackEntry(sql::Statement* statement) {
     kernel->mutable_ref(static_cast<ProtoField>(i)).ParseFromArray(
         statement->ColumnBlob(i), statement->ColumnByteLength(i));
   }
+  // The kernel now matches its row.
+  kernel->clear_dirty(NULL);
   return kernel;
 }
 
@@ -473,6 +480,15 @@ bool DirectoryBackingStore::LoadInfo(Directory::KernelLoadInfo* info) {
 }
 
 bool DirectoryBackingStore::SaveEntryToDB(const EntryKernel& entry) {
+  // The specifics are the bulk of an entry, so if they haven't changed just
+  // update the rest of its row. Entries with no row yet are written in full.
+  if (!entry.is_specifics_dirty()) {
+    if (!UpdateEntryToDB(entry))
+      return false;
+    if (db_->GetLastChangeCount() > 0)
+      return true;
+  }
+
   // This statement is constructed at runtime, so we can't use
   // GetCachedStatement() to let the Connection cache it.   We will construct
   // and cache it ourselves the first time this function is called.
@@ -502,10 +518,36 @@ bool DirectoryBackingStore::SaveEntryToDB(const EntryKernel& entry) {
     save_entry_statement_.Reset(true);
   }
 
-  BindFields(entry, &save_entry_statement_);
+  BindFields(entry, true, &save_entry_statement_);
   return save_entry_statement_.Run();
 }
 
+bool DirectoryBackingStore::UpdateEntryToDB(const EntryKernel& entry) {
+  // Like |save_entry_statement_|, this is constructed and cached here.
+  if (!update_entry_statement_.is_valid()) {
+    string query;
+    query.reserve(kUpdateStatementBufferSize);
+    query.append("UPDATE metas SET ");
+    const char* separator = "";
+    for (int i = BEGIN_FIELDS; i < STRING_FIELDS_END; ++i) {
+      query.append(separator);
+      separator = ", ";
+      query.append(ColumnName(i));
+      query.append(" = ?");
+    }
+    query.append(" WHERE metahandle = ?");
+
+    update_entry_statement_.Assign(
+        db_->GetUniqueStatement(query.c_str()));
+  } else {
+    update_entry_statement_.Reset(true);
+  }
+
+  int index = BindFields(entry, false, &update_entry_statement_);
+  update_entry_statement_.BindInt64(index, entry.ref(META_HANDLE));
+  return update_entry_statement_.Run();
+}
+
 bool DirectoryBackingStore::DropDeletedEntries() {
   return db_->Execute("DELETE FROM metas "
                       "WHERE is_del > 0 "
@@ -95,7 +95,7 @@ class DirectoryBackingStore : public base::NonThreadSafe {
 
   // Save/update helpers for entries.  Return false if sqlite commit fails.
   bool SaveEntryToDB(const EntryKernel& entry);
-  bool SaveNewEntryToDB(const EntryKernel& entry);
+  // Updates the row of |entry|, if there is one, leaving out the specifics.
   bool UpdateEntryToDB(const EntryKernel& entry);
 
   DirOpenResult DoLoad(MetahandlesIndex* entry_bucket,
@@ -152,6 +152,7 @@ class DirectoryBackingStore : public base::NonThreadSafe {
 
   scoped_ptr<sql::Connection> db_;
   sql::Statement save_entry_statement_;
+  sql::Statement update_entry_statement_;
   std::string dir_name_;
 
   // Set to true if migration left some old columns around that need to be
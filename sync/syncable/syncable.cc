@@ -279,7 +279,7 @@ bool ParentIdAndHandleIndexer::ShouldInclude(const EntryKernel* a) {
 ///////////////////////////////////////////////////////////////////////////
 // EntryKernel
 
-EntryKernel::EntryKernel() : dirty_(false) {
+EntryKernel::EntryKernel() : dirty_(false), specifics_dirty_(false) {
   // Everything else should already be default-initialized.
   for (int i = INT64_FIELDS_BEGIN; i < INT64_FIELDS_END; ++i) {
     int64_fields[i] = 0;
@@ -985,6 +985,8 @@ void Directory::HandleSaveChangesFailure(const SaveChangesSnapshot& snapshot) {
         kernel_->metahandles_index->find(&kernel_->needle);
     if (found != kernel_->metahandles_index->end()) {
       (*found)->mark_dirty(kernel_->dirty_metahandles);
+      if (i->is_specifics_dirty())
+        (*found)->mark_specifics_dirty();
     }
   }
 
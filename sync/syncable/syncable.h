@@ -286,19 +286,32 @@ struct EntryKernel {
 
   // Clear the dirty bit, and optionally remove this entry's metahandle from
   // a provided index on dirty bits in |dirty_index|. Parameter may be null,
-  // and will result only in clearing dirty bit of this entry.
+  // and will result only in clearing dirty bit of this entry. Also clears
+  // the specifics dirty bit.
   inline void clear_dirty(syncable::MetahandleSet* dirty_index) {
     if (dirty_ && dirty_index) {
       DCHECK_NE(0, ref(META_HANDLE));
       dirty_index->erase(ref(META_HANDLE));
     }
     dirty_ = false;
+    specifics_dirty_ = false;
   }
 
   inline bool is_dirty() const {
     return dirty_;
   }
 
+  // Set whenever a specifics field may have changed since the dirty bits were
+  // last cleared. The specifics are the bulk of an entry, so SaveChanges only
+  // rewrites them when this is set.
+  inline void mark_specifics_dirty() {
+    specifics_dirty_ = true;
+  }
+
+  inline bool is_specifics_dirty() const {
+    return specifics_dirty_;
+  }
+
   // Setters.
   inline void put(MetahandleField field, int64 value) {
     int64_fields[field - INT64_FIELDS_BEGIN] = value;
@@ -333,6 +346,7 @@ struct EntryKernel {
   }
   inline void put(ProtoField field, const sync_pb::EntitySpecifics& value) {
     specifics_fields[field - PROTO_FIELDS_BEGIN].CopyFrom(value);
+    specifics_dirty_ = true;
   }
   inline void put(BitTemp field, bool value) {
     bit_temps[field - BIT_TEMPS_BEGIN] = value;
@@ -378,6 +392,7 @@ struct EntryKernel {
     return string_fields[field - STRING_FIELDS_BEGIN];
   }
   inline sync_pb::EntitySpecifics& mutable_ref(ProtoField field) {
+    specifics_dirty_ = true;
     return specifics_fields[field - PROTO_FIELDS_BEGIN];
   }
   inline Id& mutable_ref(IdField field) {
@@ -393,6 +408,9 @@ struct EntryKernel {
  private:
   // Tracks whether this entry needs to be saved to the database.
   bool dirty_;
+
+  // Tracks whether the specifics need to be rewritten when it is.
+  bool specifics_dirty_;
 };
 
 // A read-only meta entry.
@@ -1401,6 +1401,60 @@ TEST_F(OnDiskSyncableDirectoryTest,
   }
 }
 
+TEST_F(OnDiskSyncableDirectoryTest, TestSpecificsOnlySavedWhenChanged) {
+  sync_pb::EntitySpecifics specifics;
+  specifics.mutable_bookmark()->set_url("http://first");
+  int64 handle = 0;
+  {
+    WriteTransaction trans(FROM_HERE, UNITTEST, dir_.get());
+    MutableEntry entry(&trans, CREATE, trans.root_id(), "name");
+    ASSERT_TRUE(entry.good());
+    entry.Put(SPECIFICS, specifics);
+    EXPECT_TRUE(entry.GetKernelCopy().is_specifics_dirty());
+    handle = entry.Get(META_HANDLE);
+  }
+  SaveAndReloadDir();
+
+  // Changing other fields leaves the specifics alone, on disk as well.
+  {
+    WriteTransaction trans(FROM_HERE, UNITTEST, dir_.get());
+    MutableEntry entry(&trans, GET_BY_HANDLE, handle);
+    ASSERT_TRUE(entry.good());
+    EXPECT_FALSE(entry.GetKernelCopy().is_specifics_dirty());
+    entry.Put(NON_UNIQUE_NAME, "renamed");
+    entry.Put(IS_UNSYNCED, true);
+    EXPECT_TRUE(entry.GetKernelCopy().is_dirty());
+    EXPECT_FALSE(entry.GetKernelCopy().is_specifics_dirty());
+  }
+  SaveAndReloadDir();
+  {
+    ReadTransaction trans(FROM_HERE, dir_.get());
+    Entry entry(&trans, GET_BY_HANDLE, handle);
+    ASSERT_TRUE(entry.good());
+    EXPECT_EQ("renamed", entry.Get(NON_UNIQUE_NAME));
+    EXPECT_TRUE(entry.Get(IS_UNSYNCED));
+    EXPECT_EQ("http://first", entry.Get(SPECIFICS).bookmark().url());
+  }
+
+  // Changed specifics are written.
+  specifics.mutable_bookmark()->set_url("http://second");
+  {
+    WriteTransaction trans(FROM_HERE, UNITTEST, dir_.get());
+    MutableEntry entry(&trans, GET_BY_HANDLE, handle);
+    ASSERT_TRUE(entry.good());
+    entry.Put(SPECIFICS, specifics);
+    EXPECT_TRUE(entry.GetKernelCopy().is_specifics_dirty());
+  }
+  SaveAndReloadDir();
+  {
+    ReadTransaction trans(FROM_HERE, dir_.get());
+    Entry entry(&trans, GET_BY_HANDLE, handle);
+    ASSERT_TRUE(entry.good());
+    EXPECT_EQ("renamed", entry.Get(NON_UNIQUE_NAME));
+    EXPECT_EQ("http://second", entry.Get(SPECIFICS).bookmark().url());
+  }
+}
+
 TEST_F(OnDiskSyncableDirectoryTest, TestSaveChangesFailure) {
   int64 handle1 = 0;
   // Set up an item using a regular, saveable directory.
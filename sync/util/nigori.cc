@@ -18,7 +18,7 @@
 
 using base::Base64Encode;
 using base::Base64Decode;
-using base::RandInt;
+using base::RandBytesAsString;
 using crypto::Encryptor;
 using crypto::HMAC;
 using crypto::SymmetricKey;
@@ -99,7 +99,7 @@ bool Nigori::InitByDerivation(const std::string& hostname,
       kDerivedKeySizeInBits));
   DCHECK(mac_key_.get());
 
-  return user_key_.get() && encryption_key_.get() && mac_key_.get();
+  return InitHmac();
 }
 
 bool Nigori::InitByImport(const std::string& user_key,
@@ -115,7 +115,23 @@ bool Nigori::InitByImport(const std::string& user_key,
   mac_key_.reset(SymmetricKey::Import(SymmetricKey::HMAC_SHA1, mac_key));
   DCHECK(mac_key_.get());
 
-  return user_key_.get() && encryption_key_.get() && mac_key_.get();
+  return InitHmac();
+}
+
+bool Nigori::InitHmac() {
+  if (!user_key_.get() || !encryption_key_.get() || !mac_key_.get())
+    return false;
+
+  std::string raw_mac_key;
+  if (!mac_key_->GetRawKey(&raw_mac_key))
+    return false;
+
+  hmac_.reset(new HMAC(HMAC::SHA256));
+  if (!hmac_->Init(raw_mac_key)) {
+    hmac_.reset();
+    return false;
+  }
+  return true;
 }
 
 // Permute[Kenc,Kmac](type || name)
@@ -135,16 +151,8 @@ bool Nigori::Permute(Type type, const std::string& name,
   if (!encryptor.Encrypt(plaintext.str(), &ciphertext))
     return false;
 
-  std::string raw_mac_key;
-  if (!mac_key_->GetRawKey(&raw_mac_key))
-    return false;
-
-  HMAC hmac(HMAC::SHA256);
-  if (!hmac.Init(raw_mac_key))
-    return false;
-
   std::vector<unsigned char> hash(kHashSize);
-  if (!hmac.Sign(ciphertext, &hash[0], hash.size()))
+  if (!hmac_->Sign(ciphertext, &hash[0], hash.size()))
     return false;
 
   std::string output;
@@ -155,11 +163,7 @@ bool Nigori::Permute(Type type, const std::string& name,
 }
 
 std::string GenerateRandomString(size_t size) {
-  // TODO(albertb): Use a secure random function.
-  std::string random(size, 0);
-  for (size_t i = 0; i < size; ++i)
-    random[i] = RandInt(0, 0xff);
-  return random;
+  return RandBytesAsString(size);
 }
 
 // Enc[Kenc,Kmac](value)
@@ -177,16 +181,8 @@ bool Nigori::Encrypt(const std::string& value, std::string* encrypted) const {
   if (!encryptor.Encrypt(value, &ciphertext))
     return false;
 
-  std::string raw_mac_key;
-  if (!mac_key_->GetRawKey(&raw_mac_key))
-    return false;
-
-  HMAC hmac(HMAC::SHA256);
-  if (!hmac.Init(raw_mac_key))
-    return false;
-
   std::vector<unsigned char> hash(kHashSize);
-  if (!hmac.Sign(ciphertext, &hash[0], hash.size()))
+  if (!hmac_->Sign(ciphertext, &hash[0], hash.size()))
     return false;
 
   std::string output;
@@ -214,16 +210,8 @@ bool Nigori::Decrypt(const std::string& encrypted, std::string* value) const {
                                       input.size() - (kIvSize + kHashSize)));
   std::string hash(input.substr(input.size() - kHashSize, kHashSize));
 
-  std::string raw_mac_key;
-  if (!mac_key_->GetRawKey(&raw_mac_key))
-    return false;
-
-  HMAC hmac(HMAC::SHA256);
-  if (!hmac.Init(raw_mac_key))
-    return false;
-
   std::vector<unsigned char> expected(kHashSize);
-  if (!hmac.Sign(ciphertext, &expected[0], expected.size()))
+  if (!hmac_->Sign(ciphertext, &expected[0], expected.size()))
     return false;
 
   if (hash.compare(0, hash.size(),
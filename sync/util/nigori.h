@@ -11,6 +11,7 @@
 #include "base/memory/scoped_ptr.h"
 
 namespace crypto {
+class HMAC;
 class SymmetricKey;
 }  // namespace crypto
 
@@ -76,9 +77,16 @@ class Nigori {
   static const size_t kSigningIterations = 1004;
 
  private:
+  // Sets up |hmac_| from |mac_key_|, and returns whether all the keys are
+  // ready for use.
+  bool InitHmac();
+
   scoped_ptr<crypto::SymmetricKey> user_key_;
   scoped_ptr<crypto::SymmetricKey> encryption_key_;
   scoped_ptr<crypto::SymmetricKey> mac_key_;
+
+  // Keyed with |mac_key_| once, rather than for every message signed.
+  scoped_ptr<crypto::HMAC> hmac_;
 };
 
 }  // namespace browser_sync
@@ -1982,6 +1982,16 @@ typedef void (GL_APIENTRYP PFNGLCOPYTEXTURECHROMIUM) (GLenum target, GLenum sour
 #define GL_COMMANDS_ISSUED_CHROMIUM 0x84F2
 #endif
 
+/* GL_CHROMIUM_async_pixel_transfers */
+/* Exposes GL_CHROMIUM_async_pixel_transfers.
+ */
+#ifndef GL_CHROMIUM_async_pixel_transfers
+#define GL_CHROMIUM_async_pixel_transfers 1
+// TODO(gman): Get official numbers for these constants.
+#define GL_ASYNC_PIXEL_TRANSFERS_COMPLETED_CHROMIUM 0x6005
+#define GL_UNPACK_ASYNC_UPLOAD_CHROMIUM 0x6006
+#endif
+
 /* GL_CHROMIUM_texture_mailbox */
 #ifndef GL_CHROMIUM_texture_mailbox
 #define GL_CHROMIUM_texture_mailbox 1
@@ -2002,6 +2012,19 @@ typedef void (GL_APIENTRYP PFNGLCONSUMETEXTURECHROMIUM) (GLenum target, const  G
 #endif
 #endif
 
+/* GL_CHROMIUM_sync_point */
+#ifndef GL_CHROMIUM_sync_point
+#define GL_CHROMIUM_sync_point 1
+#ifdef GL_GLEXT_PROTOTYPES
+#define glWaitSyncPointCHROMIUM GLES2_GET_FUN(WaitSyncPointCHROMIUM)
+#if !defined(GLES2_USE_CPP_BINDINGS)
+GL_APICALL void GL_APIENTRY glWaitSyncPointCHROMIUM (GLuint sync_point);
+#endif
+#else
+typedef void (GL_APIENTRYP PFNGLWAITSYNCPOINTCHROMIUM) (GLuint sync_point);
+#endif
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -41,7 +41,7 @@
 
         state->mode == LEN
         strm->avail_in >= 6
-        strm->avail_out >= 258
+        strm->avail_out >= INFLATE_FAST_MIN_OUTPUT
         start >= strm->avail_out
         state->bits < 8
 
@@ -61,8 +61,9 @@
 
     - The maximum bytes that a single length/distance pair can output is 258
       bytes, which is the maximum length that can be coded.  inflate_fast()
-      requires strm->avail_out >= 258 for each loop to avoid checking for
-      output space.
+      requires strm->avail_out >= INFLATE_FAST_MIN_OUTPUT for each loop to
+      avoid checking for output space, which leaves room for the up to 15
+      bytes that a chunked match copy writes past the end of the match.
  */
 void ZLIB_INTERNAL inflate_fast(strm, start)
 z_streamp strm;
@@ -100,7 +101,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     last = in + (strm->avail_in - 5);
     out = strm->next_out - OFF;
     beg = out - (start - strm->avail_out);
-    end = out + (strm->avail_out - 257);
+    end = out + (strm->avail_out - (INFLATE_FAST_MIN_OUTPUT - 1));
 #ifdef INFLATE_STRICT
     dmax = state->dmax;
 #endif
@@ -267,6 +268,22 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                 }
                 else {
                     from = out - dist;          /* copy direct from output */
+                    /* Google: if the match is at least 16 bytes back, each
+                       16-byte chunk only reads bytes that have already been
+                       written, so copy whole chunks and let the last one
+                       run past the end of the match. */
+                    if (dist >= 16) {
+                        unsigned char FAR *chunk_out = out + OFF;
+                        unsigned char FAR *chunk_from = from + OFF;
+                        unsigned chunks = (len + 15) >> 4;
+                        do {
+                            zmemcpy(chunk_out, chunk_from, 16);
+                            chunk_out += 16;
+                            chunk_from += 16;
+                        } while (--chunks);
+                        out += len;
+                        continue;
+                    }
                     do {                        /* minimum length is three */
                         PUP(out) = PUP(from);
                         PUP(out) = PUP(from);
@@ -317,7 +334,8 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     strm->next_out = out + OFF;
     strm->avail_in = (unsigned)(in < last ? 5 + (last - in) : 5 - (in - last));
     strm->avail_out = (unsigned)(out < end ?
-                                 257 + (end - out) : 257 - (out - end));
+                                 (INFLATE_FAST_MIN_OUTPUT - 1) + (end - out) :
+                                 (INFLATE_FAST_MIN_OUTPUT - 1) - (out - end));
     state->hold = hold;
     state->bits = bits;
     return;
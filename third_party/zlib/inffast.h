@@ -8,4 +8,9 @@
    subject to change. Applications should only use zlib.h.
  */
 
+/* Google: inflate_fast() copies matches in 16-byte chunks and may write up
+   to 15 bytes past the end of a match, so it needs that much more output
+   space than the longest match (258 bytes) to be called. */
+#define INFLATE_FAST_MIN_OUTPUT (258 + 15)
+
 void ZLIB_INTERNAL inflate_fast OF((z_streamp strm, unsigned start));
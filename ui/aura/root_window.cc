@@ -222,20 +222,17 @@ void RootWindow::ScheduleFullDraw() {
 }
 
 bool RootWindow::DispatchMouseEvent(MouseEvent* event) {
-  if (mouse_move_hold_count_) {
-    if (event->type() == ui::ET_MOUSE_DRAGGED ||
-        (event->flags() & ui::EF_IS_SYNTHESIZED)) {
-      held_mouse_move_.reset(new MouseEvent(*event, NULL, NULL));
-      return true;
-    } else {
-      DispatchHeldMouseMove();
-    }
+  DispatchHeldTouchMove();
+  if (ShouldHoldMouseEvent(*event)) {
+    held_mouse_move_.reset(new MouseEvent(*event, NULL, NULL));
+    return true;
   }
+  DispatchHeldMouseMove();
   return DispatchMouseEventImpl(event);
 }
 
 bool RootWindow::DispatchKeyEvent(KeyEvent* event) {
-  DispatchHeldMouseMove();
+  DispatchHeldEvents();
   KeyEvent translated_event(*event);
   if (translated_event.key_code() == ui::VKEY_UNKNOWN)
     return false;
@@ -248,7 +245,7 @@ bool RootWindow::DispatchKeyEvent(KeyEvent* event) {
 }
 
 bool RootWindow::DispatchScrollEvent(ScrollEvent* event) {
-  DispatchHeldMouseMove();
+  DispatchHeldEvents();
 #if defined(ENABLE_DIP)
   float scale = GetMonitorScaleFactor(this);
   ui::Transform transform;
@@ -281,64 +278,23 @@ bool RootWindow::DispatchScrollEvent(ScrollEvent* event) {
 
 bool RootWindow::DispatchTouchEvent(TouchEvent* event) {
   DispatchHeldMouseMove();
-#if defined(ENABLE_DIP)
-  float scale = GetMonitorScaleFactor(this);
-  ui::Transform transform;
-  transform.SetScale(scale, scale);
-  transform.ConcatTransform(layer()->transform());
-  event->UpdateForRootTransform(transform);
-#else
-  event->UpdateForRootTransform(layer()->transform());
-#endif
-  bool handled = false;
-
-  GestureConsumer* consumer = gesture_recognizer_->GetTouchLockedTarget(event);
-  ui::TouchStatus status = ui::TOUCH_STATUS_UNKNOWN;
-
-  if (!consumer || !consumer->ignores_events()) {
-    Window* target = static_cast<Window*>(consumer);
-
-    if (!target && HasCapture(capture_window_, ui::CW_LOCK_TOUCH))
-      target = capture_window_;
-
-    if (!target) {
-      target = static_cast<Window*>(
-          gesture_recognizer_->GetTargetForLocation(event->GetLocation()));
+  if (should_hold_mouse_moves_ && waiting_on_compositing_end_ &&
+      event->type() == ui::ET_TOUCH_MOVED) {
+    // Only the latest move of one touch point is held, so that moves of
+    // different points are never reordered.
+    if (held_touch_move_.get() &&
+        held_touch_move_->touch_id() != event->touch_id()) {
+      DispatchHeldTouchMove();
     }
-
-    if (!target && !bounds().Contains(event->location())) {
-      // If the touch is outside the root window, set its target to the
-      // root window.
-      target = this;
-    } else {
-      if (!target)
-        target = GetEventHandlerForPoint(event->location());
-      if (!target)
-        return false;
-
-      TouchEvent translated_event(*event, this, target);
-      status = ProcessTouchEvent(target, &translated_event);
-      handled = status != ui::TOUCH_STATUS_UNKNOWN;
-
-      if (status == ui::TOUCH_STATUS_QUEUED ||
-          status == ui::TOUCH_STATUS_QUEUED_END)
-        gesture_recognizer_->QueueTouchEventForGesture(target, *event);
-    }
-    consumer = target;
+    held_touch_move_.reset(new TouchEvent(*event, NULL, NULL));
+    return true;
   }
-
-  // Get the list of GestureEvents from GestureRecognizer.
-  scoped_ptr<ui::GestureRecognizer::Gestures> gestures;
-  gestures.reset(gesture_recognizer_->ProcessTouchEventForGesture(
-      *event, status, consumer));
-  if (ProcessGestures(gestures.get()))
-    handled = true;
-
-  return handled;
+  DispatchHeldTouchMove();
+  return DispatchTouchEventImpl(event);
 }
 
 bool RootWindow::DispatchGestureEvent(GestureEvent* event) {
-  DispatchHeldMouseMove();
+  DispatchHeldEvents();
 
   Window* target = NULL;
   if (HasCapture(capture_window_, ui::CW_LOCK_TOUCH))
@@ -561,6 +517,15 @@ void RootWindow::OnCompositingStarted(ui::Compositor*) {
 void RootWindow::OnCompositingEnded(ui::Compositor*) {
   TRACE_EVENT_ASYNC_END0("ui", "RootWindow::Draw", draw_trace_count_);
   waiting_on_compositing_end_ = false;
+  if (held_touch_move_.get() ||
+      (held_mouse_move_.get() && !mouse_move_hold_count_)) {
+    // Moves held during the frame are dispatched from a task, rather than
+    // from within the compositor's notification.
+    MessageLoop::current()->PostTask(
+        FROM_HERE,
+        base::Bind(&RootWindow::DispatchHeldMovesAfterFrame,
+                   event_factory_.GetWeakPtr()));
+  }
   if (draw_on_compositing_end_) {
     draw_on_compositing_end_ = false;
 
@@ -942,6 +907,63 @@ bool RootWindow::DispatchMouseEventImpl(MouseEvent* event) {
   return false;
 }
 
+bool RootWindow::DispatchTouchEventImpl(TouchEvent* event) {
+#if defined(ENABLE_DIP)
+  float scale = GetMonitorScaleFactor(this);
+  ui::Transform transform;
+  transform.SetScale(scale, scale);
+  transform.ConcatTransform(layer()->transform());
+  event->UpdateForRootTransform(transform);
+#else
+  event->UpdateForRootTransform(layer()->transform());
+#endif
+  bool handled = false;
+
+  GestureConsumer* consumer = gesture_recognizer_->GetTouchLockedTarget(event);
+  ui::TouchStatus status = ui::TOUCH_STATUS_UNKNOWN;
+
+  if (!consumer || !consumer->ignores_events()) {
+    Window* target = static_cast<Window*>(consumer);
+
+    if (!target && HasCapture(capture_window_, ui::CW_LOCK_TOUCH))
+      target = capture_window_;
+
+    if (!target) {
+      target = static_cast<Window*>(
+          gesture_recognizer_->GetTargetForLocation(event->GetLocation()));
+    }
+
+    if (!target && !bounds().Contains(event->location())) {
+      // If the touch is outside the root window, set its target to the
+      // root window.
+      target = this;
+    } else {
+      if (!target)
+        target = GetEventHandlerForPoint(event->location());
+      if (!target)
+        return false;
+
+      TouchEvent translated_event(*event, this, target);
+      status = ProcessTouchEvent(target, &translated_event);
+      handled = status != ui::TOUCH_STATUS_UNKNOWN;
+
+      if (status == ui::TOUCH_STATUS_QUEUED ||
+          status == ui::TOUCH_STATUS_QUEUED_END)
+        gesture_recognizer_->QueueTouchEventForGesture(target, *event);
+    }
+    consumer = target;
+  }
+
+  // Get the list of GestureEvents from GestureRecognizer.
+  scoped_ptr<ui::GestureRecognizer::Gestures> gestures;
+  gestures.reset(gesture_recognizer_->ProcessTouchEventForGesture(
+      *event, status, consumer));
+  if (ProcessGestures(gestures.get()))
+    handled = true;
+
+  return handled;
+}
+
 void RootWindow::DispatchHeldMouseMove() {
   if (held_mouse_move_.get()) {
     // If a mouse move has been synthesized, the target location is suspect,
@@ -952,6 +974,39 @@ void RootWindow::DispatchHeldMouseMove() {
   }
 }
 
+void RootWindow::DispatchHeldTouchMove() {
+  if (held_touch_move_.get()) {
+    // Released first in case dispatching re-enters DispatchTouchEvent().
+    scoped_ptr<TouchEvent> event(held_touch_move_.release());
+    DispatchTouchEventImpl(event.get());
+  }
+}
+
+void RootWindow::DispatchHeldMovesAfterFrame() {
+  // Another frame may have started since the task was posted, in which case
+  // the moves are left for it.
+  if (waiting_on_compositing_end_)
+    return;
+  if (!mouse_move_hold_count_)
+    DispatchHeldMouseMove();
+  DispatchHeldTouchMove();
+}
+
+void RootWindow::DispatchHeldEvents() {
+  DispatchHeldMouseMove();
+  DispatchHeldTouchMove();
+}
+
+bool RootWindow::ShouldHoldMouseEvent(const MouseEvent& event) const {
+  if (mouse_move_hold_count_) {
+    return event.type() == ui::ET_MOUSE_DRAGGED ||
+        (event.flags() & ui::EF_IS_SYNTHESIZED);
+  }
+  return should_hold_mouse_moves_ && waiting_on_compositing_end_ &&
+      (event.type() == ui::ET_MOUSE_MOVED ||
+       event.type() == ui::ET_MOUSE_DRAGGED);
+}
+
 void RootWindow::PostMouseMoveEventAfterWindowChange() {
   if (synthesize_mouse_move_)
     return;
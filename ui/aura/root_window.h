@@ -147,6 +147,11 @@ class AURA_EXPORT RootWindow : public ui::CompositorDelegate,
   bool DispatchScrollEvent(ScrollEvent* event);
 
   // Handles a touch event. Returns true if handled.
+  //
+  // While a frame is being drawn, mouse and touch moves are held rather than
+  // dispatched, each replacing the last, so that at most one of each reaches
+  // the window hierarchy per frame. The held move is dispatched when the frame
+  // ends or before any other event, whichever comes first.
   bool DispatchTouchEvent(TouchEvent* event);
 
   // Handles a gesture event. Returns true if handled. Unlike the other
@@ -325,11 +330,22 @@ class AURA_EXPORT RootWindow : public ui::CompositorDelegate,
   virtual bool IsFocusedWindow(const Window* window) const OVERRIDE;
 
   // We hold and aggregate mouse drags as a way of throttling resizes when
-  // HoldMouseMoves() is called. The following methods are used to dispatch held
-  // and newly incoming mouse events, typically when an event other than a mouse
-  // drag needs dispatching or a matching ReleaseMouseMoves() is called.
+  // HoldMouseMoves() is called, and mouse and touch moves while a frame is
+  // being drawn. The following methods are used to dispatch held and newly
+  // incoming events, typically when an event other than a move needs
+  // dispatching, a frame ends or a matching ReleaseMouseMoves() is called.
   bool DispatchMouseEventImpl(MouseEvent* event);
+  bool DispatchTouchEventImpl(TouchEvent* event);
   void DispatchHeldMouseMove();
+  void DispatchHeldTouchMove();
+  void DispatchHeldEvents();
+
+  // Dispatches the moves held while a frame was drawn, unless another frame
+  // has begun since.
+  void DispatchHeldMovesAfterFrame();
+
+  // Returns true if |event| should be held instead of dispatched.
+  bool ShouldHoldMouseEvent(const MouseEvent& event) const;
 
   // Parses the switch describing the initial size for the host window and
   // returns bounds for the window.
@@ -399,6 +415,7 @@ class AURA_EXPORT RootWindow : public ui::CompositorDelegate,
   int mouse_move_hold_count_;
   bool should_hold_mouse_moves_;
   scoped_ptr<MouseEvent> held_mouse_move_;
+  scoped_ptr<TouchEvent> held_touch_move_;
 
   CompositorLock* compositor_lock_;
   bool draw_on_compositor_unlock_;
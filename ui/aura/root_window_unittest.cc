@@ -15,6 +15,7 @@
 #include "ui/aura/test/test_windows.h"
 #include "ui/base/hit_test.h"
 #include "ui/base/keycodes/keyboard_codes.h"
+#include "ui/gfx/compositor/compositor.h"
 #include "ui/gfx/point.h"
 #include "ui/gfx/rect.h"
 
@@ -195,6 +196,44 @@ TEST_F(RootWindowTest, MouseButtonState) {
   EXPECT_TRUE(Env::GetInstance()->is_mouse_button_down());
 }
 
+// Mouse moves that arrive while a frame is being drawn are coalesced, and the
+// last one is dispatched once the frame ends.
+TEST_F(RootWindowTest, CoalesceMouseMovesDuringFrame) {
+  scoped_ptr<NonClientDelegate> delegate(new NonClientDelegate());
+  scoped_ptr<aura::Window> window(CreateTestWindowWithDelegate(
+      delegate.get(), 1, gfx::Rect(100, 200, 123, 45), NULL));
+
+  // Keep a frame in flight until the swap completes.
+  root_window()->compositor()->OnSwapBuffersPosted();
+  root_window()->Draw();
+
+  for (int i = 1; i <= 3; ++i) {
+    gfx::Point point(100 + i, 200 + i);
+    MouseEvent move(ui::ET_MOUSE_MOVED, point, point, 0);
+    EXPECT_TRUE(root_window()->DispatchMouseEvent(&move));
+  }
+  EXPECT_EQ(0, delegate->mouse_event_count());
+
+  root_window()->compositor()->OnSwapBuffersComplete();
+  RunAllPendingInMessageLoop();
+
+  // The window is entered, then sees only the last move.
+  EXPECT_EQ(2, delegate->mouse_event_count());
+  EXPECT_EQ(gfx::Point(3, 3), delegate->mouse_event_location());
+
+  // Any other event dispatches the held move ahead of itself.
+  root_window()->compositor()->OnSwapBuffersPosted();
+  root_window()->Draw();
+  gfx::Point point(110, 210);
+  MouseEvent move(ui::ET_MOUSE_MOVED, point, point, 0);
+  root_window()->DispatchMouseEvent(&move);
+  MouseEvent press(ui::ET_MOUSE_PRESSED, point, point,
+                   ui::EF_LEFT_MOUSE_BUTTON);
+  root_window()->DispatchMouseEvent(&press);
+  EXPECT_EQ(4, delegate->mouse_event_count());
+  root_window()->compositor()->OnSwapBuffersComplete();
+}
+
 TEST_F(RootWindowTest, TranslatedEvent) {
   scoped_ptr<Window> w1(test::CreateTestWindowWithDelegate(NULL, 1,
       gfx::Rect(50, 50, 100, 100), NULL));
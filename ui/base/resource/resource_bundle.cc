@@ -42,10 +42,41 @@ const int kMediumFontSizeDelta = 3;
 const int kLargeFontSizeDelta = 8;
 #endif
 
+// Pre-decoded image resources start with this header, followed by the rows of
+// premultiplied 32-bit ARGB pixels with no padding. The header keeps the
+// pixels 4-byte aligned relative to the start of the resource.
+const char kDecodedBitmapMagic[4] = { 'R', 'A', 'W', 'B' };
+
+struct DecodedBitmapHeader {
+  char magic[4];
+  uint32 width;
+  uint32 height;
+  uint32 opaque;
+};
+
 }  // namespace
 
 ResourceBundle* ResourceBundle::g_shared_instance_ = NULL;
 
+// static
+std::string ResourceBundle::EncodeDecodedBitmap(const SkBitmap& bitmap) {
+  DCHECK_EQ(SkBitmap::kARGB_8888_Config, bitmap.config());
+  SkAutoLockPixels lock(bitmap);
+
+  DecodedBitmapHeader header;
+  memcpy(header.magic, kDecodedBitmapMagic, sizeof(header.magic));
+  header.width = bitmap.width();
+  header.height = bitmap.height();
+  header.opaque = bitmap.isOpaque() ? 1 : 0;
+
+  size_t row_size = bitmap.width() * 4;
+  std::string result(reinterpret_cast<const char*>(&header), sizeof(header));
+  result.reserve(sizeof(header) + row_size * bitmap.height());
+  for (int y = 0; y < bitmap.height(); ++y)
+    result.append(static_cast<const char*>(bitmap.getAddr(0, y)), row_size);
+  return result;
+}
+
 // static
 std::string ResourceBundle::InitSharedInstanceWithLocale(
     const std::string& pref_locale) {
@@ -382,6 +413,10 @@ SkBitmap* ResourceBundle::LoadBitmap(const ResourceHandle& data_handle,
   if (!memory)
     return NULL;
 
+  SkBitmap* decoded_bitmap = LoadDecodedBitmap(memory);
+  if (decoded_bitmap)
+    return decoded_bitmap;
+
   SkBitmap bitmap;
   if (gfx::PNGCodec::Decode(memory->front(), memory->size(), &bitmap))
     return new SkBitmap(bitmap);
@@ -396,6 +431,41 @@ SkBitmap* ResourceBundle::LoadBitmap(const ResourceHandle& data_handle,
   return NULL;
 }
 
+// static
+SkBitmap* ResourceBundle::LoadDecodedBitmap(
+    base::RefCountedStaticMemory* memory) {
+  if (memory->size() < sizeof(DecodedBitmapHeader) ||
+      memcmp(memory->front(), kDecodedBitmapMagic,
+             sizeof(kDecodedBitmapMagic)) != 0) {
+    return NULL;
+  }
+
+  DecodedBitmapHeader header;
+  memcpy(&header, memory->front(), sizeof(header));
+  const unsigned char* pixels = memory->front() + sizeof(header);
+  size_t pixels_size = memory->size() - sizeof(header);
+  if (header.width == 0 || header.height == 0 ||
+      pixels_size / 4 / header.width != header.height ||
+      pixels_size % (4 * header.width) != 0) {
+    NOTREACHED() << "Malformed pre-decoded image resource";
+    return NULL;
+  }
+
+  SkBitmap* bitmap = new SkBitmap();
+  bitmap->setConfig(SkBitmap::kARGB_8888_Config, header.width, header.height);
+  if (reinterpret_cast<uintptr_t>(pixels) % 4 == 0) {
+    // The pak stays mapped for as long as the ResourceBundle caching this
+    // bitmap, and is never written to.
+    bitmap->setPixels(const_cast<unsigned char*>(pixels));
+  } else {
+    bitmap->allocPixels();
+    SkAutoLockPixels lock(*bitmap);
+    memcpy(bitmap->getPixels(), pixels, pixels_size);
+  }
+  bitmap->setIsOpaque(header.opaque != 0);
+  return bitmap;
+}
+
 gfx::Image* ResourceBundle::GetEmptyImage() {
   base::AutoLock lock(*images_and_fonts_lock_);
 
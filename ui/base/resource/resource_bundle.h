@@ -85,6 +85,12 @@ class UI_EXPORT ResourceBundle {
   // Check if the .pak for the given locale exists.
   static bool LocaleDataPakExists(const std::string& locale);
 
+  // Returns |bitmap| serialized as a pre-decoded image resource. Packing a
+  // frequently used image this way rather than as a PNG lets it be loaded
+  // without decoding, at the cost of a larger pak file. |bitmap| must be
+  // 32-bit ARGB.
+  static std::string EncodeDecodedBitmap(const SkBitmap& bitmap);
+
   // Registers additional data pack files with the global ResourceBundle.  When
   // looking for a DataResource, we will search these files after searching the
   // main module. |scale_factor| is the scale of images in this resource pak
@@ -150,6 +156,7 @@ class UI_EXPORT ResourceBundle {
 
  private:
   FRIEND_TEST_ALL_PREFIXES(ResourceBundle, LoadDataResourceBytes);
+  FRIEND_TEST_ALL_PREFIXES(ResourceBundle, LoadDecodedImage);
 
   // Ctor/dtor are private, since we're a singleton.
   ResourceBundle();
@@ -184,6 +191,12 @@ class UI_EXPORT ResourceBundle {
   // done.
   SkBitmap* LoadBitmap(const ResourceHandle& dll_inst, int resource_id);
 
+  // Returns a new SkBitmap for a resource written by EncodeDecodedBitmap(),
+  // or NULL if |memory| holds anything else. When the pixels in |memory| are
+  // suitably aligned the bitmap uses them in place, so they are paged in from
+  // the mapped pak as they are drawn and never copied to the heap.
+  static SkBitmap* LoadDecodedBitmap(base::RefCountedStaticMemory* memory);
+
   // Returns an empty image for when a resource cannot be loaded. This is a
   // bright red bitmap.
   gfx::Image* GetEmptyImage();
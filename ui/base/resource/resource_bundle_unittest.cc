@@ -4,12 +4,16 @@
 
 #include "ui/base/resource/resource_bundle.h"
 
+#include <map>
+
 #include "base/base_paths.h"
 #include "base/file_path.h"
 #include "base/file_util.h"
 #include "base/path_service.h"
 #include "base/scoped_temp_dir.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/base/resource/data_pack.h"
 
 namespace ui {
 
@@ -44,6 +48,38 @@ TEST(ResourceBundle, LoadDataResourceBytes) {
   EXPECT_EQ(NULL, resource_bundle.LoadDataResourceBytes(kUnfoundResourceId));
 }
 
+TEST(ResourceBundle, LoadDecodedImage) {
+  SkBitmap source;
+  source.setConfig(SkBitmap::kARGB_8888_Config, 3, 2);
+  source.allocPixels();
+  source.eraseARGB(255, 0, 0, 255);
+  source.setIsOpaque(true);
+  *source.getAddr32(1, 1) = SK_ColorGREEN;
+
+  // Pack the bitmap pre-decoded, the way a hot resource would be.
+  const int kImageId = 4;
+  std::string encoded = ResourceBundle::EncodeDecodedBitmap(source);
+  std::map<uint16, base::StringPiece> resources;
+  resources[kImageId] = base::StringPiece(encoded);
+
+  ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  FilePath data_path = dir.path().Append(FILE_PATH_LITERAL("decoded.pak"));
+  ASSERT_TRUE(DataPack::WritePack(data_path, resources, DataPack::BINARY));
+
+  ResourceBundle resource_bundle;
+  resource_bundle.LoadTestResources(data_path);
+
+  SkBitmap* bitmap = resource_bundle.GetBitmapNamed(kImageId);
+  ASSERT_TRUE(bitmap);
+  EXPECT_EQ(3, bitmap->width());
+  EXPECT_EQ(2, bitmap->height());
+  EXPECT_TRUE(bitmap->isOpaque());
+  SkAutoLockPixels lock(*bitmap);
+  EXPECT_EQ(SK_ColorBLUE, *bitmap->getAddr32(0, 0));
+  EXPECT_EQ(SK_ColorGREEN, *bitmap->getAddr32(1, 1));
+}
+
 TEST(ResourceBundle, LocaleDataPakExists) {
   // Check that ResourceBundle::LocaleDataPakExists returns the correct results.
   EXPECT_TRUE(ResourceBundle::LocaleDataPakExists("en-US"));
@@ -4,6 +4,7 @@
 
 #include "ui/gfx/compositor/compositor.h"
 
+#include "base/auto_reset.h"
 #include "base/command_line.h"
 #include "base/threading/thread_restrictions.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebCompositor.h"
@@ -126,7 +127,8 @@ Compositor::Compositor(CompositorDelegate* delegate,
       root_layer_(NULL),
       widget_(widget),
       root_web_layer_(WebKit::WebLayer::create()),
-      swap_posted_(false) {
+      swap_posted_(false),
+      updating_animations_(false) {
   WebKit::WebLayerTreeView::Settings settings;
   CommandLine* command_line = CommandLine::ForCurrentProcess();
   settings.showFPSCounter =
@@ -172,6 +174,9 @@ void Compositor::Terminate() {
 
 void Compositor::ScheduleDraw() {
   if (g_compositor_thread) {
+    // The frame being composited will draw whatever the animations set.
+    if (updating_animations_)
+      return;
     // TODO(nduca): Temporary while compositor calls
     // compositeImmediately() directly.
     layout();
@@ -268,6 +273,10 @@ void Compositor::OnSwapBuffersAborted() {
 }
 
 void Compositor::updateAnimations(double frameBeginTime) {
+  if (!root_layer_)
+    return;
+  AutoReset<bool> updating(&updating_animations_, true);
+  root_layer_->ProgressAnimationsForFrame(base::TimeTicks::Now());
 }
 
 void Compositor::layout() {
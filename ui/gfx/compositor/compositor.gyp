@@ -133,5 +133,32 @@
         }],
       ],
     },
+    {
+      'target_name': 'compositor_perftests',
+      'type': 'executable',
+      'dependencies': [
+        '<(DEPTH)/base/base.gyp:base',
+        '<(DEPTH)/base/base.gyp:test_support_base',
+        '<(DEPTH)/skia/skia.gyp:skia',
+        '<(DEPTH)/testing/gtest.gyp:gtest',
+        '<(DEPTH)/ui/gfx/gl/gl.gyp:gl',
+        '<(DEPTH)/ui/ui.gyp:ui',
+        'compositor',
+        'compositor_test_support',
+      ],
+      'sources': [
+        'layer_perftest.cc',
+        'run_all_unittests.cc',
+        'test/test_suite.cc',
+        'test/test_suite.h',
+      ],
+      'conditions': [
+        ['OS=="linux"', {
+          'dependencies': [
+            '<(DEPTH)/third_party/mesa/mesa.gyp:osmesa',
+          ],
+        }],
+      ],
+    },
   ],
 }
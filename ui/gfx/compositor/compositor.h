@@ -237,6 +237,9 @@ class COMPOSITOR_EXPORT Compositor
   // for completion.
   bool swap_posted_;
 
+  // True while layer animations are being progressed for a new frame.
+  bool updating_animations_;
+
   friend class base::RefCounted<Compositor>;
 };
 
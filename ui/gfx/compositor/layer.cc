@@ -297,12 +297,18 @@ void Layer::SetColor(SkColor color) {
 bool Layer::SchedulePaint(const gfx::Rect& invalid_rect) {
   if (type_ == LAYER_SOLID_COLOR || !delegate_)
     return false;
-  damaged_region_.op(invalid_rect.x(),
-                     invalid_rect.y(),
-                     invalid_rect.right(),
-                     invalid_rect.bottom(),
+  gfx::Rect damaged_rect = invalid_rect.Intersect(gfx::Rect(bounds_.size()));
+  if (damaged_rect.IsEmpty())
+    return true;
+  damaged_region_.op(damaged_rect.x(),
+                     damaged_rect.y(),
+                     damaged_rect.right(),
+                     damaged_rect.bottom(),
                      SkRegion::kUnion_Op);
-  ScheduleDraw();
+  // The damage of a layer that isn't drawn is kept until it is shown, which
+  // schedules a draw of its own.
+  if (IsDrawn())
+    ScheduleDraw();
   return true;
 }
 
@@ -342,12 +348,24 @@ void Layer::SuppressPaint() {
     children_[i]->SuppressPaint();
 }
 
+void Layer::ProgressAnimationsForFrame(base::TimeTicks frame_time) {
+  if (animator_.get())
+    animator_->ProgressForFrame(frame_time);
+  for (size_t i = 0; i < children_.size(); ++i)
+    children_[i]->ProgressAnimationsForFrame(frame_time);
+}
+
 void Layer::paintContents(WebKit::WebCanvas* web_canvas,
                           const WebKit::WebRect& clip) {
   TRACE_EVENT0("ui", "Layer::paintContents");
   gfx::Canvas canvas(web_canvas);
-  if (delegate_)
+  // |clip| covers the damaged rects sent to the WebLayer. Clipping to it lets
+  // delegates skip painting anything outside them.
+  canvas.Save();
+  if (delegate_ &&
+      canvas.ClipRect(gfx::Rect(clip.x, clip.y, clip.width, clip.height)))
     delegate_->OnPaintLayer(&canvas);
+  canvas.Restore();
 }
 
 float Layer::GetCombinedOpacity() const {
@@ -456,6 +474,8 @@ void Layer::SetVisibilityImmediately(bool visible) {
   visible_ = visible;
   // TODO(piman): Expose a visibility flag on WebLayer.
   web_layer_.setOpacity(visible_ ? opacity_ : 0.f);
+  if (!parent_ || parent_->IsDrawn())
+    ScheduleDraw();
 }
 
 void Layer::SetBoundsFromAnimation(const gfx::Rect& bounds) {
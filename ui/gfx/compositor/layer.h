@@ -13,6 +13,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/message_loop.h"
+#include "base/time.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkRegion.h"
 #include "third_party/WebKit/Source/Platform/chromium/public/WebContentLayerClient.h"
@@ -176,8 +177,9 @@ class COMPOSITOR_EXPORT Layer :
   // Sets the layer's fill color.  May only be called for LAYER_SOLID_COLOR.
   void SetColor(SkColor color);
 
-  // Adds |invalid_rect| to the Layer's pending invalid rect and calls
-  // ScheduleDraw(). Returns false if the paint request is ignored.
+  // Adds |invalid_rect|, clipped to the Layer's bounds, to the Layer's pending
+  // invalid rect and calls ScheduleDraw() if the Layer is drawn. Returns false
+  // if the paint request is ignored.
   bool SchedulePaint(const gfx::Rect& invalid_rect);
 
   // Schedules a redraw of the layer tree at the compositor.
@@ -193,6 +195,10 @@ class COMPOSITOR_EXPORT Layer :
   // new paint requests.
   void SuppressPaint();
 
+  // Progresses transform and opacity animations of this Layer and its
+  // descendants to |frame_time|. See LayerAnimator::ProgressForFrame().
+  void ProgressAnimationsForFrame(base::TimeTicks frame_time);
+
   // Sometimes the Layer is being updated by something other than SetCanvas
   // (e.g. the GPU process on UI_COMPOSITOR_IMAGE_TRANSPORT).
   bool layer_updated_externally() const { return layer_updated_externally_; }
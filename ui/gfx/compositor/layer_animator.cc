@@ -243,6 +243,34 @@ bool LayerAnimator::HasAnimation(LayerAnimationSequence* sequence) const {
   return false;
 }
 
+void LayerAnimator::ProgressForFrame(base::TimeTicks frame_time) {
+  if (!is_animating() || frame_time <= last_step_time_)
+    return;
+
+  for (size_t i = 0; i < running_animations_.size(); ++i) {
+    LayerAnimationSequence* sequence = running_animations_[i].sequence;
+    const LayerAnimationElement::AnimatableProperties& properties =
+        sequence->properties();
+    bool transform_or_opacity_only = true;
+    for (LayerAnimationElement::AnimatableProperties::const_iterator it =
+             properties.begin(); it != properties.end(); ++it) {
+      if (*it != LayerAnimationElement::TRANSFORM &&
+          *it != LayerAnimationElement::OPACITY) {
+        transform_or_opacity_only = false;
+        break;
+      }
+    }
+    // Bounds and visibility changes can cause repaints, which are too late to
+    // start once a frame is being drawn.
+    if (!transform_or_opacity_only)
+      continue;
+
+    base::TimeDelta delta = frame_time - running_animations_[i].start_time;
+    if (delta < sequence->duration() || sequence->is_cyclic())
+      ProgressAnimation(sequence, delta);
+  }
+}
+
 // LayerAnimator private -------------------------------------------------------
 
 void LayerAnimator::Step(base::TimeTicks now) {
@@ -119,6 +119,13 @@ class COMPOSITOR_EXPORT LayerAnimator : public AnimationContainerElement {
   // Stops all animation and clears any queued animations.
   void StopAnimating();
 
+  // Progresses running transform and opacity animations to |frame_time|, so
+  // that a frame shows them as of when it is drawn rather than as of when the
+  // animation timer last got to run on a busy UI thread. Animations are never
+  // finished here: that, and notifying observers, is left to the timer, so
+  // this can be called while the layer tree is being drawn.
+  void ProgressForFrame(base::TimeTicks frame_time);
+
   // These functions are used for adding or removing observers from the observer
   // list. The observers are notified when animations end.
   void AddObserver(LayerAnimationObserver* observer);
@@ -1118,4 +1118,46 @@ TEST(LayerAnimatorTest, GetTargetOpacity) {
   }
 }
 
+// Progressing for a frame moves opacity animations along but leaves bounds
+// animations, and finishing either, to the animation timer.
+TEST(LayerAnimatorTest, ProgressForFrame) {
+  scoped_ptr<LayerAnimator> animator(LayerAnimator::CreateDefaultAnimator());
+  AnimationContainerElement* element = animator.get();
+  animator->set_disable_timer_for_test(true);
+  TestLayerAnimationDelegate delegate;
+  animator->SetDelegate(&delegate);
+
+  gfx::Rect start_bounds(0, 0, 50, 50);
+  gfx::Rect target_bounds(0, 0, 100, 100);
+  base::TimeDelta delta = base::TimeDelta::FromSeconds(1);
+
+  delegate.SetOpacityFromAnimation(0.0);
+  delegate.SetBoundsFromAnimation(start_bounds);
+
+  std::vector<LayerAnimationSequence*> sequences;
+  sequences.push_back(new LayerAnimationSequence(
+      LayerAnimationElement::CreateOpacityElement(1.0, delta)));
+  sequences.push_back(new LayerAnimationSequence(
+      LayerAnimationElement::CreateBoundsElement(target_bounds, delta)));
+  animator->ScheduleTogether(sequences);
+
+  base::TimeTicks start_time = animator->last_step_time();
+
+  animator->ProgressForFrame(
+      start_time + base::TimeDelta::FromMilliseconds(500));
+  EXPECT_TRUE(animator->is_animating());
+  EXPECT_FLOAT_EQ(0.5, delegate.GetOpacityForAnimation());
+  CheckApproximatelyEqual(delegate.GetBoundsForAnimation(), start_bounds);
+
+  animator->ProgressForFrame(
+      start_time + base::TimeDelta::FromMilliseconds(1000));
+  EXPECT_TRUE(animator->is_animating());
+  EXPECT_FLOAT_EQ(0.5, delegate.GetOpacityForAnimation());
+
+  element->Step(start_time + base::TimeDelta::FromMilliseconds(1000));
+  EXPECT_FALSE(animator->is_animating());
+  EXPECT_FLOAT_EQ(1.0, delegate.GetOpacityForAnimation());
+  CheckApproximatelyEqual(delegate.GetBoundsForAnimation(), target_bounds);
+}
+
 }  // namespace ui
@@ -0,0 +1,130 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the cost of a frame as the number of layers and the fraction of a
+// layer that is damaged each frame vary. A small damaged fraction stands in
+// for a blinking cursor; a full one for a window being resized.
+
+#include "base/basictypes.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/gfx/canvas.h"
+#include "ui/gfx/compositor/compositor.h"
+#include "ui/gfx/compositor/compositor_setup.h"
+#include "ui/gfx/compositor/layer.h"
+#include "ui/gfx/compositor/layer_delegate.h"
+#include "ui/gfx/rect.h"
+
+namespace ui {
+
+namespace {
+
+const int kFrames = 100;
+const int kLayerSize = 200;
+const int kLayersPerRow = 5;
+
+// Paints a pattern costly enough for the painted area to matter, and counts
+// the pixels it was asked to paint.
+class CountingLayerDelegate : public LayerDelegate {
+ public:
+  CountingLayerDelegate() : painted_pixels_(0) {}
+  virtual ~CountingLayerDelegate() {}
+
+  int64 painted_pixels() const { return painted_pixels_; }
+
+  // Overridden from LayerDelegate:
+  virtual void OnPaintLayer(gfx::Canvas* canvas) OVERRIDE {
+    gfx::Rect clip;
+    if (!canvas->GetClipBounds(&clip))
+      return;
+    painted_pixels_ += clip.width() * clip.height();
+    for (int y = clip.y(); y < clip.bottom(); y += 4) {
+      canvas->FillRect(gfx::Rect(clip.x(), y, clip.width(), 2),
+                       (y & 4) ? SK_ColorRED : SK_ColorBLUE);
+    }
+  }
+
+ private:
+  int64 painted_pixels_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingLayerDelegate);
+};
+
+class LayerPerfTest : public testing::Test, public CompositorDelegate {
+ public:
+  LayerPerfTest() {}
+  virtual ~LayerPerfTest() {}
+
+  // Overridden from testing::Test:
+  virtual void SetUp() OVERRIDE {
+    ui::SetupTestCompositor();
+    compositor_.reset(new Compositor(
+        this, gfx::kNullAcceleratedWidget, gfx::Size(1000, 1000)));
+  }
+
+  // Overridden from CompositorDelegate:
+  virtual void ScheduleDraw() OVERRIDE {}
+
+ protected:
+  // Draws kFrames frames of |layer_count| layers, damaging |damaged_percent|
+  // of one layer in each, and logs the average frame time and the pixels
+  // painted per frame.
+  void RunFrames(int layer_count, int damaged_percent) {
+    Layer root(LAYER_NOT_DRAWN);
+    root.SetBounds(gfx::Rect(compositor_->size()));
+    compositor_->SetRootLayer(&root);
+
+    CountingLayerDelegate delegate;
+    ScopedVector<Layer> layers;
+    for (int i = 0; i < layer_count; ++i) {
+      Layer* layer = new Layer(LAYER_TEXTURED);
+      layer->set_delegate(&delegate);
+      layer->SetBounds(gfx::Rect((i % kLayersPerRow) * kLayerSize,
+                                 (i / kLayersPerRow) * kLayerSize % 1000,
+                                 kLayerSize, kLayerSize));
+      root.Add(layer);
+      layers.push_back(layer);
+    }
+    compositor_->Draw(false);
+
+    int damaged_height = kLayerSize * damaged_percent / 100;
+    int64 pixels_before = delegate.painted_pixels();
+    base::TimeTicks start = base::TimeTicks::HighResNow();
+    for (int frame = 0; frame < kFrames; ++frame) {
+      layers[frame % layer_count]->SchedulePaint(
+          gfx::Rect(0, 0, kLayerSize, damaged_height));
+      compositor_->Draw(false);
+    }
+    base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+
+    LOG(INFO) << "layers=" << layer_count
+              << " damaged=" << damaged_percent << "%"
+              << " frame_us=" << elapsed.InMicroseconds() / kFrames
+              << " painted_pixels_per_frame="
+              << (delegate.painted_pixels() - pixels_before) / kFrames;
+
+    compositor_->SetRootLayer(NULL);
+  }
+
+ private:
+  scoped_ptr<Compositor> compositor_;
+
+  DISALLOW_COPY_AND_ASSIGN(LayerPerfTest);
+};
+
+}  // namespace
+
+TEST_F(LayerPerfTest, FrameCost) {
+  const int kLayerCounts[] = { 1, 10, 50, 200 };
+  const int kDamagedPercents[] = { 1, 10, 50, 100 };
+  for (size_t i = 0; i < arraysize(kLayerCounts); ++i) {
+    for (size_t j = 0; j < arraysize(kDamagedPercents); ++j)
+      RunFrames(kLayerCounts[i], kDamagedPercents[j]);
+  }
+}
+
+}  // namespace ui
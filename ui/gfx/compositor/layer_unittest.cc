@@ -731,6 +731,33 @@ TEST_F(LayerWithNullDelegateTest, SetBoundsSchedulesPaint) {
   EXPECT_TRUE(schedule_draw_invoked_);
 }
 
+// Verifies SchedulePaint only asks for a draw when the damage can be seen.
+TEST_F(LayerWithNullDelegateTest, SchedulePaintSkipsUnseenDamage) {
+  scoped_ptr<Layer> l1(CreateTextureLayer(gfx::Rect(0, 0, 200, 200)));
+  scoped_ptr<Layer> l2(CreateTextureLayer(gfx::Rect(10, 10, 50, 50)));
+  l1->Add(l2.get());
+  compositor()->SetRootLayer(l1.get());
+
+  Draw();
+
+  // Damage entirely outside the layer is dropped.
+  schedule_draw_invoked_ = false;
+  EXPECT_TRUE(l2->SchedulePaint(gfx::Rect(60, 60, 10, 10)));
+  EXPECT_FALSE(schedule_draw_invoked_);
+
+  EXPECT_TRUE(l2->SchedulePaint(gfx::Rect(40, 40, 20, 20)));
+  EXPECT_TRUE(schedule_draw_invoked_);
+
+  // Damage to a layer under a hidden ancestor waits until it is shown.
+  l1->SetVisible(false);
+  schedule_draw_invoked_ = false;
+  EXPECT_TRUE(l2->SchedulePaint(gfx::Rect(0, 0, 10, 10)));
+  EXPECT_FALSE(schedule_draw_invoked_);
+
+  l1->SetVisible(true);
+  EXPECT_TRUE(schedule_draw_invoked_);
+}
+
 // Checks that pixels are actually drawn to the screen with a read back.
 TEST_F(LayerWithRealCompositorTest, MAYBE_DrawPixels) {
   scoped_ptr<Layer> layer(CreateColorLayer(SK_ColorRED,
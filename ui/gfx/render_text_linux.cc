@@ -11,7 +11,11 @@
 #include <vector>
 
 #include "base/i18n/break_iterator.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/memory/mru_cache.h"
+#include "base/stringprintf.h"
+#include "base/utf_string_conversions.h"
 #include "third_party/skia/include/core/SkTypeface.h"
 #include "ui/base/text/utf16_indexing.h"
 #include "ui/gfx/canvas.h"
@@ -22,6 +26,49 @@ namespace gfx {
 
 namespace {
 
+// Number of laid out strings kept for reuse.
+const size_t kMaxCachedLayouts = 128;
+
+class LayoutUnrefDeletor {
+ public:
+  void operator()(PangoLayout*& layout) {
+    g_object_unref(layout);
+  }
+};
+
+// Layouts shared by all RenderTextLinux instances, keyed by everything that
+// EnsureLayout() sets on them. Labels, tabs and the omnibox lay out the same
+// strings over and over, so this saves itemizing and shaping them each time.
+// A layout is never changed once it is set up, so instances can share one.
+class LayoutCache
+    : public base::MRUCacheBase<std::string, PangoLayout*, LayoutUnrefDeletor> {
+ public:
+  LayoutCache()
+      : base::MRUCacheBase<std::string, PangoLayout*, LayoutUnrefDeletor>(
+            kMaxCachedLayouts) {
+  }
+
+  // Returns a new reference to the layout cached for |key|, or NULL.
+  PangoLayout* Lookup(const std::string& key) {
+    iterator it = Get(key);
+    if (it == end())
+      return NULL;
+    g_object_ref(it->second);
+    return it->second;
+  }
+
+  // Adds |layout| for |key|, taking a reference of its own.
+  void Add(const std::string& key, PangoLayout* layout) {
+    g_object_ref(layout);
+    Put(key, layout);
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(LayoutCache);
+};
+
+base::LazyInstance<LayoutCache> g_layout_cache = LAZY_INSTANCE_INITIALIZER;
+
 // Returns the preceding element in a GSList (O(n)).
 GSList* GSListPrevious(GSList* head, GSList* item) {
   GSList* prev = NULL;
@@ -291,34 +338,53 @@ void RenderTextLinux::ResetLayout() {
 
 void RenderTextLinux::EnsureLayout() {
   if (layout_ == NULL) {
-    cairo_surface_t* surface =
-        cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 0, 0);
-    cairo_t* cr = cairo_create(surface);
-
-    layout_ = pango_cairo_create_layout(cr);
-    cairo_destroy(cr);
-    cairo_surface_destroy(surface);
-    SetupPangoLayoutWithFontDescription(
-        layout_,
-        GetDisplayText(),
-        font_list().GetFontDescriptionString(),
-        display_rect().width(),
-        base::i18n::GetFirstStrongCharacterDirection(text()),
-        Canvas::DefaultCanvasTextAlignment());
-
-    // No width set so that the x-axis position is relative to the start of the
-    // text. ToViewPoint and ToTextPoint take care of the position conversion
-    // between text space and view spaces.
-    pango_layout_set_width(layout_, -1);
-    // TODO(xji): If RenderText will be used for displaying purpose, such as
-    // label, we will need to remove the single-line-mode setting.
-    pango_layout_set_single_paragraph_mode(layout_, true);
-
-    // These are used by SetupPangoAttributes.
-    layout_text_ = pango_layout_get_text(layout_);
-    layout_text_len_ = strlen(layout_text_);
-
-    SetupPangoAttributes(layout_);
+    const string16 display_text = GetDisplayText();
+    const std::string font_description = font_list().GetFontDescriptionString();
+    const base::i18n::TextDirection direction =
+        base::i18n::GetFirstStrongCharacterDirection(text());
+
+    // The width is left out of the key: it is unset below. The text goes last
+    // so that nothing in it can be mistaken for another part of the key.
+    std::string cache_key =
+        base::StringPrintf("%s|%d|", font_description.c_str(), direction);
+    AppendFontStyleRanges(&cache_key);
+    cache_key += "|" + UTF16ToUTF8(display_text);
+
+    layout_ = g_layout_cache.Get().Lookup(cache_key);
+    if (layout_) {
+      layout_text_ = pango_layout_get_text(layout_);
+      layout_text_len_ = strlen(layout_text_);
+    } else {
+      cairo_surface_t* surface =
+          cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 0, 0);
+      cairo_t* cr = cairo_create(surface);
+
+      layout_ = pango_cairo_create_layout(cr);
+      cairo_destroy(cr);
+      cairo_surface_destroy(surface);
+      SetupPangoLayoutWithFontDescription(
+          layout_,
+          display_text,
+          font_description,
+          display_rect().width(),
+          direction,
+          Canvas::DefaultCanvasTextAlignment());
+
+      // No width set so that the x-axis position is relative to the start of
+      // the text. ToViewPoint and ToTextPoint take care of the position
+      // conversion between text space and view spaces.
+      pango_layout_set_width(layout_, -1);
+      // TODO(xji): If RenderText will be used for displaying purpose, such as
+      // label, we will need to remove the single-line-mode setting.
+      pango_layout_set_single_paragraph_mode(layout_, true);
+
+      // These are used by SetupPangoAttributes.
+      layout_text_ = pango_layout_get_text(layout_);
+      layout_text_len_ = strlen(layout_text_);
+
+      SetupPangoAttributes(layout_);
+      g_layout_cache.Get().Add(cache_key, layout_);
+    }
 
     current_line_ = pango_layout_get_line_readonly(layout_, 0);
     pango_layout_line_ref(current_line_);
@@ -327,6 +393,20 @@ void RenderTextLinux::EnsureLayout() {
   }
 }
 
+void RenderTextLinux::AppendFontStyleRanges(std::string* key) const {
+  int default_font_style = font_list().GetFontStyle();
+  for (StyleRanges::const_iterator i = style_ranges().begin();
+       i < style_ranges().end(); ++i) {
+    // Only ranges that SetupPangoAttributes() turns into font attributes.
+    if (i->font_style != default_font_style) {
+      base::StringAppendF(key, "%d:%d:%d,",
+                          static_cast<int>(i->range.start()),
+                          static_cast<int>(i->range.end()),
+                          i->font_style);
+    }
+  }
+}
+
 void RenderTextLinux::SetupPangoAttributes(PangoLayout* layout) {
   PangoAttrList* attrs = pango_attr_list_new();
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <pango/pango.h>
+#include <string>
 #include <vector>
 
 #include "ui/gfx/render_text.h"
@@ -56,6 +57,10 @@ class RenderTextLinux : public RenderText {
   SelectionModel FirstSelectionModelInsideRun(const PangoItem* run);
   SelectionModel LastSelectionModelInsideRun(const PangoItem* run);
 
+  // Appends the ranges of text drawn in other than the default font style to
+  // |key|, which identifies the layout in the layout cache.
+  void AppendFontStyleRanges(std::string* key) const;
+
   // Setup pango attribute: foreground, background, font, strike.
   void SetupPangoAttributes(PangoLayout* layout);
 
@@ -951,6 +951,28 @@ TEST_F(RenderTextTest, StringSizeBoldWidth) {
   EXPECT_GT(bold_width, plain_width);
 }
 
+// Laid out text may be shared between instances. Make sure that only the same
+// text in the same styles is.
+TEST_F(RenderTextTest, StringSizeSameTextOtherInstances) {
+  const string16 text = UTF8ToUTF16("Hello World");
+  scoped_ptr<RenderText> plain(RenderText::CreateRenderText());
+  plain->SetText(text);
+  const int plain_width = plain->GetStringSize().width();
+
+  scoped_ptr<RenderText> partly_bold(RenderText::CreateRenderText());
+  partly_bold->SetText(text);
+  StyleRange bold;
+  bold.font_style |= gfx::Font::BOLD;
+  bold.range = ui::Range(0, 5);
+  partly_bold->ApplyStyleRange(bold);
+  EXPECT_GT(partly_bold->GetStringSize().width(), plain_width);
+
+  scoped_ptr<RenderText> plain_again(RenderText::CreateRenderText());
+  plain_again->SetText(text);
+  EXPECT_EQ(plain_width, plain_again->GetStringSize().width());
+  EXPECT_EQ(plain_width, plain->GetStringSize().width());
+}
+
 TEST_F(RenderTextTest, StringSizeHeight) {
   struct {
     string16 text;
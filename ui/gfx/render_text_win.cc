@@ -10,6 +10,7 @@
 #include "base/logging.h"
 #include "base/stl_util.h"
 #include "base/string_util.h"
+#include "base/stringprintf.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/utf_string_conversions.h"
 #include "base/win/registry.h"
@@ -160,7 +161,6 @@ TextRun::TextRun()
 }
 
 TextRun::~TextRun() {
-  ScriptFreeCache(&script_cache);
 }
 
 // Returns the X coordinate of the leading or |trailing| edge of the glyph
@@ -194,6 +194,9 @@ std::map<std::string, std::vector<Font> > RenderTextWin::cached_linked_fonts_;
 // static
 std::map<std::string, Font> RenderTextWin::successful_substitute_fonts_;
 
+// static
+std::map<std::string, SCRIPT_CACHE> RenderTextWin::cached_script_caches_;
+
 RenderTextWin::RenderTextWin()
     : RenderText(),
       common_baseline_(0),
@@ -619,6 +622,7 @@ void RenderTextWin::LayoutVisualText() {
 
     // Select the font desired for glyph generation.
     SelectObject(cached_hdc_, run->font.GetNativeFont());
+    run->script_cache = GetScriptCache(run->font);
 
     run->logical_clusters.reset(new WORD[run_length]);
     run->glyph_count = 0;
@@ -628,7 +632,7 @@ void RenderTextWin::LayoutVisualText() {
       run->glyphs.reset(new WORD[max_glyphs]);
       run->visible_attributes.reset(new SCRIPT_VISATTR[max_glyphs]);
       hr = ScriptShape(cached_hdc_,
-                       &run->script_cache,
+                       run->script_cache,
                        run_text,
                        run_length,
                        max_glyphs,
@@ -730,7 +734,7 @@ void RenderTextWin::LayoutVisualText() {
       run->advance_widths.reset(new int[run->glyph_count]);
       run->offsets.reset(new GOFFSET[run->glyph_count]);
       hr = ScriptPlace(cached_hdc_,
-                       &run->script_cache,
+                       run->script_cache,
                        run->glyphs.get(),
                        run->glyph_count,
                        run->visible_attributes.get(),
@@ -774,7 +778,7 @@ void RenderTextWin::ApplySubstituteFont(internal::TextRun* run,
   const int font_height = run->font.GetHeight();
   run->font = font;
   DeriveFontIfNecessary(font_size, font_height, run->font_style, &run->font);
-  ScriptFreeCache(&run->script_cache);
+  run->script_cache = GetScriptCache(run->font);
   SelectObject(cached_hdc_, run->font.GetNativeFont());
 }
 
@@ -782,7 +786,7 @@ bool RenderTextWin::HasMissingGlyphs(internal::TextRun* run) const {
   SCRIPT_FONTPROPERTIES properties;
   memset(&properties, 0, sizeof(properties));
   properties.cBytes = sizeof(properties);
-  ScriptGetFontProperties(cached_hdc_, &run->script_cache, &properties);
+  ScriptGetFontProperties(cached_hdc_, run->script_cache, &properties);
 
   const wchar_t* run_text = &(text()[run->range.start()]);
   for (size_t char_index = 0; char_index < run->range.length(); ++char_index) {
@@ -820,6 +824,17 @@ const std::vector<Font>* RenderTextWin::GetLinkedFonts(const Font& font) const {
   return linked_fonts;
 }
 
+// static
+SCRIPT_CACHE* RenderTextWin::GetScriptCache(const Font& font) {
+  const std::string key = base::StringPrintf("%s:%d:%d:%d",
+                                             font.GetFontName().c_str(),
+                                             font.GetFontSize(),
+                                             font.GetHeight(),
+                                             font.GetStyle());
+  // Map elements never move, so the returned pointer stays valid.
+  return &cached_script_caches_[key];
+}
+
 size_t RenderTextWin::GetRunContainingCaret(const SelectionModel& caret) const {
   DCHECK(!needs_layout_);
   size_t position = caret.caret_pos();
@@ -51,7 +51,8 @@ struct TextRun {
   scoped_array<int> advance_widths;
   scoped_array<GOFFSET> offsets;
   ABC abc_widths;
-  SCRIPT_CACHE script_cache;
+  // Shared by all runs in |font|; see RenderTextWin::GetScriptCache().
+  SCRIPT_CACHE* script_cache;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(TextRun);
@@ -104,6 +105,11 @@ class RenderTextWin : public RenderText {
   // Returns a vector of linked fonts corresponding to |font|.
   const std::vector<Font>* GetLinkedFonts(const Font& font) const;
 
+  // Returns the Uniscribe cache for |font|. Uniscribe keeps a font's shaping
+  // tables and glyph widths there, so sharing one per font across runs and
+  // instances saves loading them again for every layout.
+  static SCRIPT_CACHE* GetScriptCache(const Font& font);
+
   // Return the run index that contains the argument; or the length of the
   // |runs_| vector if argument exceeds the text length or width.
   size_t GetRunContainingCaret(const SelectionModel& caret) const;
@@ -124,6 +130,9 @@ class RenderTextWin : public RenderText {
   // Cached map from font name to the last successful substitute font used.
   static std::map<std::string, Font> successful_substitute_fonts_;
 
+  // Cached map from font name, size, height and style to its Uniscribe cache.
+  static std::map<std::string, SCRIPT_CACHE> cached_script_caches_;
+
   SCRIPT_CONTROL script_control_;
   SCRIPT_STATE script_state_;
 
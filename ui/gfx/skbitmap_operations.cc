@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <string.h>
 
+#include "base/cpu.h"
 #include "base/logging.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -17,6 +18,17 @@
 #include "ui/gfx/point.h"
 #include "ui/gfx/size.h"
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || _M_IX86_FP==2
+// This is where we had compiler support for SSE2 instructions.
+#define SIMD_SSE2 1
+#endif
+#endif
+
+#if defined(SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+
 // static
 SkBitmap SkBitmapOperations::CreateInvertedBitmap(const SkBitmap& image) {
   DCHECK(image.config() == SkBitmap::kARGB_8888_Config);
@@ -317,6 +329,42 @@ void LineProcHnopSnopLdec(const color_utils::HSL& hsl_shift,
   }
 }
 
+#if defined(SIMD_SSE2)
+// SSE2 version of LineProcHnopSnopLdec(), giving identical results. Each
+// colour channel is scaled by |ldec_num| / 65536 with a 16-bit high multiply,
+// four pixels at a time, and alpha is copied through unchanged.
+void LineProcHnopSnopLdec_SSE2(const color_utils::HSL& hsl_shift,
+                               const SkPMColor* in,
+                               SkPMColor* out,
+                               int width) {
+  const uint32_t den = 65536;
+
+  DCHECK(hsl_shift.h < 0);
+  DCHECK(hsl_shift.s < 0 || fabs(hsl_shift.s - 0.5) < HSLShift::epsilon);
+  DCHECK(hsl_shift.l <= 0.5 - HSLShift::epsilon && hsl_shift.l >= 0);
+
+  uint32_t ldec_num = static_cast<uint32_t>(hsl_shift.l * 2 * den);
+  DCHECK_LT(ldec_num, den);
+  const __m128i ldec = _mm_set1_epi16(static_cast<int16>(ldec_num));
+  const __m128i alpha_mask =
+      _mm_set1_epi32(static_cast<int>(SkPackARGB32(0xFF, 0, 0, 0)));
+  const __m128i zero = _mm_setzero_si128();
+
+  int x = 0;
+  for (; x + 4 <= width; x += 4) {
+    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + x));
+    __m128i lo = _mm_mulhi_epu16(_mm_unpacklo_epi8(pixels, zero), ldec);
+    __m128i hi = _mm_mulhi_epu16(_mm_unpackhi_epi8(pixels, zero), ldec);
+    __m128i scaled = _mm_packus_epi16(lo, hi);
+    __m128i result = _mm_or_si128(_mm_and_si128(pixels, alpha_mask),
+                                  _mm_andnot_si128(alpha_mask, scaled));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), result);
+  }
+  if (x < width)
+    LineProcHnopSnopLdec(hsl_shift, in + x, out + x, width - x);
+}
+#endif
+
 // Line processor: H no-op, S no-op, L increase.
 void LineProcHnopSnopLinc(const color_utils::HSL& hsl_shift,
                           const SkPMColor* in,
@@ -549,6 +597,10 @@ SkBitmap SkBitmapOperations::CreateHSLShiftedBitmap(
 
   HSLShift::LineProcessor line_proc =
       HSLShift::kLineProcessors[H_op][S_op][L_op];
+#if defined(SIMD_SSE2)
+  if (line_proc == HSLShift::LineProcHnopSnopLdec && base::CPU().has_sse2())
+    line_proc = HSLShift::LineProcHnopSnopLdec_SSE2;
+#endif
 
   DCHECK(bitmap.empty() == false);
   DCHECK(bitmap.config() == SkBitmap::kARGB_8888_Config);
@@ -624,6 +676,41 @@ SkBitmap SkBitmapOperations::DownsampleByTwoUntilSize(const SkBitmap& bitmap,
   return current;
 }
 
+#if defined(SIMD_SSE2)
+// Averages the 2x2 blocks of |src0| and |src1| into |count| pixels of |dst|,
+// with the same truncating arithmetic as DownsampleByTwo(). |count| must be a
+// multiple of 4, and both source rows must hold 2 * |count| pixels.
+static void DownsampleRowByTwo_SSE2(const SkPMColor* src0,
+                                    const SkPMColor* src1,
+                                    SkPMColor* dst,
+                                    int count) {
+  const __m128i zero = _mm_setzero_si128();
+  for (int x = 0; x < count; x += 4) {
+    __m128i halves[2];
+    for (int i = 0; i < 2; ++i) {
+      const __m128i* p0 = reinterpret_cast<const __m128i*>(src0 + 2 * x) + i;
+      const __m128i* p1 = reinterpret_cast<const __m128i*>(src1 + 2 * x) + i;
+      __m128i top = _mm_loadu_si128(p0);
+      __m128i bottom = _mm_loadu_si128(p1);
+
+      // Sum the two rows, one 16-bit lane per channel, so pixels 0 and 1 of
+      // the four are in |lo| and pixels 2 and 3 in |hi|.
+      __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(top, zero),
+                                 _mm_unpacklo_epi8(bottom, zero));
+      __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(top, zero),
+                                 _mm_unpackhi_epi8(bottom, zero));
+
+      // Then the horizontal neighbours, leaving the sums of the two blocks.
+      __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi),
+                                  _mm_unpackhi_epi64(lo, hi));
+      halves[i] = _mm_srli_epi16(sum, 2);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x),
+                     _mm_packus_epi16(halves[0], halves[1]));
+  }
+}
+#endif
+
 // static
 SkBitmap SkBitmapOperations::DownsampleByTwo(const SkBitmap& bitmap) {
   // Handle the nop case.
@@ -640,6 +727,12 @@ SkBitmap SkBitmapOperations::DownsampleByTwo(const SkBitmap& bitmap) {
   const int resultLastX = result.width() - 1;
   const int srcLastX = bitmap.width() - 1;
 
+#if defined(SIMD_SSE2)
+  // The SSE2 path handles whole 2x2 blocks, in groups of four, and leaves any
+  // remaining pixels to the loop below.
+  const int sse2_width = base::CPU().has_sse2() ? (bitmap.width() / 2) & ~3 : 0;
+#endif
+
   for (int dest_y = 0; dest_y < result.height(); ++dest_y) {
     const int src_y = dest_y << 1;
     const SkPMColor* SK_RESTRICT cur_src0 = bitmap.getAddr32(0, src_y);
@@ -649,7 +742,17 @@ SkBitmap SkBitmapOperations::DownsampleByTwo(const SkBitmap& bitmap) {
 
     SkPMColor* SK_RESTRICT cur_dst = result.getAddr32(0, dest_y);
 
-    for (int dest_x = 0; dest_x <= resultLastX; ++dest_x) {
+    int dest_x = 0;
+#if defined(SIMD_SSE2)
+    if (sse2_width) {
+      DownsampleRowByTwo_SSE2(cur_src0, cur_src1, cur_dst, sse2_width);
+      dest_x = sse2_width;
+      cur_src0 += 2 * sse2_width;
+      cur_src1 += 2 * sse2_width;
+      cur_dst += sse2_width;
+    }
+#endif
+    for (; dest_x <= resultLastX; ++dest_x) {
       // This code is based on downsampleby2_proc32 in SkBitmap.cpp. It is very
       // clever in that it does two channels at once: alpha and green ("ag")
       // and red and blue ("rb"). Each channel gets averaged across 4 pixels
@@ -0,0 +1,111 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures the SkBitmapOperations used when loading themes and painting the
+// tab strip, on a bitmap the size of a themed frame image.
+
+#include "base/basictypes.h"
+#include "base/logging.h"
+#include "base/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorPriv.h"
+#include "ui/gfx/skbitmap_operations.h"
+
+namespace {
+
+const int kWidth = 1024;
+const int kHeight = 256;
+const int kIterations = 50;
+
+// Fills |bitmap| with premultiplied pixels of varying colour and alpha.
+void CreateTestBitmap(SkBitmap* bitmap) {
+  bitmap->setConfig(SkBitmap::kARGB_8888_Config, kWidth, kHeight);
+  bitmap->allocPixels();
+  SkAutoLockPixels lock(*bitmap);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      *bitmap->getAddr32(x, y) = SkPreMultiplyColor(
+          SkColorSetARGB(x + y, x * 3, y * 5, x ^ y));
+    }
+  }
+}
+
+class SkBitmapOperationsPerfTest : public testing::Test {
+ public:
+  SkBitmapOperationsPerfTest() {}
+
+  virtual void SetUp() OVERRIDE {
+    CreateTestBitmap(&first_);
+    CreateTestBitmap(&second_);
+  }
+
+ protected:
+  // Starts timing an operation.
+  void Start() {
+    start_ = base::TimeTicks::HighResNow();
+  }
+
+  // Logs the average time per iteration since Start().
+  void Stop(const char* name) {
+    base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start_;
+    LOG(INFO) << name << " " << kWidth << "x" << kHeight
+              << " us=" << elapsed.InMicroseconds() / kIterations;
+  }
+
+  SkBitmap first_;
+  SkBitmap second_;
+
+ private:
+  base::TimeTicks start_;
+
+  DISALLOW_COPY_AND_ASSIGN(SkBitmapOperationsPerfTest);
+};
+
+}  // namespace
+
+TEST_F(SkBitmapOperationsPerfTest, CreateBlendedBitmap) {
+  Start();
+  for (int i = 0; i < kIterations; ++i)
+    SkBitmapOperations::CreateBlendedBitmap(first_, second_, 0.3);
+  Stop("CreateBlendedBitmap");
+}
+
+TEST_F(SkBitmapOperationsPerfTest, CreateMaskedBitmap) {
+  Start();
+  for (int i = 0; i < kIterations; ++i)
+    SkBitmapOperations::CreateMaskedBitmap(first_, second_);
+  Stop("CreateMaskedBitmap");
+}
+
+TEST_F(SkBitmapOperationsPerfTest, CreateHSLShiftedBitmap) {
+  // Lightness only, as for the inactive frame tint, then a full shift.
+  color_utils::HSL darken = { -1, -1, 0.3 };
+  Start();
+  for (int i = 0; i < kIterations; ++i)
+    SkBitmapOperations::CreateHSLShiftedBitmap(first_, darken);
+  Stop("CreateHSLShiftedBitmap lightness");
+
+  color_utils::HSL tint = { 0.6, 0.7, 0.4 };
+  Start();
+  for (int i = 0; i < kIterations; ++i)
+    SkBitmapOperations::CreateHSLShiftedBitmap(first_, tint);
+  Stop("CreateHSLShiftedBitmap hue+saturation+lightness");
+}
+
+TEST_F(SkBitmapOperationsPerfTest, DownsampleByTwo) {
+  Start();
+  for (int i = 0; i < kIterations; ++i)
+    SkBitmapOperations::DownsampleByTwo(first_);
+  Stop("DownsampleByTwo");
+}
+
+TEST_F(SkBitmapOperationsPerfTest, CreateButtonBackground) {
+  Start();
+  for (int i = 0; i < kIterations; ++i) {
+    SkBitmapOperations::CreateButtonBackground(SkColorSetRGB(0x40, 0x80, 0xC0),
+                                               first_, second_);
+  }
+  Stop("CreateButtonBackground");
+}
@@ -4,6 +4,8 @@
 
 #include "ui/gfx/skbitmap_operations.h"
 
+#include <algorithm>
+
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkColorPriv.h"
@@ -315,6 +317,40 @@ TEST(SkBitmapOperationsTest, ValidateHSLShift) {
   }
 }
 
+// A lightness decrease alone scales each colour channel, truncating, and
+// leaves alpha untouched.
+TEST(SkBitmapOperationsTest, CreateHSLShiftedBitmapLightnessOnly) {
+  const int kWidth = 19;
+  SkBitmap src;
+  src.setConfig(SkBitmap::kARGB_8888_Config, kWidth, 16);
+  src.allocPixels();
+  for (int y = 0; y < 16; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      *src.getAddr32(x, y) = SkPreMultiplyColor(
+          SkColorSetARGB(y * 17, x * 13, 255 - x * 13, y * 16));
+    }
+  }
+
+  color_utils::HSL hsl = { -1, -1, 0.3 };
+  SkBitmap shifted = SkBitmapOperations::CreateHSLShiftedBitmap(src, hsl);
+
+  const uint32 ldec_num = static_cast<uint32>(0.3 * 2 * 65536);
+  SkAutoLockPixels src_lock(src);
+  SkAutoLockPixels shifted_lock(shifted);
+  for (int y = 0; y < 16; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      SkPMColor in = *src.getAddr32(x, y);
+      SkPMColor expected = SkPackARGB32(
+          SkGetPackedA32(in),
+          SkGetPackedR32(in) * ldec_num / 65536,
+          SkGetPackedG32(in) * ldec_num / 65536,
+          SkGetPackedB32(in) * ldec_num / 65536);
+      EXPECT_EQ(expected, *shifted.getAddr32(x, y))
+          << "x = " << x << ", y = " << y;
+    }
+  }
+}
+
 // Test our cropping.
 TEST(SkBitmapOperationsTest, CreateCroppedBitmap) {
   int src_w = 16, src_h = 16;
@@ -444,6 +480,41 @@ TEST(SkBitmapOperationsTest, DownsampleByTwoSmall) {
   EXPECT_EQ(0, result.height());
 }
 
+// Checks that every pixel is exactly the truncated average of its 2x2 block,
+// across widths that exercise both the vectorized part of each row and the
+// pixels left over after it.
+TEST(SkBitmapOperationsTest, DownsampleByTwoExact) {
+  for (int width = 2; width <= 21; ++width) {
+    SkBitmap input;
+    FillDataToBitmap(width, 5, &input);
+    SkAutoLockPixels input_lock(input);
+    for (int i = 0; i < width * 5; ++i)
+      input.getAddr32(0, 0)[i] *= 2654435761U;
+
+    SkBitmap result = SkBitmapOperations::DownsampleByTwo(input);
+    SkAutoLockPixels result_lock(result);
+    for (int y = 0; y < result.height(); ++y) {
+      int y1 = std::min(y * 2 + 1, input.height() - 1);
+      for (int x = 0; x < result.width(); ++x) {
+        int x1 = std::min(x * 2 + 1, width - 1);
+        uint32 block[4] = {
+          *input.getAddr32(x * 2, y * 2), *input.getAddr32(x1, y * 2),
+          *input.getAddr32(x * 2, y1), *input.getAddr32(x1, y1)
+        };
+        uint32 expected = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+          uint32 sum = 0;
+          for (int i = 0; i < 4; ++i)
+            sum += (block[i] >> shift) & 0xFF;
+          expected |= (sum / 4) << shift;
+        }
+        EXPECT_EQ(expected, *result.getAddr32(x, y))
+            << "width = " << width << ", x = " << x << ", y = " << y;
+      }
+    }
+  }
+}
+
 // Here we assume DownsampleByTwo works correctly (it's tested above) and
 // just make sure that the wrapper function does the right thing.
 TEST(SkBitmapOperationsTest, DownsampleByTwoUntilSize) {
@@ -4,6 +4,8 @@
 
 #include "webkit/appcache/appcache_update_job.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/compiler_specific.h"
@@ -22,6 +24,8 @@ namespace appcache {
 
 static const int kBufferSize = 32768;
 static const size_t kMaxConcurrentUrlFetches = 2;
+static const size_t kMinUrlFetchConcurrency = 2;
+static const size_t kMaxUrlFetchConcurrency = 6;
 static const int kMax503Retries = 3;
 
 // Helper class for collecting hosts per frontend when sending notifications
@@ -301,6 +305,7 @@ AppCacheUpdateJob::AppCacheUpdateJob(AppCacheService* service,
       internal_state_(FETCH_MANIFEST),
       master_entries_completed_(0),
       url_fetches_completed_(0),
+      url_fetch_concurrency_(kMinUrlFetchConcurrency),
       manifest_fetcher_(NULL),
       stored_state_(UNSTORED) {
 }
@@ -541,6 +546,7 @@ void AppCacheUpdateJob::HandleUrlFetchCompleted(URLFetcher* fetcher) {
 
   int response_code = request->status().is_success()
       ? request->GetResponseCode() : -1;
+  AdjustUrlFetchConcurrency(response_code);
   AppCacheEntry& entry = url_file_list_.find(url)->second;
 
   if (response_code / 100 == 2) {
@@ -931,7 +937,7 @@ void AppCacheUpdateJob::FetchUrls() {
   // Fetch each URL in the list according to section 6.9.4 step 17.1-17.3.
   // Fetch up to the concurrent limit. Other fetches will be triggered as each
   // each fetch completes.
-  while (pending_url_fetches_.size() < kMaxConcurrentUrlFetches &&
+  while (pending_url_fetches_.size() < url_fetch_concurrency_ &&
          !urls_to_fetch_.empty()) {
     UrlToFetch url_to_fetch = urls_to_fetch_.front();
     urls_to_fetch_.pop_front();
@@ -969,6 +975,18 @@ void AppCacheUpdateJob::FetchUrls() {
   }
 }
 
+void AppCacheUpdateJob::AdjustUrlFetchConcurrency(int response_code) {
+  // Manifests can list thousands of resources, so ramp up while the server
+  // keeps up, and back off quickly once requests fail or it reports errors.
+  if (response_code != -1 && response_code / 100 != 5) {
+    url_fetch_concurrency_ =
+        std::min(url_fetch_concurrency_ + 1, kMaxUrlFetchConcurrency);
+  } else {
+    url_fetch_concurrency_ =
+        std::max(url_fetch_concurrency_ / 2, kMinUrlFetchConcurrency);
+  }
+}
+
 void AppCacheUpdateJob::CancelAllUrlFetches() {
   // Cancel any pending URL requests.
   for (PendingUrlFetches::iterator it = pending_url_fetches_.begin();
@@ -191,6 +191,7 @@ class APPCACHE_EXPORT AppCacheUpdateJob : public AppCacheStorage::Delegate,
   void BuildUrlFileList(const Manifest& manifest);
   void AddUrlToFileList(const GURL& url, int type);
   void FetchUrls();
+  void AdjustUrlFetchConcurrency(int response_code);
   void CancelAllUrlFetches();
   bool ShouldSkipUrlFetch(const AppCacheEntry& entry);
 
@@ -260,6 +261,10 @@ class APPCACHE_EXPORT AppCacheUpdateJob : public AppCacheStorage::Delegate,
   AppCache::EntryMap url_file_list_;
   size_t url_fetches_completed_;
 
+  // How many URL fetches may be in flight at once. Grows by one with each
+  // fetch the server answers, and is halved on network or server errors.
+  size_t url_fetch_concurrency_;
+
   // Helper container to track which urls have not been fetched yet. URLs are
   // removed when the fetch is initiated. Flag indicates whether an attempt
   // to load the URL from storage has already been tried and failed.
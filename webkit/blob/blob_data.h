@@ -5,11 +5,13 @@
 #ifndef WEBKIT_BLOB_BLOB_DATA_H_
 #define WEBKIT_BLOB_BLOB_DATA_H_
 
+#include <algorithm>
 #include <vector>
 
 #include "base/basictypes.h"
 #include "base/file_path.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/time.h"
 #include "googleurl/src/gurl.h"
 #include "webkit/blob/blob_export.h"
@@ -45,6 +47,16 @@ class BLOB_EXPORT BlobData : public base::RefCounted<BlobData> {
       this->length = length;
     }
 
+    // Makes this a Data item for |length| bytes at |offset| in |shared_data|,
+    // which other items may be viewing too.
+    void SetToSharedData(base::RefCountedString* shared_data,
+                         uint64 offset, uint64 length) {
+      type = TYPE_DATA;
+      this->shared_data = shared_data;
+      this->offset = offset;
+      this->length = length;
+    }
+
     void SetToDataExternal(const char* data, size_t length) {
       type = TYPE_DATA_EXTERNAL;
       this->data_external = data;
@@ -68,8 +80,14 @@ class BLOB_EXPORT BlobData : public base::RefCounted<BlobData> {
       this->length = length;
     }
 
+    // Returns the bytes of a Data item, which |offset| is relative to.
+    const char* bytes() const {
+      return shared_data ? shared_data->data().data() : data.data();
+    }
+
     Type type;
     std::string data;  // For Data type.
+    scoped_refptr<base::RefCountedString> shared_data;  // Or this, instead.
     const char* data_external;  // For DataExternal type.
     GURL blob_url;  // For Blob type.
     FilePath file_path;  // For File type.
@@ -92,6 +110,14 @@ class BLOB_EXPORT BlobData : public base::RefCounted<BlobData> {
     }
   }
 
+  void AppendSharedData(base::RefCountedString* shared_data,
+                        uint64 offset, uint64 length) {
+    if (length > 0) {
+      items_.push_back(Item());
+      items_.back().SetToSharedData(shared_data, offset, length);
+    }
+  }
+
   void AppendFile(const FilePath& file_path, uint64 offset, uint64 length,
                   const base::Time& expected_modification_time) {
     items_.push_back(Item());
@@ -122,12 +148,14 @@ class BLOB_EXPORT BlobData : public base::RefCounted<BlobData> {
     content_disposition_ = content_disposition;
   }
 
+  // Shared data is counted by the length each item views, so bytes shared
+  // between blobs count once for each of them.
   int64 GetMemoryUsage() const {
     int64 memory = 0;
     for (std::vector<Item>::const_iterator iter = items_.begin();
          iter != items_.end(); ++iter) {
       if (iter->type == TYPE_DATA)
-        memory += iter->data.size();
+        memory += iter->shared_data ? iter->length : iter->data.size();
     }
     return memory;
   }
@@ -150,9 +178,10 @@ inline bool operator==(const BlobData::Item& a, const BlobData::Item& b) {
   if (a.type != b.type)
     return false;
   if (a.type == BlobData::TYPE_DATA) {
-    return a.data == b.data &&
-           a.offset == b.offset &&
-           a.length == b.length;
+    // Compare the bytes viewed, as they may be held in different ways.
+    return a.length == b.length &&
+           std::equal(a.bytes() + a.offset, a.bytes() + a.offset + a.length,
+                      b.bytes() + b.offset);
   }
   if (a.type == BlobData::TYPE_FILE) {
     return a.file_path == b.file_path &&
@@ -31,6 +31,17 @@ GURL ClearBlobUrlRef(const GURL& url) {
 
 static const int64 kMaxMemoryUsage = 1024 * 1024 * 1024;  // 1G
 
+// Appends a copy of |length| bytes at |data| to |blob_data|, held so that
+// slices of it can share the copy.
+void AppendCopiedData(BlobData* blob_data, const char* data, size_t length) {
+  if (!length)
+    return;
+  scoped_refptr<base::RefCountedString> shared_data(
+      new base::RefCountedString);
+  shared_data->data().assign(data, length);
+  blob_data->AppendSharedData(shared_data, 0, length);
+}
+
 }  // namespace
 
 BlobStorageController::BlobStorageController()
@@ -72,11 +83,11 @@ void BlobStorageController::AppendBlobDataItem(
     case BlobData::TYPE_DATA:
       // WebBlobData does not allow partial data.
       DCHECK(!(item.offset) && item.length == item.data.size());
-      target_blob_data->AppendData(item.data.c_str(), item.data.size());
+      AppendCopiedData(target_blob_data, item.data.c_str(), item.data.size());
       break;
     case BlobData::TYPE_DATA_EXTERNAL:
       DCHECK(!item.offset);
-      target_blob_data->AppendData(item.data_external, item.length);
+      AppendCopiedData(target_blob_data, item.data_external, item.length);
       break;
     case BlobData::TYPE_FILE:
       AppendFileItem(target_blob_data,
@@ -216,7 +227,7 @@ void BlobStorageController::ResolveBlobReferencesInUploadData(
           // TODO(michaeln): Now that blob_data surives for the duration,
           // maybe UploadData could take a raw ptr without having to copy.
           iter->SetToBytes(
-              &item.data.at(0) + static_cast<int>(item.offset),
+              item.bytes() + static_cast<int>(item.offset),
               static_cast<int>(item.length));
           break;
         case BlobData::TYPE_FILE:
@@ -255,9 +266,18 @@ void BlobStorageController::AppendStorageItems(
     uint64 current_length = iter->length - offset;
     uint64 new_length = current_length > length ? length : current_length;
     if (iter->type == BlobData::TYPE_DATA) {
-      target_blob_data->AppendData(
-          iter->data.c_str() + static_cast<size_t>(iter->offset + offset),
-          static_cast<uint32>(new_length));
+      // Slices share the source's bytes, unless the slice is small enough
+      // that it would keep much more memory alive than it is counted for.
+      uint64 data_offset = iter->offset + offset;
+      if (iter->shared_data &&
+          new_length >= iter->shared_data->data().size() / 2) {
+        target_blob_data->AppendSharedData(iter->shared_data, data_offset,
+                                           new_length);
+      } else {
+        AppendCopiedData(target_blob_data,
+                         iter->bytes() + static_cast<size_t>(data_offset),
+                         static_cast<size_t>(new_length));
+      }
     } else {
       DCHECK(iter->type == BlobData::TYPE_FILE);
       AppendFileItem(target_blob_data,
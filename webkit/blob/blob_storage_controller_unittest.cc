@@ -76,6 +76,45 @@ TEST(BlobStorageControllerTest, RegisterBlobUrl) {
   EXPECT_TRUE(!blob_data_found);
 }
 
+TEST(BlobStorageControllerTest, SliceSharesData) {
+  BlobStorageController blob_storage_controller;
+
+  scoped_refptr<BlobData> blob_data(new BlobData());
+  blob_data->AppendData("0123456789");
+  GURL blob_url1("blob://url_1");
+  blob_storage_controller.AddFinishedBlob(blob_url1, blob_data);
+  BlobData* source = blob_storage_controller.GetBlobDataFromUrl(blob_url1);
+  ASSERT_TRUE(source != NULL);
+  ASSERT_EQ(1U, source->items().size());
+
+  // A large slice views the source's bytes.
+  scoped_refptr<BlobData> large_slice(new BlobData());
+  large_slice->AppendBlob(blob_url1, 2, 6);
+  GURL blob_url2("blob://url_2");
+  blob_storage_controller.AddFinishedBlob(blob_url2, large_slice);
+  BlobData* found = blob_storage_controller.GetBlobDataFromUrl(blob_url2);
+  ASSERT_TRUE(found != NULL);
+  ASSERT_EQ(1U, found->items().size());
+  const BlobData::Item& large_item = found->items().at(0);
+  EXPECT_EQ(source->items().at(0).shared_data, large_item.shared_data);
+  EXPECT_EQ("234567", std::string(large_item.bytes() + large_item.offset,
+                                  large_item.length));
+  EXPECT_EQ(6, found->GetMemoryUsage());
+
+  // A small one gets its own copy.
+  scoped_refptr<BlobData> small_slice(new BlobData());
+  small_slice->AppendBlob(blob_url1, 8, 2);
+  GURL blob_url3("blob://url_3");
+  blob_storage_controller.AddFinishedBlob(blob_url3, small_slice);
+  found = blob_storage_controller.GetBlobDataFromUrl(blob_url3);
+  ASSERT_TRUE(found != NULL);
+  ASSERT_EQ(1U, found->items().size());
+  const BlobData::Item& small_item = found->items().at(0);
+  EXPECT_NE(source->items().at(0).shared_data, small_item.shared_data);
+  EXPECT_EQ("89", std::string(small_item.bytes() + small_item.offset,
+                              small_item.length));
+}
+
 TEST(BlobStorageControllerTest, ResolveBlobReferencesInUploadData) {
   // Setup blob data for testing.
   base::Time time1, time2;
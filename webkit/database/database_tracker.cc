@@ -465,6 +465,11 @@ bool DatabaseTracker::LazyInit() {
     DCHECK(!databases_table_.get());
     DCHECK(!meta_table_.get());
 
+    // Only the tracker accesses its database, and it keeps the connection
+    // open for its lifetime, so hold the lock rather than reacquiring it for
+    // every statement run as databases are opened, modified and closed.
+    db_->set_exclusive_locking();
+
     // If there are left-over directories from failed deletion attempts, clean
     // them up.
     if (file_util::DirectoryExists(db_dir_)) {
@@ -23,6 +23,7 @@ using webkit_database::DatabaseUtil;
 namespace dom_storage {
 
 static const int kCommitTimerSeconds = 1;
+static const int kBusyCommitTimerSeconds = 5;
 
 DomStorageArea::CommitBatch::CommitBatch()
   : clear_all_first(false) {
@@ -240,7 +241,7 @@ DomStorageArea::CommitBatch* DomStorageArea::CreateCommitBatchIfNeeded() {
       task_runner_->PostDelayedTask(
           FROM_HERE,
           base::Bind(&DomStorageArea::OnCommitTimer, this),
-          base::TimeDelta::FromSeconds(kCommitTimerSeconds));
+          ComputeCommitDelay());
     }
   }
   return commit_batch_.get();
@@ -285,15 +286,27 @@ void DomStorageArea::OnCommitComplete() {
   if (is_shutdown_)
     return;
   in_flight_commit_batch_.reset();
+  last_commit_time_ = base::TimeTicks::Now();
   if (commit_batch_.get()) {
     // More changes have accrued, restart the timer.
     task_runner_->PostDelayedTask(
         FROM_HERE,
         base::Bind(&DomStorageArea::OnCommitTimer, this),
-        base::TimeDelta::FromSeconds(kCommitTimerSeconds));
+        ComputeCommitDelay());
   }
 }
 
+base::TimeDelta DomStorageArea::ComputeCommitDelay() const {
+  // Changes arriving soon after the last commit are likely part of a
+  // burst of writes, so coalesce more of them into the next one.
+  if (!last_commit_time_.is_null() &&
+      base::TimeTicks::Now() - last_commit_time_ <
+          base::TimeDelta::FromSeconds(kBusyCommitTimerSeconds)) {
+    return base::TimeDelta::FromSeconds(kBusyCommitTimerSeconds);
+  }
+  return base::TimeDelta::FromSeconds(kCommitTimerSeconds);
+}
+
 void DomStorageArea::ShutdownInCommitSequence() {
   // This method executes on the commit sequence.
   DCHECK(task_runner_->IsRunningOnCommitSequence());
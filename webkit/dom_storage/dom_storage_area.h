@@ -11,6 +11,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/nullable_string16.h"
 #include "base/string16.h"
+#include "base/time.h"
 #include "googleurl/src/gurl.h"
 #include "webkit/dom_storage/dom_storage_database.h"
 #include "webkit/dom_storage/dom_storage_types.h"
@@ -74,6 +75,7 @@ class DomStorageArea
   FRIEND_TEST_ALL_PREFIXES(DomStorageAreaTest, BackingDatabaseOpened);
   FRIEND_TEST_ALL_PREFIXES(DomStorageAreaTest, TestDatabaseFilePath);
   FRIEND_TEST_ALL_PREFIXES(DomStorageAreaTest, CommitTasks);
+  FRIEND_TEST_ALL_PREFIXES(DomStorageAreaTest, CommitDelay);
   FRIEND_TEST_ALL_PREFIXES(DomStorageAreaTest, CommitChangesAtShutdown);
   FRIEND_TEST_ALL_PREFIXES(DomStorageAreaTest, DeleteOrigin);
   FRIEND_TEST_ALL_PREFIXES(DomStorageAreaTest, PurgeMemory);
@@ -101,6 +103,12 @@ class DomStorageArea
   void CommitChanges();
   void OnCommitComplete();
 
+  // Returns how long to let changes accrue before committing them.
+  // Areas that were committed recently wait longer, so that a page
+  // writing continuously costs one disk transaction per few seconds
+  // rather than one per second.
+  base::TimeDelta ComputeCommitDelay() const;
+
   void ShutdownInCommitSequence();
 
   int64 namespace_id_;
@@ -113,6 +121,7 @@ class DomStorageArea
   bool is_shutdown_;
   scoped_ptr<CommitBatch> commit_batch_;
   scoped_ptr<CommitBatch> in_flight_commit_batch_;
+  base::TimeTicks last_commit_time_;
 };
 
 }  // namespace dom_storage
@@ -270,6 +270,22 @@ TEST_F(DomStorageAreaTest, CommitTasks) {
   EXPECT_EQ(kValue2, values[kKey2].string());
 }
 
+TEST_F(DomStorageAreaTest, CommitDelay) {
+  scoped_refptr<DomStorageArea> area(
+      new DomStorageArea(kLocalStorageNamespaceId, kOrigin, FilePath(),
+          new MockDomStorageTaskRunner(base::MessageLoopProxy::current())));
+
+  // An area that hasn't committed recently uses the short delay.
+  base::TimeDelta idle_delay = area->ComputeCommitDelay();
+  area->last_commit_time_ =
+      base::TimeTicks::Now() - base::TimeDelta::FromMinutes(1);
+  EXPECT_EQ(idle_delay, area->ComputeCommitDelay());
+
+  // One that just committed waits longer before the next commit.
+  area->last_commit_time_ = base::TimeTicks::Now();
+  EXPECT_GT(area->ComputeCommitDelay(), idle_delay);
+}
+
 TEST_F(DomStorageAreaTest, CommitChangesAtShutdown) {
   ScopedTempDir temp_dir;
   ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
@@ -0,0 +1,178 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "webkit/dom_storage/dom_storage_cached_area.h"
+
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/logging.h"
+#include "webkit/dom_storage/dom_storage_map.h"
+#include "webkit/dom_storage/dom_storage_proxy.h"
+
+namespace dom_storage {
+
+DomStorageCachedArea::DomStorageCachedArea(
+    int64 namespace_id, const GURL& origin, DomStorageProxy* proxy)
+    : ignore_all_mutations_(0),
+      namespace_id_(namespace_id),
+      origin_(origin),
+      proxy_(proxy) {
+}
+
+DomStorageCachedArea::~DomStorageCachedArea() {}
+
+unsigned DomStorageCachedArea::GetLength(int connection_id) {
+  PrimeIfNeeded(connection_id);
+  return map_->Length();
+}
+
+NullableString16 DomStorageCachedArea::GetKey(
+    int connection_id, unsigned index) {
+  PrimeIfNeeded(connection_id);
+  return map_->Key(index);
+}
+
+NullableString16 DomStorageCachedArea::GetItem(
+    int connection_id, const string16& key) {
+  PrimeIfNeeded(connection_id);
+  return map_->GetItem(key);
+}
+
+bool DomStorageCachedArea::SetItem(
+    int connection_id, const string16& key, const string16& value,
+    const GURL& page_url, NullableString16* old_value) {
+  // A quick check to reject obviously overbudget items to avoid
+  // priming the cache.
+  if (key.length() + value.length() > kPerAreaQuota)
+    return false;
+
+  PrimeIfNeeded(connection_id);
+  if (!map_->SetItem(key, value, old_value))
+    return false;
+
+  // Ignore mutations to |key| until OnSetItemComplete.
+  ++ignore_key_mutations_[key];
+  proxy_->SetItem(
+      connection_id, key, value, page_url,
+      base::Bind(&DomStorageCachedArea::OnSetItemComplete, this, key));
+  return true;
+}
+
+bool DomStorageCachedArea::RemoveItem(
+    int connection_id, const string16& key, const GURL& page_url,
+    string16* old_value) {
+  PrimeIfNeeded(connection_id);
+  if (!map_->RemoveItem(key, old_value))
+    return false;
+
+  // Ignore mutations to |key| until OnRemoveItemComplete.
+  ++ignore_key_mutations_[key];
+  proxy_->RemoveItem(
+      connection_id, key, page_url,
+      base::Bind(&DomStorageCachedArea::OnRemoveItemComplete, this, key));
+  return true;
+}
+
+bool DomStorageCachedArea::Clear(int connection_id, const GURL& page_url) {
+  // No need to prime the cache in this case.
+  bool cleared_something = !map_ || map_->Length() > 0;
+  Reset();
+  map_ = new DomStorageMap(kPerAreaQuota);
+
+  // Ignore all mutations until OnClearComplete time.
+  ++ignore_all_mutations_;
+  proxy_->ClearArea(
+      connection_id, page_url,
+      base::Bind(&DomStorageCachedArea::OnClearComplete, this));
+  return cleared_something;
+}
+
+void DomStorageCachedArea::ApplyMutation(
+    const NullableString16& key, const NullableString16& new_value) {
+  if (!map_ || ignore_all_mutations_)
+    return;
+
+  if (key.is_null()) {
+    // It's a clear event. Local changes made after it was issued must be
+    // retained.
+    scoped_refptr<DomStorageMap> old = map_;
+    map_ = new DomStorageMap(kPerAreaQuota);
+    std::map<string16, int>::const_iterator iter =
+        ignore_key_mutations_.begin();
+    for (; iter != ignore_key_mutations_.end(); ++iter) {
+      NullableString16 value = old->GetItem(iter->first);
+      if (!value.is_null()) {
+        NullableString16 unused;
+        map_->SetItem(iter->first, value.string(), &unused);
+      }
+    }
+    return;
+  }
+
+  // Local changes to the key win until the host has confirmed them.
+  if (should_ignore_key_mutation(key.string()))
+    return;
+
+  if (new_value.is_null()) {
+    string16 unused;
+    map_->RemoveItem(key.string(), &unused);
+    return;
+  }
+
+  // The host has already accepted this value, which may have used an over
+  // budget allowance, so don't check quota here.
+  NullableString16 unused;
+  map_->set_quota(kint32max);
+  map_->SetItem(key.string(), new_value.string(), &unused);
+  map_->set_quota(kPerAreaQuota);
+}
+
+size_t DomStorageCachedArea::MemoryBytesUsedByCache() const {
+  return map_ ? map_->bytes_used() : 0;
+}
+
+void DomStorageCachedArea::PrimeIfNeeded(int connection_id) {
+  if (map_)
+    return;
+  ValuesMap values;
+  proxy_->LoadArea(connection_id, &values);
+  map_ = new DomStorageMap(kPerAreaQuota);
+  map_->SwapValues(&values);
+}
+
+void DomStorageCachedArea::Reset() {
+  // Mutations still in flight keep their entries, they are removed as
+  // the host confirms each one.
+  map_ = NULL;
+}
+
+void DomStorageCachedArea::OnSetItemComplete(
+    const string16& key, bool success) {
+  std::map<string16, int>::iterator found = ignore_key_mutations_.find(key);
+  DCHECK(found != ignore_key_mutations_.end());
+  if (--found->second == 0)
+    ignore_key_mutations_.erase(found);
+
+  // The host rejected the value, most likely for quota, so our cached copy
+  // is wrong. Drop it and reload on next access.
+  if (!success)
+    Reset();
+}
+
+void DomStorageCachedArea::OnRemoveItemComplete(
+    const string16& key, bool success) {
+  DCHECK(success);
+  std::map<string16, int>::iterator found = ignore_key_mutations_.find(key);
+  DCHECK(found != ignore_key_mutations_.end());
+  if (--found->second == 0)
+    ignore_key_mutations_.erase(found);
+}
+
+void DomStorageCachedArea::OnClearComplete(bool success) {
+  DCHECK(success);
+  DCHECK_GT(ignore_all_mutations_, 0);
+  --ignore_all_mutations_;
+}
+
+}  // namespace dom_storage
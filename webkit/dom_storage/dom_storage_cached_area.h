@@ -0,0 +1,89 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef WEBKIT_DOM_STORAGE_DOM_STORAGE_CACHED_AREA_H_
+#define WEBKIT_DOM_STORAGE_DOM_STORAGE_CACHED_AREA_H_
+#pragma once
+
+#include <map>
+
+#include "base/gtest_prod_util.h"
+#include "base/memory/ref_counted.h"
+#include "base/nullable_string16.h"
+#include "googleurl/src/gurl.h"
+
+namespace dom_storage {
+
+class DomStorageMap;
+class DomStorageProxy;
+
+// Unlike the other classes in the dom_storage library, this one is intended
+// for use in renderer processes. It maintains a complete cache of the
+// origin's Map of key/value pairs for fast access. The cache is primed on
+// first access and changes are written to the backend thru the |proxy|.
+// Mutations originating in other processes are applied to the cache via
+// the ApplyMutation method.
+class DomStorageCachedArea : public base::RefCounted<DomStorageCachedArea> {
+ public:
+  DomStorageCachedArea(int64 namespace_id, const GURL& origin,
+                       DomStorageProxy* proxy);
+
+  int64 namespace_id() const { return namespace_id_; }
+  const GURL& origin() const { return origin_; }
+
+  unsigned GetLength(int connection_id);
+  NullableString16 GetKey(int connection_id, unsigned index);
+  NullableString16 GetItem(int connection_id, const string16& key);
+  bool SetItem(int connection_id, const string16& key, const string16& value,
+               const GURL& page_url, NullableString16* old_value);
+  bool RemoveItem(int connection_id, const string16& key,
+                  const GURL& page_url, string16* old_value);
+  bool Clear(int connection_id, const GURL& page_url);
+
+  // Applies a change made by another process. A null |key| is a clear,
+  // and a null |new_value| is a removal. Changes to keys this process has
+  // modified since are ignored until the host confirms ours.
+  void ApplyMutation(const NullableString16& key,
+                     const NullableString16& new_value);
+
+  size_t MemoryBytesUsedByCache() const;
+
+ private:
+  friend class base::RefCounted<DomStorageCachedArea>;
+  FRIEND_TEST_ALL_PREFIXES(DomStorageCachedAreaTest, MutationsAreIgnored);
+  ~DomStorageCachedArea();
+
+  // Primes the cache, loading all values for the area.
+  void PrimeIfNeeded(int connection_id);
+
+  // Resets the object back to its newly constructed state.
+  void Reset();
+
+  // Async completion callbacks for proxied operations.
+  void OnSetItemComplete(const string16& key, bool success);
+  void OnRemoveItemComplete(const string16& key, bool success);
+  void OnClearComplete(bool success);
+
+  bool should_ignore_key_mutation(const string16& key) const {
+    return ignore_key_mutations_.find(key) != ignore_key_mutations_.end();
+  }
+
+  // Counts of local mutations per key that the host has not confirmed.
+  std::map<string16, int> ignore_key_mutations_;
+
+  // Number of local clears the host has not confirmed. All mutations from
+  // other processes are ignored while any are outstanding.
+  int ignore_all_mutations_;
+
+  int64 namespace_id_;
+  GURL origin_;
+  scoped_refptr<DomStorageMap> map_;
+  scoped_refptr<DomStorageProxy> proxy_;
+
+  DISALLOW_COPY_AND_ASSIGN(DomStorageCachedArea);
+};
+
+}  // namespace dom_storage
+
+#endif  // WEBKIT_DOM_STORAGE_DOM_STORAGE_CACHED_AREA_H_
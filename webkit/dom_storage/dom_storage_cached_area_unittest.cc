@@ -0,0 +1,187 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <list>
+
+#include "base/bind.h"
+#include "base/utf_string_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "webkit/dom_storage/dom_storage_cached_area.h"
+#include "webkit/dom_storage/dom_storage_proxy.h"
+
+namespace dom_storage {
+
+namespace {
+
+// A mock implementation of the DomStorageProxy interface.
+class MockProxy : public DomStorageProxy {
+ public:
+  MockProxy() : load_area_count_(0) {}
+
+  virtual void LoadArea(int connection_id, ValuesMap* values) OVERRIDE {
+    ++load_area_count_;
+    *values = load_area_return_values_;
+  }
+
+  virtual void SetItem(int connection_id, const string16& key,
+                       const string16& value, const GURL& page_url,
+                       const CompletionCallback& callback) OVERRIDE {
+    pending_callbacks_.push_back(callback);
+  }
+
+  virtual void RemoveItem(int connection_id, const string16& key,
+                          const GURL& page_url,
+                          const CompletionCallback& callback) OVERRIDE {
+    pending_callbacks_.push_back(callback);
+  }
+
+  virtual void ClearArea(int connection_id,
+                         const GURL& page_url,
+                         const CompletionCallback& callback) OVERRIDE {
+    pending_callbacks_.push_back(callback);
+  }
+
+  // Completes the oldest operation sent to the host.
+  void CompleteOnePendingCallback(bool success) {
+    ASSERT_TRUE(!pending_callbacks_.empty());
+    pending_callbacks_.front().Run(success);
+    pending_callbacks_.pop_front();
+  }
+
+  ValuesMap load_area_return_values_;
+  int load_area_count_;
+  std::list<CompletionCallback> pending_callbacks_;
+
+ private:
+  virtual ~MockProxy() {}
+};
+
+const int64 kNamespaceId = 10;
+const int kConnectionId = 7;
+
+}  // namespace
+
+class DomStorageCachedAreaTest : public testing::Test {
+ public:
+  DomStorageCachedAreaTest()
+    : kOrigin("http://dom_storage/"),
+      kKey(ASCIIToUTF16("key")),
+      kValue(ASCIIToUTF16("value")),
+      kPageUrl("http://dom_storage/page"),
+      mock_proxy_(new MockProxy()) {
+    mock_proxy_->load_area_return_values_[kKey] =
+        NullableString16(kValue, false);
+  }
+
+  const GURL kOrigin;
+  const string16 kKey;
+  const string16 kValue;
+  const GURL kPageUrl;
+  scoped_refptr<MockProxy> mock_proxy_;
+};
+
+TEST_F(DomStorageCachedAreaTest, ReadsAreLocal) {
+  scoped_refptr<DomStorageCachedArea> cached_area =
+      new DomStorageCachedArea(kNamespaceId, kOrigin, mock_proxy_);
+  EXPECT_EQ(kNamespaceId, cached_area->namespace_id());
+  EXPECT_EQ(kOrigin, cached_area->origin());
+  EXPECT_EQ(0u, cached_area->MemoryBytesUsedByCache());
+
+  // The first read primes the cache, later ones don't go to the host.
+  EXPECT_EQ(1u, cached_area->GetLength(kConnectionId));
+  EXPECT_EQ(kKey, cached_area->GetKey(kConnectionId, 0).string());
+  EXPECT_EQ(kValue, cached_area->GetItem(kConnectionId, kKey).string());
+  EXPECT_EQ(1, mock_proxy_->load_area_count_);
+  EXPECT_NE(0u, cached_area->MemoryBytesUsedByCache());
+
+  // Writes are applied locally and sent without waiting.
+  const string16 kValue2(ASCIIToUTF16("value2"));
+  NullableString16 old_value;
+  EXPECT_TRUE(cached_area->SetItem(kConnectionId, kKey, kValue2, kPageUrl,
+                                   &old_value));
+  EXPECT_EQ(kValue, old_value.string());
+  EXPECT_EQ(kValue2, cached_area->GetItem(kConnectionId, kKey).string());
+  EXPECT_EQ(1u, mock_proxy_->pending_callbacks_.size());
+
+  string16 removed_value;
+  EXPECT_TRUE(cached_area->RemoveItem(kConnectionId, kKey, kPageUrl,
+                                      &removed_value));
+  EXPECT_EQ(kValue2, removed_value);
+  EXPECT_EQ(0u, cached_area->GetLength(kConnectionId));
+
+  // Removing a key that isn't there doesn't go to the host.
+  EXPECT_FALSE(cached_area->RemoveItem(kConnectionId, kKey, kPageUrl,
+                                       &removed_value));
+  EXPECT_EQ(2u, mock_proxy_->pending_callbacks_.size());
+  EXPECT_EQ(1, mock_proxy_->load_area_count_);
+}
+
+TEST_F(DomStorageCachedAreaTest, MutationsAreIgnored) {
+  scoped_refptr<DomStorageCachedArea> cached_area =
+      new DomStorageCachedArea(kNamespaceId, kOrigin, mock_proxy_);
+  const string16 kKey2(ASCIIToUTF16("key2"));
+  const string16 kLocalValue(ASCIIToUTF16("local"));
+  const string16 kRemoteValue(ASCIIToUTF16("remote"));
+
+  // Mutations before the cache is primed are ignored, the values are
+  // loaded when it is.
+  cached_area->ApplyMutation(NullableString16(kKey2, false),
+                             NullableString16(kRemoteValue, false));
+  EXPECT_EQ(0u, cached_area->MemoryBytesUsedByCache());
+
+  // A remote change to a key with a local change in flight is ignored,
+  // other keys are updated.
+  NullableString16 old_value;
+  EXPECT_TRUE(cached_area->SetItem(kConnectionId, kKey, kLocalValue,
+                                   kPageUrl, &old_value));
+  EXPECT_TRUE(cached_area->should_ignore_key_mutation(kKey));
+  cached_area->ApplyMutation(NullableString16(kKey, false),
+                             NullableString16(kRemoteValue, false));
+  cached_area->ApplyMutation(NullableString16(kKey2, false),
+                             NullableString16(kRemoteValue, false));
+  EXPECT_EQ(kLocalValue, cached_area->GetItem(kConnectionId, kKey).string());
+  EXPECT_EQ(kRemoteValue,
+            cached_area->GetItem(kConnectionId, kKey2).string());
+
+  // A remote clear keeps the local change.
+  cached_area->ApplyMutation(NullableString16(true), NullableString16(true));
+  EXPECT_EQ(1u, cached_area->GetLength(kConnectionId));
+  EXPECT_EQ(kLocalValue, cached_area->GetItem(kConnectionId, kKey).string());
+
+  // Once the host confirms it, remote changes to the key apply again.
+  mock_proxy_->CompleteOnePendingCallback(true);
+  EXPECT_FALSE(cached_area->should_ignore_key_mutation(kKey));
+  cached_area->ApplyMutation(NullableString16(kKey, false),
+                             NullableString16(true));
+  EXPECT_EQ(0u, cached_area->GetLength(kConnectionId));
+
+  // Everything is ignored while a local clear is in flight.
+  EXPECT_TRUE(cached_area->Clear(kConnectionId, kPageUrl));
+  cached_area->ApplyMutation(NullableString16(kKey, false),
+                             NullableString16(kRemoteValue, false));
+  EXPECT_EQ(0u, cached_area->GetLength(kConnectionId));
+  mock_proxy_->CompleteOnePendingCallback(true);
+  cached_area->ApplyMutation(NullableString16(kKey, false),
+                             NullableString16(kRemoteValue, false));
+  EXPECT_EQ(1u, cached_area->GetLength(kConnectionId));
+  EXPECT_EQ(1, mock_proxy_->load_area_count_);
+}
+
+TEST_F(DomStorageCachedAreaTest, RejectedSetReloads) {
+  scoped_refptr<DomStorageCachedArea> cached_area =
+      new DomStorageCachedArea(kNamespaceId, kOrigin, mock_proxy_);
+  const string16 kValue2(ASCIIToUTF16("value2"));
+  NullableString16 old_value;
+  EXPECT_TRUE(cached_area->SetItem(kConnectionId, kKey, kValue2, kPageUrl,
+                                   &old_value));
+  EXPECT_EQ(1, mock_proxy_->load_area_count_);
+
+  // The host's copy is reloaded after it rejects a change.
+  mock_proxy_->CompleteOnePendingCallback(false);
+  EXPECT_EQ(0u, cached_area->MemoryBytesUsedByCache());
+  EXPECT_EQ(kValue, cached_area->GetItem(kConnectionId, kKey).string());
+  EXPECT_EQ(2, mock_proxy_->load_area_count_);
+}
+
+}  // namespace dom_storage
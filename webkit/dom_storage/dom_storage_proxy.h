@@ -0,0 +1,46 @@
+// Copyright (c) 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef WEBKIT_DOM_STORAGE_DOM_STORAGE_PROXY_H_
+#define WEBKIT_DOM_STORAGE_DOM_STORAGE_PROXY_H_
+#pragma once
+
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/string16.h"
+#include "webkit/dom_storage/dom_storage_types.h"
+
+class GURL;
+
+namespace dom_storage {
+
+// Abstract interface for the cached area to talk to the DomStorageHost
+// that holds the authoritative copy of its values, typically over IPC.
+class DomStorageProxy : public base::RefCounted<DomStorageProxy> {
+ public:
+  typedef base::Callback<void(bool)> CompletionCallback;
+
+  // Retrieves all of the values in the area, blocking until they arrive.
+  virtual void LoadArea(int connection_id, ValuesMap* values) = 0;
+
+  // Mutations are sent without waiting for a reply. The |callback| runs
+  // once the host has applied the change, with false if it was rejected.
+  virtual void SetItem(int connection_id, const string16& key,
+                       const string16& value, const GURL& page_url,
+                       const CompletionCallback& callback) = 0;
+  virtual void RemoveItem(int connection_id, const string16& key,
+                          const GURL& page_url,
+                          const CompletionCallback& callback) = 0;
+  virtual void ClearArea(int connection_id,
+                         const GURL& page_url,
+                         const CompletionCallback& callback) = 0;
+
+ protected:
+  friend class base::RefCounted<DomStorageProxy>;
+  virtual ~DomStorageProxy() {}
+};
+
+}  // namespace dom_storage
+
+#endif  // WEBKIT_DOM_STORAGE_DOM_STORAGE_PROXY_H_
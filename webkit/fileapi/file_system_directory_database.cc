@@ -434,14 +434,17 @@ bool FileSystemDirectoryDatabase::ListChildren(
   DCHECK(children);
   std::string child_key_prefix = GetChildListingKeyPrefix(parent_id);
 
+  // Compare and parse the keys and values in place; copying them out costs
+  // two allocations per child, which adds up for large directories.
   scoped_ptr<leveldb::Iterator> iter(db_->NewIterator(leveldb::ReadOptions()));
   iter->Seek(child_key_prefix);
   children->clear();
-  while (iter->Valid() &&
-      StartsWithASCII(iter->key().ToString(), child_key_prefix, true)) {
-    std::string child_id_string = iter->value().ToString();
+  while (iter->Valid() && iter->key().starts_with(child_key_prefix)) {
+    leveldb::Slice child_id_slice = iter->value();
     FileId child_id;
-    if (!base::StringToInt64(child_id_string, &child_id)) {
+    if (!base::StringToInt64(
+            base::StringPiece(child_id_slice.data(), child_id_slice.size()),
+            &child_id)) {
       LOG(ERROR) << "Hit database corruption!";
       return false;
     }
@@ -28,6 +28,10 @@ using WebKit::WebURLResponse;
 
 namespace {
 
+// How much of the generated page is collected before it is sent to the
+// client.
+const size_t kMaxChunkSize = 32 * 1024;
+
 string16 ConvertPathToUTF16(const std::string& path) {
   // Per RFC 2640, FTP servers should use UTF-8 or its proper subset ASCII,
   // but many old FTP servers use legacy encodings. Try UTF-8 first.
@@ -75,8 +79,14 @@ void FtpDirectoryListingResponseDelegate::OnCompletedRequest() {
     SendDataToClient("<script>onListingParsingError();</script>\n");
     return;
   }
+  // The raw listing is not needed any more.
+  std::string().swap(buffer_);
+
+  // Hand the entries to the client in chunks rather than one at a time, so a
+  // large listing doesn't cost a call into WebKit per entry.
+  std::string data;
   for (size_t i = 0; i < entries.size(); i++) {
-    FtpDirectoryListingEntry entry = entries[i];
+    const FtpDirectoryListingEntry& entry = entries[i];
 
     // Skip the current and parent directory entries in the listing. Our header
     // always includes them.
@@ -87,9 +97,15 @@ void FtpDirectoryListingResponseDelegate::OnCompletedRequest() {
     int64 size = entry.size;
     if (entry.type != FtpDirectoryListingEntry::FILE)
       size = 0;
-    SendDataToClient(net::GetDirectoryListingEntry(
+    data.append(net::GetDirectoryListingEntry(
         entry.name, entry.raw_name, is_directory, size, entry.last_modified));
+    if (data.size() >= kMaxChunkSize) {
+      SendDataToClient(data);
+      data.clear();
+    }
   }
+  if (!data.empty())
+    SendDataToClient(data);
 }
 
 void FtpDirectoryListingResponseDelegate::Init(const GURL& response_url) {
@@ -68,12 +68,13 @@ struct SerializeObject {
 // 10: Adds support for blob
 // 11: Adds support for pageScaleFactor
 // 12: Adds support for hasPasswordData in HTTP body
+// 13: Stops writing the referrer a second time after the HTTP body
 // Should be const, but unit tests may modify it.
 //
 // NOTE: If the version is -1, then the pickle contains only a URL string.
 // See CreateHistoryStateForURL.
 //
-int kVersion = 12;
+int kVersion = 13;
 
 // A bunch of convenience functions to read/write to SerializeObjects.
 // The serializers assume the input data is in the correct format and so does
@@ -351,11 +352,12 @@ void WriteHistoryItem(
       WriteString(item.stateObject().toString(), obj);
   }
 
-  // Yes, the referrer is written twice.  This is for backwards
-  // compatibility with the format.
+  // Before version 13 the referrer was written a second time here. It is
+  // written once per frame on every navigation, so it's no longer repeated.
   WriteFormData(item.httpBody(), obj);
   WriteString(item.httpContentType(), obj);
-  WriteString(item.referrer(), obj);
+  if (kVersion < 13)
+    WriteString(item.referrer(), obj);
 
   // Subitems
   const WebVector<WebHistoryItem>& children = item.children();
@@ -420,10 +422,11 @@ WebHistoryItem ReadHistoryItem(
     }
   }
 
-  // The extra referrer string is read for backwards compat.
+  // Versions before 13 have an extra referrer string, which is skipped.
   const WebHTTPBody& http_body = ReadFormData(obj);
   const WebString& http_content_type = ReadString(obj);
-  ALLOW_UNUSED const WebString& unused_referrer = ReadString(obj);
+  if (obj->version < 13)
+    ReadString(obj);
   if (include_form_data == ALWAYS_INCLUDE_FORM_DATA ||
       (include_form_data == INCLUDE_FORM_DATA_WITHOUT_PASSWORDS &&
        !http_body.isNull() && !http_body.containsPasswordData())) {
@@ -162,8 +162,8 @@ class GlueSerializeTest : public testing::Test {
 TEST_F(GlueSerializeTest, BackwardsCompatibleTest) {
   const WebHistoryItem& item = MakeHistoryItem(false, false);
 
-  // Make sure version 12 (current version) can read versions 1 through 11.
-  for (int i = 1; i <= 11; i++) {
+  // Make sure version 13 (current version) can read versions 1 through 12.
+  for (int i = 1; i <= 12; i++) {
     std::string serialized_item;
     webkit_glue::HistoryItemToVersionedString(item, i, &serialized_item);
     const WebHistoryItem& deserialized_item =
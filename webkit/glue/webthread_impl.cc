@@ -7,14 +7,116 @@
 
 #include "webkit/glue/webthread_impl.h"
 
+#include <algorithm>
+#include <deque>
+#include <vector>
+
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/message_loop.h"
+#include "base/stl_util.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/platform_thread.h"
+#include "base/time.h"
 
 namespace webkit_glue {
 
-WebThreadBase::WebThreadBase() { }
+namespace {
+
+// How long a batch of tasks may run before the rest are left for a later
+// MessageLoop task, so that input and IPC are not starved.
+const int kTaskBatchBudgetMs = 5;
+
+}  // namespace
+
+// Holds the tasks posted with PostBatchedTask() that have not run yet. At
+// most one MessageLoop task to run them is pending at a time. Ref-counted as
+// that MessageLoop task can outlive the WebThreadBase.
+class WebThreadBase::TaskBatch
+    : public base::RefCountedThreadSafe<TaskBatch> {
+ public:
+  TaskBatch() : run_pending_(false) {}
+
+  void Add(base::MessageLoopProxy* message_loop, Task* task) {
+    {
+      base::AutoLock locked(lock_);
+      tasks_.push_back(task);
+      if (run_pending_)
+        return;
+      run_pending_ = true;
+    }
+    PostRun(message_loop);
+  }
+
+  // The observers are only used on the thread that runs the tasks.
+  void AddObserver(TaskObserver* observer) {
+    observers_.push_back(observer);
+  }
+
+  void RemoveObserver(TaskObserver* observer) {
+    observers_.erase(
+        std::remove(observers_.begin(), observers_.end(), observer),
+        observers_.end());
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<TaskBatch>;
+
+  ~TaskBatch() {
+    STLDeleteElements(&tasks_);
+  }
+
+  void PostRun(base::MessageLoopProxy* message_loop) {
+    message_loop->PostTask(
+        FROM_HERE, base::Bind(&TaskBatch::Run, this,
+                              make_scoped_refptr(message_loop)));
+  }
+
+  void Run(scoped_refptr<base::MessageLoopProxy> message_loop) {
+    base::TimeTicks deadline = base::TimeTicks::Now() +
+        base::TimeDelta::FromMilliseconds(kTaskBatchBudgetMs);
+    bool first = true;
+    for (;;) {
+      bool over_budget = !first && base::TimeTicks::Now() >= deadline;
+      scoped_ptr<Task> task;
+      {
+        base::AutoLock locked(lock_);
+        if (tasks_.empty()) {
+          run_pending_ = false;
+          return;
+        }
+        if (over_budget)
+          break;
+        task.reset(tasks_.front());
+        tasks_.pop_front();
+      }
+      // The MessageLoop only notifies observers after the last task of the
+      // batch, so notify them about the ones before it here.
+      if (!first)
+        NotifyObservers();
+      first = false;
+      task->run();
+    }
+    PostRun(message_loop);
+  }
+
+  void NotifyObservers() {
+    // Copied, as observers may remove themselves.
+    std::vector<TaskObserver*> observers(observers_);
+    for (size_t i = 0; i < observers.size(); ++i)
+      observers[i]->didProcessTask();
+  }
+
+  base::Lock lock_;
+  std::deque<Task*> tasks_;
+  bool run_pending_;
+
+  std::vector<TaskObserver*> observers_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskBatch);
+};
+
+WebThreadBase::WebThreadBase() : task_batch_(new TaskBatch) { }
 WebThreadBase::~WebThreadBase() { }
 
 class WebThreadBase::TaskObserverAdapter : public MessageLoop::TaskObserver {
@@ -37,8 +139,10 @@ void WebThreadBase::addTaskObserver(TaskObserver* observer) {
   CHECK(IsCurrentThread());
   std::pair<TaskObserverMap::iterator, bool> result = task_observer_map_.insert(
       std::make_pair(observer, static_cast<TaskObserverAdapter*>(NULL)));
-  if (result.second)
+  if (result.second) {
     result.first->second = new TaskObserverAdapter(observer);
+    task_batch_->AddObserver(observer);
+  }
   MessageLoop::current()->AddTaskObserver(result.first->second);
 }
 
@@ -48,18 +152,23 @@ void WebThreadBase::removeTaskObserver(TaskObserver* observer) {
   if (iter == task_observer_map_.end())
     return;
   MessageLoop::current()->RemoveTaskObserver(iter->second);
+  task_batch_->RemoveObserver(observer);
   delete iter->second;
   task_observer_map_.erase(iter);
 }
 
+void WebThreadBase::PostBatchedTask(base::MessageLoopProxy* message_loop,
+                                    Task* task) {
+  task_batch_->Add(message_loop, task);
+}
+
 WebThreadImpl::WebThreadImpl(const char* name)
     : thread_(new base::Thread(name)) {
   thread_->Start();
 }
 
 void WebThreadImpl::postTask(Task* task) {
-  thread_->message_loop()->PostTask(
-      FROM_HERE, base::Bind(&WebKit::WebThread::Task::run, base::Owned(task)));
+  PostBatchedTask(thread_->message_loop_proxy(), task);
 }
 
 void WebThreadImpl::postDelayedTask(
@@ -96,8 +205,7 @@ WebThreadImplForMessageLoop::WebThreadImplForMessageLoop(
 }
 
 void WebThreadImplForMessageLoop::postTask(Task* task) {
-  message_loop_->PostTask(
-      FROM_HERE, base::Bind(&WebKit::WebThread::Task::run, base::Owned(task)));
+  PostBatchedTask(message_loop_, task);
 }
 
 void WebThreadImplForMessageLoop::postDelayedTask(
@@ -7,6 +7,7 @@
 #include <map>
 
 #include "base/threading/thread.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/platform/WebThread.h"
 #include "webkit/glue/webkit_glue_export.h"
@@ -23,13 +24,21 @@ class WebThreadBase : public WebKit::WebThread {
  protected:
   WebThreadBase();
 
+  // Queues |task| to run on |message_loop|, the loop of this thread. Tasks
+  // posted in quick succession share a single MessageLoop task, which runs
+  // them in order for up to a short time budget.
+  void PostBatchedTask(base::MessageLoopProxy* message_loop, Task* task);
+
  private:
   class TaskObserverAdapter;
+  class TaskBatch;
 
   virtual bool IsCurrentThread() const = 0;
 
   typedef std::map<TaskObserver*, TaskObserverAdapter*> TaskObserverMap;
   TaskObserverMap task_observer_map_;
+
+  scoped_refptr<TaskBatch> task_batch_;
 };
 
 class WebThreadImpl : public WebThreadBase {
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <deque>
+
 #include "base/callback.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
@@ -11,22 +13,63 @@
 
 using WebKit::WebWorkerRunLoop;
 
-namespace {
+namespace webkit_glue {
 
-class RunClosureTask : public WebWorkerRunLoop::Task {
+// Workers can be sent many messages in a burst, so closures posted while a
+// previous batch is still waiting to run join that batch instead of each
+// allocating and posting a run loop task.
+class WorkerTaskRunner::PendingClosures
+    : public base::RefCountedThreadSafe<PendingClosures> {
  public:
-  RunClosureTask(const base::Closure& task) : task_(task) {}
-  virtual ~RunClosureTask() {}
-  virtual void Run() {
-    task_.Run();
+  // Worker run loop task that runs the pending closures.
+  class RunTask : public WebWorkerRunLoop::Task {
+   public:
+    explicit RunTask(PendingClosures* pending_closures)
+        : pending_closures_(pending_closures) {}
+    virtual ~RunTask() {}
+    virtual void Run() {
+      pending_closures_->Run();
+    }
+   private:
+    scoped_refptr<PendingClosures> pending_closures_;
+  };
+
+  PendingClosures() {}
+
+  // Returns true if this is the first closure of a new batch, in which case
+  // the caller must post a RunTask to the worker run loop.
+  bool Add(const base::Closure& closure) {
+    base::AutoLock locker(lock_);
+    closures_.push_back(closure);
+    return closures_.size() == 1;
   }
+
+  // Runs on the worker thread.
+  void Run() {
+    std::deque<base::Closure> closures;
+    {
+      base::AutoLock locker(lock_);
+      closures_.swap(closures);
+    }
+    for (std::deque<base::Closure>::iterator it = closures.begin();
+         it != closures.end(); ++it) {
+      it->Run();
+    }
+  }
+
  private:
-  base::Closure task_;
+  friend class base::RefCountedThreadSafe<PendingClosures>;
+  ~PendingClosures() {}
+
+  base::Lock lock_;
+  std::deque<base::Closure> closures_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingClosures);
 };
 
-} // unnamed namespace
+WorkerTaskRunner::WorkerLoop::WorkerLoop() {}
 
-namespace webkit_glue {
+WorkerTaskRunner::WorkerLoop::~WorkerLoop() {}
 
 struct WorkerTaskRunner::ThreadLocalState {
   ThreadLocalState(int id, const WebWorkerRunLoop& loop)
@@ -48,8 +91,13 @@ void WorkerTaskRunner::PostTask(
   DCHECK(id > 0);
   base::AutoLock locker(loop_map_lock_);
   IDToLoopMap::iterator found = loop_map_.find(id);
-  if (found != loop_map_.end())
-    found->second.postTask(new RunClosureTask(closure));
+  if (found == loop_map_.end())
+    return;
+  WorkerLoop& worker_loop = found->second;
+  if (worker_loop.pending_closures->Add(closure)) {
+    worker_loop.run_loop.postTask(
+        new PendingClosures::RunTask(worker_loop.pending_closures));
+  }
 }
 
 int WorkerTaskRunner::CurrentWorkerId() {
@@ -83,7 +131,9 @@ void WorkerTaskRunner::OnWorkerRunLoopStarted(const WebWorkerRunLoop& loop) {
   current_tls_.Set(new ThreadLocalState(id, loop));
 
   base::AutoLock locker_(loop_map_lock_);
-  loop_map_[id] = loop;
+  WorkerLoop& worker_loop = loop_map_[id];
+  worker_loop.run_loop = loop;
+  worker_loop.pending_closures = new PendingClosures;
 }
 
 void WorkerTaskRunner::OnWorkerRunLoopStopped(const WebWorkerRunLoop& loop) {
@@ -92,7 +142,7 @@ void WorkerTaskRunner::OnWorkerRunLoopStopped(const WebWorkerRunLoop& loop) {
                     OnWorkerRunLoopStopped());
   {
     base::AutoLock locker(loop_map_lock_);
-    DCHECK(loop_map_[CurrentWorkerId()] == loop);
+    DCHECK(loop_map_[CurrentWorkerId()].run_loop == loop);
     loop_map_.erase(CurrentWorkerId());
   }
   delete current_tls_.Get();
@@ -10,6 +10,7 @@
 
 #include "base/atomic_sequence_num.h"
 #include "base/callback_forward.h"
+#include "base/memory/ref_counted.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebWorkerRunLoop.h"
@@ -40,7 +41,18 @@ class WEBKIT_GLUE_EXPORT WorkerTaskRunner {
   friend class WebKitPlatformSupportImpl;
   friend class WorkerTaskRunnerTest;
 
-  typedef std::map<int, WebKit::WebWorkerRunLoop> IDToLoopMap;
+  // Closures posted to a worker and not run yet. Shared with the task that
+  // runs them on the worker thread.
+  class PendingClosures;
+
+  struct WorkerLoop {
+    WorkerLoop();
+    ~WorkerLoop();
+
+    WebKit::WebWorkerRunLoop run_loop;
+    scoped_refptr<PendingClosures> pending_closures;
+  };
+  typedef std::map<int, WorkerLoop> IDToLoopMap;
 
   ~WorkerTaskRunner();
   void OnWorkerRunLoopStarted(const WebKit::WebWorkerRunLoop& loop);
@@ -45,6 +45,7 @@ BufferedDataSource::BufferedDataSource(
       cache_miss_retries_left_(kNumCacheMissRetries),
       bitrate_(0),
       playback_rate_(0.0),
+      download_rate_(0),
       media_log_(media_log) {
 }
 
@@ -67,6 +68,7 @@ BufferedResourceLoader* BufferedDataSource::CreateResourceLoader(
                                     strategy,
                                     bitrate_,
                                     playback_rate_,
+                                    download_rate_,
                                     media_log_);
 }
 
@@ -256,6 +258,11 @@ void BufferedDataSource::RestartLoadingTask() {
       return;
   }
 
+  // Let the new loader size its buffer window by what the old one learned of
+  // the link, rather than starting over from the defaults.
+  if (loader_->download_rate() > 0)
+    download_rate_ = loader_->download_rate();
+
   loader_.reset(CreateResourceLoader(read_position_, kPositionNotSpecified));
   loader_->Start(
       base::Bind(&BufferedDataSource::PartialReadStartCallback, this),
@@ -214,6 +214,10 @@ class BufferedDataSource : public media::DataSource {
   // Current playback rate.
   float playback_rate_;
 
+  // Download rate in bytes per second observed by the last loader, 0 if
+  // unknown. Handed to the loaders created after a cache miss.
+  int download_rate_;
+
   scoped_refptr<media::MediaLog> media_log_;
 
   DISALLOW_COPY_AND_ASSIGN(BufferedDataSource);
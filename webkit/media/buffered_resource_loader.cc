@@ -51,18 +51,34 @@ static const int kMaxBufferCapacity = 20 * kMegabyte;
 // location and will instead reset the request.
 static const int kForwardWaitThreshold = 2 * kMegabyte;
 
+// How long the download rate is measured for before a sample is taken, and
+// how much weight each new sample gets in the smoothed rate.
+static const int kDownloadRateSampleIntervalMs = 1000;
+static const double kDownloadRateSampleWeight = 0.3;
+
 // Computes the suggested backward and forward capacity for the buffer
 // if one wants to play at |playback_rate| * the natural playback speed.
 // Use a value of 0 for |bitrate| if it is unknown.
+//
+// |download_rate| is the observed download rate in bytes per second, 0 if
+// unknown. When the link does not comfortably outpace playback, more is
+// buffered ahead so that bursts in the bitrate and slow reconnects after a
+// deferral do not drain the buffer.
 static void ComputeTargetBufferWindow(float playback_rate, int bitrate,
+                                      int download_rate,
                                       int* out_backward_capacity,
                                       int* out_forward_capacity) {
   static const int kDefaultBitrate = 200 * 1024 * 8;  // 200 Kbps.
   static const int kMaxBitrate = 20 * kMegabyte * 8;  // 20 Mbps.
   static const float kMaxPlaybackRate = 25.0;
   static const int kTargetSecondsBufferedAhead = 10;
+  static const int kMaxTargetSecondsBufferedAhead = 30;
   static const int kTargetSecondsBufferedBehind = 2;
 
+  // Download rate relative to the playback byte rate above which the default
+  // amount of buffering ahead is considered enough.
+  static const double kComfortableDownloadRatio = 1.5;
+
   // Use a default bit rate if unknown and clamp to prevent overflow.
   if (bitrate <= 0)
     bitrate = kDefaultBitrate;
@@ -81,14 +97,30 @@ static void ComputeTargetBufferWindow(float playback_rate, int bitrate,
 
   int bytes_per_second = (bitrate / 8.0) * playback_rate;
 
-  // Clamp between kMinBufferCapacity and kMaxBufferCapacity.
-  *out_forward_capacity = std::max(
-      kTargetSecondsBufferedAhead * bytes_per_second, kMinBufferCapacity);
-  *out_backward_capacity = std::max(
-      kTargetSecondsBufferedBehind * bytes_per_second, kMinBufferCapacity);
+  // Scale the time buffered ahead by how far the download rate falls short of
+  // comfortably outpacing playback.
+  double seconds_ahead = kTargetSecondsBufferedAhead;
+  if (download_rate > 0) {
+    double shortfall =
+        kComfortableDownloadRatio * bytes_per_second / download_rate;
+    seconds_ahead = std::max(seconds_ahead * shortfall, seconds_ahead);
+    seconds_ahead = std::min(
+        seconds_ahead, static_cast<double>(kMaxTargetSecondsBufferedAhead));
+  }
+
+  // Clamp between kMinBufferCapacity and kMaxBufferCapacity. The products are
+  // computed as doubles since they can exceed the range of an int before
+  // clamping.
+  double forward_capacity = std::max(seconds_ahead * bytes_per_second,
+                                     static_cast<double>(kMinBufferCapacity));
+  double backward_capacity = std::max(
+      static_cast<double>(kTargetSecondsBufferedBehind) * bytes_per_second,
+      static_cast<double>(kMinBufferCapacity));
 
-  *out_forward_capacity = std::min(*out_forward_capacity, kMaxBufferCapacity);
-  *out_backward_capacity = std::min(*out_backward_capacity, kMaxBufferCapacity);
+  *out_forward_capacity = static_cast<int>(
+      std::min(forward_capacity, static_cast<double>(kMaxBufferCapacity)));
+  *out_backward_capacity = static_cast<int>(
+      std::min(backward_capacity, static_cast<double>(kMaxBufferCapacity)));
 
   if (backward_playback)
     std::swap(*out_forward_capacity, *out_backward_capacity);
@@ -101,6 +133,7 @@ BufferedResourceLoader::BufferedResourceLoader(
     DeferStrategy strategy,
     int bitrate,
     float playback_rate,
+    int download_rate,
     media::MediaLog* media_log)
     : defer_strategy_(strategy),
       range_supported_(false),
@@ -119,12 +152,14 @@ BufferedResourceLoader::BufferedResourceLoader(
       last_offset_(0),
       bitrate_(bitrate),
       playback_rate_(playback_rate),
+      download_rate_(download_rate),
+      download_sample_bytes_(0),
       media_log_(media_log) {
 
   int backward_capacity;
   int forward_capacity;
-  ComputeTargetBufferWindow(
-      playback_rate_, bitrate_, &backward_capacity, &forward_capacity);
+  ComputeTargetBufferWindow(playback_rate_, bitrate_, download_rate_,
+                            &backward_capacity, &forward_capacity);
   buffer_.reset(new media::SeekableBuffer(backward_capacity, forward_capacity));
 }
 
@@ -435,6 +470,8 @@ void BufferedResourceLoader::didReceiveData(
   // Writes more data to |buffer_|.
   buffer_->Append(reinterpret_cast<const uint8*>(data), data_length);
 
+  UpdateDownloadRate(data_length, base::TimeTicks::Now());
+
   // If there is an active read request, try to fulfill the request.
   if (HasPendingRead() && CanFulfillRead())
     ReadInternal();
@@ -572,8 +609,8 @@ void BufferedResourceLoader::UpdateBufferWindow() {
 
   int backward_capacity;
   int forward_capacity;
-  ComputeTargetBufferWindow(
-      playback_rate_, bitrate_, &backward_capacity, &forward_capacity);
+  ComputeTargetBufferWindow(playback_rate_, bitrate_, download_rate_,
+                            &backward_capacity, &forward_capacity);
 
   // This does not evict data from the buffer if the new capacities are less
   // than the current capacities; the new limits will be enforced after the
@@ -582,6 +619,36 @@ void BufferedResourceLoader::UpdateBufferWindow() {
   buffer_->set_forward_capacity(forward_capacity);
 }
 
+void BufferedResourceLoader::UpdateDownloadRate(int bytes,
+                                                base::TimeTicks now) {
+  // The first chunk after a (re)start only marks the beginning of a sample;
+  // its bytes arrived after an unknown amount of latency.
+  if (download_sample_start_.is_null()) {
+    download_sample_start_ = now;
+    download_sample_bytes_ = 0;
+    return;
+  }
+
+  download_sample_bytes_ += bytes;
+  base::TimeDelta elapsed = now - download_sample_start_;
+  if (elapsed.InMilliseconds() < kDownloadRateSampleIntervalMs)
+    return;
+
+  double sample = download_sample_bytes_ / elapsed.InSecondsF();
+  if (download_rate_ > 0) {
+    sample = kDownloadRateSampleWeight * sample +
+        (1 - kDownloadRateSampleWeight) * download_rate_;
+  }
+  // Keep a stalled link from reading as an unknown rate.
+  sample = std::max(sample, 1.0);
+  download_rate_ = static_cast<int>(
+      std::min(sample, static_cast<double>(kint32max)));
+  download_sample_start_ = now;
+  download_sample_bytes_ = 0;
+
+  UpdateBufferWindow();
+}
+
 void BufferedResourceLoader::UpdateDeferBehavior() {
   if (!active_loader_.get() || !buffer_.get())
     return;
@@ -594,6 +661,10 @@ void BufferedResourceLoader::UpdateDeferBehavior() {
 
 void BufferedResourceLoader::SetDeferred(bool deferred) {
   active_loader_->SetDeferred(deferred);
+
+  // Start a new download rate sample once data flows again.
+  download_sample_start_ = base::TimeTicks();
+  download_sample_bytes_ = 0;
   NotifyNetworkEvent();
 }
 
@@ -9,6 +9,7 @@
 
 #include "base/callback.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/time.h"
 #include "base/timer.h"
 #include "googleurl/src/gurl.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebFrame.h"
@@ -72,12 +73,15 @@ class BufferedResourceLoader : public WebKit::WebURLLoaderClient {
   // |strategy| is the initial loading strategy to use.
   // |bitrate| is the bitrate of the media, 0 if unknown.
   // |playback_rate| is the current playback rate of the media.
+  // |download_rate| is the download rate in bytes per second observed by a
+  // previous loader for the same media, 0 if unknown.
   BufferedResourceLoader(const GURL& url,
                          int64 first_byte_position,
                          int64 last_byte_position,
                          DeferStrategy strategy,
                          int bitrate,
                          float playback_rate,
+                         int download_rate,
                          media::MediaLog* media_log);
   virtual ~BufferedResourceLoader();
 
@@ -179,6 +183,10 @@ class BufferedResourceLoader : public WebKit::WebURLLoaderClient {
   // accordingly.
   void SetBitrate(int bitrate);
 
+  // Returns the download rate observed so far in bytes per second, 0 if
+  // unknown. Time spent deferred does not count against the rate.
+  int download_rate() const { return download_rate_; }
+
   // Parse a Content-Range header into its component pieces and return true if
   // each of the expected elements was found & parsed correctly.
   // |*instance_size| may be set to kPositionNotSpecified if the range ends in
@@ -197,6 +205,10 @@ class BufferedResourceLoader : public WebKit::WebURLLoaderClient {
   // Updates the |buffer_|'s forward and backward capacities.
   void UpdateBufferWindow();
 
+  // Accounts for |bytes| received at |now| in |download_rate_|, updating the
+  // buffer window whenever a new sample is taken.
+  void UpdateDownloadRate(int bytes, base::TimeTicks now);
+
   // Returns true if we should defer resource loading based on the current
   // buffering scheme.
   bool ShouldEnableDefer() const;
@@ -303,6 +315,13 @@ class BufferedResourceLoader : public WebKit::WebURLLoaderClient {
   // Playback rate of the media.
   float playback_rate_;
 
+  // Smoothed download rate in bytes per second, 0 until the first sample.
+  // Samples are taken over |download_sample_start_| onwards while loading is
+  // not deferred, so that time spent deferred is not mistaken for a slow link.
+  int download_rate_;
+  base::TimeTicks download_sample_start_;
+  int64 download_sample_bytes_;
+
   scoped_refptr<media::MediaLog> media_log_;
 
   DISALLOW_COPY_AND_ASSIGN(BufferedResourceLoader);
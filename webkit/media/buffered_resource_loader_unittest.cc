@@ -85,7 +85,7 @@ class BufferedResourceLoaderTest : public testing::Test {
 
     loader_.reset(new BufferedResourceLoader(
         gurl_, first_position_, last_position_,
-        BufferedResourceLoader::kThresholdDefer, 0, 0,
+        BufferedResourceLoader::kThresholdDefer, 0, 0, 0,
         new media::MediaLog()));
 
     // |test_loader_| will be used when Start() is called.
@@ -1116,6 +1116,47 @@ TEST_F(BufferedResourceLoaderTest, BufferWindow_PlaybackRate_AboveUpperBound) {
   StopWhenLoad();
 }
 
+TEST_F(BufferedResourceLoaderTest, BufferWindow_DownloadRate_Fast) {
+  static const int kBytesPerSecond = 256 * 1024;
+  Initialize(kHttpUrl, -1, -1);
+  Start();
+  loader_->SetBitrate(kBytesPerSecond * 8);
+  ConfirmLoaderBufferForwardCapacity(10 * kBytesPerSecond);
+
+  // A link ten times faster than playback needs no more than the default.
+  base::TimeTicks now = base::TimeTicks::Now();
+  loader_->UpdateDownloadRate(0, now);
+  loader_->UpdateDownloadRate(10 * kBytesPerSecond,
+                              now + base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(10 * kBytesPerSecond, loader_->download_rate());
+  ConfirmLoaderBufferForwardCapacity(10 * kBytesPerSecond);
+  CheckBufferWindowBounds();
+  StopWhenLoad();
+}
+
+TEST_F(BufferedResourceLoaderTest, BufferWindow_DownloadRate_Slow) {
+  static const int kBytesPerSecond = 256 * 1024;
+  Initialize(kHttpUrl, -1, -1);
+  Start();
+  loader_->SetBitrate(kBytesPerSecond * 8);
+
+  // A link just keeping up with playback buffers further ahead.
+  base::TimeTicks now = base::TimeTicks::Now();
+  loader_->UpdateDownloadRate(0, now);
+  loader_->UpdateDownloadRate(kBytesPerSecond,
+                              now + base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(kBytesPerSecond, loader_->download_rate());
+  ConfirmLoaderBufferForwardCapacity(15 * kBytesPerSecond);
+
+  // Slower still, up to a limit.
+  for (int i = 2; i < 8; ++i)
+    loader_->UpdateDownloadRate(0, now + base::TimeDelta::FromSeconds(i));
+  EXPECT_LT(loader_->download_rate(), kBytesPerSecond / 2);
+  ConfirmLoaderBufferForwardCapacity(30 * kBytesPerSecond);
+  CheckBufferWindowBounds();
+  StopWhenLoad();
+}
+
 static void ExpectContentRange(
     const std::string& str, bool expect_success,
     int64 expected_first, int64 expected_last, int64 expected_size) {
@@ -142,20 +142,21 @@ static void FastPaint(
   // TODO(hclam): do rotation and mirroring here.
   // TODO(fbarchard): switch filtering based on performance.
   bitmap.lockPixels();
-  media::ScaleYUVToRGB32(frame_clip_y,
-                         frame_clip_u,
-                         frame_clip_v,
-                         dest_rect_pointer,
-                         frame_clip_width,
-                         frame_clip_height,
-                         local_dest_irect.width(),
-                         local_dest_irect.height(),
-                         video_frame->stride(media::VideoFrame::kYPlane),
-                         video_frame->stride(media::VideoFrame::kUPlane),
-                         bitmap.rowBytes(),
-                         yuv_type,
-                         media::ROTATE_0,
-                         media::FILTER_BILINEAR);
+  media::ScaleYUVToRGB32Parallel(
+      frame_clip_y,
+      frame_clip_u,
+      frame_clip_v,
+      dest_rect_pointer,
+      frame_clip_width,
+      frame_clip_height,
+      local_dest_irect.width(),
+      local_dest_irect.height(),
+      video_frame->stride(media::VideoFrame::kYPlane),
+      video_frame->stride(media::VideoFrame::kUPlane),
+      bitmap.rowBytes(),
+      yuv_type,
+      media::ROTATE_0,
+      media::FILTER_BILINEAR);
   bitmap.unlockPixels();
 }
 
@@ -184,16 +185,17 @@ static void ConvertVideoFrameToBitmap(
   media::YUVType yuv_type =
       (video_frame->format() == media::VideoFrame::YV12) ?
       media::YV12 : media::YV16;
-  media::ConvertYUVToRGB32(video_frame->data(media::VideoFrame::kYPlane),
-                           video_frame->data(media::VideoFrame::kUPlane),
-                           video_frame->data(media::VideoFrame::kVPlane),
-                           static_cast<uint8*>(bitmap->getPixels()),
-                           video_frame->width(),
-                           video_frame->height(),
-                           video_frame->stride(media::VideoFrame::kYPlane),
-                           video_frame->stride(media::VideoFrame::kUPlane),
-                           bitmap->rowBytes(),
-                           yuv_type);
+  media::ConvertYUVToRGB32Parallel(
+      video_frame->data(media::VideoFrame::kYPlane),
+      video_frame->data(media::VideoFrame::kUPlane),
+      video_frame->data(media::VideoFrame::kVPlane),
+      static_cast<uint8*>(bitmap->getPixels()),
+      video_frame->width(),
+      video_frame->height(),
+      video_frame->stride(media::VideoFrame::kYPlane),
+      video_frame->stride(media::VideoFrame::kUPlane),
+      bitmap->rowBytes(),
+      yuv_type);
   bitmap->notifyPixelsChanged();
   bitmap->unlockPixels();
 }
@@ -613,6 +613,10 @@ unsigned WebMediaPlayerImpl::videoDecodedByteCount() const {
   return stats.video_bytes_decoded;
 }
 
+// The compositor pulls frames through getCurrentFrame() and putCurrentFrame()
+// instead of paint(), so they never pass through SkCanvasVideoRenderer: frames
+// from GpuVideoDecoder hand over their texture as is, and YUV frames are
+// uploaded plane by plane and converted to RGB on the GPU.
 WebKit::WebVideoFrame* WebMediaPlayerImpl::getCurrentFrame() {
   scoped_refptr<media::VideoFrame> video_frame;
   proxy_->GetCurrentFrame(&video_frame);
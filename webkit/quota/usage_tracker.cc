@@ -390,11 +390,13 @@ void ClientUsageTracker::UpdateUsageCache(
     const GURL& origin, int64 delta) {
   std::string host = net::GetHostOrSpecFromURL(origin);
   if (cached_hosts_.find(host) != cached_hosts_.end()) {
-    cached_usage_[host][origin] += delta;
+    int64& usage = cached_usage_[host][origin];
+    usage += delta;
+    cached_host_usage_[host] += delta;
     global_usage_ += delta;
     if (global_unlimited_usage_is_valid_ && IsStorageUnlimited(origin))
       global_unlimited_usage_ += delta;
-    DCHECK_GE(cached_usage_[host][origin], 0);
+    DCHECK_GE(usage, 0);
     DCHECK_GE(global_usage_, 0);
     return;
   }
@@ -408,10 +410,10 @@ void ClientUsageTracker::UpdateUsageCache(
 void ClientUsageTracker::GetCachedHostsUsage(
     std::map<std::string, int64>* host_usage) const {
   DCHECK(host_usage);
-  for (HostUsageMap::const_iterator host_iter = cached_usage_.begin();
-       host_iter != cached_usage_.end(); host_iter++) {
-    host_usage->operator[](host_iter->first) +=
-        GetCachedHostUsage(host_iter->first);
+  for (HostUsageTotalMap::const_iterator host_iter =
+           cached_host_usage_.begin();
+       host_iter != cached_host_usage_.end(); host_iter++) {
+    host_usage->operator[](host_iter->first) += host_iter->second;
   }
 }
 
@@ -435,6 +437,7 @@ void ClientUsageTracker::AddCachedOrigin(
   int64 old_usage = iter->second;
   iter->second = usage;
   int64 delta = usage - old_usage;
+  cached_host_usage_[host] += delta;
   if (delta) {
     global_usage_ += delta;
     if (global_unlimited_usage_is_valid_ && IsStorageUnlimited(origin))
@@ -472,17 +475,10 @@ void ClientUsageTracker::GatherHostUsageComplete(const std::string& host) {
 }
 
 int64 ClientUsageTracker::GetCachedHostUsage(const std::string& host) const {
-  HostUsageMap::const_iterator found = cached_usage_.find(host);
-  if (found == cached_usage_.end())
+  HostUsageTotalMap::const_iterator found = cached_host_usage_.find(host);
+  if (found == cached_host_usage_.end())
     return 0;
-
-  int64 usage = 0;
-  const UsageMap& map = found->second;
-  for (UsageMap::const_iterator iter = map.begin();
-       iter != map.end(); ++iter) {
-    usage += iter->second;
-  }
-  return usage;
+  return found->second;
 }
 
 int64 ClientUsageTracker::GetCachedGlobalUnlimitedUsage() {
@@ -99,6 +99,7 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   typedef std::set<std::string> HostSet;
   typedef std::map<GURL, int64> UsageMap;
   typedef std::map<std::string, UsageMap> HostUsageMap;
+  typedef std::map<std::string, int64> HostUsageTotalMap;
 
   class GatherUsageTaskBase;
   class GatherGlobalUsageTask;
@@ -129,6 +130,10 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   HostSet cached_hosts_;
   HostUsageMap cached_usage_;
 
+  // The sum of each host's usage in |cached_usage_|, kept up to date with it
+  // so that usage queries don't have to add up the origins every time.
+  HostUsageTotalMap cached_host_usage_;
+
   GatherGlobalUsageTask* global_usage_task_;
   GlobalUsageCallbackQueue global_usage_callback_;
   std::map<std::string, GatherHostUsageTask*> host_usage_tasks_;